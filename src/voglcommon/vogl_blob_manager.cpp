@@ -31,6 +31,7 @@
 #include "vogl_file_utils.h"
 #include "vogl_find_files.h"
 #include "vogl_hash.h"
+#include "vogl_miniz_parallel.h"
 
 using namespace vogl;
 
@@ -60,14 +61,20 @@ dynamic_string vogl_blob_manager::compute_unique_id(const void *pData, uint size
 
     uint64_t crc64 = pCRC64 ? *pCRC64 : calc_crc64(CRC64_INIT, static_cast<const uint8 *>(pData), size);
 
-    dynamic_string actual_ext(ext);
-    if ((actual_ext.get_len() > 1) && (actual_ext[0] == '.'))
-        actual_ext.right(1);
+    const char *pExt = ext.get_ptr();
+    if ((ext.get_len() > 1) && (pExt[0] == '.'))
+        pExt++;
+
+    // This is called once per blob while tracing/snapshotting, so build the id with the typed appenders instead of going through vsnprintf.
+    dynamic_string id;
+    id.reserve(prefix.get_len() + 64);
 
     if (prefix.get_len())
-        return dynamic_string(cVarArg, "[%s]_%" PRIX64 "_%u.radblob.%s", prefix.get_ptr(), crc64, size, actual_ext.get_len() ? actual_ext.get_ptr() : "raw");
-    else
-        return dynamic_string(cVarArg, "%" PRIX64 "_%u.radblob.%s", crc64, size, actual_ext.get_len() ? actual_ext.get_ptr() : "raw");
+        id.append_char('[').append(prefix).append("]_");
+
+    id.append_hex(crc64).append_char('_').append_uint64(size).append(".radblob.").append(*pExt ? pExt : "raw");
+
+    return id;
 }
 
 dynamic_string vogl_blob_manager::get_prefix(const dynamic_string &id) const
@@ -92,6 +99,23 @@ dynamic_string vogl_blob_manager::get_extension(const dynamic_string &id) const
     return extension;
 }
 
+data_stream *vogl_blob_manager::get_stream(const dynamic_string &id) const
+{
+    VOGL_FUNC_TRACER
+
+    if (!is_initialized())
+    {
+        VOGL_ASSERT(0);
+        return NULL;
+    }
+
+    data_stream *pStream = open_concurrent(id);
+    if (!pStream)
+        vogl_error_printf("%s: Failed finding blob ID %s\n", VOGL_FUNCTION_INFO_CSTR, id.get_ptr());
+
+    return pStream;
+}
+
 bool vogl_blob_manager::get(const dynamic_string &id, uint8_vec &data) const
 {
     VOGL_FUNC_TRACER
@@ -102,11 +126,10 @@ bool vogl_blob_manager::get(const dynamic_string &id, uint8_vec &data) const
         return false;
     }
 
-    data_stream *pStream = open(id);
+    data_stream *pStream = get_stream(id);
     if (!pStream)
     {
         data.resize(0);
-        vogl_error_printf("%s: Failed finding blob ID %s\n", VOGL_FUNCTION_INFO_CSTR, id.get_ptr());
         return false;
     }
 
@@ -192,7 +215,7 @@ dynamic_string vogl_blob_manager::add_buf_compute_unique_id(const void *pData, u
 
     dynamic_string id(compute_unique_id(pData, size, prefix, ext, pCRC64));
 
-    return add_buf_using_id(pData, size, id);
+    return add_buf_using_id_concurrent(pData, size, id);
 }
 
 dynamic_string vogl_blob_manager::add_stream_compute_unique_id(data_stream &stream, const dynamic_string &prefix, const dynamic_string &ext, const uint64_t *pCRC64)
@@ -241,7 +264,7 @@ dynamic_string vogl_blob_manager::add_stream_compute_unique_id(data_stream &stre
 
     dynamic_string id(compute_unique_id(pData, size, prefix, ext, pCRC64));
 
-    dynamic_string actual_id(add_buf_using_id(pData, size, id));
+    dynamic_string actual_id(add_buf_using_id_concurrent(pData, size, id));
 
     vogl_free(pData);
     return actual_id;
@@ -284,12 +307,28 @@ dynamic_string vogl_blob_manager::add_stream_using_id(data_stream &stream, const
         return "";
     }
 
-    dynamic_string actual_id(add_buf_using_id(pData, size, id));
+    dynamic_string actual_id(add_buf_using_id_concurrent(pData, size, id));
 
     vogl_free(pData);
     return actual_id;
 }
 
+data_stream *vogl_blob_manager::open_concurrent(const dynamic_string &id) const
+{
+    VOGL_FUNC_TRACER
+
+    scoped_mutex lock(m_mutex);
+    return open(id);
+}
+
+dynamic_string vogl_blob_manager::add_buf_using_id_concurrent(const void *pData, uint size, const dynamic_string &id)
+{
+    VOGL_FUNC_TRACER
+
+    scoped_mutex lock(m_mutex);
+    return add_buf_using_id(pData, size, id);
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 // vogl_blob_manager::copy_file
 //----------------------------------------------------------------------------------------------------------------------
@@ -996,26 +1035,55 @@ vogl::dynamic_string vogl_archive_blob_manager::add_buf_using_id(const void *pDa
         return "";
     }
 
-    if (mz_zip_get_mode(&m_zip) != MZ_ZIP_MODE_WRITING)
-        return "";
-
     dynamic_string actual_id(id);
     if (actual_id.is_empty())
         actual_id = compute_unique_id(pData, size);
 
-    // We don't support overwriting files already in the archive - it's up to the caller to not try adding redundant files into the archive.
-    // We could support orphaning the previous copy of the file and updating the archive to point to the latest version, though.
-    if (m_blobs.contains(actual_id))
     {
-        vogl_debug_printf("%s: Archive already contains blob id \"%s\"! Not replacing file.\n", VOGL_FUNCTION_INFO_CSTR, actual_id.get_ptr());
-        return actual_id;
+        scoped_mutex lock(m_mutex);
+
+        if (mz_zip_get_mode(&m_zip) != MZ_ZIP_MODE_WRITING)
+            return "";
+
+        // We don't support overwriting files already in the archive - it's up to the caller to not try adding redundant files into the archive.
+        // We could support orphaning the previous copy of the file and updating the archive to point to the latest version, though.
+        if (m_blobs.contains(actual_id))
+        {
+            vogl_debug_printf("%s: Archive already contains blob id \"%s\"! Not replacing file.\n", VOGL_FUNCTION_INFO_CSTR, actual_id.get_ptr());
+            return actual_id;
+        }
     }
 
+    // Deflate outside of the lock, so multiple threads can add blobs at once. Large blobs are deflated in parallel blocks. The result is
+    // still a plain deflated zip entry, the block index goes into the entry's comment so open() can inflate it in parallel too.
+    uint8_vec comp_data;
+    mz_parallel::block_index comp_index;
+    mz_uint32 crc32 = 0;
+    dynamic_string comment;
+    const bool compressed = (size > 3) && (mz_parallel::deflate(comp_data, pData, size, MZ_BEST_SPEED, 0, &comp_index, &crc32)) && (comp_data.size() < size);
+    if ((compressed) && (comp_index.m_comp_sizes.size() > 1))
+        comp_index.serialize(comment);
+
+    // Only the local header/data append and the central directory update are serialized.
+    scoped_mutex lock(m_mutex);
+
+    if (m_blobs.contains(actual_id))
+        return actual_id;
+
     uint file_index = mz_zip_get_num_files(&m_zip);
 
+    if (compressed)
+    {
+        if (!mz_zip_writer_add_mem_ex(&m_zip, actual_id.get_ptr(), comp_data.get_ptr(), comp_data.size(), comment.get_ptr(), comment.get_len(), MZ_BEST_SPEED | MZ_ZIP_FLAG_COMPRESSED_DATA, size, crc32))
+        {
+            mz_zip_error mz_err = mz_zip_get_last_error(&m_zip);
+            vogl_error_printf("%s: mz_zip_writer_add_mem_ex() failed adding blob \"%s\" size %u, error 0x%X (%s)\n", VOGL_FUNCTION_INFO_CSTR, id.get_ptr(), size, mz_err, mz_zip_get_error_string(mz_err));
+
+            return "";
+        }
+    }
     // TODO: Allow caller to control whether files are compressed
-    if (!mz_zip_writer_add_mem(&m_zip, actual_id.get_ptr(), pData, size, MZ_BEST_SPEED))
-    //if (!mz_zip_writer_add_mem(&m_zip, actual_id.get_ptr(), pData, size, 0))
+    else if (!mz_zip_writer_add_mem(&m_zip, actual_id.get_ptr(), pData, size, 0))
     {
         mz_zip_error mz_err = mz_zip_get_last_error(&m_zip);
         vogl_error_printf("%s: mz_zip_writer_add_mem() failed adding blob \"%s\" size %u, error 0x%X (%s)\n", VOGL_FUNCTION_INFO_CSTR, id.get_ptr(), size, mz_err, mz_zip_get_error_string(mz_err));
@@ -1040,27 +1108,103 @@ vogl::data_stream *vogl_archive_blob_manager::open(const vogl::dynamic_string &i
         return NULL;
     }
 
-    blob_map::const_iterator it = m_blobs.find(id);
-    if (it == m_blobs.end())
-        return NULL;
-
     // TODO: Add some sort of streaming decompression support to miniz and this class.
 
-    mz_zip_clear_last_error(&m_zip);
+    // Only reading the raw entry out of the archive is serialized, it's inflated after the lock is released.
+    blob b;
+    mz_zip_archive_file_stat stat;
+    void *pComp_data;
+    size_t comp_size;
+    {
+        scoped_mutex lock(m_mutex);
+
+        blob_map::const_iterator it = m_blobs.find(id);
+        if (it == m_blobs.end())
+            return NULL;
+        b = it->second;
 
-    size_t size;
-    void *pBuf = mz_zip_extract_to_heap(&m_zip, it->second.m_file_index, &size, 0);
+        mz_zip_clear_last_error(&m_zip);
+
+        pComp_data = NULL;
+        if (mz_zip_file_stat(&m_zip, b.m_file_index, &stat))
+            pComp_data = mz_zip_extract_to_heap(&m_zip, b.m_file_index, &comp_size, MZ_ZIP_FLAG_COMPRESSED_DATA);
+
+        if (!pComp_data)
+        {
+            mz_zip_error mz_err = mz_zip_get_last_error(&m_zip);
+            vogl_error_printf("%s: mz_zip_extract_to_heap() failed opening blob \"%s\", error 0x%X (%s)\n", VOGL_FUNCTION_INFO_CSTR, id.get_ptr(), mz_err, mz_zip_get_error_string(mz_err));
+
+            return NULL;
+        }
+    }
+
+    void *pBuf = inflate_blob(b, stat, pComp_data, comp_size);
     if (!pBuf)
+        return NULL;
+
+    return vogl_new(vogl::buffer_stream, pBuf, static_cast<size_t>(b.m_size));
+}
+
+// Takes ownership of pComp_data (the raw zip entry), returns the uncompressed blob or NULL on failure.
+void *vogl_archive_blob_manager::inflate_blob(const blob &b, const mz_zip_archive_file_stat &stat, void *pComp_data, size_t comp_size) const
+{
+    VOGL_FUNC_TRACER
+
+    if ((stat.m_uncomp_size != b.m_size) || (stat.m_uncomp_size > cUINT32_MAX) || ((stat.m_method) && (stat.m_method != MZ_DEFLATED)))
     {
-        mz_zip_error mz_err = mz_zip_get_last_error(&m_zip);
-        vogl_error_printf("%s: mz_zip_extract_to_heap() failed opening blob \"%s\", error 0x%X (%s)\n", VOGL_FUNCTION_INFO_CSTR, id.get_ptr(), mz_err, mz_zip_get_error_string(mz_err));
+        vogl_error_printf("%s: Unsupported zip entry for blob \"%s\" (method %u, size %" PRIu64 ")\n", VOGL_FUNCTION_INFO_CSTR, b.m_id.get_ptr(), stat.m_method, static_cast<uint64_t>(stat.m_uncomp_size));
+
+        mz_free(pComp_data);
+        return NULL;
+    }
+
+    // Stored entries are the blob itself.
+    if (!stat.m_method)
+    {
+        if ((comp_size != stat.m_uncomp_size) || (mz_crc32(MZ_CRC32_INIT, static_cast<const mz_uint8 *>(pComp_data), comp_size) != stat.m_crc32))
+        {
+            vogl_error_printf("%s: CRC check failed on blob \"%s\"\n", VOGL_FUNCTION_INFO_CSTR, b.m_id.get_ptr());
 
+            mz_free(pComp_data);
+            return NULL;
+        }
+
+        return pComp_data;
+    }
+
+    const size_t size = static_cast<size_t>(stat.m_uncomp_size);
+    void *pBuf = vogl_malloc(math::maximum<size_t>(size, 1U));
+    if (!pBuf)
+    {
+        mz_free(pComp_data);
         return NULL;
     }
 
-    VOGL_VERIFY(size == it->second.m_size);
+    // Blobs written by mz_parallel::deflate() can be inflated in parallel blocks. If the index is missing or doesn't work out, inflate serially.
+    mz_parallel::block_index comp_index;
+    mz_uint32 crc32 = 0;
+    bool success = false;
+    if ((g_number_of_processors > 1) && (comp_index.deserialize(stat.m_comment)))
+    {
+        success = (mz_parallel::inflate(pBuf, size, pComp_data, comp_size, 0, &comp_index, &crc32)) && (crc32 == stat.m_crc32);
+        if (!success)
+            vogl_warning_printf("%s: Parallel inflate of blob \"%s\" failed, falling back to serial inflate\n", VOGL_FUNCTION_INFO_CSTR, b.m_id.get_ptr());
+    }
+
+    if (!success)
+        success = (mz_parallel::inflate(pBuf, size, pComp_data, comp_size, 0, NULL, &crc32)) && (crc32 == stat.m_crc32);
+
+    mz_free(pComp_data);
+
+    if (!success)
+    {
+        vogl_error_printf("%s: Failed inflating blob \"%s\"\n", VOGL_FUNCTION_INFO_CSTR, b.m_id.get_ptr());
+
+        vogl_free(pBuf);
+        return NULL;
+    }
 
-    return vogl_new(vogl::buffer_stream, pBuf, size);
+    return pBuf;
 }
 
 void vogl_archive_blob_manager::close(vogl::data_stream *pStream) const
@@ -1252,6 +1396,20 @@ vogl::data_stream *vogl_multi_blob_manager::open(const dynamic_string &id) const
 {
     VOGL_FUNC_TRACER
 
+    return open_internal(id, false);
+}
+
+vogl::data_stream *vogl_multi_blob_manager::open_concurrent(const dynamic_string &id) const
+{
+    VOGL_FUNC_TRACER
+
+    return open_internal(id, true);
+}
+
+vogl::data_stream *vogl_multi_blob_manager::open_internal(const dynamic_string &id, bool concurrent) const
+{
+    VOGL_FUNC_TRACER
+
     if (!is_initialized())
     {
         VOGL_ASSERT(0);
@@ -1263,7 +1421,7 @@ vogl::data_stream *vogl_multi_blob_manager::open(const dynamic_string &id) const
         if (!m_blob_managers[i]->is_initialized())
             continue;
 
-        vogl::data_stream *pStream = m_blob_managers[i]->open(id);
+        vogl::data_stream *pStream = concurrent ? m_blob_managers[i]->open_concurrent(id) : m_blob_managers[i]->open(id);
         if (pStream)
         {
             VOGL_ASSERT(!pStream->get_user_data());
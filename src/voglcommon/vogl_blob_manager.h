@@ -30,6 +30,7 @@
 #include "vogl_map.h"
 #include "vogl_data_stream.h"
 #include "vogl_miniz_zip.h"
+#include "vogl_threading.h"
 
 enum vogl_blob_manager_type_t
 {
@@ -51,6 +52,9 @@ enum vogl_blob_manager_flags_t
 
 //----------------------------------------------------------------------------------------------------------------------
 // class vogl_blob_manager
+// get(), add_buf_compute_unique_id(), add_stream_compute_unique_id() and add_stream_using_id() may be called from
+// multiple threads at once (snapshot objects are serialized in parallel). IDs are computed outside of the lock, and
+// the underlying open()/add_buf_using_id() calls go through open_concurrent()/add_buf_using_id_concurrent().
 //----------------------------------------------------------------------------------------------------------------------
 class vogl_blob_manager
 {
@@ -80,6 +84,10 @@ public:
 
     virtual bool get(const dynamic_string &id, vogl::uint8_vec &data) const;
 
+    // Like open(), but safe to call from multiple threads (like get()). Lets callers read a blob incrementally instead of
+    // loading all of it. Returns NULL on failure, otherwise the stream must be released with close().
+    vogl::data_stream *get_stream(const dynamic_string &id) const;
+
     virtual vogl::dynamic_string add_buf_compute_unique_id(const void *pData, uint size, const vogl::dynamic_string &prefix, const dynamic_string &ext, const uint64_t *pCRC64 = NULL);
     virtual vogl::dynamic_string add_stream_compute_unique_id(vogl::data_stream &stream, const vogl::dynamic_string &prefix, const dynamic_string &ext, const uint64_t *pCRC64 = NULL);
 
@@ -126,7 +134,16 @@ protected:
         return true;
     }
 
+    // Called by the thread safe functions above. By default they serialize open()/add_buf_using_id() on m_mutex. Managers whose
+    // open()/add_buf_using_id() only lock around their shared state (and do the (de)compression outside of it) override these.
+    virtual vogl::data_stream *open_concurrent(const vogl::dynamic_string &id) const;
+    virtual vogl::dynamic_string add_buf_using_id_concurrent(const void *pData, uint size, const vogl::dynamic_string &id);
+
     bool m_initialized;
+
+    mutable vogl::mutex m_mutex;
+
+    friend class vogl_multi_blob_manager;
 };
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -334,6 +351,17 @@ public:
 
     virtual vogl::dynamic_string_array enumerate() const;
 
+protected:
+    // open() and add_buf_using_id() lock m_mutex themselves, only around the archive accesses.
+    virtual vogl::data_stream *open_concurrent(const vogl::dynamic_string &id) const
+    {
+        return open(id);
+    }
+    virtual vogl::dynamic_string add_buf_using_id_concurrent(const void *pData, uint size, const vogl::dynamic_string &id)
+    {
+        return add_buf_using_id(pData, size, id);
+    }
+
 private:
     mutable mz_zip_archive m_zip;
     dynamic_string m_archive_filename;
@@ -358,6 +386,7 @@ private:
 
     vogl::dynamic_string get_filename(const vogl::dynamic_string &id) const;
     bool populate_blob_map();
+    void *inflate_blob(const blob &b, const mz_zip_archive_file_stat &stat, void *pComp_data, size_t comp_size) const;
 };
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -406,8 +435,14 @@ public:
 
     virtual vogl::dynamic_string_array enumerate() const;
 
+protected:
+    // Goes through each manager's open_concurrent(), instead of serializing all of them on this manager's lock.
+    virtual vogl::data_stream *open_concurrent(const vogl::dynamic_string &id) const;
+
 private:
     vogl_blob_manager_ptr_vec m_blob_managers;
+
+    vogl::data_stream *open_internal(const dynamic_string &id, bool concurrent) const;
 };
 
 #endif // VOGL_BLOB_MANAGER_H
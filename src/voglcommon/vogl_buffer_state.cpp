@@ -31,6 +31,7 @@
 vogl_buffer_state::vogl_buffer_state()
     : m_snapshot_handle(0),
       m_target(GL_NONE),
+      m_data_skipped(false),
       m_is_valid(false)
 {
     VOGL_FUNC_TRACER
@@ -46,6 +47,13 @@ bool vogl_buffer_state::snapshot(const vogl_context_info &context_info, vogl_han
 {
     VOGL_FUNC_TRACER
 
+    return snapshot(context_info, remapper, handle, target, 0);
+}
+
+bool vogl_buffer_state::snapshot(const vogl_context_info &context_info, vogl_handle_remapper &remapper, GLuint64 handle, GLenum target, uint64_t max_static_data_size)
+{
+    VOGL_FUNC_TRACER
+
     VOGL_NOTE_UNUSED(remapper);
     VOGL_NOTE_UNUSED(context_info);
 
@@ -113,7 +121,15 @@ bool vogl_buffer_state::snapshot(const vogl_context_info &context_info, vogl_han
             return false;
         }
 
-        if (buf_size)
+        if ((buf_size) && (max_static_data_size) && (static_cast<uint64_t>(buf_size) > max_static_data_size) &&
+            (utils::is_in_set(m_params.get_value<int>(GL_BUFFER_USAGE), GL_STATIC_DRAW, GL_STATIC_READ, GL_STATIC_COPY)))
+        {
+            vogl_warning_printf("%s: Skipping contents of static buffer %" PRIu64 " target %s size %i, it's larger than the capture budget's limit of %" PRIu64 " bytes\n", VOGL_FUNCTION_INFO_CSTR,
+                               (uint64_t)handle, get_gl_enums().find_gl_name(target), buf_size, max_static_data_size);
+
+            m_data_skipped = true;
+        }
+        else if (buf_size)
         {
             if (!m_buffer_data.try_resize(buf_size))
             {
@@ -155,9 +171,8 @@ bool vogl_buffer_state::restore(const vogl_context_info &context_info, vogl_hand
 {
     VOGL_FUNC_TRACER
 
-    VOGL_NOTE_UNUSED(context_info);
-
     int buf_usage = 0, buf_size = 0;
+    bool use_dsa = false;
 
     if (!m_is_valid)
         return false;
@@ -183,24 +198,36 @@ bool vogl_buffer_state::restore(const vogl_context_info &context_info, vogl_hand
 
     if (m_target != GL_NONE)
     {
-        vogl_scoped_binding_state orig_bindings(m_target);
-
-        GL_ENTRYPOINT(glBindBuffer)(m_target, static_cast<GLuint>(handle));
-        if (vogl_check_gl_error())
-            goto handle_failure;
-
         buf_usage = m_params.get_value<int>(GL_BUFFER_USAGE);
         buf_size = m_params.get_value<int>(GL_BUFFER_SIZE);
 
-        if (buf_size != static_cast<int>(m_buffer_data.size()))
+        if ((!m_data_skipped) && (buf_size != static_cast<int>(m_buffer_data.size())))
         {
             VOGL_ASSERT_ALWAYS;
             goto handle_failure;
         }
 
-        GL_ENTRYPOINT(glBufferData)(m_target, buf_size, m_buffer_data.get_ptr(), buf_usage);
-        if (vogl_check_gl_error())
-            goto handle_failure;
+        // With DSA we can upload straight to the object, instead of saving/binding/restoring the target's binding.
+        use_dsa = context_info.supports_extension("GL_EXT_direct_state_access") && GL_ENTRYPOINT(glNamedBufferDataEXT);
+
+        if (use_dsa)
+        {
+            GL_ENTRYPOINT(glNamedBufferDataEXT)(static_cast<GLuint>(handle), buf_size, m_data_skipped ? NULL : m_buffer_data.get_ptr(), buf_usage);
+            if (vogl_check_gl_error())
+                goto handle_failure;
+        }
+        else
+        {
+            vogl_scoped_binding_state orig_bindings(m_target);
+
+            GL_ENTRYPOINT(glBindBuffer)(m_target, static_cast<GLuint>(handle));
+            if (vogl_check_gl_error())
+                goto handle_failure;
+
+            GL_ENTRYPOINT(glBufferData)(m_target, buf_size, m_data_skipped ? NULL : m_buffer_data.get_ptr(), buf_usage);
+            if (vogl_check_gl_error())
+                goto handle_failure;
+        }
     }
 
     return true;
@@ -208,8 +235,11 @@ bool vogl_buffer_state::restore(const vogl_context_info &context_info, vogl_hand
 handle_failure:
     vogl_error_printf("%s: Failed restoring trace buffer %u target %s size %u\n", VOGL_FUNCTION_INFO_CSTR, m_snapshot_handle, get_gl_enums().find_gl_name(m_target), buf_size);
 
-    GL_ENTRYPOINT(glBindBuffer)(m_target, 0);
-    VOGL_CHECK_GL_ERROR;
+    if (!use_dsa)
+    {
+        GL_ENTRYPOINT(glBindBuffer)(m_target, 0);
+        VOGL_CHECK_GL_ERROR;
+    }
 
     if ((handle) && (created_handle))
     {
@@ -252,6 +282,7 @@ void vogl_buffer_state::clear()
     m_map_access = 0;
     m_map_range = false;
     m_is_mapped = false;
+    m_data_skipped = false;
 }
 
 bool vogl_buffer_state::serialize(json_node &node, vogl_blob_manager &blob_manager) const
@@ -281,6 +312,7 @@ bool vogl_buffer_state::serialize(json_node &node, vogl_blob_manager &blob_manag
     node.add_key_value("handle", m_snapshot_handle);
     node.add_key_value("target", get_gl_enums().find_gl_name(m_target));
     node.add_key_value("buffer_data_blob_id", blob_id);
+    node.add_key_value("data_skipped", m_data_skipped);
 
     node.add_key_value("map_ofs", m_map_ofs);
     node.add_key_value("map_size", m_map_size);
@@ -319,7 +351,9 @@ bool vogl_buffer_state::deserialize(const json_node &node, const vogl_blob_manag
 
         int buf_size = m_params.get_value<int>(GL_BUFFER_SIZE);
 
-        if (buf_size)
+        m_data_skipped = node.value_as_bool("data_skipped");
+
+        if ((buf_size) && (!m_data_skipped))
         {
             dynamic_string blob_id(node.value_as_string_ptr("buffer_data_blob_id"));
             if (blob_id.is_empty())
@@ -335,7 +369,7 @@ bool vogl_buffer_state::deserialize(const json_node &node, const vogl_blob_manag
             }
         }
 
-        if (buf_size != static_cast<int>(m_buffer_data.size()))
+        if ((!m_data_skipped) && (buf_size != static_cast<int>(m_buffer_data.size())))
         {
             clear();
             return false;
@@ -372,7 +406,7 @@ bool vogl_buffer_state::compare_restorable_state(const vogl_gl_object_state &rhs
     if (m_target != rhs.m_target)
         return false;
 
-    if (m_buffer_data != rhs.m_buffer_data)
+    if ((m_data_skipped != rhs.m_data_skipped) || (m_buffer_data != rhs.m_buffer_data))
         return false;
 
     if (m_params != rhs.m_params)
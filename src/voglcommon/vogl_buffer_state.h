@@ -53,6 +53,10 @@ public:
 
     virtual bool snapshot(const vogl_context_info &context_info, vogl_handle_remapper &remapper, GLuint64 handle, GLenum target);
 
+    // Same as above, but if the buffer's usage is GL_STATIC_* and it's larger than max_static_data_size bytes its contents aren't read back. The
+    // buffer is restored with the right size and usage but undefined contents. 0 means no limit. Used to stay within a capture budget.
+    bool snapshot(const vogl_context_info &context_info, vogl_handle_remapper &remapper, GLuint64 handle, GLenum target, uint64_t max_static_data_size);
+
     void set_mapped_buffer_snapshot_state(const vogl_mapped_buffer_desc &map_desc);
 
     virtual bool restore(const vogl_context_info &context_info, vogl_handle_remapper &remapper, GLuint64 &handle) const;
@@ -85,6 +89,10 @@ public:
     {
         return m_buffer_data;
     }
+    bool get_data_skipped() const
+    {
+        return m_data_skipped;
+    }
     const vogl_state_vector &get_params() const
     {
         return m_params;
@@ -112,6 +120,7 @@ private:
     bool m_map_range;
     bool m_is_mapped;
 
+    bool m_data_skipped;
     bool m_is_valid;
 };
 
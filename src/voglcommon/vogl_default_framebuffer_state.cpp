@@ -117,10 +117,12 @@ bool vogl_default_framebuffer_state::snapshot(const vogl_context_info &context_i
 
     m_fb_attribs = fb_attribs;
 
-    // Create compatible GL texture
-    // Attach this texture to an FBO
-    // Blit default framebuffer to this FBO
-    // Capture this texture's state
+    // For each buffer:
+    //   Create compatible GL texture
+    //   Attach this texture to an FBO
+    //   Blit default framebuffer to this FBO
+    // Then read all the textures back into pixel pack buffers, and finally capture the textures' state (mapping the buffers).
+    // Nothing waits on the GPU until the first buffer is mapped. MSAA textures go through the texture splitter and are read back synchronously.
 
     vogl_scoped_state_saver framebuffer_state_saver(cGSTReadBuffer, cGSTDrawBuffer);
 
@@ -150,6 +152,9 @@ bool vogl_default_framebuffer_state::snapshot(const vogl_context_info &context_i
     // TODO: Test multisampled default framebuffers
     const GLenum tex_target = (fb_attribs.m_samples > 1) ? GL_TEXTURE_2D_MULTISAMPLE : GL_TEXTURE_2D;
 
+    GLuint tex_handles[cDefFramebufferTotal];
+    utils::zero_object(tex_handles);
+
     for (uint i = 0; i < cDefFramebufferTotal; i++)
     {
         GLenum internal_fmt, pixel_fmt, pixel_type;
@@ -261,13 +266,8 @@ bool vogl_default_framebuffer_state::snapshot(const vogl_context_info &context_i
 
         if (status)
         {
-            vogl_handle_remapper def_handle_remapper;
-            status = m_textures[i].snapshot(context_info, def_handle_remapper, tex_handle, tex_target);
-
-            if (!status)
-            {
-                vogl_error_printf("%s: Failed snapshotting texture for default framebuffer %s\n", VOGL_FUNCTION_INFO_CSTR, get_gl_enums().find_gl_name(g_def_framebuffer_enums[i]));
-            }
+            // Keep the texture around until all the blits have been issued.
+            tex_handles[i] = tex_handle;
         }
         else
         {
@@ -287,7 +287,33 @@ bool vogl_default_framebuffer_state::snapshot(const vogl_context_info &context_i
         GL_ENTRYPOINT(glBindTexture)(tex_target, 0);
         VOGL_CHECK_GL_ERROR;
 
-        GL_ENTRYPOINT(glDeleteTextures)(1, &tex_handle);
+        if (!status)
+        {
+            GL_ENTRYPOINT(glDeleteTextures)(1, &tex_handle);
+            VOGL_CHECK_GL_ERROR;
+        }
+    }
+
+    vogl_texture_readback_queue readbacks;
+
+    for (uint i = 0; i < cDefFramebufferTotal; i++)
+    {
+        if (tex_handles[i])
+            readbacks.queue(context_info, tex_handles[i], tex_target);
+    }
+
+    for (uint i = 0; i < cDefFramebufferTotal; i++)
+    {
+        if (!tex_handles[i])
+            continue;
+
+        vogl_handle_remapper def_handle_remapper;
+        if (!m_textures[i].snapshot(context_info, def_handle_remapper, tex_handles[i], tex_target, false, &readbacks))
+        {
+            vogl_error_printf("%s: Failed snapshotting texture for default framebuffer %s\n", VOGL_FUNCTION_INFO_CSTR, get_gl_enums().find_gl_name(g_def_framebuffer_enums[i]));
+        }
+
+        GL_ENTRYPOINT(glDeleteTextures)(1, &tex_handles[i]);
         VOGL_CHECK_GL_ERROR;
     }
 
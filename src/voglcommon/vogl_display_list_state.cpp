@@ -25,13 +25,16 @@
 
 // File: vogl_display_list_state.cpp
 #include "vogl_display_list_state.h"
+#include "vogl_fixed_function_shadow.h"
 
 vogl_display_list::vogl_display_list()
     : m_handle(0),
       m_xfont_glyph(0),
       m_xfont(false),
       m_generating(false),
-      m_valid(false)
+      m_valid(false),
+      m_has_unlisted_calls(false),
+      m_bind_status(cBindsNotParsed)
 {
     VOGL_FUNC_TRACER
 }
@@ -46,6 +49,8 @@ void vogl_display_list::clear()
     m_packets.clear();
     m_generating = false;
     m_valid = false;
+    m_has_unlisted_calls = false;
+    invalidate_parsed_packets();
 }
 
 void vogl_display_list::init_xfont(const char *pName, int glyph)
@@ -53,6 +58,7 @@ void vogl_display_list::init_xfont(const char *pName, int glyph)
     VOGL_FUNC_TRACER
 
     m_packets.clear();
+    invalidate_parsed_packets();
     m_xfont_name = pName ? pName : "";
     m_xfont_glyph = glyph;
     m_xfont = true;
@@ -77,6 +83,116 @@ void vogl_display_list::end_gen()
     m_valid = true;
 }
 
+void vogl_display_list::parse_packets()
+{
+    VOGL_FUNC_TRACER
+
+    m_binds.resize(0);
+    m_bind_status = cBindsValid;
+    m_fixed_function_packets.resize(0);
+
+    vogl_trace_packet trace_packet(&get_vogl_process_gl_ctypes());
+
+    for (uint packet_index = 0; packet_index < m_packets.size(); packet_index++)
+    {
+        if (m_packets.get_packet_type(packet_index) != cTSPTGLEntrypoint)
+        {
+            VOGL_ASSERT_ALWAYS;
+            continue;
+        }
+
+        const vogl_trace_gl_entrypoint_packet &gl_packet = m_packets.get_packet<vogl_trace_gl_entrypoint_packet>(packet_index);
+        const gl_entrypoint_id_t entrypoint_id = static_cast<gl_entrypoint_id_t>(gl_packet.m_entrypoint_id);
+
+        // Replayed into the fixed function shadow when the list is called, see vogl_display_list_state::update_fixed_function_shadow().
+        if ((entrypoint_id == VOGL_ENTRYPOINT_glCallList) || (entrypoint_id == VOGL_ENTRYPOINT_glCallLists) || (vogl_fixed_function_shadow::is_shadowed_entrypoint(entrypoint_id)))
+            m_fixed_function_packets.push_back(packet_index);
+
+        if (m_bind_status != cBindsValid)
+            continue;
+
+        // Quickly skip by those packets we don't care about
+        switch (entrypoint_id)
+        {
+            case VOGL_ENTRYPOINT_glBindTexture:
+            case VOGL_ENTRYPOINT_glBindTextureEXT:
+            case VOGL_ENTRYPOINT_glBindMultiTextureEXT:
+            case VOGL_ENTRYPOINT_glBindBuffer:
+            case VOGL_ENTRYPOINT_glBindVertexArray:
+            case VOGL_ENTRYPOINT_glBeginQuery:
+            case VOGL_ENTRYPOINT_glBeginQueryARB:
+            case VOGL_ENTRYPOINT_glCallList:
+            case VOGL_ENTRYPOINT_glCallLists:
+                break;
+            default:
+                continue;
+        }
+
+        if (!trace_packet.deserialize(m_packets.get_packet_buf(packet_index), false))
+        {
+            vogl_error_printf("%s: Failed parsing GL entrypoint packet in display list %u\n", VOGL_FUNCTION_INFO_CSTR, m_handle);
+            VOGL_ASSERT_ALWAYS;
+            m_bind_status = cBindsParseFailed;
+            continue;
+        }
+
+        bind_desc bind;
+        switch (trace_packet.get_entrypoint_id())
+        {
+            case VOGL_ENTRYPOINT_glBindTexture:
+            case VOGL_ENTRYPOINT_glBindTextureEXT:
+            {
+                bind.m_namespace = VOGL_NAMESPACE_TEXTURES;
+                bind.m_target = trace_packet.get_param_value<GLenum>(0);
+                bind.m_handle = trace_packet.get_param_value<GLuint>(1);
+                break;
+            }
+            case VOGL_ENTRYPOINT_glBindMultiTextureEXT:
+            {
+                bind.m_namespace = VOGL_NAMESPACE_TEXTURES;
+                bind.m_target = trace_packet.get_param_value<GLenum>(1);
+                bind.m_handle = trace_packet.get_param_value<GLuint>(2);
+                break;
+            }
+            case VOGL_ENTRYPOINT_glBindBuffer:
+            {
+                bind.m_namespace = VOGL_NAMESPACE_BUFFERS;
+                bind.m_target = trace_packet.get_param_value<GLenum>(0);
+                bind.m_handle = trace_packet.get_param_value<GLuint>(1);
+                break;
+            }
+            case VOGL_ENTRYPOINT_glBindVertexArray:
+            {
+                bind.m_namespace = VOGL_NAMESPACE_VERTEX_ARRAYS;
+                bind.m_target = GL_NONE;
+                bind.m_handle = trace_packet.get_param_value<GLuint>(0);
+                break;
+            }
+            case VOGL_ENTRYPOINT_glBeginQuery:
+            case VOGL_ENTRYPOINT_glBeginQueryARB:
+            {
+                bind.m_namespace = VOGL_NAMESPACE_QUERIES;
+                bind.m_target = trace_packet.get_param_value<GLenum>(0);
+                bind.m_handle = trace_packet.get_param_value<GLuint>(1);
+                break;
+            }
+            case VOGL_ENTRYPOINT_glCallList:
+            case VOGL_ENTRYPOINT_glCallLists:
+            {
+                m_bind_status = cBindsHasNestedCalls;
+                continue;
+            }
+            default:
+            {
+                VOGL_ASSERT_ALWAYS;
+                continue;
+            }
+        }
+
+        m_binds.push_back(bind);
+    }
+}
+
 bool vogl_display_list::serialize(json_node &node, vogl_blob_manager &blob_manager, const vogl_ctypes *pCtypes) const
 {
     VOGL_FUNC_TRACER
@@ -398,106 +514,101 @@ bool vogl_display_list_state::add_packet_to_list(GLuint handle, gl_entrypoint_id
         return false;
     }
 
-    pList->get_packets().push_back(buf);
+    pList->get_packets().push_back(VOGL_MOVE(buf));
     return true;
 }
 
-bool vogl_display_list_state::parse_list_and_update_shadows(GLuint handle, pBind_callback_func_ptr pBind_callback, void *pBind_callback_opaque)
+// Replays the fixed function calls of a called list, and of the lists it calls, into the shadow.
+void vogl_display_list_state::update_fixed_function_shadow(vogl_display_list &list, vogl_fixed_function_shadow &shadow, uint nesting_level)
 {
     VOGL_FUNC_TRACER
 
-    VOGL_ASSERT(pBind_callback);
+    // GL_MAX_LIST_NESTING is at least 64
+    const uint cMaxListNesting = 64;
 
-    const vogl_display_list *pList = find_list(handle);
-    if (!pList)
-        return false;
+    if ((list.has_unlisted_calls()) || (list.get_bind_status() == vogl_display_list::cBindsParseFailed) || (nesting_level >= cMaxListNesting))
+    {
+        shadow.call_unknown_list();
+        return;
+    }
+
+    const uint_vec &packet_indices = list.get_fixed_function_packets();
+    if (packet_indices.is_empty())
+        return;
 
-    const vogl_trace_packet_array &packets = pList->get_packets();
+    const vogl_display_list &const_list = list;
+    const vogl_trace_packet_array &packets = const_list.get_packets();
 
     vogl_trace_packet trace_packet(&get_vogl_process_gl_ctypes());
 
-    for (uint packet_index = 0; packet_index < packets.size(); packet_index++)
+    for (uint i = 0; i < packet_indices.size(); i++)
     {
-        if (packets.get_packet_type(packet_index) != cTSPTGLEntrypoint)
+        if (!trace_packet.deserialize(packets.get_packet_buf(packet_indices[i]), false))
         {
-            VOGL_ASSERT_ALWAYS;
-            continue;
-        }
-
-        // Quickly skip by those packets we don't care about
-        // TODO: If display lists are used a lot we could precompute a flag for each one that indicates whether or not they should be parsed for binds.
-        const vogl_trace_gl_entrypoint_packet &gl_packet = packets.get_packet<vogl_trace_gl_entrypoint_packet>(packet_index);
-        switch (gl_packet.m_entrypoint_id)
-        {
-            case VOGL_ENTRYPOINT_glBindTexture:
-            case VOGL_ENTRYPOINT_glBindTextureEXT:
-            case VOGL_ENTRYPOINT_glBindMultiTextureEXT:
-            case VOGL_ENTRYPOINT_glBindBuffer:
-            case VOGL_ENTRYPOINT_glBindVertexArray:
-            case VOGL_ENTRYPOINT_glBeginQuery:
-            case VOGL_ENTRYPOINT_glBeginQueryARB:
-            case VOGL_ENTRYPOINT_glCallList:
-            case VOGL_ENTRYPOINT_glCallLists:
-                break;
-            default:
-                continue;
-        }
-
-        if (!trace_packet.deserialize(packets.get_packet_buf(packet_index), false))
-        {
-            vogl_error_printf("%s: Failed parsing GL entrypoint packet in display list %u\n", VOGL_FUNCTION_INFO_CSTR, handle);
-            VOGL_ASSERT_ALWAYS;
-            return false;
+            vogl_error_printf("%s: Failed parsing GL entrypoint packet in display list %u\n", VOGL_FUNCTION_INFO_CSTR, list.get_handle());
+            shadow.call_unknown_list();
+            return;
         }
 
         switch (trace_packet.get_entrypoint_id())
         {
-            case VOGL_ENTRYPOINT_glBindTexture:
-            case VOGL_ENTRYPOINT_glBindTextureEXT:
-            {
-                (*pBind_callback)(VOGL_NAMESPACE_TEXTURES, trace_packet.get_param_value<GLenum>(0), trace_packet.get_param_value<GLuint>(1), pBind_callback_opaque);
-                break;
-            }
-            case VOGL_ENTRYPOINT_glBindMultiTextureEXT:
-            {
-                (*pBind_callback)(VOGL_NAMESPACE_TEXTURES, trace_packet.get_param_value<GLenum>(1), trace_packet.get_param_value<GLuint>(2), pBind_callback_opaque);
-                break;
-            }
-            case VOGL_ENTRYPOINT_glBindBuffer:
-            {
-                (*pBind_callback)(VOGL_NAMESPACE_BUFFERS, trace_packet.get_param_value<GLenum>(0), trace_packet.get_param_value<GLuint>(1), pBind_callback_opaque);
-                break;
-            }
-            case VOGL_ENTRYPOINT_glBindVertexArray:
-            {
-                (*pBind_callback)(VOGL_NAMESPACE_VERTEX_ARRAYS, GL_NONE, trace_packet.get_param_value<GLuint>(0), pBind_callback_opaque);
-                break;
-            }
-            case VOGL_ENTRYPOINT_glBeginQuery:
-            case VOGL_ENTRYPOINT_glBeginQueryARB:
+            case VOGL_ENTRYPOINT_glCallList:
             {
-                (*pBind_callback)(VOGL_NAMESPACE_QUERIES, trace_packet.get_param_value<GLenum>(0), trace_packet.get_param_value<GLuint>(1), pBind_callback_opaque);
+                vogl_display_list *pNested_list = find_list(trace_packet.get_param_value<GLuint>(0));
+                if (pNested_list)
+                    update_fixed_function_shadow(*pNested_list, shadow, nesting_level + 1);
                 break;
             }
-            case VOGL_ENTRYPOINT_glCallList:
             case VOGL_ENTRYPOINT_glCallLists:
             {
-                vogl_warning_printf("%s: Recursive display lists are not currently supported\n", VOGL_FUNCTION_INFO_CSTR);
-                VOGL_ASSERT_ALWAYS;
-                return false;
+                // The lists called depend on the list base, which the list itself may change.
+                shadow.call_unknown_list();
+                break;
             }
             default:
             {
-                VOGL_ASSERT_ALWAYS;
+                shadow.update(trace_packet);
                 break;
             }
         }
     }
+}
+
+bool vogl_display_list_state::parse_list_and_update_shadows(GLuint handle, pBind_callback_func_ptr pBind_callback, void *pBind_callback_opaque, vogl_fixed_function_shadow *pFixed_function_shadow)
+{
+    VOGL_FUNC_TRACER
+
+    VOGL_ASSERT(pBind_callback);
+
+    vogl_display_list *pList = find_list(handle);
+    if (!pList)
+        return false;
+
+    if (pFixed_function_shadow)
+        update_fixed_function_shadow(*pList, *pFixed_function_shadow, 0);
+
+    const vogl_display_list::bind_desc_vec &binds = pList->get_binds();
+    for (uint i = 0; i < binds.size(); i++)
+        (*pBind_callback)(binds[i].m_namespace, binds[i].m_target, binds[i].m_handle, pBind_callback_opaque);
+
+    switch (pList->get_bind_status())
+    {
+        case vogl_display_list::cBindsHasNestedCalls:
+        {
+            vogl_warning_printf("%s: Recursive display lists are not currently supported\n", VOGL_FUNCTION_INFO_CSTR);
+            VOGL_ASSERT_ALWAYS;
+            return false;
+        }
+        case vogl_display_list::cBindsParseFailed:
+            return false;
+        default:
+            break;
+    }
 
     return true;
 }
 
-bool vogl_display_list_state::parse_lists_and_update_shadows(GLsizei n, GLenum type, const GLvoid *lists, pBind_callback_func_ptr pBind_callback, void *pBind_callback_opaque)
+bool vogl_display_list_state::parse_lists_and_update_shadows(GLsizei n, GLenum type, const GLvoid *lists, pBind_callback_func_ptr pBind_callback, void *pBind_callback_opaque, vogl_fixed_function_shadow *pFixed_function_shadow)
 {
     VOGL_FUNC_TRACER
 
@@ -602,7 +713,7 @@ bool vogl_display_list_state::parse_lists_and_update_shadows(GLsizei n, GLenum t
         }
         else
         {
-            if (!parse_list_and_update_shadows(handle, pBind_callback, pBind_callback_opaque))
+            if (!parse_list_and_update_shadows(handle, pBind_callback, pBind_callback_opaque, pFixed_function_shadow))
                 success = false;
         }
     }
@@ -33,12 +33,31 @@
 #include "vogl_blob_manager.h"
 #include "vogl_trace_file_reader.h"
 
+class vogl_fixed_function_shadow;
+
 //----------------------------------------------------------------------------------------------------------------------
 // class vogl_display_list
 //----------------------------------------------------------------------------------------------------------------------
 class vogl_display_list
 {
 public:
+    // A bind made by one of the list's packets that the object shadows care about.
+    struct bind_desc
+    {
+        vogl_namespace_t m_namespace;
+        GLenum m_target;
+        GLuint m_handle;
+    };
+    typedef vogl::vector<bind_desc> bind_desc_vec;
+
+    enum bind_status_t
+    {
+        cBindsNotParsed,
+        cBindsValid,
+        cBindsHasNestedCalls, // the binds stop at the first glCallList/glCallLists
+        cBindsParseFailed     // the binds stop at the packet that couldn't be deserialized
+    };
+
     vogl_display_list();
 
     void clear();
@@ -80,9 +99,43 @@ public:
     }
     vogl_trace_packet_array &get_packets()
     {
+        invalidate_parsed_packets();
         return m_packets;
     }
 
+    // The list's binds in call order. Parsed from the packets on first use, and cached until the packets change.
+    const bind_desc_vec &get_binds()
+    {
+        if (m_bind_status == cBindsNotParsed)
+            parse_packets();
+        return m_binds;
+    }
+    bind_status_t get_bind_status()
+    {
+        if (m_bind_status == cBindsNotParsed)
+            parse_packets();
+        return m_bind_status;
+    }
+
+    // Indices of the packets that may change fixed function state, and of the glCallList(s) packets, in call order.
+    const uint_vec &get_fixed_function_packets()
+    {
+        if (m_bind_status == cBindsNotParsed)
+            parse_packets();
+        return m_fixed_function_packets;
+    }
+
+    // True if a call made while composing the list couldn't be added to it, so the packets don't show everything
+    // executing the list does.
+    bool has_unlisted_calls() const
+    {
+        return m_has_unlisted_calls;
+    }
+    void set_has_unlisted_calls()
+    {
+        m_has_unlisted_calls = true;
+    }
+
     void init_xfont(const char *pName, int glyph);
 
     void begin_gen();
@@ -100,6 +153,21 @@ private:
     bool m_xfont;
     bool m_generating;
     bool m_valid;
+
+    bool m_has_unlisted_calls;
+
+    bind_desc_vec m_binds;
+    bind_status_t m_bind_status;
+    uint_vec m_fixed_function_packets;
+
+    void invalidate_parsed_packets()
+    {
+        m_binds.clear();
+        m_fixed_function_packets.clear();
+        m_bind_status = cBindsNotParsed;
+    }
+
+    void parse_packets();
 };
 
 typedef vogl::map<GLuint, vogl_display_list> vogl_display_list_map;
@@ -160,11 +228,14 @@ public:
 
     typedef void (*pBind_callback_func_ptr)(vogl_namespace_t handle_namespace, GLenum target, GLuint handle, void *pOpaque);
 
-    bool parse_list_and_update_shadows(GLuint handle, pBind_callback_func_ptr pBind_callback, void *pBind_callback_opaque);
-    bool parse_lists_and_update_shadows(GLsizei n, GLenum type, const GLvoid *lists, pBind_callback_func_ptr pBind_callback, void *pBind_callback_opaque);
+    // If pFixed_function_shadow isn't NULL the fixed function calls of the lists are replayed into it.
+    bool parse_list_and_update_shadows(GLuint handle, pBind_callback_func_ptr pBind_callback, void *pBind_callback_opaque, vogl_fixed_function_shadow *pFixed_function_shadow = NULL);
+    bool parse_lists_and_update_shadows(GLsizei n, GLenum type, const GLvoid *lists, pBind_callback_func_ptr pBind_callback, void *pBind_callback_opaque, vogl_fixed_function_shadow *pFixed_function_shadow = NULL);
 
 private:
     vogl_display_list_map m_display_lists;
+
+    void update_fixed_function_shadow(vogl_display_list &list, vogl_fixed_function_shadow &shadow, uint nesting_level);
 };
 
 #endif // VOGL_DISPLAY_LIST_STATE_H
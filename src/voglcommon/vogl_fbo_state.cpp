@@ -468,7 +468,12 @@ bool vogl_framebuffer_state::restore(const vogl_context_info &context_info, vogl
 
         uint num_valid_draw_buffers = last_valid_draw_buffer_idx + 1;
 
-        if (!num_valid_draw_buffers)
+        // A freshly generated FBO already draws to and reads from GL_COLOR_ATTACHMENT0, so skip those calls if they match.
+        if ((created_handle) && (num_valid_draw_buffers == 1) && (m_draw_buffers[0] == GL_COLOR_ATTACHMENT0))
+        {
+            // Nothing to do
+        }
+        else if (!num_valid_draw_buffers)
         {
             GL_ENTRYPOINT(glDrawBuffer)(GL_NONE);
             VOGL_CHECK_GL_ERROR;
@@ -484,8 +489,11 @@ bool vogl_framebuffer_state::restore(const vogl_context_info &context_info, vogl
             VOGL_CHECK_GL_ERROR;
         }
 
-        GL_ENTRYPOINT(glReadBuffer)(m_read_buffer);
-        VOGL_CHECK_GL_ERROR;
+        if ((!created_handle) || (m_read_buffer != GL_COLOR_ATTACHMENT0))
+        {
+            GL_ENTRYPOINT(glReadBuffer)(m_read_buffer);
+            VOGL_CHECK_GL_ERROR;
+        }
 
         GLenum cur_status;
         cur_status = GL_ENTRYPOINT(glCheckFramebufferStatus)(GL_DRAW_FRAMEBUFFER);
@@ -0,0 +1,1964 @@
+/**************************************************************************
+ *
+ * Copyright 2013-2014 RAD Game Tools and Valve Software
+ * Copyright 2010-2014 Rich Geldreich and Tenacious Software LLC
+ * All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ **************************************************************************/
+
+// File: vogl_fixed_function_shadow.cpp
+#include "vogl_fixed_function_shadow.h"
+#include "vogl_gl_utils.h"
+
+// GL keeps matrices and light/texgen params as floats, so the shadow rounds the same way.
+static inline double round_to_float(double val)
+{
+    return static_cast<float>(val);
+}
+
+// Matrices are column major, like GL's.
+static void set_identity(double *pMatrix)
+{
+    for (uint i = 0; i < 16; i++)
+        pMatrix[i] = ((i % 5) == 0) ? 1.0 : 0.0;
+}
+
+template <typename T>
+static void get_matrix(double *pDst, const T *pSrc, bool transpose)
+{
+    for (uint c = 0; c < 4; c++)
+        for (uint r = 0; r < 4; r++)
+            pDst[c * 4 + r] = transpose ? pSrc[r * 4 + c] : pSrc[c * 4 + r];
+}
+
+// vogl_state_vector::insert() keeps the existing value of a param, this replaces it.
+template <typename T>
+static void set_state(vogl_state_vector &state, GLenum pname, uint index, const T *pVals)
+{
+    vogl_state_data state_data;
+    if (state_data.init(pname, index, pVals, sizeof(T), false))
+        state.get_states()[state_data.get_id()] = state_data;
+}
+
+// Copies the client memory of a packet param, returns false if it holds less than n values.
+template <typename T>
+static bool get_param_array(const vogl_trace_packet &packet, uint param_index, T *pDst, uint n)
+{
+    const T *pSrc = packet.get_param_client_memory<T>(param_index);
+    if ((!pSrc) || (packet.get_param_client_memory_data_size(param_index) < n * sizeof(T)))
+        return false;
+
+    memcpy(pDst, pSrc, n * sizeof(T));
+    return true;
+}
+
+// The number of values of the glLight(), glMaterial(), glTexEnv() and glTexGen() params, 0 if GL rejects the pname.
+static uint get_light_param_count(GLenum pname)
+{
+    switch (pname)
+    {
+        case GL_AMBIENT:
+        case GL_DIFFUSE:
+        case GL_SPECULAR:
+        case GL_POSITION:
+            return 4;
+        case GL_SPOT_DIRECTION:
+            return 3;
+        case GL_SPOT_EXPONENT:
+        case GL_SPOT_CUTOFF:
+        case GL_CONSTANT_ATTENUATION:
+        case GL_LINEAR_ATTENUATION:
+        case GL_QUADRATIC_ATTENUATION:
+            return 1;
+        default:
+            break;
+    }
+
+    return 0;
+}
+
+static uint get_material_param_count(GLenum pname)
+{
+    switch (pname)
+    {
+        case GL_AMBIENT:
+        case GL_DIFFUSE:
+        case GL_SPECULAR:
+        case GL_EMISSION:
+        case GL_AMBIENT_AND_DIFFUSE:
+            return 4;
+        case GL_COLOR_INDEXES:
+            return 3;
+        case GL_SHININESS:
+            return 1;
+        default:
+            break;
+    }
+
+    return 0;
+}
+
+static uint get_tex_env_param_count(GLenum pname)
+{
+    return (pname == GL_TEXTURE_ENV_COLOR) ? 4 : 1;
+}
+
+static uint get_tex_gen_param_count(GLenum pname)
+{
+    return (pname == GL_TEXTURE_GEN_MODE) ? 1 : 4;
+}
+
+// Enum params passed as floats are converted like GL does.
+static GLenum get_enum_param(float val)
+{
+    return (val >= 0.0f) ? static_cast<GLenum>(val + .5f) : GL_NONE;
+}
+
+struct texenv_param_desc
+{
+    GLenum m_target;
+    GLenum m_pname;
+    bool m_is_float;
+};
+
+// Same params and types as vogl_texenv_state::snapshot().
+static const texenv_param_desc s_texenv_params[] =
+{
+    { GL_TEXTURE_FILTER_CONTROL, GL_TEXTURE_LOD_BIAS, true },
+    { GL_POINT_SPRITE, GL_COORD_REPLACE, false },
+    { GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, false },
+    { GL_TEXTURE_ENV, GL_TEXTURE_ENV_COLOR, true },
+    { GL_TEXTURE_ENV, GL_COMBINE_RGB, false },
+    { GL_TEXTURE_ENV, GL_COMBINE_ALPHA, false },
+    { GL_TEXTURE_ENV, GL_RGB_SCALE, true },
+    { GL_TEXTURE_ENV, GL_ALPHA_SCALE, true },
+    { GL_TEXTURE_ENV, GL_SRC0_RGB, false },
+    { GL_TEXTURE_ENV, GL_SRC1_RGB, false },
+    { GL_TEXTURE_ENV, GL_SRC2_RGB, false },
+    { GL_TEXTURE_ENV, GL_SRC0_ALPHA, false },
+    { GL_TEXTURE_ENV, GL_SRC1_ALPHA, false },
+    { GL_TEXTURE_ENV, GL_SRC2_ALPHA, false },
+    { GL_TEXTURE_ENV, GL_OPERAND0_RGB, false },
+    { GL_TEXTURE_ENV, GL_OPERAND1_RGB, false },
+    { GL_TEXTURE_ENV, GL_OPERAND2_RGB, false },
+    { GL_TEXTURE_ENV, GL_OPERAND0_ALPHA, false },
+    { GL_TEXTURE_ENV, GL_OPERAND1_ALPHA, false },
+    { GL_TEXTURE_ENV, GL_OPERAND2_ALPHA, false },
+    { GL_S, GL_TEXTURE_GEN_MODE, false },
+    { GL_S, GL_OBJECT_PLANE, true },
+    { GL_S, GL_EYE_PLANE, true },
+    { GL_T, GL_TEXTURE_GEN_MODE, false },
+    { GL_T, GL_OBJECT_PLANE, true },
+    { GL_T, GL_EYE_PLANE, true },
+    { GL_R, GL_TEXTURE_GEN_MODE, false },
+    { GL_R, GL_OBJECT_PLANE, true },
+    { GL_R, GL_EYE_PLANE, true },
+    { GL_Q, GL_TEXTURE_GEN_MODE, false },
+    { GL_Q, GL_OBJECT_PLANE, true },
+    { GL_Q, GL_EYE_PLANE, true }
+};
+
+vogl_fixed_function_shadow::vogl_fixed_function_shadow()
+    : m_enabled(false),
+      m_max_lights(0),
+      m_max_texture_units(0),
+      m_max_active_textures(0),
+      m_max_attrib_stack_depth(0),
+      m_has_color_matrix(false),
+      m_list_mode(GL_NONE),
+      m_in_begin(false),
+      m_matrix_mode(GL_NONE),
+      m_active_texture(cUnknown),
+      m_lights_valid(false),
+      m_material_valid(false),
+      m_color_material(cUnknown),
+      m_texenv_valid(false),
+      m_attrib_stack_known(false)
+{
+    VOGL_FUNC_TRACER
+}
+
+void vogl_fixed_function_shadow::init(const vogl_context_info &context_info)
+{
+    VOGL_FUNC_TRACER
+
+    *this = vogl_fixed_function_shadow();
+
+    if ((!context_info.is_valid()) || (context_info.is_core_profile()))
+        return;
+
+    VOGL_CHECK_GL_ERROR;
+
+    m_max_lights = context_info.get_max_lights();
+    m_max_texture_units = context_info.get_max_texture_units();
+    m_max_active_textures = math::maximum(context_info.get_max_texture_coords(), context_info.get_max_combined_texture_coords());
+
+    m_projection.init(vogl_get_gl_integer(GL_MAX_PROJECTION_STACK_DEPTH));
+    m_modelview.init(vogl_get_gl_integer(GL_MAX_MODELVIEW_STACK_DEPTH));
+
+    m_texture.resize(context_info.get_max_texture_coords());
+    const GLint max_texture_stack_depth = vogl_get_gl_integer(GL_MAX_TEXTURE_STACK_DEPTH);
+    for (uint i = 0; i < m_texture.size(); i++)
+        m_texture[i].init(max_texture_stack_depth);
+
+    m_program.resize(context_info.get_max_arb_program_matrices());
+    if (m_program.size())
+    {
+        const GLint max_program_stack_depth = vogl_get_gl_integer(GL_MAX_PROGRAM_MATRIX_STACK_DEPTH_ARB);
+        for (uint i = 0; i < m_program.size(); i++)
+            m_program[i].init(max_program_stack_depth);
+    }
+
+    m_max_attrib_stack_depth = vogl_get_gl_integer(GL_MAX_ATTRIB_STACK_DEPTH);
+
+    if (vogl_check_gl_error())
+    {
+        vogl_error_printf("%s: GL error while querying the max fixed function stack depths, nothing will be shadowed\n", VOGL_FUNCTION_INFO_CSTR);
+        *this = vogl_fixed_function_shadow();
+        return;
+    }
+
+    // The color matrix is part of the optional ARB_imaging subset.
+    GLint max_color_stack_depth = 0;
+    GL_ENTRYPOINT(glGetIntegerv)(GL_MAX_COLOR_MATRIX_STACK_DEPTH, &max_color_stack_depth);
+    m_has_color_matrix = !vogl_check_gl_error() && (max_color_stack_depth > 0);
+    if (m_has_color_matrix)
+        m_color.init(max_color_stack_depth);
+
+    m_enabled = true;
+    m_matrix_mode = GL_MODELVIEW;
+    m_active_texture = 0;
+
+    m_lights.resize(m_max_lights);
+    for (uint light = 0; light < m_max_lights; light++)
+    {
+        static const GLenum s_pnames[] = { GL_CONSTANT_ATTENUATION, GL_LINEAR_ATTENUATION, GL_QUADRATIC_ATTENUATION, GL_SPOT_EXPONENT, GL_SPOT_CUTOFF, GL_AMBIENT, GL_DIFFUSE, GL_SPECULAR, GL_POSITION, GL_SPOT_DIRECTION };
+        for (uint i = 0; i < VOGL_ARRAY_SIZE(s_pnames); i++)
+        {
+            float vals[4] = { 0, 0, 0, 0 };
+            vogl_get_default_light_parameter(light, s_pnames[i], vals);
+            set_state(m_lights[light], s_pnames[i], 0, vals);
+        }
+    }
+    m_lights_valid = true;
+
+    for (uint side = 0; side < cTotalSides; side++)
+    {
+        static const GLenum s_pnames[] = { GL_AMBIENT, GL_DIFFUSE, GL_SPECULAR, GL_EMISSION, GL_SHININESS, GL_COLOR_INDEXES };
+        for (uint i = 0; i < VOGL_ARRAY_SIZE(s_pnames); i++)
+        {
+            float vals[4] = { 0, 0, 0, 0 };
+            vogl_get_default_material_parameter(s_pnames[i], vals);
+            set_state(m_material[side], s_pnames[i], 0, vals);
+        }
+    }
+    m_material_valid = true;
+    m_color_material = GL_FALSE;
+
+    for (uint unit = 0; unit < m_max_texture_units; unit++)
+    {
+        for (uint i = 0; i < VOGL_ARRAY_SIZE(s_texenv_params); i++)
+        {
+            float vals[4] = { 0, 0, 0, 0 };
+            vogl_get_default_texenv_parameter(s_texenv_params[i].m_target, s_texenv_params[i].m_pname, vals);
+
+            if (s_texenv_params[i].m_is_float)
+            {
+                set_state(m_texenv[s_texenv_params[i].m_target], s_texenv_params[i].m_pname, unit, vals);
+            }
+            else
+            {
+                int ivals[4] = { static_cast<int>(vals[0]), static_cast<int>(vals[1]), static_cast<int>(vals[2]), static_cast<int>(vals[3]) };
+                set_state(m_texenv[s_texenv_params[i].m_target], s_texenv_params[i].m_pname, unit, ivals);
+            }
+        }
+    }
+    m_texenv_valid = true;
+
+    m_attrib_stack_known = true;
+}
+
+void vogl_fixed_function_shadow::invalidate()
+{
+    VOGL_FUNC_TRACER
+
+    invalidate_matrices();
+    invalidate_attrib_state();
+}
+
+void vogl_fixed_function_shadow::invalidate_matrices()
+{
+    VOGL_FUNC_TRACER
+
+    m_projection.m_valid = false;
+    m_modelview.m_valid = false;
+    m_color.m_valid = false;
+    for (uint i = 0; i < m_texture.size(); i++)
+        m_texture[i].m_valid = false;
+    for (uint i = 0; i < m_program.size(); i++)
+        m_program[i].m_valid = false;
+}
+
+// Everything glPopAttrib() may restore. The stack itself becomes unknown, because the entries GL pops may not be the
+// ones the shadow pushed.
+void vogl_fixed_function_shadow::invalidate_attrib_state()
+{
+    VOGL_FUNC_TRACER
+
+    m_matrix_mode = GL_NONE;
+    m_active_texture = cUnknown;
+    m_lights_valid = false;
+    m_material_valid = false;
+    m_color_material = cUnknown;
+    m_texenv_valid = false;
+
+    m_attrib_stack.clear();
+    m_attrib_stack_known = false;
+}
+
+// Returns false if the call can't change shadowed state.
+bool vogl_fixed_function_shadow::begin_update(bool allowed_inside_begin)
+{
+    if (!m_enabled)
+        return false;
+
+    // Calls compiled into a GL_COMPILE list only take effect when the list is called, see
+    // vogl_display_list_state::parse_list_and_update_shadows().
+    if (m_list_mode == GL_COMPILE)
+        return false;
+
+    // GL rejects most calls between glBegin() and glEnd().
+    return allowed_inside_begin || !m_in_begin;
+}
+
+void vogl_fixed_function_shadow::new_list(GLenum mode)
+{
+    VOGL_FUNC_TRACER
+
+    m_list_mode = mode;
+}
+
+void vogl_fixed_function_shadow::end_list()
+{
+    VOGL_FUNC_TRACER
+
+    m_list_mode = GL_NONE;
+}
+
+void vogl_fixed_function_shadow::call_unknown_list()
+{
+    VOGL_FUNC_TRACER
+
+    if (begin_update(true))
+        invalidate();
+}
+
+void vogl_fixed_function_shadow::begin()
+{
+    VOGL_FUNC_TRACER
+
+    if (m_list_mode != GL_COMPILE)
+        m_in_begin = true;
+}
+
+void vogl_fixed_function_shadow::end()
+{
+    VOGL_FUNC_TRACER
+
+    if (m_list_mode != GL_COMPILE)
+        m_in_begin = false;
+}
+
+void vogl_fixed_function_shadow::enable(GLenum cap, bool enabled)
+{
+    VOGL_FUNC_TRACER
+
+    // While GL_COLOR_MATERIAL is enabled the material tracks the current color, which isn't shadowed.
+    if ((cap != GL_COLOR_MATERIAL) || (!begin_update()))
+        return;
+
+    m_color_material = enabled ? GL_TRUE : GL_FALSE;
+    if (enabled)
+        m_material_valid = false;
+}
+
+void vogl_fixed_function_shadow::push_attrib(GLbitfield mask)
+{
+    VOGL_FUNC_TRACER
+
+    if (!begin_update())
+        return;
+
+    // GL_STACK_OVERFLOW
+    if (m_attrib_stack.size() >= m_max_attrib_stack_depth)
+        return;
+
+    attrib_stack_entry entry;
+    entry.m_mask = mask;
+    entry.m_may_have_overflowed = !m_attrib_stack_known;
+
+    if (mask & GL_TRANSFORM_BIT)
+        entry.m_matrix_mode = m_matrix_mode;
+
+    if (mask & GL_TEXTURE_BIT)
+        entry.m_active_texture = m_active_texture;
+
+    // GL_COORD_REPLACE is in the point group, everything else in the texture group.
+    if (mask & (GL_TEXTURE_BIT | GL_POINT_BIT))
+    {
+        entry.m_texenv = m_texenv;
+        entry.m_texenv_valid = m_texenv_valid;
+    }
+
+    if (mask & GL_LIGHTING_BIT)
+    {
+        entry.m_lights = m_lights;
+        entry.m_lights_valid = m_lights_valid;
+        for (uint side = 0; side < cTotalSides; side++)
+            entry.m_material[side] = m_material[side];
+        entry.m_material_valid = m_material_valid;
+    }
+
+    if (mask & (GL_LIGHTING_BIT | GL_ENABLE_BIT))
+        entry.m_color_material = m_color_material;
+
+    m_attrib_stack.push_back(entry);
+}
+
+void vogl_fixed_function_shadow::pop_attrib()
+{
+    VOGL_FUNC_TRACER
+
+    if (!begin_update())
+        return;
+
+    // GL_STACK_UNDERFLOW, unless GL's stack holds entries pushed before the shadow started following it.
+    if (m_attrib_stack.is_empty())
+    {
+        if (!m_attrib_stack_known)
+            invalidate_attrib_state();
+        return;
+    }
+
+    if (m_attrib_stack.back().m_may_have_overflowed)
+    {
+        invalidate_attrib_state();
+        return;
+    }
+
+    const attrib_stack_entry &entry = m_attrib_stack.back();
+    const GLbitfield mask = entry.m_mask;
+
+    if (mask & GL_TRANSFORM_BIT)
+        m_matrix_mode = entry.m_matrix_mode;
+
+    if (mask & GL_TEXTURE_BIT)
+        m_active_texture = entry.m_active_texture;
+
+    if (mask & (GL_TEXTURE_BIT | GL_POINT_BIT))
+    {
+        for (texenv_map::const_iterator it = entry.m_texenv.begin(); it != entry.m_texenv.end(); ++it)
+        {
+            if (mask & ((it->first == GL_POINT_SPRITE) ? GL_POINT_BIT : GL_TEXTURE_BIT))
+                m_texenv[it->first] = it->second;
+        }
+
+        if ((mask & (GL_TEXTURE_BIT | GL_POINT_BIT)) == (GL_TEXTURE_BIT | GL_POINT_BIT))
+            m_texenv_valid = entry.m_texenv_valid;
+        else
+            m_texenv_valid = m_texenv_valid && entry.m_texenv_valid;
+    }
+
+    if (mask & GL_LIGHTING_BIT)
+    {
+        m_lights = entry.m_lights;
+        m_lights_valid = entry.m_lights_valid;
+        for (uint side = 0; side < cTotalSides; side++)
+            m_material[side] = entry.m_material[side];
+        m_material_valid = entry.m_material_valid;
+    }
+
+    if (mask & (GL_LIGHTING_BIT | GL_ENABLE_BIT))
+        m_color_material = entry.m_color_material;
+
+    if (m_color_material != GL_FALSE)
+        m_material_valid = false;
+
+    m_attrib_stack.pop_back();
+}
+
+void vogl_fixed_function_shadow::matrix_mode(GLenum mode)
+{
+    VOGL_FUNC_TRACER
+
+    if (!begin_update())
+        return;
+
+    switch (mode)
+    {
+        case GL_PROJECTION:
+        case GL_MODELVIEW:
+        case GL_TEXTURE:
+            m_matrix_mode = mode;
+            break;
+        case GL_COLOR:
+            m_matrix_mode = m_has_color_matrix ? mode : GL_NONE;
+            break;
+        default:
+            // ARB_matrix_palette's GL_MATRIX_PALETTE_ARB etc. aren't shadowed.
+            m_matrix_mode = ((mode >= GL_MATRIX0_ARB) && (mode < GL_MATRIX0_ARB + m_program.size())) ? mode : GL_NONE;
+            break;
+    }
+}
+
+void vogl_fixed_function_shadow::active_texture(GLenum texture)
+{
+    VOGL_FUNC_TRACER
+
+    if (!begin_update())
+        return;
+
+    const uint unit = texture - GL_TEXTURE0;
+    m_active_texture = ((texture >= GL_TEXTURE0) && (unit < m_max_active_textures)) ? static_cast<int>(unit) : cUnknown;
+}
+
+const vogl_fixed_function_shadow::matrix_stack *vogl_fixed_function_shadow::find_matrix_stack(GLenum matrix, uint index) const
+{
+    VOGL_FUNC_TRACER
+
+    if (!m_enabled)
+        return NULL;
+
+    switch (matrix)
+    {
+        case GL_PROJECTION:
+            return &m_projection;
+        case GL_MODELVIEW:
+            return &m_modelview;
+        case GL_COLOR:
+            return m_has_color_matrix ? &m_color : NULL;
+        case GL_TEXTURE:
+            return (index < m_texture.size()) ? &m_texture[index] : NULL;
+        default:
+            break;
+    }
+
+    if ((matrix >= GL_MATRIX0_ARB) && (matrix < GL_MATRIX0_ARB + m_program.size()))
+        return &m_program[matrix - GL_MATRIX0_ARB];
+
+    return NULL;
+}
+
+// Returns the stack a matrix op applies to, or NULL if GL rejects the op or the stack isn't shadowed. If the op's
+// stack isn't known, the stacks it may have changed are invalidated.
+vogl_fixed_function_shadow::matrix_stack *vogl_fixed_function_shadow::get_target_matrix_stack(GLenum matrix)
+{
+    int texture_unit = m_active_texture;
+
+    if (matrix == GL_NONE)
+    {
+        matrix = m_matrix_mode;
+        if (matrix == GL_NONE)
+        {
+            invalidate_matrices();
+            return NULL;
+        }
+    }
+    else if ((matrix >= GL_TEXTURE0) && (matrix <= GL_TEXTURE31))
+    {
+        // The glMatrix*EXT() calls also take a texture unit.
+        texture_unit = matrix - GL_TEXTURE0;
+        matrix = GL_TEXTURE;
+    }
+
+    if (matrix == GL_TEXTURE)
+    {
+        if (texture_unit == cUnknown)
+        {
+            for (uint i = 0; i < m_texture.size(); i++)
+                m_texture[i].m_valid = false;
+            return NULL;
+        }
+
+        return (static_cast<uint>(texture_unit) < m_texture.size()) ? &m_texture[texture_unit] : NULL;
+    }
+
+    return const_cast<matrix_stack *>(find_matrix_stack(matrix, 0));
+}
+
+void vogl_fixed_function_shadow::load(GLenum matrix, const double *pMatrix)
+{
+    matrix_stack *pStack = get_target_matrix_stack(matrix);
+    if ((!pStack) || (!pStack->m_valid))
+        return;
+
+    double *pDst = pStack->m_matrices.back().get_ptr();
+    for (uint i = 0; i < 16; i++)
+        pDst[i] = round_to_float(pMatrix[i]);
+}
+
+void vogl_fixed_function_shadow::mult(GLenum matrix, const double *pMatrix)
+{
+    matrix_stack *pStack = get_target_matrix_stack(matrix);
+    if ((!pStack) || (!pStack->m_valid))
+        return;
+
+    double *pCur = pStack->m_matrices.back().get_ptr();
+
+    double result[16];
+    for (uint c = 0; c < 4; c++)
+    {
+        for (uint r = 0; r < 4; r++)
+        {
+            double sum = 0;
+            for (uint k = 0; k < 4; k++)
+                sum += pCur[k * 4 + r] * pMatrix[c * 4 + k];
+            result[c * 4 + r] = sum;
+        }
+    }
+
+    for (uint i = 0; i < 16; i++)
+        pCur[i] = round_to_float(result[i]);
+}
+
+void vogl_fixed_function_shadow::load_identity(GLenum matrix)
+{
+    VOGL_FUNC_TRACER
+
+    if (!begin_update())
+        return;
+
+    double m[16];
+    set_identity(m);
+    load(matrix, m);
+}
+
+void vogl_fixed_function_shadow::load_matrix(GLenum matrix, const GLfloat *pMatrix, bool transpose)
+{
+    VOGL_FUNC_TRACER
+
+    if ((!begin_update()) || (!pMatrix))
+        return;
+
+    double m[16];
+    get_matrix(m, pMatrix, transpose);
+    load(matrix, m);
+}
+
+void vogl_fixed_function_shadow::load_matrix(GLenum matrix, const GLdouble *pMatrix, bool transpose)
+{
+    VOGL_FUNC_TRACER
+
+    if ((!begin_update()) || (!pMatrix))
+        return;
+
+    double m[16];
+    get_matrix(m, pMatrix, transpose);
+    load(matrix, m);
+}
+
+void vogl_fixed_function_shadow::mult_matrix(GLenum matrix, const GLfloat *pMatrix, bool transpose)
+{
+    VOGL_FUNC_TRACER
+
+    if ((!begin_update()) || (!pMatrix))
+        return;
+
+    double m[16];
+    get_matrix(m, pMatrix, transpose);
+    mult(matrix, m);
+}
+
+void vogl_fixed_function_shadow::mult_matrix(GLenum matrix, const GLdouble *pMatrix, bool transpose)
+{
+    VOGL_FUNC_TRACER
+
+    if ((!begin_update()) || (!pMatrix))
+        return;
+
+    double m[16];
+    get_matrix(m, pMatrix, transpose);
+    mult(matrix, m);
+}
+
+void vogl_fixed_function_shadow::rotate(GLenum matrix, double angle, double x, double y, double z)
+{
+    VOGL_FUNC_TRACER
+
+    if (!begin_update())
+        return;
+
+    // The result of rotating around a zero length axis is implementation dependent.
+    const double len = sqrt(x * x + y * y + z * z);
+    if (len == 0.0)
+    {
+        matrix_stack *pStack = get_target_matrix_stack(matrix);
+        if (pStack)
+            pStack->m_valid = false;
+        return;
+    }
+
+    x /= len;
+    y /= len;
+    z /= len;
+
+    const double rad = angle * (3.14159265358979323846 / 180.0);
+    const double c = cos(rad);
+    const double s = sin(rad);
+    const double t = 1.0 - c;
+
+    double m[16];
+    m[0] = x * x * t + c;
+    m[1] = y * x * t + z * s;
+    m[2] = x * z * t - y * s;
+    m[3] = 0.0;
+    m[4] = x * y * t - z * s;
+    m[5] = y * y * t + c;
+    m[6] = y * z * t + x * s;
+    m[7] = 0.0;
+    m[8] = x * z * t + y * s;
+    m[9] = y * z * t - x * s;
+    m[10] = z * z * t + c;
+    m[11] = 0.0;
+    m[12] = 0.0;
+    m[13] = 0.0;
+    m[14] = 0.0;
+    m[15] = 1.0;
+    mult(matrix, m);
+}
+
+void vogl_fixed_function_shadow::scale(GLenum matrix, double x, double y, double z)
+{
+    VOGL_FUNC_TRACER
+
+    if (!begin_update())
+        return;
+
+    double m[16];
+    set_identity(m);
+    m[0] = x;
+    m[5] = y;
+    m[10] = z;
+    mult(matrix, m);
+}
+
+void vogl_fixed_function_shadow::translate(GLenum matrix, double x, double y, double z)
+{
+    VOGL_FUNC_TRACER
+
+    if (!begin_update())
+        return;
+
+    double m[16];
+    set_identity(m);
+    m[12] = x;
+    m[13] = y;
+    m[14] = z;
+    mult(matrix, m);
+}
+
+void vogl_fixed_function_shadow::frustum(GLenum matrix, double left, double right, double bottom, double top, double z_near, double z_far)
+{
+    VOGL_FUNC_TRACER
+
+    if (!begin_update())
+        return;
+
+    // GL_INVALID_VALUE
+    if ((left == right) || (bottom == top) || (z_near <= 0.0) || (z_far <= 0.0) || (z_near == z_far))
+        return;
+
+    double m[16];
+    memset(m, 0, sizeof(m));
+    m[0] = (2.0 * z_near) / (right - left);
+    m[5] = (2.0 * z_near) / (top - bottom);
+    m[8] = (right + left) / (right - left);
+    m[9] = (top + bottom) / (top - bottom);
+    m[10] = -(z_far + z_near) / (z_far - z_near);
+    m[11] = -1.0;
+    m[14] = -(2.0 * z_far * z_near) / (z_far - z_near);
+    mult(matrix, m);
+}
+
+void vogl_fixed_function_shadow::ortho(GLenum matrix, double left, double right, double bottom, double top, double z_near, double z_far)
+{
+    VOGL_FUNC_TRACER
+
+    if (!begin_update())
+        return;
+
+    // GL_INVALID_VALUE
+    if ((left == right) || (bottom == top) || (z_near == z_far))
+        return;
+
+    double m[16];
+    memset(m, 0, sizeof(m));
+    m[0] = 2.0 / (right - left);
+    m[5] = 2.0 / (top - bottom);
+    m[10] = -2.0 / (z_far - z_near);
+    m[12] = -(right + left) / (right - left);
+    m[13] = -(top + bottom) / (top - bottom);
+    m[14] = -(z_far + z_near) / (z_far - z_near);
+    m[15] = 1.0;
+    mult(matrix, m);
+}
+
+void vogl_fixed_function_shadow::push_matrix(GLenum matrix)
+{
+    VOGL_FUNC_TRACER
+
+    if (!begin_update())
+        return;
+
+    matrix_stack *pStack = get_target_matrix_stack(matrix);
+    if ((!pStack) || (!pStack->m_valid))
+        return;
+
+    // GL_STACK_OVERFLOW
+    if (pStack->m_matrices.size() >= pStack->m_max_depth)
+        return;
+
+    const matrix44D cur(pStack->m_matrices.back());
+    pStack->m_matrices.push_back(cur);
+}
+
+void vogl_fixed_function_shadow::pop_matrix(GLenum matrix)
+{
+    VOGL_FUNC_TRACER
+
+    if (!begin_update())
+        return;
+
+    matrix_stack *pStack = get_target_matrix_stack(matrix);
+    if ((!pStack) || (!pStack->m_valid))
+        return;
+
+    // GL_STACK_UNDERFLOW
+    if (pStack->m_matrices.size() <= 1)
+        return;
+
+    pStack->m_matrices.pop_back();
+}
+
+void vogl_fixed_function_shadow::invalidate_matrix(GLenum matrix)
+{
+    VOGL_FUNC_TRACER
+
+    if (!begin_update())
+        return;
+
+    matrix_stack *pStack = get_target_matrix_stack(matrix);
+    if (pStack)
+        pStack->m_valid = false;
+}
+
+void vogl_fixed_function_shadow::light(GLenum light, GLenum pname, const GLfloat *pParams, bool is_vector)
+{
+    VOGL_FUNC_TRACER
+
+    if ((!begin_update()) || (!pParams))
+        return;
+
+    // GL_INVALID_ENUM
+    const uint n = get_light_param_count(pname);
+    if ((!n) || ((n > 1) && (!is_vector)))
+        return;
+
+    float vals[4] = { 0, 0, 0, 0 };
+    memcpy(vals, pParams, n * sizeof(GLfloat));
+    update_light(light, pname, vals);
+}
+
+void vogl_fixed_function_shadow::light(GLenum light, GLenum pname, const GLint *pParams, bool is_vector)
+{
+    VOGL_FUNC_TRACER
+
+    if ((!begin_update()) || (!pParams))
+        return;
+
+    const uint n = get_light_param_count(pname);
+    if ((!n) || ((n > 1) && (!is_vector)))
+        return;
+
+    // Integer colors are mapped to [-1,1] with implementation dependent precision.
+    if ((pname == GL_AMBIENT) || (pname == GL_DIFFUSE) || (pname == GL_SPECULAR))
+    {
+        invalidate_lights();
+        return;
+    }
+
+    float vals[4] = { 0, 0, 0, 0 };
+    for (uint i = 0; i < n; i++)
+        vals[i] = static_cast<float>(pParams[i]);
+    update_light(light, pname, vals);
+}
+
+void vogl_fixed_function_shadow::update_light(GLenum light, GLenum pname, const float *pVals)
+{
+    const uint index = light - GL_LIGHT0;
+    if ((light < GL_LIGHT0) || (index >= m_max_lights))
+        return;
+
+    float vals[4] = { pVals[0], pVals[1], pVals[2], pVals[3] };
+
+    // GL_INVALID_VALUE
+    switch (pname)
+    {
+        case GL_SPOT_EXPONENT:
+        {
+            if ((vals[0] < 0.0f) || (vals[0] > 128.0f))
+                return;
+            break;
+        }
+        case GL_SPOT_CUTOFF:
+        {
+            if (((vals[0] < 0.0f) || (vals[0] > 90.0f)) && (vals[0] != 180.0f))
+                return;
+            break;
+        }
+        case GL_CONSTANT_ATTENUATION:
+        case GL_LINEAR_ATTENUATION:
+        case GL_QUADRATIC_ATTENUATION:
+        {
+            if (vals[0] < 0.0f)
+                return;
+            break;
+        }
+        case GL_POSITION:
+        case GL_SPOT_DIRECTION:
+        {
+            // Stored in eye coordinates, the direction is transformed by the upper left 3x3 of the modelview matrix.
+            if (!m_modelview.m_valid)
+            {
+                m_lights_valid = false;
+                return;
+            }
+
+            const double *pM = m_modelview.m_matrices.back().get_ptr();
+            const uint n = (pname == GL_POSITION) ? 4 : 3;
+            for (uint r = 0; r < n; r++)
+            {
+                double sum = 0;
+                for (uint c = 0; c < n; c++)
+                    sum += pM[c * 4 + r] * pVals[c];
+                vals[r] = static_cast<float>(sum);
+            }
+            break;
+        }
+        default:
+            break;
+    }
+
+    if (m_lights_valid)
+        set_state(m_lights[index], pname, 0, vals);
+}
+
+void vogl_fixed_function_shadow::material(GLenum face, GLenum pname, const GLfloat *pParams, bool is_vector)
+{
+    VOGL_FUNC_TRACER
+
+    // glMaterial() is one of the few calls allowed between glBegin() and glEnd().
+    if ((!begin_update(true)) || (!pParams))
+        return;
+
+    const uint n = get_material_param_count(pname);
+    if ((!n) || ((n > 1) && (!is_vector)))
+        return;
+
+    float vals[4] = { 0, 0, 0, 0 };
+    memcpy(vals, pParams, n * sizeof(GLfloat));
+    update_material(face, pname, vals);
+}
+
+void vogl_fixed_function_shadow::material(GLenum face, GLenum pname, const GLint *pParams, bool is_vector)
+{
+    VOGL_FUNC_TRACER
+
+    if ((!begin_update(true)) || (!pParams))
+        return;
+
+    const uint n = get_material_param_count(pname);
+    if ((!n) || ((n > 1) && (!is_vector)))
+        return;
+
+    // Integer colors are mapped to [-1,1] with implementation dependent precision.
+    if ((pname != GL_SHININESS) && (pname != GL_COLOR_INDEXES))
+    {
+        invalidate_material();
+        return;
+    }
+
+    float vals[4] = { 0, 0, 0, 0 };
+    for (uint i = 0; i < n; i++)
+        vals[i] = static_cast<float>(pParams[i]);
+    update_material(face, pname, vals);
+}
+
+void vogl_fixed_function_shadow::update_material(GLenum face, GLenum pname, const float *pVals)
+{
+    uint first_side, last_side;
+    switch (face)
+    {
+        case GL_FRONT:
+            first_side = last_side = cFront;
+            break;
+        case GL_BACK:
+            first_side = last_side = cBack;
+            break;
+        case GL_FRONT_AND_BACK:
+            first_side = cFront;
+            last_side = cBack;
+            break;
+        default:
+            return;
+    }
+
+    // GL_INVALID_VALUE
+    if ((pname == GL_SHININESS) && ((pVals[0] < 0.0f) || (pVals[0] > 128.0f)))
+        return;
+
+    if (!m_material_valid)
+        return;
+
+    for (uint side = first_side; side <= last_side; side++)
+    {
+        if (pname == GL_AMBIENT_AND_DIFFUSE)
+        {
+            set_state(m_material[side], GL_AMBIENT, 0, pVals);
+            set_state(m_material[side], GL_DIFFUSE, 0, pVals);
+        }
+        else
+        {
+            set_state(m_material[side], pname, 0, pVals);
+        }
+    }
+}
+
+// Returns false if GL rejects the call or the unit's params aren't shadowed. If the active texture isn't known the
+// texenv params are invalidated.
+bool vogl_fixed_function_shadow::get_texture_unit(GLenum texunit, uint &unit)
+{
+    if (texunit == GL_NONE)
+    {
+        if (m_active_texture == cUnknown)
+        {
+            m_texenv_valid = false;
+            return false;
+        }
+
+        unit = m_active_texture;
+    }
+    else
+    {
+        if (texunit < GL_TEXTURE0)
+            return false;
+
+        unit = texunit - GL_TEXTURE0;
+    }
+
+    return unit < m_max_texture_units;
+}
+
+void vogl_fixed_function_shadow::tex_env(GLenum texunit, GLenum target, GLenum pname, const GLfloat *pParams, bool is_vector)
+{
+    VOGL_FUNC_TRACER
+
+    if ((!begin_update()) || (!pParams))
+        return;
+
+    const uint n = get_tex_env_param_count(pname);
+    if ((n > 1) && (!is_vector))
+        return;
+
+    float vals[4] = { 0, 0, 0, 0 };
+    memcpy(vals, pParams, n * sizeof(GLfloat));
+    update_tex_env(texunit, target, pname, vals, false);
+}
+
+void vogl_fixed_function_shadow::tex_env(GLenum texunit, GLenum target, GLenum pname, const GLint *pParams, bool is_vector)
+{
+    VOGL_FUNC_TRACER
+
+    if ((!begin_update()) || (!pParams))
+        return;
+
+    const uint n = get_tex_env_param_count(pname);
+    if ((n > 1) && (!is_vector))
+        return;
+
+    float vals[4] = { 0, 0, 0, 0 };
+    for (uint i = 0; i < n; i++)
+        vals[i] = static_cast<float>(pParams[i]);
+    update_tex_env(texunit, target, pname, vals, true);
+}
+
+void vogl_fixed_function_shadow::update_tex_env(GLenum texunit, GLenum target, GLenum pname, const float *pVals, bool integer_params)
+{
+    uint unit;
+    if (!get_texture_unit(texunit, unit))
+        return;
+
+    const GLenum enum_val = get_enum_param(pVals[0]);
+
+    // Values GL rejects, or that only extensions define, invalidate the params instead of being validated exactly.
+    bool known_value = true;
+
+    switch (target)
+    {
+        case GL_TEXTURE_FILTER_CONTROL:
+        {
+            if (pname != GL_TEXTURE_LOD_BIAS)
+                return;
+
+            if (m_texenv_valid)
+                set_state(m_texenv[target], pname, unit, pVals);
+            return;
+        }
+        case GL_POINT_SPRITE:
+        {
+            if (pname != GL_COORD_REPLACE)
+                return;
+
+            if ((pVals[0] != 0.0f) && (pVals[0] != 1.0f))
+                return;
+
+            if (m_texenv_valid)
+            {
+                const int val = (pVals[0] != 0.0f) ? GL_TRUE : GL_FALSE;
+                set_state(m_texenv[target], pname, unit, &val);
+            }
+            return;
+        }
+        case GL_TEXTURE_ENV:
+            break;
+        default:
+            return;
+    }
+
+    switch (pname)
+    {
+        case GL_TEXTURE_ENV_COLOR:
+        {
+            // Integer colors are mapped to [-1,1] with implementation dependent precision, and whether float colors
+            // are clamped depends on the GL version.
+            for (uint i = 0; i < 4; i++)
+                if ((pVals[i] < 0.0f) || (pVals[i] > 1.0f))
+                    known_value = false;
+            if (integer_params)
+                known_value = false;
+            break;
+        }
+        case GL_RGB_SCALE:
+        case GL_ALPHA_SCALE:
+        {
+            // GL_INVALID_VALUE
+            if ((pVals[0] != 1.0f) && (pVals[0] != 2.0f) && (pVals[0] != 4.0f))
+                return;
+            break;
+        }
+        case GL_TEXTURE_ENV_MODE:
+        {
+            known_value = (enum_val == GL_ADD) || (enum_val == GL_MODULATE) || (enum_val == GL_DECAL) || (enum_val == GL_BLEND) || (enum_val == GL_REPLACE) || (enum_val == GL_COMBINE);
+            break;
+        }
+        case GL_COMBINE_RGB:
+        case GL_COMBINE_ALPHA:
+        {
+            switch (enum_val)
+            {
+                case GL_REPLACE:
+                case GL_MODULATE:
+                case GL_ADD:
+                case GL_ADD_SIGNED:
+                case GL_INTERPOLATE:
+                case GL_SUBTRACT:
+                    break;
+                case GL_DOT3_RGB:
+                case GL_DOT3_RGBA:
+                    known_value = (pname == GL_COMBINE_RGB);
+                    break;
+                default:
+                    known_value = false;
+                    break;
+            }
+            break;
+        }
+        case GL_SRC0_RGB:
+        case GL_SRC1_RGB:
+        case GL_SRC2_RGB:
+        case GL_SRC0_ALPHA:
+        case GL_SRC1_ALPHA:
+        case GL_SRC2_ALPHA:
+        {
+            known_value = (enum_val == GL_TEXTURE) || (enum_val == GL_CONSTANT) || (enum_val == GL_PRIMARY_COLOR) || (enum_val == GL_PREVIOUS) ||
+                          ((enum_val >= GL_TEXTURE0) && (enum_val < GL_TEXTURE0 + m_max_texture_units));
+            break;
+        }
+        case GL_OPERAND0_RGB:
+        case GL_OPERAND1_RGB:
+        case GL_OPERAND2_RGB:
+        {
+            known_value = (enum_val == GL_SRC_COLOR) || (enum_val == GL_ONE_MINUS_SRC_COLOR) || (enum_val == GL_SRC_ALPHA) || (enum_val == GL_ONE_MINUS_SRC_ALPHA);
+            break;
+        }
+        case GL_OPERAND0_ALPHA:
+        case GL_OPERAND1_ALPHA:
+        case GL_OPERAND2_ALPHA:
+        {
+            known_value = (enum_val == GL_SRC_ALPHA) || (enum_val == GL_ONE_MINUS_SRC_ALPHA);
+            break;
+        }
+        default:
+        {
+            // Extension params (i.e. NV_texture_env_combine4's) aren't snapshotted.
+            return;
+        }
+    }
+
+    if (!known_value)
+    {
+        m_texenv_valid = false;
+        return;
+    }
+
+    if (!m_texenv_valid)
+        return;
+
+    // Same types as vogl_texenv_state::snapshot().
+    if ((pname == GL_TEXTURE_ENV_COLOR) || (pname == GL_RGB_SCALE) || (pname == GL_ALPHA_SCALE))
+    {
+        set_state(m_texenv[target], pname, unit, pVals);
+    }
+    else
+    {
+        const int val = enum_val;
+        set_state(m_texenv[target], pname, unit, &val);
+    }
+}
+
+void vogl_fixed_function_shadow::tex_gen(GLenum texunit, GLenum coord, GLenum pname, const GLdouble *pParams, bool is_vector)
+{
+    VOGL_FUNC_TRACER
+
+    if ((!begin_update()) || (!pParams))
+        return;
+
+    const uint n = get_tex_gen_param_count(pname);
+    if ((n > 1) && (!is_vector))
+        return;
+
+    double vals[4] = { 0, 0, 0, 0 };
+    for (uint i = 0; i < n; i++)
+        vals[i] = pParams[i];
+    update_tex_gen(texunit, coord, pname, vals);
+}
+
+void vogl_fixed_function_shadow::tex_gen(GLenum texunit, GLenum coord, GLenum pname, const GLfloat *pParams, bool is_vector)
+{
+    VOGL_FUNC_TRACER
+
+    if ((!begin_update()) || (!pParams))
+        return;
+
+    const uint n = get_tex_gen_param_count(pname);
+    if ((n > 1) && (!is_vector))
+        return;
+
+    double vals[4] = { 0, 0, 0, 0 };
+    for (uint i = 0; i < n; i++)
+        vals[i] = pParams[i];
+    update_tex_gen(texunit, coord, pname, vals);
+}
+
+void vogl_fixed_function_shadow::tex_gen(GLenum texunit, GLenum coord, GLenum pname, const GLint *pParams, bool is_vector)
+{
+    VOGL_FUNC_TRACER
+
+    if ((!begin_update()) || (!pParams))
+        return;
+
+    const uint n = get_tex_gen_param_count(pname);
+    if ((n > 1) && (!is_vector))
+        return;
+
+    double vals[4] = { 0, 0, 0, 0 };
+    for (uint i = 0; i < n; i++)
+        vals[i] = pParams[i];
+    update_tex_gen(texunit, coord, pname, vals);
+}
+
+void vogl_fixed_function_shadow::update_tex_gen(GLenum texunit, GLenum coord, GLenum pname, const double *pVals)
+{
+    if ((coord < GL_S) || (coord > GL_Q))
+        return;
+
+    uint unit;
+    if (!get_texture_unit(texunit, unit))
+        return;
+
+    switch (pname)
+    {
+        case GL_TEXTURE_GEN_MODE:
+        {
+            const GLenum mode = (pVals[0] >= 0.0) ? static_cast<GLenum>(pVals[0] + .5) : GL_NONE;
+            switch (mode)
+            {
+                case GL_OBJECT_LINEAR:
+                case GL_EYE_LINEAR:
+                    break;
+                case GL_SPHERE_MAP:
+                {
+                    // GL_INVALID_ENUM
+                    if ((coord == GL_R) || (coord == GL_Q))
+                        return;
+                    break;
+                }
+                case GL_REFLECTION_MAP:
+                case GL_NORMAL_MAP:
+                {
+                    if (coord == GL_Q)
+                        return;
+                    break;
+                }
+                default:
+                {
+                    m_texenv_valid = false;
+                    return;
+                }
+            }
+
+            if (m_texenv_valid)
+            {
+                const int val = mode;
+                set_state(m_texenv[coord], pname, unit, &val);
+            }
+            break;
+        }
+        case GL_OBJECT_PLANE:
+        {
+            if (m_texenv_valid)
+            {
+                const float vals[4] = { static_cast<float>(pVals[0]), static_cast<float>(pVals[1]), static_cast<float>(pVals[2]), static_cast<float>(pVals[3]) };
+                set_state(m_texenv[coord], pname, unit, vals);
+            }
+            break;
+        }
+        case GL_EYE_PLANE:
+        {
+            // Stored in eye coordinates: the plane is multiplied by the inverse of the modelview matrix.
+            // matrix44D keeps rows, so the GL matrix in it is transposed, and so is its inverse.
+            matrix44D inv;
+            if ((!m_modelview.m_valid) || (!m_modelview.m_matrices.back().invert(inv)))
+            {
+                m_texenv_valid = false;
+                return;
+            }
+
+            if (m_texenv_valid)
+            {
+                float vals[4];
+                for (uint c = 0; c < 4; c++)
+                {
+                    double sum = 0;
+                    for (uint r = 0; r < 4; r++)
+                        sum += pVals[r] * inv(c, r);
+                    vals[c] = static_cast<float>(sum);
+                }
+                set_state(m_texenv[coord], pname, unit, vals);
+            }
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+void vogl_fixed_function_shadow::invalidate_lights()
+{
+    VOGL_FUNC_TRACER
+
+    if (begin_update())
+        m_lights_valid = false;
+}
+
+void vogl_fixed_function_shadow::invalidate_material()
+{
+    VOGL_FUNC_TRACER
+
+    if (begin_update(true))
+        m_material_valid = false;
+}
+
+void vogl_fixed_function_shadow::invalidate_texenv()
+{
+    VOGL_FUNC_TRACER
+
+    if (begin_update())
+        m_texenv_valid = false;
+}
+
+bool vogl_fixed_function_shadow::is_shadowed_entrypoint(gl_entrypoint_id_t entrypoint_id)
+{
+    switch (entrypoint_id)
+    {
+        case VOGL_ENTRYPOINT_glMatrixMode:
+        case VOGL_ENTRYPOINT_glActiveTexture:
+        case VOGL_ENTRYPOINT_glActiveTextureARB:
+        case VOGL_ENTRYPOINT_glPushAttrib:
+        case VOGL_ENTRYPOINT_glPopAttrib:
+        case VOGL_ENTRYPOINT_glEnable:
+        case VOGL_ENTRYPOINT_glDisable:
+        case VOGL_ENTRYPOINT_glLoadIdentity:
+        case VOGL_ENTRYPOINT_glLoadMatrixf:
+        case VOGL_ENTRYPOINT_glLoadMatrixd:
+        case VOGL_ENTRYPOINT_glLoadMatrixxOES:
+        case VOGL_ENTRYPOINT_glLoadTransposeMatrixf:
+        case VOGL_ENTRYPOINT_glLoadTransposeMatrixd:
+        case VOGL_ENTRYPOINT_glLoadTransposeMatrixfARB:
+        case VOGL_ENTRYPOINT_glLoadTransposeMatrixdARB:
+        case VOGL_ENTRYPOINT_glLoadTransposeMatrixxOES:
+        case VOGL_ENTRYPOINT_glMultMatrixf:
+        case VOGL_ENTRYPOINT_glMultMatrixd:
+        case VOGL_ENTRYPOINT_glMultMatrixxOES:
+        case VOGL_ENTRYPOINT_glMultTransposeMatrixf:
+        case VOGL_ENTRYPOINT_glMultTransposeMatrixd:
+        case VOGL_ENTRYPOINT_glMultTransposeMatrixfARB:
+        case VOGL_ENTRYPOINT_glMultTransposeMatrixdARB:
+        case VOGL_ENTRYPOINT_glMultTransposeMatrixxOES:
+        case VOGL_ENTRYPOINT_glRotatef:
+        case VOGL_ENTRYPOINT_glRotated:
+        case VOGL_ENTRYPOINT_glRotatexOES:
+        case VOGL_ENTRYPOINT_glScalef:
+        case VOGL_ENTRYPOINT_glScaled:
+        case VOGL_ENTRYPOINT_glScalexOES:
+        case VOGL_ENTRYPOINT_glTranslatef:
+        case VOGL_ENTRYPOINT_glTranslated:
+        case VOGL_ENTRYPOINT_glTranslatexOES:
+        case VOGL_ENTRYPOINT_glFrustum:
+        case VOGL_ENTRYPOINT_glFrustumfOES:
+        case VOGL_ENTRYPOINT_glFrustumxOES:
+        case VOGL_ENTRYPOINT_glOrtho:
+        case VOGL_ENTRYPOINT_glOrthofOES:
+        case VOGL_ENTRYPOINT_glOrthoxOES:
+        case VOGL_ENTRYPOINT_glPushMatrix:
+        case VOGL_ENTRYPOINT_glPopMatrix:
+        case VOGL_ENTRYPOINT_glMatrixLoadfEXT:
+        case VOGL_ENTRYPOINT_glMatrixLoaddEXT:
+        case VOGL_ENTRYPOINT_glMatrixLoadTransposefEXT:
+        case VOGL_ENTRYPOINT_glMatrixLoadTransposedEXT:
+        case VOGL_ENTRYPOINT_glMatrixLoadIdentityEXT:
+        case VOGL_ENTRYPOINT_glMatrixMultfEXT:
+        case VOGL_ENTRYPOINT_glMatrixMultdEXT:
+        case VOGL_ENTRYPOINT_glMatrixMultTransposefEXT:
+        case VOGL_ENTRYPOINT_glMatrixMultTransposedEXT:
+        case VOGL_ENTRYPOINT_glMatrixRotatefEXT:
+        case VOGL_ENTRYPOINT_glMatrixRotatedEXT:
+        case VOGL_ENTRYPOINT_glMatrixScalefEXT:
+        case VOGL_ENTRYPOINT_glMatrixScaledEXT:
+        case VOGL_ENTRYPOINT_glMatrixTranslatefEXT:
+        case VOGL_ENTRYPOINT_glMatrixTranslatedEXT:
+        case VOGL_ENTRYPOINT_glMatrixFrustumEXT:
+        case VOGL_ENTRYPOINT_glMatrixOrthoEXT:
+        case VOGL_ENTRYPOINT_glMatrixPushEXT:
+        case VOGL_ENTRYPOINT_glMatrixPopEXT:
+        case VOGL_ENTRYPOINT_glLightf:
+        case VOGL_ENTRYPOINT_glLightfv:
+        case VOGL_ENTRYPOINT_glLighti:
+        case VOGL_ENTRYPOINT_glLightiv:
+        case VOGL_ENTRYPOINT_glLightxOES:
+        case VOGL_ENTRYPOINT_glLightxvOES:
+        case VOGL_ENTRYPOINT_glMaterialf:
+        case VOGL_ENTRYPOINT_glMaterialfv:
+        case VOGL_ENTRYPOINT_glMateriali:
+        case VOGL_ENTRYPOINT_glMaterialiv:
+        case VOGL_ENTRYPOINT_glMaterialxOES:
+        case VOGL_ENTRYPOINT_glMaterialxvOES:
+        case VOGL_ENTRYPOINT_glTexEnvf:
+        case VOGL_ENTRYPOINT_glTexEnvfv:
+        case VOGL_ENTRYPOINT_glTexEnvi:
+        case VOGL_ENTRYPOINT_glTexEnviv:
+        case VOGL_ENTRYPOINT_glTexEnvxOES:
+        case VOGL_ENTRYPOINT_glTexEnvxvOES:
+        case VOGL_ENTRYPOINT_glMultiTexEnvfEXT:
+        case VOGL_ENTRYPOINT_glMultiTexEnvfvEXT:
+        case VOGL_ENTRYPOINT_glMultiTexEnviEXT:
+        case VOGL_ENTRYPOINT_glMultiTexEnvivEXT:
+        case VOGL_ENTRYPOINT_glTexGend:
+        case VOGL_ENTRYPOINT_glTexGendv:
+        case VOGL_ENTRYPOINT_glTexGenf:
+        case VOGL_ENTRYPOINT_glTexGenfv:
+        case VOGL_ENTRYPOINT_glTexGeni:
+        case VOGL_ENTRYPOINT_glTexGeniv:
+        case VOGL_ENTRYPOINT_glTexGenxOES:
+        case VOGL_ENTRYPOINT_glTexGenxvOES:
+        case VOGL_ENTRYPOINT_glMultiTexGendEXT:
+        case VOGL_ENTRYPOINT_glMultiTexGendvEXT:
+        case VOGL_ENTRYPOINT_glMultiTexGenfEXT:
+        case VOGL_ENTRYPOINT_glMultiTexGenfvEXT:
+        case VOGL_ENTRYPOINT_glMultiTexGeniEXT:
+        case VOGL_ENTRYPOINT_glMultiTexGenivEXT:
+            return true;
+        default:
+            break;
+    }
+
+    return false;
+}
+
+void vogl_fixed_function_shadow::update(const vogl_trace_packet &packet)
+{
+    VOGL_FUNC_TRACER
+
+    if (!m_enabled)
+        return;
+
+#define GET_ENUM(param_index) packet.get_param_value<GLenum>(param_index)
+#define GET_DOUBLE(param_index) static_cast<double>(packet.get_param_value<GLdouble>(param_index))
+#define GET_FLOAT(param_index) static_cast<double>(packet.get_param_value<GLfloat>(param_index))
+
+// The v variants' arrays are copied out of the packet first, so short arrays can't be over read.
+#define UPDATE_MATRIX(func, matrix, param_index, type, transpose) \
+    do                                                          \
+    {                                                           \
+        type m[16];                                             \
+        if (get_param_array(packet, param_index, m, 16))        \
+            func(matrix, m, transpose);                         \
+        else                                                    \
+            invalidate_matrix(matrix);                          \
+    } while (0)
+#define UPDATE_PARAMS(func, invalidate_func, count_func, pname_index, type, ...) \
+    do                                                                       \
+    {                                                                        \
+        type params[4] = { 0, 0, 0, 0 };                                     \
+        if (get_param_array(packet, pname_index + 1, params, count_func(GET_ENUM(pname_index)))) \
+            func(__VA_ARGS__, params, true);                                 \
+        else                                                                 \
+            invalidate_func();                                               \
+    } while (0)
+
+    switch (packet.get_entrypoint_id())
+    {
+        case VOGL_ENTRYPOINT_glNewList:
+            new_list(GET_ENUM(1));
+            break;
+        case VOGL_ENTRYPOINT_glEndList:
+            end_list();
+            break;
+        case VOGL_ENTRYPOINT_glBegin:
+            begin();
+            break;
+        case VOGL_ENTRYPOINT_glEnd:
+            end();
+            break;
+        case VOGL_ENTRYPOINT_glEnable:
+            enable(GET_ENUM(0), true);
+            break;
+        case VOGL_ENTRYPOINT_glDisable:
+            enable(GET_ENUM(0), false);
+            break;
+        case VOGL_ENTRYPOINT_glPushAttrib:
+            push_attrib(packet.get_param_value<GLbitfield>(0));
+            break;
+        case VOGL_ENTRYPOINT_glPopAttrib:
+            pop_attrib();
+            break;
+        case VOGL_ENTRYPOINT_glMatrixMode:
+            matrix_mode(GET_ENUM(0));
+            break;
+        case VOGL_ENTRYPOINT_glActiveTexture:
+        case VOGL_ENTRYPOINT_glActiveTextureARB:
+            active_texture(GET_ENUM(0));
+            break;
+
+        case VOGL_ENTRYPOINT_glLoadIdentity:
+            load_identity(GL_NONE);
+            break;
+        case VOGL_ENTRYPOINT_glLoadMatrixf:
+            UPDATE_MATRIX(load_matrix, GL_NONE, 0, GLfloat, false);
+            break;
+        case VOGL_ENTRYPOINT_glLoadMatrixd:
+            UPDATE_MATRIX(load_matrix, GL_NONE, 0, GLdouble, false);
+            break;
+        case VOGL_ENTRYPOINT_glLoadTransposeMatrixf:
+        case VOGL_ENTRYPOINT_glLoadTransposeMatrixfARB:
+            UPDATE_MATRIX(load_matrix, GL_NONE, 0, GLfloat, true);
+            break;
+        case VOGL_ENTRYPOINT_glLoadTransposeMatrixd:
+        case VOGL_ENTRYPOINT_glLoadTransposeMatrixdARB:
+            UPDATE_MATRIX(load_matrix, GL_NONE, 0, GLdouble, true);
+            break;
+        case VOGL_ENTRYPOINT_glMultMatrixf:
+            UPDATE_MATRIX(mult_matrix, GL_NONE, 0, GLfloat, false);
+            break;
+        case VOGL_ENTRYPOINT_glMultMatrixd:
+            UPDATE_MATRIX(mult_matrix, GL_NONE, 0, GLdouble, false);
+            break;
+        case VOGL_ENTRYPOINT_glMultTransposeMatrixf:
+        case VOGL_ENTRYPOINT_glMultTransposeMatrixfARB:
+            UPDATE_MATRIX(mult_matrix, GL_NONE, 0, GLfloat, true);
+            break;
+        case VOGL_ENTRYPOINT_glMultTransposeMatrixd:
+        case VOGL_ENTRYPOINT_glMultTransposeMatrixdARB:
+            UPDATE_MATRIX(mult_matrix, GL_NONE, 0, GLdouble, true);
+            break;
+        case VOGL_ENTRYPOINT_glRotatef:
+            rotate(GL_NONE, GET_FLOAT(0), GET_FLOAT(1), GET_FLOAT(2), GET_FLOAT(3));
+            break;
+        case VOGL_ENTRYPOINT_glRotated:
+            rotate(GL_NONE, GET_DOUBLE(0), GET_DOUBLE(1), GET_DOUBLE(2), GET_DOUBLE(3));
+            break;
+        case VOGL_ENTRYPOINT_glScalef:
+            scale(GL_NONE, GET_FLOAT(0), GET_FLOAT(1), GET_FLOAT(2));
+            break;
+        case VOGL_ENTRYPOINT_glScaled:
+            scale(GL_NONE, GET_DOUBLE(0), GET_DOUBLE(1), GET_DOUBLE(2));
+            break;
+        case VOGL_ENTRYPOINT_glTranslatef:
+            translate(GL_NONE, GET_FLOAT(0), GET_FLOAT(1), GET_FLOAT(2));
+            break;
+        case VOGL_ENTRYPOINT_glTranslated:
+            translate(GL_NONE, GET_DOUBLE(0), GET_DOUBLE(1), GET_DOUBLE(2));
+            break;
+        case VOGL_ENTRYPOINT_glFrustum:
+            frustum(GL_NONE, GET_DOUBLE(0), GET_DOUBLE(1), GET_DOUBLE(2), GET_DOUBLE(3), GET_DOUBLE(4), GET_DOUBLE(5));
+            break;
+        case VOGL_ENTRYPOINT_glFrustumfOES:
+            frustum(GL_NONE, GET_FLOAT(0), GET_FLOAT(1), GET_FLOAT(2), GET_FLOAT(3), GET_FLOAT(4), GET_FLOAT(5));
+            break;
+        case VOGL_ENTRYPOINT_glOrtho:
+            ortho(GL_NONE, GET_DOUBLE(0), GET_DOUBLE(1), GET_DOUBLE(2), GET_DOUBLE(3), GET_DOUBLE(4), GET_DOUBLE(5));
+            break;
+        case VOGL_ENTRYPOINT_glOrthofOES:
+            ortho(GL_NONE, GET_FLOAT(0), GET_FLOAT(1), GET_FLOAT(2), GET_FLOAT(3), GET_FLOAT(4), GET_FLOAT(5));
+            break;
+        case VOGL_ENTRYPOINT_glPushMatrix:
+            push_matrix(GL_NONE);
+            break;
+        case VOGL_ENTRYPOINT_glPopMatrix:
+            pop_matrix(GL_NONE);
+            break;
+        case VOGL_ENTRYPOINT_glLoadMatrixxOES:
+        case VOGL_ENTRYPOINT_glLoadTransposeMatrixxOES:
+        case VOGL_ENTRYPOINT_glMultMatrixxOES:
+        case VOGL_ENTRYPOINT_glMultTransposeMatrixxOES:
+        case VOGL_ENTRYPOINT_glRotatexOES:
+        case VOGL_ENTRYPOINT_glScalexOES:
+        case VOGL_ENTRYPOINT_glTranslatexOES:
+        case VOGL_ENTRYPOINT_glFrustumxOES:
+        case VOGL_ENTRYPOINT_glOrthoxOES:
+            invalidate_matrix(GL_NONE);
+            break;
+
+        case VOGL_ENTRYPOINT_glMatrixLoadIdentityEXT:
+            load_identity(GET_ENUM(0));
+            break;
+        case VOGL_ENTRYPOINT_glMatrixLoadfEXT:
+            UPDATE_MATRIX(load_matrix, GET_ENUM(0), 1, GLfloat, false);
+            break;
+        case VOGL_ENTRYPOINT_glMatrixLoaddEXT:
+            UPDATE_MATRIX(load_matrix, GET_ENUM(0), 1, GLdouble, false);
+            break;
+        case VOGL_ENTRYPOINT_glMatrixLoadTransposefEXT:
+            UPDATE_MATRIX(load_matrix, GET_ENUM(0), 1, GLfloat, true);
+            break;
+        case VOGL_ENTRYPOINT_glMatrixLoadTransposedEXT:
+            UPDATE_MATRIX(load_matrix, GET_ENUM(0), 1, GLdouble, true);
+            break;
+        case VOGL_ENTRYPOINT_glMatrixMultfEXT:
+            UPDATE_MATRIX(mult_matrix, GET_ENUM(0), 1, GLfloat, false);
+            break;
+        case VOGL_ENTRYPOINT_glMatrixMultdEXT:
+            UPDATE_MATRIX(mult_matrix, GET_ENUM(0), 1, GLdouble, false);
+            break;
+        case VOGL_ENTRYPOINT_glMatrixMultTransposefEXT:
+            UPDATE_MATRIX(mult_matrix, GET_ENUM(0), 1, GLfloat, true);
+            break;
+        case VOGL_ENTRYPOINT_glMatrixMultTransposedEXT:
+            UPDATE_MATRIX(mult_matrix, GET_ENUM(0), 1, GLdouble, true);
+            break;
+        case VOGL_ENTRYPOINT_glMatrixRotatefEXT:
+            rotate(GET_ENUM(0), GET_FLOAT(1), GET_FLOAT(2), GET_FLOAT(3), GET_FLOAT(4));
+            break;
+        case VOGL_ENTRYPOINT_glMatrixRotatedEXT:
+            rotate(GET_ENUM(0), GET_DOUBLE(1), GET_DOUBLE(2), GET_DOUBLE(3), GET_DOUBLE(4));
+            break;
+        case VOGL_ENTRYPOINT_glMatrixScalefEXT:
+            scale(GET_ENUM(0), GET_FLOAT(1), GET_FLOAT(2), GET_FLOAT(3));
+            break;
+        case VOGL_ENTRYPOINT_glMatrixScaledEXT:
+            scale(GET_ENUM(0), GET_DOUBLE(1), GET_DOUBLE(2), GET_DOUBLE(3));
+            break;
+        case VOGL_ENTRYPOINT_glMatrixTranslatefEXT:
+            translate(GET_ENUM(0), GET_FLOAT(1), GET_FLOAT(2), GET_FLOAT(3));
+            break;
+        case VOGL_ENTRYPOINT_glMatrixTranslatedEXT:
+            translate(GET_ENUM(0), GET_DOUBLE(1), GET_DOUBLE(2), GET_DOUBLE(3));
+            break;
+        case VOGL_ENTRYPOINT_glMatrixFrustumEXT:
+            frustum(GET_ENUM(0), GET_DOUBLE(1), GET_DOUBLE(2), GET_DOUBLE(3), GET_DOUBLE(4), GET_DOUBLE(5), GET_DOUBLE(6));
+            break;
+        case VOGL_ENTRYPOINT_glMatrixOrthoEXT:
+            ortho(GET_ENUM(0), GET_DOUBLE(1), GET_DOUBLE(2), GET_DOUBLE(3), GET_DOUBLE(4), GET_DOUBLE(5), GET_DOUBLE(6));
+            break;
+        case VOGL_ENTRYPOINT_glMatrixPushEXT:
+            push_matrix(GET_ENUM(0));
+            break;
+        case VOGL_ENTRYPOINT_glMatrixPopEXT:
+            pop_matrix(GET_ENUM(0));
+            break;
+
+        case VOGL_ENTRYPOINT_glLightf:
+        {
+            const GLfloat param = packet.get_param_value<GLfloat>(2);
+            light(GET_ENUM(0), GET_ENUM(1), &param, false);
+            break;
+        }
+        case VOGL_ENTRYPOINT_glLighti:
+        {
+            const GLint param = packet.get_param_value<GLint>(2);
+            light(GET_ENUM(0), GET_ENUM(1), &param, false);
+            break;
+        }
+        case VOGL_ENTRYPOINT_glLightfv:
+            UPDATE_PARAMS(light, invalidate_lights, get_light_param_count, 1, GLfloat, GET_ENUM(0), GET_ENUM(1));
+            break;
+        case VOGL_ENTRYPOINT_glLightiv:
+            UPDATE_PARAMS(light, invalidate_lights, get_light_param_count, 1, GLint, GET_ENUM(0), GET_ENUM(1));
+            break;
+        case VOGL_ENTRYPOINT_glLightxOES:
+        case VOGL_ENTRYPOINT_glLightxvOES:
+            invalidate_lights();
+            break;
+
+        case VOGL_ENTRYPOINT_glMaterialf:
+        {
+            const GLfloat param = packet.get_param_value<GLfloat>(2);
+            material(GET_ENUM(0), GET_ENUM(1), &param, false);
+            break;
+        }
+        case VOGL_ENTRYPOINT_glMateriali:
+        {
+            const GLint param = packet.get_param_value<GLint>(2);
+            material(GET_ENUM(0), GET_ENUM(1), &param, false);
+            break;
+        }
+        case VOGL_ENTRYPOINT_glMaterialfv:
+            UPDATE_PARAMS(material, invalidate_material, get_material_param_count, 1, GLfloat, GET_ENUM(0), GET_ENUM(1));
+            break;
+        case VOGL_ENTRYPOINT_glMaterialiv:
+            UPDATE_PARAMS(material, invalidate_material, get_material_param_count, 1, GLint, GET_ENUM(0), GET_ENUM(1));
+            break;
+        case VOGL_ENTRYPOINT_glMaterialxOES:
+        case VOGL_ENTRYPOINT_glMaterialxvOES:
+            invalidate_material();
+            break;
+
+        case VOGL_ENTRYPOINT_glTexEnvf:
+        {
+            const GLfloat param = packet.get_param_value<GLfloat>(2);
+            tex_env(GL_NONE, GET_ENUM(0), GET_ENUM(1), &param, false);
+            break;
+        }
+        case VOGL_ENTRYPOINT_glTexEnvi:
+        {
+            const GLint param = packet.get_param_value<GLint>(2);
+            tex_env(GL_NONE, GET_ENUM(0), GET_ENUM(1), &param, false);
+            break;
+        }
+        case VOGL_ENTRYPOINT_glTexEnvfv:
+            UPDATE_PARAMS(tex_env, invalidate_texenv, get_tex_env_param_count, 1, GLfloat, GL_NONE, GET_ENUM(0), GET_ENUM(1));
+            break;
+        case VOGL_ENTRYPOINT_glTexEnviv:
+            UPDATE_PARAMS(tex_env, invalidate_texenv, get_tex_env_param_count, 1, GLint, GL_NONE, GET_ENUM(0), GET_ENUM(1));
+            break;
+        case VOGL_ENTRYPOINT_glMultiTexEnvfEXT:
+        {
+            const GLfloat param = packet.get_param_value<GLfloat>(3);
+            tex_env(GET_ENUM(0), GET_ENUM(1), GET_ENUM(2), &param, false);
+            break;
+        }
+        case VOGL_ENTRYPOINT_glMultiTexEnviEXT:
+        {
+            const GLint param = packet.get_param_value<GLint>(3);
+            tex_env(GET_ENUM(0), GET_ENUM(1), GET_ENUM(2), &param, false);
+            break;
+        }
+        case VOGL_ENTRYPOINT_glMultiTexEnvfvEXT:
+            UPDATE_PARAMS(tex_env, invalidate_texenv, get_tex_env_param_count, 2, GLfloat, GET_ENUM(0), GET_ENUM(1), GET_ENUM(2));
+            break;
+        case VOGL_ENTRYPOINT_glMultiTexEnvivEXT:
+            UPDATE_PARAMS(tex_env, invalidate_texenv, get_tex_env_param_count, 2, GLint, GET_ENUM(0), GET_ENUM(1), GET_ENUM(2));
+            break;
+
+        case VOGL_ENTRYPOINT_glTexGend:
+        {
+            const GLdouble param = packet.get_param_value<GLdouble>(2);
+            tex_gen(GL_NONE, GET_ENUM(0), GET_ENUM(1), &param, false);
+            break;
+        }
+        case VOGL_ENTRYPOINT_glTexGenf:
+        {
+            const GLfloat param = packet.get_param_value<GLfloat>(2);
+            tex_gen(GL_NONE, GET_ENUM(0), GET_ENUM(1), &param, false);
+            break;
+        }
+        case VOGL_ENTRYPOINT_glTexGeni:
+        {
+            const GLint param = packet.get_param_value<GLint>(2);
+            tex_gen(GL_NONE, GET_ENUM(0), GET_ENUM(1), &param, false);
+            break;
+        }
+        case VOGL_ENTRYPOINT_glTexGendv:
+            UPDATE_PARAMS(tex_gen, invalidate_texenv, get_tex_gen_param_count, 1, GLdouble, GL_NONE, GET_ENUM(0), GET_ENUM(1));
+            break;
+        case VOGL_ENTRYPOINT_glTexGenfv:
+            UPDATE_PARAMS(tex_gen, invalidate_texenv, get_tex_gen_param_count, 1, GLfloat, GL_NONE, GET_ENUM(0), GET_ENUM(1));
+            break;
+        case VOGL_ENTRYPOINT_glTexGeniv:
+            UPDATE_PARAMS(tex_gen, invalidate_texenv, get_tex_gen_param_count, 1, GLint, GL_NONE, GET_ENUM(0), GET_ENUM(1));
+            break;
+        case VOGL_ENTRYPOINT_glMultiTexGendEXT:
+        {
+            const GLdouble param = packet.get_param_value<GLdouble>(3);
+            tex_gen(GET_ENUM(0), GET_ENUM(1), GET_ENUM(2), &param, false);
+            break;
+        }
+        case VOGL_ENTRYPOINT_glMultiTexGenfEXT:
+        {
+            const GLfloat param = packet.get_param_value<GLfloat>(3);
+            tex_gen(GET_ENUM(0), GET_ENUM(1), GET_ENUM(2), &param, false);
+            break;
+        }
+        case VOGL_ENTRYPOINT_glMultiTexGeniEXT:
+        {
+            const GLint param = packet.get_param_value<GLint>(3);
+            tex_gen(GET_ENUM(0), GET_ENUM(1), GET_ENUM(2), &param, false);
+            break;
+        }
+        case VOGL_ENTRYPOINT_glMultiTexGendvEXT:
+            UPDATE_PARAMS(tex_gen, invalidate_texenv, get_tex_gen_param_count, 2, GLdouble, GET_ENUM(0), GET_ENUM(1), GET_ENUM(2));
+            break;
+        case VOGL_ENTRYPOINT_glMultiTexGenfvEXT:
+            UPDATE_PARAMS(tex_gen, invalidate_texenv, get_tex_gen_param_count, 2, GLfloat, GET_ENUM(0), GET_ENUM(1), GET_ENUM(2));
+            break;
+        case VOGL_ENTRYPOINT_glMultiTexGenivEXT:
+            UPDATE_PARAMS(tex_gen, invalidate_texenv, get_tex_gen_param_count, 2, GLint, GET_ENUM(0), GET_ENUM(1), GET_ENUM(2));
+            break;
+        case VOGL_ENTRYPOINT_glTexEnvxOES:
+        case VOGL_ENTRYPOINT_glTexEnvxvOES:
+        case VOGL_ENTRYPOINT_glTexGenxOES:
+        case VOGL_ENTRYPOINT_glTexGenxvOES:
+            invalidate_texenv();
+            break;
+
+        default:
+            break;
+    }
+
+#undef GET_ENUM
+#undef GET_DOUBLE
+#undef GET_FLOAT
+#undef UPDATE_MATRIX
+#undef UPDATE_PARAMS
+}
+
+const vogl_fixed_function_shadow::matrix_vec *vogl_fixed_function_shadow::get_matrix_stack(GLenum matrix, uint index) const
+{
+    VOGL_FUNC_TRACER
+
+    const matrix_stack *pStack = find_matrix_stack(matrix, index);
+    return (pStack && pStack->m_valid) ? &pStack->m_matrices : NULL;
+}
+
+void vogl_fixed_function_shadow::set_matrix_stack(GLenum matrix, uint index, const matrix_vec &matrices)
+{
+    VOGL_FUNC_TRACER
+
+    matrix_stack *pStack = const_cast<matrix_stack *>(find_matrix_stack(matrix, index));
+    if ((!pStack) || (matrices.is_empty()) || (matrices.size() > pStack->m_max_depth))
+        return;
+
+    pStack->m_matrices = matrices;
+    pStack->m_valid = true;
+}
+
+const vogl_fixed_function_shadow::light_vec *vogl_fixed_function_shadow::get_lights() const
+{
+    VOGL_FUNC_TRACER
+
+    return (m_enabled && m_lights_valid) ? &m_lights : NULL;
+}
+
+void vogl_fixed_function_shadow::set_lights(const light_vec &lights)
+{
+    VOGL_FUNC_TRACER
+
+    if ((!m_enabled) || (lights.size() != m_max_lights))
+        return;
+
+    m_lights = lights;
+    m_lights_valid = true;
+}
+
+const vogl_state_vector *vogl_fixed_function_shadow::get_material() const
+{
+    VOGL_FUNC_TRACER
+
+    return (m_enabled && m_material_valid) ? m_material : NULL;
+}
+
+void vogl_fixed_function_shadow::set_material(const vogl_state_vector *pParams, bool color_material_enabled)
+{
+    VOGL_FUNC_TRACER
+
+    if (!m_enabled)
+        return;
+
+    // The material will keep changing with the current color.
+    m_color_material = color_material_enabled ? GL_TRUE : GL_FALSE;
+    if (color_material_enabled)
+    {
+        m_material_valid = false;
+        return;
+    }
+
+    for (uint side = 0; side < cTotalSides; side++)
+        m_material[side] = pParams[side];
+    m_material_valid = true;
+}
+
+const vogl_fixed_function_shadow::texenv_map *vogl_fixed_function_shadow::get_texenv() const
+{
+    VOGL_FUNC_TRACER
+
+    return (m_enabled && m_texenv_valid) ? &m_texenv : NULL;
+}
+
+void vogl_fixed_function_shadow::set_texenv(const texenv_map &params)
+{
+    VOGL_FUNC_TRACER
+
+    if (!m_enabled)
+        return;
+
+    m_texenv = params;
+    m_texenv_valid = true;
+}
@@ -0,0 +1,272 @@
+/**************************************************************************
+ *
+ * Copyright 2013-2014 RAD Game Tools and Valve Software
+ * Copyright 2010-2014 Rich Geldreich and Tenacious Software LLC
+ * All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ **************************************************************************/
+
+// File: vogl_fixed_function_shadow.h
+#ifndef VOGL_FIXED_FUNCTION_SHADOW_H
+#define VOGL_FIXED_FUNCTION_SHADOW_H
+
+#include "vogl_core.h"
+#include "vogl_common.h"
+#include "vogl_matrix.h"
+#include "vogl_map.h"
+#include "vogl_context_info.h"
+#include "vogl_state_vector.h"
+#include "vogl_trace_packet.h"
+
+//----------------------------------------------------------------------------------------------------------------------
+// class vogl_fixed_function_shadow
+// Per-context CPU copy of the fixed function matrix stacks, lights, materials and texenv/texgen params, kept up to date
+// from the calls the tracer intercepts or the replayer replays. vogl_matrix_state, vogl_light_state, vogl_material_state
+// and vogl_texenv_state snapshot straight from it instead of issuing thousands of glGet*() calls on legacy titles.
+// Every matrix stack, and the lights, material and texenv groups, have their own valid flag. Anything the shadow can't
+// follow exactly (display lists holding calls that couldn't be recorded, GL_COLOR_MATERIAL, integer colors, param values
+// only extensions define) clears the flags of the state it may have changed. The next snapshot reads that state from GL
+// and reseeds the shadow with it.
+// Calls GL rejects are detected by validating their params, so the tracer never has to call glGetError().
+//----------------------------------------------------------------------------------------------------------------------
+class vogl_fixed_function_shadow
+{
+public:
+    typedef vogl::vector<matrix44D> matrix_vec;
+    typedef vogl::vector<vogl_state_vector> light_vec;
+    typedef vogl::map<GLenum, vogl_state_vector> texenv_map;
+
+    enum
+    {
+        cFront = 0,
+        cBack = 1,
+        cTotalSides
+    };
+
+    vogl_fixed_function_shadow();
+
+    // Sets everything to the state of a freshly created context. Call when the context is first made current, the max
+    // stack depths are queried from GL. Until then (and forever on core profile contexts) nothing is shadowed.
+    void init(const vogl_context_info &context_info);
+
+    // Marks everything as unknown. Call after state has been set behind the shadow's back (i.e. restoring a snapshot).
+    void invalidate();
+
+    bool is_enabled() const
+    {
+        return m_enabled;
+    }
+
+    // Updates the shadow from a replayed GL entrypoint packet, or from one of the packets of an executed display list.
+    // glCallList(s)() packets are ignored, vogl_display_list_state::parse_list_and_update_shadows() replays the lists.
+    void update(const vogl_trace_packet &packet);
+
+    // True if packets of this entrypoint may change shadowed state when a display list holding them is executed.
+    static bool is_shadowed_entrypoint(gl_entrypoint_id_t entrypoint_id);
+
+    // Calls made while composing a list only change the shadow in GL_COMPILE_AND_EXECUTE mode.
+    void new_list(GLenum mode);
+    void end_list();
+
+    // For executed lists whose effect isn't known, i.e. lists holding calls that couldn't be recorded.
+    void call_unknown_list();
+
+    void begin();
+    void end();
+    void enable(GLenum cap, bool enabled);
+    void push_attrib(GLbitfield mask);
+    void pop_attrib();
+
+    void matrix_mode(GLenum mode);
+    void active_texture(GLenum texture);
+
+    // matrix is GL_NONE to use the current matrix mode, otherwise it's the mode param of the glMatrix*EXT() calls.
+    void load_identity(GLenum matrix);
+    void load_matrix(GLenum matrix, const GLfloat *pMatrix, bool transpose);
+    void load_matrix(GLenum matrix, const GLdouble *pMatrix, bool transpose);
+    void mult_matrix(GLenum matrix, const GLfloat *pMatrix, bool transpose);
+    void mult_matrix(GLenum matrix, const GLdouble *pMatrix, bool transpose);
+    void rotate(GLenum matrix, double angle, double x, double y, double z);
+    void scale(GLenum matrix, double x, double y, double z);
+    void translate(GLenum matrix, double x, double y, double z);
+    void frustum(GLenum matrix, double left, double right, double bottom, double top, double z_near, double z_far);
+    void ortho(GLenum matrix, double left, double right, double bottom, double top, double z_near, double z_far);
+    void push_matrix(GLenum matrix);
+    void pop_matrix(GLenum matrix);
+
+    // is_vector is true for the v variants, which take an array of params.
+    void light(GLenum light, GLenum pname, const GLfloat *pParams, bool is_vector);
+    void light(GLenum light, GLenum pname, const GLint *pParams, bool is_vector);
+    void material(GLenum face, GLenum pname, const GLfloat *pParams, bool is_vector);
+    void material(GLenum face, GLenum pname, const GLint *pParams, bool is_vector);
+
+    // texunit is GL_NONE to use the active texture, otherwise it's the texunit param of the glMultiTex*EXT() calls.
+    void tex_env(GLenum texunit, GLenum target, GLenum pname, const GLfloat *pParams, bool is_vector);
+    void tex_env(GLenum texunit, GLenum target, GLenum pname, const GLint *pParams, bool is_vector);
+    void tex_gen(GLenum texunit, GLenum coord, GLenum pname, const GLdouble *pParams, bool is_vector);
+    void tex_gen(GLenum texunit, GLenum coord, GLenum pname, const GLfloat *pParams, bool is_vector);
+    void tex_gen(GLenum texunit, GLenum coord, GLenum pname, const GLint *pParams, bool is_vector);
+
+    // For calls that aren't followed, i.e. the OES fixed point variants.
+    void invalidate_matrix(GLenum matrix);
+    void invalidate_lights();
+    void invalidate_material();
+    void invalidate_texenv();
+
+    // Snapshotting: The getters return NULL if the state isn't known. The setters reseed the shadow with state that was
+    // read back from GL.
+    const matrix_vec *get_matrix_stack(GLenum matrix, uint index) const;
+    void set_matrix_stack(GLenum matrix, uint index, const matrix_vec &matrices);
+
+    const light_vec *get_lights() const;
+    void set_lights(const light_vec &lights);
+
+    // Indexed by cFront/cBack.
+    const vogl_state_vector *get_material() const;
+    void set_material(const vogl_state_vector *pParams, bool color_material_enabled);
+
+    // Same layout as vogl_texenv_state: keyed by glTexEnv() target or glTexGen() coord, indexed by texture unit.
+    const texenv_map *get_texenv() const;
+    void set_texenv(const texenv_map &params);
+
+private:
+    enum
+    {
+        cUnknown = -1
+    };
+
+    struct matrix_stack
+    {
+        matrix_stack()
+            : m_max_depth(0),
+              m_valid(false)
+        {
+        }
+
+        // A new context's stacks hold a single identity matrix.
+        void init(uint max_depth)
+        {
+            m_matrices.resize(1);
+            m_matrices[0].set_identity_matrix();
+            m_max_depth = max_depth;
+            m_valid = max_depth > 0;
+        }
+
+        // deepest .. current
+        matrix_vec m_matrices;
+        uint m_max_depth;
+        bool m_valid;
+    };
+    typedef vogl::vector<matrix_stack> matrix_stack_vec;
+
+    // The state glPushAttrib() saves for the groups in m_mask.
+    struct attrib_stack_entry
+    {
+        attrib_stack_entry()
+            : m_mask(0),
+              m_may_have_overflowed(false),
+              m_matrix_mode(GL_NONE),
+              m_active_texture(cUnknown),
+              m_lights_valid(false),
+              m_material_valid(false),
+              m_color_material(cUnknown),
+              m_texenv_valid(false)
+        {
+        }
+
+        GLbitfield m_mask;
+
+        // Pushed while the depth of the GL attrib stack wasn't known, so it may have overflowed.
+        bool m_may_have_overflowed;
+
+        GLenum m_matrix_mode;
+        int m_active_texture;
+
+        light_vec m_lights;
+        bool m_lights_valid;
+        vogl_state_vector m_material[cTotalSides];
+        bool m_material_valid;
+        int m_color_material;
+
+        texenv_map m_texenv;
+        bool m_texenv_valid;
+    };
+    typedef vogl::vector<attrib_stack_entry> attrib_stack_vec;
+
+    bool m_enabled;
+
+    uint m_max_lights;
+    uint m_max_texture_units;
+    uint m_max_active_textures;
+    uint m_max_attrib_stack_depth;
+    bool m_has_color_matrix;
+
+    // GL_NONE if not composing a list.
+    GLenum m_list_mode;
+    bool m_in_begin;
+
+    // GL_NONE if not known.
+    GLenum m_matrix_mode;
+
+    // Texture unit index, or cUnknown.
+    int m_active_texture;
+
+    matrix_stack m_projection;
+    matrix_stack m_modelview;
+    matrix_stack m_color;
+    matrix_stack_vec m_texture;
+    matrix_stack_vec m_program;
+
+    light_vec m_lights;
+    bool m_lights_valid;
+
+    vogl_state_vector m_material[cTotalSides];
+    bool m_material_valid;
+
+    // GL_FALSE, GL_TRUE, or cUnknown
+    int m_color_material;
+
+    texenv_map m_texenv;
+    bool m_texenv_valid;
+
+    attrib_stack_vec m_attrib_stack;
+
+    // False if the GL attrib stack may hold entries pushed before the shadow started following it.
+    bool m_attrib_stack_known;
+
+    bool begin_update(bool allowed_inside_begin = false);
+
+    const matrix_stack *find_matrix_stack(GLenum matrix, uint index) const;
+    matrix_stack *get_target_matrix_stack(GLenum matrix);
+    void invalidate_matrices();
+    void invalidate_attrib_state();
+
+    void load(GLenum matrix, const double *pMatrix);
+    void mult(GLenum matrix, const double *pMatrix);
+
+    bool get_texture_unit(GLenum texunit, uint &unit);
+    void update_light(GLenum light, GLenum pname, const float *pVals);
+    void update_material(GLenum face, GLenum pname, const float *pVals);
+    void update_tex_env(GLenum texunit, GLenum target, GLenum pname, const float *pVals, bool integer_params);
+    void update_tex_gen(GLenum texunit, GLenum coord, GLenum pname, const double *pVals);
+};
+
+#endif // VOGL_FIXED_FUNCTION_SHADOW_H
@@ -353,6 +353,23 @@ bool vogl_general_context_state::restore_buffer_binding(GLenum binding_enum, GLe
     return false;
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+// vogl_general_context_state::state_matches_default
+// The replayer only restores into freshly created contexts, so restore() skips any state that still holds its GL default.
+//----------------------------------------------------------------------------------------------------------------------
+bool vogl_general_context_state::state_matches_default(GLenum enum_val, uint index, bool indexed_variant) const
+{
+    VOGL_FUNC_TRACER
+
+    const vogl_state_data *pData = find(enum_val, index, indexed_variant);
+    if (!pData)
+        return false;
+
+    float default_vals[4];
+    const uint num_defaults = vogl_get_default_context_state(enum_val, default_vals);
+    return (num_defaults == pData->get_num_elements()) && vogl_state_data_matches_defaults(*pData, default_vals, num_defaults);
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 // vogl_general_context_state::restore_buffer_binding_range
 //----------------------------------------------------------------------------------------------------------------------
@@ -1015,6 +1032,12 @@ bool vogl_general_context_state::restore(const vogl_context_info &context_info,
             continue;
         }
 
+        if (state_matches_default(enum_val, index, state.get_indexed_variant()))
+        {
+            ADD_PROCESSED_STATE(enum_val, index);
+            continue;
+        }
+
         if (vogl_gl_enum_is_dependent_on_active_texture(enum_val))
         {
             GL_ENTRYPOINT(glActiveTexture)(GL_TEXTURE0 + index);
@@ -1427,7 +1450,8 @@ bool vogl_general_context_state::restore(const vogl_context_info &context_info,
     // blend func separate
     GLenum src_rgb, src_alpha;
     GLenum dst_rgb, dst_alpha;
-    if (get(GL_BLEND_SRC_RGB, 0, &src_rgb) && get(GL_BLEND_SRC_ALPHA, 0, &src_alpha) && get(GL_BLEND_DST_RGB, 0, &dst_rgb) && get(GL_BLEND_DST_ALPHA, 0, &dst_alpha))
+    if (get(GL_BLEND_SRC_RGB, 0, &src_rgb) && get(GL_BLEND_SRC_ALPHA, 0, &src_alpha) && get(GL_BLEND_DST_RGB, 0, &dst_rgb) && get(GL_BLEND_DST_ALPHA, 0, &dst_alpha) &&
+        !(state_matches_default(GL_BLEND_SRC_RGB) && state_matches_default(GL_BLEND_SRC_ALPHA) && state_matches_default(GL_BLEND_DST_RGB) && state_matches_default(GL_BLEND_DST_ALPHA)))
     {
         GL_ENTRYPOINT(glBlendFuncSeparate)(src_rgb, dst_rgb, src_alpha, dst_alpha);
         VOGL_CHECK_GL_ERROR;
@@ -1441,7 +1465,7 @@ bool vogl_general_context_state::restore(const vogl_context_info &context_info,
 
     // blend color
     float blend_color[4];
-    if (get(GL_BLEND_COLOR, 0, blend_color, 4))
+    if (get(GL_BLEND_COLOR, 0, blend_color, 4) && !state_matches_default(GL_BLEND_COLOR))
     {
         GL_ENTRYPOINT(glBlendColor)(blend_color[0], blend_color[1], blend_color[2], blend_color[3]);
         VOGL_CHECK_GL_ERROR;
@@ -1450,7 +1474,7 @@ bool vogl_general_context_state::restore(const vogl_context_info &context_info,
 
     // blend equation separate
     GLenum blend_equation_rgb = 0, blend_equation_alpha = 0;
-    if (get(GL_BLEND_EQUATION_RGB, 0, &blend_equation_rgb) && get(GL_BLEND_EQUATION_ALPHA, 0, &blend_equation_alpha))
+    if (get(GL_BLEND_EQUATION_RGB, 0, &blend_equation_rgb) && get(GL_BLEND_EQUATION_ALPHA, 0, &blend_equation_alpha) && !(state_matches_default(GL_BLEND_EQUATION_RGB) && state_matches_default(GL_BLEND_EQUATION_ALPHA)))
     {
         GL_ENTRYPOINT(glBlendEquationSeparate)(blend_equation_rgb, blend_equation_alpha);
         VOGL_CHECK_GL_ERROR;
@@ -1460,7 +1484,7 @@ bool vogl_general_context_state::restore(const vogl_context_info &context_info,
 
     // clear color
     float clear_color[4];
-    if (get(GL_COLOR_CLEAR_VALUE, 0, clear_color, 4))
+    if (get(GL_COLOR_CLEAR_VALUE, 0, clear_color, 4) && !state_matches_default(GL_COLOR_CLEAR_VALUE))
     {
         GL_ENTRYPOINT(glClearColor)(clear_color[0], clear_color[1], clear_color[2], clear_color[3]);
         VOGL_CHECK_GL_ERROR;
@@ -1469,7 +1493,7 @@ bool vogl_general_context_state::restore(const vogl_context_info &context_info,
 
     // logic op
     GLenum logic_op_mode;
-    if (get(GL_LOGIC_OP_MODE, 0, &logic_op_mode))
+    if (get(GL_LOGIC_OP_MODE, 0, &logic_op_mode) && !state_matches_default(GL_LOGIC_OP_MODE))
     {
         GL_ENTRYPOINT(glLogicOp)(logic_op_mode);
         VOGL_CHECK_GL_ERROR;
@@ -1478,7 +1502,7 @@ bool vogl_general_context_state::restore(const vogl_context_info &context_info,
 
     // color mask
     bool color_mask[4];
-    if (get(GL_COLOR_WRITEMASK, 0, color_mask, 4))
+    if (get(GL_COLOR_WRITEMASK, 0, color_mask, 4) && !state_matches_default(GL_COLOR_WRITEMASK))
     {
         GL_ENTRYPOINT(glColorMask)(color_mask[0], color_mask[1], color_mask[2], color_mask[3]);
         VOGL_CHECK_GL_ERROR;
@@ -1488,7 +1512,7 @@ bool vogl_general_context_state::restore(const vogl_context_info &context_info,
     // Restore indexed color masks (we've already restored the global state, which sets all the indexed states)
     for (uint i = 0; i < context_info.get_max_draw_buffers(); i++)
     {
-        if (get(GL_COLOR_WRITEMASK, i, color_mask, 4, true))
+        if (get(GL_COLOR_WRITEMASK, i, color_mask, 4, true) && !state_matches_default(GL_COLOR_WRITEMASK, i, true))
         {
             GL_ENTRYPOINT(glColorMaski)(i, color_mask[0], color_mask[1], color_mask[2], color_mask[3]);
             VOGL_CHECK_GL_ERROR;
@@ -1498,7 +1522,7 @@ bool vogl_general_context_state::restore(const vogl_context_info &context_info,
 
     // cull face mode
     GLenum cull_face_mode;
-    if (get(GL_CULL_FACE_MODE, 0, &cull_face_mode))
+    if (get(GL_CULL_FACE_MODE, 0, &cull_face_mode) && !state_matches_default(GL_CULL_FACE_MODE))
     {
         GL_ENTRYPOINT(glCullFace)(cull_face_mode);
         VOGL_CHECK_GL_ERROR;
@@ -1507,7 +1531,7 @@ bool vogl_general_context_state::restore(const vogl_context_info &context_info,
 
     // front face
     GLenum front_face;
-    if (get(GL_FRONT_FACE, 0, &front_face))
+    if (get(GL_FRONT_FACE, 0, &front_face) && !state_matches_default(GL_FRONT_FACE))
     {
         GL_ENTRYPOINT(glFrontFace)(front_face);
         VOGL_CHECK_GL_ERROR;
@@ -1516,7 +1540,7 @@ bool vogl_general_context_state::restore(const vogl_context_info &context_info,
 
     // depth clear value
     double depth_clear_val;
-    if (get(GL_DEPTH_CLEAR_VALUE, 0, &depth_clear_val))
+    if (get(GL_DEPTH_CLEAR_VALUE, 0, &depth_clear_val) && !state_matches_default(GL_DEPTH_CLEAR_VALUE))
     {
         GL_ENTRYPOINT(glClearDepth)(depth_clear_val);
         VOGL_CHECK_GL_ERROR;
@@ -1525,7 +1549,7 @@ bool vogl_general_context_state::restore(const vogl_context_info &context_info,
 
     // min sample shading
     float min_sample_shading;
-    if (get(GL_MIN_SAMPLE_SHADING_VALUE, 0, &min_sample_shading))
+    if (get(GL_MIN_SAMPLE_SHADING_VALUE, 0, &min_sample_shading) && !state_matches_default(GL_MIN_SAMPLE_SHADING_VALUE))
     {
         GL_ENTRYPOINT(glMinSampleShading)(min_sample_shading);
         VOGL_CHECK_GL_ERROR;
@@ -1534,7 +1558,7 @@ bool vogl_general_context_state::restore(const vogl_context_info &context_info,
 
     // depth func
     GLenum depth_func;
-    if (get(GL_DEPTH_FUNC, 0, &depth_func))
+    if (get(GL_DEPTH_FUNC, 0, &depth_func) && !state_matches_default(GL_DEPTH_FUNC))
     {
         GL_ENTRYPOINT(glDepthFunc)(depth_func);
         VOGL_CHECK_GL_ERROR;
@@ -1543,7 +1567,7 @@ bool vogl_general_context_state::restore(const vogl_context_info &context_info,
 
     // depth range
     double depth_range[2];
-    if (get(GL_DEPTH_RANGE, 0, depth_range, 2))
+    if (get(GL_DEPTH_RANGE, 0, depth_range, 2) && !state_matches_default(GL_DEPTH_RANGE))
     {
         GL_ENTRYPOINT(glDepthRange)(depth_range[0], depth_range[1]);
         VOGL_CHECK_GL_ERROR;
@@ -1552,7 +1576,7 @@ bool vogl_general_context_state::restore(const vogl_context_info &context_info,
 
     // depth mask
     bool depth_mask;
-    if (get(GL_DEPTH_WRITEMASK, 0, &depth_mask))
+    if (get(GL_DEPTH_WRITEMASK, 0, &depth_mask) && !state_matches_default(GL_DEPTH_WRITEMASK))
     {
         GL_ENTRYPOINT(glDepthMask)(depth_mask != 0);
         VOGL_CHECK_GL_ERROR;
@@ -1654,7 +1678,7 @@ bool vogl_general_context_state::restore(const vogl_context_info &context_info,
 
     // line width
     float line_width;
-    if (get(GL_LINE_WIDTH, 0, &line_width))
+    if (get(GL_LINE_WIDTH, 0, &line_width) && !state_matches_default(GL_LINE_WIDTH))
     {
         GL_ENTRYPOINT(glLineWidth)(line_width);
         VOGL_CHECK_GL_ERROR;
@@ -1663,7 +1687,7 @@ bool vogl_general_context_state::restore(const vogl_context_info &context_info,
 
     // point fade threshold
     float point_fade_threshold_size;
-    if (get(GL_POINT_FADE_THRESHOLD_SIZE, 0, &point_fade_threshold_size))
+    if (get(GL_POINT_FADE_THRESHOLD_SIZE, 0, &point_fade_threshold_size) && !state_matches_default(GL_POINT_FADE_THRESHOLD_SIZE))
     {
         GL_ENTRYPOINT(glPointParameterf)(GL_POINT_FADE_THRESHOLD_SIZE, point_fade_threshold_size);
         VOGL_CHECK_GL_ERROR;
@@ -1672,7 +1696,7 @@ bool vogl_general_context_state::restore(const vogl_context_info &context_info,
 
     // point dist atten
     float point_distance_atten[3];
-    if (get(GL_POINT_DISTANCE_ATTENUATION, 0, point_distance_atten, 3))
+    if (get(GL_POINT_DISTANCE_ATTENUATION, 0, point_distance_atten, 3) && !state_matches_default(GL_POINT_DISTANCE_ATTENUATION))
     {
         GL_ENTRYPOINT(glPointParameterfv)(GL_POINT_DISTANCE_ATTENUATION, point_distance_atten);
         VOGL_CHECK_GL_ERROR;
@@ -1681,7 +1705,7 @@ bool vogl_general_context_state::restore(const vogl_context_info &context_info,
 
     // point sprite coord origin
     GLenum point_sprite_coord_origin = 0;
-    if (get(GL_POINT_SPRITE_COORD_ORIGIN, 0, &point_sprite_coord_origin))
+    if (get(GL_POINT_SPRITE_COORD_ORIGIN, 0, &point_sprite_coord_origin) && !state_matches_default(GL_POINT_SPRITE_COORD_ORIGIN))
     {
         GL_ENTRYPOINT(glPointParameteri)(GL_POINT_SPRITE_COORD_ORIGIN, point_sprite_coord_origin);
         VOGL_CHECK_GL_ERROR;
@@ -1690,7 +1714,7 @@ bool vogl_general_context_state::restore(const vogl_context_info &context_info,
 
     // point size min
     float point_size_min;
-    if (get(GL_POINT_SIZE_MIN, 0, &point_size_min))
+    if (get(GL_POINT_SIZE_MIN, 0, &point_size_min) && !state_matches_default(GL_POINT_SIZE_MIN))
     {
         GL_ENTRYPOINT(glPointParameterf)(GL_POINT_SIZE_MIN, point_size_min);
         VOGL_CHECK_GL_ERROR;
@@ -1708,7 +1732,7 @@ bool vogl_general_context_state::restore(const vogl_context_info &context_info,
 
     // provoking vertex
     GLenum provoking_vertex = 0;
-    if (get(GL_PROVOKING_VERTEX, 0, &provoking_vertex))
+    if (get(GL_PROVOKING_VERTEX, 0, &provoking_vertex) && !state_matches_default(GL_PROVOKING_VERTEX))
     {
         GL_ENTRYPOINT(glProvokingVertex)(provoking_vertex);
         VOGL_CHECK_GL_ERROR;
@@ -1717,7 +1741,7 @@ bool vogl_general_context_state::restore(const vogl_context_info &context_info,
 
     // point size
     float point_size;
-    if (get(GL_POINT_SIZE, 0, &point_size))
+    if (get(GL_POINT_SIZE, 0, &point_size) && !state_matches_default(GL_POINT_SIZE))
     {
         GL_ENTRYPOINT(glPointSize)(point_size);
         VOGL_CHECK_GL_ERROR;
@@ -1726,7 +1750,7 @@ bool vogl_general_context_state::restore(const vogl_context_info &context_info,
 
     // polygon offset
     float polygon_offset_factor, polygon_offset_units;
-    if (get(GL_POLYGON_OFFSET_FACTOR, 0, &polygon_offset_factor) && get(GL_POLYGON_OFFSET_UNITS, 0, &polygon_offset_units))
+    if (get(GL_POLYGON_OFFSET_FACTOR, 0, &polygon_offset_factor) && get(GL_POLYGON_OFFSET_UNITS, 0, &polygon_offset_units) && !(state_matches_default(GL_POLYGON_OFFSET_FACTOR) && state_matches_default(GL_POLYGON_OFFSET_UNITS)))
     {
         GL_ENTRYPOINT(glPolygonOffset)(polygon_offset_factor, polygon_offset_units);
         VOGL_CHECK_GL_ERROR;
@@ -1736,7 +1760,7 @@ bool vogl_general_context_state::restore(const vogl_context_info &context_info,
 
     // polygon mode
     GLenum polygon_mode[2] = { 0, 0 };
-    if (get(GL_POLYGON_MODE, 0, polygon_mode, 2))
+    if (get(GL_POLYGON_MODE, 0, polygon_mode, 2) && !state_matches_default(GL_POLYGON_MODE))
     {
         GL_ENTRYPOINT(glPolygonMode)(GL_FRONT, polygon_mode[0]);
         GL_ENTRYPOINT(glPolygonMode)(GL_BACK, polygon_mode[1]);
@@ -1747,7 +1771,7 @@ bool vogl_general_context_state::restore(const vogl_context_info &context_info,
     // sample coverage
     float sample_coverage;
     bool sample_invert;
-    if (get(GL_SAMPLE_COVERAGE_VALUE, 0, &sample_coverage) && get(GL_SAMPLE_COVERAGE_INVERT, 0, &sample_invert))
+    if (get(GL_SAMPLE_COVERAGE_VALUE, 0, &sample_coverage) && get(GL_SAMPLE_COVERAGE_INVERT, 0, &sample_invert) && !(state_matches_default(GL_SAMPLE_COVERAGE_VALUE) && state_matches_default(GL_SAMPLE_COVERAGE_INVERT)))
     {
         GL_ENTRYPOINT(glSampleCoverage)(sample_coverage, sample_invert);
         VOGL_CHECK_GL_ERROR;
@@ -1775,7 +1799,8 @@ bool vogl_general_context_state::restore(const vogl_context_info &context_info,
 
     // stencil op separate
     GLenum stencil_fail = 0, stencil_dp_pass = 0, stencil_dp_fail = 0;
-    if (get(GL_STENCIL_FAIL, 0, &stencil_fail) && get(GL_STENCIL_PASS_DEPTH_PASS, 0, &stencil_dp_pass) && get(GL_STENCIL_PASS_DEPTH_FAIL, 0, &stencil_dp_fail))
+    if (get(GL_STENCIL_FAIL, 0, &stencil_fail) && get(GL_STENCIL_PASS_DEPTH_PASS, 0, &stencil_dp_pass) && get(GL_STENCIL_PASS_DEPTH_FAIL, 0, &stencil_dp_fail) &&
+        !(state_matches_default(GL_STENCIL_FAIL) && state_matches_default(GL_STENCIL_PASS_DEPTH_PASS) && state_matches_default(GL_STENCIL_PASS_DEPTH_FAIL)))
     {
         GL_ENTRYPOINT(glStencilOpSeparate)(GL_FRONT, stencil_fail, stencil_dp_fail, stencil_dp_pass);
         VOGL_CHECK_GL_ERROR;
@@ -1784,7 +1809,8 @@ bool vogl_general_context_state::restore(const vogl_context_info &context_info,
         ADD_PROCESSED_STATE(GL_STENCIL_PASS_DEPTH_FAIL, 0);
     }
 
-    if (get(GL_STENCIL_BACK_FAIL, 0, &stencil_fail) && get(GL_STENCIL_BACK_PASS_DEPTH_PASS, 0, &stencil_dp_pass) && get(GL_STENCIL_BACK_PASS_DEPTH_FAIL, 0, &stencil_dp_fail))
+    if (get(GL_STENCIL_BACK_FAIL, 0, &stencil_fail) && get(GL_STENCIL_BACK_PASS_DEPTH_PASS, 0, &stencil_dp_pass) && get(GL_STENCIL_BACK_PASS_DEPTH_FAIL, 0, &stencil_dp_fail) &&
+        !(state_matches_default(GL_STENCIL_BACK_FAIL) && state_matches_default(GL_STENCIL_BACK_PASS_DEPTH_PASS) && state_matches_default(GL_STENCIL_BACK_PASS_DEPTH_FAIL)))
     {
         GL_ENTRYPOINT(glStencilOpSeparate)(GL_BACK, stencil_fail, stencil_dp_fail, stencil_dp_pass);
         VOGL_CHECK_GL_ERROR;
@@ -1833,7 +1859,7 @@ bool vogl_general_context_state::restore(const vogl_context_info &context_info,
     }
 
     GLenum color_material_face, color_material_parameter;
-    if (get(GL_COLOR_MATERIAL_FACE, 0, &color_material_face) && get(GL_COLOR_MATERIAL_PARAMETER, 0, &color_material_parameter))
+    if (get(GL_COLOR_MATERIAL_FACE, 0, &color_material_face) && get(GL_COLOR_MATERIAL_PARAMETER, 0, &color_material_parameter) && !(state_matches_default(GL_COLOR_MATERIAL_FACE) && state_matches_default(GL_COLOR_MATERIAL_PARAMETER)))
     {
         GL_ENTRYPOINT(glColorMaterial)(color_material_face, color_material_parameter);
         VOGL_CHECK_GL_ERROR;
@@ -1895,7 +1921,7 @@ bool vogl_general_context_state::restore(const vogl_context_info &context_info,
     for (uint i = 0; i < context_info.get_max_draw_buffers(); i++)
     {
         GLint enabled = 0;
-        if (get(GL_BLEND, i, &enabled, 1, true))
+        if (get(GL_BLEND, i, &enabled, 1, true) && !state_matches_default(GL_BLEND, i, true))
         {
             if (enabled)
             {
@@ -1948,7 +1974,7 @@ bool vogl_general_context_state::restore(const vogl_context_info &context_info,
         if (pname_def.m_type == cSTInt32)
         {
             int val;
-            if (get(enum_val, 0, &val))
+            if (get(enum_val, 0, &val) && !state_matches_default(enum_val))
             {
                 GL_ENTRYPOINT(glPixelTransferi)(enum_val, val);
                 VOGL_CHECK_GL_ERROR;
@@ -1958,7 +1984,7 @@ bool vogl_general_context_state::restore(const vogl_context_info &context_info,
         else if (pname_def.m_type == cSTFloat)
         {
             float val;
-            if (get(enum_val, 0, &val))
+            if (get(enum_val, 0, &val) && !state_matches_default(enum_val))
             {
                 GL_ENTRYPOINT(glPixelTransferf)(enum_val, val);
                 VOGL_CHECK_GL_ERROR;
@@ -1977,6 +2003,8 @@ bool vogl_general_context_state::restore(const vogl_context_info &context_info,
     for (uint i = 0; i < VOGL_ARRAY_SIZE(s_fog_pnames); i++)
     {
         GLenum enum_val = s_fog_pnames[i];
+        if (state_matches_default(enum_val))
+            continue;
 
         int pname_def_index = get_gl_enums().find_pname_def_index(enum_val);
         if (pname_def_index < 0)
@@ -2042,7 +2070,7 @@ bool vogl_general_context_state::restore(const vogl_context_info &context_info,
     {
         GLenum enum_val = s_hint_pnames[i];
         GLenum val;
-        if (get(enum_val, 0, &val))
+        if (get(enum_val, 0, &val) && !state_matches_default(enum_val))
         {
             GL_ENTRYPOINT(glHint)(enum_val, val);
             VOGL_CHECK_GL_ERROR;
@@ -2052,7 +2080,7 @@ bool vogl_general_context_state::restore(const vogl_context_info &context_info,
 
     // primitive restart index
     uint prim_restart_index;
-    if (get(GL_PRIMITIVE_RESTART_INDEX, 0, &prim_restart_index))
+    if (get(GL_PRIMITIVE_RESTART_INDEX, 0, &prim_restart_index) && !state_matches_default(GL_PRIMITIVE_RESTART_INDEX))
     {
         GL_ENTRYPOINT(glPrimitiveRestartIndex)(prim_restart_index);
         VOGL_CHECK_GL_ERROR;
@@ -2062,7 +2090,7 @@ bool vogl_general_context_state::restore(const vogl_context_info &context_info,
     // alpha func
     GLenum alpha_func;
     float alpha_ref;
-    if (get(GL_ALPHA_TEST_FUNC, 0, &alpha_func) && get(GL_ALPHA_TEST_REF, 0, &alpha_ref))
+    if (get(GL_ALPHA_TEST_FUNC, 0, &alpha_func) && get(GL_ALPHA_TEST_REF, 0, &alpha_ref) && !(state_matches_default(GL_ALPHA_TEST_FUNC) && state_matches_default(GL_ALPHA_TEST_REF)))
     {
         GL_ENTRYPOINT(glAlphaFunc)(alpha_func, alpha_ref);
         VOGL_CHECK_GL_ERROR;
@@ -2072,7 +2100,7 @@ bool vogl_general_context_state::restore(const vogl_context_info &context_info,
 
     // clear index value
     int clear_index;
-    if (get(GL_INDEX_CLEAR_VALUE, 0, &clear_index))
+    if (get(GL_INDEX_CLEAR_VALUE, 0, &clear_index) && !state_matches_default(GL_INDEX_CLEAR_VALUE))
     {
         GL_ENTRYPOINT(glClearIndex)(static_cast<float>(clear_index));
         VOGL_CHECK_GL_ERROR;
@@ -2090,7 +2118,7 @@ bool vogl_general_context_state::restore(const vogl_context_info &context_info,
 
     // line stipple
     int line_stipple_pattern, line_stipple_repeat;
-    if (get(GL_LINE_STIPPLE_PATTERN, 0, &line_stipple_pattern) && get(GL_LINE_STIPPLE_REPEAT, 0, &line_stipple_repeat))
+    if (get(GL_LINE_STIPPLE_PATTERN, 0, &line_stipple_pattern) && get(GL_LINE_STIPPLE_REPEAT, 0, &line_stipple_repeat) && !(state_matches_default(GL_LINE_STIPPLE_PATTERN) && state_matches_default(GL_LINE_STIPPLE_REPEAT)))
     {
         GL_ENTRYPOINT(glLineStipple)(line_stipple_repeat, line_stipple_pattern);
         VOGL_CHECK_GL_ERROR;
@@ -2100,7 +2128,7 @@ bool vogl_general_context_state::restore(const vogl_context_info &context_info,
 
     // list base
     int list_base;
-    if (get(GL_LIST_BASE, 0, &list_base))
+    if (get(GL_LIST_BASE, 0, &list_base) && !state_matches_default(GL_LIST_BASE))
     {
         GL_ENTRYPOINT(glListBase)(list_base);
         VOGL_CHECK_GL_ERROR;
@@ -2118,7 +2146,7 @@ bool vogl_general_context_state::restore(const vogl_context_info &context_info,
 
     // shade model
     GLenum shade_model;
-    if (get(GL_SHADE_MODEL, 0, &shade_model))
+    if (get(GL_SHADE_MODEL, 0, &shade_model) && !state_matches_default(GL_SHADE_MODEL))
     {
         GL_ENTRYPOINT(glShadeModel)(shade_model);
         VOGL_CHECK_GL_ERROR;
@@ -2127,7 +2155,7 @@ bool vogl_general_context_state::restore(const vogl_context_info &context_info,
 
     // pixel zoom
     float zoom_x, zoom_y;
-    if (get(GL_ZOOM_X, 0, &zoom_x) && get(GL_ZOOM_Y, 0, &zoom_y))
+    if (get(GL_ZOOM_X, 0, &zoom_x) && get(GL_ZOOM_Y, 0, &zoom_y) && !(state_matches_default(GL_ZOOM_X) && state_matches_default(GL_ZOOM_Y)))
     {
         GL_ENTRYPOINT(glPixelZoom)(zoom_x, zoom_y);
         VOGL_CHECK_GL_ERROR;
@@ -2137,7 +2165,7 @@ bool vogl_general_context_state::restore(const vogl_context_info &context_info,
 
     // stencil clear value
     int stencil_clear_value;
-    if (get(GL_STENCIL_CLEAR_VALUE, 0, &stencil_clear_value))
+    if (get(GL_STENCIL_CLEAR_VALUE, 0, &stencil_clear_value) && !state_matches_default(GL_STENCIL_CLEAR_VALUE))
     {
         GL_ENTRYPOINT(glClearStencil)(stencil_clear_value);
         VOGL_CHECK_GL_ERROR;
@@ -2167,7 +2195,7 @@ bool vogl_general_context_state::restore(const vogl_context_info &context_info,
         VOGL_VERIFY((pname_def.m_type == cSTInt32) && (pname_def.m_count == 1));
 
         int val;
-        if (get(enum_val, 0, &val))
+        if (get(enum_val, 0, &val) && !state_matches_default(enum_val))
         {
             GL_ENTRYPOINT(glPixelStorei)(enum_val, val);
             VOGL_CHECK_GL_ERROR;
@@ -2188,7 +2216,7 @@ bool vogl_general_context_state::restore(const vogl_context_info &context_info,
 
     // accum clear value
     float accum_clear_value[4];
-    if (get(GL_ACCUM_CLEAR_VALUE, 0, accum_clear_value, 4))
+    if (get(GL_ACCUM_CLEAR_VALUE, 0, accum_clear_value, 4) && !state_matches_default(GL_ACCUM_CLEAR_VALUE))
     {
         GL_ENTRYPOINT(glClearAccum)(accum_clear_value[0], accum_clear_value[1], accum_clear_value[2], accum_clear_value[3]);
         VOGL_CHECK_GL_ERROR;
@@ -2196,7 +2224,7 @@ bool vogl_general_context_state::restore(const vogl_context_info &context_info,
     }
 
     float light_model_ambient[4];
-    if (get(GL_LIGHT_MODEL_AMBIENT, 0, light_model_ambient, 4))
+    if (get(GL_LIGHT_MODEL_AMBIENT, 0, light_model_ambient, 4) && !state_matches_default(GL_LIGHT_MODEL_AMBIENT))
     {
         GL_ENTRYPOINT(glLightModelfv)(GL_LIGHT_MODEL_AMBIENT, light_model_ambient);
         VOGL_CHECK_GL_ERROR;
@@ -2204,7 +2232,7 @@ bool vogl_general_context_state::restore(const vogl_context_info &context_info,
     }
 
     GLenum light_model_color_control;
-    if (get(GL_LIGHT_MODEL_COLOR_CONTROL, 0, &light_model_color_control))
+    if (get(GL_LIGHT_MODEL_COLOR_CONTROL, 0, &light_model_color_control) && !state_matches_default(GL_LIGHT_MODEL_COLOR_CONTROL))
     {
         GL_ENTRYPOINT(glLightModeli)(GL_LIGHT_MODEL_COLOR_CONTROL, light_model_color_control);
         VOGL_CHECK_GL_ERROR;
@@ -2280,35 +2308,35 @@ bool vogl_general_context_state::restore(const vogl_context_info &context_info,
 
     // current color
     vec4F cur_color(0.0f);
-    if (get(GL_CURRENT_COLOR, 0, cur_color.get_ptr(), 4))
+    if (get(GL_CURRENT_COLOR, 0, cur_color.get_ptr(), 4) && !state_matches_default(GL_CURRENT_COLOR))
     {
         GL_ENTRYPOINT(glColor4f)(cur_color[0], cur_color[1], cur_color[2], cur_color[3]);
         ADD_PROCESSED_STATE(GL_CURRENT_COLOR, 0);
     }
 
     vec3F cur_normal(0.0f);
-    if (get(GL_CURRENT_NORMAL, 0, cur_normal.get_ptr(), 3))
+    if (get(GL_CURRENT_NORMAL, 0, cur_normal.get_ptr(), 3) && !state_matches_default(GL_CURRENT_NORMAL))
     {
         GL_ENTRYPOINT(glNormal3f)(cur_normal[0], cur_normal[1], cur_normal[2]);
         ADD_PROCESSED_STATE(GL_CURRENT_NORMAL, 0);
     }
 
     float cur_index = 0;
-    if (get(GL_CURRENT_INDEX, 0, &cur_index, 1))
+    if (get(GL_CURRENT_INDEX, 0, &cur_index, 1) && !state_matches_default(GL_CURRENT_INDEX))
     {
         GL_ENTRYPOINT(glIndexf)(cur_index);
         ADD_PROCESSED_STATE(GL_CURRENT_INDEX, 0);
     }
 
     float cur_fog_coord = 0;
-    if (get(GL_CURRENT_FOG_COORD, 0, &cur_fog_coord, 1))
+    if (get(GL_CURRENT_FOG_COORD, 0, &cur_fog_coord, 1) && !state_matches_default(GL_CURRENT_FOG_COORD))
     {
         GL_ENTRYPOINT(glFogCoordf)(cur_fog_coord);
         ADD_PROCESSED_STATE(GL_CURRENT_FOG_COORD, 0);
     }
 
     vec4F cur_secondary_color(0.0f);
-    if (get(GL_CURRENT_SECONDARY_COLOR, 0, cur_secondary_color.get_ptr(), 4))
+    if (get(GL_CURRENT_SECONDARY_COLOR, 0, cur_secondary_color.get_ptr(), 4) && !state_matches_default(GL_CURRENT_SECONDARY_COLOR))
     {
         GL_ENTRYPOINT(glSecondaryColor3f)(cur_secondary_color[0], cur_secondary_color[1], cur_secondary_color[2]);
         ADD_PROCESSED_STATE(GL_CURRENT_SECONDARY_COLOR, 0);
@@ -2585,7 +2613,7 @@ bool vogl_general_context_state::restore(const vogl_context_info &context_info,
             if (state.get_id() == processed_states[i])
                 break;
 
-        if (i == processed_states.size())
+        if ((i == processed_states.size()) && (!state_matches_default(state.get_enum_val(), state.get_index(), state.get_indexed_variant())))
         {
             vogl_debug_printf("Didn't process state: %s index: %u indexed_variant: %u\n", get_gl_enums().find_name(state.get_enum_val()), state.get_index(), state.get_indexed_variant());
         }
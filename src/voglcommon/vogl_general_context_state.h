@@ -74,6 +74,7 @@ private:
     bool restore_buffer_binding(GLenum binding_enum, GLenum set_enum, vogl_handle_remapper &remapper) const;
     bool restore_buffer_binding_range(GLenum binding_enum, GLenum start_enum, GLenum size_enum, GLenum set_enum, uint index, bool indexed_variant, vogl_handle_remapper &remapper) const;
     bool snapshot_active_queries(const vogl_context_info &context_info);
+    bool state_matches_default(GLenum enum_val, uint index = 0, bool indexed_variant = false) const;
 };
 
 class vogl_polygon_stipple_state
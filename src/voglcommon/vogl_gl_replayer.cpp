@@ -512,17 +512,32 @@ bool vogl_gl_replayer::dump_frontbuffer_to_file(const dynamic_string &filename)
 
 //----------------------------------------------------------------------------------------------------------------------
 // vogl_replayer::trigger_pending_window_resize
+// Returns cStatusResizeWindow if the caller must wait for the window system, or cStatusOK if the resize already happened.
 //----------------------------------------------------------------------------------------------------------------------
 vogl_gl_replayer::status_t vogl_gl_replayer::trigger_pending_window_resize(uint win_width, uint win_height)
 {
     VOGL_FUNC_TRACER
 
+    // Offscreen pbuffers are recreated at exactly the requested size, so there's nothing to wait for.
+    if (m_pWindow->is_offscreen())
+    {
+        clear_pending_window_resize();
+
+        if (!m_pWindow->resize(win_width, win_height))
+            vogl_error_printf("%s: Failed resizing offscreen drawable to %ux%u\n", VOGL_FUNCTION_INFO_CSTR, win_width, win_height);
+
+        rebind_offscreen_drawable();
+
+        return cStatusOK;
+    }
+
     m_pending_window_resize_width = win_width;
     m_pending_window_resize_height = win_height;
     m_pending_window_resize_attempt_counter = 0;
     m_time_since_pending_window_resize.start();
 
     m_pWindow->resize(win_width, win_height);
+    rebind_offscreen_drawable();
 
     if (m_flags & cGLReplayerVerboseMode)
         vogl_debug_printf("%s: Waiting for window to resize to %ux%u\n", VOGL_FUNCTION_INFO_CSTR, win_width, win_height);
@@ -581,6 +596,7 @@ vogl_gl_replayer::status_t vogl_gl_replayer::process_frame_check_for_pending_win
         if (m_pending_window_resize_attempt_counter < cMaxSecsToWait)
         {
             m_pWindow->resize(get_pending_window_resize_width(), get_pending_winow_resize_height());
+            rebind_offscreen_drawable();
 
             m_time_since_pending_window_resize.start();
 
@@ -595,6 +611,97 @@ vogl_gl_replayer::status_t vogl_gl_replayer::process_frame_check_for_pending_win
     return cStatusOK;
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+// vogl_replayer::rebind_offscreen_drawable
+// Offscreen windows resize by recreating their pbuffer, so the current context must be made current on the new one.
+//----------------------------------------------------------------------------------------------------------------------
+void vogl_gl_replayer::rebind_offscreen_drawable()
+{
+    VOGL_FUNC_TRACER
+
+    if ((!m_pWindow->is_offscreen()) || (!m_cur_replay_context))
+        return;
+
+    #if (VOGL_PLATFORM_HAS_GLX)
+        if (!GL_ENTRYPOINT(glXMakeCurrent)(m_pWindow->get_display(), m_pWindow->get_drawable(), m_cur_replay_context))
+            vogl_error_printf("%s: Failed making the current context current on the resized offscreen drawable\n", VOGL_FUNCTION_INFO_CSTR);
+    #else
+        VOGL_VERIFY(!"impl vogl_gl_replayer::rebind_offscreen_drawable on this platform");
+    #endif
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// vogl_replayer::present_offscreen_drawable
+// Blits the offscreen drawable's front buffer (the frame just swapped) to the window's back buffer, then swaps the
+// window. The context is temporarily made current with the window as its draw drawable, and every piece of state the
+// blit depends on is restored afterwards. GL errors aren't checked here: that would consume errors still pending from
+// the traced swap, which the replayer's own error checking must see.
+//----------------------------------------------------------------------------------------------------------------------
+bool vogl_gl_replayer::present_offscreen_drawable()
+{
+    VOGL_FUNC_TRACER
+
+    if ((!m_pWindow->is_offscreen()) || (!m_cur_replay_context) || (!m_pCur_context_state))
+        return false;
+
+    const vogl_context_info &context_info = m_pCur_context_state->m_context_info;
+    if ((context_info.get_version() < VOGL_GL_VERSION_3_0) && (!context_info.supports_extension("GL_ARB_framebuffer_object")))
+        return false;
+
+    #if (VOGL_PLATFORM_HAS_GLX)
+        if (!GL_ENTRYPOINT(glXMakeContextCurrent))
+            return false;
+
+        Display *dpy = m_pWindow->get_display();
+        GLXDrawable pbuffer = m_pWindow->get_drawable();
+        Window win = m_pWindow->get_xwindow();
+
+        GLint prev_read_framebuffer = 0, prev_draw_framebuffer = 0, prev_read_buffer = GL_BACK, prev_draw_buffer = GL_BACK;
+        GL_ENTRYPOINT(glGetIntegerv)(GL_READ_FRAMEBUFFER_BINDING, &prev_read_framebuffer);
+        GL_ENTRYPOINT(glGetIntegerv)(GL_DRAW_FRAMEBUFFER_BINDING, &prev_draw_framebuffer);
+        const GLboolean prev_scissor_test = GL_ENTRYPOINT(glIsEnabled)(GL_SCISSOR_TEST);
+
+        if (!GL_ENTRYPOINT(glXMakeContextCurrent)(dpy, win, pbuffer, m_cur_replay_context))
+        {
+            vogl_error_printf("%s: glXMakeContextCurrent() failed, unable to present offscreen drawable\n", VOGL_FUNCTION_INFO_CSTR);
+            GL_ENTRYPOINT(glXMakeCurrent)(dpy, pbuffer, m_cur_replay_context);
+            return false;
+        }
+
+        GL_ENTRYPOINT(glBindFramebuffer)(GL_READ_FRAMEBUFFER, 0);
+        GL_ENTRYPOINT(glBindFramebuffer)(GL_DRAW_FRAMEBUFFER, 0);
+        GL_ENTRYPOINT(glGetIntegerv)(GL_READ_BUFFER, &prev_read_buffer);
+        GL_ENTRYPOINT(glGetIntegerv)(GL_DRAW_BUFFER, &prev_draw_buffer);
+        GL_ENTRYPOINT(glReadBuffer)(GL_FRONT);
+        GL_ENTRYPOINT(glDrawBuffer)(GL_BACK);
+        GL_ENTRYPOINT(glDisable)(GL_SCISSOR_TEST);
+
+        GL_ENTRYPOINT(glBlitFramebuffer)(0, 0, m_pWindow->get_width(), m_pWindow->get_height(),
+                                         0, 0, m_pWindow->get_window_width(), m_pWindow->get_window_height(),
+                                         GL_COLOR_BUFFER_BIT, GL_LINEAR);
+
+        GL_ENTRYPOINT(glXSwapBuffers)(dpy, win);
+
+        GL_ENTRYPOINT(glReadBuffer)(prev_read_buffer);
+        GL_ENTRYPOINT(glDrawBuffer)(prev_draw_buffer);
+        if (prev_scissor_test)
+            GL_ENTRYPOINT(glEnable)(GL_SCISSOR_TEST);
+        GL_ENTRYPOINT(glBindFramebuffer)(GL_READ_FRAMEBUFFER, prev_read_framebuffer);
+        GL_ENTRYPOINT(glBindFramebuffer)(GL_DRAW_FRAMEBUFFER, prev_draw_framebuffer);
+
+        if (!GL_ENTRYPOINT(glXMakeCurrent)(dpy, pbuffer, m_cur_replay_context))
+        {
+            vogl_error_printf("%s: Failed making the current context current on the offscreen drawable again\n", VOGL_FUNCTION_INFO_CSTR);
+            return false;
+        }
+
+        return true;
+    #else
+        VOGL_VERIFY(!"impl vogl_gl_replayer::present_offscreen_drawable on this platform");
+        return false;
+    #endif
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 // vogl_replayer::destroy_pending_snapshot
 //----------------------------------------------------------------------------------------------------------------------
@@ -891,7 +998,8 @@ bool vogl_gl_replayer::set_client_side_array_data(const key_value_map &map, GLui
         {
             uint key_index = base_key_index + inner_iter;
 
-            const uint8_vec *pVertex_blob = map.get_blob(static_cast<uint16>(key_index));
+            uint vertex_blob_size = 0;
+            const uint8 *pVertex_blob = map.get_blob_data(static_cast<uint16>(key_index), vertex_blob_size);
             // TODO: Check for case where blob (or map) is not present, but they still access client side data, this is a bad error
             if (!pVertex_blob)
                 continue;
@@ -977,17 +1085,18 @@ bool vogl_gl_replayer::set_client_side_array_data(const key_value_map &map, GLui
 #endif
 
             uint8_vec temp_blob;
-            if (vertex_data_size != pVertex_blob->size())
+            if (vertex_data_size != vertex_blob_size)
             {
-                process_entrypoint_error("%s: %s will access more client side data (%u bytes) than stored in the trace (%u bytes), using what is in the trace and using zeros for the rest\n", VOGL_FUNCTION_INFO_CSTR, g_vogl_entrypoint_descs[desc.m_entrypoint].m_pName, vertex_data_size, pVertex_blob->size());
-                temp_blob = *pVertex_blob;
+                process_entrypoint_error("%s: %s will access more client side data (%u bytes) than stored in the trace (%u bytes), using what is in the trace and using zeros for the rest\n", VOGL_FUNCTION_INFO_CSTR, g_vogl_entrypoint_descs[desc.m_entrypoint].m_pName, vertex_data_size, vertex_blob_size);
+                temp_blob.append(pVertex_blob, vertex_blob_size);
                 temp_blob.resize(vertex_data_size);
-                pVertex_blob = &temp_blob;
+                pVertex_blob = temp_blob.get_ptr();
+                vertex_blob_size = temp_blob.size();
             }
 
             uint bytes_remaining_at_end = math::maximum<int>(0, (int)VOGL_MAX_CLIENT_SIDE_VERTEX_ARRAY_SIZE - (int)first_vertex_ofs);
-            uint bytes_to_copy = math::minimum<uint>(pVertex_blob->size(), bytes_remaining_at_end);
-            if (bytes_to_copy != pVertex_blob->size())
+            uint bytes_to_copy = math::minimum<uint>(vertex_blob_size, bytes_remaining_at_end);
+            if (bytes_to_copy != vertex_blob_size)
             {
                 // Can't resize buffer, it could move and that would invalidate any VAO pointer bindings.
                 process_entrypoint_error("%s: %s accesses too much client side data (%u bytes), increase VOGL_MAX_CLIENT_SIDE_VERTEX_ARRAY_SIZE\n", VOGL_FUNCTION_INFO_CSTR, g_vogl_entrypoint_descs[desc.m_entrypoint].m_pName, first_vertex_ofs + total_data_size);
@@ -995,7 +1104,7 @@ bool vogl_gl_replayer::set_client_side_array_data(const key_value_map &map, GLui
 
             VOGL_ASSERT((first_vertex_ofs + bytes_to_copy) <= array_data.size());
 
-            memcpy(array_data.get_ptr() + first_vertex_ofs, pVertex_blob->get_ptr(), bytes_to_copy);
+            memcpy(array_data.get_ptr() + first_vertex_ofs, pVertex_blob, bytes_to_copy);
         }
     }
 
@@ -1016,7 +1125,8 @@ bool vogl_gl_replayer::set_client_side_vertex_attrib_array_data(const key_value_
 
     for (int vertex_attrib_index = 0; vertex_attrib_index < static_cast<int>(m_pCur_context_state->m_context_info.get_max_vertex_attribs()); vertex_attrib_index++)
     {
-        const uint8_vec *pVertex_blob = map.get_blob(static_cast<uint16>(vertex_attrib_index));
+        uint vertex_blob_size = 0;
+        const uint8 *pVertex_blob = map.get_blob_data(static_cast<uint16>(vertex_attrib_index), vertex_blob_size);
 
         // TODO: Check for case where blob (or map) is not present, but they still access client side data, this is a bad error
         if (!pVertex_blob)
@@ -1084,17 +1194,18 @@ bool vogl_gl_replayer::set_client_side_vertex_attrib_array_data(const key_value_
         uint total_data_size = last_vertex_ofs + stride;
 
         uint8_vec temp_blob;
-        if (vertex_data_size != pVertex_blob->size())
+        if (vertex_data_size != vertex_blob_size)
         {
-            process_entrypoint_error("%s: Vertex attribute index %i will access more client side data (%u bytes) than stored in the trace (%u bytes), using what is in the trace and using zeros for the rest\n", VOGL_FUNCTION_INFO_CSTR, vertex_attrib_index, vertex_data_size, pVertex_blob->size());
-            temp_blob = *pVertex_blob;
+            process_entrypoint_error("%s: Vertex attribute index %i will access more client side data (%u bytes) than stored in the trace (%u bytes), using what is in the trace and using zeros for the rest\n", VOGL_FUNCTION_INFO_CSTR, vertex_attrib_index, vertex_data_size, vertex_blob_size);
+            temp_blob.append(pVertex_blob, vertex_blob_size);
             temp_blob.resize(vertex_data_size);
-            pVertex_blob = &temp_blob;
+            pVertex_blob = temp_blob.get_ptr();
+            vertex_blob_size = temp_blob.size();
         }
 
         uint bytes_remaining_at_end = math::maximum<int>(0, (int)VOGL_MAX_CLIENT_SIDE_VERTEX_ARRAY_SIZE - (int)first_vertex_ofs);
-        uint bytes_to_copy = math::minimum<uint>(pVertex_blob->size(), bytes_remaining_at_end);
-        if (bytes_to_copy != pVertex_blob->size())
+        uint bytes_to_copy = math::minimum<uint>(vertex_blob_size, bytes_remaining_at_end);
+        if (bytes_to_copy != vertex_blob_size)
         {
             // Can't resize buffer, it could move and that would invalidate any VAO pointer bindings.
             process_entrypoint_error("%s: Vertex attribute index %i accesses too much client side data (%u bytes), increase VOGL_MAX_CLIENT_SIDE_VERTEX_ARRAY_SIZE\n", VOGL_FUNCTION_INFO_CSTR, vertex_attrib_index, first_vertex_ofs + total_data_size);
@@ -1102,7 +1213,7 @@ bool vogl_gl_replayer::set_client_side_vertex_attrib_array_data(const key_value_
 
         VOGL_ASSERT((first_vertex_ofs + bytes_to_copy) <= m_client_side_vertex_attrib_data[vertex_attrib_index].size());
 
-        memcpy(m_client_side_vertex_attrib_data[vertex_attrib_index].get_ptr() + first_vertex_ofs, pVertex_blob->get_ptr(), bytes_to_copy);
+        memcpy(m_client_side_vertex_attrib_data[vertex_attrib_index].get_ptr() + first_vertex_ofs, pVertex_blob, bytes_to_copy);
     }
 
     return true;
@@ -1178,23 +1289,24 @@ bool vogl_gl_replayer::draw_elements_client_side_array_setup(
 
     if ((indexed) && (!element_array_buffer))
     {
-        const uint8_vec *pIndices_vec = map.get_blob(string_hash("indices"));
-        if (!pIndices_vec)
+        key_value_map::const_iterator indices_it = map.find(string_hash("indices"));
+        if ((indices_it == map.end()) || (!indices_it->second.is_blob()))
         {
             process_entrypoint_error("%s: No element array buffer is bound, but key value map doesn't have an indices blob\n", VOGL_FUNCTION_INFO_CSTR);
             return false;
         }
 
-        pIndices = pIndices_vec->get_ptr();
+        uint indices_size = indices_it->second.get_blob_size();
+        pIndices = indices_size ? indices_it->second.get_blob_data() : NULL;
         if (!pIndices)
         {
             process_entrypoint_error("%s: No element array buffer is bound, but key value map has an empty indices blob\n", VOGL_FUNCTION_INFO_CSTR);
             return false;
         }
 
-        if ((pIndices_vec->size() / index_size) != static_cast<uint>(count))
+        if ((indices_size / index_size) != static_cast<uint>(count))
         {
-            process_entrypoint_error("%s: Client side index data blob stored in packet is too small (wanted %u indices, got %u indices)\n", VOGL_FUNCTION_INFO_CSTR, count, pIndices_vec->size() / index_size);
+            process_entrypoint_error("%s: Client side index data blob stored in packet is too small (wanted %u indices, got %u indices)\n", VOGL_FUNCTION_INFO_CSTR, count, indices_size / index_size);
             return false;
         }
     }
@@ -1454,7 +1566,7 @@ vogl_gl_replayer::status_t vogl_gl_replayer::switch_contexts(vogl_trace_context_
 
     #if (VOGL_PLATFORM_HAS_GLX)
         const Display *dpy = m_pWindow->get_display();
-        GLXDrawable drawable = replay_context ? m_pWindow->get_xwindow() : (GLXDrawable)NULL;
+        GLXDrawable drawable = replay_context ? m_pWindow->get_drawable() : (GLXDrawable)NULL;
 
         Bool result = GL_ENTRYPOINT(glXMakeCurrent)(dpy, drawable, replay_context);
     #else
@@ -1576,6 +1688,8 @@ bool vogl_gl_replayer::context_state::handle_context_made_current()
         return false;
     }
 
+    m_fixed_function_shadow.init(m_context_info);
+
     if (m_replayer.m_flags & cGLReplayerLowLevelDebugMode)
     {
         vogl_debug_printf("%s: Creating dummy handles\n", VOGL_FUNCTION_INFO_CSTR);
@@ -1863,7 +1977,7 @@ vogl_gl_replayer::status_t vogl_gl_replayer::process_pending_make_current()
 
     #if (VOGL_PLATFORM_HAS_GLX)
         const Display *dpy = m_pWindow->get_display();
-        GLXDrawable drawable = replay_context ? m_pWindow->get_xwindow() : (GLXDrawable)NULL;
+        GLXDrawable drawable = replay_context ? m_pWindow->get_drawable() : (GLXDrawable)NULL;
         Bool result = GL_ENTRYPOINT(glXMakeCurrent)(dpy, drawable, replay_context);
     #elif (VOGL_PLATFORM_HAS_WGL)
         VOGL_VERIFY(!"impl vogl_gl_replayer::process_pending_make_current on Windows");
@@ -2279,6 +2393,7 @@ void vogl_gl_replayer::handle_use_program(GLuint trace_handle, gl_entrypoint_id_
             get_shared_state()->m_glsl_program_hash_map.erase(prev_trace_program);
 
             was_deleted = get_shared_state()->m_shadow_state.m_linked_programs.remove_snapshot(prev_replay_program);
+            get_shared_state()->m_shadow_state.m_uniform_values.remove_program(prev_replay_program);
             if ((prev_link_status) && (!was_deleted))
             {
                 VOGL_ASSERT_ALWAYS;
@@ -2410,6 +2525,7 @@ void vogl_gl_replayer::handle_delete_program(GLuint trace_handle)
         was_deleted = get_shared_state()->m_glsl_program_hash_map.erase(trace_handle);
 
         get_shared_state()->m_shadow_state.m_linked_programs.remove_snapshot(replay_handle);
+        get_shared_state()->m_shadow_state.m_uniform_values.remove_program(replay_handle);
 
         if (m_pCur_context_state->m_cur_replay_program == replay_handle)
         {
@@ -2570,6 +2686,9 @@ void vogl_gl_replayer::handle_post_link_program(gl_entrypoint_id_t entrypoint_id
         check_gl_error();
     }
 
+    // Linking resets the program's uniforms and may reassign their locations.
+    get_shared_state()->m_shadow_state.m_uniform_values.remove_program(replay_handle);
+
     if ((replay_link_status) || (!get_shared_state()->m_shadow_state.m_linked_programs.find_snapshot(replay_handle)))
     {
         bool success;
@@ -2868,6 +2987,9 @@ void vogl_gl_replayer::handle_link_program(gl_entrypoint_id_t entrypoint_id)
         }
     }
 
+    // A failed relink keeps the program's previous link snapshot, so finish it while the program still holds that link's results.
+    get_shared_state()->m_shadow_state.m_linked_programs.complete_deferred_snapshot(m_pCur_context_state->m_context_info, m_replay_to_trace_remapper, replay_handle);
+
     switch (entrypoint_id)
     {
         case VOGL_ENTRYPOINT_glLinkProgram:
@@ -3491,15 +3613,15 @@ vogl_gl_replayer::status_t vogl_gl_replayer::handle_ShaderSource(GLhandleARB tra
             continue;
         }
 
-        const uint8_vec *pBlob = it->second.get_blob();
-        if (!pBlob)
+        if (!it->second.is_blob())
         {
             process_entrypoint_error("%s: Can't convert string %i to a blob\n", VOGL_FUNCTION_INFO_CSTR, i);
             return cStatusHardFailure;
         }
 
-        blobs[i] = *pBlob;
         uint8_vec &blob = blobs[i];
+        blob.resize(0);
+        blob.append(it->second.get_blob_data(), it->second.get_blob_size());
 
         if ((pTrace_lengths) && (pTrace_lengths[i] >= 0))
         {
@@ -3740,11 +3862,14 @@ vogl_gl_replayer::status_t vogl_gl_replayer::process_gl_entrypoint_packet_intern
                     {
                         if ((m_pWindow->get_width() != win_width) || (m_pWindow->get_height() != win_height))
                         {
-                            m_pending_make_current_packet = *m_pCur_gl_packet;
-
                             status = trigger_pending_window_resize(win_width, win_height);
 
-                            vogl_printf("%s: Deferring glXMakeCurrent() until window resizes to %ux%u\n", VOGL_FUNCTION_INFO_CSTR, win_width, win_height);
+                            if (status == cStatusResizeWindow)
+                            {
+                                m_pending_make_current_packet = *m_pCur_gl_packet;
+
+                                vogl_printf("%s: Deferring glXMakeCurrent() until window resizes to %ux%u\n", VOGL_FUNCTION_INFO_CSTR, win_width, win_height);
+                            }
                         }
                     }
                 }
@@ -3754,7 +3879,7 @@ vogl_gl_replayer::status_t vogl_gl_replayer::process_gl_entrypoint_packet_intern
             {
                 #if (VOGL_PLATFORM_HAS_GLX)
                     const Display *dpy = m_pWindow->get_display();
-                    GLXDrawable drawable = replay_context ? m_pWindow->get_xwindow() : (GLXDrawable)NULL;
+                    GLXDrawable drawable = replay_context ? m_pWindow->get_drawable() : (GLXDrawable)NULL;
                     Bool result = GL_ENTRYPOINT(glXMakeCurrent)(dpy, drawable, replay_context);
                 #elif (VOGL_PLATFORM_HAS_WGL)
                     bool result = true;
@@ -4012,9 +4137,12 @@ vogl_gl_replayer::status_t vogl_gl_replayer::process_gl_entrypoint_packet_intern
 
             #if (VOGL_PLATFORM_HAS_GLX)
                 const Display *dpy = m_pWindow->get_display();
-                GLXDrawable drawable = m_pWindow->get_xwindow();
+                GLXDrawable drawable = m_pWindow->get_drawable();
 
                 GL_ENTRYPOINT(glXSwapBuffers)(dpy, drawable);
+
+                if (m_flags & cGLReplayerOffscreenPresent)
+                    present_offscreen_drawable();
             #elif (VOGL_PLATFORM_HAS_WGL)
                 VOGL_VERIFY(!"impl vogl_gl_replayer::process_gl_entrypoint_packet_internal on Windows");
             #else
@@ -4150,6 +4278,8 @@ vogl_gl_replayer::status_t vogl_gl_replayer::process_gl_entrypoint_packet_intern
     // Add call to current display list
     if ((get_context_state()->is_composing_display_list()) && (g_vogl_entrypoint_descs[entrypoint_id].m_is_listable))
     {
+        bool added_to_list = false;
+
         if (!vogl_display_list_state::is_call_listable(entrypoint_id, trace_packet))
         {
             if (!g_vogl_entrypoint_descs[entrypoint_id].m_whitelisted_for_displaylists)
@@ -4163,7 +4293,34 @@ vogl_gl_replayer::status_t vogl_gl_replayer::process_gl_entrypoint_packet_intern
             {
                 process_entrypoint_warning("%s: Failed adding current packet to display list shadow!\n", VOGL_FUNCTION_INFO_CSTR);
             }
+            else
+            {
+                added_to_list = true;
+            }
+        }
+
+        if (!added_to_list)
+        {
+            vogl_display_list *pList = get_shared_state()->m_shadow_state.m_display_lists.find_list(get_context_state()->m_current_display_list_handle);
+            if (pList)
+                pList->set_has_unlisted_calls();
+        }
+    }
+
+    // glCallList(s) are handled below, where the called lists are known.
+    get_context_state()->m_fixed_function_shadow.update(trace_packet);
+
+    vogl_immediate_mode_batcher &immediate_mode_batcher = m_pCur_context_state->m_immediate_mode_batcher;
+    if ((immediate_mode_batcher.is_active()) && (entrypoint_id != VOGL_ENTRYPOINT_glEnd))
+    {
+        if (immediate_mode_batcher.add(trace_packet))
+        {
+            m_last_processed_call_counter = trace_packet.get_call_counter();
+            return cStatusOK;
         }
+
+        // Something we can't batch, finish the block the regular way.
+        immediate_mode_batcher.flush_to_immediate_mode();
     }
 
     switch (entrypoint_id)
@@ -4265,7 +4422,15 @@ vogl_gl_replayer::status_t vogl_gl_replayer::process_gl_entrypoint_packet_intern
             }
             m_pCur_context_state->m_inside_gl_begin = true;
 
-            g_vogl_actual_gl_entrypoints.m_glBegin(trace_packet.get_param_value<GLenum>(0));
+            GLenum mode = trace_packet.get_param_value<GLenum>(0);
+
+            // Blocks being compiled into display lists must go to GL as-is.
+            bool batched = false;
+            if ((m_flags & cGLReplayerBatchImmediateMode) && (!get_context_state()->is_composing_display_list()))
+                batched = m_pCur_context_state->m_immediate_mode_batcher.begin(m_pCur_context_state->m_context_info, mode);
+
+            if (!batched)
+                g_vogl_actual_gl_entrypoints.m_glBegin(mode);
 
             break;
         }
@@ -4277,7 +4442,10 @@ vogl_gl_replayer::status_t vogl_gl_replayer::process_gl_entrypoint_packet_intern
             }
             m_pCur_context_state->m_inside_gl_begin = false;
 
-            g_vogl_actual_gl_entrypoints.m_glEnd();
+            if (m_pCur_context_state->m_immediate_mode_batcher.is_active())
+                m_pCur_context_state->m_immediate_mode_batcher.end();
+            else
+                g_vogl_actual_gl_entrypoints.m_glEnd();
 
             if ((status = post_draw_call()) != cStatusOK)
                 return status;
@@ -4489,13 +4657,13 @@ vogl_gl_replayer::status_t vogl_gl_replayer::process_gl_entrypoint_packet_intern
         }
         case VOGL_ENTRYPOINT_glGenTextures:
         {
-            if (!gen_handles(get_shared_state()->m_shadow_state.m_textures, trace_packet.get_param_value<GLsizei>(0), static_cast<const GLuint *>(trace_packet.get_param_client_memory_ptr(1)), GL_ENTRYPOINT(glGenTextures), NULL, GL_NONE))
+            if (!gen_handles(get_shared_state()->m_shadow_state.m_textures, trace_packet.get_param_value<GLsizei>(0), static_cast<const GLuint *>(trace_packet.get_param_client_memory_ptr(1)), GL_ENTRYPOINT(glGenTextures), GL_ENTRYPOINT(glDeleteTextures), NULL, GL_NONE))
                 return cStatusHardFailure;
             break;
         }
         case VOGL_ENTRYPOINT_glGenTexturesEXT:
         {
-            if (!gen_handles(get_shared_state()->m_shadow_state.m_textures, trace_packet.get_param_value<GLsizei>(0), static_cast<const GLuint *>(trace_packet.get_param_client_memory_ptr(1)), GL_ENTRYPOINT(glGenTexturesEXT), NULL, GL_NONE))
+            if (!gen_handles(get_shared_state()->m_shadow_state.m_textures, trace_packet.get_param_value<GLsizei>(0), static_cast<const GLuint *>(trace_packet.get_param_client_memory_ptr(1)), GL_ENTRYPOINT(glGenTexturesEXT), GL_ENTRYPOINT(glDeleteTexturesEXT), NULL, GL_NONE))
                 return cStatusHardFailure;
             break;
         }
@@ -4815,13 +4983,13 @@ vogl_gl_replayer::status_t vogl_gl_replayer::process_gl_entrypoint_packet_intern
         }
         case VOGL_ENTRYPOINT_glGenRenderbuffersEXT:
         {
-            if (!gen_handles(get_shared_state()->m_shadow_state.m_rbos, trace_packet.get_param_value<GLsizei>(0), static_cast<const GLuint *>(trace_packet.get_param_client_memory_ptr(1)), GL_ENTRYPOINT(glGenRenderbuffersEXT), NULL, GL_NONE))
+            if (!gen_handles(get_shared_state()->m_shadow_state.m_rbos, trace_packet.get_param_value<GLsizei>(0), static_cast<const GLuint *>(trace_packet.get_param_client_memory_ptr(1)), GL_ENTRYPOINT(glGenRenderbuffersEXT), GL_ENTRYPOINT(glDeleteRenderbuffersEXT), NULL, GL_NONE))
                 return cStatusHardFailure;
             break;
         }
         case VOGL_ENTRYPOINT_glGenRenderbuffers:
         {
-            if (!gen_handles(get_shared_state()->m_shadow_state.m_rbos, trace_packet.get_param_value<GLsizei>(0), static_cast<const GLuint *>(trace_packet.get_param_client_memory_ptr(1)), GL_ENTRYPOINT(glGenRenderbuffers), NULL, GL_NONE))
+            if (!gen_handles(get_shared_state()->m_shadow_state.m_rbos, trace_packet.get_param_value<GLsizei>(0), static_cast<const GLuint *>(trace_packet.get_param_client_memory_ptr(1)), GL_ENTRYPOINT(glGenRenderbuffers), GL_ENTRYPOINT(glDeleteRenderbuffers), NULL, GL_NONE))
                 return cStatusHardFailure;
             break;
         }
@@ -7430,7 +7598,8 @@ vogl_gl_replayer::status_t vogl_gl_replayer::process_gl_entrypoint_packet_intern
                             int64_t ofs = unmap_data.get_int64(i * 4 + 0);
                             int64_t size = unmap_data.get_int64(i * 4 + 1);
                             VOGL_NOTE_UNUSED(size);
-                            const uint8_vec *pData = unmap_data.get_blob(i * 4 + 2);
+                            uint data_size = 0;
+                            const uint8 *pData = unmap_data.get_blob_data(i * 4 + 2, data_size);
                             if (!pData)
                             {
                                 process_entrypoint_error("%s: Failed finding flushed range data in key value map\n", VOGL_FUNCTION_INFO_CSTR);
@@ -7443,11 +7612,11 @@ vogl_gl_replayer::status_t vogl_gl_replayer::process_gl_entrypoint_packet_intern
                                 return cStatusHardFailure;
                             }
 
-                            VOGL_ASSERT(size == pData->size());
+                            VOGL_ASSERT(size == data_size);
 
-                            memcpy(static_cast<uint8 *>(map_desc.m_pPtr) + ofs, pData->get_ptr(), pData->size());
+                            memcpy(static_cast<uint8 *>(map_desc.m_pPtr) + ofs, pData, data_size);
 
-                            GL_ENTRYPOINT(glFlushMappedBufferRange)(target, static_cast<GLintptr>(ofs), pData->size());
+                            GL_ENTRYPOINT(glFlushMappedBufferRange)(target, static_cast<GLintptr>(ofs), data_size);
                         }
                     }
                     else
@@ -7456,7 +7625,8 @@ vogl_gl_replayer::status_t vogl_gl_replayer::process_gl_entrypoint_packet_intern
                         VOGL_NOTE_UNUSED(ofs);
                         int64_t size = unmap_data.get_int64(1);
                         VOGL_NOTE_UNUSED(size);
-                        const uint8_vec *pData = unmap_data.get_blob(2);
+                        uint data_size = 0;
+                        const uint8 *pData = unmap_data.get_blob_data(2, data_size);
                         if (!pData)
                         {
                             process_entrypoint_error("%s: Failed finding mapped data in key value map\n", VOGL_FUNCTION_INFO_CSTR);
@@ -7464,7 +7634,7 @@ vogl_gl_replayer::status_t vogl_gl_replayer::process_gl_entrypoint_packet_intern
                         }
                         else
                         {
-                            memcpy(map_desc.m_pPtr, pData->get_ptr(), pData->size());
+                            memcpy(map_desc.m_pPtr, pData, data_size);
                         }
                     }
                 }
@@ -7917,7 +8087,7 @@ vogl_gl_replayer::status_t vogl_gl_replayer::process_gl_entrypoint_packet_intern
 
             GL_ENTRYPOINT(glCallList)(replay_handle);
 
-            if (!get_shared_state()->m_shadow_state.m_display_lists.parse_list_and_update_shadows(trace_handle, display_list_bind_callback, this))
+            if (!get_shared_state()->m_shadow_state.m_display_lists.parse_list_and_update_shadows(trace_handle, display_list_bind_callback, this, &get_context_state()->m_fixed_function_shadow))
             {
                 process_entrypoint_warning("%s: Failed processing display list shadow for trace handle %u GL handle %u\n", VOGL_FUNCTION_INFO_CSTR, trace_handle, replay_handle);
             }
@@ -8038,7 +8208,7 @@ vogl_gl_replayer::status_t vogl_gl_replayer::process_gl_entrypoint_packet_intern
                     GLuint replay_handle = map_handle(get_shared_state()->m_lists, trace_handle);
                     GL_ENTRYPOINT(glCallList)(replay_handle);
 
-                    if (!get_shared_state()->m_shadow_state.m_display_lists.parse_list_and_update_shadows(trace_handle, display_list_bind_callback, this))
+                    if (!get_shared_state()->m_shadow_state.m_display_lists.parse_list_and_update_shadows(trace_handle, display_list_bind_callback, this, &get_context_state()->m_fixed_function_shadow))
                     {
                         process_entrypoint_warning("%s: Failed processing display list shadow for trace handle %u GL handle %u\n", VOGL_FUNCTION_INFO_CSTR, trace_handle, replay_handle);
                     }
@@ -9151,21 +9321,22 @@ vogl_gl_replayer::status_t vogl_gl_replayer::process_gl_entrypoint_packet_intern
                     return cStatusHardFailure;
                 }
 
-                const uint8_vec *pBlob = it->second.get_blob();
-                if (!pBlob)
+                if (!it->second.is_blob())
                 {
                     process_entrypoint_error("%s: Can't convert string %i to a blob\n", VOGL_FUNCTION_INFO_CSTR, i);
                     return cStatusHardFailure;
                 }
 
-                if (pBlob->find('\0') < 0)
+                const uint8 *pBlob_data = it->second.get_blob_data();
+                uint blob_size = it->second.get_blob_size();
+                if ((!blob_size) || (!memchr(pBlob_data, '\0', blob_size)))
                 {
                     process_entrypoint_error("%s: String %i is not null terminated\n", VOGL_FUNCTION_INFO_CSTR, i);
                     return cStatusHardFailure;
                 }
 
                 dynamic_string str;
-                str.set(reinterpret_cast<const char *>(pBlob->get_ptr()));
+                str.set(reinterpret_cast<const char *>(pBlob_data));
 
                 strings.enlarge(1)->swap(str);
             }
@@ -10038,6 +10209,21 @@ vogl_gl_state_snapshot *vogl_gl_replayer::snapshot_state(const vogl_trace_packet
 
     vogl_printf("%s: Capturing %u context(s)\n", VOGL_FUNCTION_INFO_CSTR, m_contexts.size());
 
+    // Each sharelist group's shared objects are captured exactly once, through one context in the group that has been made current (the root if possible).
+    typedef vogl::hash_map<context_state *, context_state *, bit_hasher<context_state *> > share_group_capture_context_map;
+    share_group_capture_context_map share_group_capture_contexts;
+
+    for (context_hash_map::const_iterator share_it = m_contexts.begin(); share_it != m_contexts.end(); ++share_it)
+    {
+        context_state *pContext_state = share_it->second;
+        if (!pContext_state->m_has_been_made_current)
+            continue;
+
+        context_state *&pCapture_context = share_group_capture_contexts[pContext_state->m_pShared_state];
+        if ((!pCapture_context) || (pContext_state->is_root_context()))
+            pCapture_context = pContext_state;
+    }
+
     context_hash_map::iterator it;
     for (it = m_contexts.begin(); it != m_contexts.end(); ++it)
     {
@@ -10067,11 +10253,14 @@ vogl_gl_state_snapshot *vogl_gl_replayer::snapshot_state(const vogl_trace_packet
             {
                 vogl_warning_printf("%s: Trace context 0x%" PRIX64 " is inside a glBegin, which is not fully supported for state capturing. Capture will continue but will not be replayable.\n", VOGL_FUNCTION_INFO_CSTR, cast_val_to_uint64(it->first));
                 pSnapshot->set_is_restorable(false);
+
+                if (m_pCur_context_state->m_immediate_mode_batcher.is_active())
+                    m_pCur_context_state->m_immediate_mode_batcher.flush_to_immediate_mode();
             }
 
 
             // Init the shadow state needed by the snapshot code.
-            if (!m_pCur_context_state->is_root_context())
+            if (share_group_capture_contexts.value(m_pCur_context_state->m_pShared_state) != m_pCur_context_state)
             {
                 // Only fill in non-shared state.
                 fill_replay_handle_hash_set(pShadow_state->m_framebuffers, get_context_state()->m_framebuffers);
@@ -10079,7 +10268,7 @@ vogl_gl_state_snapshot *vogl_gl_replayer::snapshot_state(const vogl_trace_packet
             }
             else
             {
-                pShadow_state = &m_pCur_context_state->m_shadow_state;
+                pShadow_state = &get_shared_state()->m_shadow_state;
 
                 pShadow_state->m_query_targets = get_shared_state()->m_query_targets;
 
@@ -10115,6 +10304,9 @@ vogl_gl_state_snapshot *vogl_gl_replayer::snapshot_state(const vogl_trace_packet
                     VOGL_NOTE_UNUSED(success);
                 }
 
+                // Finish any link snapshots that were deferred at link time.
+                pShadow_state->m_linked_programs.complete_deferred_snapshots(m_pCur_context_state->m_context_info, m_replay_to_trace_remapper);
+
                 // Program handles filter
                 pShadow_state->m_filter_program_handles = false;
                 pShadow_state->m_program_handles_filter.reset();
@@ -10183,17 +10375,25 @@ vogl_gl_state_snapshot *vogl_gl_replayer::snapshot_state(const vogl_trace_packet
                     }
                 }
 
-            } // if (!m_pCur_context_state->is_root_context())
+            } // if (share_group_capture_contexts.value(m_pCur_context_state->m_pShared_state) != m_pCur_context_state)
 
         } // if (pContext_state->m_has_been_made_current)
 
-        if (!pSnapshot->capture_context(pContext_state->m_context_desc, pContext_state->m_context_info, m_replay_to_trace_remapper, *pShadow_state))
+        // The shadow may be a temporary or the sharelist root's, so hand it this context's fixed function shadow, and
+        // take back whatever the capture reseeded it with.
+        pShadow_state->m_fixed_function_shadow = pContext_state->m_fixed_function_shadow;
+
+        bool captured = pSnapshot->capture_context(pContext_state->m_context_desc, pContext_state->m_context_info, m_replay_to_trace_remapper, *pShadow_state);
+
+        pContext_state->m_fixed_function_shadow = pShadow_state->m_fixed_function_shadow;
+
+        if (!captured)
         {
             vogl_error_printf("%s: Failed capturing trace context 0x%" PRIX64 ", capture failed\n", VOGL_FUNCTION_INFO_CSTR, static_cast<uint64_t>(it->first));
             break;
         }
 
-        if ((pContext_state->m_has_been_made_current) && (m_pCur_context_state->is_root_context()))
+        if ((pContext_state->m_has_been_made_current) && (share_group_capture_contexts.value(m_pCur_context_state->m_pShared_state) == m_pCur_context_state))
         {
             vogl_mapped_buffer_desc_vec &mapped_bufs = get_shared_state()->m_shadow_state.m_mapped_buffers;
 
@@ -10810,6 +11010,11 @@ vogl_gl_replayer::status_t vogl_gl_replayer::restore_objects(
 
     const vogl_gl_object_state_ptr_vec &object_ptrs = context_state.get_objects();
 
+    // Textures are restored back to back, so save/reset the bindings and pixel state they touch once for the whole batch.
+    vogl_scoped_texture_restore_state texture_restore_state;
+    if (state_type == cGLSTTexture)
+        texture_restore_state.save(m_pCur_context_state->m_context_info);
+
     uint n = 0;
 
     for (uint i = 0; i < object_ptrs.size(); i++)
@@ -10820,7 +11025,14 @@ vogl_gl_replayer::status_t vogl_gl_replayer::restore_objects(
             continue;
 
         GLuint64 restore_handle = 0;
-        if (!pState_obj->restore(m_pCur_context_state->m_context_info, trace_to_replay_remapper, restore_handle))
+
+        bool restored;
+        if (state_type == cGLSTTexture)
+            restored = static_cast<const vogl_texture_state *>(pState_obj)->restore(m_pCur_context_state->m_context_info, trace_to_replay_remapper, restore_handle, false);
+        else
+            restored = pState_obj->restore(m_pCur_context_state->m_context_info, trace_to_replay_remapper, restore_handle);
+
+        if (!restored)
         {
             vogl_error_printf("%s: Failed restoring object type %s object index %u trace handle 0x%" PRIX64 " restore handle 0x%" PRIX64 "\n", VOGL_FUNCTION_INFO_CSTR, get_gl_object_state_type_str(state_type), i, (uint64_t)pState_obj->get_snapshot_handle(), (uint64_t)restore_handle);
             return cStatusHardFailure;
@@ -10849,6 +11061,9 @@ vogl_gl_replayer::status_t vogl_gl_replayer::restore_objects(
             {
                 const vogl_program_state *pProg = static_cast<const vogl_program_state *>(pState_obj);
 
+                // Any uniform values cached for this handle belong to whatever program had it before, whether or not the link snapshot remaps.
+                get_shared_state()->m_shadow_state.m_uniform_values.remove_program(static_cast<uint32>(restore_handle));
+
                 if (pProg->has_link_time_snapshot())
                 {
                     vogl_program_state link_snapshot(*pProg->get_link_time_snapshot());
@@ -11336,6 +11551,9 @@ vogl_gl_replayer::status_t vogl_gl_replayer::update_context_shadows(vogl_handle_
 
     check_program_binding_shadow();
 
+    // The restored fixed function state is whatever the snapshot held.
+    m_pCur_context_state->m_fixed_function_shadow.invalidate();
+
     return cStatusOK;
 }
 
@@ -11430,7 +11648,9 @@ vogl_gl_replayer::status_t vogl_gl_replayer::begin_applying_snapshot(const vogl_
 
     if (!(m_flags & cGLReplayerLockWindowDimensions))
     {
-        return trigger_pending_window_resize(pSnapshot->get_window_width(), pSnapshot->get_window_height());
+        status_t status = trigger_pending_window_resize(pSnapshot->get_window_width(), pSnapshot->get_window_height());
+        if (status != cStatusOK)
+            return status;
     }
 
     return process_applying_pending_snapshot();
@@ -11491,7 +11711,7 @@ vogl_gl_replayer::status_t vogl_gl_replayer::restore_context(vogl_handle_remappe
         }
 
         #if (VOGL_PLATFORM_HAS_GLX)
-            GLXDrawable drawable = m_pWindow->get_xwindow();
+            GLXDrawable drawable = m_pWindow->get_drawable();
             Bool result = GL_ENTRYPOINT(glXMakeCurrent)(dpy, drawable, replay_context);
         #elif (VOGL_PLATFORM_HAS_WGL)
             bool result = false;
@@ -11557,6 +11777,7 @@ vogl_gl_replayer::status_t vogl_gl_replayer::process_applying_pending_snapshot()
     uint total_contexts_restored = 0;
     bool restored_default_framebuffer = false;
 
+    // Create every context first. Share contexts must be created after their sharelist context.
     for (;;)
     {
         uint num_contexts_restored_in_this_pass = 0;
@@ -11579,64 +11800,62 @@ vogl_gl_replayer::status_t vogl_gl_replayer::process_applying_pending_snapshot()
             if (status != cStatusOK)
                 goto handle_error;
 
-            // Has this context ever been made current?
-            if (context_state.get_context_info().is_valid())
-            {
-                // Keep this in sync with vogl_gl_object_state_type (the order doesn't need to match the enum, but be sure to restore leaf GL objects first!)
-                const vogl_gl_object_state_type s_object_type_restore_order[] = { cGLSTBuffer, cGLSTSampler, cGLSTQuery, cGLSTRenderbuffer, cGLSTTexture, cGLSTFramebuffer, cGLSTVertexArray, cGLSTShader, cGLSTProgram, cGLSTSync, cGLSTARBProgram };
-                VOGL_ASSUME(VOGL_ARRAY_SIZE(s_object_type_restore_order) == (cGLSTTotalTypes - 1));
+            num_contexts_restored_in_this_pass++;
 
-                if (m_flags & cGLReplayerLowLevelDebugMode)
-                {
-                    if (!validate_textures())
-                        vogl_warning_printf("%s: Failed validating texture handles against handle mapping tables\n", VOGL_FUNCTION_INFO_CSTR);
-                }
+            total_contexts_restored++;
 
-                vogl_const_gl_object_state_ptr_vec &objects_to_delete = objects_to_delete_vec[context_index];
+            restore_context_ptrs[context_index] = NULL;
+        }
 
-                for (uint i = 0; i < VOGL_ARRAY_SIZE(s_object_type_restore_order); i++)
-                {
-                    status = restore_objects(trace_to_replay_remapper, snapshot, context_state, s_object_type_restore_order[i], objects_to_delete);
-                    if (status != cStatusOK)
-                        goto handle_error;
+        if (!num_contexts_restored_in_this_pass)
+            break;
+    }
 
-                    if (m_flags & cGLReplayerLowLevelDebugMode)
-                    {
-                        if (!validate_program_and_shader_handle_tables())
-                            vogl_error_printf("%s: Program/shader handle table validation failed!\n", VOGL_FUNCTION_INFO_CSTR);
+    if (total_contexts_restored != snapshot.get_contexts().size())
+    {
+        vogl_error_printf("%s: Failed satisfying sharelist dependency during context restoration\n", VOGL_FUNCTION_INFO_CSTR);
+        goto handle_error;
+    }
 
-                        if (!validate_textures())
-                            vogl_warning_printf("%s: Failed validating texture handles against handle mapping tables\n", VOGL_FUNCTION_INFO_CSTR);
-                    }
-                }
+    // A sharelist group's shared objects are captured by whichever of its contexts was made current (the root if possible),
+    // which may come after other contexts in the group. So restore every context's shared objects in the first pass, and
+    // the per-context framebuffers/VAOs (which reference them) and general state in the second.
+    for (uint pass = 0; pass < 2; pass++)
+    {
+        for (uint context_index = 0; context_index < context_ptrs.size(); context_index++)
+        {
+            const vogl_context_snapshot &context_state = *context_ptrs[context_index];
 
-                if (m_flags & cGLReplayerLowLevelDebugMode)
-                {
-                    if (!validate_textures())
-                        vogl_warning_printf("%s: Failed validating texture handles against handle mapping tables\n", VOGL_FUNCTION_INFO_CSTR);
-                }
+            // Has this context ever been made current?
+            if (!context_state.get_context_info().is_valid())
+                continue;
 
-                status = restore_display_lists(trace_to_replay_remapper, snapshot, context_state);
-                if (status != cStatusOK)
-                    goto handle_error;
+            status = switch_contexts(context_state.get_context_desc().get_trace_context());
+            if (status != cStatusOK)
+            {
+                vogl_error_printf("%s: Failed switching to trace context 0x%" PRIX64 ", restore failed\n", VOGL_FUNCTION_INFO_CSTR, cast_val_to_uint64(context_state.get_context_desc().get_trace_context()));
+                goto handle_error;
+            }
 
-                // Restore default framebuffer
-                if ((!restored_default_framebuffer) && (snapshot.get_default_framebuffer().is_valid()))
-                {
-                    restored_default_framebuffer = true;
+            // Keep these in sync with vogl_gl_object_state_type (the order doesn't need to match the enum, but be sure to restore leaf GL objects first!)
+            const vogl_gl_object_state_type s_shared_object_type_restore_order[] = { cGLSTBuffer, cGLSTSampler, cGLSTQuery, cGLSTRenderbuffer, cGLSTTexture, cGLSTShader, cGLSTProgram, cGLSTSync, cGLSTARBProgram };
+            const vogl_gl_object_state_type s_container_object_type_restore_order[] = { cGLSTFramebuffer, cGLSTVertexArray };
+            VOGL_ASSUME((VOGL_ARRAY_SIZE(s_shared_object_type_restore_order) + VOGL_ARRAY_SIZE(s_container_object_type_restore_order)) == (cGLSTTotalTypes - 1));
 
-                    if (!snapshot.get_default_framebuffer().restore(m_pCur_context_state->m_context_info, (m_flags & cGLReplayerDisableRestoreFrontBuffer) == 0))
-                    {
-                        vogl_warning_printf("%s: Failed restoring default framebuffer!\n", VOGL_FUNCTION_INFO_CSTR);
-                    }
-                }
+            const vogl_gl_object_state_type *pObject_type_restore_order = pass ? s_container_object_type_restore_order : s_shared_object_type_restore_order;
+            const uint num_object_types = pass ? VOGL_ARRAY_SIZE(s_container_object_type_restore_order) : VOGL_ARRAY_SIZE(s_shared_object_type_restore_order);
 
-                // Beware: restore_general_state() will bind a bunch of stuff from the trace!
-                status = restore_general_state(trace_to_replay_remapper, snapshot, context_state);
-                if (status != cStatusOK)
-                    goto handle_error;
+            if (m_flags & cGLReplayerLowLevelDebugMode)
+            {
+                if (!validate_textures())
+                    vogl_warning_printf("%s: Failed validating texture handles against handle mapping tables\n", VOGL_FUNCTION_INFO_CSTR);
+            }
+
+            vogl_const_gl_object_state_ptr_vec &objects_to_delete = objects_to_delete_vec[context_index];
 
-                status = update_context_shadows(trace_to_replay_remapper, snapshot, context_state);
+            for (uint i = 0; i < num_object_types; i++)
+            {
+                status = restore_objects(trace_to_replay_remapper, snapshot, context_state, pObject_type_restore_order[i], objects_to_delete);
                 if (status != cStatusOK)
                     goto handle_error;
 
@@ -11650,21 +11869,44 @@ vogl_gl_replayer::status_t vogl_gl_replayer::process_applying_pending_snapshot()
                 }
             }
 
-            num_contexts_restored_in_this_pass++;
+            if (!pass)
+            {
+                status = restore_display_lists(trace_to_replay_remapper, snapshot, context_state);
+                if (status != cStatusOK)
+                    goto handle_error;
 
-            total_contexts_restored++;
+                continue;
+            }
 
-            restore_context_ptrs[context_index] = NULL;
-        }
+            // Restore default framebuffer
+            if ((!restored_default_framebuffer) && (snapshot.get_default_framebuffer().is_valid()))
+            {
+                restored_default_framebuffer = true;
 
-        if (!num_contexts_restored_in_this_pass)
-            break;
-    }
+                if (!snapshot.get_default_framebuffer().restore(m_pCur_context_state->m_context_info, (m_flags & cGLReplayerDisableRestoreFrontBuffer) == 0))
+                {
+                    vogl_warning_printf("%s: Failed restoring default framebuffer!\n", VOGL_FUNCTION_INFO_CSTR);
+                }
+            }
 
-    if (total_contexts_restored != snapshot.get_contexts().size())
-    {
-        vogl_error_printf("%s: Failed satisfying sharelist dependency during context restoration\n", VOGL_FUNCTION_INFO_CSTR);
-        goto handle_error;
+            // Beware: restore_general_state() will bind a bunch of stuff from the trace!
+            status = restore_general_state(trace_to_replay_remapper, snapshot, context_state);
+            if (status != cStatusOK)
+                goto handle_error;
+
+            status = update_context_shadows(trace_to_replay_remapper, snapshot, context_state);
+            if (status != cStatusOK)
+                goto handle_error;
+
+            if (m_flags & cGLReplayerLowLevelDebugMode)
+            {
+                if (!validate_program_and_shader_handle_tables())
+                    vogl_error_printf("%s: Program/shader handle table validation failed!\n", VOGL_FUNCTION_INFO_CSTR);
+
+                if (!validate_textures())
+                    vogl_warning_printf("%s: Failed validating texture handles against handle mapping tables\n", VOGL_FUNCTION_INFO_CSTR);
+            }
+        }
     }
 
     for (uint context_index = 0; context_index < context_ptrs.size(); context_index++)
@@ -11812,7 +12054,8 @@ bool vogl_gl_replayer::write_trim_file_internal(vogl_trace_packet_array &trim_pa
         pTrim_snapshot->set_frame_index(0);
 
         json_document doc;
-        if (!pTrim_snapshot->serialize(*doc.get_root(), *trace_writer.get_trace_archive(), &trace_gl_ctypes))
+        vogl_snapshot_stats snapshot_stats;
+        if (!pTrim_snapshot->serialize(*doc.get_root(), *trace_writer.get_trace_archive(), &trace_gl_ctypes, &snapshot_stats))
         {
             console::error("%s: Failed serializing GL state snapshot!\n", VOGL_FUNCTION_INFO_CSTR);
             trace_writer.close();
@@ -11820,6 +12063,8 @@ bool vogl_gl_replayer::write_trim_file_internal(vogl_trace_packet_array &trim_pa
             return false;
         }
 
+        snapshot_stats.print();
+
         vogl::vector<char> snapshot_data;
         doc.serialize(snapshot_data, true, 0, false);
 
@@ -11981,7 +12226,7 @@ bool vogl_gl_replayer::write_trim_file(uint flags, const dynamic_string &trim_fi
                     if (packet_type != cTSPTGLEntrypoint)
                         break;
 
-                    const uint8_vec &packet_buf = trim_packets.get_packet_buf(packet_index);
+                    uint8_vec &packet_buf = trim_packets.get_packet_buf(packet_index);
 
                     const vogl_trace_gl_entrypoint_packet *pGL_packet = &trim_packets.get_packet<vogl_trace_gl_entrypoint_packet>(packet_index);
                     if (pGL_packet->m_entrypoint_id != VOGL_ENTRYPOINT_glInternalTraceCommandRAD)
@@ -11995,7 +12240,7 @@ bool vogl_gl_replayer::write_trim_file(uint flags, const dynamic_string &trim_fi
 
                     GLuint cmd = trace_packet.get_param_value<GLuint>(0);
 
-                    new_trim_packets.push_back(packet_buf);
+                    new_trim_packets.push_back(VOGL_MOVE(packet_buf));
 
                     if (cmd == cITCRDemarcation)
                         break;
@@ -37,6 +37,7 @@
 
 #include "vogl_replay_window.h"
 #include "vogl_gl_state_snapshot.h"
+#include "vogl_immediate_mode_batcher.h"
 #include "vogl_blob_manager.h"
 
 // TODO: Make this a command line param
@@ -66,7 +67,9 @@ enum vogl_gl_replayer_flags
     cGLReplayerDumpBackbufferHashes = 0x00004000,
     cGLReplayerSumHashing = 0x00008000,
     cGLReplayerClearUnintializedBuffers = 0x00010000,
-    cGLReplayerDisableRestoreFrontBuffer = 0x00020000
+    cGLReplayerDisableRestoreFrontBuffer = 0x00020000,
+    cGLReplayerBatchImmediateMode = 0x00040000, // replay simple glBegin/glEnd blocks as single glDrawArrays() calls
+    cGLReplayerOffscreenPresent = 0x00080000    // when the window is offscreen, blit each swapped frame to the window
 };
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -374,6 +377,10 @@ private:
 
             m_current_display_list_handle = -1;
             m_current_display_list_mode = GL_NONE;
+
+            // Link snapshots are only needed for state snapshots/trimming, so only capture the link inputs at link time and
+            // introspect the programs when a snapshot is actually taken.
+            m_shadow_state.m_linked_programs.set_defer_link_snapshots(true);
         }
 
         bool handle_context_made_current();
@@ -438,6 +445,12 @@ private:
 
         vogl_capture_context_params m_shadow_state;
 
+        // Copied into the capture params before snapshotting, which may not be this context's m_shadow_state.
+        vogl_fixed_function_shadow m_fixed_function_shadow;
+
+        // Only used with cGLReplayerBatchImmediateMode.
+        vogl_immediate_mode_batcher m_immediate_mode_batcher;
+
         int m_current_display_list_handle;
         GLenum m_current_display_list_mode;
     };
@@ -503,6 +516,8 @@ private:
     status_t trigger_pending_window_resize(uint win_width, uint win_height);
     void clear_pending_window_resize();
     status_t process_frame_check_for_pending_window_resize();
+    void rebind_offscreen_drawable();
+    bool present_offscreen_drawable();
 
     void destroy_pending_snapshot();
 
@@ -719,41 +734,76 @@ private:
         delete_handles(handle_hash_map, 1, &trace_id, gl_delete_function);
     }
 
-    template <typename T>
-    inline bool gen_handles(vogl_handle_tracker &handle_tracker, GLsizei n, const GLuint *pTrace_ids, T gl_gen_function, GLuint *pReplay_handles, GLenum def_target)
+    template <typename T, typename U>
+    inline bool gen_handles(vogl_handle_tracker &handle_tracker, GLsizei n, const GLuint *pTrace_ids, T gl_gen_function, U gl_delete_function, GLuint *pReplay_handles, GLenum def_target)
     {
         VOGL_FUNC_TRACER
 
+        if (n <= 0)
+            return true;
+
+        // Gen all the replay handles we need with a single call, then add them to the tracker in bulk.
+        vogl::growable_array<GLuint, 32> replay_ids;
+        replay_ids.resize(n);
+
+        uint num_to_gen = 0;
+        for (GLsizei i = 0; i < n; i++)
+            if (pTrace_ids[i])
+                num_to_gen++;
+
+        vogl::growable_array<GLuint, 32> genned_ids;
+        genned_ids.resize(num_to_gen);
+        if (num_to_gen)
+            gl_gen_function(num_to_gen, genned_ids.get_ptr());
+
+        uint genned_index = 0;
         for (GLsizei i = 0; i < n; i++)
         {
-            if (pReplay_handles)
-                pReplay_handles[i] = 0;
+            replay_ids[i] = 0;
 
             if (!pTrace_ids[i])
                 continue;
 
-            GLuint replay_id = 0;
-            gl_gen_function(1, &replay_id);
-
+            GLuint replay_id = genned_ids[genned_index++];
             if (!replay_id)
             {
                 process_entrypoint_error("%s: GL handle gen call failed, but succeeded in the trace!\n", VOGL_FUNCTION_INFO_CSTR);
+
+                // None of the genned handles have been added to the tracker yet, so delete whichever ones the driver did return.
+                uint num_to_delete = 0;
+                for (uint j = 0; j < num_to_gen; j++)
+                    if (genned_ids[j])
+                        genned_ids[num_to_delete++] = genned_ids[j];
+                if (num_to_delete)
+                    gl_delete_function(num_to_delete, genned_ids.get_ptr());
+
+                if (pReplay_handles)
+                    memset(pReplay_handles, 0, sizeof(GLuint) * n);
                 return false;
             }
 
-            if (pReplay_handles)
-                pReplay_handles[i] = replay_id;
+            replay_ids[i] = replay_id;
+        }
 
-            if (!handle_tracker.insert(pTrace_ids[i], replay_id, def_target))
-            {
-                process_entrypoint_error("%s: Replacing genned GL handle %u trace handle %u in handle hash map (this indicates a handle shadowing error)\n", VOGL_FUNCTION_INFO_CSTR, replay_id, pTrace_ids[i]);
+        if (pReplay_handles)
+            memcpy(pReplay_handles, replay_ids.get_ptr(), sizeof(GLuint) * n);
+
+        uint cur_index = 0;
+        while (cur_index < static_cast<uint>(n))
+        {
+            cur_index += handle_tracker.insert_array(n - cur_index, pTrace_ids + cur_index, replay_ids.get_ptr() + cur_index, def_target);
+            if (cur_index >= static_cast<uint>(n))
+                break;
 
-                handle_tracker.erase(pTrace_ids[i]);
+            process_entrypoint_error("%s: Replacing genned GL handle %u trace handle %u in handle hash map (this indicates a handle shadowing error)\n", VOGL_FUNCTION_INFO_CSTR, replay_ids[cur_index], pTrace_ids[cur_index]);
 
-                bool success = handle_tracker.insert(pTrace_ids[i], replay_id, def_target);
-                VOGL_ASSERT(success);
-                VOGL_NOTE_UNUSED(success);
-            }
+            handle_tracker.erase(pTrace_ids[cur_index]);
+
+            bool success = handle_tracker.insert(pTrace_ids[cur_index], replay_ids[cur_index], def_target);
+            VOGL_ASSERT(success);
+            VOGL_NOTE_UNUSED(success);
+
+            cur_index++;
         }
 
         return true;
@@ -788,26 +838,33 @@ private:
     {
         VOGL_FUNC_TRACER
 
+        if (trace_n <= 0)
+            return;
+
         vogl::growable_array<GLuint, 32> replay_ids;
-        replay_ids.reserve(trace_n);
+        replay_ids.resize(trace_n);
 
-        for (int i = 0; i < trace_n; i++)
+        uint cur_index = 0;
+        while (cur_index < static_cast<uint>(trace_n))
         {
-            GLuint trace_id = pTrace_ids[i];
-            if (!trace_id)
-                continue;
+            cur_index += handle_tracker.erase_array(trace_n - cur_index, pTrace_ids + cur_index, replay_ids.get_ptr() + cur_index);
+            if (cur_index >= static_cast<uint>(trace_n))
+                break;
 
-            GLuint replay_id = trace_id;
-            if (!handle_tracker.map_handle_to_inv_handle(trace_id, replay_id))
-                process_entrypoint_warning("%s: Couldn't map trace GL handle %u to replay GL handle, using trace handle instead, namespace %s\n", VOGL_FUNCTION_INFO_CSTR, pTrace_ids[i], vogl_get_namespace_name(handle_tracker.get_namespace()));
-            else
-                handle_tracker.erase(trace_id);
+            process_entrypoint_warning("%s: Couldn't map trace GL handle %u to replay GL handle, using trace handle instead, namespace %s\n", VOGL_FUNCTION_INFO_CSTR, pTrace_ids[cur_index], vogl_get_namespace_name(handle_tracker.get_namespace()));
 
-            replay_ids.push_back(replay_id);
+            replay_ids[cur_index] = pTrace_ids[cur_index];
+            cur_index++;
         }
 
-        if (replay_ids.size())
-            gl_delete_function(replay_ids.size(), replay_ids.get_ptr());
+        // Skip the zero handles, like the trace.
+        uint num_replay_ids = 0;
+        for (GLsizei i = 0; i < trace_n; i++)
+            if (pTrace_ids[i])
+                replay_ids[num_replay_ids++] = replay_ids[i];
+
+        if (num_replay_ids)
+            gl_delete_function(num_replay_ids, replay_ids.get_ptr());
     }
 
     static void delete_program_helper(GLsizei n, const GLuint *pIDs)
@@ -923,6 +980,40 @@ private:
         return determine_uniform_replay_location(m_pCur_context_state->m_cur_trace_program, trace_location);
     }
 
+    static inline GLenum get_uniform_base_type(const GLfloat *)
+    {
+        return GL_FLOAT;
+    }
+    static inline GLenum get_uniform_base_type(const GLdouble *)
+    {
+        return GL_DOUBLE;
+    }
+    static inline GLenum get_uniform_base_type(const GLint *)
+    {
+        return GL_INT;
+    }
+    static inline GLenum get_uniform_base_type(const GLuint *)
+    {
+        return GL_UNSIGNED_INT;
+    }
+
+    // Mirrors a replayed uniform write into the uniform value shadow, which state snapshots read instead of glGetUniform*().
+    template <class T>
+    inline void update_uniform_value_shadow(GLuint replay_program, GLint replay_location, GLsizei count, GLboolean transpose, uint num_components, const T *pValues)
+    {
+        vogl_uniform_value_shadow &shadow = get_shared_state()->m_shadow_state.m_uniform_values;
+
+        if (!replay_program)
+        {
+            // No current program: the write either failed or went to a program pipeline's active program, which isn't tracked.
+            shadow.clear();
+        }
+        else if (transpose)
+            shadow.invalidate(replay_program, replay_location, count);
+        else
+            shadow.set(replay_program, replay_location, count, get_uniform_base_type(pValues), num_components, pValues);
+    }
+
     template <uint N, class T, class F>
     inline void set_uniformv_helper(F func)
     {
@@ -935,6 +1026,8 @@ private:
         VOGL_ASSERT((uint)m_pCur_gl_packet->get_param_client_memory_data_size(2) == sizeof(T) * N * count);
 
         func(replay_location, count, pValues);
+
+        update_uniform_value_shadow(m_pCur_context_state->m_cur_replay_program, replay_location, count, GL_FALSE, N, pValues);
     }
 
     template <uint C, uint R, class T, class F>
@@ -950,6 +1043,8 @@ private:
         VOGL_ASSERT((uint)m_pCur_gl_packet->get_param_client_memory_data_size(3) == sizeof(T) * C * R * count);
 
         func(replay_location, count, transpose, pValues);
+
+        update_uniform_value_shadow(m_pCur_context_state->m_cur_replay_program, replay_location, count, transpose, C * R, pValues);
     }
 
     // glUniform* helpers
@@ -958,7 +1053,12 @@ private:
     {
         VOGL_FUNC_TRACER
 
-        func(determine_uniform_replay_location(m_pCur_gl_packet->get_param_value<GLint>(0)), m_pCur_gl_packet->get_param_value<T>(1));
+        GLint replay_location = determine_uniform_replay_location(m_pCur_gl_packet->get_param_value<GLint>(0));
+        const T values[1] = { m_pCur_gl_packet->get_param_value<T>(1) };
+
+        func(replay_location, values[0]);
+
+        update_uniform_value_shadow(m_pCur_context_state->m_cur_replay_program, replay_location, 1, GL_FALSE, 1, values);
     }
 
     template <class T, class F>
@@ -966,7 +1066,12 @@ private:
     {
         VOGL_FUNC_TRACER
 
-        func(determine_uniform_replay_location(m_pCur_gl_packet->get_param_value<GLint>(0)), m_pCur_gl_packet->get_param_value<T>(1), m_pCur_gl_packet->get_param_value<T>(2));
+        GLint replay_location = determine_uniform_replay_location(m_pCur_gl_packet->get_param_value<GLint>(0));
+        const T values[2] = { m_pCur_gl_packet->get_param_value<T>(1), m_pCur_gl_packet->get_param_value<T>(2) };
+
+        func(replay_location, values[0], values[1]);
+
+        update_uniform_value_shadow(m_pCur_context_state->m_cur_replay_program, replay_location, 1, GL_FALSE, 2, values);
     }
 
     template <class T, class F>
@@ -974,7 +1079,12 @@ private:
     {
         VOGL_FUNC_TRACER
 
-        func(determine_uniform_replay_location(m_pCur_gl_packet->get_param_value<GLint>(0)), m_pCur_gl_packet->get_param_value<T>(1), m_pCur_gl_packet->get_param_value<T>(2), m_pCur_gl_packet->get_param_value<T>(3));
+        GLint replay_location = determine_uniform_replay_location(m_pCur_gl_packet->get_param_value<GLint>(0));
+        const T values[3] = { m_pCur_gl_packet->get_param_value<T>(1), m_pCur_gl_packet->get_param_value<T>(2), m_pCur_gl_packet->get_param_value<T>(3) };
+
+        func(replay_location, values[0], values[1], values[2]);
+
+        update_uniform_value_shadow(m_pCur_context_state->m_cur_replay_program, replay_location, 1, GL_FALSE, 3, values);
     }
 
     template <class T, class F>
@@ -982,7 +1092,12 @@ private:
     {
         VOGL_FUNC_TRACER
 
-        func(determine_uniform_replay_location(m_pCur_gl_packet->get_param_value<GLint>(0)), m_pCur_gl_packet->get_param_value<T>(1), m_pCur_gl_packet->get_param_value<T>(2), m_pCur_gl_packet->get_param_value<T>(3), m_pCur_gl_packet->get_param_value<T>(4));
+        GLint replay_location = determine_uniform_replay_location(m_pCur_gl_packet->get_param_value<GLint>(0));
+        const T values[4] = { m_pCur_gl_packet->get_param_value<T>(1), m_pCur_gl_packet->get_param_value<T>(2), m_pCur_gl_packet->get_param_value<T>(3), m_pCur_gl_packet->get_param_value<T>(4) };
+
+        func(replay_location, values[0], values[1], values[2], values[3]);
+
+        update_uniform_value_shadow(m_pCur_context_state->m_cur_replay_program, replay_location, 1, GL_FALSE, 4, values);
     }
 
     // glSetProgramUniform* helpers
@@ -993,7 +1108,12 @@ private:
 
         GLuint trace_handle = m_pCur_gl_packet->get_param_value<GLuint>(0);
         GLuint replay_handle = map_handle(m_pCur_context_state->m_pShared_state->m_shadow_state.m_objs, trace_handle);
-        func(replay_handle, determine_uniform_replay_location(trace_handle, m_pCur_gl_packet->get_param_value<GLint>(1)), m_pCur_gl_packet->get_param_value<T>(2));
+        GLint replay_location = determine_uniform_replay_location(trace_handle, m_pCur_gl_packet->get_param_value<GLint>(1));
+        const T values[1] = { m_pCur_gl_packet->get_param_value<T>(2) };
+
+        func(replay_handle, replay_location, values[0]);
+
+        update_uniform_value_shadow(replay_handle, replay_location, 1, GL_FALSE, 1, values);
     }
 
     template <class T, class F>
@@ -1003,7 +1123,12 @@ private:
 
         GLuint trace_handle = m_pCur_gl_packet->get_param_value<GLuint>(0);
         GLuint replay_handle = map_handle(m_pCur_context_state->m_pShared_state->m_shadow_state.m_objs, trace_handle);
-        func(replay_handle, determine_uniform_replay_location(trace_handle, m_pCur_gl_packet->get_param_value<GLint>(1)), m_pCur_gl_packet->get_param_value<T>(2), m_pCur_gl_packet->get_param_value<T>(3));
+        GLint replay_location = determine_uniform_replay_location(trace_handle, m_pCur_gl_packet->get_param_value<GLint>(1));
+        const T values[2] = { m_pCur_gl_packet->get_param_value<T>(2), m_pCur_gl_packet->get_param_value<T>(3) };
+
+        func(replay_handle, replay_location, values[0], values[1]);
+
+        update_uniform_value_shadow(replay_handle, replay_location, 1, GL_FALSE, 2, values);
     }
 
     template <class T, class F>
@@ -1013,7 +1138,12 @@ private:
 
         GLuint trace_handle = m_pCur_gl_packet->get_param_value<GLuint>(0);
         GLuint replay_handle = map_handle(m_pCur_context_state->m_pShared_state->m_shadow_state.m_objs, trace_handle);
-        func(replay_handle, determine_uniform_replay_location(trace_handle, m_pCur_gl_packet->get_param_value<GLint>(1)), m_pCur_gl_packet->get_param_value<T>(2), m_pCur_gl_packet->get_param_value<T>(3), m_pCur_gl_packet->get_param_value<T>(4));
+        GLint replay_location = determine_uniform_replay_location(trace_handle, m_pCur_gl_packet->get_param_value<GLint>(1));
+        const T values[3] = { m_pCur_gl_packet->get_param_value<T>(2), m_pCur_gl_packet->get_param_value<T>(3), m_pCur_gl_packet->get_param_value<T>(4) };
+
+        func(replay_handle, replay_location, values[0], values[1], values[2]);
+
+        update_uniform_value_shadow(replay_handle, replay_location, 1, GL_FALSE, 3, values);
     }
 
     template <class T, class F>
@@ -1023,7 +1153,12 @@ private:
 
         GLuint trace_handle = m_pCur_gl_packet->get_param_value<GLuint>(0);
         GLuint replay_handle = map_handle(m_pCur_context_state->m_pShared_state->m_shadow_state.m_objs, trace_handle);
-        func(replay_handle, determine_uniform_replay_location(trace_handle, m_pCur_gl_packet->get_param_value<GLint>(1)), m_pCur_gl_packet->get_param_value<T>(2), m_pCur_gl_packet->get_param_value<T>(3), m_pCur_gl_packet->get_param_value<T>(4), m_pCur_gl_packet->get_param_value<T>(5));
+        GLint replay_location = determine_uniform_replay_location(trace_handle, m_pCur_gl_packet->get_param_value<GLint>(1));
+        const T values[4] = { m_pCur_gl_packet->get_param_value<T>(2), m_pCur_gl_packet->get_param_value<T>(3), m_pCur_gl_packet->get_param_value<T>(4), m_pCur_gl_packet->get_param_value<T>(5) };
+
+        func(replay_handle, replay_location, values[0], values[1], values[2], values[3]);
+
+        update_uniform_value_shadow(replay_handle, replay_location, 1, GL_FALSE, 4, values);
     }
 
     template <uint C, uint R, class T, class F>
@@ -1042,6 +1177,8 @@ private:
         VOGL_ASSERT((uint)m_pCur_gl_packet->get_param_client_memory_data_size(4) == sizeof(T) * C * R * count);
 
         func(replay_handle, replay_location, count, transpose, pValues);
+
+        update_uniform_value_shadow(replay_handle, replay_location, count, transpose, C * R, pValues);
     }
 
     template <uint N, class T, class F>
@@ -1060,6 +1197,8 @@ private:
         VOGL_ASSERT((uint)m_pCur_gl_packet->get_param_client_memory_data_size(3) == sizeof(T) * N * count);
 
         func(replay_handle, replay_location, count, pValues);
+
+        update_uniform_value_shadow(replay_handle, replay_location, count, GL_FALSE, N, pValues);
     }
 
     static void delete_objects_arb(GLsizei n, const GLuint *pHandles)
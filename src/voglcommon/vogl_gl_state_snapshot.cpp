@@ -27,6 +27,215 @@
 #include "vogl_gl_state_snapshot.h"
 #include "vogl_uuid.h"
 
+//----------------------------------------------------------------------------------------------------------------------
+// Parallel object (de)serialization
+// By the time a snapshot is serialized all GL readback has already happened, so each object's JSON subtree can be built
+// (or parsed) independently on a worker thread. The JSON nodes are always created up front in the usual order, so the
+// output doesn't depend on the number of threads.
+//----------------------------------------------------------------------------------------------------------------------
+typedef bool (*vogl_object_task_func)(uint index, void *pContext);
+
+struct vogl_object_task_state
+{
+    vogl_object_task_func m_pFunc;
+    void *m_pContext;
+    uint m_num_objects;
+    atomic32_t m_next_index;
+    atomic32_t m_failed;
+};
+
+static void vogl_object_task_callback(uint64_t data, void *pData_ptr)
+{
+    VOGL_NOTE_UNUSED(data);
+
+    vogl_object_task_state *pState = static_cast<vogl_object_task_state *>(pData_ptr);
+
+    while (!pState->m_failed)
+    {
+        const uint index = static_cast<uint>(atomic_increment32(&pState->m_next_index) - 1);
+        if (index >= pState->m_num_objects)
+            break;
+
+        if (!pState->m_pFunc(index, pState->m_pContext))
+            atomic_exchange32(&pState->m_failed, 1);
+    }
+}
+
+// Calls pFunc once for each object, spread across a temporary task pool when there are enough objects to make it worthwhile.
+// Returns false if any call failed (remaining objects may then be skipped).
+static bool vogl_process_objects(uint num_objects, vogl_object_task_func pFunc, void *pContext)
+{
+    VOGL_FUNC_TRACER
+
+    enum
+    {
+        cMinObjectsForParallel = 16
+    };
+
+    vogl_object_task_state state;
+    state.m_pFunc = pFunc;
+    state.m_pContext = pContext;
+    state.m_num_objects = num_objects;
+    state.m_next_index = 0;
+    state.m_failed = 0;
+
+    task_pool tp;
+    if ((g_number_of_processors > 1) && (num_objects >= cMinObjectsForParallel) && (tp.init(math::minimum<uint>(g_number_of_processors, task_pool::cMaxThreads) - 1)))
+    {
+        for (uint i = 0; i < tp.get_num_threads(); i++)
+            tp.queue_task(vogl_object_task_callback, 0, &state);
+    }
+
+    // The calling thread pulls objects too, and handles everything when the pool couldn't be created.
+    vogl_object_task_callback(0, &state);
+
+    tp.join();
+
+    return !state.m_failed;
+}
+
+struct vogl_object_serialize_context
+{
+    const vogl_gl_object_state_ptr_vec *m_pObjs;
+    const vogl::vector<json_node *> *m_pNodes;
+    vogl_blob_manager *m_pBlob_manager;
+
+    // Each task writes only its own entry, so no locking is needed.
+    vogl::vector<timer_ticks> *m_pTicks;
+};
+
+static bool vogl_serialize_object_task(uint index, void *pContext)
+{
+    const vogl_object_serialize_context *pCtx = static_cast<const vogl_object_serialize_context *>(pContext);
+
+    timer_ticks start_ticks = timer::get_ticks();
+
+    bool success = (*pCtx->m_pObjs)[index]->serialize(*(*pCtx->m_pNodes)[index], *pCtx->m_pBlob_manager);
+
+    (*pCtx->m_pTicks)[index] = timer::get_ticks() - start_ticks;
+
+    return success;
+}
+
+struct vogl_object_deserialize_context
+{
+    vogl_gl_object_state_ptr_vec *m_pObjs;
+    const vogl::vector<const json_node *> *m_pNodes;
+    const vogl_blob_manager *m_pBlob_manager;
+};
+
+static bool vogl_deserialize_object_task(uint index, void *pContext)
+{
+    const vogl_object_deserialize_context *pCtx = static_cast<const vogl_object_deserialize_context *>(pContext);
+
+    return (*pCtx->m_pObjs)[index]->deserialize(*(*pCtx->m_pNodes)[index], *pCtx->m_pBlob_manager);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// class vogl_snapshot_stats
+//----------------------------------------------------------------------------------------------------------------------
+void vogl_snapshot_stats::clear()
+{
+    VOGL_FUNC_TRACER
+
+    utils::zero_object(m_object_types);
+    m_context_state_time = 0;
+}
+
+vogl_snapshot_stats::object_type_stats vogl_snapshot_stats::get_total() const
+{
+    VOGL_FUNC_TRACER
+
+    object_type_stats total;
+    utils::zero_object(total);
+
+    for (uint i = 0; i < cGLSTTotalTypes; i++)
+    {
+        total.m_total_objects += m_object_types[i].m_total_objects;
+        total.m_total_reduced += m_object_types[i].m_total_reduced;
+        total.m_total_bytes += m_object_types[i].m_total_bytes;
+        total.m_snapshot_time += m_object_types[i].m_snapshot_time;
+        total.m_serialize_time += m_object_types[i].m_serialize_time;
+    }
+
+    return total;
+}
+
+void vogl_snapshot_stats::print() const
+{
+    VOGL_FUNC_TRACER
+
+    vogl_message_printf("Snapshot cost: Context state snapshot time %3.3f secs\n", m_context_state_time);
+
+    for (uint i = 0; i < cGLSTTotalTypes; i++)
+    {
+        const object_type_stats &stats = m_object_types[i];
+        if (!stats.m_total_objects)
+            continue;
+
+        vogl_message_printf("Snapshot cost: %16s: %6u objects (%u reduced), %12" PRIu64 " bytes, snapshot time %3.3f secs, serialize time %3.3f secs\n",
+                            get_gl_object_state_type_str(static_cast<vogl_gl_object_state_type>(i)), stats.m_total_objects, stats.m_total_reduced, stats.m_total_bytes, stats.m_snapshot_time, stats.m_serialize_time);
+    }
+
+    object_type_stats total(get_total());
+    vogl_message_printf("Snapshot cost: %16s: %6u objects (%u reduced), %12" PRIu64 " bytes, snapshot time %3.3f secs, serialize time %3.3f secs\n",
+                        "Total", total.m_total_objects, total.m_total_reduced, total.m_total_bytes, total.m_snapshot_time, total.m_serialize_time);
+}
+
+bool vogl_snapshot_stats::serialize(json_node &node) const
+{
+    VOGL_FUNC_TRACER
+
+    node.add_key_value("context_state_time", m_context_state_time);
+
+    json_node &types_node = node.add_object("object_types");
+    for (uint i = 0; i < cGLSTTotalTypes; i++)
+    {
+        const object_type_stats &stats = m_object_types[i];
+        if (!stats.m_total_objects)
+            continue;
+
+        json_node &type_node = types_node.add_object(get_gl_object_state_type_str(static_cast<vogl_gl_object_state_type>(i)));
+        type_node.add_key_value("objects", stats.m_total_objects);
+        type_node.add_key_value("reduced", stats.m_total_reduced);
+        type_node.add_key_value("bytes", stats.m_total_bytes);
+        type_node.add_key_value("snapshot_time", stats.m_snapshot_time);
+        type_node.add_key_value("serialize_time", stats.m_serialize_time);
+    }
+
+    return true;
+}
+
+bool vogl_snapshot_stats::deserialize(const json_node &node)
+{
+    VOGL_FUNC_TRACER
+
+    clear();
+
+    m_context_state_time = node.value_as_double("context_state_time");
+
+    const json_node *pTypes_node = node.find_child_object("object_types");
+    if (pTypes_node)
+    {
+        for (uint i = 0; i < pTypes_node->size(); i++)
+        {
+            vogl_gl_object_state_type state_type = determine_gl_object_state_type_from_str(pTypes_node->get_key(i).get_ptr());
+            const json_node *pType_node = pTypes_node->get_value_as_object(i);
+            if ((state_type == cGLSTInvalid) || (!pType_node))
+                continue;
+
+            object_type_stats &stats = m_object_types[state_type];
+            stats.m_total_objects = pType_node->value_as_uint32("objects");
+            stats.m_total_reduced = pType_node->value_as_uint32("reduced");
+            stats.m_total_bytes = pType_node->value_as_uint64("bytes");
+            stats.m_snapshot_time = pType_node->value_as_double("snapshot_time");
+            stats.m_serialize_time = pType_node->value_as_double("serialize_time");
+        }
+    }
+
+    return true;
+}
+
 vogl_context_snapshot::vogl_context_snapshot()
     : m_is_valid(false)
 {
@@ -71,7 +280,8 @@ void vogl_context_snapshot::clear()
 }
 
 // Note info may NOT be valid here if the context was never made current!
-bool vogl_context_snapshot::capture(const vogl_context_desc &desc, const vogl_context_info &info, const vogl_capture_context_params &capture_params, vogl_handle_remapper &remapper)
+bool vogl_context_snapshot::capture(const vogl_context_desc &desc, const vogl_context_info &info, const vogl_capture_context_params &capture_params, vogl_handle_remapper &remapper,
+                                    const vogl_snapshot_budget &budget, vogl_snapshot_stats &stats, const vogl_capture_context_params *pShared_capture_params)
 {
     VOGL_FUNC_TRACER
 
@@ -83,11 +293,13 @@ bool vogl_context_snapshot::capture(const vogl_context_desc &desc, const vogl_co
 
     m_context_desc = desc;
     m_context_info = info;
-    m_display_list_state = capture_params.m_display_lists;
+    m_display_list_state = pShared_capture_params ? pShared_capture_params->m_display_lists : capture_params.m_display_lists;
 
     // Has this context been ever made current?
     if (info.is_valid())
     {
+        timer_ticks context_state_start_ticks = timer::get_ticks();
+
         if (!m_general_state.snapshot(m_context_info))
             goto handle_error;
 
@@ -96,16 +308,16 @@ bool vogl_context_snapshot::capture(const vogl_context_desc &desc, const vogl_co
 
         if (!info.is_core_profile())
         {
-            if (!m_texenv_state.snapshot(m_context_info))
+            if (!m_texenv_state.snapshot(m_context_info, capture_params.m_fixed_function_shadow))
                 goto handle_error;
 
-            if (!m_light_state.snapshot(m_context_info))
+            if (!m_light_state.snapshot(m_context_info, capture_params.m_fixed_function_shadow))
                 goto handle_error;
 
-            if (!m_material_state.snapshot(m_context_info))
+            if (!m_material_state.snapshot(m_context_info, capture_params.m_fixed_function_shadow))
                 goto handle_error;
 
-            if (!m_matrix_state.snapshot(m_context_info))
+            if (!m_matrix_state.snapshot(m_context_info, capture_params.m_fixed_function_shadow))
                 goto handle_error;
 
             if (!m_polygon_stipple_state.snapshot(m_context_info))
@@ -118,13 +330,22 @@ bool vogl_context_snapshot::capture(const vogl_context_desc &desc, const vogl_co
             }
         }
 
+        stats.m_context_state_time += timer::ticks_to_secs(timer::get_ticks() - context_state_start_ticks);
+
         // Keep this list in sync with vogl_gl_object_state_type (order doesn't matter, just make sure all valid object types are present)
         const vogl_gl_object_state_type s_object_type_capture_order[] = { cGLSTTexture, cGLSTBuffer, cGLSTSampler, cGLSTQuery, cGLSTRenderbuffer, cGLSTFramebuffer, cGLSTVertexArray, cGLSTShader, cGLSTProgram, cGLSTSync, cGLSTARBProgram };
         VOGL_ASSUME(VOGL_ARRAY_SIZE(s_object_type_capture_order) == cGLSTTotalTypes - 1);
 
         for (uint i = 0; i < VOGL_ARRAY_SIZE(s_object_type_capture_order); i++)
-            if (!capture_objects(s_object_type_capture_order[i], capture_params, remapper))
+        {
+            vogl_gl_object_state_type state_type = s_object_type_capture_order[i];
+
+            // Framebuffers and VAOs are container objects, which are never shared.
+            bool is_shared_type = (state_type != cGLSTFramebuffer) && (state_type != cGLSTVertexArray);
+
+            if (!capture_objects(state_type, (is_shared_type && pShared_capture_params) ? *pShared_capture_params : capture_params, remapper, budget, stats))
                 goto handle_error;
+        }
     }
 
     m_is_valid = true;
@@ -182,7 +403,7 @@ bool vogl_context_snapshot::remap_handles(vogl_handle_remapper &remapper)
     return true;
 }
 
-bool vogl_context_snapshot::capture_objects(vogl_gl_object_state_type state_type, const vogl_capture_context_params &capture_params, vogl_handle_remapper &remapper)
+bool vogl_context_snapshot::capture_objects(vogl_gl_object_state_type state_type, const vogl_capture_context_params &capture_params, vogl_handle_remapper &remapper, const vogl_snapshot_budget &budget, vogl_snapshot_stats &stats)
 {
     VOGL_FUNC_TRACER
 
@@ -190,6 +411,9 @@ bool vogl_context_snapshot::capture_objects(vogl_gl_object_state_type state_type
 
     uint total = 0;
 
+    vogl_snapshot_stats::object_type_stats &type_stats = stats.get(state_type);
+    timer_ticks start_ticks = timer::get_ticks();
+
     if ((state_type == cGLSTVertexArray) && (m_context_info.is_compatibility_profile()))
     {
         // Save the default VAO.
@@ -257,21 +481,21 @@ bool vogl_context_snapshot::capture_objects(vogl_gl_object_state_type state_type
             }
             case cGLSTTexture:
             {
-                for (uint i = 0; i < capture_params.m_textures.size(); i++)
+                const vogl_handle_tracker &tracker = capture_params.m_textures;
+                for (uint handle = tracker.find_next_handle(0); handle != cUINT32_MAX; handle = tracker.find_next_handle(handle + 1))
                 {
-                    const vogl_handle_tracker::handle_def &def = capture_params.m_textures[i];
-                    if (def.is_valid())
-                        handles_to_capture.push_back(std::make_pair(def.get_inv_handle(), def.get_target()));
+                    const vogl_handle_tracker::handle_def def(tracker[handle]);
+                    handles_to_capture.push_back(std::make_pair(def.get_inv_handle(), def.get_target()));
                 }
                 break;
             }
             case cGLSTRenderbuffer:
             {
-                for (uint i = 0; i < capture_params.m_rbos.size(); i++)
+                const vogl_handle_tracker &tracker = capture_params.m_rbos;
+                for (uint handle = tracker.find_next_handle(0); handle != cUINT32_MAX; handle = tracker.find_next_handle(handle + 1))
                 {
-                    const vogl_handle_tracker::handle_def &def = capture_params.m_rbos[i];
-                    if (def.is_valid())
-                        handles_to_capture.push_back(std::make_pair(def.get_inv_handle(), def.get_target()));
+                    const vogl_handle_tracker::handle_def def(tracker[handle]);
+                    handles_to_capture.push_back(std::make_pair(def.get_inv_handle(), def.get_target()));
                 }
 
                 break;
@@ -291,10 +515,11 @@ bool vogl_context_snapshot::capture_objects(vogl_gl_object_state_type state_type
             }
             case cGLSTShader:
             {
-                for (uint i = 0; i < capture_params.m_objs.size(); i++)
+                const vogl_handle_tracker &tracker = capture_params.m_objs;
+                for (uint handle = tracker.find_next_handle(0); handle != cUINT32_MAX; handle = tracker.find_next_handle(handle + 1))
                 {
-                    const vogl_handle_tracker::handle_def &def = capture_params.m_objs[i];
-                    if ((def.is_valid()) && (def.get_target() == VOGL_SHADER_OBJECT))
+                    const vogl_handle_tracker::handle_def def(tracker[handle]);
+                    if (def.get_target() == VOGL_SHADER_OBJECT)
                         handles_to_capture.push_back(std::make_pair(def.get_inv_handle(), def.get_target()));
                 }
 
@@ -302,20 +527,21 @@ bool vogl_context_snapshot::capture_objects(vogl_gl_object_state_type state_type
             }
             case cGLSTProgram:
             {
-                for (uint i = 0; i < capture_params.m_objs.size(); i++)
+                const vogl_handle_tracker &tracker = capture_params.m_objs;
+                for (uint handle = tracker.find_next_handle(0); handle != cUINT32_MAX; handle = tracker.find_next_handle(handle + 1))
                 {
-                    const vogl_handle_tracker::handle_def &def = capture_params.m_objs[i];
-                    if ((def.is_valid()) && (def.get_target() == VOGL_PROGRAM_OBJECT))
+                    const vogl_handle_tracker::handle_def def(tracker[handle]);
+                    if (def.get_target() == VOGL_PROGRAM_OBJECT)
                     {
-                        GLuint handle = def.get_inv_handle();
+                        GLuint program = def.get_inv_handle();
 
                         if (capture_params.m_filter_program_handles)
                         {
-                            if (!capture_params.m_program_handles_filter.contains(handle))
+                            if (!capture_params.m_program_handles_filter.contains(program))
                                 continue;
                         }
 
-                        handles_to_capture.push_back(std::make_pair(handle, def.get_target()));
+                        handles_to_capture.push_back(std::make_pair(program, def.get_target()));
                     }
                 }
 
@@ -344,6 +570,10 @@ bool vogl_context_snapshot::capture_objects(vogl_gl_object_state_type state_type
 
         m_object_ptrs.reserve(m_object_ptrs.size() + handles_to_capture.size());
 
+        // Renderbuffers are all blitted and queued for readback first, and only then read back (see end_snapshot() below).
+        const uint first_object_index = m_object_ptrs.size();
+        vogl_texture_readback_queue readbacks;
+
         for (uint i = 0; i < handles_to_capture.size(); ++i)
         {
             GLuint handle = handles_to_capture[i].first;
@@ -352,7 +582,21 @@ bool vogl_context_snapshot::capture_objects(vogl_gl_object_state_type state_type
             vogl_gl_object_state *p = vogl_gl_object_state_factory(state_type);
             VOGL_VERIFY(p);
 
-            bool success = p->snapshot(m_context_info, remapper, handle, target);
+            bool success;
+            if (state_type == cGLSTProgram)
+                success = static_cast<vogl_program_state *>(p)->snapshot(m_context_info, remapper, handle, target, capture_params.m_uniform_values.find(handle));
+            else if (state_type == cGLSTTexture)
+            {
+                bool skip_mip_tail = (budget.m_max_texture_bytes) && (type_stats.m_total_bytes >= budget.m_max_texture_bytes);
+                success = static_cast<vogl_texture_state *>(p)->snapshot(m_context_info, remapper, handle, target, skip_mip_tail);
+            }
+            else if (state_type == cGLSTBuffer)
+                success = static_cast<vogl_buffer_state *>(p)->snapshot(m_context_info, remapper, handle, target, budget.m_max_static_buffer_size);
+            else if (state_type == cGLSTRenderbuffer)
+                success = static_cast<vogl_renderbuffer_state *>(p)->begin_snapshot(m_context_info, remapper, handle, target, &readbacks);
+            else
+                success = p->snapshot(m_context_info, remapper, handle, target);
+
             if (!success)
             {
                 vogl_delete(p);
@@ -393,13 +637,42 @@ bool vogl_context_snapshot::capture_objects(vogl_gl_object_state_type state_type
                 }
             }
 
+            if (state_type == cGLSTTexture)
+            {
+                const vogl_texture_state *pTex = static_cast<const vogl_texture_state *>(p);
+                type_stats.m_total_bytes += pTex->get_texture_data_size();
+                type_stats.m_total_reduced += pTex->get_mip_tail_skipped();
+            }
+            else if (state_type == cGLSTBuffer)
+            {
+                const vogl_buffer_state *pBuf = static_cast<const vogl_buffer_state *>(p);
+                type_stats.m_total_bytes += pBuf->get_buffer_data().size();
+                type_stats.m_total_reduced += pBuf->get_data_skipped();
+            }
+
             m_object_ptrs.push_back(p);
             total++;
         }
+
+        if (state_type == cGLSTRenderbuffer)
+        {
+            for (uint i = first_object_index; i < m_object_ptrs.size(); i++)
+            {
+                vogl_renderbuffer_state *pRBO = static_cast<vogl_renderbuffer_state *>(m_object_ptrs[i]);
+
+                if (!pRBO->end_snapshot(m_context_info, &readbacks))
+                    return false;
+
+                type_stats.m_total_bytes += pRBO->get_texture().get_texture_data_size();
+            }
+        }
     }
 
     VOGL_CHECK_GL_ERROR;
 
+    type_stats.m_total_objects += total;
+    type_stats.m_snapshot_time += timer::ticks_to_secs(timer::get_ticks() - start_ticks);
+
     vogl_printf("Found %u %ss\n", total, get_gl_object_state_type_str(state_type));
 
     return true;
@@ -423,7 +696,7 @@ void vogl_context_snapshot::get_all_objects_of_category(vogl_gl_object_state_typ
     obj_ptr_vec.sort(vogl_object_ptr_sorter);
 }
 
-bool vogl_context_snapshot::serialize(json_node &node, vogl_blob_manager &blob_manager, const vogl_ctypes *pCtypes) const
+bool vogl_context_snapshot::serialize(json_node &node, vogl_blob_manager &blob_manager, const vogl_ctypes *pCtypes, vogl_snapshot_stats *pStats) const
 {
     VOGL_FUNC_TRACER
 
@@ -469,6 +742,12 @@ bool vogl_context_snapshot::serialize(json_node &node, vogl_blob_manager &blob_m
 
         vogl_gl_object_state_ptr_vec obj_ptrs;
 
+        vogl_gl_object_state_ptr_vec all_obj_ptrs;
+        all_obj_ptrs.reserve(m_object_ptrs.size());
+
+        vogl::vector<json_node *> obj_nodes;
+        obj_nodes.reserve(m_object_ptrs.size());
+
         for (vogl_gl_object_state_type state_type = static_cast<vogl_gl_object_state_type>(0); state_type < cGLSTTotalTypes; state_type = static_cast<vogl_gl_object_state_type>(state_type + 1))
         {
             get_all_objects_of_category(state_type, obj_ptrs);
@@ -479,11 +758,27 @@ bool vogl_context_snapshot::serialize(json_node &node, vogl_blob_manager &blob_m
 
             for (uint i = 0; i < obj_ptrs.size(); i++)
             {
-                json_node &new_obj = array_node.add_object();
-                if (!obj_ptrs[i]->serialize(new_obj, blob_manager))
-                    return false;
+                all_obj_ptrs.push_back(obj_ptrs[i]);
+                obj_nodes.push_back(&array_node.add_object());
             }
         }
+
+        vogl::vector<timer_ticks> obj_ticks(all_obj_ptrs.size());
+
+        vogl_object_serialize_context ctx;
+        ctx.m_pObjs = &all_obj_ptrs;
+        ctx.m_pNodes = &obj_nodes;
+        ctx.m_pBlob_manager = &blob_manager;
+        ctx.m_pTicks = &obj_ticks;
+
+        if (!vogl_process_objects(all_obj_ptrs.size(), vogl_serialize_object_task, &ctx))
+            return false;
+
+        if (pStats)
+        {
+            for (uint i = 0; i < all_obj_ptrs.size(); i++)
+                pStats->get(all_obj_ptrs[i]->get_type()).m_serialize_time += timer::ticks_to_secs(obj_ticks[i]);
+        }
     }
 
     return true;
@@ -559,6 +854,8 @@ bool vogl_context_snapshot::deserialize(const json_node &node, const vogl_blob_m
     const json_node *pObjects_node = node.find_child_object("state_objects");
     if (pObjects_node)
     {
+        vogl::vector<const json_node *> obj_nodes;
+
         for (uint obj_iter = 0; obj_iter < pObjects_node->size(); obj_iter++)
         {
             const dynamic_string &obj_type_str = pObjects_node->get_key(obj_iter);
@@ -595,17 +892,21 @@ bool vogl_context_snapshot::deserialize(const json_node &node, const vogl_blob_m
                     return false;
                 }
 
-                if (!pState_obj->deserialize(*pObj_node, blob_manager))
-                {
-                    vogl_delete(pState_obj);
-
-                    clear();
-                    return false;
-                }
-
                 m_object_ptrs.push_back(pState_obj);
+                obj_nodes.push_back(pObj_node);
             }
         }
+
+        vogl_object_deserialize_context ctx;
+        ctx.m_pObjs = &m_object_ptrs;
+        ctx.m_pNodes = &obj_nodes;
+        ctx.m_pBlob_manager = &blob_manager;
+
+        if (!vogl_process_objects(m_object_ptrs.size(), vogl_deserialize_object_task, &ctx))
+        {
+            clear();
+            return false;
+        }
     }
 
     m_is_valid = true;
@@ -657,6 +958,8 @@ void vogl_gl_state_snapshot::clear()
 
     m_default_framebuffer.clear();
 
+    m_stats.clear();
+
     m_captured_default_framebuffer = false;
     m_is_valid = false;
 }
@@ -695,7 +998,7 @@ void vogl_gl_state_snapshot::add_client_side_array_ptrs(const vogl_client_side_a
 // TODO: check if the context was ever made current yet (if not the context_info won't be valid), make sure this path works
 bool vogl_gl_state_snapshot::capture_context(
     const vogl_context_desc &desc, const vogl_context_info &info, vogl_handle_remapper &remapper,
-    const vogl_capture_context_params &capture_params)
+    const vogl_capture_context_params &capture_params, const vogl_capture_context_params *pShared_capture_params)
 {
     VOGL_FUNC_TRACER
 
@@ -724,7 +1027,7 @@ bool vogl_gl_state_snapshot::capture_context(
 
     vogl_context_snapshot *pSnapshot = vogl_new(vogl_context_snapshot);
 
-    if (!pSnapshot->capture(desc, info, capture_params, remapper))
+    if (!pSnapshot->capture(desc, info, capture_params, remapper, m_budget, m_stats, pShared_capture_params))
     {
         m_is_valid = false;
 
@@ -748,7 +1051,7 @@ bool vogl_gl_state_snapshot::end_capture()
     return m_is_valid;
 }
 
-bool vogl_gl_state_snapshot::serialize(json_node &node, vogl_blob_manager &blob_manager, const vogl_ctypes *pCtypes) const
+bool vogl_gl_state_snapshot::serialize(json_node &node, vogl_blob_manager &blob_manager, const vogl_ctypes *pCtypes, vogl_snapshot_stats *pStats) const
 {
     VOGL_FUNC_TRACER
 
@@ -771,8 +1074,16 @@ bool vogl_gl_state_snapshot::serialize(json_node &node, vogl_blob_manager &blob_
     if (!vogl_json_serialize_vec(node, blob_manager, "client_side_texcoord_ptrs", m_client_side_texcoord_ptrs))
         return false;
 
-    if (!vogl_json_serialize_ptr_vec(node, blob_manager, "context_snapshots", m_context_ptrs, pCtypes))
-        return false;
+    // Snapshots can be serialized more than once, so don't accumulate serialization costs into m_stats.
+    vogl_snapshot_stats stats(m_stats);
+
+    json_node &contexts_node = node.add_array("context_snapshots");
+    for (uint i = 0; i < m_context_ptrs.size(); i++)
+    {
+        json_node &context_node = contexts_node.add_object();
+        if ((m_context_ptrs[i]) && (!m_context_ptrs[i]->serialize(context_node, blob_manager, pCtypes, &stats)))
+            return false;
+    }
 
     if (m_default_framebuffer.is_valid())
     {
@@ -780,6 +1091,12 @@ bool vogl_gl_state_snapshot::serialize(json_node &node, vogl_blob_manager &blob_
             return false;
     }
 
+    if (!stats.serialize(node.add_object("capture_stats")))
+        return false;
+
+    if (pStats)
+        *pStats = stats;
+
     return true;
 }
 
@@ -826,6 +1143,9 @@ bool vogl_gl_state_snapshot::deserialize(const json_node &node, const vogl_blob_
             return false;
     }
 
+    if (node.has_object("capture_stats"))
+        m_stats.deserialize(*node.find_child_object("capture_stats"));
+
     m_is_valid = true;
 
     return true;
@@ -47,6 +47,7 @@
 #include "vogl_material_state.h"
 #include "vogl_display_list_state.h"
 #include "vogl_matrix_state.h"
+#include "vogl_fixed_function_shadow.h"
 #include "vogl_current_vertex_attrib_state.h"
 #include "vogl_arb_program_state.h"
 #include "vogl_handle_tracker.h"
@@ -140,9 +141,13 @@ public:
         m_objs.clear();
 
         m_linked_programs.clear();
+        m_uniform_values.clear();
 
         m_program_handles_filter.clear();
         m_filter_program_handles = false;
+
+        // The context's GL state outlives the shadow, so nothing it holds can be trusted anymore.
+        m_fixed_function_shadow.invalidate();
     }
 
     // During tracing: All handles live in the tracing GL namespace (there is no replay namespace).
@@ -160,8 +165,12 @@ public:
 
     // During replay: replay domain
     vogl_linked_program_state m_linked_programs;
+    vogl_uniform_value_shadow m_uniform_values;
     vogl_mapped_buffer_desc_vec m_mapped_buffers;
 
+    // Per-context, never shared. Mutable because snapshotting reseeds it with the state it had to read back from GL.
+    mutable vogl_fixed_function_shadow m_fixed_function_shadow;
+
     // During replay: These objects map from trace (non-inv) to replay (inv).
     // TODO: Transition ALL the above hash sets/maps to instances of vogl_handle_tracker.
     vogl_handle_tracker m_rbos;
@@ -172,6 +181,89 @@ public:
     bool m_filter_program_handles;
 };
 
+//----------------------------------------------------------------------------------------------------------------------
+// struct vogl_snapshot_budget
+// Optional limits on how much object data a snapshot captures. Data left out because of a limit is either regenerated on
+// restore (mip tails) or restored undefined (static buffer contents), so only use these when capture hitches matter more
+// than exact replay.
+//----------------------------------------------------------------------------------------------------------------------
+struct vogl_snapshot_budget
+{
+    vogl_snapshot_budget()
+    {
+        clear();
+    }
+
+    void clear()
+    {
+        m_max_texture_bytes = 0;
+        m_max_static_buffer_size = 0;
+    }
+
+    // Once this many bytes of texel data have been captured, only the levels up to the base level of the remaining mipmapped textures are captured. 0=unlimited.
+    uint64_t m_max_texture_bytes;
+
+    // The contents of GL_STATIC_* buffers larger than this aren't captured. 0=unlimited.
+    uint64_t m_max_static_buffer_size;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+// class vogl_snapshot_stats
+// Where a snapshot's time and bytes went, per object type.
+//----------------------------------------------------------------------------------------------------------------------
+class vogl_snapshot_stats
+{
+public:
+    struct object_type_stats
+    {
+        uint m_total_objects;
+
+        // Objects that had data left out to stay within the snapshot's budget.
+        uint m_total_reduced;
+
+        // Captured object data (texels, buffer contents), not including parameters.
+        uint64_t m_total_bytes;
+
+        // Seconds spent reading back state from GL.
+        double m_snapshot_time;
+
+        // Seconds spent serializing, summed across all threads.
+        double m_serialize_time;
+    };
+
+    vogl_snapshot_stats()
+    {
+        clear();
+    }
+
+    void clear();
+
+    object_type_stats &get(vogl_gl_object_state_type type)
+    {
+        VOGL_ASSERT(type < cGLSTTotalTypes);
+        return m_object_types[type];
+    }
+    const object_type_stats &get(vogl_gl_object_state_type type) const
+    {
+        VOGL_ASSERT(type < cGLSTTotalTypes);
+        return m_object_types[type];
+    }
+
+    // Sum over all object types.
+    object_type_stats get_total() const;
+
+    // Seconds spent reading back non-object context state (general state, fixed function state, etc.)
+    double m_context_state_time;
+
+    void print() const;
+
+    bool serialize(json_node &node) const;
+    bool deserialize(const json_node &node);
+
+private:
+    object_type_stats m_object_types[cGLSTTotalTypes];
+};
+
 //----------------------------------------------------------------------------------------------------------------------
 // class vogl_state_snapshot
 //----------------------------------------------------------------------------------------------------------------------
@@ -185,7 +277,12 @@ public:
 
     void clear();
 
-    bool capture(const vogl_context_desc &desc, const vogl_context_info &info, const vogl_capture_context_params &capture_params, vogl_handle_remapper &remapper);
+    // pShared_capture_params may be NULL. If not, the objects shared across the context's sharelist group (everything except framebuffers and VAOs) are
+    // captured from it instead of capture_params. This lets a share context that has been made current capture the group's objects on behalf of a root
+    // context that never was.
+    // Object data is limited by budget, and the costs are accumulated into stats.
+    bool capture(const vogl_context_desc &desc, const vogl_context_info &info, const vogl_capture_context_params &capture_params, vogl_handle_remapper &remapper,
+                 const vogl_snapshot_budget &budget, vogl_snapshot_stats &stats, const vogl_capture_context_params *pShared_capture_params = NULL);
 
     bool is_valid() const
     {
@@ -295,7 +392,8 @@ public:
 
     void get_all_objects_of_category(vogl_gl_object_state_type state_type, vogl_gl_object_state_ptr_vec &obj_ptr_vec) const;
 
-    bool serialize(json_node &node, vogl_blob_manager &blob_manager, const vogl_ctypes *pCtypes) const;
+    // If pStats is not NULL, the time spent serializing each object type is accumulated into it.
+    bool serialize(json_node &node, vogl_blob_manager &blob_manager, const vogl_ctypes *pCtypes, vogl_snapshot_stats *pStats = NULL) const;
     bool deserialize(const json_node &node, const vogl_blob_manager &blob_manager, const vogl_ctypes *pCtypes);
 
 private:
@@ -314,7 +412,7 @@ private:
 
     vogl_gl_object_state_ptr_vec m_object_ptrs;
 
-    bool capture_objects(vogl_gl_object_state_type state_type, const vogl_capture_context_params &capture_params, vogl_handle_remapper &remapper);
+    bool capture_objects(vogl_gl_object_state_type state_type, const vogl_capture_context_params &capture_params, vogl_handle_remapper &remapper, const vogl_snapshot_budget &budget, vogl_snapshot_stats &stats);
 
     bool m_is_valid;
 
@@ -390,7 +488,7 @@ public:
 
     bool capture_context(
         const vogl_context_desc &desc, const vogl_context_info &info, vogl_handle_remapper &remapper,
-        const vogl_capture_context_params &capture_params);
+        const vogl_capture_context_params &capture_params, const vogl_capture_context_params *pShared_capture_params = NULL);
 
     bool end_capture();
 
@@ -399,7 +497,24 @@ public:
         return m_is_valid;
     }
 
-    bool serialize(json_node &node, vogl_blob_manager &blob_manager, const vogl_ctypes *pCtypes) const;
+    // The budget isn't reset by clear() or begin_capture(), it applies to all following captures.
+    const vogl_snapshot_budget &get_budget() const
+    {
+        return m_budget;
+    }
+    void set_budget(const vogl_snapshot_budget &budget)
+    {
+        m_budget = budget;
+    }
+
+    // Capture costs. Serialization costs are only known after serialize(), which writes the final stats to the "capture_stats" node
+    // and to pStats if it's not NULL. deserialize() reads them back.
+    const vogl_snapshot_stats &get_stats() const
+    {
+        return m_stats;
+    }
+
+    bool serialize(json_node &node, vogl_blob_manager &blob_manager, const vogl_ctypes *pCtypes, vogl_snapshot_stats *pStats = NULL) const;
     bool deserialize(const json_node &node, const vogl_blob_manager &blob_manager, const vogl_ctypes *pCtypes);
 
     md5_hash get_uuid() const
@@ -506,6 +621,9 @@ private:
 
     vogl_default_framebuffer_state m_default_framebuffer;
 
+    vogl_snapshot_budget m_budget;
+    vogl_snapshot_stats m_stats;
+
     bool m_captured_default_framebuffer;
     bool m_is_valid;
 
@@ -2195,6 +2195,615 @@ int vogl_gl_get_uniform_base_type(GLenum type)
     }
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+// vogl_get_default_tex_parameter
+// Returns the number of values written to pVals (at most 4), or 0 if the default isn't known. Pass GL_NONE as the target
+// for sampler objects.
+//----------------------------------------------------------------------------------------------------------------------
+uint vogl_get_default_tex_parameter(GLenum target, GLenum pname, float *pVals)
+{
+    VOGL_FUNC_TRACER
+
+    const bool is_rect = (target == GL_TEXTURE_RECTANGLE);
+
+    switch (pname)
+    {
+        case GL_TEXTURE_MIN_FILTER:
+            pVals[0] = static_cast<float>(is_rect ? GL_LINEAR : GL_NEAREST_MIPMAP_LINEAR);
+            return 1;
+        case GL_TEXTURE_MAG_FILTER:
+            pVals[0] = static_cast<float>(GL_LINEAR);
+            return 1;
+        case GL_TEXTURE_WRAP_S:
+        case GL_TEXTURE_WRAP_T:
+        case GL_TEXTURE_WRAP_R:
+            pVals[0] = static_cast<float>(is_rect ? GL_CLAMP_TO_EDGE : GL_REPEAT);
+            return 1;
+        case GL_TEXTURE_MIN_LOD:
+            pVals[0] = -1000.0f;
+            return 1;
+        case GL_TEXTURE_MAX_LOD:
+        case GL_TEXTURE_MAX_LEVEL:
+            pVals[0] = 1000.0f;
+            return 1;
+        case GL_TEXTURE_BASE_LEVEL:
+        case GL_TEXTURE_LOD_BIAS:
+        case GL_TEXTURE_COMPARE_FAIL_VALUE_ARB:
+            pVals[0] = 0.0f;
+            return 1;
+        case GL_TEXTURE_BORDER_COLOR:
+            pVals[0] = pVals[1] = pVals[2] = pVals[3] = 0.0f;
+            return 4;
+        case GL_TEXTURE_COMPARE_MODE:
+            pVals[0] = static_cast<float>(GL_NONE);
+            return 1;
+        case GL_TEXTURE_COMPARE_FUNC:
+            pVals[0] = static_cast<float>(GL_LEQUAL);
+            return 1;
+        case GL_TEXTURE_SWIZZLE_RGBA:
+            pVals[0] = static_cast<float>(GL_RED);
+            pVals[1] = static_cast<float>(GL_GREEN);
+            pVals[2] = static_cast<float>(GL_BLUE);
+            pVals[3] = static_cast<float>(GL_ALPHA);
+            return 4;
+        case GL_TEXTURE_MAX_ANISOTROPY_EXT:
+            pVals[0] = 1.0f;
+            return 1;
+        case GL_TEXTURE_SRGB_DECODE_EXT:
+            pVals[0] = static_cast<float>(GL_DECODE_EXT);
+            return 1;
+        case GL_DEPTH_TEXTURE_MODE:
+            pVals[0] = static_cast<float>(GL_LUMINANCE);
+            return 1;
+        default:
+            break;
+    }
+
+    return 0;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// vogl_get_default_light_parameter
+// See the glLight() man page. GL_LIGHT0 defaults to a white diffuse/specular color, the others to black.
+//----------------------------------------------------------------------------------------------------------------------
+uint vogl_get_default_light_parameter(uint light, GLenum pname, float *pVals)
+{
+    VOGL_FUNC_TRACER
+
+    const float light_color = light ? 0.0f : 1.0f;
+
+    switch (pname)
+    {
+        case GL_CONSTANT_ATTENUATION:
+            pVals[0] = 1.0f;
+            return 1;
+        case GL_LINEAR_ATTENUATION:
+        case GL_QUADRATIC_ATTENUATION:
+        case GL_SPOT_EXPONENT:
+            pVals[0] = 0.0f;
+            return 1;
+        case GL_SPOT_CUTOFF:
+            pVals[0] = 180.0f;
+            return 1;
+        case GL_AMBIENT:
+            pVals[0] = pVals[1] = pVals[2] = 0.0f;
+            pVals[3] = 1.0f;
+            return 4;
+        case GL_DIFFUSE:
+        case GL_SPECULAR:
+            pVals[0] = pVals[1] = pVals[2] = light_color;
+            pVals[3] = 1.0f;
+            return 4;
+        case GL_POSITION:
+            pVals[0] = pVals[1] = pVals[3] = 0.0f;
+            pVals[2] = 1.0f;
+            return 4;
+        case GL_SPOT_DIRECTION:
+            pVals[0] = pVals[1] = 0.0f;
+            pVals[2] = -1.0f;
+            return 3;
+        default:
+            break;
+    }
+
+    return 0;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// vogl_get_default_material_parameter
+// See the glMaterial() man page. Both faces have the same defaults.
+//----------------------------------------------------------------------------------------------------------------------
+uint vogl_get_default_material_parameter(GLenum pname, float *pVals)
+{
+    VOGL_FUNC_TRACER
+
+    switch (pname)
+    {
+        case GL_AMBIENT:
+            pVals[0] = pVals[1] = pVals[2] = 0.2f;
+            pVals[3] = 1.0f;
+            return 4;
+        case GL_DIFFUSE:
+            pVals[0] = pVals[1] = pVals[2] = 0.8f;
+            pVals[3] = 1.0f;
+            return 4;
+        case GL_SPECULAR:
+        case GL_EMISSION:
+            pVals[0] = pVals[1] = pVals[2] = 0.0f;
+            pVals[3] = 1.0f;
+            return 4;
+        case GL_SHININESS:
+            pVals[0] = 0.0f;
+            return 1;
+        case GL_COLOR_INDEXES:
+            pVals[0] = 0.0f;
+            pVals[1] = pVals[2] = 1.0f;
+            return 3;
+        default:
+            break;
+    }
+
+    return 0;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// vogl_get_default_texenv_parameter
+// See the glTexEnv() and glTexGen() man pages. target is the glTexEnv() target or the glTexGen() coord (GL_S etc.).
+//----------------------------------------------------------------------------------------------------------------------
+uint vogl_get_default_texenv_parameter(GLenum target, GLenum pname, float *pVals)
+{
+    VOGL_FUNC_TRACER
+
+    switch (target)
+    {
+        case GL_TEXTURE_FILTER_CONTROL:
+        {
+            if (pname != GL_TEXTURE_LOD_BIAS)
+                break;
+            pVals[0] = 0.0f;
+            return 1;
+        }
+        case GL_POINT_SPRITE:
+        {
+            if (pname != GL_COORD_REPLACE)
+                break;
+            pVals[0] = GL_FALSE;
+            return 1;
+        }
+        case GL_TEXTURE_ENV:
+        {
+            switch (pname)
+            {
+                case GL_TEXTURE_ENV_MODE:
+                case GL_COMBINE_RGB:
+                case GL_COMBINE_ALPHA:
+                    pVals[0] = GL_MODULATE;
+                    return 1;
+                case GL_TEXTURE_ENV_COLOR:
+                    pVals[0] = pVals[1] = pVals[2] = pVals[3] = 0.0f;
+                    return 4;
+                case GL_RGB_SCALE:
+                case GL_ALPHA_SCALE:
+                    pVals[0] = 1.0f;
+                    return 1;
+                case GL_SRC0_RGB:
+                case GL_SRC0_ALPHA:
+                    pVals[0] = GL_TEXTURE;
+                    return 1;
+                case GL_SRC1_RGB:
+                case GL_SRC1_ALPHA:
+                    pVals[0] = GL_PREVIOUS;
+                    return 1;
+                case GL_SRC2_RGB:
+                case GL_SRC2_ALPHA:
+                    pVals[0] = GL_CONSTANT;
+                    return 1;
+                case GL_OPERAND0_RGB:
+                case GL_OPERAND1_RGB:
+                    pVals[0] = GL_SRC_COLOR;
+                    return 1;
+                case GL_OPERAND2_RGB:
+                case GL_OPERAND0_ALPHA:
+                case GL_OPERAND1_ALPHA:
+                case GL_OPERAND2_ALPHA:
+                    pVals[0] = GL_SRC_ALPHA;
+                    return 1;
+                default:
+                    break;
+            }
+            break;
+        }
+        case GL_S:
+        case GL_T:
+        case GL_R:
+        case GL_Q:
+        {
+            if (pname == GL_TEXTURE_GEN_MODE)
+            {
+                pVals[0] = GL_EYE_LINEAR;
+                return 1;
+            }
+            else if ((pname == GL_OBJECT_PLANE) || (pname == GL_EYE_PLANE))
+            {
+                // S and T default to (1,0,0,0) and (0,1,0,0), R and Q to all zeros.
+                pVals[0] = pVals[1] = pVals[2] = pVals[3] = 0.0f;
+                if (target == GL_S)
+                    pVals[0] = 1.0f;
+                else if (target == GL_T)
+                    pVals[1] = 1.0f;
+                return 4;
+            }
+            break;
+        }
+        default:
+            break;
+    }
+
+    return 0;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// vogl_get_default_context_state
+// Initial values from the glGet() tables in the GL spec. Only covers states a fresh context always starts with, so
+// nothing here depends on the drawable, the implementation limits, or whether it's a debug context.
+//----------------------------------------------------------------------------------------------------------------------
+uint vogl_get_default_context_state(GLenum pname, float *pVals)
+{
+    VOGL_FUNC_TRACER
+
+    switch (pname)
+    {
+        // glEnable/glDisable and glEnableClientState/glDisableClientState
+        case GL_DITHER:
+        case GL_MULTISAMPLE:
+            pVals[0] = GL_TRUE;
+            return 1;
+        case GL_COLOR_ARRAY:
+        case GL_EDGE_FLAG_ARRAY:
+        case GL_FOG_COORD_ARRAY:
+        case GL_INDEX_ARRAY:
+        case GL_NORMAL_ARRAY:
+        case GL_SECONDARY_COLOR_ARRAY:
+        case GL_TEXTURE_COORD_ARRAY:
+        case GL_VERTEX_ARRAY:
+        case GL_ALPHA_TEST:
+        case GL_AUTO_NORMAL:
+        case GL_BLEND:
+        case GL_CLIP_DISTANCE0:
+        case GL_CLIP_DISTANCE1:
+        case GL_CLIP_DISTANCE2:
+        case GL_CLIP_DISTANCE3:
+        case GL_CLIP_DISTANCE4:
+        case GL_CLIP_DISTANCE5:
+        case GL_CLIP_DISTANCE6:
+        case GL_CLIP_DISTANCE7:
+        case GL_COLOR_LOGIC_OP:
+        case GL_COLOR_MATERIAL:
+        case GL_COLOR_SUM:
+        case GL_COLOR_TABLE:
+        case GL_CONVOLUTION_1D:
+        case GL_CONVOLUTION_2D:
+        case GL_CULL_FACE:
+        case GL_DEPTH_CLAMP:
+        case GL_DEPTH_TEST:
+        case GL_FOG:
+        case GL_FRAMEBUFFER_SRGB:
+        case GL_HISTOGRAM:
+        case GL_INDEX_LOGIC_OP:
+        case GL_LIGHT0:
+        case GL_LIGHT1:
+        case GL_LIGHT2:
+        case GL_LIGHT3:
+        case GL_LIGHT4:
+        case GL_LIGHT5:
+        case GL_LIGHT6:
+        case GL_LIGHT7:
+        case GL_LIGHTING:
+        case GL_LINE_SMOOTH:
+        case GL_LINE_STIPPLE:
+        case GL_MAP1_COLOR_4:
+        case GL_MAP1_INDEX:
+        case GL_MAP1_NORMAL:
+        case GL_MAP1_TEXTURE_COORD_1:
+        case GL_MAP1_TEXTURE_COORD_2:
+        case GL_MAP1_TEXTURE_COORD_3:
+        case GL_MAP1_TEXTURE_COORD_4:
+        case GL_MAP1_VERTEX_3:
+        case GL_MAP1_VERTEX_4:
+        case GL_MAP2_COLOR_4:
+        case GL_MAP2_INDEX:
+        case GL_MAP2_NORMAL:
+        case GL_MAP2_TEXTURE_COORD_1:
+        case GL_MAP2_TEXTURE_COORD_2:
+        case GL_MAP2_TEXTURE_COORD_3:
+        case GL_MAP2_TEXTURE_COORD_4:
+        case GL_MAP2_VERTEX_3:
+        case GL_MAP2_VERTEX_4:
+        case GL_MINMAX:
+        case GL_NORMALIZE:
+        case GL_POINT_SMOOTH:
+        case GL_POINT_SPRITE:
+        case GL_POLYGON_OFFSET_FILL:
+        case GL_POLYGON_OFFSET_LINE:
+        case GL_POLYGON_OFFSET_POINT:
+        case GL_POLYGON_SMOOTH:
+        case GL_POLYGON_STIPPLE:
+        case GL_POST_COLOR_MATRIX_COLOR_TABLE:
+        case GL_POST_CONVOLUTION_COLOR_TABLE:
+        case GL_PRIMITIVE_RESTART:
+        case GL_PRIMITIVE_RESTART_FIXED_INDEX:
+        case GL_PROGRAM_POINT_SIZE:
+        case GL_RASTERIZER_DISCARD:
+        case GL_RESCALE_NORMAL:
+        case GL_SAMPLE_ALPHA_TO_COVERAGE:
+        case GL_SAMPLE_ALPHA_TO_ONE:
+        case GL_SAMPLE_COVERAGE:
+        case GL_SAMPLE_MASK:
+        case GL_SAMPLE_SHADING:
+        case GL_SCISSOR_TEST:
+        case GL_SEPARABLE_2D:
+        case GL_STENCIL_TEST:
+        case GL_TEXTURE_1D:
+        case GL_TEXTURE_2D:
+        case GL_TEXTURE_3D:
+        case GL_TEXTURE_CUBE_MAP:
+        case GL_TEXTURE_CUBE_MAP_SEAMLESS:
+        case GL_TEXTURE_GEN_Q:
+        case GL_TEXTURE_GEN_R:
+        case GL_TEXTURE_GEN_S:
+        case GL_TEXTURE_GEN_T:
+        case GL_VERTEX_PROGRAM_TWO_SIDE:
+        case GL_VERTEX_PROGRAM_ARB:
+        case GL_FRAGMENT_PROGRAM_ARB:
+        // Other booleans
+        case GL_LIGHT_MODEL_LOCAL_VIEWER:
+        case GL_LIGHT_MODEL_TWO_SIDE:
+        case GL_MAP_COLOR:
+        case GL_MAP_STENCIL:
+        case GL_PACK_LSB_FIRST:
+        case GL_PACK_SWAP_BYTES:
+        case GL_UNPACK_LSB_FIRST:
+        case GL_UNPACK_SWAP_BYTES:
+        case GL_SAMPLE_COVERAGE_INVERT:
+            pVals[0] = GL_FALSE;
+            return 1;
+        case GL_EDGE_FLAG:
+        case GL_DEPTH_WRITEMASK:
+            pVals[0] = GL_TRUE;
+            return 1;
+        case GL_COLOR_WRITEMASK:
+            pVals[0] = pVals[1] = pVals[2] = pVals[3] = GL_TRUE;
+            return 4;
+
+        // Rasterization and per-fragment state
+        case GL_CULL_FACE_MODE:
+            pVals[0] = GL_BACK;
+            return 1;
+        case GL_FRONT_FACE:
+            pVals[0] = GL_CCW;
+            return 1;
+        case GL_DEPTH_FUNC:
+            pVals[0] = GL_LESS;
+            return 1;
+        case GL_DEPTH_RANGE:
+            pVals[0] = 0.0f;
+            pVals[1] = 1.0f;
+            return 2;
+        case GL_LOGIC_OP_MODE:
+            pVals[0] = GL_COPY;
+            return 1;
+        case GL_SHADE_MODEL:
+            pVals[0] = GL_SMOOTH;
+            return 1;
+        case GL_PROVOKING_VERTEX:
+            pVals[0] = GL_LAST_VERTEX_CONVENTION;
+            return 1;
+        case GL_POLYGON_MODE:
+            pVals[0] = pVals[1] = GL_FILL;
+            return 2;
+        case GL_BLEND_SRC_RGB:
+        case GL_BLEND_SRC_ALPHA:
+            pVals[0] = GL_ONE;
+            return 1;
+        case GL_BLEND_DST_RGB:
+        case GL_BLEND_DST_ALPHA:
+            pVals[0] = GL_ZERO;
+            return 1;
+        case GL_BLEND_EQUATION_RGB:
+        case GL_BLEND_EQUATION_ALPHA:
+            pVals[0] = GL_FUNC_ADD;
+            return 1;
+        case GL_STENCIL_FAIL:
+        case GL_STENCIL_PASS_DEPTH_PASS:
+        case GL_STENCIL_PASS_DEPTH_FAIL:
+        case GL_STENCIL_BACK_FAIL:
+        case GL_STENCIL_BACK_PASS_DEPTH_PASS:
+        case GL_STENCIL_BACK_PASS_DEPTH_FAIL:
+            pVals[0] = GL_KEEP;
+            return 1;
+        case GL_ALPHA_TEST_FUNC:
+            pVals[0] = GL_ALWAYS;
+            return 1;
+        case GL_COLOR_MATERIAL_FACE:
+            pVals[0] = GL_FRONT_AND_BACK;
+            return 1;
+        case GL_COLOR_MATERIAL_PARAMETER:
+            pVals[0] = GL_AMBIENT_AND_DIFFUSE;
+            return 1;
+        case GL_LIGHT_MODEL_COLOR_CONTROL:
+            pVals[0] = GL_SINGLE_COLOR;
+            return 1;
+        case GL_LIGHT_MODEL_AMBIENT:
+            pVals[0] = pVals[1] = pVals[2] = 0.2f;
+            pVals[3] = 1.0f;
+            return 4;
+        case GL_LINE_STIPPLE_PATTERN:
+            pVals[0] = 0xFFFF;
+            return 1;
+        case GL_LINE_WIDTH:
+        case GL_POINT_SIZE:
+        case GL_POINT_FADE_THRESHOLD_SIZE:
+        case GL_LINE_STIPPLE_REPEAT:
+        case GL_SAMPLE_COVERAGE_VALUE:
+        case GL_DEPTH_CLEAR_VALUE:
+        case GL_ZOOM_X:
+        case GL_ZOOM_Y:
+            pVals[0] = 1.0f;
+            return 1;
+        case GL_POINT_DISTANCE_ATTENUATION:
+            pVals[0] = 1.0f;
+            pVals[1] = pVals[2] = 0.0f;
+            return 3;
+        case GL_POINT_SPRITE_COORD_ORIGIN:
+            pVals[0] = GL_UPPER_LEFT;
+            return 1;
+        case GL_POINT_SIZE_MIN:
+        case GL_MIN_SAMPLE_SHADING_VALUE:
+        case GL_POLYGON_OFFSET_FACTOR:
+        case GL_POLYGON_OFFSET_UNITS:
+        case GL_ALPHA_TEST_REF:
+        case GL_PRIMITIVE_RESTART_INDEX:
+        case GL_STENCIL_CLEAR_VALUE:
+        case GL_INDEX_CLEAR_VALUE:
+        case GL_LIST_BASE:
+            pVals[0] = 0.0f;
+            return 1;
+        case GL_COLOR_CLEAR_VALUE:
+        case GL_ACCUM_CLEAR_VALUE:
+        case GL_BLEND_COLOR:
+            pVals[0] = pVals[1] = pVals[2] = pVals[3] = 0.0f;
+            return 4;
+
+        // Fog
+        case GL_FOG_MODE:
+            pVals[0] = GL_EXP;
+            return 1;
+        case GL_FOG_DENSITY:
+        case GL_FOG_END:
+            pVals[0] = 1.0f;
+            return 1;
+        case GL_FOG_START:
+        case GL_FOG_INDEX:
+            pVals[0] = 0.0f;
+            return 1;
+        case GL_FOG_COLOR:
+            pVals[0] = pVals[1] = pVals[2] = pVals[3] = 0.0f;
+            return 4;
+        case GL_FOG_COORD_SRC:
+            pVals[0] = GL_FRAGMENT_DEPTH;
+            return 1;
+
+        // Hints
+        case GL_GENERATE_MIPMAP_HINT:
+        case GL_FOG_HINT:
+        case GL_FRAGMENT_SHADER_DERIVATIVE_HINT:
+        case GL_LINE_SMOOTH_HINT:
+        case GL_POLYGON_SMOOTH_HINT:
+        case GL_TEXTURE_COMPRESSION_HINT:
+        case GL_PERSPECTIVE_CORRECTION_HINT:
+        case GL_POINT_SMOOTH_HINT:
+            pVals[0] = GL_DONT_CARE;
+            return 1;
+
+        // Pixel transfer and pixel store
+        case GL_RED_SCALE:
+        case GL_GREEN_SCALE:
+        case GL_BLUE_SCALE:
+        case GL_ALPHA_SCALE:
+        case GL_DEPTH_SCALE:
+        case GL_POST_COLOR_MATRIX_RED_SCALE:
+        case GL_POST_COLOR_MATRIX_GREEN_SCALE:
+        case GL_POST_COLOR_MATRIX_BLUE_SCALE:
+        case GL_POST_COLOR_MATRIX_ALPHA_SCALE:
+        case GL_POST_CONVOLUTION_RED_SCALE:
+        case GL_POST_CONVOLUTION_GREEN_SCALE:
+        case GL_POST_CONVOLUTION_BLUE_SCALE:
+        case GL_POST_CONVOLUTION_ALPHA_SCALE:
+            pVals[0] = 1.0f;
+            return 1;
+        case GL_INDEX_SHIFT:
+        case GL_INDEX_OFFSET:
+        case GL_RED_BIAS:
+        case GL_GREEN_BIAS:
+        case GL_BLUE_BIAS:
+        case GL_ALPHA_BIAS:
+        case GL_DEPTH_BIAS:
+        case GL_POST_COLOR_MATRIX_RED_BIAS:
+        case GL_POST_COLOR_MATRIX_GREEN_BIAS:
+        case GL_POST_COLOR_MATRIX_BLUE_BIAS:
+        case GL_POST_COLOR_MATRIX_ALPHA_BIAS:
+        case GL_POST_CONVOLUTION_RED_BIAS:
+        case GL_POST_CONVOLUTION_GREEN_BIAS:
+        case GL_POST_CONVOLUTION_BLUE_BIAS:
+        case GL_POST_CONVOLUTION_ALPHA_BIAS:
+        case GL_UNPACK_ROW_LENGTH:
+        case GL_UNPACK_SKIP_PIXELS:
+        case GL_UNPACK_SKIP_ROWS:
+        case GL_UNPACK_IMAGE_HEIGHT:
+        case GL_UNPACK_SKIP_IMAGES:
+        case GL_PACK_IMAGE_HEIGHT:
+        case GL_PACK_ROW_LENGTH:
+        case GL_PACK_SKIP_IMAGES:
+        case GL_PACK_SKIP_PIXELS:
+        case GL_PACK_SKIP_ROWS:
+            pVals[0] = 0.0f;
+            return 1;
+        case GL_UNPACK_ALIGNMENT:
+        case GL_PACK_ALIGNMENT:
+            pVals[0] = 4.0f;
+            return 1;
+
+        // Current vertex state
+        case GL_CURRENT_COLOR:
+            pVals[0] = pVals[1] = pVals[2] = pVals[3] = 1.0f;
+            return 4;
+        case GL_CURRENT_NORMAL:
+            pVals[0] = pVals[1] = 0.0f;
+            pVals[2] = 1.0f;
+            return 3;
+        case GL_CURRENT_INDEX:
+            pVals[0] = 1.0f;
+            return 1;
+        case GL_CURRENT_FOG_COORD:
+            pVals[0] = 0.0f;
+            return 1;
+        case GL_CURRENT_SECONDARY_COLOR:
+            pVals[0] = pVals[1] = pVals[2] = 0.0f;
+            pVals[3] = 1.0f;
+            return 4;
+
+        default:
+            break;
+    }
+
+    return 0;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// vogl_state_data_matches_defaults
+//----------------------------------------------------------------------------------------------------------------------
+bool vogl_state_data_matches_defaults(const vogl_state_data &data, const float *pDefaults, uint num_defaults)
+{
+    VOGL_FUNC_TRACER
+
+    enum
+    {
+        cMaxElements = 16
+    };
+
+    if ((!num_defaults) || (num_defaults > data.get_num_elements()) || (data.get_num_elements() > cMaxElements))
+        return false;
+
+    float vals[cMaxElements];
+    data.get_float(vals);
+
+    for (uint i = 0; i < num_defaults; i++)
+        if (vals[i] != pDefaults[i])
+            return false;
+
+    return true;
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 // vogl_format_debug_output_arb
 // Loosely derived from http://www.altdevblogaday.com/2011/06/23/improving-opengl-error-messages/
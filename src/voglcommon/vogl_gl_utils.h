@@ -51,6 +51,7 @@ namespace vogl
 class vogl_context_info;
 class vogl_blob_manager;
 class vogl_context_desc;
+class vogl_state_data;
 
 typedef vogl::map<GLenum, int> GLenum_to_int_map;
 
@@ -421,6 +422,16 @@ int vogl_gl_get_uniform_size_in_GLints(GLenum type);
 int vogl_gl_get_uniform_size_in_bytes(GLenum type);
 int vogl_gl_get_uniform_base_type(GLenum type);
 
+// These return the number of default values written to pVals (up to 4), or 0 if unknown. Use GL_NONE as the target for samplers.
+uint vogl_get_default_tex_parameter(GLenum target, GLenum pname, float *pVals);
+uint vogl_get_default_light_parameter(uint light, GLenum pname, float *pVals);
+uint vogl_get_default_material_parameter(GLenum pname, float *pVals);
+uint vogl_get_default_texenv_parameter(GLenum target, GLenum pname, float *pVals);
+uint vogl_get_default_context_state(GLenum pname, float *pVals);
+
+// True if the first num_defaults values of data match pDefaults. Always false if num_defaults is 0.
+bool vogl_state_data_matches_defaults(const vogl_state_data &data, const float *pDefaults, uint num_defaults);
+
 //----------------------------------------------------------------------------------------------------------------------
 // class vogl_binding_state
 //----------------------------------------------------------------------------------------------------------------------
@@ -29,12 +29,17 @@
 #include "vogl_handle_tracker.h"
 
 vogl_handle_tracker::vogl_handle_tracker()
+    : m_namespace(VOGL_NAMESPACE_UNKNOWN),
+      m_size(0),
+      m_total_valid_handles(0)
 {
     VOGL_FUNC_TRACER
 }
 
 vogl_handle_tracker::vogl_handle_tracker(vogl_namespace_t handle_namespace)
-    : m_namespace(handle_namespace)
+    : m_namespace(handle_namespace),
+      m_size(0),
+      m_total_valid_handles(0)
 {
     VOGL_FUNC_TRACER
 }
@@ -48,38 +53,130 @@ void vogl_handle_tracker::clear()
 {
     VOGL_FUNC_TRACER
 
-    m_handles.clear();
+    m_size = 0;
+    m_total_valid_handles = 0;
+
+    m_valid_handles.clear();
     m_inv_handles.clear();
+    m_targets.clear();
+
+    m_handles_by_inv.clear();
+    m_large_inv_handles.clear();
+}
+
+uint vogl_handle_tracker::find_next_handle(uint first_handle) const
+{
+    if (first_handle >= m_size)
+        return cUINT32_MAX;
+
+    return m_valid_handles.find_first_set_bit(first_handle, m_size - first_handle);
 }
 
-void vogl_handle_tracker::get_handles(uint_vec &handles)
+void vogl_handle_tracker::get_handles(uint_vec &handles) const
 {
     VOGL_FUNC_TRACER
 
     handles.resize(0);
-    handles.reserve(m_inv_handles.size());
+    handles.reserve(m_total_valid_handles);
 
-    for (uint handle = 0; handle < m_handles.size(); handle++)
-    {
-        const handle_def &def = m_handles[handle];
-        if (def.is_valid())
-            handles.push_back(handle);
-    }
+    for (uint handle = find_next_handle(0); handle != cUINT32_MAX; handle = find_next_handle(handle + 1))
+        handles.push_back(handle);
 }
 
-void vogl_handle_tracker::get_inv_handles(uint_vec &inv_handles)
+void vogl_handle_tracker::get_inv_handles(uint_vec &inv_handles) const
 {
     VOGL_FUNC_TRACER
 
     inv_handles.resize(0);
-    inv_handles.reserve(m_inv_handles.size());
+    inv_handles.reserve(m_total_valid_handles);
 
-    for (uint handle = 0; handle < m_handles.size(); handle++)
+    for (uint handle = find_next_handle(0); handle != cUINT32_MAX; handle = find_next_handle(handle + 1))
+        inv_handles.push_back(m_inv_handles[handle]);
+}
+
+void vogl_handle_tracker::ensure_handle_capacity(handle_t max_handle)
+{
+    if (max_handle < m_size)
+        return;
+
+    // Keep the bitmap's size (rounded up to whole groups) representable in a uint.
+    VOGL_VERIFY(max_handle < (cUINT32_MAX - vogl::sparse_bit_array::cBitsPerGroup));
+
+    m_size = max_handle + 1;
+
+    // Grow the bitmap geometrically, sparse_bit_array::resize() reallocates its group pointer table.
+    if (m_size > m_valid_handles.get_size())
     {
-        const handle_def &def = m_handles[handle];
-        if (def.is_valid())
-            inv_handles.push_back(def.get_inv_handle());
+        uint64_t new_bitmap_size = m_valid_handles.get_size() * 2ULL;
+        if ((new_bitmap_size < m_size) || (new_bitmap_size >= (cUINT32_MAX - vogl::sparse_bit_array::cBitsPerGroup)))
+            new_bitmap_size = m_size;
+        m_valid_handles.resize(static_cast<uint>(new_bitmap_size));
     }
+
+    m_inv_handles.resize(m_size);
+    m_targets.resize(m_size);
+}
+
+void vogl_handle_tracker::set_inv_handle_mapping(handle_t inv_handle, handle_t handle)
+{
+    if (inv_handle < cMaxDirectInvHandle)
+    {
+        if (inv_handle >= m_handles_by_inv.size())
+            m_handles_by_inv.resize(inv_handle + 1);
+        *m_handles_by_inv.ensure_present(inv_handle) = handle + 1;
+    }
+    else
+    {
+        bool success = m_large_inv_handles.insert(inv_handle, handle).second;
+        VOGL_ASSERT(success);
+        VOGL_NOTE_UNUSED(success);
+    }
+}
+
+void vogl_handle_tracker::remove_inv_handle_mapping(handle_t inv_handle)
+{
+    if (inv_handle < cMaxDirectInvHandle)
+    {
+        VOGL_ASSERT(inv_handle < m_handles_by_inv.size());
+        *m_handles_by_inv.ensure_present(inv_handle) = 0;
+    }
+    else
+    {
+        bool success = m_large_inv_handles.erase(inv_handle);
+        VOGL_ASSERT(success);
+        VOGL_NOTE_UNUSED(success);
+    }
+}
+
+void vogl_handle_tracker::insert_new(handle_t handle, handle_t inv_handle, GLenum target)
+{
+    VOGL_ASSERT(!is_valid_handle(handle) && !is_valid_inv_handle(inv_handle));
+
+    ensure_handle_capacity(handle);
+
+    m_valid_handles.set_bit(handle);
+    *m_inv_handles.ensure_present(handle) = inv_handle;
+    *m_targets.ensure_present(handle) = target;
+
+    set_inv_handle_mapping(inv_handle, handle);
+
+    m_total_valid_handles++;
+}
+
+void vogl_handle_tracker::remove(handle_t handle)
+{
+    VOGL_ASSERT(is_valid_handle(handle));
+
+    handle_t inv_handle = m_inv_handles[handle];
+
+    m_valid_handles.clear_bit(handle);
+    *m_inv_handles.ensure_present(handle) = 0;
+    *m_targets.ensure_present(handle) = GL_NONE;
+
+    remove_inv_handle_mapping(inv_handle);
+
+    VOGL_ASSERT(m_total_valid_handles);
+    m_total_valid_handles--;
 }
 
 bool vogl_handle_tracker::insert(handle_t handle, handle_t inv_handle, GLenum target)
@@ -88,34 +185,55 @@ bool vogl_handle_tracker::insert(handle_t handle, handle_t inv_handle, GLenum ta
 
     if (is_valid_handle(handle))
     {
-        VOGL_ASSERT(m_handles[handle].get_inv_handle() == inv_handle);
+        VOGL_ASSERT(m_inv_handles[handle] == inv_handle);
         VOGL_ASSERT(is_valid_inv_handle(inv_handle));
-        VOGL_ASSERT(m_inv_handles.value(inv_handle) == handle);
         return false;
     }
 
     if (is_valid_inv_handle(inv_handle))
         return false;
 
-    handle_def *pHandle = m_handles.ensure_present(handle);
-    pHandle->init(handle, inv_handle, target);
-
-    bool inv_insert_success = m_inv_handles.insert(inv_handle, handle).second;
-    VOGL_ASSERT(inv_insert_success);
-    VOGL_NOTE_UNUSED(inv_insert_success);
+    insert_new(handle, inv_handle, target);
 
     return true;
 }
 
+uint vogl_handle_tracker::insert_array(uint n, const handle_t *pHandles, const handle_t *pInv_handles, GLenum target)
+{
+    VOGL_FUNC_TRACER
+
+    handle_t max_handle = 0;
+    for (uint i = 0; i < n; i++)
+        max_handle = math::maximum(max_handle, pHandles[i]);
+
+    if (max_handle)
+        ensure_handle_capacity(max_handle);
+
+    for (uint i = 0; i < n; i++)
+    {
+        handle_t handle = pHandles[i];
+        if (!handle)
+            continue;
+
+        handle_t inv_handle = pInv_handles[i];
+        if ((is_valid_handle(handle)) || (is_valid_inv_handle(inv_handle)))
+            return i;
+
+        insert_new(handle, inv_handle, target);
+    }
+
+    return n;
+}
+
 bool vogl_handle_tracker::conditional_update(handle_t handle, handle_t inv_handle, GLenum compare_target, GLenum target)
 {
     VOGL_FUNC_TRACER
 
     if (is_valid_handle(handle))
     {
-        handle_def &def = m_handles.get_or_create_element(handle);
-        if (def.get_target() == compare_target)
-            def.set_target(target);
+        GLenum *pTarget = m_targets.ensure_present(handle);
+        if (*pTarget == compare_target)
+            *pTarget = target;
         return true;
     }
 
@@ -128,12 +246,12 @@ bool vogl_handle_tracker::update(handle_t handle, handle_t inv_handle, GLenum ta
 
     if (is_valid_handle(handle))
     {
-        handle_def &def = m_handles.get_or_create_element(handle);
+        GLenum *pTarget = m_targets.ensure_present(handle);
 
-        if ((def.get_target() != GL_NONE) && (target != def.get_target()))
-            vogl_debug_printf("%s: Object target is being changed from %s to %s, handle %u inv handle %u, namespace %s\n", VOGL_FUNCTION_INFO_CSTR, get_gl_enums().find_gl_name(def.get_target()), get_gl_enums().find_gl_name(target), def.get_handle(), def.get_inv_handle(), vogl_get_namespace_name(m_namespace));
+        if ((*pTarget != GL_NONE) && (target != *pTarget))
+            vogl_debug_printf("%s: Object target is being changed from %s to %s, handle %u inv handle %u, namespace %s\n", VOGL_FUNCTION_INFO_CSTR, get_gl_enums().find_gl_name(*pTarget), get_gl_enums().find_gl_name(target), handle, m_inv_handles[handle], vogl_get_namespace_name(m_namespace));
 
-        def.set_target(target);
+        *pTarget = target;
         return true;
     }
 
@@ -145,16 +263,16 @@ bool vogl_handle_tracker::update_inv(handle_t inv_handle, handle_t handle, GLenu
     VOGL_FUNC_TRACER
 
     handle_t actual_handle;
-    if (map_inv_handle_to_handle(inv_handle, actual_handle))
+    if (find_inv_handle(inv_handle, actual_handle))
     {
         VOGL_ASSERT(is_valid_handle(actual_handle));
 
-        handle_def &def = m_handles.get_or_create_element(actual_handle);
+        GLenum *pTarget = m_targets.ensure_present(actual_handle);
 
-        if ((def.get_target() != GL_NONE) && (target != def.get_target()))
-            vogl_debug_printf("%s: Object target is being changed from %s to %s, handle %u inv handle %u, namespace %s\n", VOGL_FUNCTION_INFO_CSTR, get_gl_enums().find_gl_name(def.get_target()), get_gl_enums().find_gl_name(target), def.get_handle(), def.get_inv_handle(), vogl_get_namespace_name(m_namespace));
+        if ((*pTarget != GL_NONE) && (target != *pTarget))
+            vogl_debug_printf("%s: Object target is being changed from %s to %s, handle %u inv handle %u, namespace %s\n", VOGL_FUNCTION_INFO_CSTR, get_gl_enums().find_gl_name(*pTarget), get_gl_enums().find_gl_name(target), actual_handle, inv_handle, vogl_get_namespace_name(m_namespace));
 
-        def.set_target(target);
+        *pTarget = target;
 
         return true;
     }
@@ -168,7 +286,7 @@ bool vogl_handle_tracker::set_target(handle_t handle, GLenum target)
 
     if (!is_valid_handle(handle))
         return false;
-    m_handles.get_or_create_element(handle).set_target(target);
+    *m_targets.ensure_present(handle) = target;
     return true;
 }
 
@@ -176,22 +294,19 @@ bool vogl_handle_tracker::set_target_inv(handle_t inv_handle, GLenum target)
 {
     VOGL_FUNC_TRACER
 
-    handle_hash_map_t::const_iterator it(m_inv_handles.find(inv_handle));
-    if (it == m_inv_handles.end())
+    handle_t handle;
+    if (!find_inv_handle(inv_handle, handle))
         return false;
-    return set_target(it->second, target);
+    return set_target(handle, target);
 }
 
 bool vogl_handle_tracker::map_inv_handle_to_handle(handle_t inv_handle, handle_t &handle) const
 {
     VOGL_FUNC_TRACER
 
-    handle_hash_map_t::const_iterator it(m_inv_handles.find(inv_handle));
-    if (it == m_inv_handles.end())
+    if (!find_inv_handle(inv_handle, handle))
         return false;
 
-    handle = it->second;
-
     VOGL_ASSERT(contains(handle));
 
     return handle;
@@ -201,13 +316,10 @@ bool vogl_handle_tracker::map_handle_to_inv_handle(handle_t handle, handle_t &in
 {
     VOGL_FUNC_TRACER
 
-    if (handle >= m_handles.size())
-        return false;
-
-    if (!m_handles[handle].is_valid())
+    if (!is_valid_handle(handle))
         return false;
 
-    inv_handle = m_handles[handle].get_inv_handle();
+    inv_handle = m_inv_handles[handle];
 
     VOGL_ASSERT(contains_inv(inv_handle));
 
@@ -220,7 +332,7 @@ GLenum vogl_handle_tracker::get_target(handle_t handle) const
 
     if (!is_valid_handle(handle))
         return GL_NONE;
-    return m_handles[handle].get_target();
+    return m_targets[handle];
 }
 
 GLenum vogl_handle_tracker::get_target_inv(handle_t inv_handle) const
@@ -228,10 +340,10 @@ GLenum vogl_handle_tracker::get_target_inv(handle_t inv_handle) const
     VOGL_FUNC_TRACER
 
     handle_t handle;
-    if (!map_inv_handle_to_handle(inv_handle, handle))
+    if (!find_inv_handle(inv_handle, handle))
         return GL_NONE;
     VOGL_ASSERT(is_valid_handle(handle));
-    return m_handles[handle].get_target();
+    return m_targets[handle];
 }
 
 bool vogl_handle_tracker::erase(handle_t handle)
@@ -241,18 +353,7 @@ bool vogl_handle_tracker::erase(handle_t handle)
     if (!is_valid_handle(handle))
         return false;
 
-    VOGL_ASSERT(m_handles[handle].get_handle() == handle);
-
-    uint inv_handle = m_handles[handle].get_inv_handle();
-
-    VOGL_ASSERT(m_inv_handles.value(inv_handle) == handle);
-
-    m_handles.get_or_create_element(handle).clear();
-    VOGL_ASSERT(!m_handles[handle].is_valid());
-
-    bool success = m_inv_handles.erase(inv_handle);
-    VOGL_NOTE_UNUSED(success);
-    VOGL_ASSERT(success);
+    remove(handle);
 
     return true;
 }
@@ -261,25 +362,47 @@ bool vogl_handle_tracker::erase_inv(handle_t inv_handle)
 {
     VOGL_FUNC_TRACER
 
-    handle_hash_map_t::const_iterator it(m_inv_handles.find(inv_handle));
-    if (it == m_inv_handles.end())
+    handle_t handle;
+    if (!find_inv_handle(inv_handle, handle))
         return false;
 
-    uint handle = it->second;
     if (!is_valid_handle(handle))
     {
         VOGL_ASSERT_ALWAYS;
+        remove_inv_handle_mapping(inv_handle);
+        return true;
     }
-    else
+
+    VOGL_ASSERT(m_inv_handles[handle] == inv_handle);
+    remove(handle);
+
+    return true;
+}
+
+uint vogl_handle_tracker::erase_array(uint n, const handle_t *pHandles, handle_t *pInv_handles)
+{
+    VOGL_FUNC_TRACER
+
+    for (uint i = 0; i < n; i++)
     {
-        VOGL_ASSERT(m_handles[handle].get_handle() == handle);
-        VOGL_ASSERT(m_handles[handle].get_inv_handle() == inv_handle);
-        m_handles.get_or_create_element(handle).clear();
-        VOGL_ASSERT(!m_handles[handle].is_valid());
+        handle_t handle = pHandles[i];
+
+        if (pInv_handles)
+            pInv_handles[i] = 0;
+
+        if (!handle)
+            continue;
+
+        if (!is_valid_handle(handle))
+            return i;
+
+        if (pInv_handles)
+            pInv_handles[i] = m_inv_handles[handle];
+
+        remove(handle);
     }
 
-    m_inv_handles.erase(inv_handle);
-    return true;
+    return n;
 }
 
 bool vogl_handle_tracker::invert(vogl_handle_tracker &inverted_map) const
@@ -288,13 +411,9 @@ bool vogl_handle_tracker::invert(vogl_handle_tracker &inverted_map) const
 
     inverted_map.clear();
 
-    for (uint handle = 0; handle < m_handles.size(); handle++)
+    for (uint handle = find_next_handle(0); handle != cUINT32_MAX; handle = find_next_handle(handle + 1))
     {
-        const handle_def &def = m_handles[handle];
-        if (!def.is_valid())
-            continue;
-
-        if (!inverted_map.insert(def.get_inv_handle(), def.get_handle(), def.get_target()))
+        if (!inverted_map.insert(m_inv_handles[handle], handle, m_targets[handle]))
             return false;
     }
 
@@ -305,48 +424,42 @@ bool vogl_handle_tracker::check() const
 {
     VOGL_FUNC_TRACER
 
-    handle_hash_map_t forward_to_inverse_map;
-    forward_to_inverse_map.reserve(m_inv_handles.size());
-    for (handle_hash_map_t::const_iterator it = m_inv_handles.begin(); it != m_inv_handles.end(); ++it)
-        if (!forward_to_inverse_map.insert(it->second, it->first).second)
-            return false;
-
-    uint total_found = 0;
-    for (uint handle = 0; handle < m_handles.size(); handle++)
-    {
-        if (!m_handles.is_present(handle))
-        {
-            if (forward_to_inverse_map.contains(handle))
-                return false;
-            continue;
-        }
+    if (m_valid_handles.count_set_bits() != m_total_valid_handles)
+        return false;
 
-        const handle_def &def = m_handles[handle];
-        if (!def.is_valid())
-        {
-            if (forward_to_inverse_map.contains(handle))
-                return false;
-            continue;
-        }
+    if ((m_inv_handles.size() != m_size) || (m_targets.size() != m_size) || (m_valid_handles.get_size() < m_size))
+        return false;
 
-        const uint *pInv_handle = forward_to_inverse_map.find_value(handle);
-        if (!pInv_handle)
+    for (uint handle = find_next_handle(0); handle != cUINT32_MAX; handle = find_next_handle(handle + 1))
+    {
+        handle_t mapped_handle;
+        if (!find_inv_handle(m_inv_handles[handle], mapped_handle))
             return false;
-
-        uint inv_handle = *pInv_handle;
-
-        if (m_inv_handles.value(inv_handle) != handle)
+        if (mapped_handle != static_cast<handle_t>(handle))
             return false;
+    }
 
-        if (def.get_handle() != handle)
+    // Every inverse mapping must point back at a valid handle, and there must be exactly one per valid handle.
+    uint total_inv_handles = m_large_inv_handles.size();
+    for (handle_hash_map_t::const_iterator it = m_large_inv_handles.begin(); it != m_large_inv_handles.end(); ++it)
+    {
+        if ((!is_valid_handle(it->second)) || (m_inv_handles[it->second] != it->first))
             return false;
-        if (def.get_inv_handle() != inv_handle)
+    }
+
+    for (uint inv_handle = 0; inv_handle < m_handles_by_inv.size(); inv_handle++)
+    {
+        handle_t h = m_handles_by_inv[inv_handle];
+        if (!h)
+            continue;
+
+        if ((!is_valid_handle(h - 1)) || (m_inv_handles[h - 1] != inv_handle))
             return false;
 
-        total_found++;
+        total_inv_handles++;
     }
 
-    if (total_found != m_inv_handles.size())
+    if (total_inv_handles != m_total_valid_handles)
         return false;
 
     return true;
@@ -356,11 +469,17 @@ bool vogl_handle_tracker::operator==(const vogl_handle_tracker &other) const
 {
     VOGL_FUNC_TRACER
 
-    if (m_inv_handles != other.m_inv_handles)
+    if (m_total_valid_handles != other.m_total_valid_handles)
         return false;
 
-    if (m_handles != other.m_handles)
-        return false;
+    for (uint handle = find_next_handle(0); handle != cUINT32_MAX; handle = find_next_handle(handle + 1))
+    {
+        if (!other.is_valid_handle(handle))
+            return false;
+
+        if ((m_inv_handles[handle] != other.m_inv_handles[handle]) || (m_targets[handle] != other.m_targets[handle]))
+            return false;
+    }
 
     return true;
 }
@@ -371,15 +490,12 @@ bool vogl_handle_tracker::serialize(json_node &node) const
 
     node.init_array();
 
-    for (uint i = 0; i < m_handles.size(); i++)
+    for (uint handle = find_next_handle(0); handle != cUINT32_MAX; handle = find_next_handle(handle + 1))
     {
-        if (!is_valid_handle(i))
-            continue;
-
         json_node &obj = node.add_object();
-        obj.add_key_value("handle", m_handles[i].get_handle());
-        obj.add_key_value("inv_handle", m_handles[i].get_inv_handle());
-        obj.add_key_value("target", m_handles[i].get_target());
+        obj.add_key_value("handle", static_cast<handle_t>(handle));
+        obj.add_key_value("inv_handle", m_inv_handles[handle]);
+        obj.add_key_value("target", m_targets[handle]);
     }
 
     return true;
@@ -32,17 +32,20 @@
 #include "vogl_common.h"
 #include "vogl_hash_map.h"
 #include "vogl_sparse_vector.h"
+#include "vogl_sparse_bit_array.h"
 #include "vogl_json.h"
 
+// Bidirectional handle<->inverse handle map (i.e. trace<->replay GL handles), along with each handle's target.
+// Storage is struct-of-arrays indexed directly by handle: a validity bitmap plus paged inverse handle and target arrays.
+// The inverse direction is a paged direct-index table for reasonably sized inverse handles, with a hash map fallback for huge ones.
 class vogl_handle_tracker
 {
 public:
     typedef uint32 handle_t;
 
+    // Value type describing a single handle, returned by operator[].
     class handle_def
     {
-        friend class vogl_handle_tracker;
-
     public:
         handle_def()
         {
@@ -101,19 +104,9 @@ public:
         handle_t m_inv_handle;
         GLenum m_target;
         bool m_is_valid;
-
-        void set_handle(handle_t handle)
-        {
-            m_handle = handle;
-        }
-        void set_inv_handle(handle_t inv_handle)
-        {
-            m_inv_handle = inv_handle;
-        }
     };
 
-    typedef vogl::sparse_vector<handle_def, 5> handle_def_vec;
-    typedef vogl::hash_map<handle_t, uint> handle_hash_map_t;
+    typedef vogl::hash_map<handle_t, handle_t> handle_hash_map_t;
 
     vogl_handle_tracker();
     vogl_handle_tracker(vogl_namespace_t handle_namespace);
@@ -132,36 +125,39 @@ public:
 
     uint get_total_valid_handles() const
     {
-        return m_inv_handles.size();
+        return m_total_valid_handles;
     }
 
     // size() and operator[] allow you to iterate over the entire handle namespace, but beware that not all handles may be valid!
     // size() is not necessarily always equal to get_total_valid_handles()!
+    // Prefer find_next_handle(), which skips over invalid handles a bitmap word at a time.
     uint size() const
     {
-        return m_handles.size();
+        return m_size;
     }
-    const handle_def &operator[](uint index) const
+    handle_def operator[](uint index) const
     {
-        return m_handles[index];
+        if (!is_valid_handle(index))
+            return handle_def();
+        return handle_def(index, m_inv_handles[index], m_targets[index]);
     }
 
-    void get_handles(uint_vec &handles);
-    void get_inv_handles(uint_vec &inv_handles);
+    // Returns the first valid handle >= first_handle, or cUINT32_MAX. To iterate:
+    // for (uint handle = tracker.find_next_handle(0); handle != cUINT32_MAX; handle = tracker.find_next_handle(handle + 1))
+    uint find_next_handle(uint first_handle) const;
 
-    const handle_def_vec &get_handles() const
-    {
-        return m_handles;
-    }
-    const handle_hash_map_t get_inv_handles() const
-    {
-        return m_inv_handles;
-    }
+    void get_handles(uint_vec &handles) const;
+    void get_inv_handles(uint_vec &inv_handles) const;
 
     // true if insertion occured, otherwise it already existed and wasn't updated.
     bool insert(handle_t handle, handle_t inv_handle, GLenum target);
     //bool insert(handle_t handle, GLenum target) { return insert(handle, handle, target); }
 
+    // Bulk insert for glGen*() style arrays (pInv_handles may equal pHandles). Zero handles are skipped.
+    // Returns the number of entries processed: if less than n, the entry at that index couldn't be inserted because
+    // its handle or inv handle already exists, and the caller can resolve the conflict and continue after it.
+    uint insert_array(uint n, const handle_t *pHandles, const handle_t *pInv_handles, GLenum target);
+
     // If handle is missing, the handle/inv_handle/target is added.
     // Otherwise, it's only updated if the target is compare_target (and the inv_handle is ignored).
     bool conditional_update(handle_t handle, handle_t inv_handle, GLenum compare_target, GLenum target);
@@ -209,6 +205,11 @@ public:
     bool erase(handle_t handle);
     bool erase_inv(handle_t inv_handle);
 
+    // Bulk erase for glDelete*() style arrays. Zero handles are skipped. If pInv_handles is not NULL, the inv handle of each
+    // erased entry is written to it (0 for skipped entries). Returns the number of entries processed: if less than n,
+    // the handle at that index wasn't present.
+    uint erase_array(uint n, const handle_t *pHandles, handle_t *pInv_handles);
+
     bool invert(vogl_handle_tracker &inverted_map) const;
 
     // Consistency check
@@ -224,18 +225,68 @@ public:
     bool deserialize(const json_node &node);
 
 private:
+    // Inverse handles below this are mapped through m_handles_by_inv, larger ones go into m_large_inv_handles.
+    // Log2 page size 8 keeps the top level page table <= 128KB at this limit.
+    enum
+    {
+        cMaxDirectInvHandle = 1U << 22
+    };
+
+    typedef vogl::sparse_vector<handle_t, 8> handle_vec;
+    typedef vogl::sparse_vector<GLenum, 8> target_vec;
+
     vogl_namespace_t m_namespace;
-    handle_def_vec m_handles;
-    handle_hash_map_t m_inv_handles;
+
+    uint m_size;
+    uint m_total_valid_handles;
+
+    // Indexed by handle.
+    vogl::sparse_bit_array m_valid_handles;
+    handle_vec m_inv_handles;
+    target_vec m_targets;
+
+    // Indexed by inv handle, stores handle + 1 (0 means not present).
+    handle_vec m_handles_by_inv;
+    handle_hash_map_t m_large_inv_handles;
 
     bool is_valid_handle(handle_t handle) const
     {
-        return (handle < m_handles.size()) && (m_handles[handle].is_valid());
+        return (handle < m_size) && (m_valid_handles.get_bit(handle));
     }
     bool is_valid_inv_handle(handle_t inv_handle) const
     {
-        return m_inv_handles.contains(inv_handle);
+        handle_t handle;
+        return find_inv_handle(inv_handle, handle);
     }
+
+    inline bool find_inv_handle(handle_t inv_handle, handle_t &handle) const
+    {
+        if (inv_handle < cMaxDirectInvHandle)
+        {
+            if (inv_handle >= m_handles_by_inv.size())
+                return false;
+
+            handle_t h = m_handles_by_inv[inv_handle];
+            if (!h)
+                return false;
+
+            handle = h - 1;
+            return true;
+        }
+
+        const handle_t *pHandle = m_large_inv_handles.find_value(inv_handle);
+        if (!pHandle)
+            return false;
+
+        handle = *pHandle;
+        return true;
+    }
+
+    void ensure_handle_capacity(handle_t max_handle);
+    void set_inv_handle_mapping(handle_t inv_handle, handle_t handle);
+    void remove_inv_handle_mapping(handle_t inv_handle);
+    void insert_new(handle_t handle, handle_t inv_handle, GLenum target);
+    void remove(handle_t handle);
 };
 
 #endif // VOGL_HANDLE_TRACKER_H
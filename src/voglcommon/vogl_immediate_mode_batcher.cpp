@@ -0,0 +1,331 @@
+/**************************************************************************
+ *
+ * Copyright 2013-2014 RAD Game Tools and Valve Software
+ * Copyright 2010-2014 Rich Geldreich and Tenacious Software LLC
+ * All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ **************************************************************************/
+
+// File: vogl_immediate_mode_batcher.cpp
+#include "vogl_immediate_mode_batcher.h"
+
+//----------------------------------------------------------------------------------------------------------------------
+// vogl_get_immediate_mode_values
+// divisor is 255 for normalized unsigned byte colors, otherwise 1.
+//----------------------------------------------------------------------------------------------------------------------
+template <typename T>
+static bool vogl_get_immediate_mode_values(const vogl_trace_packet &trace_packet, uint num_values, bool is_vector, float divisor, float *pValues)
+{
+    if (is_vector)
+    {
+        const T *pSrc = trace_packet.get_param_client_memory<T>(0);
+        if ((!pSrc) || (trace_packet.get_param_client_memory_data_size(0) < num_values * sizeof(T)))
+            return false;
+
+        for (uint i = 0; i < num_values; i++)
+            pValues[i] = static_cast<float>(pSrc[i]) / divisor;
+    }
+    else
+    {
+        for (uint i = 0; i < num_values; i++)
+            pValues[i] = static_cast<float>(trace_packet.get_param_value<T>(i)) / divisor;
+    }
+
+    return true;
+}
+
+vogl_immediate_mode_batcher::vogl_immediate_mode_batcher()
+    : m_mode(GL_NONE),
+      m_num_vertices(0),
+      m_used_attribs(0),
+      m_enabled_arrays(0),
+      m_vao(0),
+      m_buffer(0),
+      m_active(false),
+      m_supported(false),
+      m_checked_support(false)
+{
+    VOGL_FUNC_TRACER
+}
+
+bool vogl_immediate_mode_batcher::begin(const vogl_context_info &context_info, GLenum mode)
+{
+    VOGL_FUNC_TRACER
+
+    VOGL_ASSERT(!m_active);
+
+    if (!m_checked_support)
+    {
+        m_checked_support = true;
+        m_supported = !context_info.is_core_profile() && ((context_info.get_version() >= VOGL_GL_VERSION_3_0) || context_info.supports_extension("GL_ARB_vertex_array_object"));
+    }
+
+    if (!m_supported)
+        return false;
+
+    m_active = true;
+    m_mode = mode;
+    m_num_vertices = 0;
+    m_used_attribs = 0;
+    m_commands.resize(0);
+
+    return true;
+}
+
+bool vogl_immediate_mode_batcher::add(const vogl_trace_packet &trace_packet)
+{
+    VOGL_FUNC_TRACER
+
+    VOGL_ASSERT(m_active);
+
+    command cmd;
+    cmd.m_values[0] = 0.0f;
+    cmd.m_values[1] = 0.0f;
+    cmd.m_values[2] = 0.0f;
+    cmd.m_values[3] = 1.0f;
+
+    bool success = false;
+
+    switch (trace_packet.get_entrypoint_id())
+    {
+#define VOGL_BATCH_CALL(name, attrib, type, num_values, is_vector, divisor)                                               \
+    case VOGL_ENTRYPOINT_##name:                                                                                          \
+        cmd.m_attrib = attrib;                                                                                            \
+        success = vogl_get_immediate_mode_values<type>(trace_packet, num_values, is_vector, divisor, cmd.m_values); \
+        break;
+#define VOGL_BATCH_CALL_AND_VECTOR(name, attrib, type, num_values, divisor)  \
+    VOGL_BATCH_CALL(name, attrib, type, num_values, false, divisor) \
+    VOGL_BATCH_CALL(name##v, attrib, type, num_values, true, divisor)
+
+        VOGL_BATCH_CALL_AND_VECTOR(glVertex2f, cAttribVertex, GLfloat, 2, 1.0f)
+        VOGL_BATCH_CALL_AND_VECTOR(glVertex3f, cAttribVertex, GLfloat, 3, 1.0f)
+        VOGL_BATCH_CALL_AND_VECTOR(glVertex4f, cAttribVertex, GLfloat, 4, 1.0f)
+        VOGL_BATCH_CALL_AND_VECTOR(glVertex2d, cAttribVertex, GLdouble, 2, 1.0f)
+        VOGL_BATCH_CALL_AND_VECTOR(glVertex3d, cAttribVertex, GLdouble, 3, 1.0f)
+        VOGL_BATCH_CALL_AND_VECTOR(glVertex4d, cAttribVertex, GLdouble, 4, 1.0f)
+        VOGL_BATCH_CALL_AND_VECTOR(glVertex2i, cAttribVertex, GLint, 2, 1.0f)
+        VOGL_BATCH_CALL_AND_VECTOR(glVertex3i, cAttribVertex, GLint, 3, 1.0f)
+        VOGL_BATCH_CALL_AND_VECTOR(glVertex4i, cAttribVertex, GLint, 4, 1.0f)
+        VOGL_BATCH_CALL_AND_VECTOR(glVertex2s, cAttribVertex, GLshort, 2, 1.0f)
+        VOGL_BATCH_CALL_AND_VECTOR(glVertex3s, cAttribVertex, GLshort, 3, 1.0f)
+        VOGL_BATCH_CALL_AND_VECTOR(glVertex4s, cAttribVertex, GLshort, 4, 1.0f)
+
+        VOGL_BATCH_CALL_AND_VECTOR(glColor3f, cAttribColor, GLfloat, 3, 1.0f)
+        VOGL_BATCH_CALL_AND_VECTOR(glColor4f, cAttribColor, GLfloat, 4, 1.0f)
+        VOGL_BATCH_CALL_AND_VECTOR(glColor3d, cAttribColor, GLdouble, 3, 1.0f)
+        VOGL_BATCH_CALL_AND_VECTOR(glColor4d, cAttribColor, GLdouble, 4, 1.0f)
+        VOGL_BATCH_CALL_AND_VECTOR(glColor3ub, cAttribColor, GLubyte, 3, 255.0f)
+        VOGL_BATCH_CALL_AND_VECTOR(glColor4ub, cAttribColor, GLubyte, 4, 255.0f)
+
+        VOGL_BATCH_CALL_AND_VECTOR(glNormal3f, cAttribNormal, GLfloat, 3, 1.0f)
+        VOGL_BATCH_CALL_AND_VECTOR(glNormal3d, cAttribNormal, GLdouble, 3, 1.0f)
+
+        VOGL_BATCH_CALL_AND_VECTOR(glTexCoord1f, cAttribTexCoord, GLfloat, 1, 1.0f)
+        VOGL_BATCH_CALL_AND_VECTOR(glTexCoord2f, cAttribTexCoord, GLfloat, 2, 1.0f)
+        VOGL_BATCH_CALL_AND_VECTOR(glTexCoord3f, cAttribTexCoord, GLfloat, 3, 1.0f)
+        VOGL_BATCH_CALL_AND_VECTOR(glTexCoord4f, cAttribTexCoord, GLfloat, 4, 1.0f)
+        VOGL_BATCH_CALL_AND_VECTOR(glTexCoord1d, cAttribTexCoord, GLdouble, 1, 1.0f)
+        VOGL_BATCH_CALL_AND_VECTOR(glTexCoord2d, cAttribTexCoord, GLdouble, 2, 1.0f)
+        VOGL_BATCH_CALL_AND_VECTOR(glTexCoord3d, cAttribTexCoord, GLdouble, 3, 1.0f)
+        VOGL_BATCH_CALL_AND_VECTOR(glTexCoord4d, cAttribTexCoord, GLdouble, 4, 1.0f)
+
+#undef VOGL_BATCH_CALL_AND_VECTOR
+#undef VOGL_BATCH_CALL
+
+        default:
+            return false;
+    }
+
+    if (!success)
+        return false;
+
+    if (cmd.m_attrib == cAttribVertex)
+        m_num_vertices++;
+    else
+    {
+        // The vertices already batched would need this attribute's current value from before glBegin(), which we don't know.
+        if ((m_num_vertices) && (!(m_used_attribs & (1U << cmd.m_attrib))))
+            return false;
+
+        m_used_attribs |= (1U << cmd.m_attrib);
+    }
+
+    m_commands.push_back(cmd);
+
+    return true;
+}
+
+void vogl_immediate_mode_batcher::flush_to_immediate_mode()
+{
+    VOGL_FUNC_TRACER
+
+    VOGL_ASSERT(m_active);
+
+    m_active = false;
+
+    GL_ENTRYPOINT(glBegin)(m_mode);
+
+    for (uint i = 0; i < m_commands.size(); i++)
+    {
+        const command &cmd = m_commands[i];
+
+        switch (cmd.m_attrib)
+        {
+            case cAttribVertex:
+                GL_ENTRYPOINT(glVertex4fv)(cmd.m_values);
+                break;
+            case cAttribColor:
+                GL_ENTRYPOINT(glColor4fv)(cmd.m_values);
+                break;
+            case cAttribNormal:
+                GL_ENTRYPOINT(glNormal3fv)(cmd.m_values);
+                break;
+            case cAttribTexCoord:
+                GL_ENTRYPOINT(glTexCoord4fv)(cmd.m_values);
+                break;
+            default:
+                VOGL_ASSERT_ALWAYS;
+                break;
+        }
+    }
+
+    m_commands.resize(0);
+}
+
+void vogl_immediate_mode_batcher::update_enabled_arrays(uint arrays)
+{
+    VOGL_FUNC_TRACER
+
+    static const GLenum s_array_enums[cTotalAttribs] = { GL_VERTEX_ARRAY, GL_COLOR_ARRAY, GL_NORMAL_ARRAY, GL_TEXTURE_COORD_ARRAY };
+
+    uint changed_arrays = arrays ^ m_enabled_arrays;
+    if (!changed_arrays)
+        return;
+
+    // The texcoord array enable is selected by the client active texture, which isn't VAO state.
+    GLint prev_client_active_texture = GL_TEXTURE0;
+    if (changed_arrays & (1U << cAttribTexCoord))
+    {
+        GL_ENTRYPOINT(glGetIntegerv)(GL_CLIENT_ACTIVE_TEXTURE, &prev_client_active_texture);
+        GL_ENTRYPOINT(glClientActiveTexture)(GL_TEXTURE0);
+    }
+
+    for (uint i = 0; i < cTotalAttribs; i++)
+    {
+        if (!(changed_arrays & (1U << i)))
+            continue;
+
+        if (arrays & (1U << i))
+            GL_ENTRYPOINT(glEnableClientState)(s_array_enums[i]);
+        else
+            GL_ENTRYPOINT(glDisableClientState)(s_array_enums[i]);
+    }
+
+    if (changed_arrays & (1U << cAttribTexCoord))
+        GL_ENTRYPOINT(glClientActiveTexture)(prev_client_active_texture);
+
+    m_enabled_arrays = arrays;
+}
+
+void vogl_immediate_mode_batcher::end()
+{
+    VOGL_FUNC_TRACER
+
+    VOGL_ASSERT(m_active);
+
+    m_active = false;
+
+    vertex cur_vertex;
+    for (uint i = 0; i < cTotalAttribs; i++)
+    {
+        cur_vertex.m_attribs[i][0] = 0.0f;
+        cur_vertex.m_attribs[i][1] = 0.0f;
+        cur_vertex.m_attribs[i][2] = 0.0f;
+        cur_vertex.m_attribs[i][3] = 1.0f;
+    }
+
+    m_vertices.resize(0);
+    m_vertices.reserve(m_num_vertices);
+
+    for (uint i = 0; i < m_commands.size(); i++)
+    {
+        const command &cmd = m_commands[i];
+
+        memcpy(cur_vertex.m_attribs[cmd.m_attrib], cmd.m_values, sizeof(cmd.m_values));
+
+        if (cmd.m_attrib == cAttribVertex)
+            m_vertices.push_back(cur_vertex);
+    }
+
+    GLint prev_vao = 0, prev_array_buffer = 0;
+    GL_ENTRYPOINT(glGetIntegerv)(GL_VERTEX_ARRAY_BINDING, &prev_vao);
+    GL_ENTRYPOINT(glGetIntegerv)(GL_ARRAY_BUFFER_BINDING, &prev_array_buffer);
+
+    if (!m_vao)
+    {
+        GL_ENTRYPOINT(glGenVertexArrays)(1, &m_vao);
+        GL_ENTRYPOINT(glGenBuffers)(1, &m_buffer);
+
+        GL_ENTRYPOINT(glBindVertexArray)(m_vao);
+        GL_ENTRYPOINT(glBindBuffer)(GL_ARRAY_BUFFER, m_buffer);
+
+        GLint prev_client_active_texture = GL_TEXTURE0;
+        GL_ENTRYPOINT(glGetIntegerv)(GL_CLIENT_ACTIVE_TEXTURE, &prev_client_active_texture);
+        GL_ENTRYPOINT(glClientActiveTexture)(GL_TEXTURE0);
+
+        // The pointers are offsets into m_buffer, so they stay valid across glBufferData().
+        const GLsizei stride = sizeof(vertex);
+        GL_ENTRYPOINT(glVertexPointer)(4, GL_FLOAT, stride, reinterpret_cast<const GLvoid *>(sizeof(float) * 4 * cAttribVertex));
+        GL_ENTRYPOINT(glColorPointer)(4, GL_FLOAT, stride, reinterpret_cast<const GLvoid *>(sizeof(float) * 4 * cAttribColor));
+        GL_ENTRYPOINT(glNormalPointer)(GL_FLOAT, stride, reinterpret_cast<const GLvoid *>(sizeof(float) * 4 * cAttribNormal));
+        GL_ENTRYPOINT(glTexCoordPointer)(4, GL_FLOAT, stride, reinterpret_cast<const GLvoid *>(sizeof(float) * 4 * cAttribTexCoord));
+
+        GL_ENTRYPOINT(glClientActiveTexture)(prev_client_active_texture);
+
+        m_enabled_arrays = 0;
+    }
+    else
+    {
+        GL_ENTRYPOINT(glBindVertexArray)(m_vao);
+        GL_ENTRYPOINT(glBindBuffer)(GL_ARRAY_BUFFER, m_buffer);
+    }
+
+    // Respecifying the whole store each batch lets the driver orphan the previous one instead of stalling on it.
+    GL_ENTRYPOINT(glBufferData)(GL_ARRAY_BUFFER, m_vertices.size_in_bytes(), m_vertices.get_ptr(), GL_STREAM_DRAW);
+
+    update_enabled_arrays(m_used_attribs | (1U << cAttribVertex));
+
+    // Always draw, even with no vertices, so an invalid mode still raises the error glBegin() would have.
+    GL_ENTRYPOINT(glDrawArrays)(m_mode, 0, m_vertices.size());
+
+    GL_ENTRYPOINT(glBindVertexArray)(prev_vao);
+    GL_ENTRYPOINT(glBindBuffer)(GL_ARRAY_BUFFER, prev_array_buffer);
+
+    // glDrawArrays() leaves the current values of enabled arrays undefined, but glEnd() leaves the last ones set.
+    if (m_used_attribs & (1U << cAttribColor))
+        GL_ENTRYPOINT(glColor4fv)(cur_vertex.m_attribs[cAttribColor]);
+    if (m_used_attribs & (1U << cAttribNormal))
+        GL_ENTRYPOINT(glNormal3fv)(cur_vertex.m_attribs[cAttribNormal]);
+    if (m_used_attribs & (1U << cAttribTexCoord))
+        GL_ENTRYPOINT(glMultiTexCoord4fv)(GL_TEXTURE0, cur_vertex.m_attribs[cAttribTexCoord]);
+
+    m_commands.resize(0);
+}
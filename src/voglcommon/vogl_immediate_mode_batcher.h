@@ -0,0 +1,111 @@
+/**************************************************************************
+ *
+ * Copyright 2013-2014 RAD Game Tools and Valve Software
+ * Copyright 2010-2014 Rich Geldreich and Tenacious Software LLC
+ * All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ **************************************************************************/
+
+// File: vogl_immediate_mode_batcher.h
+#ifndef VOGL_IMMEDIATE_MODE_BATCHER_H
+#define VOGL_IMMEDIATE_MODE_BATCHER_H
+
+#include "vogl_core.h"
+#include "vogl_common.h"
+#include "vogl_context_info.h"
+#include "vogl_trace_packet.h"
+
+//----------------------------------------------------------------------------------------------------------------------
+// class vogl_immediate_mode_batcher
+// Replay helper that accumulates the glVertex/glColor/glNormal/glTexCoord calls between glBegin() and glEnd() on the
+// CPU and submits them as a single glDrawArrays() from a stream VBO, instead of issuing one GL call per attribute.
+// Any other call inside the block makes the replayer fall back to regular immediate mode for the rest of the block.
+// Requires a compatibility context with vertex array objects, because the draw uses a private VAO so the app's vertex
+// array state is left untouched. One instance per context.
+//----------------------------------------------------------------------------------------------------------------------
+class vogl_immediate_mode_batcher
+{
+    VOGL_NO_COPY_OR_ASSIGNMENT_OP(vogl_immediate_mode_batcher);
+
+public:
+    vogl_immediate_mode_batcher();
+
+    bool is_active() const
+    {
+        return m_active;
+    }
+
+    // Returns false if batching isn't possible on this context, in which case the caller must call glBegin() itself.
+    bool begin(const vogl_context_info &context_info, GLenum mode);
+
+    // Returns true if the call was batched. Otherwise the caller must call flush_to_immediate_mode() and replay the call itself.
+    bool add(const vogl_trace_packet &trace_packet);
+
+    // Calls glBegin() and replays everything batched so far as regular immediate mode calls, ending the batch.
+    void flush_to_immediate_mode();
+
+    // Draws the batched vertices in place of glEnd(), ending the batch. The caller checks for GL errors.
+    void end();
+
+private:
+    enum attrib_t
+    {
+        cAttribVertex,
+        cAttribColor,
+        cAttribNormal,
+        cAttribTexCoord,
+        cTotalAttribs
+    };
+
+    struct command
+    {
+        uint m_attrib;
+        float m_values[4];
+    };
+
+    struct vertex
+    {
+        float m_attribs[cTotalAttribs][4];
+    };
+
+    vogl::vector<command> m_commands;
+    vogl::vector<vertex> m_vertices;
+
+    GLenum m_mode;
+    uint m_num_vertices;
+
+    // Bitmask of (1 << attrib_t) set within the current batch.
+    uint m_used_attribs;
+
+    // Bitmask of (1 << attrib_t) whose client arrays are enabled in m_vao.
+    uint m_enabled_arrays;
+
+    GLuint m_vao;
+    GLuint m_buffer;
+
+    bool m_active;
+    bool m_supported;
+    bool m_checked_support;
+
+    void update_enabled_arrays(uint arrays);
+};
+
+#endif // VOGL_IMMEDIATE_MODE_BATCHER_H
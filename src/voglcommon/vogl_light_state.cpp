@@ -86,7 +86,30 @@ bool vogl_light_state::snapshot(const vogl_context_info &context_info)
     return true;
 }
 
-bool vogl_light_state::set_light_parameter(uint light, GLenum pname) const
+bool vogl_light_state::snapshot(const vogl_context_info &context_info, vogl_fixed_function_shadow &shadow)
+{
+    VOGL_FUNC_TRACER
+
+    const vogl_fixed_function_shadow::light_vec *pLights = shadow.get_lights();
+    if ((pLights) && (pLights->size() == context_info.get_max_lights()))
+    {
+        clear();
+
+        m_lights = *pLights;
+        m_valid = true;
+
+        return true;
+    }
+
+    if (!snapshot(context_info))
+        return false;
+
+    shadow.set_lights(m_lights);
+
+    return true;
+}
+
+bool vogl_light_state::set_light_parameter(uint light, GLenum pname, bool skip_if_default) const
 {
     VOGL_FUNC_TRACER
 
@@ -106,6 +129,14 @@ bool vogl_light_state::set_light_parameter(uint light, GLenum pname) const
         return false;
     }
 
+    if (skip_if_default)
+    {
+        float default_vals[4];
+        const uint num_defaults = vogl_get_default_light_parameter(light, pname, default_vals);
+        if (vogl_state_data_matches_defaults(*pData, default_vals, num_defaults))
+            return true;
+    }
+
     if ((pData->get_data_type() == cSTFloat) || (pData->get_data_type() == cSTDouble))
     {
         float fvals[cMaxElements];
@@ -143,9 +174,10 @@ bool vogl_light_state::restore(const vogl_context_info &context_info) const
         vogl_warning_printf("%s: Object has %u lights, but the context only supports %u lights!\n", VOGL_FUNCTION_INFO_CSTR, m_lights.size(), context_info.get_max_lights());
     }
 
+    // The replayer only restores into freshly created contexts, so params still at their GL defaults are skipped.
     for (uint light = 0; light < num_lights; light++)
     {
-#define SET_FLOAT(light, pname) set_light_parameter(light, pname)
+#define SET_FLOAT(light, pname) set_light_parameter(light, pname, true)
         SET_FLOAT(light, GL_CONSTANT_ATTENUATION);
         SET_FLOAT(light, GL_LINEAR_ATTENUATION);
         SET_FLOAT(light, GL_QUADRATIC_ATTENUATION);
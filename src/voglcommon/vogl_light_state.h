@@ -31,6 +31,7 @@
 #include "vogl_context_info.h"
 #include "vogl_general_context_state.h"
 #include "vogl_blob_manager.h"
+#include "vogl_fixed_function_shadow.h"
 
 class vogl_light_state
 {
@@ -40,6 +41,9 @@ public:
 
     bool snapshot(const vogl_context_info &context_info);
 
+    // Copies the lights from the shadow if it knows them, otherwise reads them from GL and reseeds the shadow.
+    bool snapshot(const vogl_context_info &context_info, vogl_fixed_function_shadow &shadow);
+
     bool restore(const vogl_context_info &context_info) const;
 
     void clear();
@@ -74,7 +78,7 @@ private:
 
     bool m_valid;
 
-    bool set_light_parameter(uint light, GLenum pname) const;
+    bool set_light_parameter(uint light, GLenum pname, bool skip_if_default) const;
 };
 
 #endif // VOGL_LIGHT_STATE_H
@@ -82,7 +82,36 @@ bool vogl_material_state::snapshot(const vogl_context_info &context_info)
     return true;
 }
 
-bool vogl_material_state::set_material_parameter(uint side, GLenum pname) const
+bool vogl_material_state::snapshot(const vogl_context_info &context_info, vogl_fixed_function_shadow &shadow)
+{
+    VOGL_FUNC_TRACER
+
+    const vogl_state_vector *pParams = shadow.get_material();
+    if (pParams)
+    {
+        clear();
+
+        for (uint s = 0; s < cTotalSides; s++)
+            m_params[s] = pParams[s];
+        m_valid = true;
+
+        return true;
+    }
+
+    if (!snapshot(context_info))
+        return false;
+
+    if (shadow.is_enabled())
+    {
+        const bool color_material_enabled = GL_ENTRYPOINT(glIsEnabled)(GL_COLOR_MATERIAL) != GL_FALSE;
+        if (!vogl_check_gl_error())
+            shadow.set_material(m_params, color_material_enabled);
+    }
+
+    return true;
+}
+
+bool vogl_material_state::set_material_parameter(uint side, GLenum pname, bool skip_if_default) const
 {
     VOGL_FUNC_TRACER
 
@@ -105,6 +134,14 @@ bool vogl_material_state::set_material_parameter(uint side, GLenum pname) const
         return false;
     }
 
+    if (skip_if_default)
+    {
+        float default_vals[4];
+        const uint num_defaults = vogl_get_default_material_parameter(pname, default_vals);
+        if (vogl_state_data_matches_defaults(*pData, default_vals, num_defaults))
+            return true;
+    }
+
     if ((pData->get_data_type() == cSTFloat) || (pData->get_data_type() == cSTDouble))
     {
         float fvals[cMaxElements];
@@ -141,7 +178,8 @@ bool vogl_material_state::restore(const vogl_context_info &context_info) const
 
     VOGL_CHECK_GL_ERROR;
 
-#define SET_FLOAT(side, pname) set_material_parameter(side, pname)
+    // The replayer only restores into freshly created contexts, so params still at their GL defaults are skipped.
+#define SET_FLOAT(side, pname) set_material_parameter(side, pname, true)
     for (uint s = 0; s < cTotalSides; s++)
     {
         SET_FLOAT(s, GL_AMBIENT);
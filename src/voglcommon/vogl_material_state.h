@@ -31,6 +31,7 @@
 #include "vogl_context_info.h"
 #include "vogl_general_context_state.h"
 #include "vogl_blob_manager.h"
+#include "vogl_fixed_function_shadow.h"
 
 class vogl_material_state
 {
@@ -40,6 +41,9 @@ public:
 
     bool snapshot(const vogl_context_info &context_info);
 
+    // Copies the material from the shadow if it knows it, otherwise reads it from GL and reseeds the shadow.
+    bool snapshot(const vogl_context_info &context_info, vogl_fixed_function_shadow &shadow);
+
     bool restore(const vogl_context_info &context_info) const;
 
     void clear();
@@ -68,7 +72,7 @@ private:
 
     bool m_valid;
 
-    bool set_material_parameter(uint side, GLenum pname) const;
+    bool set_material_parameter(uint side, GLenum pname, bool skip_if_default) const;
 
     static inline GLenum get_face(uint side)
     {
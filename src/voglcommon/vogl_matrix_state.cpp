@@ -140,6 +140,16 @@ bool vogl_matrix_state::save_matrix_stack(const vogl_context_info &context_info,
     return true;
 }
 
+static bool is_identity_matrix(const matrix44D &mat)
+{
+    for (uint r = 0; r < 4; r++)
+        for (uint c = 0; c < 4; c++)
+            if (mat(r, c) != ((r == c) ? 1.0 : 0.0))
+                return false;
+
+    return true;
+}
+
 bool vogl_matrix_state::restore_matrix_stack(const vogl_context_info &context_info, GLenum matrix, uint index) const
 {
     VOGL_FUNC_TRACER
@@ -150,6 +160,10 @@ bool vogl_matrix_state::restore_matrix_stack(const vogl_context_info &context_in
     if ((!pVec) || (pVec->size() < 1))
         return false;
 
+    // The replayer only restores into freshly created contexts, where every stack holds a single identity matrix.
+    if ((pVec->size() == 1) && (is_identity_matrix((*pVec)[0])))
+        return true;
+
     GL_ENTRYPOINT(glMatrixMode)(matrix);
     if (vogl_check_gl_error())
         return false;
@@ -178,8 +192,43 @@ bool vogl_matrix_state::snapshot(const vogl_context_info &context_info)
 {
     VOGL_FUNC_TRACER
 
+    // An uninitialized shadow knows nothing, so every stack is read from GL.
+    vogl_fixed_function_shadow shadow;
+
+    return snapshot(context_info, shadow);
+}
+
+bool vogl_matrix_state::snapshot(const vogl_context_info &context_info, vogl_fixed_function_shadow &shadow)
+{
+    VOGL_FUNC_TRACER
+
     clear();
 
+    vogl::vector<matrix_key> keys;
+    keys.push_back(matrix_key(GL_PROJECTION, 0));
+    keys.push_back(matrix_key(GL_MODELVIEW, 0));
+    keys.push_back(matrix_key(GL_COLOR, 0));
+    for (uint texcoord_index = 0; texcoord_index < context_info.get_max_texture_coords(); texcoord_index++)
+        keys.push_back(matrix_key(GL_TEXTURE, texcoord_index));
+    for (uint i = 0; i < context_info.get_max_arb_program_matrices(); i++)
+        keys.push_back(matrix_key(GL_MATRIX0_ARB + i, 0));
+
+    vogl::vector<matrix_key> unknown_keys;
+    for (uint i = 0; i < keys.size(); i++)
+    {
+        const vogl_fixed_function_shadow::matrix_vec *pMatrices = shadow.get_matrix_stack(keys[i].m_target, keys[i].m_index);
+        if (pMatrices)
+            m_matrices[keys[i]] = *pMatrices;
+        else
+            unknown_keys.push_back(keys[i]);
+    }
+
+    if (unknown_keys.is_empty())
+    {
+        m_valid = true;
+        return true;
+    }
+
     bool any_errors = false;
 
     VOGL_CHECK_GL_ERROR;
@@ -189,30 +238,46 @@ bool vogl_matrix_state::snapshot(const vogl_context_info &context_info)
     if (vogl_check_gl_error())
         any_errors = true;
 
-    if (!save_matrix_stack(context_info, GL_PROJECTION, 0, GL_PROJECTION_STACK_DEPTH, GL_PROJECTION_MATRIX))
-        any_errors = true;
-
-    if (!save_matrix_stack(context_info, GL_MODELVIEW, 0, GL_MODELVIEW_STACK_DEPTH, GL_MODELVIEW_MATRIX))
-        any_errors = true;
-
-    if (!save_matrix_stack(context_info, GL_COLOR, 0, GL_COLOR_MATRIX_STACK_DEPTH, GL_COLOR_MATRIX))
-        any_errors = true;
-
-    for (uint texcoord_index = 0; texcoord_index < context_info.get_max_texture_coords(); texcoord_index++)
+    for (uint i = 0; i < unknown_keys.size(); i++)
     {
-        GL_ENTRYPOINT(glActiveTexture)(GL_TEXTURE0 + texcoord_index);
+        const matrix_key &key = unknown_keys[i];
 
-        if (vogl_check_gl_error())
-            any_errors = true;
+        GLenum depth_get, matrix_get;
+        switch (key.m_target)
+        {
+            case GL_PROJECTION:
+                depth_get = GL_PROJECTION_STACK_DEPTH;
+                matrix_get = GL_PROJECTION_MATRIX;
+                break;
+            case GL_MODELVIEW:
+                depth_get = GL_MODELVIEW_STACK_DEPTH;
+                matrix_get = GL_MODELVIEW_MATRIX;
+                break;
+            case GL_COLOR:
+                depth_get = GL_COLOR_MATRIX_STACK_DEPTH;
+                matrix_get = GL_COLOR_MATRIX;
+                break;
+            case GL_TEXTURE:
+            {
+                depth_get = GL_TEXTURE_STACK_DEPTH;
+                matrix_get = GL_TEXTURE_MATRIX;
 
-        if (!save_matrix_stack(context_info, GL_TEXTURE, texcoord_index, GL_TEXTURE_STACK_DEPTH, GL_TEXTURE_MATRIX))
-            any_errors = true;
-    }
+                GL_ENTRYPOINT(glActiveTexture)(GL_TEXTURE0 + key.m_index);
 
-    for (uint i = 0; i < context_info.get_max_arb_program_matrices(); i++)
-    {
-        if (!save_matrix_stack(context_info, GL_MATRIX0_ARB + i, 0, GL_CURRENT_MATRIX_STACK_DEPTH_ARB, GL_CURRENT_MATRIX_ARB))
+                if (vogl_check_gl_error())
+                    any_errors = true;
+                break;
+            }
+            default:
+                depth_get = GL_CURRENT_MATRIX_STACK_DEPTH_ARB;
+                matrix_get = GL_CURRENT_MATRIX_ARB;
+                break;
+        }
+
+        if (!save_matrix_stack(context_info, key.m_target, key.m_index, depth_get, matrix_get))
             any_errors = true;
+        else
+            shadow.set_matrix_stack(key.m_target, key.m_index, m_matrices[key]);
     }
 
     if (any_errors)
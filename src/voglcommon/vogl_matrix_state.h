@@ -32,6 +32,7 @@
 #include "vogl_context_info.h"
 #include "vogl_general_context_state.h"
 #include "vogl_blob_manager.h"
+#include "vogl_fixed_function_shadow.h"
 
 class vogl_matrix_state
 {
@@ -41,6 +42,9 @@ public:
 
     bool snapshot(const vogl_context_info &context_info);
 
+    // Copies the stacks the shadow knows, only the others are read from GL and used to reseed the shadow.
+    bool snapshot(const vogl_context_info &context_info, vogl_fixed_function_shadow &shadow);
+
     bool restore(const vogl_context_info &context_info) const;
 
     void clear();
@@ -64,6 +64,7 @@ vogl_program_state::vogl_program_state()
       m_link_status(false),
       m_verify_status(false),
       m_link_snapshot(false),
+      m_link_snapshot_pending(false),
       m_is_valid(false)
 {
     VOGL_FUNC_TRACER
@@ -83,6 +84,7 @@ vogl_program_state::vogl_program_state(const vogl_program_state &other)
       m_link_status(false),
       m_verify_status(false),
       m_link_snapshot(false),
+      m_link_snapshot_pending(false),
       m_is_valid(false)
 {
     VOGL_FUNC_TRACER
@@ -137,6 +139,7 @@ vogl_program_state &vogl_program_state::operator=(const vogl_program_state &rhs)
     CPY(m_link_status);
     CPY(m_verify_status);
     CPY(m_link_snapshot);
+    CPY(m_link_snapshot_pending);
 
     CPY(m_is_valid);
 
@@ -150,7 +153,7 @@ vogl_program_state &vogl_program_state::operator=(const vogl_program_state &rhs)
     return *this;
 }
 
-bool vogl_program_state::snapshot_uniforms(const vogl_context_info &context_info, vogl_handle_remapper &remapper)
+bool vogl_program_state::snapshot_uniforms(const vogl_context_info &context_info, vogl_handle_remapper &remapper, const vogl_program_uniform_values *pUniform_values)
 {
     VOGL_FUNC_TRACER
 
@@ -196,10 +199,15 @@ bool vogl_program_state::snapshot_uniforms(const vogl_context_info &context_info
 
         if (uniform.m_base_location != -1)
         {
+            const bool is_array = uniform.m_name.ends_with("]");
+
             for (int element = 0; element < size; element++)
             {
                 uint8 *pDst = &uniform.m_data[element * type_size_in_bytes];
 
+                if ((pUniform_values) && (pUniform_values->get(uniform.m_base_location + element, uniform.m_base_location, is_array, type, pDst, type_size_in_bytes)))
+                    continue;
+
                 if (base_type == GL_FLOAT)
                     GL_ENTRYPOINT(glGetUniformfv)(m_snapshot_handle, uniform.m_base_location + element, (GLfloat *)pDst);
                 else if (base_type == GL_DOUBLE)
@@ -528,6 +536,13 @@ bool vogl_program_state::snapshot(const vogl_context_info &context_info, vogl_ha
 {
     VOGL_FUNC_TRACER
 
+    return snapshot(context_info, remapper, handle, target, NULL);
+}
+
+bool vogl_program_state::snapshot(const vogl_context_info &context_info, vogl_handle_remapper &remapper, GLuint64 handle, GLenum target, const vogl_program_uniform_values *pUniform_values)
+{
+    VOGL_FUNC_TRACER
+
     VOGL_NOTE_UNUSED(context_info);
     VOGL_NOTE_UNUSED(target);
 
@@ -575,7 +590,7 @@ bool vogl_program_state::snapshot(const vogl_context_info &context_info, vogl_ha
         return false;
     }
 
-    if (!snapshot_uniforms(context_info, remapper))
+    if (!snapshot_uniforms(context_info, remapper, pUniform_values))
     {
         clear();
         return false;
@@ -600,7 +615,7 @@ bool vogl_program_state::snapshot(const vogl_context_info &context_info, vogl_ha
     return true;
 }
 
-bool vogl_program_state::link_snapshot(const vogl_context_info &context_info, vogl_handle_remapper &remapper, gl_entrypoint_id_t link_entrypoint, GLuint handle, const void *pBinary, uint binary_size, GLenum binary_format, GLenum type, GLsizei count, GLchar *const *strings)
+bool vogl_program_state::link_snapshot(const vogl_context_info &context_info, vogl_handle_remapper &remapper, gl_entrypoint_id_t link_entrypoint, GLuint handle, const void *pBinary, uint binary_size, GLenum binary_format, GLenum type, GLsizei count, GLchar *const *strings, bool defer_linked_state)
 {
     VOGL_FUNC_TRACER
 
@@ -629,12 +644,6 @@ bool vogl_program_state::link_snapshot(const vogl_context_info &context_info, vo
         return false;
     }
 
-    if (!snapshot_outputs(context_info, remapper, handle))
-    {
-        clear();
-        return false;
-    }
-
     if (linked_using_binary)
         m_program_binary.append(static_cast<const uint8 *>(pBinary), binary_size);
 
@@ -646,25 +655,59 @@ bool vogl_program_state::link_snapshot(const vogl_context_info &context_info, vo
         return false;
     }
 
-    if (!snapshot_active_attribs(context_info, remapper))
+    if (!snapshot_attached_shaders(context_info, remapper, linked_using_binary))
     {
         clear();
         return false;
     }
 
-    if (!snapshot_attached_shaders(context_info, remapper, linked_using_binary))
+    if (!snapshot_shader_objects(context_info, remapper))
     {
         clear();
         return false;
     }
 
-    if (!snapshot_shader_objects(context_info, remapper))
+    if ((m_link_status) && (!m_attached_shaders.size()) && (!linked_using_binary) && (type == GL_NONE))
+    {
+        vogl_error_printf("%s: Program %u was successfully linked, but there are no attached shaders!\n", VOGL_FUNCTION_INFO_CSTR, m_snapshot_handle);
+    }
+
+    // We don't care about the attached shader handles, we've now snapshotted and copied the ACTUAL shaders.
+    m_attached_shaders.clear();
+
+    m_link_snapshot = true;
+    m_link_snapshot_pending = true;
+
+    if (defer_linked_state)
+        return true;
+
+    return complete_link_snapshot(context_info, remapper);
+}
+
+bool vogl_program_state::complete_link_snapshot(const vogl_context_info &context_info, vogl_handle_remapper &remapper)
+{
+    VOGL_FUNC_TRACER
+
+    if (!m_link_snapshot_pending)
+        return m_is_valid;
+
+    VOGL_CHECK_GL_ERROR;
+
+    // Everything captured here is part of the linked program, so it doesn't change until the program is relinked.
+    if (!snapshot_outputs(context_info, remapper, m_snapshot_handle))
+    {
+        clear();
+        return false;
+    }
+
+    if (!snapshot_active_attribs(context_info, remapper))
     {
         clear();
         return false;
     }
 
-    if (!linked_using_binary)
+    // Programs linked from a binary already have it.
+    if (m_program_binary.is_empty())
     {
         if (!snapshot_program_binary(context_info, remapper))
         {
@@ -673,21 +716,13 @@ bool vogl_program_state::link_snapshot(const vogl_context_info &context_info, vo
         }
     }
 
-    if (!snapshot_transform_feedback(context_info, remapper, handle))
+    if (!snapshot_transform_feedback(context_info, remapper, m_snapshot_handle))
     {
         clear();
         return false;
     }
 
-    if ((m_link_status) && (!m_attached_shaders.size()) && (!linked_using_binary) && (type == GL_NONE))
-    {
-        vogl_error_printf("%s: Program %u was successfully linked, but there are no attached shaders!\n", VOGL_FUNCTION_INFO_CSTR, m_snapshot_handle);
-    }
-
-    // We don't care about the attached shader handles, we've now snapshotted and copied the ACTUAL shaders.
-    m_attached_shaders.clear();
-
-    m_link_snapshot = true;
+    m_link_snapshot_pending = false;
     m_is_valid = true;
 
     return true;
@@ -1632,6 +1667,7 @@ void vogl_program_state::clear()
     m_verify_status = false;
 
     m_link_snapshot = false;
+    m_link_snapshot_pending = false;
     m_is_valid = false;
 }
 
@@ -2176,12 +2212,14 @@ bool vogl_program_state::compare_restorable_state(const vogl_gl_object_state &rh
 }
 
 vogl_linked_program_state::vogl_linked_program_state()
+    : m_defer_link_snapshots(false)
 {
     VOGL_FUNC_TRACER
 }
 
 vogl_linked_program_state::vogl_linked_program_state(const vogl_linked_program_state &other)
-    : m_linked_programs(other.m_linked_programs)
+    : m_linked_programs(other.m_linked_programs),
+      m_defer_link_snapshots(other.m_defer_link_snapshots)
 {
     VOGL_FUNC_TRACER
 }
@@ -2199,6 +2237,7 @@ vogl_linked_program_state &vogl_linked_program_state::operator=(const vogl_linke
         return *this;
 
     m_linked_programs = rhs.m_linked_programs;
+    m_defer_link_snapshots = rhs.m_defer_link_snapshots;
 
     return *this;
 }
@@ -2226,7 +2265,7 @@ bool vogl_linked_program_state::add_snapshot(const vogl_context_info &context_in
 
     vogl_program_state &prog = (res.first)->second;
 
-    if (!prog.link_snapshot(context_info, remapper, link_entrypoint, handle, pBinary, binary_size, binary_format, GL_NONE, 0, NULL))
+    if (!prog.link_snapshot(context_info, remapper, link_entrypoint, handle, pBinary, binary_size, binary_format, GL_NONE, 0, NULL, m_defer_link_snapshots))
     {
         m_linked_programs.erase(handle);
         return false;
@@ -2243,7 +2282,7 @@ bool vogl_linked_program_state::add_snapshot(const vogl_context_info &context_in
 
     vogl_program_state &prog = (res.first)->second;
 
-    if (!prog.link_snapshot(context_info, remapper, link_entrypoint, handle, NULL, 0, GL_NONE, type, count, strings))
+    if (!prog.link_snapshot(context_info, remapper, link_entrypoint, handle, NULL, 0, GL_NONE, type, count, strings, m_defer_link_snapshots))
     {
         m_linked_programs.erase(handle);
         return false;
@@ -2259,6 +2298,48 @@ bool vogl_linked_program_state::remove_snapshot(GLuint handle)
     return m_linked_programs.erase(handle);
 }
 
+bool vogl_linked_program_state::complete_deferred_snapshot(const vogl_context_info &context_info, vogl_handle_remapper &remapper, GLuint handle)
+{
+    VOGL_FUNC_TRACER
+
+    vogl_program_state *pProg = m_linked_programs.find_value(handle);
+    if ((!pProg) || (!pProg->is_link_snapshot_pending()))
+        return true;
+
+    if (!pProg->complete_link_snapshot(context_info, remapper))
+    {
+        vogl_error_printf("%s: Failed completing deferred link snapshot of program %u\n", VOGL_FUNCTION_INFO_CSTR, handle);
+        m_linked_programs.erase(handle);
+        return false;
+    }
+
+    return true;
+}
+
+bool vogl_linked_program_state::complete_deferred_snapshots(const vogl_context_info &context_info, vogl_handle_remapper &remapper)
+{
+    VOGL_FUNC_TRACER
+
+    vogl::vector<GLuint> failed_handles;
+
+    for (vogl_program_state_map::iterator it = m_linked_programs.begin(); it != m_linked_programs.end(); ++it)
+    {
+        if (!it->second.is_link_snapshot_pending())
+            continue;
+
+        if (!it->second.complete_link_snapshot(context_info, remapper))
+        {
+            vogl_error_printf("%s: Failed completing deferred link snapshot of program %u\n", VOGL_FUNCTION_INFO_CSTR, it->first);
+            failed_handles.push_back(it->first);
+        }
+    }
+
+    for (uint i = 0; i < failed_handles.size(); i++)
+        m_linked_programs.erase(failed_handles[i]);
+
+    return failed_handles.is_empty();
+}
+
 const vogl_program_state *vogl_linked_program_state::find_snapshot(GLuint handle) const
 {
     VOGL_FUNC_TRACER
@@ -2361,3 +2442,175 @@ bool vogl_linked_program_state::remap_handles(vogl_handle_remapper &remapper)
 
     return true;
 }
+
+vogl_program_uniform_values::vogl_program_uniform_values()
+{
+    VOGL_FUNC_TRACER
+}
+
+void vogl_program_uniform_values::clear()
+{
+    VOGL_FUNC_TRACER
+
+    m_elements.clear();
+    m_data.clear();
+}
+
+void vogl_program_uniform_values::set(GLint location, GLsizei count, GLenum base_type, uint num_components, const void *pValues)
+{
+    VOGL_FUNC_TRACER
+
+    if ((location < 0) || (location >= cMaxLocations) || (count <= 0) || (!pValues))
+        return;
+
+    const uint element_size = num_components * ((base_type == GL_DOUBLE) ? sizeof(GLdouble) : sizeof(GLint));
+    const uint end_location = static_cast<uint>(math::minimum<int64_t>(static_cast<int64_t>(location) + count, cMaxLocations));
+
+    if (m_elements.size() < end_location)
+        m_elements.resize(end_location);
+
+    const uint8 *pSrc = static_cast<const uint8 *>(pValues);
+    for (uint i = location; i < end_location; i++, pSrc += element_size)
+    {
+        element &e = m_elements[i];
+        if (e.m_capacity < element_size)
+        {
+            e.m_ofs = m_data.size();
+            e.m_capacity = element_size;
+            m_data.resize(m_data.size() + element_size);
+        }
+
+        e.m_size = element_size;
+        e.m_base_type = base_type;
+        e.m_write_location = location;
+        e.m_write_count = count;
+        memcpy(&m_data[e.m_ofs], pSrc, element_size);
+    }
+}
+
+void vogl_program_uniform_values::invalidate(GLint location, GLsizei count)
+{
+    VOGL_FUNC_TRACER
+
+    if ((location < 0) || (count <= 0))
+        return;
+
+    const uint end_location = static_cast<uint>(math::minimum<int64_t>(static_cast<int64_t>(location) + count, m_elements.size()));
+    for (uint i = location; i < end_location; i++)
+        m_elements[i].m_size = 0;
+}
+
+bool vogl_program_uniform_values::get(GLint location, GLint base_location, bool is_array, GLenum type, void *pDst, uint dst_size) const
+{
+    VOGL_FUNC_TRACER
+
+    if ((location < 0) || (static_cast<uint>(location) >= m_elements.size()))
+        return false;
+
+    const element &e = m_elements[location];
+    if ((!e.m_size) || (e.m_size != dst_size))
+        return false;
+
+    // GL ignores the part of a write that runs past the end of an array, so the write must have started within this uniform. Only
+    // arrays accept a count above 1, anything else was an INVALID_OPERATION which GL didn't apply.
+    if ((e.m_write_location < base_location) || (e.m_write_location > location))
+        return false;
+    if ((!is_array) && (e.m_write_count > 1))
+        return false;
+
+    const uint8 *pSrc = &m_data[e.m_ofs];
+    const GLenum base_type = static_cast<GLenum>(vogl_gl_get_uniform_base_type(type));
+
+    switch (base_type)
+    {
+        case GL_FLOAT:
+        case GL_DOUBLE:
+        case GL_INT:
+        {
+            if (e.m_base_type != base_type)
+                return false;
+            break;
+        }
+        case GL_UNSIGNED_INT:
+        {
+            // Atomic counters can't be set with glUniform*.
+            if ((e.m_base_type != GL_UNSIGNED_INT) || (type == GL_UNSIGNED_INT_ATOMIC_COUNTER))
+                return false;
+            break;
+        }
+        case GL_SAMPLER:
+        case GL_IMAGE_1D:
+        {
+            // Sampler and image units are only settable with glUniform1i{v}.
+            if (e.m_base_type != GL_INT)
+                return false;
+            break;
+        }
+        case GL_BOOL:
+        {
+            // Booleans can be set with any of the float, int or uint variants, and read back as 0 or 1.
+            if ((e.m_base_type != GL_FLOAT) && (e.m_base_type != GL_INT) && (e.m_base_type != GL_UNSIGNED_INT))
+                return false;
+
+            GLint *pDst_bools = static_cast<GLint *>(pDst);
+            for (uint i = 0; i < dst_size / sizeof(GLint); i++)
+            {
+                if (e.m_base_type == GL_FLOAT)
+                    pDst_bools[i] = reinterpret_cast<const GLfloat *>(pSrc)[i] != 0.0f;
+                else
+                    pDst_bools[i] = reinterpret_cast<const GLuint *>(pSrc)[i] != 0;
+            }
+            return true;
+        }
+        default:
+            return false;
+    }
+
+    memcpy(pDst, pSrc, dst_size);
+    return true;
+}
+
+vogl_uniform_value_shadow::vogl_uniform_value_shadow()
+{
+    VOGL_FUNC_TRACER
+}
+
+void vogl_uniform_value_shadow::clear()
+{
+    VOGL_FUNC_TRACER
+
+    m_programs.clear();
+}
+
+void vogl_uniform_value_shadow::set(GLuint program, GLint location, GLsizei count, GLenum base_type, uint num_components, const void *pValues)
+{
+    VOGL_FUNC_TRACER
+
+    if ((!program) || (location < 0))
+        return;
+
+    m_programs[program].set(location, count, base_type, num_components, pValues);
+}
+
+void vogl_uniform_value_shadow::invalidate(GLuint program, GLint location, GLsizei count)
+{
+    VOGL_FUNC_TRACER
+
+    vogl_program_uniform_values *pValues = m_programs.find_value(program);
+    if (pValues)
+        pValues->invalidate(location, count);
+}
+
+void vogl_uniform_value_shadow::remove_program(GLuint program)
+{
+    VOGL_FUNC_TRACER
+
+    m_programs.erase(program);
+}
+
+const vogl_program_uniform_values *vogl_uniform_value_shadow::find(GLuint program) const
+{
+    VOGL_FUNC_TRACER
+
+    return m_programs.find_value(program);
+}
@@ -31,6 +31,7 @@
 #include "vogl_dynamic_string.h"
 #include "vogl_json.h"
 #include "vogl_map.h"
+#include "vogl_hash_map.h"
 #include "vogl_unique_ptr.h"
 
 #include "vogl_general_context_state.h"
@@ -184,6 +185,82 @@ struct vogl_program_transform_feedback_varying
 
 typedef vogl::vector<vogl_program_transform_feedback_varying> vogl_program_transform_feedback_varying_vec;
 
+//----------------------------------------------------------------------------------------------------------------------
+// class vogl_program_uniform_values
+// Shadow of the values written to a single program's uniforms by glUniform*/glProgramUniform*, indexed by location. Program
+// snapshots read uniforms from here instead of issuing one glGetUniform*() per array element, and only fall back to GL for
+// locations the shadow can't vouch for (never written, written with a different type or size, transposed matrices, etc.).
+//----------------------------------------------------------------------------------------------------------------------
+class vogl_program_uniform_values
+{
+public:
+    // Locations at or above this aren't shadowed (GL_MAX_UNIFORM_LOCATIONS is typically 1024-4096).
+    enum
+    {
+        cMaxLocations = 65536
+    };
+
+    vogl_program_uniform_values();
+
+    void clear();
+
+    // Records count consecutive elements starting at location, each holding num_components values of base_type
+    // (GL_FLOAT, GL_DOUBLE, GL_INT or GL_UNSIGNED_INT).
+    void set(GLint location, GLsizei count, GLenum base_type, uint num_components, const void *pValues);
+
+    // Forgets count elements starting at location.
+    void invalidate(GLint location, GLsizei count);
+
+    // Copies the shadowed value of the element at location, which belongs to the uniform at base_location of the given type, into pDst
+    // in the layout glGetUniform*() would return. Returns false if the shadow can't vouch for the element.
+    bool get(GLint location, GLint base_location, bool is_array, GLenum type, void *pDst, uint dst_size) const;
+
+private:
+    struct element
+    {
+        element()
+            : m_ofs(0), m_capacity(0), m_size(0), m_base_type(GL_NONE), m_write_location(-1), m_write_count(0)
+        {
+        }
+
+        // Offset and size of this element's storage in m_data. m_size is 0 if the element isn't shadowed.
+        uint m_ofs;
+        uint m_capacity;
+        uint m_size;
+        GLenum m_base_type;
+
+        // First location and count of the call that last wrote this element.
+        GLint m_write_location;
+        GLsizei m_write_count;
+    };
+
+    vogl::vector<element> m_elements;
+    uint8_vec m_data;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+// class vogl_uniform_value_shadow
+// Per-program uniform value shadows, keyed by GL program handle. A program's values must be removed whenever it's (re)linked or
+// deleted, because linking resets uniforms and may reassign locations.
+//----------------------------------------------------------------------------------------------------------------------
+class vogl_uniform_value_shadow
+{
+public:
+    vogl_uniform_value_shadow();
+
+    void clear();
+
+    void set(GLuint program, GLint location, GLsizei count, GLenum base_type, uint num_components, const void *pValues);
+    void invalidate(GLuint program, GLint location, GLsizei count);
+    void remove_program(GLuint program);
+
+    const vogl_program_uniform_values *find(GLuint program) const;
+
+private:
+    typedef vogl::hash_map<GLuint, vogl_program_uniform_values> program_values_map;
+    program_values_map m_programs;
+};
+
 class vogl_program_state : public vogl_gl_object_state
 {
 public:
@@ -204,6 +281,9 @@ public:
 
     virtual bool snapshot(const vogl_context_info &context_info, vogl_handle_remapper &remapper, GLuint64 handle, GLenum target);
 
+    // pUniform_values may be NULL, in which case every uniform element is read back from GL.
+    bool snapshot(const vogl_context_info &context_info, vogl_handle_remapper &remapper, GLuint64 handle, GLenum target, const vogl_program_uniform_values *pUniform_values);
+
     virtual bool restore(const vogl_context_info &context_info, vogl_handle_remapper &remapper, GLuint64 &handle) const;
 
     virtual bool remap_handles(vogl_handle_remapper &remapper);
@@ -235,7 +315,17 @@ public:
         return m_info_log;
     }
 
-    bool link_snapshot(const vogl_context_info &context_info, vogl_handle_remapper &remapper, gl_entrypoint_id_t link_entrypoint, GLuint handle, const void *pBinary = NULL, uint binary_size = 0, GLenum binary_format = GL_NONE, GLenum type = GL_NONE, GLsizei count = 0, GLchar *const *strings = NULL);
+    // If defer_linked_state is true only the link's inputs (attached shaders, sources, binary, info log) are captured now. The linked
+    // program's introspected state (attribs, outputs, program binary, transform feedback varyings) is captured by a later call to
+    // complete_link_snapshot(), which must happen before the program is relinked or deleted.
+    bool link_snapshot(const vogl_context_info &context_info, vogl_handle_remapper &remapper, gl_entrypoint_id_t link_entrypoint, GLuint handle, const void *pBinary = NULL, uint binary_size = 0, GLenum binary_format = GL_NONE, GLenum type = GL_NONE, GLsizei count = 0, GLchar *const *strings = NULL, bool defer_linked_state = false);
+
+    bool is_link_snapshot_pending() const
+    {
+        return m_link_snapshot_pending;
+    }
+
+    bool complete_link_snapshot(const vogl_context_info &context_info, vogl_handle_remapper &remapper);
 
     void set_link_time_snapshot(vogl_unique_ptr<vogl_program_state> &pSnapshot);
 
@@ -386,10 +476,11 @@ private:
     bool m_link_status;
     bool m_verify_status;
     bool m_link_snapshot;
+    bool m_link_snapshot_pending;
 
     bool m_is_valid;
 
-    bool snapshot_uniforms(const vogl_context_info &context_info, vogl_handle_remapper &remapper);
+    bool snapshot_uniforms(const vogl_context_info &context_info, vogl_handle_remapper &remapper, const vogl_program_uniform_values *pUniform_values);
     bool snapshot_uniform_blocks(const vogl_context_info &context_info, vogl_handle_remapper &remapper);
     bool snapshot_active_attribs(const vogl_context_info &context_info, vogl_handle_remapper &remapper);
     bool snapshot_attached_shaders(const vogl_context_info &context_info, vogl_handle_remapper &remapper, bool linked_using_binary);
@@ -421,11 +512,28 @@ public:
 
     void clear();
 
+    // When enabled, link snapshots only capture the link's inputs at link time and the rest is captured by
+    // complete_deferred_snapshot(s)(), so programs that are never snapshotted don't pay for full introspection.
+    void set_defer_link_snapshots(bool defer)
+    {
+        m_defer_link_snapshots = defer;
+    }
+
+    bool get_defer_link_snapshots() const
+    {
+        return m_defer_link_snapshots;
+    }
+
     bool add_snapshot(GLuint handle, const vogl_program_state &prog);
     bool add_snapshot(const vogl_context_info &context_info, vogl_handle_remapper &remapper, gl_entrypoint_id_t link_entrypoint, GLuint handle, GLenum binary_format = GL_NONE, const void *pBinary = NULL, uint binary_size = 0);
     bool add_snapshot(const vogl_context_info &context_info, vogl_handle_remapper &remapper, gl_entrypoint_id_t link_entrypoint, GLuint handle, GLenum type, GLsizei count, GLchar *const *strings);
     bool remove_snapshot(GLuint handle);
 
+    // Finishes a deferred link snapshot. Must be called with a context from the program's share group current, before the program is
+    // relinked. Snapshots that can't be completed are removed.
+    bool complete_deferred_snapshot(const vogl_context_info &context_info, vogl_handle_remapper &remapper, GLuint handle);
+    bool complete_deferred_snapshots(const vogl_context_info &context_info, vogl_handle_remapper &remapper);
+
     const vogl_program_state *find_snapshot(GLuint handle) const;
     vogl_program_state *find_snapshot(GLuint handle);
 
@@ -446,6 +554,7 @@ public:
 
 private:
     vogl_program_state_map m_linked_programs;
+    bool m_defer_link_snapshots;
 };
 
 #endif // VOGL_PROGRAM_STATE_H
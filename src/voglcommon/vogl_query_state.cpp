@@ -30,6 +30,8 @@ vogl_query_state::vogl_query_state()
     : m_snapshot_handle(0),
       m_target(GL_NONE),
       m_prev_result(0),
+      m_get_result_status(GL_NONE),
+      m_result_status(cResultNone),
       m_has_been_begun(false),
       m_is_valid(false)
 {
@@ -56,29 +58,78 @@ bool vogl_query_state::snapshot(const vogl_context_info &context_info, vogl_hand
     m_target = target;
     m_has_been_begun = GL_ENTRYPOINT(glIsQuery)(static_cast<GLuint>(handle)) != 0;
 
-    if (target != GL_NONE)
+    if ((target != GL_NONE) && (m_has_been_begun))
     {
-        if (context_info.supports_extension("GL_ARB_timer_query") && GL_ENTRYPOINT(glGetQueryObjecti64v))
+        // Querying the result of the active query is an error, so check that first.
+        GLuint active_query = 0;
+        GL_ENTRYPOINT(glGetQueryiv)(target, GL_CURRENT_QUERY, reinterpret_cast<GLint *>(&active_query));
+        VOGL_CHECK_GL_ERROR;
+
+        if (active_query == m_snapshot_handle)
         {
-            GLint64 result = 0;
-            GL_ENTRYPOINT(glGetQueryObjecti64v)(m_snapshot_handle, GL_QUERY_RESULT, &result);
-            m_prev_result = result;
+            m_result_status = cResultActive;
         }
         else
         {
-            GLuint prev_result32;
-            GL_ENTRYPOINT(glGetQueryObjectuiv)(m_snapshot_handle, GL_QUERY_RESULT, &prev_result32);
-            m_prev_result = prev_result32;
+            // GL_QUERY_RESULT would stall until the GPU catches up, so only read it once GL_QUERY_RESULT_AVAILABLE says it's there.
+            GLuint available = GL_FALSE;
+            GL_ENTRYPOINT(glGetQueryObjectuiv)(m_snapshot_handle, GL_QUERY_RESULT_AVAILABLE, &available);
+
+            if (vogl_check_gl_error())
+                m_result_status = cResultNone;
+            else if (!available)
+                m_result_status = cResultPending;
+            else
+            {
+                if (context_info.supports_extension("GL_ARB_timer_query") && GL_ENTRYPOINT(glGetQueryObjecti64v))
+                {
+                    GLint64 result = 0;
+                    GL_ENTRYPOINT(glGetQueryObjecti64v)(m_snapshot_handle, GL_QUERY_RESULT, &result);
+                    m_prev_result = result;
+                }
+                else
+                {
+                    GLuint prev_result32;
+                    GL_ENTRYPOINT(glGetQueryObjectuiv)(m_snapshot_handle, GL_QUERY_RESULT, &prev_result32);
+                    m_prev_result = prev_result32;
+                }
+
+                m_result_status = cResultAvailable;
+            }
         }
     }
 
     m_get_result_status = vogl_check_gl_error();
+    if (m_get_result_status)
+        m_result_status = cResultNone;
 
     m_is_valid = true;
 
     return true;
 }
 
+const char *vogl_query_state::get_result_status_str(result_status_t status)
+{
+    VOGL_FUNC_TRACER
+
+    switch (status)
+    {
+        case cResultNone:
+            return "none";
+        case cResultAvailable:
+            return "available";
+        case cResultPending:
+            return "pending";
+        case cResultActive:
+            return "active";
+        default:
+            VOGL_ASSERT_ALWAYS;
+            break;
+    }
+
+    return "none";
+}
+
 bool vogl_query_state::restore(const vogl_context_info &context_info, vogl_handle_remapper &remapper, GLuint64 &handle) const
 {
     VOGL_FUNC_TRACER
@@ -113,23 +164,35 @@ bool vogl_query_state::restore(const vogl_context_info &context_info, vogl_handl
 
         VOGL_ASSERT(handle <= cUINT32_MAX);
 
-        // Begin end the restore query, so it becomes a valid name.
-        GL_ENTRYPOINT(glBeginQuery)(m_target, static_cast<GLuint>(handle));
-        if (vogl_check_gl_error())
-            goto handle_error;
+        // Only one query can be active on a target, so end whichever query an earlier restore left active.
+        if (prev_query)
+        {
+            if (m_result_status == cResultActive)
+                vogl_warning_printf("%s: Query %u and query %u were both captured as active on target %s, only the latter will be left active\n", VOGL_FUNCTION_INFO_CSTR, prev_query, static_cast<GLuint>(handle), get_gl_enums().find_gl_name(m_target));
 
-        GL_ENTRYPOINT(glEndQuery)(m_target);
+            GL_ENTRYPOINT(glEndQuery)(m_target);
+            VOGL_CHECK_GL_ERROR;
+        }
+
+        // Begin the restore query so it becomes a valid name. An active query is left running so the trace's
+        // glEndQuery() still has something to end. Otherwise end it right away: a pending or available result becomes
+        // the replay's own result once the GPU gets to it.
+        GL_ENTRYPOINT(glBeginQuery)(m_target, static_cast<GLuint>(handle));
         if (vogl_check_gl_error())
             goto handle_error;
 
-        if (prev_query)
+        if (m_result_status != cResultActive)
         {
-            // Now begin/end the original query so it's active again. The query API sucks.
-            GL_ENTRYPOINT(glBeginQuery)(m_target, prev_query);
-            VOGL_CHECK_GL_ERROR;
-
             GL_ENTRYPOINT(glEndQuery)(m_target);
-            VOGL_CHECK_GL_ERROR;
+            if (vogl_check_gl_error())
+                goto handle_error;
+
+            if (prev_query)
+            {
+                // Now begin the original query so it's active again. The query API sucks.
+                GL_ENTRYPOINT(glBeginQuery)(m_target, prev_query);
+                VOGL_CHECK_GL_ERROR;
+            }
         }
     }
 
@@ -170,6 +233,7 @@ void vogl_query_state::clear()
     m_target = GL_NONE;
     m_prev_result = 0;
     m_get_result_status = GL_NONE;
+    m_result_status = cResultNone;
     m_has_been_begun = false;
     m_is_valid = false;
 }
@@ -186,6 +250,7 @@ bool vogl_query_state::serialize(json_node &node, vogl_blob_manager &blob_manage
     node.add_key_value("handle", m_snapshot_handle);
     node.add_key_value("target", get_gl_enums().find_name(m_target, "gl"));
     node.add_key_value("prev_result", m_prev_result);
+    node.add_key_value("result_status", get_result_status_str(m_result_status));
     node.add_key_value("has_been_begun", m_has_been_begun);
 
     return true;
@@ -215,6 +280,26 @@ bool vogl_query_state::deserialize(const json_node &node, const vogl_blob_manage
     m_prev_result = node.value_as_int64("prev_result");
     m_has_been_begun = node.value_as_bool("has_been_begun");
 
+    // Older snapshots always waited for the result.
+    m_result_status = m_has_been_begun ? cResultAvailable : cResultNone;
+    if (node.has_key("result_status"))
+    {
+        dynamic_string status_str(node.value_as_string("result_status"));
+
+        uint i;
+        for (i = 0; i <= cResultActive; i++)
+            if (status_str == get_result_status_str(static_cast<result_status_t>(i)))
+                break;
+
+        if (i > cResultActive)
+        {
+            clear();
+            return false;
+        }
+
+        m_result_status = static_cast<result_status_t>(i);
+    }
+
     m_is_valid = true;
 
     return true;
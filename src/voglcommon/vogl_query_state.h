@@ -38,6 +38,17 @@
 class vogl_query_state : public vogl_gl_object_state
 {
 public:
+    // Snapshotting never waits on the GPU for a query's result. If the result isn't available yet it's recorded as
+    // pending, and restore() just begins/ends the restored query so the replay's own result becomes available later.
+    // A query captured while active is begun by restore() and left active.
+    enum result_status_t
+    {
+        cResultNone,      // never begun, or the result couldn't be read
+        cResultAvailable, // m_prev_result holds the result
+        cResultPending,   // ended, but the GPU hadn't produced the result yet
+        cResultActive     // currently active on its target, so there's no result to read
+    };
+
     vogl_query_state();
     virtual ~vogl_query_state();
 
@@ -53,7 +64,7 @@ public:
     // Target must be supplied by the caller, we can't determine it via normal GL calls.
     virtual bool snapshot(const vogl_context_info &context_info, vogl_handle_remapper &remapper, GLuint64 handle, GLenum target);
 
-    // restore() tries to restore the previously bound query on target, but it must begin/end it to do so.
+    // restore() tries to keep the previously active query on target active, but it must end and re-begin it to do so.
     virtual bool restore(const vogl_context_info &context_info, vogl_handle_remapper &remapper, GLuint64 &handle) const;
 
     virtual bool remap_handles(vogl_handle_remapper &remapper);
@@ -80,6 +91,13 @@ public:
         return m_prev_result;
     }
 
+    result_status_t get_result_status() const
+    {
+        return m_result_status;
+    }
+
+    static const char *get_result_status_str(result_status_t status);
+
     virtual bool is_valid() const
     {
         return m_is_valid;
@@ -92,6 +110,7 @@ private:
 
     int64_t m_prev_result;
     GLenum m_get_result_status;
+    result_status_t m_result_status;
 
     bool m_has_been_begun;
 
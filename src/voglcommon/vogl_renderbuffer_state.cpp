@@ -258,6 +258,7 @@ bool vogl_renderbuffer_desc::get_int(GLenum enum_val, int *pVals, uint n) const
 
 vogl_renderbuffer_state::vogl_renderbuffer_state()
     : m_snapshot_handle(0),
+      m_readback_tex_handle(0),
       m_is_valid(false)
 {
     VOGL_FUNC_TRACER
@@ -274,6 +275,16 @@ bool vogl_renderbuffer_state::snapshot(const vogl_context_info &context_info, vo
 {
     VOGL_FUNC_TRACER
 
+    if (!begin_snapshot(context_info, remapper, handle, target, NULL))
+        return false;
+
+    return end_snapshot(context_info, NULL);
+}
+
+bool vogl_renderbuffer_state::begin_snapshot(const vogl_context_info &context_info, vogl_handle_remapper &remapper, GLuint64 handle, GLenum target, vogl_texture_readback_queue *pReadbacks)
+{
+    VOGL_FUNC_TRACER
+
     VOGL_NOTE_UNUSED(remapper);
     VOGL_ASSERT(context_info.get_version() >= VOGL_GL_VERSION_3_0);
     VOGL_CHECK_GL_ERROR;
@@ -412,11 +423,7 @@ bool vogl_renderbuffer_state::snapshot(const vogl_context_info &context_info, vo
                         GL_NEAREST);
 
                     if (!vogl_check_gl_error_internal())
-                    {
-                        vogl_handle_remapper def_handle_remapper;
-                        if (m_texture.snapshot(context_info, def_handle_remapper, tex_handle, tex_target))
-                            capture_status = true;
-                    }
+                        capture_status = true;
                 }
 
                 // Delete FBO
@@ -436,14 +443,36 @@ bool vogl_renderbuffer_state::snapshot(const vogl_context_info &context_info, vo
             GL_ENTRYPOINT(glBindTexture)(tex_target, 0);
             VOGL_CHECK_GL_ERROR;
 
-            GL_ENTRYPOINT(glDeleteTextures)(1, &tex_handle);
-            VOGL_CHECK_GL_ERROR;
+            if (capture_status)
+            {
+                // Keep the texture until end_snapshot() reads it back.
+                m_readback_tex_handle = tex_handle;
+            }
+            else
+            {
+                GL_ENTRYPOINT(glDeleteTextures)(1, &tex_handle);
+                VOGL_CHECK_GL_ERROR;
+            }
         }
 
         if (!capture_status)
         {
             vogl_error_printf("%s: Failed blitting renderbuffer data to texture for renderbuffer %" PRIu64 "\n", VOGL_FUNCTION_INFO_CSTR, static_cast<uint64_t>(handle));
         }
+        else if (pReadbacks)
+        {
+            vogl_scoped_state_saver pixelstore_state_saver(cGSTPixelStore);
+
+            vogl_scoped_state_saver pixeltransfer_state_saver;
+            if (!context_info.is_core_profile())
+                pixeltransfer_state_saver.save(cGSTPixelTransfer);
+
+            vogl_reset_pixel_store_states();
+            if (!context_info.is_core_profile())
+                vogl_reset_pixel_transfer_states();
+
+            pReadbacks->queue(context_info, m_readback_tex_handle, tex_target);
+        }
     }
 
     m_is_valid = true;
@@ -451,6 +480,29 @@ bool vogl_renderbuffer_state::snapshot(const vogl_context_info &context_info, vo
     return true;
 }
 
+bool vogl_renderbuffer_state::end_snapshot(const vogl_context_info &context_info, vogl_texture_readback_queue *pReadbacks)
+{
+    VOGL_FUNC_TRACER
+
+    if (!m_readback_tex_handle)
+        return m_is_valid;
+
+    const GLenum tex_target = (m_desc.m_samples > 1) ? GL_TEXTURE_2D_MULTISAMPLE : GL_TEXTURE_2D;
+
+    vogl_handle_remapper def_handle_remapper;
+    if (!m_texture.snapshot(context_info, def_handle_remapper, m_readback_tex_handle, tex_target, false, pReadbacks))
+    {
+        vogl_error_printf("%s: Failed reading back renderbuffer data for renderbuffer %" PRIu64 "\n", VOGL_FUNCTION_INFO_CSTR, static_cast<uint64_t>(m_snapshot_handle));
+    }
+
+    GL_ENTRYPOINT(glDeleteTextures)(1, &m_readback_tex_handle);
+    VOGL_CHECK_GL_ERROR;
+
+    m_readback_tex_handle = 0;
+
+    return m_is_valid;
+}
+
 bool vogl_renderbuffer_state::restore(const vogl_context_info &context_info, vogl_handle_remapper &remapper, GLuint64 &handle) const
 {
     VOGL_FUNC_TRACER
@@ -669,6 +721,15 @@ void vogl_renderbuffer_state::clear()
 
     m_snapshot_handle = 0;
 
+    // Only left over if end_snapshot() was never called.
+    if (m_readback_tex_handle)
+    {
+        GL_ENTRYPOINT(glDeleteTextures)(1, &m_readback_tex_handle);
+        VOGL_CHECK_GL_ERROR;
+
+        m_readback_tex_handle = 0;
+    }
+
     m_desc.clear();
     m_texture.clear();
 
@@ -93,6 +93,12 @@ public:
 
     virtual bool snapshot(const vogl_context_info &context_info, vogl_handle_remapper &remapper, GLuint64 handle, GLenum target);
 
+    // snapshot() in two steps, so the contents of many renderbuffers can be read back without waiting on the GPU for each one:
+    // begin_snapshot() blits the renderbuffer into a temporary texture and (if pReadbacks isn't NULL) queues its readback.
+    // end_snapshot() captures the texture, using the queued readback if there is one, and deletes the temporary texture.
+    bool begin_snapshot(const vogl_context_info &context_info, vogl_handle_remapper &remapper, GLuint64 handle, GLenum target, vogl_texture_readback_queue *pReadbacks);
+    bool end_snapshot(const vogl_context_info &context_info, vogl_texture_readback_queue *pReadbacks);
+
     virtual bool restore(const vogl_context_info &context_info, vogl_handle_remapper &remapper, GLuint64 &handle) const;
 
     virtual bool remap_handles(vogl_handle_remapper &remapper);
@@ -127,6 +133,9 @@ private:
     vogl_renderbuffer_desc m_desc;
     vogl_texture_state m_texture;
 
+    // Temporary texture the renderbuffer was blitted into, between begin_snapshot() and end_snapshot().
+    GLuint m_readback_tex_handle;
+
     bool m_is_valid;
 };
 
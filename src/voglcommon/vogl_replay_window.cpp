@@ -31,6 +31,10 @@ vogl_replay_window::vogl_replay_window()
       m_win((Window)NULL),
       m_width(0),
       m_height(0),
+      m_window_width(0),
+      m_window_height(0),
+      m_offscreen(false),
+      m_pbuffer((GLXPbuffer)NULL),
       m_pFB_configs(NULL),
       m_num_fb_configs(0)
 {
@@ -44,7 +48,7 @@ vogl_replay_window::~vogl_replay_window()
     close();
 }
 
-bool vogl_replay_window::open(int width, int height, int samples)
+bool vogl_replay_window::open(int width, int height, int samples, bool offscreen)
 {
     VOGL_FUNC_TRACER
     #if (VOGL_PLATFORM_HAS_GLX)
@@ -54,6 +58,12 @@ bool vogl_replay_window::open(int width, int height, int samples)
         if (!check_glx_version())
             return false;
 
+        if ((offscreen) && ((!GL_ENTRYPOINT(glXCreatePbuffer)) || (!GL_ENTRYPOINT(glXDestroyPbuffer))))
+        {
+            console::error("%s: Offscreen rendering requires glXCreatePbuffer()!\n", VOGL_FUNCTION_INFO_CSTR);
+            return false;
+        }
+
         // TODO: These attribs (especially the sizes) should be passed in by the caller!
         int fbAttribs[64];
 
@@ -61,7 +71,7 @@ bool vogl_replay_window::open(int width, int height, int samples)
 
         *pAttribs++ = GLX_RENDER_TYPE;      *pAttribs++ = GLX_RGBA_BIT;
         *pAttribs++ = GLX_X_RENDERABLE;     *pAttribs++ = True;
-        *pAttribs++ = GLX_DRAWABLE_TYPE;    *pAttribs++ = GLX_WINDOW_BIT;
+        *pAttribs++ = GLX_DRAWABLE_TYPE;    *pAttribs++ = offscreen ? (GLX_WINDOW_BIT | GLX_PBUFFER_BIT) : GLX_WINDOW_BIT;
         *pAttribs++ = GLX_DOUBLEBUFFER;     *pAttribs++ = True;
         *pAttribs++ = GLX_RED_SIZE;         *pAttribs++ = 8;
         *pAttribs++ = GLX_BLUE_SIZE;        *pAttribs++ = 8;
@@ -141,10 +151,23 @@ bool vogl_replay_window::open(int width, int height, int samples)
 
         m_width = width;
         m_height = height;
+        m_window_width = width;
+        m_window_height = height;
+
+        if (offscreen)
+        {
+            m_offscreen = true;
+
+            if (!create_pbuffer(width, height))
+            {
+                close();
+                return false;
+            }
+        }
 
         uint actual_width = 0, actual_height = 0;
         vogl_replay_window::get_actual_dimensions(actual_width, actual_height);
-        vogl_debug_printf("%s: Created window, requested dimensions %ux%u, actual dimensions %ux%u\n", VOGL_FUNCTION_INFO_CSTR, m_width, m_height, actual_width, actual_height);
+        vogl_debug_printf("%s: Created %s, requested dimensions %ux%u, actual dimensions %ux%u\n", VOGL_FUNCTION_INFO_CSTR, m_offscreen ? "offscreen pbuffer" : "window", m_width, m_height, actual_width, actual_height);
 
         return true;
     #else
@@ -173,11 +196,16 @@ bool vogl_replay_window::resize(int new_width, int new_height)
     #if (VOGL_PLATFORM_HAS_GLX)
 
         if (!is_opened())
-            return open(new_width, new_height);
+            return open(new_width, new_height, 1, m_offscreen);
 
         if ((new_width == m_width) && (new_height == m_height))
             return true;
 
+        // The window keeps its size, only the pbuffer gets recreated. The old pbuffer is destroyed once it's no longer
+        // current, so callers must make their context current on get_drawable() again.
+        if (m_offscreen)
+            return create_pbuffer(new_width, new_height);
+
         XSizeHints sh;
         utils::zero_object(sh);
         sh.width = sh.min_width = sh.max_width = sh.base_width = new_width;
@@ -210,7 +238,7 @@ void vogl_replay_window::clear_window()
         if (!m_dpy)
             return;
 
-        XFillRectangle(m_dpy, m_win, DefaultGC(m_dpy, DefaultScreen(m_dpy)), 0, 0, m_width, m_height);
+        XFillRectangle(m_dpy, m_win, DefaultGC(m_dpy, DefaultScreen(m_dpy)), 0, 0, get_window_width(), get_window_height());
     #else
         VOGL_ASSERT(!"impl");
     #endif
@@ -221,6 +249,12 @@ void vogl_replay_window::close()
     VOGL_FUNC_TRACER
     #if (VOGL_PLATFORM_HAS_GLX)
 
+        if (m_pbuffer)
+        {
+            GL_ENTRYPOINT(glXDestroyPbuffer)(m_dpy, m_pbuffer);
+            m_pbuffer = (GLXPbuffer)NULL;
+        }
+
         if (m_win)
         {
             XDestroyWindow(m_dpy, m_win);
@@ -235,6 +269,9 @@ void vogl_replay_window::close()
 
         m_width = 0;
         m_height = 0;
+        m_window_width = 0;
+        m_window_height = 0;
+        m_offscreen = false;
     #else
         VOGL_ASSERT(!"impl");
     #endif
@@ -259,6 +296,14 @@ bool vogl_replay_window::get_actual_dimensions(uint &width, uint &height) const
 {
     VOGL_FUNC_TRACER
     #if (VOGL_PLATFORM_HAS_GLX)
+        // The pbuffer is created with exactly the requested size, there's nothing to wait for.
+        if (m_offscreen)
+        {
+            width = m_width;
+            height = m_height;
+            return m_pbuffer != (GLXPbuffer)NULL;
+        }
+
         Window root;
         int x, y;
         unsigned int border_width, depth;
@@ -268,6 +313,40 @@ bool vogl_replay_window::get_actual_dimensions(uint &width, uint &height) const
     #endif
 }
 
+bool vogl_replay_window::create_pbuffer(int width, int height)
+{
+    VOGL_FUNC_TRACER
+    #if (VOGL_PLATFORM_HAS_GLX)
+        int pbuffer_attribs[] =
+        {
+            GLX_PBUFFER_WIDTH, width,
+            GLX_PBUFFER_HEIGHT, height,
+            GLX_PRESERVED_CONTENTS, True,
+            GLX_LARGEST_PBUFFER, False,
+            0
+        };
+
+        GLXPbuffer pbuffer = GL_ENTRYPOINT(glXCreatePbuffer)(m_dpy, m_pFB_configs[0], pbuffer_attribs);
+        if (!pbuffer)
+        {
+            console::error("%s: glXCreatePbuffer() failed creating %ix%i pbuffer!\n", VOGL_FUNCTION_INFO_CSTR, width, height);
+            return false;
+        }
+
+        if (m_pbuffer)
+            GL_ENTRYPOINT(glXDestroyPbuffer)(m_dpy, m_pbuffer);
+
+        m_pbuffer = pbuffer;
+        m_width = width;
+        m_height = height;
+
+        return true;
+    #else
+        VOGL_ASSERT(!"impl");
+        return false;
+    #endif
+}
+
 bool vogl_replay_window::check_glx_version()
 {
     VOGL_FUNC_TRACER
@@ -44,7 +44,9 @@ public:
         return (m_width > 0) && (m_dpy != NULL);
     }
 
-    bool open(int width, int height, int samples = 1);
+    // If offscreen is true, the window is only used for presentation and events: rendering goes to a pbuffer (returned by
+    // get_drawable()) which is resized synchronously, without touching the window.
+    bool open(int width, int height, int samples = 1, bool offscreen = false);
 
     void set_title(const char *pTitle);
 
@@ -62,6 +64,23 @@ public:
     {
         return m_win;
     }
+    inline bool is_offscreen() const
+    {
+        return m_offscreen;
+    }
+    // The drawable the replayer should render to: the pbuffer when offscreen, otherwise the window.
+    inline GLXDrawable get_drawable() const
+    {
+        return m_offscreen ? m_pbuffer : m_win;
+    }
+    inline int get_window_width() const
+    {
+        return m_offscreen ? m_window_width : m_width;
+    }
+    inline int get_window_height() const
+    {
+        return m_offscreen ? m_window_height : m_height;
+    }
     inline int get_width() const
     {
         return m_width;
@@ -90,10 +109,18 @@ private:
     int m_width;
     int m_height;
 
+    // The window's own (fixed) dimensions when offscreen, m_width/m_height are then the pbuffer's.
+    int m_window_width;
+    int m_window_height;
+
+    bool m_offscreen;
+    GLXPbuffer m_pbuffer;
+
     GLXFBConfig *m_pFB_configs;
     int m_num_fb_configs;
 
     bool check_glx_version();
+    bool create_pbuffer(int width, int height);
 };
 
 #endif // VOGL_REPLAY_WINDOW_H
@@ -110,7 +110,7 @@ bool vogl_sampler_state::snapshot(const vogl_context_info &context_info, vogl_ha
     return true;
 }
 
-bool vogl_sampler_state::set_sampler_parameter(GLuint handle, GLenum pname) const
+bool vogl_sampler_state::set_sampler_parameter(GLuint handle, GLenum pname, bool skip_if_default) const
 {
     VOGL_FUNC_TRACER
 
@@ -128,6 +128,15 @@ bool vogl_sampler_state::set_sampler_parameter(GLuint handle, GLenum pname) cons
         return false;
     }
 
+    if (skip_if_default)
+    {
+        // New sampler objects start out with the GL defaults, so skip params that already match.
+        float default_vals[4];
+        const uint num_defaults = vogl_get_default_tex_parameter(GL_NONE, pname, default_vals);
+        if (vogl_state_data_matches_defaults(*pData, default_vals, num_defaults))
+            return true;
+    }
+
     if ((pData->get_data_type() == cSTFloat) || (pData->get_data_type() == cSTDouble))
     {
         float fvals[cMaxElements];
@@ -159,6 +168,8 @@ bool vogl_sampler_state::restore(const vogl_context_info &context_info, vogl_han
 
     VOGL_CHECK_GL_ERROR;
 
+    bool created_handle = false;
+
     if (!handle)
     {
         GLuint handle32 = 0;
@@ -169,21 +180,23 @@ bool vogl_sampler_state::restore(const vogl_context_info &context_info, vogl_han
 
         remapper.declare_handle(VOGL_NAMESPACE_SAMPLERS, m_snapshot_handle, handle, GL_NONE);
         VOGL_ASSERT(remapper.remap_handle(VOGL_NAMESPACE_SAMPLERS, m_snapshot_handle) == handle);
+
+        created_handle = true;
     }
 
     bool any_failures = false;
 
-#define SET_INT(pname)                                                  \
-    do                                                                  \
-    {                                                                   \
-        if (!set_sampler_parameter(static_cast<GLuint>(handle), pname)) \
-            any_failures = true;                                        \
+#define SET_INT(pname)                                                                  \
+    do                                                                                  \
+    {                                                                                   \
+        if (!set_sampler_parameter(static_cast<GLuint>(handle), pname, created_handle)) \
+            any_failures = true;                                                        \
     } while (0)
-#define SET_FLOAT(pname)                                                \
-    do                                                                  \
-    {                                                                   \
-        if (!set_sampler_parameter(static_cast<GLuint>(handle), pname)) \
-            any_failures = true;                                        \
+#define SET_FLOAT(pname)                                                                \
+    do                                                                                  \
+    {                                                                                   \
+        if (!set_sampler_parameter(static_cast<GLuint>(handle), pname, created_handle)) \
+            any_failures = true;                                                        \
     } while (0)
 
     SET_INT(GL_TEXTURE_MAG_FILTER);
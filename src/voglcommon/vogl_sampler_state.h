@@ -84,7 +84,7 @@ private:
 
     bool m_is_valid;
 
-    bool set_sampler_parameter(GLuint handle, GLenum pname) const;
+    bool set_sampler_parameter(GLuint handle, GLenum pname, bool skip_if_default) const;
 };
 
 namespace vogl
@@ -30,6 +30,7 @@
 #include "vogl_common.h"
 #include "vogl_json.h"
 #include "vogl_map.h"
+#include "vogl_btree_map.h"
 
 class vogl_snapshot_context_info;
 class vogl_state_vector;
@@ -298,7 +299,7 @@ public:
         return m_states.size();
     }
 
-    typedef vogl::map<vogl_state_id, vogl_state_data> state_map;
+    typedef vogl::btree_map<vogl_state_id, vogl_state_data> state_map;
 
     typedef state_map::const_iterator const_iterator;
 
@@ -113,6 +113,20 @@ bool vogl_sync_state::restore(const vogl_context_info &context_info, vogl_handle
 
         remapper.declare_handle(VOGL_NAMESPACE_SYNCS, m_snapshot_handle, handle, GL_NONE);
         VOGL_ASSERT(remapper.remap_handle(VOGL_NAMESPACE_SYNCS, m_snapshot_handle) == handle);
+
+        // The snapshot only records the fence's status (reading it never blocks). A fence that was already signaled
+        // is recreated signaled by waiting on the new fence here, so the replay sees the same status the app did.
+        // Unsignaled fences are left to signal on their own, like the original did.
+        if (is_signaled())
+        {
+            GLenum status = GL_ENTRYPOINT(glClientWaitSync)(sync, GL_SYNC_FLUSH_COMMANDS_BIT, cSignaledFenceTimeout);
+            VOGL_CHECK_GL_ERROR;
+
+            if ((status != GL_ALREADY_SIGNALED) && (status != GL_CONDITION_SATISFIED))
+            {
+                vogl_warning_printf("%s: Restored sync %" PRIu64 " was signaled in the snapshot, but didn't signal during restore\n", VOGL_FUNCTION_INFO_CSTR, (uint64_t)m_snapshot_handle);
+            }
+        }
     }
 
     return true;
@@ -78,7 +78,15 @@ public:
     // Content comparison, ignores handles.
     virtual bool compare_restorable_state(const vogl_gl_object_state &rhs_obj) const;
 
+    bool is_signaled() const
+    {
+        return m_params.get_value<GLenum>(GL_SYNC_STATUS) == GL_SIGNALED;
+    }
+
 private:
+    // Upper bound in nanoseconds on how long restore() waits for a recreated fence that was signaled in the snapshot.
+    static const GLuint64 cSignaledFenceTimeout = 1000000000ULL;
+
     uint64_t m_snapshot_handle;
     vogl_state_vector m_params;
 
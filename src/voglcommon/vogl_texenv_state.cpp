@@ -173,7 +173,30 @@ bool vogl_texenv_state::snapshot(const vogl_context_info &context_info)
     return true;
 }
 
-bool vogl_texenv_state::set_texenv_parameter(GLenum target, uint index, GLenum pname) const
+bool vogl_texenv_state::snapshot(const vogl_context_info &context_info, vogl_fixed_function_shadow &shadow)
+{
+    VOGL_FUNC_TRACER
+
+    const vogl_fixed_function_shadow::texenv_map *pParams = shadow.get_texenv();
+    if (pParams)
+    {
+        clear();
+
+        m_params = *pParams;
+        m_valid = true;
+
+        return true;
+    }
+
+    if (!snapshot(context_info))
+        return false;
+
+    shadow.set_texenv(m_params);
+
+    return true;
+}
+
+bool vogl_texenv_state::set_texenv_parameter(GLenum target, uint index, GLenum pname, bool skip_if_default) const
 {
     VOGL_FUNC_TRACER
 
@@ -195,6 +218,14 @@ bool vogl_texenv_state::set_texenv_parameter(GLenum target, uint index, GLenum p
         return false;
     }
 
+    if (skip_if_default)
+    {
+        float default_vals[4];
+        const uint num_defaults = vogl_get_default_texenv_parameter(target, pname, default_vals);
+        if (vogl_state_data_matches_defaults(*pData, default_vals, num_defaults))
+            return true;
+    }
+
     if ((pData->get_data_type() == cSTFloat) || (pData->get_data_type() == cSTDouble))
     {
         float fvals[cMaxElements];
@@ -217,7 +248,7 @@ bool vogl_texenv_state::set_texenv_parameter(GLenum target, uint index, GLenum p
     return !vogl_check_gl_error();
 }
 
-bool vogl_texenv_state::set_texgen_parameter(GLenum coord, uint index, GLenum pname) const
+bool vogl_texenv_state::set_texgen_parameter(GLenum coord, uint index, GLenum pname, bool skip_if_default) const
 {
     VOGL_FUNC_TRACER
 
@@ -239,6 +270,14 @@ bool vogl_texenv_state::set_texgen_parameter(GLenum coord, uint index, GLenum pn
         return false;
     }
 
+    if (skip_if_default)
+    {
+        float default_vals[4];
+        const uint num_defaults = vogl_get_default_texenv_parameter(coord, pname, default_vals);
+        if (vogl_state_data_matches_defaults(*pData, default_vals, num_defaults))
+            return true;
+    }
+
     if ((pData->get_data_type() == cSTFloat) || (pData->get_data_type() == cSTDouble))
     {
         float fvals[cMaxElements];
@@ -284,6 +323,7 @@ bool vogl_texenv_state::restore(const vogl_context_info &context_info) const
     if (vogl_check_gl_error())
         any_gl_errors = true;
 
+    // The replayer only restores into freshly created contexts, so params still at their GL defaults are skipped.
     for (uint texcoord_index = 0; texcoord_index < context_info.get_max_texture_coords(); texcoord_index++)
     {
         GL_ENTRYPOINT(glActiveTexture)(GL_TEXTURE0 + texcoord_index);
@@ -291,8 +331,8 @@ bool vogl_texenv_state::restore(const vogl_context_info &context_info) const
         if (vogl_check_gl_error())
             any_gl_errors = true;
 
-#define SET_FLOAT(target, idx, pname) set_texenv_parameter(target, idx, pname);
-#define SET_INT(target, idx, pname) set_texenv_parameter(target, idx, pname);
+#define SET_FLOAT(target, idx, pname) set_texenv_parameter(target, idx, pname, true);
+#define SET_INT(target, idx, pname) set_texenv_parameter(target, idx, pname, true);
 
         SET_FLOAT(GL_TEXTURE_FILTER_CONTROL, texcoord_index, GL_TEXTURE_LOD_BIAS);
         SET_INT(GL_POINT_SPRITE, texcoord_index, GL_COORD_REPLACE);
@@ -323,8 +363,8 @@ bool vogl_texenv_state::restore(const vogl_context_info &context_info) const
         if (vogl_check_gl_error())
             any_gl_errors = true;
 
-#define SET_DBL(target, idx, pname) set_texgen_parameter(target, idx, pname);
-#define SET_INT(target, idx, pname) set_texgen_parameter(target, idx, pname);
+#define SET_DBL(target, idx, pname) set_texgen_parameter(target, idx, pname, true);
+#define SET_INT(target, idx, pname) set_texgen_parameter(target, idx, pname, true);
 
         SET_INT(GL_S, texcoord_index, GL_TEXTURE_GEN_MODE);
         SET_DBL(GL_S, texcoord_index, GL_OBJECT_PLANE);
@@ -32,6 +32,7 @@
 #include "vogl_context_info.h"
 #include "vogl_general_context_state.h"
 #include "vogl_blob_manager.h"
+#include "vogl_fixed_function_shadow.h"
 
 class vogl_texenv_state
 {
@@ -40,6 +41,10 @@ public:
     ~vogl_texenv_state();
 
     bool snapshot(const vogl_context_info &context_info);
+
+    // Copies the params from the shadow if it knows them, otherwise reads them from GL and reseeds the shadow.
+    bool snapshot(const vogl_context_info &context_info, vogl_fixed_function_shadow &shadow);
+
     bool restore(const vogl_context_info &context_info) const;
 
     void clear();
@@ -60,8 +65,8 @@ private:
 
     bool m_valid;
 
-    bool set_texenv_parameter(GLenum target, uint index, GLenum pname) const;
-    bool set_texgen_parameter(GLenum coord, uint index, GLenum pname) const;
+    bool set_texenv_parameter(GLenum target, uint index, GLenum pname, bool skip_if_default) const;
+    bool set_texgen_parameter(GLenum coord, uint index, GLenum pname, bool skip_if_default) const;
 };
 
 #endif // VOGL_TEXENV_STATE_H
@@ -27,6 +27,7 @@
 #include "vogl_common.h"
 #include "vogl_texture_format.h"
 #include "vogl_ktx_texture.h"
+#include "vogl_context_info.h"
 
 //----------------------------------------------------------------------------------------------------------------------
 // Globals
@@ -872,3 +873,132 @@ const vogl_internal_tex_format *vogl_find_internal_texture_format(GLenum interna
     const vogl_internal_tex_format **ppFmt = get_internal_format_hash_map().find_value(internal_format);
     return ppFmt ? *ppFmt : NULL;
 }
+
+//----------------------------------------------------------------------------------------------------------------------
+// vogl_get_swapped_image_format
+// Returns the image format with the red and blue channels swapped, or GL_NONE if there isn't one.
+//----------------------------------------------------------------------------------------------------------------------
+static GLenum vogl_get_swapped_image_format(GLenum format)
+{
+    switch (format)
+    {
+        case GL_RGB:
+            return GL_BGR;
+        case GL_BGR:
+            return GL_RGB;
+        case GL_RGBA:
+            return GL_BGRA;
+        case GL_BGRA:
+            return GL_RGBA;
+        case GL_RGB_INTEGER:
+            return GL_BGR_INTEGER;
+        case GL_BGR_INTEGER:
+            return GL_RGB_INTEGER;
+        case GL_RGBA_INTEGER:
+            return GL_BGRA_INTEGER;
+        case GL_BGRA_INTEGER:
+            return GL_RGBA_INTEGER;
+        default:
+            break;
+    }
+    return GL_NONE;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// vogl_is_8888_image_type
+// Types that read/write four 8-bit components, only the byte order differs.
+//----------------------------------------------------------------------------------------------------------------------
+static bool vogl_is_8888_image_type(GLenum type)
+{
+    switch (type)
+    {
+        case GL_UNSIGNED_BYTE:
+        case GL_UNSIGNED_INT_8_8_8_8:
+        case GL_UNSIGNED_INT_8_8_8_8_REV:
+            return true;
+        default:
+            break;
+    }
+    return false;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// vogl_is_lossless_image_format_substitution
+// True if reading back with native_fmt/native_type instead of fmt/type only reorders the components or bytes of each
+// texel. Every component keeps its type and bit depth, so nothing is lost on readback or restore.
+//----------------------------------------------------------------------------------------------------------------------
+static bool vogl_is_lossless_image_format_substitution(GLenum fmt, GLenum type, GLenum native_fmt, GLenum native_type)
+{
+    if ((native_fmt != fmt) && (native_fmt != vogl_get_swapped_image_format(fmt)))
+        return false;
+
+    if (native_type == type)
+        return true;
+
+    return (vogl_get_image_format_channels(fmt) == 4) && (vogl_is_8888_image_type(type)) && (vogl_is_8888_image_type(native_type));
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// vogl_get_native_get_image_format
+// The internal format table was built against one driver. When ARB_internalformat_query2 is available we ask the current
+// driver for its preferred readback format/type, and use it instead if it's a lossless permutation of the table's
+// format/type (RGBA<->BGRA, or UNSIGNED_BYTE<->UNSIGNED_INT_8_8_8_8_REV). The KTX texture records whatever we pick, and
+// restore uploads with it, so neither direction needs per-texel conversion in the driver. Results are cached per
+// target/internal format, and snapshots may run on several threads so the cache is locked.
+//----------------------------------------------------------------------------------------------------------------------
+typedef vogl::hash_map<uint64_t, uint64_t> vogl_native_format_cache;
+static vogl_native_format_cache g_native_formats;
+static mutex g_native_formats_mutex;
+
+void vogl_get_native_get_image_format(const vogl_context_info &context_info, GLenum target, const vogl_internal_tex_format &tex_fmt, GLenum &image_fmt, GLenum &image_type)
+{
+    VOGL_FUNC_TRACER
+
+    image_fmt = tex_fmt.m_optimum_get_image_fmt;
+    image_type = tex_fmt.m_optimum_get_image_type;
+
+    // Compressed formats are read back verbatim with glGetCompressedTexImage(), and depth/stencil readback is too
+    // inconsistent across drivers to trust.
+    if ((tex_fmt.m_compressed) || (image_fmt == GL_NONE) || (image_type == GL_NONE) ||
+        (tex_fmt.m_comp_sizes[cTCDepth]) || (tex_fmt.m_comp_sizes[cTCStencil]))
+        return;
+
+    if ((!context_info.supports_extension("GL_ARB_internalformat_query2")) || (!GL_ENTRYPOINT(glGetInternalformativ)))
+        return;
+
+    const uint64_t key = (static_cast<uint64_t>(target) << 32) | tex_fmt.m_fmt;
+
+    uint64_t native = 0;
+    bool found;
+    {
+        scoped_mutex lock(g_native_formats_mutex);
+
+        const uint64_t *pCached = g_native_formats.find_value(key);
+        found = (pCached != NULL);
+        if (found)
+            native = *pCached;
+    }
+
+    if (!found)
+    {
+        // Don't hold the lock while querying the driver. If another thread gets here first it'll insert the same value.
+        GLint native_fmt = GL_NONE, native_type = GL_NONE;
+        GL_ENTRYPOINT(glGetInternalformativ)(target, tex_fmt.m_fmt, GL_GET_TEXTURE_IMAGE_FORMAT, 1, &native_fmt);
+        GL_ENTRYPOINT(glGetInternalformativ)(target, tex_fmt.m_fmt, GL_GET_TEXTURE_IMAGE_TYPE, 1, &native_type);
+
+        if ((vogl_check_gl_error()) || (native_fmt == GL_NONE) || (native_type == GL_NONE) ||
+            (!vogl_is_lossless_image_format_substitution(image_fmt, image_type, native_fmt, native_type)))
+        {
+            native_fmt = image_fmt;
+            native_type = image_type;
+        }
+
+        native = (static_cast<uint64_t>(native_fmt) << 32) | static_cast<uint32>(native_type);
+
+        scoped_mutex lock(g_native_formats_mutex);
+        g_native_formats.insert(key, native);
+    }
+
+    image_fmt = static_cast<GLenum>(native >> 32);
+    image_type = static_cast<GLenum>(native & cUINT32_MAX);
+}
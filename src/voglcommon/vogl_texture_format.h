@@ -125,4 +125,7 @@ void vogl_devel_dump_internal_texture_formats(const vogl_context_info &context_i
 void vogl_texture_format_init();
 const vogl_internal_tex_format *vogl_find_internal_texture_format(GLenum internal_format);
 
+// Returns the format/type to read back (and upload) texels of tex_fmt with, preferring the driver's native layout.
+void vogl_get_native_get_image_format(const vogl_context_info &context_info, GLenum target, const vogl_internal_tex_format &tex_fmt, GLenum &image_fmt, GLenum &image_type);
+
 #endif // VOGL_TEXTURE_FORMAT_H
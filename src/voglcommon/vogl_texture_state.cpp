@@ -43,6 +43,7 @@ vogl_texture_state::vogl_texture_state()
       m_buffer(0),
       m_num_samples(0),
       m_is_unquerable(false),
+      m_mip_tail_skipped(false),
       m_is_valid(false)
 {
     VOGL_FUNC_TRACER
@@ -55,11 +56,54 @@ vogl_texture_state::~vogl_texture_state()
     clear();
 }
 
-// TODO: Split this bad boy up into multiple methods
 bool vogl_texture_state::snapshot(const vogl_context_info &context_info, vogl_handle_remapper &remapper, GLuint64 handle, GLenum target)
 {
     VOGL_FUNC_TRACER
 
+    return snapshot(context_info, remapper, handle, target, false);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// vogl_can_regenerate_mip_tail
+// glGenerateMipmap() only works on color-renderable, filterable, non-integer formats. Depth/stencil, integer, compressed,
+// snorm, luminance/intensity and shared exponent formats are ruled out using the format table, and the driver gets the
+// final say when ARB_internalformat_query2 is available.
+//----------------------------------------------------------------------------------------------------------------------
+static bool vogl_can_regenerate_mip_tail(const vogl_context_info &context_info, GLenum target, const vogl_internal_tex_format &tex_fmt)
+{
+    VOGL_FUNC_TRACER
+
+    if ((tex_fmt.m_compressed) || (tex_fmt.m_shared_size))
+        return false;
+
+    if ((tex_fmt.m_comp_sizes[cTCDepth]) || (tex_fmt.m_comp_sizes[cTCStencil]) || (tex_fmt.m_comp_sizes[cTCIntensity]) || (tex_fmt.m_comp_sizes[cTCLuminance]))
+        return false;
+
+    for (uint i = 0; i < cTCTotalComponents; i++)
+    {
+        if ((tex_fmt.m_comp_sizes[i]) && (tex_fmt.m_comp_types[i] != GL_UNSIGNED_NORMALIZED) && (tex_fmt.m_comp_types[i] != GL_FLOAT))
+            return false;
+    }
+
+    if ((context_info.supports_extension("GL_ARB_internalformat_query2")) && (GL_ENTRYPOINT(glGetInternalformativ)))
+    {
+        GLint mipmap = GL_FALSE, filter = GL_NONE, color_renderable = GL_FALSE;
+        GL_ENTRYPOINT(glGetInternalformativ)(target, tex_fmt.m_fmt, GL_MIPMAP, 1, &mipmap);
+        GL_ENTRYPOINT(glGetInternalformativ)(target, tex_fmt.m_fmt, GL_FILTER, 1, &filter);
+        GL_ENTRYPOINT(glGetInternalformativ)(target, tex_fmt.m_fmt, GL_COLOR_RENDERABLE, 1, &color_renderable);
+
+        if ((vogl_check_gl_error()) || (mipmap != GL_TRUE) || (filter == GL_NONE) || (color_renderable != GL_TRUE))
+            return false;
+    }
+
+    return true;
+}
+
+// TODO: Split this bad boy up into multiple methods
+bool vogl_texture_state::snapshot(const vogl_context_info &context_info, vogl_handle_remapper &remapper, GLuint64 handle, GLenum target, bool skip_mip_tail, vogl_texture_readback_queue *pReadbacks)
+{
+    VOGL_FUNC_TRACER
+
     VOGL_NOTE_UNUSED(remapper);
 
     const bool is_target_multisampled = ((target == GL_TEXTURE_2D_MULTISAMPLE) || (target == GL_TEXTURE_2D_MULTISAMPLE_ARRAY));
@@ -299,6 +343,14 @@ bool vogl_texture_state::snapshot(const vogl_context_info &context_info, vogl_ha
                            internal_fmt, get_gl_enums().find_gl_image_format_name(internal_fmt), static_cast<uint64_t>(handle), get_gl_enums().find_gl_name(m_target));
     }
 
+    // Only drop the mip tail if restore can recreate it with glGenerateMipmap().
+    if ((skip_mip_tail) && (!is_target_multisampled) && (num_actual_mip_levels > static_cast<uint>(base_level) + 1U) &&
+        (vogl_can_regenerate_mip_tail(context_info, m_target, *pInternal_tex_fmt)))
+    {
+        num_actual_mip_levels = base_level + 1;
+        m_mip_tail_skipped = true;
+    }
+
     // Note: Mips below the base_level may or may not actually exist, AND the app can dynamically manipulate the base level so we need to try and save everything we can.
     int base_width = 0, base_height = 0, base_depth = 0;
     GL_ENTRYPOINT(glGetTexLevelParameteriv)(target_to_query, base_level, GL_TEXTURE_WIDTH, &base_width);
@@ -378,8 +430,15 @@ bool vogl_texture_state::snapshot(const vogl_context_info &context_info, vogl_ha
 
     //uint max_possible_mip_levels = (m_target == GL_TEXTURE_RECTANGLE) ? 1 : utils::compute_max_mips(width, height, depth);
 
-    GLenum image_fmt = pInternal_tex_fmt->m_optimum_get_image_fmt;
-    GLenum image_type = pInternal_tex_fmt->m_optimum_get_image_type;
+    // MSAA textures are read back through non-MSAA split textures.
+    GLenum get_image_target = m_target;
+    if (m_target == GL_TEXTURE_2D_MULTISAMPLE)
+        get_image_target = GL_TEXTURE_2D;
+    else if (m_target == GL_TEXTURE_2D_MULTISAMPLE_ARRAY)
+        get_image_target = GL_TEXTURE_2D_ARRAY;
+
+    GLenum image_fmt, image_type;
+    vogl_get_native_get_image_format(context_info, get_image_target, *pInternal_tex_fmt, image_fmt, image_type);
 
 #if 0
     // OK, I can't retrive the default framebuffer's depth/stencil buffer on AMD - all I get is INVALID_OPERATION. Crap. This works fine on NV though.
@@ -858,7 +917,7 @@ bool vogl_texture_state::snapshot(const vogl_context_info &context_info, vogl_ha
                 {
                     GL_ENTRYPOINT(glGetCompressedTexImage)(get_target, level, temp_img.get_ptr());
                 }
-                else
+                else if ((!pReadbacks) || (!pReadbacks->get(static_cast<GLuint>(handle), get_target, level, image_fmt, image_type, temp_img.get_ptr(), size_in_bytes)))
                 {
                     GL_ENTRYPOINT(glGetTexImage)(get_target, level, image_fmt, image_type, temp_img.get_ptr());
                 }
@@ -1042,7 +1101,8 @@ bool vogl_texture_state::snapshot(const vogl_context_info &context_info, vogl_ha
     return true;
 }
 
-bool vogl_texture_state::set_tex_parameter(GLenum pname) const
+// If dsa_handle is nonzero the param is set through EXT_direct_state_access, otherwise on the texture bound to m_target.
+bool vogl_texture_state::set_tex_parameter(GLenum pname, GLuint dsa_handle, bool skip_if_default) const
 {
     VOGL_FUNC_TRACER
 
@@ -1064,11 +1124,27 @@ bool vogl_texture_state::set_tex_parameter(GLenum pname) const
         return false;
     }
 
+    if (skip_if_default)
+    {
+        // Freshly created textures already hold the GL defaults, so don't bother setting params that match them.
+        float default_vals[4];
+        const uint num_defaults = vogl_get_default_tex_parameter(m_target, pname, default_vals);
+        if (vogl_state_data_matches_defaults(*pData, default_vals, num_defaults))
+            return true;
+    }
+
     if ((pData->get_data_type() == cSTFloat) || (pData->get_data_type() == cSTDouble))
     {
         float fvals[16];
         pData->get_float(fvals);
-        if (pData->get_num_elements() == 1)
+        if (dsa_handle)
+        {
+            if (pData->get_num_elements() == 1)
+                GL_ENTRYPOINT(glTextureParameterfEXT)(dsa_handle, m_target, pname, fvals[0]);
+            else
+                GL_ENTRYPOINT(glTextureParameterfvEXT)(dsa_handle, m_target, pname, fvals);
+        }
+        else if (pData->get_num_elements() == 1)
             GL_ENTRYPOINT(glTexParameterf)(m_target, pname, fvals[0]);
         else
             GL_ENTRYPOINT(glTexParameterfv)(m_target, pname, fvals);
@@ -1077,7 +1153,14 @@ bool vogl_texture_state::set_tex_parameter(GLenum pname) const
     {
         int ivals[16];
         pData->get_int(ivals);
-        if (pData->get_num_elements() == 1)
+        if (dsa_handle)
+        {
+            if (pData->get_num_elements() == 1)
+                GL_ENTRYPOINT(glTextureParameteriEXT)(dsa_handle, m_target, pname, ivals[0]);
+            else
+                GL_ENTRYPOINT(glTextureParameterivEXT)(dsa_handle, m_target, pname, ivals);
+        }
+        else if (pData->get_num_elements() == 1)
             GL_ENTRYPOINT(glTexParameteri)(m_target, pname, ivals[0]);
         else
             GL_ENTRYPOINT(glTexParameteriv)(m_target, pname, ivals);
@@ -1086,25 +1169,20 @@ bool vogl_texture_state::set_tex_parameter(GLenum pname) const
     return !vogl_check_gl_error();
 }
 
-// Note: We'll need the remapper for buffer textures.
-bool vogl_texture_state::restore(const vogl_context_info &context_info, vogl_handle_remapper &remapper, GLuint64 &handle) const
+void vogl_scoped_texture_restore_state::save(const vogl_context_info &context_info)
 {
     VOGL_FUNC_TRACER
 
-    if (!m_is_valid)
-        return false;
-
     VOGL_CHECK_GL_ERROR;
 
-    vogl_msaa_texture_splitter splitter;
-
-    vogl_scoped_binding_state orig_bindings(GL_PIXEL_PACK_BUFFER, GL_PIXEL_UNPACK_BUFFER);
-    orig_bindings.save_textures();
+    m_orig_bindings.save(GL_PIXEL_PACK_BUFFER);
+    m_orig_bindings.save(GL_PIXEL_UNPACK_BUFFER);
+    m_orig_bindings.save_textures();
 
-    vogl_scoped_state_saver pixeltransfer_state_saver(cGSTPixelStore);
+    m_pixel_state_saver.save(cGSTPixelStore);
 
     if (!context_info.is_core_profile())
-        pixeltransfer_state_saver.save(cGSTPixelTransfer);
+        m_pixel_state_saver.save(cGSTPixelTransfer);
 
     vogl_reset_pixel_store_states();
 
@@ -1116,6 +1194,182 @@ bool vogl_texture_state::restore(const vogl_context_info &context_info, vogl_han
 
     GL_ENTRYPOINT(glBindBuffer)(GL_PIXEL_UNPACK_BUFFER, 0);
     VOGL_CHECK_GL_ERROR;
+}
+
+vogl_texture_readback_queue::vogl_texture_readback_queue()
+{
+    VOGL_FUNC_TRACER
+}
+
+vogl_texture_readback_queue::~vogl_texture_readback_queue()
+{
+    VOGL_FUNC_TRACER
+
+    clear();
+}
+
+bool vogl_texture_readback_queue::queue(const vogl_context_info &context_info, GLuint handle, GLenum target)
+{
+    VOGL_FUNC_TRACER
+
+    if ((target != GL_TEXTURE_2D) || (!context_info.supports_extension("GL_ARB_pixel_buffer_object")))
+        return false;
+
+    VOGL_CHECK_GL_ERROR;
+
+    vogl_scoped_binding_state orig_bindings(GL_PIXEL_PACK_BUFFER, GL_TEXTURE_2D);
+
+    GL_ENTRYPOINT(glBindTexture)(GL_TEXTURE_2D, handle);
+    VOGL_CHECK_GL_ERROR;
+
+    GLint internal_fmt = 0, width = 0, height = 0;
+    GL_ENTRYPOINT(glGetTexLevelParameteriv)(GL_TEXTURE_2D, 0, GL_TEXTURE_INTERNAL_FORMAT, &internal_fmt);
+    GL_ENTRYPOINT(glGetTexLevelParameteriv)(GL_TEXTURE_2D, 0, GL_TEXTURE_WIDTH, &width);
+    GL_ENTRYPOINT(glGetTexLevelParameteriv)(GL_TEXTURE_2D, 0, GL_TEXTURE_HEIGHT, &height);
+    if ((vogl_check_gl_error()) || (width < 1) || (height < 1))
+        return false;
+
+    const vogl_internal_tex_format *pInternal_tex_fmt = vogl_find_internal_texture_format(internal_fmt);
+    if ((!pInternal_tex_fmt) || (pInternal_tex_fmt->m_compressed))
+        return false;
+
+    readback rb;
+    rb.m_handle = handle;
+    rb.m_target = target;
+
+    // Must match the format vogl_texture_state::snapshot() asks for.
+    vogl_get_native_get_image_format(context_info, GL_TEXTURE_2D, *pInternal_tex_fmt, rb.m_image_fmt, rb.m_image_type);
+    if ((rb.m_image_fmt == GL_NONE) || (rb.m_image_type == GL_NONE))
+        return false;
+
+    rb.m_size = vogl_get_image_size(rb.m_image_fmt, rb.m_image_type, width, height, 1);
+    if ((!rb.m_size) || (rb.m_size > static_cast<size_t>(cINT32_MAX)))
+        return false;
+
+    rb.m_buffer = 0;
+    GL_ENTRYPOINT(glGenBuffers)(1, &rb.m_buffer);
+    VOGL_CHECK_GL_ERROR;
+
+    GL_ENTRYPOINT(glBindBuffer)(GL_PIXEL_PACK_BUFFER, rb.m_buffer);
+    VOGL_CHECK_GL_ERROR;
+
+    GL_ENTRYPOINT(glBufferData)(GL_PIXEL_PACK_BUFFER, rb.m_size, NULL, GL_STREAM_READ);
+
+    if (!vogl_check_gl_error())
+    {
+        // With a pack buffer bound this only queues the copy.
+        GL_ENTRYPOINT(glGetTexImage)(GL_TEXTURE_2D, 0, rb.m_image_fmt, rb.m_image_type, NULL);
+    }
+
+    if (vogl_check_gl_error())
+    {
+        vogl_warning_printf("%s: Failed queuing readback of texture %u, falling back to a synchronous readback\n", VOGL_FUNCTION_INFO_CSTR, handle);
+
+        GL_ENTRYPOINT(glBindBuffer)(GL_PIXEL_PACK_BUFFER, 0);
+        VOGL_CHECK_GL_ERROR;
+
+        GL_ENTRYPOINT(glDeleteBuffers)(1, &rb.m_buffer);
+        VOGL_CHECK_GL_ERROR;
+
+        return false;
+    }
+
+    m_readbacks.push_back(rb);
+
+    return true;
+}
+
+bool vogl_texture_readback_queue::get(GLuint handle, GLenum target, int level, GLenum image_fmt, GLenum image_type, void *pDst, size_t size)
+{
+    VOGL_FUNC_TRACER
+
+    if (level)
+        return false;
+
+    uint i;
+    for (i = 0; i < m_readbacks.size(); i++)
+    {
+        const readback &rb = m_readbacks[i];
+        if ((rb.m_buffer) && (rb.m_handle == handle) && (rb.m_target == target) && (rb.m_image_fmt == image_fmt) && (rb.m_image_type == image_type) && (rb.m_size == size))
+            break;
+    }
+
+    if (i == m_readbacks.size())
+        return false;
+
+    readback &rb = m_readbacks[i];
+
+    VOGL_CHECK_GL_ERROR;
+
+    vogl_scoped_binding_state orig_bindings(GL_PIXEL_PACK_BUFFER);
+
+    GL_ENTRYPOINT(glBindBuffer)(GL_PIXEL_PACK_BUFFER, rb.m_buffer);
+    VOGL_CHECK_GL_ERROR;
+
+    bool success = false;
+
+    const void *pSrc = GL_ENTRYPOINT(glMapBuffer)(GL_PIXEL_PACK_BUFFER, GL_READ_ONLY);
+    if ((!vogl_check_gl_error()) && (pSrc))
+    {
+        memcpy(pDst, pSrc, size);
+
+        success = (GL_ENTRYPOINT(glUnmapBuffer)(GL_PIXEL_PACK_BUFFER) == GL_TRUE);
+        VOGL_CHECK_GL_ERROR;
+    }
+
+    if (!success)
+        vogl_warning_printf("%s: Failed mapping the readback buffer of texture %u\n", VOGL_FUNCTION_INFO_CSTR, handle);
+
+    GL_ENTRYPOINT(glBindBuffer)(GL_PIXEL_PACK_BUFFER, 0);
+    VOGL_CHECK_GL_ERROR;
+
+    // The data is only needed once, so don't hang on to the memory.
+    GL_ENTRYPOINT(glDeleteBuffers)(1, &rb.m_buffer);
+    VOGL_CHECK_GL_ERROR;
+
+    rb.m_buffer = 0;
+
+    return success;
+}
+
+void vogl_texture_readback_queue::clear()
+{
+    VOGL_FUNC_TRACER
+
+    for (uint i = 0; i < m_readbacks.size(); i++)
+    {
+        if (m_readbacks[i].m_buffer)
+        {
+            GL_ENTRYPOINT(glDeleteBuffers)(1, &m_readbacks[i].m_buffer);
+            VOGL_CHECK_GL_ERROR;
+        }
+    }
+
+    m_readbacks.clear();
+}
+
+bool vogl_texture_state::restore(const vogl_context_info &context_info, vogl_handle_remapper &remapper, GLuint64 &handle) const
+{
+    VOGL_FUNC_TRACER
+
+    return restore(context_info, remapper, handle, true);
+}
+
+// Note: We'll need the remapper for buffer textures.
+bool vogl_texture_state::restore(const vogl_context_info &context_info, vogl_handle_remapper &remapper, GLuint64 &handle, bool preserve_state) const
+{
+    VOGL_FUNC_TRACER
+
+    if (!m_is_valid)
+        return false;
+
+    VOGL_CHECK_GL_ERROR;
+
+    vogl_scoped_texture_restore_state scoped_restore_state;
+    if (preserve_state)
+        scoped_restore_state.save(context_info);
+
+    vogl_msaa_texture_splitter splitter;
 
     bool created_handle = false;
 
@@ -1187,17 +1441,23 @@ bool vogl_texture_state::restore(const vogl_context_info &context_info, vogl_han
     bool any_failures;
     any_failures = false;
 
-#define SET_INT(pname)                 \
-    do                                 \
-    {                                  \
-        if (!set_tex_parameter(pname)) \
-            any_failures = true;       \
+    // Set the params directly on the texture object when EXT_direct_state_access is available.
+    GLuint dsa_handle;
+    dsa_handle = 0;
+    if (context_info.supports_extension("GL_EXT_direct_state_access") && GL_ENTRYPOINT(glTextureParameteriEXT))
+        dsa_handle = static_cast<GLuint>(handle);
+
+#define SET_INT(pname)                                             \
+    do                                                             \
+    {                                                              \
+        if (!set_tex_parameter(pname, dsa_handle, created_handle)) \
+            any_failures = true;                                   \
     } while (0)
-#define SET_FLOAT(pname)               \
-    do                                 \
-    {                                  \
-        if (!set_tex_parameter(pname)) \
-            any_failures = true;       \
+#define SET_FLOAT(pname)                                           \
+    do                                                             \
+    {                                                              \
+        if (!set_tex_parameter(pname, dsa_handle, created_handle)) \
+            any_failures = true;                                   \
     } while (0)
     SET_INT(GL_TEXTURE_BASE_LEVEL);
     SET_INT(GL_TEXTURE_MAX_LEVEL);
@@ -1581,10 +1841,23 @@ bool vogl_texture_state::restore(const vogl_context_info &context_info, vogl_han
         } // level
     } // face
 
-    if (m_params.get_value<int>(GL_GENERATE_MIPMAP))
+    if ((m_mip_tail_skipped) || (m_params.get_value<int>(GL_GENERATE_MIPMAP)))
     {
         GL_ENTRYPOINT(glGenerateMipmap)(m_target);
         vogl_debug_printf("%s: Generating mipmaps for texture, snapshot handle %u GL handle %u\n", VOGL_FUNCTION_INFO_CSTR, m_snapshot_handle, (uint)handle);
+
+        if (vogl_check_gl_error())
+        {
+            vogl_warning_printf("%s: glGenerateMipmap() failed on trace texture %u, GL texture %" PRIu64 " target %s, internal format %s\n", VOGL_FUNCTION_INFO_CSTR,
+                               m_snapshot_handle, (uint64_t)handle, get_gl_enums().find_gl_name(m_target), get_gl_enums().find_gl_image_format_name(internal_fmt));
+
+            if (m_mip_tail_skipped)
+            {
+                // The mip tail wasn't captured, so clamp the texture to the levels that were to keep it mipmap complete.
+                GL_ENTRYPOINT(glTexParameteri)(m_target, GL_TEXTURE_MAX_LEVEL, total_actual_levels - 1);
+                VOGL_CHECK_GL_ERROR;
+            }
+        }
     }
 
 #undef SET_INT
@@ -1650,9 +1923,26 @@ void vogl_texture_state::clear()
         m_level_params[i].clear();
 
     m_is_unquerable = false;
+    m_mip_tail_skipped = false;
     m_is_valid = false;
 }
 
+uint64_t vogl_texture_state::get_texture_data_size() const
+{
+    VOGL_FUNC_TRACER
+
+    uint64_t total = 0;
+
+    for (uint sample_index = 0; sample_index < m_num_samples; sample_index++)
+    {
+        const ktx_texture &tex = m_textures[sample_index];
+        for (uint i = 0; i < tex.get_num_images(); i++)
+            total += tex.get_image_data(i).size();
+    }
+
+    return total;
+}
+
 bool vogl_texture_state::serialize(json_node &node, vogl_blob_manager &blob_manager) const
 {
     VOGL_FUNC_TRACER
@@ -1664,6 +1954,7 @@ bool vogl_texture_state::serialize(json_node &node, vogl_blob_manager &blob_mana
     node.add_key_value("handle", m_snapshot_handle);
     node.add_key_value("target", get_gl_enums().find_gl_name(m_target));
     node.add_key_value("is_unquerable", m_is_unquerable);
+    node.add_key_value("mip_tail_skipped", m_mip_tail_skipped);
     node.add_key_value("buffer", m_buffer);
     node.add_key_value("samples", m_num_samples);
 
@@ -1773,6 +2064,34 @@ bool vogl_texture_state::serialize(json_node &node, vogl_blob_manager &blob_mana
     return true;
 }
 
+// Reads the KTX file level by level straight from the blob's stream, so the whole blob is never copied into a temporary buffer.
+static bool read_ktx_blob(const vogl_blob_manager &blob_manager, const dynamic_string &blob_id, ktx_texture &tex)
+{
+    VOGL_FUNC_TRACER
+
+    data_stream *pStream = blob_manager.get_stream(blob_id);
+    if (!pStream)
+        return false;
+
+    ktx_texture_reader reader;
+    bool success = reader.open(*pStream);
+    if (success)
+    {
+        tex = reader.get_desc();
+
+        for (uint level = 0; (success) && (level < tex.get_num_mips()); level++)
+            success = reader.read_mip_level(level, tex);
+    }
+
+    if (!success)
+        vogl_error_printf("%s: Failed reading KTX texture blob %s\n", VOGL_FUNCTION_INFO_CSTR, blob_id.get_ptr());
+
+    reader.close();
+    blob_manager.close(pStream);
+
+    return success;
+}
+
 bool vogl_texture_state::deserialize(const json_node &node, const vogl_blob_manager &blob_manager)
 {
     VOGL_FUNC_TRACER
@@ -1785,6 +2104,7 @@ bool vogl_texture_state::deserialize(const json_node &node, const vogl_blob_mana
     m_snapshot_handle = node.value_as_uint32("handle");
     m_target = vogl_get_json_value_as_enum(node, "target");
     m_is_unquerable = node.value_as_bool("is_unquerable");
+    m_mip_tail_skipped = node.value_as_bool("mip_tail_skipped");
     m_buffer = node.value_as_uint32("buffer");
     m_num_samples = node.value_as_uint32("samples", 1);
 
@@ -1813,12 +2133,7 @@ bool vogl_texture_state::deserialize(const json_node &node, const vogl_blob_mana
             if (blob_id.is_empty())
                 return false;
 
-            dynamic_stream tex_data;
-            if (!blob_manager.get(blob_id, tex_data.get_buf()))
-                return false;
-
-            data_stream_serializer serializer(&tex_data);
-            if (!m_textures[0].read_from_stream(serializer))
+            if (!read_ktx_blob(blob_manager, blob_id, m_textures[0]))
                 return false;
         }
         else if (node.has_array("textures"))
@@ -1837,12 +2152,7 @@ bool vogl_texture_state::deserialize(const json_node &node, const vogl_blob_mana
                 if (blob_id.is_empty())
                     return false;
 
-                dynamic_stream tex_data;
-                if (!blob_manager.get(blob_id, tex_data.get_buf()))
-                    return false;
-
-                data_stream_serializer serializer(&tex_data);
-                if (!m_textures[i].read_from_stream(serializer))
+                if (!read_ktx_blob(blob_manager, blob_id, m_textures[i]))
                     return false;
             }
         }
@@ -1909,6 +2219,7 @@ bool vogl_texture_state::compare_restorable_state(const vogl_gl_object_state &rh
     if (x != rhs.x) \
         return false;
     CMP(m_is_unquerable);
+    CMP(m_mip_tail_skipped);
     CMP(m_target);
     CMP(m_params);
     CMP(m_buffer);
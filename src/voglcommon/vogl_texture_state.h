@@ -34,6 +34,8 @@
 #include "vogl_blob_manager.h"
 #include "vogl_vec.h"
 
+class vogl_texture_readback_queue;
+
 class vogl_texture_state : public vogl_gl_object_state
 {
 public:
@@ -52,9 +54,18 @@ public:
     // Creates snapshot of a texture handle
     virtual bool snapshot(const vogl_context_info &context_info, vogl_handle_remapper &remapper, GLuint64 handle, GLenum target);
 
+    // Same as above, but if skip_mip_tail is true only the levels up to the base level are read back from mipmapped textures whose format
+    // glGenerateMipmap() supports. The remaining levels are regenerated on restore. Used to stay within a capture budget.
+    // Image data already queued in pReadbacks (if any) is taken from there instead of being read back with glGetTexImage().
+    bool snapshot(const vogl_context_info &context_info, vogl_handle_remapper &remapper, GLuint64 handle, GLenum target, bool skip_mip_tail, vogl_texture_readback_queue *pReadbacks = NULL);
+
     // Creates and restores a texture
     virtual bool restore(const vogl_context_info &context_info, vogl_handle_remapper &remapper, GLuint64 &handle) const;
 
+    // Same as above, but assumes the caller has already saved and reset the texture bindings and pixel store/transfer
+    // state (see vogl_scoped_texture_restore_state), so many textures can be restored back to back without redundant GL calls.
+    bool restore(const vogl_context_info &context_info, vogl_handle_remapper &remapper, GLuint64 &handle, bool preserve_state) const;
+
     virtual bool remap_handles(vogl_handle_remapper &remapper);
 
     virtual void clear();
@@ -114,6 +125,14 @@ public:
         return m_level_params[face][level];
     }
 
+    bool get_mip_tail_skipped() const
+    {
+        return m_mip_tail_skipped;
+    }
+
+    // Total size of the captured texel data, across all samples.
+    uint64_t get_texture_data_size() const;
+
     // Content comparison, ignores handle.
     virtual bool compare_restorable_state(const vogl_gl_object_state &rhs_obj) const;
 
@@ -139,9 +158,78 @@ private:
     vogl_state_vector_array m_level_params[cCubeMapFaces];
 
     bool m_is_unquerable;
+    bool m_mip_tail_skipped;
     bool m_is_valid;
 
-    bool set_tex_parameter(GLenum pname) const;
+    bool set_tex_parameter(GLenum pname, GLuint dsa_handle, bool skip_if_default) const;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+// class vogl_scoped_texture_restore_state
+// Saves the texture/pixel buffer bindings and pixel store/transfer state, resets them to the defaults texture restoring
+// expects, and puts everything back on destruction.
+//----------------------------------------------------------------------------------------------------------------------
+class vogl_scoped_texture_restore_state
+{
+    VOGL_NO_COPY_OR_ASSIGNMENT_OP(vogl_scoped_texture_restore_state);
+
+    vogl_scoped_binding_state m_orig_bindings;
+    vogl_scoped_state_saver m_pixel_state_saver;
+
+public:
+    vogl_scoped_texture_restore_state()
+    {
+    }
+
+    vogl_scoped_texture_restore_state(const vogl_context_info &context_info)
+    {
+        save(context_info);
+    }
+
+    void save(const vogl_context_info &context_info);
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+// class vogl_texture_readback_queue
+// Reads back the base level of 2D textures into pixel pack buffers without waiting on the GPU. Queue all the textures
+// first, then pass the queue to vogl_texture_state::snapshot(), which maps the buffers instead of calling glGetTexImage().
+// Only the first map has to wait for the GPU.
+//----------------------------------------------------------------------------------------------------------------------
+class vogl_texture_readback_queue
+{
+    VOGL_NO_COPY_OR_ASSIGNMENT_OP(vogl_texture_readback_queue);
+
+public:
+    vogl_texture_readback_queue();
+    ~vogl_texture_readback_queue();
+
+    // Issues the readback of level 0 of a GL_TEXTURE_2D texture. The pixel store and pixel transfer states must be the defaults.
+    // Returns false if the texture can't be read back this way, in which case snapshot() reads it back synchronously.
+    bool queue(const vogl_context_info &context_info, GLuint handle, GLenum target);
+
+    // Copies a queued readback into pDst and deletes its buffer. Returns false if no matching readback was queued.
+    bool get(GLuint handle, GLenum target, int level, GLenum image_fmt, GLenum image_type, void *pDst, size_t size);
+
+    // Deletes all the pixel pack buffers.
+    void clear();
+
+    uint get_num_queued() const
+    {
+        return m_readbacks.size();
+    }
+
+private:
+    struct readback
+    {
+        GLuint m_handle;
+        GLenum m_target;
+        GLenum m_image_fmt;
+        GLenum m_image_type;
+        GLuint m_buffer;
+        size_t m_size;
+    };
+
+    vogl::vector<readback> m_readbacks;
 };
 
 namespace vogl
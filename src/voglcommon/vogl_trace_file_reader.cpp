@@ -71,12 +71,16 @@ vogl_trace_file_reader::trace_file_reader_status_t vogl_trace_file_reader::read_
             break;
         }
 
-        packets.push_back(get_packet_buf());
+        const bool is_eof = is_eof_packet();
+        const bool is_swap = !is_eof && is_swap_buffers_packet();
 
-        if (is_eof_packet())
+        // Hand the packet buffer over instead of copying it, read_next_packet() will allocate a new one sized to the next packet.
+        packets.push_back(VOGL_MOVE(m_packet_buf));
+
+        if (is_eof)
             break;
 
-        if (is_swap_buffers_packet())
+        if (is_swap)
         {
             if (++total_frames_read == num_frames)
                 break;
@@ -356,10 +360,9 @@ vogl_trace_file_reader::trace_file_reader_status_t vogl_binary_trace_file_reader
 {
     VOGL_FUNC_TRACER
 
-    m_packet_buf.resize(sizeof(vogl_trace_stream_packet_base));
-
     {
-        vogl_trace_stream_packet_base &packet_base = *reinterpret_cast<vogl_trace_stream_packet_base *>(m_packet_buf.get_ptr());
+        // Read the header on the stack, so the packet buffer is only resized once (it may have been moved out by read_frame_packets()).
+        vogl_trace_stream_packet_base packet_base;
         uint bytes_actually_read = m_trace_stream.read(&packet_base, sizeof(packet_base));
         if (bytes_actually_read != sizeof(packet_base))
         {
@@ -388,6 +391,7 @@ vogl_trace_file_reader::trace_file_reader_status_t vogl_binary_trace_file_reader
         }
 
         m_packet_buf.resize(packet_base.m_size);
+        memcpy(m_packet_buf.get_ptr(), &packet_base, sizeof(packet_base));
     }
 
     vogl_trace_stream_packet_base &packet_base = *reinterpret_cast<vogl_trace_stream_packet_base *>(m_packet_buf.get_ptr());
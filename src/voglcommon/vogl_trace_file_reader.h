@@ -74,6 +74,13 @@ public:
         m_packets.push_back(packet);
     }
 
+#if VOGL_HAS_MOVE_SEMANTICS
+    void push_back(uint8_vec &&packet)
+    {
+        m_packets.push_back(std::move(packet));
+    }
+#endif
+
     void insert(uint index, const uint8_vec &packet)
     {
         m_packets.insert(index, packet);
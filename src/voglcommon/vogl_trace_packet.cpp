@@ -504,8 +504,8 @@ bool vogl_trace_packet::json_serialize(json_node &node, const json_serialize_par
 
     node.add_key_value("func", pFunc_name);
 
-    node.add_key_value("thread_id", dynamic_string(cVarArg, "0x%" PRIX64, m_packet.m_thread_id));
-    node.add_key_value("context", dynamic_string(cVarArg, "0x%" PRIX64, m_packet.m_context_handle));
+    node.add_key_value("thread_id", uint64_to_hex_string(m_packet.m_thread_id));
+    node.add_key_value("context", uint64_to_hex_string(m_packet.m_context_handle));
     node.add_key_value("call_counter", static_cast<int64_t>(m_packet.m_call_counter));
     node.add_key_value("crc32", m_packet.m_crc);
     node.add_key_value("begin_rdtsc", m_packet.m_packet_begin_rdtsc);
@@ -576,7 +576,7 @@ bool vogl_trace_packet::json_serialize(json_node &node, const json_serialize_par
 
             if (val.is_blob())
             {
-                if (val.get_blob()->size() >= params.m_blob_file_size_threshold)
+                if (val.get_blob_size() >= params.m_blob_file_size_threshold)
                     handle_as_blob_file = true;
                 else if (should_always_write_as_blob_file(pFunc_name))
                     handle_as_blob_file = true;
@@ -586,14 +586,14 @@ bool vogl_trace_packet::json_serialize(json_node &node, const json_serialize_par
             {
                 dynamic_string id;
 
-                uint64_t blob_crc64 = calc_crc64(CRC64_INIT, reinterpret_cast<const uint8 *>(val.get_blob()->get_ptr()), val.get_blob()->size());
+                uint64_t blob_crc64 = calc_crc64(CRC64_INIT, val.get_blob_data(), val.get_blob_size());
 
                 if (params.m_pBlob_manager)
                 {
                     //dynamic_string prefix(cVarArg, "%s_%s", params.m_output_basename.get_ptr(), pFunc_name);
-                    dynamic_string prefix(cVarArg, "%s", pFunc_name);
+                    dynamic_string prefix(pFunc_name);
 
-                    id = params.m_pBlob_manager->add_buf_compute_unique_id(val.get_blob()->get_ptr(), val.get_blob()->size(), prefix, "blob", &blob_crc64);
+                    id = params.m_pBlob_manager->add_buf_compute_unique_id(val.get_blob_data(), val.get_blob_size(), prefix, "blob", &blob_crc64);
                     if (id.is_empty())
                     {
                         vogl_error_printf("%s: Failed adding blob %s to blob manager\n", VOGL_FUNCTION_INFO_CSTR, prefix.get_ptr());
@@ -609,8 +609,8 @@ bool vogl_trace_packet::json_serialize(json_node &node, const json_serialize_par
 
                 json_node &blob_node = entry_node.add_object("data");
                 blob_node.add_key_value("blob_id", id);
-                blob_node.add_key_value("crc64", dynamic_string(cVarArg, "0x%016" PRIX64, blob_crc64));
-                blob_node.add_key_value("size", val.get_blob()->size());
+                blob_node.add_key_value("crc64", uint64_to_hex_string(blob_crc64, 16));
+                blob_node.add_key_value("size", val.get_blob_size());
             }
             else
             {
@@ -653,7 +653,7 @@ bool vogl_trace_packet::json_serialize(json_node &node, const json_serialize_par
                         json_value test_val;
                         if ((!test_val.deserialize(new_val_as_str)) || (test_val.as_float() != flt_val))
                         {
-                            new_val.set_value(dynamic_string(cVarArg, "0x%08X", *reinterpret_cast<const uint32 *>(&flt_val)).get_ptr());
+                            new_val.set_value(uint64_to_hex_string(*reinterpret_cast<const uint32 *>(&flt_val), 8).get_ptr());
                         }
 
                         break;
@@ -669,14 +669,14 @@ bool vogl_trace_packet::json_serialize(json_node &node, const json_serialize_par
                         json_value test_val;
                         if ((!test_val.deserialize(new_val_as_str)) || (test_val.as_double() != dbl_val))
                         {
-                            new_val.set_value(dynamic_string(cVarArg, "0x%" PRIX64, static_cast<uint64_t>(*reinterpret_cast<const uint64_t *>(&dbl_val))).get_ptr());
+                            new_val.set_value(uint64_to_hex_string(*reinterpret_cast<const uint64_t *>(&dbl_val)).get_ptr());
                         }
 
                         break;
                     }
                     case cDTUInt64:
                     {
-                        entry_node.add_key_value("data", dynamic_string(cVarArg, "0x%" PRIX64, val.get_uint64()).get_ptr());
+                        entry_node.add_key_value("data", uint64_to_hex_string(val.get_uint64()).get_ptr());
                         break;
                     }
                     case cDTJSONDoc:
@@ -1281,7 +1281,7 @@ void vogl_trace_packet::ctype_to_json_value(json_value &val, gl_entrypoint_id_t
         }
     }
 
-    val.set_value(dynamic_string(cVarArg, "0x%" PRIX64, data).get_ptr());
+    val.set_value(uint64_to_hex_string(data).get_ptr());
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -1350,15 +1350,15 @@ bool vogl_trace_packet::json_serialize_param(
             dynamic_string str(pStr);
             param_node.add_key_value("string", str);
 
-            param_node.add_key_value("ptr", dynamic_string(cVarArg, "0x%016" PRIX64, param_data));
+            param_node.add_key_value("ptr", uint64_to_hex_string(param_data, 16));
         }
         else
         {
-            param_node.add_key_value("ptr", dynamic_string(cVarArg, "0x%016" PRIX64, param_data));
+            param_node.add_key_value("ptr", uint64_to_hex_string(param_data, 16));
             param_node.add_key_value("mem_size", client_mem_size);
 
             uint64_t client_mem_crc64 = calc_crc64(CRC64_INIT, reinterpret_cast<const uint8 *>(pClient_mem), client_mem_size);
-            param_node.add_key_value("crc64", dynamic_string(cVarArg, "0x%016" PRIX64, client_mem_crc64));
+            param_node.add_key_value("crc64", uint64_to_hex_string(client_mem_crc64, 16));
 
             if ((pointee_size >= 1) && (pointee_size <= 8) && (math::is_power_of_2(pointee_size)) && (!(client_mem_size % pointee_size)))
             {
@@ -1412,7 +1412,8 @@ bool vogl_trace_packet::json_serialize_param(
                     if (params.m_pBlob_manager)
                     {
                         //dynamic_string prefix(cVarArg, "%s_%s_param_%i", params.m_output_basename.get_ptr(), pFunc_name, param_index);
-                        dynamic_string prefix(cVarArg, "%s_%s", pFunc_name, g_vogl_entrypoint_param_descs[m_packet.m_entrypoint_id][param_index].m_pName);
+                        dynamic_string prefix(pFunc_name);
+                        prefix.append_char('_').append(g_vogl_entrypoint_param_descs[m_packet.m_entrypoint_id][param_index].m_pName);
 
                         id = params.m_pBlob_manager->add_buf_compute_unique_id(pClient_mem, client_mem_size, prefix, "blob", &client_mem_crc64);
                         if (id.is_empty())
@@ -2145,20 +2146,20 @@ bool vogl_trace_packet::fixup_manually_edited_params(gl_entrypoint_id_t gl_entry
                         return false;
                     }
 
-                    const uint8_vec *pBlob = it->second.get_blob();
-                    if (!pBlob)
+                    if (!it->second.is_blob())
                     {
                         vogl_error_printf("GL func %s call counter %" PRIu64 ": Failed finding shader source blob string in GL key value map\n", pGL_func_name, cur_call_counter);
                         return false;
                     }
 
                     uint l = pLengths[i];
+                    uint blob_size = it->second.get_blob_size();
 
-                    if (pBlob->size() != l)
+                    if (blob_size != l)
                     {
                         vogl_warning_printf("GL func %s call counter %" PRIu64 ": Shader source code line %u: blob size is %u bytes, but length field is %u bytes: Fixing up length field to match blob's size\n",
-                                           pGL_func_name, cur_call_counter, static_cast<uint>(i), pBlob->size(), l);
-                        pLengths[i] = pBlob->size();
+                                           pGL_func_name, cur_call_counter, static_cast<uint>(i), blob_size, l);
+                        pLengths[i] = blob_size;
                     }
                 }
             }
@@ -2310,10 +2311,10 @@ bool vogl_trace_packet::pretty_print_param(dynamic_string &str, uint param_index
             //const bool pointee_is_ptr = (*m_pCTypes)[pointee_ctype].m_is_pointer;
 
             if ((!val_data) && (!client_mem_size))
-                str.format_append("NULL");
+                str.append("NULL");
             else if ((pointee_ctype == VOGL_INVALID_CTYPE) && (!client_mem_size))
             {
-                str.format_append("ptr=0x%" PRIX64, val_data);
+                str.append("ptr=0x").append_hex(val_data);
             }
             else
             {
@@ -2322,9 +2323,9 @@ bool vogl_trace_packet::pretty_print_param(dynamic_string &str, uint param_index
                     shortened_ctype.right(5);
 
                 if ((pointee_size > 1) && ((client_mem_size % pointee_size) == 0))
-                    str.format_append("ptr=0x%" PRIX64 " size=%u elements=%u pointee_type=%s", val_data, client_mem_size, client_mem_size / pointee_size, shortened_ctype.get_ptr());
+                    str.append("ptr=0x").append_hex(val_data).append(" size=").append_uint64(client_mem_size).append(" elements=").append_uint64(client_mem_size / pointee_size).append(" pointee_type=").append(shortened_ctype);
                 else
-                    str.format_append("ptr=0x%" PRIX64 " size=%u pointee_type=%s", val_data, client_mem_size, shortened_ctype.get_ptr());
+                    str.append("ptr=0x").append_hex(val_data).append(" size=").append_uint64(client_mem_size).append(" pointee_type=").append(shortened_ctype);
 
                 uint bytes_to_dump = math::minimum<uint>(64, client_mem_size);
                 if ((pClient_mem) && (bytes_to_dump))
@@ -2336,11 +2337,11 @@ bool vogl_trace_packet::pretty_print_param(dynamic_string &str, uint param_index
                         for (uint i = 0; i < bytes_to_dump / sizeof(uint64_t); i++)
                         {
                             if (i)
-                                str.format_append(" ");
+                                str.append_char(' ');
 
                             uint64_t array_val_data = reinterpret_cast<const uint64_t *>(pClient_mem)[i];
                             if (!pretty_print_param_val(str, pointee_ctype_desc, array_val_data, get_entrypoint_id(), is_return_param ? -1 : param_index))
-                                str.format_append("0x%" PRIX64, array_val_data);
+                                str.append("0x").append_hex(array_val_data);
                         }
                     }
                     else if ((pointee_size == sizeof(uint32)) && ((client_mem_size & 3) == 0))
@@ -2348,11 +2349,11 @@ bool vogl_trace_packet::pretty_print_param(dynamic_string &str, uint param_index
                         for (uint i = 0; i < bytes_to_dump / sizeof(uint32); i++)
                         {
                             if (i)
-                                str.format_append(" ");
+                                str.append_char(' ');
 
                             uint64_t array_val_data = reinterpret_cast<const uint32 *>(pClient_mem)[i];
                             if (!pretty_print_param_val(str, pointee_ctype_desc, array_val_data, get_entrypoint_id(), is_return_param ? -1 : param_index))
-                                str.format_append("0x%" PRIX64, array_val_data);
+                                str.append("0x").append_hex(array_val_data);
                         }
                     }
                     else if ((pointee_size == sizeof(uint16)) && ((client_mem_size & 1) == 0))
@@ -2360,11 +2361,11 @@ bool vogl_trace_packet::pretty_print_param(dynamic_string &str, uint param_index
                         for (uint i = 0; i < bytes_to_dump / sizeof(uint16); i++)
                         {
                             if (i)
-                                str.format_append(" ");
+                                str.append_char(' ');
 
                             uint64_t array_val_data = reinterpret_cast<const uint16 *>(pClient_mem)[i];
                             if (!pretty_print_param_val(str, pointee_ctype_desc, array_val_data, get_entrypoint_id(), is_return_param ? -1 : param_index))
-                                str.format_append("0x%" PRIX64, array_val_data);
+                                str.append("0x").append_hex(array_val_data);
                         }
                     }
                     else
@@ -2374,7 +2375,7 @@ bool vogl_trace_packet::pretty_print_param(dynamic_string &str, uint param_index
                         for (uint i = 0; i < bytes_to_dump; i++)
                         {
                             if (i)
-                                str.format_append(" ");
+                                str.append_char(' ');
 
                             uint32 array_val_data = reinterpret_cast<const uint8 *>(pClient_mem)[i];
 
@@ -2383,7 +2384,7 @@ bool vogl_trace_packet::pretty_print_param(dynamic_string &str, uint param_index
                                 handled = pretty_print_param_val(str, pointee_ctype_desc, array_val_data, get_entrypoint_id(), is_return_param ? -1 : param_index);
 
                             if (!handled)
-                                str.format_append("%02X", array_val_data);
+                                str.append_hex(array_val_data, 2);
                         }
                     }
 
@@ -2396,7 +2397,7 @@ bool vogl_trace_packet::pretty_print_param(dynamic_string &str, uint param_index
         }
         else
         {
-            str.format_append("0x%" PRIX64, val_data);
+            str.append("0x").append_hex(val_data);
         }
     }
 
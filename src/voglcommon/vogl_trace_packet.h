@@ -115,7 +115,8 @@ public:
 class vogl_trace_packet
 {
 public:
-    inline vogl_trace_packet(const vogl_ctypes *pCtypes)
+    // pBlob_chunk_pool (optional) supplies the chunks of the key/value blob arena, see key_value_map::set_blob_arena_mode().
+    inline vogl_trace_packet(const vogl_ctypes *pCtypes, concurrent_buffer_pool *pBlob_chunk_pool = NULL)
         : m_pCTypes(pCtypes),
           m_total_params(0),
           m_has_return_value(false),
@@ -126,6 +127,9 @@ public:
         VOGL_ASSUME(VOGL_INVALID_CTYPE == 0);
 
         utils::zero_object(m_packet);
+
+        // Packets are reset and reused, so keep large key/value blobs in an arena that reset() recycles.
+        m_key_value_map.set_blob_arena_mode(true, pBlob_chunk_pool);
     }
 
     inline void clear()
@@ -459,9 +463,7 @@ public:
         VOGL_FUNC_TRACER
 
         VOGL_ASSERT(m_is_valid);
-        value_to_value_hash_map::insert_result res(m_key_value_map.insert(key, value()));
-        (res.first)->second.set_blob(static_cast<const uint8 *>(pData), data_size);
-        return res.second;
+        return m_key_value_map.insert_blob(key, pData, data_size).second;
     }
 
     inline bool set_key_value_json_document(const value &key, const json_document &doc)
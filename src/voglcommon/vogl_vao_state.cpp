@@ -46,6 +46,14 @@ bool vogl_vertex_attrib_desc::operator==(const vogl_vertex_attrib_desc &rhs) con
     return true;
 }
 
+bool vogl_vertex_attrib_desc::is_default() const
+{
+    VOGL_FUNC_TRACER
+
+    return (!m_pointer) && (!m_array_binding) && (m_size == 4) && (m_type == GL_FLOAT) && (!m_stride) &&
+           (!m_integer) && (!m_divisor) && (!m_enabled) && (!m_normalized);
+}
+
 vogl_vao_state::vogl_vao_state()
     : m_snapshot_handle(0),
       m_element_array_binding(0),
@@ -153,6 +161,8 @@ bool vogl_vao_state::restore(const vogl_context_info &context_info, vogl_handle_
 
     vogl_scoped_binding_state orig_binding(GL_VERTEX_ARRAY, GL_ARRAY_BUFFER, GL_ELEMENT_ARRAY_BUFFER);
 
+    bool created_handle = false;
+
     if ((!m_snapshot_handle) && (!handle))
     {
         GL_ENTRYPOINT(glBindVertexArray)(0);
@@ -173,6 +183,8 @@ bool vogl_vao_state::restore(const vogl_context_info &context_info, vogl_handle_
                 remapper.declare_handle(VOGL_NAMESPACE_VERTEX_ARRAYS, m_snapshot_handle, handle, GL_NONE);
                 VOGL_ASSERT(remapper.remap_handle(VOGL_NAMESPACE_VERTEX_ARRAYS, m_snapshot_handle) == handle);
             }
+
+            created_handle = true;
         }
 
         if (m_has_been_bound)
@@ -196,6 +208,10 @@ bool vogl_vao_state::restore(const vogl_context_info &context_info, vogl_handle_
         {
             const vogl_vertex_attrib_desc &desc = m_vertex_attribs[i];
 
+            // Attribs on a new VAO already have their initial state, most VAOs only use a few of them.
+            if ((created_handle) && (desc.is_default()))
+                continue;
+
             GL_ENTRYPOINT(glBindBuffer)(GL_ARRAY_BUFFER, static_cast<GLuint>(remapper.remap_handle(VOGL_NAMESPACE_BUFFERS, desc.m_array_binding)));
             VOGL_CHECK_GL_ERROR;
 
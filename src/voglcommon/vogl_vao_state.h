@@ -54,6 +54,9 @@ struct vogl_vertex_attrib_desc
     bool m_normalized;
 
     bool operator==(const vogl_vertex_attrib_desc &rhs) const;
+
+    // True if this matches the initial state of an attrib on a new VAO.
+    bool is_default() const;
 };
 
 class vogl_vao_state : public vogl_gl_object_state
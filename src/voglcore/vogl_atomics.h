@@ -64,6 +64,7 @@ namespace vogl
 {
 #if VOGL_USE_WIN32_ATOMIC_FUNCTIONS
     typedef volatile LONG atomic32_t;
+    typedef LONG nonvolatile_atomic32_t;
     typedef volatile LONGLONG atomic64_t;
 
     // Returns the original value.
@@ -173,6 +174,7 @@ namespace vogl
 
     // Atomic ops not supported - but try to do something reasonable. Assumes no threading at all.
     typedef long atomic32_t;
+    typedef long nonvolatile_atomic32_t;
     typedef long long atomic64_t;
 
     inline atomic32_t atomic_compare_exchange32(atomic32_t volatile *pDest, atomic32_t exchange, atomic32_t comparand)
@@ -0,0 +1,213 @@
+/**************************************************************************
+ *
+ * Copyright 2013-2014 RAD Game Tools and Valve Software
+ * Copyright 2010-2014 Rich Geldreich and Tenacious Software LLC
+ * All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ **************************************************************************/
+
+// File: vogl_btree_map.cpp
+#include "vogl_core.h"
+#include "vogl_btree_map.h"
+#include "vogl_rand.h"
+#include "vogl_strutils.h"
+#include <map>
+
+namespace vogl
+{
+    // Compares the container against a std::map holding the same contents, forwards and backwards.
+    template <typename BTreeMap, typename StdMap>
+    static bool btree_map_matches(const BTreeMap &m, const StdMap &ref)
+    {
+        if ((m.size() != ref.size()) || (!m.debug_check()))
+            return false;
+
+        typename StdMap::const_iterator ref_it = ref.begin();
+        for (typename BTreeMap::const_iterator it = m.begin(); it != m.end(); ++it, ++ref_it)
+        {
+            if ((ref_it == ref.end()) || (it->first != ref_it->first) || (it->second != ref_it->second))
+                return false;
+        }
+        if (ref_it != ref.end())
+            return false;
+
+        if (m.size())
+        {
+            typename StdMap::const_reverse_iterator ref_rit = ref.rbegin();
+            typename BTreeMap::const_iterator it = m.end();
+            do
+            {
+                --it;
+                if (it->first != ref_rit->first)
+                    return false;
+                ++ref_rit;
+            } while (it != m.begin());
+        }
+
+        return true;
+    }
+
+    bool btree_map_test()
+    {
+        typedef vogl::btree_map<int, dynamic_string> int_to_string_map;
+        typedef std::map<int, dynamic_string> std_int_to_string_map;
+
+        int_to_string_map m;
+        std_int_to_string_map ref;
+
+        if ((m.contains(0)) || (m.begin() != m.end()) || (m.erase(0)) || (!m.debug_check()))
+            return false;
+
+        fast_random frm;
+        frm.seed(5557);
+
+        // Random inserts and erases, so nodes are split, merged and rotated at every level.
+        for (uint pass = 0; pass < 4; pass++)
+        {
+            const int max_key = (pass & 1) ? 100000 : 500;
+
+            for (uint i = 0; i < 20000; i++)
+            {
+                int key = frm.irand(0, max_key);
+
+                if ((frm.urand32() % 3) || (pass == 3))
+                {
+                    dynamic_string val(cVarArg, "%i %u", key, i);
+
+                    bool inserted = m.insert(key, val).second;
+                    if (inserted != ref.insert(std::make_pair(key, val)).second)
+                        return false;
+                }
+                else
+                {
+                    if (m.erase(key) != (ref.erase(key) != 0))
+                        return false;
+                }
+
+                if ((i & 1023) == 0)
+                {
+                    if (!btree_map_matches(m, ref))
+                        return false;
+                }
+            }
+
+            if (!btree_map_matches(m, ref))
+                return false;
+
+            for (uint i = 0; i < 1000; i++)
+            {
+                int key = frm.irand(-1, max_key + 1);
+
+                const dynamic_string *pVal = m.find_value(key);
+                std_int_to_string_map::const_iterator ref_it(ref.find(key));
+                if ((pVal != NULL) != (ref_it != ref.end()))
+                    return false;
+                if ((pVal) && (*pVal != ref_it->second))
+                    return false;
+
+                int_to_string_map::const_iterator l_it(m.lower_bound(key));
+                std_int_to_string_map::const_iterator ref_l_it(ref.lower_bound(key));
+                if ((l_it == m.end()) != (ref_l_it == ref.end()))
+                    return false;
+                if ((l_it != m.end()) && (l_it->first != ref_l_it->first))
+                    return false;
+
+                int_to_string_map::const_iterator u_it(m.upper_bound(key));
+                std_int_to_string_map::const_iterator ref_u_it(ref.upper_bound(key));
+                if ((u_it == m.end()) != (ref_u_it == ref.end()))
+                    return false;
+                if ((u_it != m.end()) && (u_it->first != ref_u_it->first))
+                    return false;
+            }
+
+            // Erase most of the container through iterators, collapsing the tree.
+            if (pass == 2)
+            {
+                while (m.size() > 10)
+                {
+                    int_to_string_map::iterator it(m.find(ref.begin()->first));
+                    if (it == m.end())
+                        return false;
+                    m.erase(it);
+                    ref.erase(ref.begin());
+                }
+
+                if (!btree_map_matches(m, ref))
+                    return false;
+            }
+        }
+
+        if (m.get_depth() < 2)
+            return false;
+
+        // Copies and bulk loads.
+        int_to_string_map m2(m);
+        if ((m2 != m) || (!btree_map_matches(m2, ref)))
+            return false;
+
+        vogl::vector<std::pair<int, dynamic_string> > sorted;
+        for (uint n = 0; n < 3000; n += 1 + n / 4)
+        {
+            sorted.resize(0);
+            for (uint i = 0; i < n; i++)
+                sorted.push_back(std::make_pair(static_cast<int>(i * 3), dynamic_string(cVarArg, "%u", i)));
+
+            int_to_string_map bulk;
+            if (!bulk.assign_sorted(sorted.begin(), sorted.end()))
+                return false;
+
+            std_int_to_string_map bulk_ref(sorted.begin(), sorted.end());
+            if (!btree_map_matches(bulk, bulk_ref))
+                return false;
+
+            // The bulk loaded tree must still support updates.
+            for (uint i = 0; i < n; i += 2)
+            {
+                bulk.erase(static_cast<int>(i * 3));
+                bulk_ref.erase(static_cast<int>(i * 3));
+                bulk[static_cast<int>(i * 3 + 1)] = "x";
+                bulk_ref[static_cast<int>(i * 3 + 1)] = "x";
+            }
+            if (!btree_map_matches(bulk, bulk_ref))
+                return false;
+        }
+
+        if (sorted.size() > 1)
+        {
+            std::swap(sorted[0], sorted[1]);
+
+            int_to_string_map unsorted;
+            if ((unsorted.assign_sorted(sorted.begin(), sorted.end())) || (!unsorted.is_empty()) || (!unsorted.debug_check()))
+                return false;
+        }
+
+        m2.clear();
+        if ((m2.size()) || (m2.begin() != m2.end()) || (!m2.debug_check()))
+            return false;
+
+        m2.swap(m);
+        if ((m.size()) || (!btree_map_matches(m2, ref)))
+            return false;
+
+        return true;
+    }
+
+} // namespace vogl
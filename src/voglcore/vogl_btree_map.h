@@ -0,0 +1,1307 @@
+/**************************************************************************
+ *
+ * Copyright 2013-2014 RAD Game Tools and Valve Software
+ * Copyright 2010-2014 Rich Geldreich and Tenacious Software LLC
+ * All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ **************************************************************************/
+
+// File: vogl_btree_map.h
+// See https://en.wikipedia.org/wiki/B%2B_tree
+//
+// Notes:
+// vogl::btree_map is an ordered associative container implemented as a B+ tree, meant for large maps where vogl::map's
+// 1 malloc per object and pointer chasing hurt. Its interface is a subset of vogl::map's (unique keys only).
+//
+// Properties:
+// Objects are stored by value in leaves of up to cLeafSlots objects, leaves are doubly linked so iteration forwards or backwards
+// is constant time per step and touches memory sequentially. Inner nodes only hold separator keys and child pointers.
+// Unlike vogl::map, objects move: inserting or erasing invalidates all iterators and pointers into the container.
+// All leaves except the root are at least half full, so lookups are O(log n) with a very small constant.
+// assign_sorted() bulk loads the tree from a sorted range in O(n) with nearly full leaves, which is much faster than inserting.
+// The container is bitwise movable (the only self referencing node, the leaf list head, lives on the heap).
+#pragma once
+
+#include "vogl_core.h"
+#include "vogl_vector.h"
+
+namespace vogl
+{
+    // Using default template options, Key must support operator <.
+    template <typename Key, typename Value = empty_type,
+              typename LessComp = less_than<Key>,
+              typename EqualComp = equal_to_using_less_than<Key> >
+    class btree_map
+    {
+    public:
+        typedef btree_map<Key, Value, LessComp, EqualComp> btree_map_type;
+        typedef Key key_type;
+        typedef Value referent_type;
+        typedef std::pair<const Key, Value> value_type;
+        typedef LessComp less_comp_type;
+        typedef EqualComp equal_comp_type;
+
+        enum
+        {
+            // Leaves are roughly 512 bytes for small objects.
+            cLeafSlots = (sizeof(value_type) <= 16) ? 32 : ((sizeof(value_type) <= 32) ? 16 : 8),
+            cMinLeafValues = cLeafSlots / 2,
+            cInnerSlots = 32,
+            cMinInnerKeys = cInnerSlots / 2,
+            cMaxDepth = 32
+        };
+
+    private:
+        struct leaf_link
+        {
+            leaf_link *m_pPrev;
+            leaf_link *m_pNext;
+            uint m_num_values;
+        };
+
+        struct leaf_node : leaf_link
+        {
+            // Raw storage, only the first m_num_values objects are constructed.
+            uint64_t m_values[(sizeof(value_type) * cLeafSlots + sizeof(uint64_t) - 1) / sizeof(uint64_t)];
+
+            inline value_type *get_values()
+            {
+                return reinterpret_cast<value_type *>(m_values);
+            }
+            inline const value_type *get_values() const
+            {
+                return reinterpret_cast<const value_type *>(m_values);
+            }
+        };
+
+        // An inner node with n keys has n+1 children. All keys in child i are < key i, which is <= all keys in child i+1.
+        // Keys in inner nodes aren't necessarily present in the leaves, because erasing never updates them.
+        struct inner_node
+        {
+            uint m_num_keys;
+            void *m_pChildren[cInnerSlots + 1];
+            uint64_t m_keys[(sizeof(Key) * cInnerSlots + sizeof(uint64_t) - 1) / sizeof(uint64_t)];
+
+            inline Key *get_keys()
+            {
+                return reinterpret_cast<Key *>(m_keys);
+            }
+            inline const Key *get_keys() const
+            {
+                return reinterpret_cast<const Key *>(m_keys);
+            }
+        };
+
+    public:
+        template <typename DerivedType, typename Pointer, typename Reference>
+        class iterator_base
+        {
+        protected:
+            leaf_link *m_pLink;
+            uint m_index;
+
+            template <typename DerivedType2, typename Pointer2, typename Reference2>
+            friend class iterator_base;
+
+            inline iterator_base()
+                : m_pLink(NULL), m_index(0)
+            {
+            }
+
+            inline iterator_base(leaf_link *pLink, uint index)
+                : m_pLink(pLink), m_index(index)
+            {
+            }
+
+        public:
+            // post-increment
+            inline DerivedType operator++(int)
+            {
+                DerivedType result(static_cast<DerivedType &>(*this));
+                ++*this;
+                return result;
+            }
+
+            // pre-increment
+            inline DerivedType &operator++()
+            {
+                VOGL_ASSERT(m_pLink);
+                if ((m_pLink) && (++m_index >= m_pLink->m_num_values))
+                {
+                    m_pLink = m_pLink->m_pNext;
+                    m_index = 0;
+                }
+                return static_cast<DerivedType &>(*this);
+            }
+
+            // post-decrement
+            inline DerivedType operator--(int)
+            {
+                DerivedType result(static_cast<DerivedType &>(*this));
+                --*this;
+                return result;
+            }
+
+            // pre-decrement
+            inline DerivedType &operator--()
+            {
+                VOGL_ASSERT(m_pLink);
+                if (m_pLink)
+                {
+                    if (m_index)
+                        m_index--;
+                    else
+                    {
+                        m_pLink = m_pLink->m_pPrev;
+                        m_index = m_pLink->m_num_values ? (m_pLink->m_num_values - 1) : 0;
+                    }
+                }
+                return static_cast<DerivedType &>(*this);
+            }
+
+            inline Reference operator*() const
+            {
+                VOGL_ASSERT((m_pLink) && (m_index < m_pLink->m_num_values));
+                return static_cast<leaf_node *>(m_pLink)->get_values()[m_index];
+            }
+
+            inline Pointer operator->() const
+            {
+                VOGL_ASSERT((m_pLink) && (m_index < m_pLink->m_num_values));
+                return &static_cast<leaf_node *>(m_pLink)->get_values()[m_index];
+            }
+
+            template <typename DerivedType2, typename Pointer2, typename Reference2>
+            inline bool operator==(const iterator_base<DerivedType2, Pointer2, Reference2> &rhs) const
+            {
+                return (m_pLink == rhs.m_pLink) && (m_index == rhs.m_index);
+            }
+
+            template <typename DerivedType2, typename Pointer2, typename Reference2>
+            inline bool operator!=(const iterator_base<DerivedType2, Pointer2, Reference2> &rhs) const
+            {
+                return (m_pLink != rhs.m_pLink) || (m_index != rhs.m_index);
+            }
+        };
+
+        class iterator : public iterator_base<iterator, value_type *, value_type &>
+        {
+            friend class btree_map;
+            friend class const_iterator;
+
+            inline iterator(leaf_link *pLink, uint index)
+                : iterator_base<iterator, value_type *, value_type &>(pLink, index)
+            {
+            }
+
+        public:
+            inline iterator()
+            {
+            }
+        };
+
+        class const_iterator : public iterator_base<const_iterator, const value_type *, const value_type &>
+        {
+            friend class btree_map;
+            friend class iterator;
+
+            inline const_iterator(leaf_link *pLink, uint index)
+                : iterator_base<const_iterator, const value_type *, const value_type &>(pLink, index)
+            {
+            }
+
+        public:
+            inline const_iterator()
+            {
+            }
+
+            inline const_iterator(iterator itr)
+                : iterator_base<const_iterator, const value_type *, const value_type &>(itr.m_pLink, itr.m_index)
+            {
+            }
+        };
+
+        inline btree_map(const LessComp &less_than_obj = less_comp_type(), const EqualComp &equal_to_obj = equal_comp_type())
+            : m_pHead(NULL),
+              m_pRoot(NULL),
+              m_depth(0),
+              m_size(0),
+              m_is_key_less_than(less_than_obj),
+              m_is_key_equal_to(equal_to_obj)
+        {
+        }
+
+        inline btree_map(const btree_map &other)
+            : m_pHead(NULL),
+              m_pRoot(NULL),
+              m_depth(0),
+              m_size(0),
+              m_is_key_less_than(other.m_is_key_less_than),
+              m_is_key_equal_to(other.m_is_key_equal_to)
+        {
+            assign_sorted(other.begin(), other.end());
+        }
+
+        inline btree_map &operator=(const btree_map &rhs)
+        {
+            if (this == &rhs)
+                return *this;
+
+            clear();
+
+            m_is_key_less_than = rhs.m_is_key_less_than;
+            m_is_key_equal_to = rhs.m_is_key_equal_to;
+
+            assign_sorted(rhs.begin(), rhs.end());
+
+            return *this;
+        }
+
+#if VOGL_HAS_MOVE_SEMANTICS
+        inline btree_map(btree_map &&other)
+            : m_pHead(NULL),
+              m_pRoot(NULL),
+              m_depth(0),
+              m_size(0),
+              m_is_key_less_than(other.m_is_key_less_than),
+              m_is_key_equal_to(other.m_is_key_equal_to)
+        {
+            swap(other);
+        }
+
+        inline btree_map &operator=(btree_map &&rhs)
+        {
+            if (this != &rhs)
+            {
+                clear();
+                swap(rhs);
+            }
+            return *this;
+        }
+#endif
+
+        inline ~btree_map()
+        {
+            clear();
+
+            vogl_free(m_pHead);
+        }
+
+        inline void clear()
+        {
+            if (m_pRoot)
+                free_subtree(m_pRoot, m_depth);
+
+            m_pRoot = NULL;
+            m_depth = 0;
+            m_size = 0;
+
+            if (m_pHead)
+            {
+                m_pHead->m_pPrev = m_pHead;
+                m_pHead->m_pNext = m_pHead;
+            }
+        }
+
+        // An empty container that has never been inserted into has no list head yet, so begin() == end() == a NULL iterator.
+        inline iterator begin()
+        {
+            return m_pHead ? iterator(m_pHead->m_pNext, 0) : iterator();
+        }
+        inline const_iterator begin() const
+        {
+            return m_pHead ? const_iterator(m_pHead->m_pNext, 0) : const_iterator();
+        }
+
+        inline iterator end()
+        {
+            return m_pHead ? iterator(m_pHead, 0) : iterator();
+        }
+        inline const_iterator end() const
+        {
+            return m_pHead ? const_iterator(m_pHead, 0) : const_iterator();
+        }
+
+        inline uint size() const
+        {
+            return m_size;
+        }
+
+        inline bool is_empty() const
+        {
+            return !m_size;
+        }
+
+        // Number of inner node levels above the leaves.
+        inline uint get_depth() const
+        {
+            return m_depth;
+        }
+
+        inline const LessComp &get_less() const
+        {
+            return m_is_key_less_than;
+        }
+
+        inline const EqualComp &get_equals() const
+        {
+            return m_is_key_equal_to;
+        }
+
+        typedef std::pair<iterator, bool> insert_result;
+
+        // insert_result.first will always point to inserted key/value (or the already existing key/value).
+        // insert_result.second will be true if a new key/value was inserted, or false if the key already existed (in which case first will point to the already existing value).
+        insert_result insert(const Key &key, const Value &value = Value())
+        {
+            if (!m_pRoot)
+            {
+                if (!m_pHead)
+                {
+                    m_pHead = static_cast<leaf_link *>(vogl_malloc(sizeof(leaf_link)));
+                    m_pHead->m_pPrev = m_pHead;
+                    m_pHead->m_pNext = m_pHead;
+                    m_pHead->m_num_values = 0;
+                }
+
+                leaf_node *pLeaf = alloc_leaf();
+                link_leaf_after(pLeaf, m_pHead);
+
+                m_pRoot = pLeaf;
+            }
+
+            inner_node *pPath[cMaxDepth];
+            uint child_index[cMaxDepth];
+
+            leaf_node *pLeaf = find_leaf(key, pPath, child_index);
+
+            uint pos = leaf_lower_bound(pLeaf, key);
+            if ((pos < pLeaf->m_num_values) && (m_is_key_equal_to(pLeaf->get_values()[pos].first, key)))
+                return std::make_pair(iterator(pLeaf, pos), false);
+
+            if (m_size == cUINT32_MAX)
+            {
+                VOGL_ASSERT_ALWAYS;
+                return std::make_pair(end(), false);
+            }
+
+            if (pLeaf->m_num_values < static_cast<uint>(cLeafSlots))
+            {
+                insert_into_leaf(pLeaf, pos, key, value);
+                m_size++;
+                return std::make_pair(iterator(pLeaf, pos), true);
+            }
+
+            // Split the full leaf in half. (Use assign_sorted() to build large containers from sorted data, ascending inserts leave leaves half full.)
+            leaf_node *pRight = alloc_leaf();
+            link_leaf_after(pRight, pLeaf);
+
+            const uint split = cLeafSlots / 2;
+            move_values(pRight->get_values(), pLeaf->get_values() + split, cLeafSlots - split);
+            pRight->m_num_values = cLeafSlots - split;
+            pLeaf->m_num_values = split;
+
+            leaf_node *pDst_leaf = pLeaf;
+            if (pos > split)
+            {
+                pDst_leaf = pRight;
+                pos -= split;
+            }
+
+            insert_into_leaf(pDst_leaf, pos, key, value);
+            m_size++;
+
+            insert_into_parents(pPath, child_index, pRight->get_values()[0].first, pRight);
+
+            return std::make_pair(iterator(pDst_leaf, pos), true);
+        }
+
+        inline insert_result insert(const value_type &value)
+        {
+            return insert(value.first, value.second);
+        }
+
+        inline Value &operator[](const Key &key)
+        {
+            return (insert(key).first)->second;
+        }
+
+        // Returns const ref to value if key is found, otherwise returns the default.
+        inline const Value &value(const Key &key, const Value &def = Value()) const
+        {
+            const Value *pValue = find_value(key);
+            return pValue ? *pValue : def;
+        }
+
+        // iterator->first is the key, iterator->second is the value, or returns end() if the key cannot be found
+        inline const_iterator find(const Key &key) const
+        {
+            const_iterator it(lower_bound(key));
+            if ((it != end()) && (m_is_key_equal_to(it->first, key)))
+                return it;
+            return end();
+        }
+
+        // iterator->first is the key, iterator->second is the value, or returns end() if the key cannot be found
+        inline iterator find(const Key &key)
+        {
+            iterator it(lower_bound(key));
+            if ((it != end()) && (m_is_key_equal_to(it->first, key)))
+                return it;
+            return end();
+        }
+
+        // Return pointer to the value associated with key, or NULL if it doesn't exist.
+        inline Value *find_value(const Key &key)
+        {
+            return const_cast<Value *>(static_cast<const btree_map *>(this)->find_value(key));
+        }
+
+        // Return pointer to the value associated with key, or NULL if it doesn't exist.
+        inline const Value *find_value(const Key &key) const
+        {
+            if (!m_pRoot)
+                return NULL;
+
+            const leaf_node *pLeaf = find_leaf(key, NULL, NULL);
+
+            uint pos = leaf_lower_bound(pLeaf, key);
+            if ((pos < pLeaf->m_num_values) && (m_is_key_equal_to(pLeaf->get_values()[pos].first, key)))
+                return &pLeaf->get_values()[pos].second;
+
+            return NULL;
+        }
+
+        // true if the key is found.
+        inline bool contains(const Key &key) const
+        {
+            return find_value(key) != NULL;
+        }
+
+        // Returns an iterator pointing to the first item with a key >= key, or end().
+        inline const_iterator lower_bound(const Key &key) const
+        {
+            if (!m_pRoot)
+                return end();
+
+            leaf_node *pLeaf = find_leaf(key, NULL, NULL);
+
+            uint pos = leaf_lower_bound(pLeaf, key);
+            if (pos < pLeaf->m_num_values)
+                return const_iterator(pLeaf, pos);
+
+            return const_iterator(pLeaf->m_pNext, 0);
+        }
+
+        inline iterator lower_bound(const Key &key)
+        {
+            const_iterator it(static_cast<const btree_map *>(this)->lower_bound(key));
+            return iterator(it.m_pLink, it.m_index);
+        }
+
+        // Returns an iterator pointing to the first item with a key > key, or end().
+        inline const_iterator upper_bound(const Key &key) const
+        {
+            const_iterator it(lower_bound(key));
+            if ((it != end()) && (m_is_key_equal_to(it->first, key)))
+                ++it;
+            return it;
+        }
+
+        inline iterator upper_bound(const Key &key)
+        {
+            const_iterator it(static_cast<const btree_map *>(this)->upper_bound(key));
+            return iterator(it.m_pLink, it.m_index);
+        }
+
+        // Erases the item associated with the specified key. Returns false if the key wasn't found.
+        bool erase(const Key &key)
+        {
+            if (!m_pRoot)
+                return false;
+
+            inner_node *pPath[cMaxDepth];
+            uint child_index[cMaxDepth];
+
+            leaf_node *pLeaf = find_leaf(key, pPath, child_index);
+
+            uint pos = leaf_lower_bound(pLeaf, key);
+            if ((pos >= pLeaf->m_num_values) || (!m_is_key_equal_to(pLeaf->get_values()[pos].first, key)))
+                return false;
+
+            // Be careful, key is a ref and it could be freed here!
+            erase_from_leaf(pLeaf, pos);
+            m_size--;
+
+            if (!m_depth)
+            {
+                if (!pLeaf->m_num_values)
+                {
+                    unlink_leaf(pLeaf);
+                    free_leaf(pLeaf);
+                    m_pRoot = NULL;
+                }
+                return true;
+            }
+
+            if (pLeaf->m_num_values < static_cast<uint>(cMinLeafValues))
+                rebalance_leaf(pLeaf, pPath, child_index);
+
+            return true;
+        }
+
+        // Erases the item the iterator points to. Invalidates all iterators.
+        inline void erase(const iterator &it)
+        {
+            VOGL_ASSERT((it.m_pLink) && (it.m_index < it.m_pLink->m_num_values));
+
+            // The key must be copied, erase(key) shifts the leaf's objects.
+            Key key(it->first);
+
+            bool success = erase(key);
+            VOGL_ASSERT(success);
+            VOGL_NOTE_UNUSED(success);
+        }
+
+        // Replaces the container's contents with the range [first, last), which must be sorted by key with no duplicates.
+        // Returns false (leaving the container empty) if the range isn't sorted.
+        template <typename InputIterator>
+        bool assign_sorted(InputIterator first, InputIterator last)
+        {
+            clear();
+
+            if (first == last)
+                return true;
+
+            // Fill the leaves first, checking the order as we go.
+            vogl::vector<leaf_node *> leaves;
+
+            leaf_node *pLeaf = NULL;
+            const Key *pPrev_key = NULL;
+            for (; first != last; ++first)
+            {
+                if ((pPrev_key) && (!m_is_key_less_than(*pPrev_key, first->first)))
+                {
+                    for (uint i = 0; i < leaves.size(); i++)
+                        free_leaf(leaves[i]);
+                    return false;
+                }
+
+                if ((!pLeaf) || (pLeaf->m_num_values == static_cast<uint>(cLeafSlots)))
+                {
+                    pLeaf = alloc_leaf();
+                    leaves.push_back(pLeaf);
+                }
+
+                value_type *pDst = pLeaf->get_values() + pLeaf->m_num_values;
+                new (static_cast<void *>(pDst)) value_type(first->first, first->second);
+                pLeaf->m_num_values++;
+
+                pPrev_key = &pDst->first;
+            }
+
+            // The last leaf may be underfull, even it out with its neighbor.
+            if ((leaves.size() > 1) && (leaves.back()->m_num_values < static_cast<uint>(cMinLeafValues)))
+            {
+                leaf_node *pLast = leaves.back();
+                leaf_node *pPrev = leaves[leaves.size() - 2];
+
+                uint total = pPrev->m_num_values + pLast->m_num_values;
+                uint n = pPrev->m_num_values - total / 2;
+
+                move_values(pLast->get_values() + n, pLast->get_values(), pLast->m_num_values);
+                move_values(pLast->get_values(), pPrev->get_values() + pPrev->m_num_values - n, n);
+                pPrev->m_num_values -= n;
+                pLast->m_num_values += n;
+            }
+
+            if (!m_pHead)
+            {
+                m_pHead = static_cast<leaf_link *>(vogl_malloc(sizeof(leaf_link)));
+                m_pHead->m_num_values = 0;
+            }
+
+            leaf_link *pPrev_link = m_pHead;
+            for (uint i = 0; i < leaves.size(); i++)
+            {
+                leaves[i]->m_pPrev = pPrev_link;
+                pPrev_link->m_pNext = leaves[i];
+                pPrev_link = leaves[i];
+                m_size += leaves[i]->m_num_values;
+            }
+            pPrev_link->m_pNext = m_pHead;
+            m_pHead->m_pPrev = pPrev_link;
+
+            // Now build the inner levels bottom up. Each node's smallest key is the separator in its parent.
+            vogl::vector<void *> nodes(leaves.size());
+            vogl::vector<const Key *> min_keys(leaves.size());
+            for (uint i = 0; i < leaves.size(); i++)
+            {
+                nodes[i] = leaves[i];
+                min_keys[i] = &leaves[i]->get_values()[0].first;
+            }
+
+            while (nodes.size() > 1)
+            {
+                const uint num_children = nodes.size();
+                const uint num_parents = (num_children + cInnerSlots) / (cInnerSlots + 1);
+
+                uint cur_child = 0;
+                for (uint i = 0; i < num_parents; i++)
+                {
+                    // Spread the children evenly, so every node is at least half full.
+                    const uint n = (num_children / num_parents) + ((i < (num_children % num_parents)) ? 1 : 0);
+
+                    inner_node *pInner = alloc_inner();
+                    for (uint j = 0; j < n; j++)
+                    {
+                        pInner->m_pChildren[j] = nodes[cur_child + j];
+                        if (j)
+                            helpers::construct(pInner->get_keys() + (j - 1), *min_keys[cur_child + j]);
+                    }
+                    pInner->m_num_keys = n - 1;
+
+                    nodes[i] = pInner;
+                    min_keys[i] = min_keys[cur_child];
+
+                    cur_child += n;
+                }
+
+                nodes.resize(num_parents);
+                min_keys.resize(num_parents);
+                m_depth++;
+            }
+
+            m_pRoot = nodes[0];
+
+            return true;
+        }
+
+        // Appends all keys to the specified vector.
+        inline vogl::vector<Key> &get_keys(vogl::vector<Key> &vec) const
+        {
+            vec.reserve(vec.size() + m_size);
+
+            for (const_iterator it = begin(); it != end(); ++it)
+                vec.push_back(it->first);
+
+            return vec;
+        }
+
+        // Appends all values to the specified vector.
+        inline vogl::vector<Value> &get_values(vogl::vector<Value> &vec) const
+        {
+            vec.reserve(vec.size() + m_size);
+
+            for (const_iterator it = begin(); it != end(); ++it)
+                vec.push_back(it->second);
+
+            return vec;
+        }
+
+        inline void swap(btree_map &other)
+        {
+            std::swap(m_pHead, other.m_pHead);
+            std::swap(m_pRoot, other.m_pRoot);
+            std::swap(m_depth, other.m_depth);
+            std::swap(m_size, other.m_size);
+            std::swap(m_is_key_less_than, other.m_is_key_less_than);
+            std::swap(m_is_key_equal_to, other.m_is_key_equal_to);
+        }
+
+        // Compares this container's full contents to another.
+        inline bool operator==(const btree_map &rhs) const
+        {
+            if (this == &rhs)
+                return true;
+
+            if (m_size != rhs.m_size)
+                return false;
+
+            const_iterator lhs_it(begin());
+            const_iterator rhs_it(rhs.begin());
+
+            while (lhs_it != end())
+            {
+                VOGL_ASSERT(rhs_it != rhs.end());
+
+                if (*lhs_it != *rhs_it)
+                    return false;
+
+                ++lhs_it;
+                ++rhs_it;
+            }
+
+            return true;
+        }
+
+        inline bool operator!=(const btree_map &rhs) const
+        {
+            return !(*this == rhs);
+        }
+
+        // Returns false if the container is invalid/corrupted.
+        bool debug_check() const
+        {
+            if (!m_pRoot)
+            {
+                if (m_size || m_depth)
+                    return false;
+                if ((m_pHead) && ((m_pHead->m_pNext != m_pHead) || (m_pHead->m_pPrev != m_pHead)))
+                    return false;
+                return true;
+            }
+
+            if ((!m_pHead) || (m_pHead->m_num_values))
+                return false;
+
+            uint total_values = 0;
+            const leaf_link *pExpected_leaf = m_pHead->m_pNext;
+            if (!debug_check_subtree(m_pRoot, m_depth, NULL, NULL, true, total_values, pExpected_leaf))
+                return false;
+
+            if ((total_values != m_size) || (pExpected_leaf != m_pHead))
+                return false;
+
+            // Walk the leaf list backwards, checking the links and order.
+            uint n = 0;
+            const Key *pNext_key = NULL;
+            for (const leaf_link *pLink = m_pHead->m_pPrev; pLink != m_pHead; pLink = pLink->m_pPrev)
+            {
+                if (pLink->m_pNext->m_pPrev != pLink)
+                    return false;
+
+                const leaf_node *pLeaf = static_cast<const leaf_node *>(pLink);
+                for (int i = pLeaf->m_num_values - 1; i >= 0; i--)
+                {
+                    if ((pNext_key) && (!m_is_key_less_than(pLeaf->get_values()[i].first, *pNext_key)))
+                        return false;
+                    pNext_key = &pLeaf->get_values()[i].first;
+                    n++;
+                }
+            }
+
+            return n == m_size;
+        }
+
+    private:
+        leaf_link *m_pHead;
+        void *m_pRoot;
+        uint m_depth;
+        uint m_size;
+
+        LessComp m_is_key_less_than;
+        EqualComp m_is_key_equal_to;
+
+        // Moves n objects from pSrc to the uninitialized pDst, leaving pSrc uninitialized. The ranges may overlap.
+        template <typename T>
+        static inline void move_objects(T *pDst, T *pSrc, uint n, bool bitwise)
+        {
+            if ((pDst == pSrc) || (!n))
+                return;
+
+            if (bitwise)
+                memmove(static_cast<void *>(pDst), pSrc, sizeof(T) * n);
+            else if (pDst < pSrc)
+            {
+                for (uint i = 0; i < n; i++)
+                {
+                    new (static_cast<void *>(pDst + i)) T(VOGL_MOVE(pSrc[i]));
+                    helpers::destruct(pSrc + i);
+                }
+            }
+            else
+            {
+                for (uint i = n; i > 0; i--)
+                {
+                    new (static_cast<void *>(pDst + i - 1)) T(VOGL_MOVE(pSrc[i - 1]));
+                    helpers::destruct(pSrc + i - 1);
+                }
+            }
+        }
+
+        // The traits are checked here, not in a class scope enum, so containers can be members of classes declared bitwise movable after them.
+        static inline void move_values(value_type *pDst, value_type *pSrc, uint n)
+        {
+            move_objects(pDst, pSrc, n, VOGL_IS_BITWISE_COPYABLE_OR_MOVABLE(Key) && VOGL_IS_BITWISE_COPYABLE_OR_MOVABLE(Value));
+        }
+
+        static inline void move_keys(Key *pDst, Key *pSrc, uint n)
+        {
+            move_objects(pDst, pSrc, n, VOGL_IS_BITWISE_COPYABLE_OR_MOVABLE(Key));
+        }
+
+        static inline void move_children(void **ppDst, void **ppSrc, uint n)
+        {
+            memmove(ppDst, ppSrc, sizeof(void *) * n);
+        }
+
+        inline leaf_node *alloc_leaf()
+        {
+            leaf_node *pLeaf = static_cast<leaf_node *>(vogl_malloc(sizeof(leaf_node)));
+            pLeaf->m_pPrev = NULL;
+            pLeaf->m_pNext = NULL;
+            pLeaf->m_num_values = 0;
+            return pLeaf;
+        }
+
+        inline void free_leaf(leaf_node *pLeaf)
+        {
+            helpers::destruct_array(pLeaf->get_values(), pLeaf->m_num_values);
+            vogl_free(pLeaf);
+        }
+
+        inline inner_node *alloc_inner()
+        {
+            inner_node *pInner = static_cast<inner_node *>(vogl_malloc(sizeof(inner_node)));
+            pInner->m_num_keys = 0;
+            return pInner;
+        }
+
+        inline void free_inner(inner_node *pInner)
+        {
+            helpers::destruct_array(pInner->get_keys(), pInner->m_num_keys);
+            vogl_free(pInner);
+        }
+
+        void free_subtree(void *pNode, uint depth)
+        {
+            if (!depth)
+            {
+                free_leaf(static_cast<leaf_node *>(pNode));
+                return;
+            }
+
+            inner_node *pInner = static_cast<inner_node *>(pNode);
+            for (uint i = 0; i <= pInner->m_num_keys; i++)
+                free_subtree(pInner->m_pChildren[i], depth - 1);
+
+            free_inner(pInner);
+        }
+
+        static inline void link_leaf_after(leaf_node *pLeaf, leaf_link *pPrev)
+        {
+            pLeaf->m_pPrev = pPrev;
+            pLeaf->m_pNext = pPrev->m_pNext;
+            pPrev->m_pNext->m_pPrev = pLeaf;
+            pPrev->m_pNext = pLeaf;
+        }
+
+        static inline void unlink_leaf(leaf_node *pLeaf)
+        {
+            pLeaf->m_pPrev->m_pNext = pLeaf->m_pNext;
+            pLeaf->m_pNext->m_pPrev = pLeaf->m_pPrev;
+        }
+
+        // Index of the child of pInner whose subtree may contain key.
+        inline uint inner_child_index(const inner_node *pInner, const Key &key) const
+        {
+            const Key *pKeys = pInner->get_keys();
+
+            uint l = 0, h = pInner->m_num_keys;
+            while (l < h)
+            {
+                uint m = (l + h) >> 1;
+                if (m_is_key_less_than(key, pKeys[m]))
+                    h = m;
+                else
+                    l = m + 1;
+            }
+
+            return l;
+        }
+
+        // Index of the first object in pLeaf with a key >= key.
+        inline uint leaf_lower_bound(const leaf_node *pLeaf, const Key &key) const
+        {
+            const value_type *pValues = pLeaf->get_values();
+
+            uint l = 0, h = pLeaf->m_num_values;
+            while (l < h)
+            {
+                uint m = (l + h) >> 1;
+                if (m_is_key_less_than(pValues[m].first, key))
+                    l = m + 1;
+                else
+                    h = m;
+            }
+
+            return l;
+        }
+
+        // Returns the leaf that may contain key. If pPath isn't NULL, it receives the inner nodes visited (root first) and the child index taken in each.
+        inline leaf_node *find_leaf(const Key &key, inner_node **pPath, uint *pChild_index) const
+        {
+            void *pNode = m_pRoot;
+
+            for (uint level = 0; level < m_depth; level++)
+            {
+                inner_node *pInner = static_cast<inner_node *>(pNode);
+                uint index = inner_child_index(pInner, key);
+
+                if (pPath)
+                {
+                    pPath[level] = pInner;
+                    pChild_index[level] = index;
+                }
+
+                pNode = pInner->m_pChildren[index];
+            }
+
+            return static_cast<leaf_node *>(pNode);
+        }
+
+        inline void insert_into_leaf(leaf_node *pLeaf, uint pos, const Key &key, const Value &value)
+        {
+            VOGL_ASSERT((pLeaf->m_num_values < static_cast<uint>(cLeafSlots)) && (pos <= pLeaf->m_num_values));
+
+            value_type *pValues = pLeaf->get_values();
+            move_values(pValues + pos + 1, pValues + pos, pLeaf->m_num_values - pos);
+            new (static_cast<void *>(pValues + pos)) value_type(key, value);
+
+            pLeaf->m_num_values++;
+        }
+
+        inline void erase_from_leaf(leaf_node *pLeaf, uint pos)
+        {
+            VOGL_ASSERT(pos < pLeaf->m_num_values);
+
+            value_type *pValues = pLeaf->get_values();
+            helpers::destruct(pValues + pos);
+            move_values(pValues + pos, pValues + pos + 1, pLeaf->m_num_values - pos - 1);
+
+            pLeaf->m_num_values--;
+        }
+
+        // Inserts separator key and new right sibling pNew_node into the parent of the node at depth m_depth (the leaf), splitting inner nodes as needed.
+        void insert_into_parents(inner_node **pPath, const uint *pChild_index, const Key &separator, void *pNew_node)
+        {
+            Key key(separator);
+            void *pChild = pNew_node;
+
+            for (int level = static_cast<int>(m_depth) - 1; level >= 0; level--)
+            {
+                inner_node *pInner = pPath[level];
+                uint index = pChild_index[level];
+
+                if (pInner->m_num_keys < static_cast<uint>(cInnerSlots))
+                {
+                    insert_into_inner(pInner, index, key, pChild);
+                    return;
+                }
+
+                // Split the full inner node. Of the cInnerSlots + 1 keys (including the new one) the middle one moves up, so both halves end up with cInnerSlots / 2 keys.
+                const uint mid = cInnerSlots / 2;
+
+                inner_node *pRight = alloc_inner();
+
+                if (index == mid)
+                {
+                    // The new key itself moves up, and its child becomes the right node's first child.
+                    move_keys(pRight->get_keys(), pInner->get_keys() + mid, cInnerSlots - mid);
+                    move_children(pRight->m_pChildren + 1, pInner->m_pChildren + mid + 1, cInnerSlots - mid);
+                    pRight->m_pChildren[0] = pChild;
+                    pRight->m_num_keys = cInnerSlots - mid;
+                    pInner->m_num_keys = mid;
+                }
+                else
+                {
+                    const uint split = (index < mid) ? (mid - 1) : mid;
+
+                    move_keys(pRight->get_keys(), pInner->get_keys() + split + 1, cInnerSlots - split - 1);
+                    move_children(pRight->m_pChildren, pInner->m_pChildren + split + 1, cInnerSlots - split);
+                    pRight->m_num_keys = cInnerSlots - split - 1;
+
+                    Key up_key(pInner->get_keys()[split]);
+                    helpers::destruct(pInner->get_keys() + split);
+                    pInner->m_num_keys = split;
+
+                    if (index < mid)
+                        insert_into_inner(pInner, index, key, pChild);
+                    else
+                        insert_into_inner(pRight, index - split - 1, key, pChild);
+
+                    key = up_key;
+                }
+
+                pChild = pRight;
+            }
+
+            // The root split, grow the tree by one level.
+            inner_node *pNew_root = alloc_inner();
+            pNew_root->m_pChildren[0] = m_pRoot;
+            pNew_root->m_pChildren[1] = pChild;
+            helpers::construct(pNew_root->get_keys(), key);
+            pNew_root->m_num_keys = 1;
+
+            m_pRoot = pNew_root;
+            m_depth++;
+
+            VOGL_ASSERT(m_depth < static_cast<uint>(cMaxDepth));
+        }
+
+        // Inserts key at key index index, and pChild immediately to its right.
+        inline void insert_into_inner(inner_node *pInner, uint index, const Key &key, void *pChild)
+        {
+            VOGL_ASSERT((pInner->m_num_keys < static_cast<uint>(cInnerSlots)) && (index <= pInner->m_num_keys));
+
+            move_keys(pInner->get_keys() + index + 1, pInner->get_keys() + index, pInner->m_num_keys - index);
+            helpers::construct(pInner->get_keys() + index, key);
+
+            move_children(pInner->m_pChildren + index + 2, pInner->m_pChildren + index + 1, pInner->m_num_keys - index);
+            pInner->m_pChildren[index + 1] = pChild;
+
+            pInner->m_num_keys++;
+        }
+
+        // Removes key index index and the child immediately to its right.
+        inline void erase_from_inner(inner_node *pInner, uint index)
+        {
+            VOGL_ASSERT(index < pInner->m_num_keys);
+
+            helpers::destruct(pInner->get_keys() + index);
+            move_keys(pInner->get_keys() + index, pInner->get_keys() + index + 1, pInner->m_num_keys - index - 1);
+
+            move_children(pInner->m_pChildren + index + 1, pInner->m_pChildren + index + 2, pInner->m_num_keys - index - 1);
+
+            pInner->m_num_keys--;
+        }
+
+        // Fixes up an underfull non-root leaf by borrowing from or merging with a sibling.
+        void rebalance_leaf(leaf_node *pLeaf, inner_node **pPath, const uint *pChild_index)
+        {
+            inner_node *pParent = pPath[m_depth - 1];
+            uint index = pChild_index[m_depth - 1];
+
+            leaf_node *pLeft = index ? static_cast<leaf_node *>(pParent->m_pChildren[index - 1]) : NULL;
+            leaf_node *pRight = (index < pParent->m_num_keys) ? static_cast<leaf_node *>(pParent->m_pChildren[index + 1]) : NULL;
+
+            if ((pLeft) && (pLeft->m_num_values > static_cast<uint>(cMinLeafValues)))
+            {
+                move_values(pLeaf->get_values() + 1, pLeaf->get_values(), pLeaf->m_num_values);
+                move_values(pLeaf->get_values(), pLeft->get_values() + pLeft->m_num_values - 1, 1);
+                pLeft->m_num_values--;
+                pLeaf->m_num_values++;
+
+                pParent->get_keys()[index - 1] = pLeaf->get_values()[0].first;
+                return;
+            }
+
+            if ((pRight) && (pRight->m_num_values > static_cast<uint>(cMinLeafValues)))
+            {
+                move_values(pLeaf->get_values() + pLeaf->m_num_values, pRight->get_values(), 1);
+                move_values(pRight->get_values(), pRight->get_values() + 1, pRight->m_num_values - 1);
+                pRight->m_num_values--;
+                pLeaf->m_num_values++;
+
+                pParent->get_keys()[index] = pRight->get_values()[0].first;
+                return;
+            }
+
+            // Merge with a sibling, the right node of the pair is freed.
+            if (pLeft)
+            {
+                merge_leaves(pLeft, pLeaf);
+                erase_from_inner(pParent, index - 1);
+            }
+            else
+            {
+                VOGL_ASSERT(pRight);
+                merge_leaves(pLeaf, pRight);
+                erase_from_inner(pParent, index);
+            }
+
+            rebalance_inner(m_depth - 1, pPath, pChild_index);
+        }
+
+        inline void merge_leaves(leaf_node *pLeft, leaf_node *pRight)
+        {
+            VOGL_ASSERT(pLeft->m_num_values + pRight->m_num_values <= static_cast<uint>(cLeafSlots));
+
+            move_values(pLeft->get_values() + pLeft->m_num_values, pRight->get_values(), pRight->m_num_values);
+            pLeft->m_num_values += pRight->m_num_values;
+            pRight->m_num_values = 0;
+
+            unlink_leaf(pRight);
+            free_leaf(pRight);
+        }
+
+        // Fixes up the inner node at the specified level after it lost a key, shrinking the tree if the root becomes empty.
+        void rebalance_inner(uint level, inner_node **pPath, const uint *pChild_index)
+        {
+            inner_node *pInner = pPath[level];
+
+            if (!level)
+            {
+                if (!pInner->m_num_keys)
+                {
+                    m_pRoot = pInner->m_pChildren[0];
+                    m_depth--;
+                    free_inner(pInner);
+                }
+                return;
+            }
+
+            if (pInner->m_num_keys >= static_cast<uint>(cMinInnerKeys))
+                return;
+
+            inner_node *pParent = pPath[level - 1];
+            uint index = pChild_index[level - 1];
+
+            inner_node *pLeft = index ? static_cast<inner_node *>(pParent->m_pChildren[index - 1]) : NULL;
+            inner_node *pRight = (index < pParent->m_num_keys) ? static_cast<inner_node *>(pParent->m_pChildren[index + 1]) : NULL;
+
+            if ((pLeft) && (pLeft->m_num_keys > static_cast<uint>(cMinInnerKeys)))
+            {
+                // Rotate right: the parent's separator moves down, the left sibling's last key moves up.
+                move_keys(pInner->get_keys() + 1, pInner->get_keys(), pInner->m_num_keys);
+                move_children(pInner->m_pChildren + 1, pInner->m_pChildren, pInner->m_num_keys + 1);
+
+                move_keys(pInner->get_keys(), pParent->get_keys() + index - 1, 1);
+                pInner->m_pChildren[0] = pLeft->m_pChildren[pLeft->m_num_keys];
+                pInner->m_num_keys++;
+
+                move_keys(pParent->get_keys() + index - 1, pLeft->get_keys() + pLeft->m_num_keys - 1, 1);
+                pLeft->m_num_keys--;
+                return;
+            }
+
+            if ((pRight) && (pRight->m_num_keys > static_cast<uint>(cMinInnerKeys)))
+            {
+                // Rotate left: the parent's separator moves down, the right sibling's first key moves up.
+                move_keys(pInner->get_keys() + pInner->m_num_keys, pParent->get_keys() + index, 1);
+                pInner->m_pChildren[pInner->m_num_keys + 1] = pRight->m_pChildren[0];
+                pInner->m_num_keys++;
+
+                move_keys(pParent->get_keys() + index, pRight->get_keys(), 1);
+                move_keys(pRight->get_keys(), pRight->get_keys() + 1, pRight->m_num_keys - 1);
+                move_children(pRight->m_pChildren, pRight->m_pChildren + 1, pRight->m_num_keys);
+                pRight->m_num_keys--;
+                return;
+            }
+
+            if (pLeft)
+            {
+                merge_inners(pLeft, pParent, index - 1, pInner);
+                erase_from_inner(pParent, index - 1);
+            }
+            else
+            {
+                VOGL_ASSERT(pRight);
+                merge_inners(pInner, pParent, index, pRight);
+                erase_from_inner(pParent, index);
+            }
+
+            rebalance_inner(level - 1, pPath, pChild_index);
+        }
+
+        // Appends the parent's separator key and pRight's contents to pLeft, then frees pRight.
+        inline void merge_inners(inner_node *pLeft, inner_node *pParent, uint separator_index, inner_node *pRight)
+        {
+            VOGL_ASSERT(pLeft->m_num_keys + 1 + pRight->m_num_keys <= static_cast<uint>(cInnerSlots));
+
+            helpers::construct(pLeft->get_keys() + pLeft->m_num_keys, pParent->get_keys()[separator_index]);
+            move_keys(pLeft->get_keys() + pLeft->m_num_keys + 1, pRight->get_keys(), pRight->m_num_keys);
+            move_children(pLeft->m_pChildren + pLeft->m_num_keys + 1, pRight->m_pChildren, pRight->m_num_keys + 1);
+
+            pLeft->m_num_keys += 1 + pRight->m_num_keys;
+            pRight->m_num_keys = 0;
+
+            free_inner(pRight);
+        }
+
+        // Checks node fill, key bounds (lower <= keys < upper) and that leaves are linked in tree order.
+        bool debug_check_subtree(const void *pNode, uint depth, const Key *pLower, const Key *pUpper, bool is_root, uint &total_values, const leaf_link *&pExpected_leaf) const
+        {
+            if (!depth)
+            {
+                const leaf_node *pLeaf = static_cast<const leaf_node *>(pNode);
+                if (pLeaf != pExpected_leaf)
+                    return false;
+                pExpected_leaf = pLeaf->m_pNext;
+
+                if ((pLeaf->m_num_values > static_cast<uint>(cLeafSlots)) || (!pLeaf->m_num_values))
+                    return false;
+                if ((!is_root) && (pLeaf->m_num_values < static_cast<uint>(cMinLeafValues)))
+                    return false;
+
+                for (uint i = 0; i < pLeaf->m_num_values; i++)
+                {
+                    const Key &key = pLeaf->get_values()[i].first;
+                    if ((pLower) && (m_is_key_less_than(key, *pLower)))
+                        return false;
+                    if ((pUpper) && (!m_is_key_less_than(key, *pUpper)))
+                        return false;
+                }
+
+                total_values += pLeaf->m_num_values;
+                return true;
+            }
+
+            const inner_node *pInner = static_cast<const inner_node *>(pNode);
+            if ((pInner->m_num_keys > static_cast<uint>(cInnerSlots)) || (!pInner->m_num_keys))
+                return false;
+            if ((!is_root) && (pInner->m_num_keys < static_cast<uint>(cMinInnerKeys)))
+                return false;
+
+            for (uint i = 0; i <= pInner->m_num_keys; i++)
+            {
+                const Key *pChild_lower = i ? &pInner->get_keys()[i - 1] : pLower;
+                const Key *pChild_upper = (i < pInner->m_num_keys) ? &pInner->get_keys()[i] : pUpper;
+
+                if ((pChild_lower) && (pChild_upper) && (!m_is_key_less_than(*pChild_lower, *pChild_upper)))
+                    return false;
+
+                if (!debug_check_subtree(pInner->m_pChildren[i], depth - 1, pChild_lower, pChild_upper, false, total_values, pExpected_leaf))
+                    return false;
+            }
+
+            return true;
+        }
+    };
+
+    template <typename Key, typename Value, typename LessComp, typename EqualComp>
+    struct bitwise_movable<btree_map<Key, Value, LessComp, EqualComp> >
+    {
+        enum
+        {
+            cFlag = true
+        };
+    };
+
+    template <typename Key, typename Value, typename LessComp, typename EqualComp>
+    inline void swap(btree_map<Key, Value, LessComp, EqualComp> &a, btree_map<Key, Value, LessComp, EqualComp> &b)
+    {
+        a.swap(b);
+    }
+
+    bool btree_map_test();
+
+} // namespace vogl
+
+namespace std
+{
+    template <typename Key, typename Value, typename LessComp, typename EqualComp>
+    inline void swap(vogl::btree_map<Key, Value, LessComp, EqualComp> &a, vogl::btree_map<Key, Value, LessComp, EqualComp> &b)
+    {
+        a.swap(b);
+    }
+}
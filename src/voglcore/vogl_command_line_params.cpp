@@ -262,6 +262,51 @@ namespace vogl
         m_params.clear();
 
         m_param_map.clear();
+        m_params_by_key.clear();
+        m_param_ids.clear();
+        m_params_by_id.clear();
+    }
+
+    void command_line_params::add_param(const dynamic_string &key, const param_value &pv)
+    {
+        const uint param_index = m_param_map.size();
+        m_param_map.push_back(std::make_pair(key, pv));
+
+        dynamic_string lower_key(key);
+        lower_key.tolower();
+
+        m_params_by_key[lower_key].push_back(param_index);
+
+        param_id_map::const_iterator it(m_param_ids.find(lower_key));
+        if (it != m_param_ids.end())
+            m_params_by_id[it->second].push_back(param_index);
+    }
+
+    void command_line_params::init_param_ids(uint total_param_descs, const command_line_param_desc *pParam_desc)
+    {
+        m_param_ids.clear();
+        m_params_by_id.clear();
+        m_params_by_id.resize(total_param_descs);
+
+        for (uint i = 0; i < total_param_descs; i++)
+        {
+            dynamic_string lower_key(pParam_desc[i].m_pName);
+            lower_key.tolower();
+
+            // If a name is declared more than once, the first desc wins (like the linear search parse() used to do).
+            m_param_ids.insert(lower_key, i);
+        }
+
+        // Params from previous calls to parse() are also reachable through the new ids.
+        for (uint param_index = 0; param_index < m_param_map.size(); param_index++)
+        {
+            dynamic_string lower_key(m_param_map[param_index].first);
+            lower_key.tolower();
+
+            param_id_map::const_iterator it(m_param_ids.find(lower_key));
+            if (it != m_param_ids.end())
+                m_params_by_id[it->second].push_back(param_index);
+        }
     }
 
     bool command_line_params::load_string_file(const char *pFilename, dynamic_string_array &strings)
@@ -294,6 +339,8 @@ namespace vogl
     {
         m_params = params;
 
+        init_param_ids(total_param_descs, pParam_desc);
+
         command_line_param_desc desc;
         desc.m_num_values = 0;
         desc.m_support_listing_file = false;
@@ -373,12 +420,8 @@ namespace vogl
 
                 if (total_param_descs)
                 {
-                    uint param_index;
-                    for (param_index = 0; param_index < total_param_descs; param_index++)
-                        if (key_str == pParam_desc[param_index].m_pName)
-                            break;
-
-                    if (param_index == total_param_descs)
+                    const int param_index = get_param_id(key_str.get_ptr());
+                    if (param_index == cInvalidParamID)
                     {
                         if (config.m_ignore_unrecognized_params)
                             continue;
@@ -436,7 +479,7 @@ namespace vogl
                 pv.m_values.swap(strings);
                 pv.m_split_param_index = cur_arg_index;
                 pv.m_modifier = (int8)modifier;
-                m_param_map.insert(std::make_pair(key_str, pv));
+                add_param(key_str, pv);
             }
             else if (!config.m_ignore_non_params)
             {
@@ -450,7 +493,7 @@ namespace vogl
                 pv.m_values.push_back(src_param);
                 pv.m_values.back().unquote();
                 pv.m_split_param_index = cur_arg_index;
-                m_param_map.insert(std::make_pair(get_empty_dynamic_string(), pv));
+                add_param(get_empty_dynamic_string(), pv);
             }
         }
 
@@ -489,50 +532,43 @@ namespace vogl
 #endif
     }
 
-    bool command_line_params::find(const char *pKey, param_map_const_iterator &begin, param_map_const_iterator &end) const
+    const uint_vec *command_line_params::find_key(const char *pKey) const
     {
-        dynamic_string key(pKey);
-        begin = m_param_map.lower_bound(key);
-        end = m_param_map.upper_bound(key);
-        return begin != end;
+        dynamic_string lower_key(pKey);
+        lower_key.tolower();
+
+        param_index_map::const_iterator it(m_params_by_key.find(lower_key));
+        if (it == m_params_by_key.end())
+            return NULL;
+
+        return &it->second;
     }
 
     uint command_line_params::get_count(const char *pKey) const
     {
-        param_map_const_iterator begin, end;
-        find(pKey, begin, end);
-
-        uint n = 0;
-
-        while (begin != end)
-        {
-            n++;
-            begin++;
-        }
-
-        return n;
+        const uint_vec *pIndices = find_key(pKey);
+        return pIndices ? pIndices->size() : 0;
     }
 
     command_line_params::param_map_const_iterator command_line_params::get_param(const char *pKey, uint key_index) const
     {
-        param_map_const_iterator begin, end;
-        find(pKey, begin, end);
-
-        if (begin == end)
+        const uint_vec *pIndices = find_key(pKey);
+        if ((!pIndices) || (key_index >= pIndices->size()))
             return m_param_map.end();
 
-        uint n = 0;
+        return m_param_map.begin() + (*pIndices)[key_index];
+    }
 
-        while ((begin != end) && (n != key_index))
-        {
-            n++;
-            begin++;
-        }
+    int command_line_params::get_param_id(const char *pKey) const
+    {
+        dynamic_string lower_key(pKey);
+        lower_key.tolower();
 
-        if (begin == end)
-            return m_param_map.end();
+        param_id_map::const_iterator it(m_param_ids.find(lower_key));
+        if (it == m_param_ids.end())
+            return cInvalidParamID;
 
-        return begin;
+        return it->second;
     }
 
     bool command_line_params::has_value(const char *pKey, uint key_index) const
@@ -556,18 +592,25 @@ namespace vogl
         if (it == end())
             return def;
 
-        if (it->second.m_modifier)
-            return it->second.m_modifier > 0;
-        else
-            return true;
+        return get_bool_value(it->second);
     }
 
     int command_line_params::get_value_as_int(const char *pKey, uint key_index, int def, int l, int h, uint value_index, bool *pSuccess) const
+    {
+        return convert_value_to_int(get_param(pKey, key_index), pKey, key_index, def, l, h, value_index, pSuccess);
+    }
+
+    int command_line_params::get_value_as_int(int param_id, uint key_index, int def, int l, int h, uint value_index, bool *pSuccess) const
+    {
+        param_map_const_iterator it = get_param(param_id, key_index);
+        return convert_value_to_int(it, get_param_key(it), key_index, def, l, h, value_index, pSuccess);
+    }
+
+    int command_line_params::convert_value_to_int(param_map_const_iterator it, const char *pKey, uint key_index, int def, int l, int h, uint value_index, bool *pSuccess) const
     {
         if (pSuccess)
             *pSuccess = false;
 
-        param_map_const_iterator it = get_param(pKey, key_index);
         if (it == end())
             return def;
         if (value_index >= it->second.m_values.size())
@@ -605,11 +648,21 @@ namespace vogl
     }
 
     int64_t command_line_params::get_value_as_int64(const char *pKey, uint key_index, int64_t def, int64_t l, int64_t h, uint value_index, bool *pSuccess) const
+    {
+        return convert_value_to_int64(get_param(pKey, key_index), pKey, key_index, def, l, h, value_index, pSuccess);
+    }
+
+    int64_t command_line_params::get_value_as_int64(int param_id, uint key_index, int64_t def, int64_t l, int64_t h, uint value_index, bool *pSuccess) const
+    {
+        param_map_const_iterator it = get_param(param_id, key_index);
+        return convert_value_to_int64(it, get_param_key(it), key_index, def, l, h, value_index, pSuccess);
+    }
+
+    int64_t command_line_params::convert_value_to_int64(param_map_const_iterator it, const char *pKey, uint key_index, int64_t def, int64_t l, int64_t h, uint value_index, bool *pSuccess) const
     {
         if (pSuccess)
             *pSuccess = false;
 
-        param_map_const_iterator it = get_param(pKey, key_index);
         if (it == end())
             return def;
         if (value_index >= it->second.m_values.size())
@@ -647,11 +700,21 @@ namespace vogl
     }
 
     uint command_line_params::get_value_as_uint(const char *pKey, uint key_index, uint def, uint l, uint h, uint value_index, bool *pSuccess) const
+    {
+        return convert_value_to_uint(get_param(pKey, key_index), pKey, key_index, def, l, h, value_index, pSuccess);
+    }
+
+    uint command_line_params::get_value_as_uint(int param_id, uint key_index, uint def, uint l, uint h, uint value_index, bool *pSuccess) const
+    {
+        param_map_const_iterator it = get_param(param_id, key_index);
+        return convert_value_to_uint(it, get_param_key(it), key_index, def, l, h, value_index, pSuccess);
+    }
+
+    uint command_line_params::convert_value_to_uint(param_map_const_iterator it, const char *pKey, uint key_index, uint def, uint l, uint h, uint value_index, bool *pSuccess) const
     {
         if (pSuccess)
             *pSuccess = false;
 
-        param_map_const_iterator it = get_param(pKey, key_index);
         if (it == end())
             return def;
         if (value_index >= it->second.m_values.size())
@@ -689,11 +752,21 @@ namespace vogl
     }
 
     uint64_t command_line_params::get_value_as_uint64(const char *pKey, uint key_index, uint64_t def, uint64_t l, uint64_t h, uint value_index, bool *pSuccess) const
+    {
+        return convert_value_to_uint64(get_param(pKey, key_index), pKey, key_index, def, l, h, value_index, pSuccess);
+    }
+
+    uint64_t command_line_params::get_value_as_uint64(int param_id, uint key_index, uint64_t def, uint64_t l, uint64_t h, uint value_index, bool *pSuccess) const
+    {
+        param_map_const_iterator it = get_param(param_id, key_index);
+        return convert_value_to_uint64(it, get_param_key(it), key_index, def, l, h, value_index, pSuccess);
+    }
+
+    uint64_t command_line_params::convert_value_to_uint64(param_map_const_iterator it, const char *pKey, uint key_index, uint64_t def, uint64_t l, uint64_t h, uint value_index, bool *pSuccess) const
     {
         if (pSuccess)
             *pSuccess = false;
 
-        param_map_const_iterator it = get_param(pKey, key_index);
         if (it == end())
             return def;
         if (value_index >= it->second.m_values.size())
@@ -731,11 +804,21 @@ namespace vogl
     }
 
     float command_line_params::get_value_as_float(const char *pKey, uint key_index, float def, float l, float h, uint value_index, bool *pSuccess) const
+    {
+        return convert_value_to_float(get_param(pKey, key_index), pKey, def, l, h, value_index, pSuccess);
+    }
+
+    float command_line_params::get_value_as_float(int param_id, uint key_index, float def, float l, float h, uint value_index, bool *pSuccess) const
+    {
+        param_map_const_iterator it = get_param(param_id, key_index);
+        return convert_value_to_float(it, get_param_key(it), def, l, h, value_index, pSuccess);
+    }
+
+    float command_line_params::convert_value_to_float(param_map_const_iterator it, const char *pKey, float def, float l, float h, uint value_index, bool *pSuccess) const
     {
         if (pSuccess)
             *pSuccess = false;
 
-        param_map_const_iterator it = get_param(pKey, key_index);
         if (it == end())
             return def;
         if (value_index >= it->second.m_values.size())
@@ -772,7 +855,17 @@ namespace vogl
 
     bool command_line_params::get_value_as_string(dynamic_string &value, const char *pKey, uint key_index, const char *pDef, uint value_index) const
     {
-        param_map_const_iterator it = get_param(pKey, key_index);
+        return convert_value_to_string(get_param(pKey, key_index), value, pKey, pDef, value_index);
+    }
+
+    bool command_line_params::get_value_as_string(dynamic_string &value, int param_id, uint key_index, const char *pDef, uint value_index) const
+    {
+        param_map_const_iterator it = get_param(param_id, key_index);
+        return convert_value_to_string(it, value, get_param_key(it), pDef, value_index);
+    }
+
+    bool command_line_params::convert_value_to_string(param_map_const_iterator it, dynamic_string &value, const char *pKey, const char *pDef, uint value_index) const
+    {
         if (it == end())
             return false;
         if (value_index >= it->second.m_values.size())
@@ -788,21 +881,35 @@ namespace vogl
 
     dynamic_string command_line_params::get_value_as_string(const char *pKey, uint key_index, const char *pDef, uint value_index) const
     {
-        param_map_const_iterator it = get_param(pKey, key_index);
-        if (it == end())
-            return dynamic_string(pDef);
-        if (value_index >= it->second.m_values.size())
-        {
-            vogl::console::debug("%s: Trying to retrieve value %u of command line parameter %s, but this parameter only has %u values\n", VOGL_FUNCTION_INFO_CSTR, value_index, pKey, it->second.m_values.size());
-            return dynamic_string(pDef);
-        }
+        dynamic_string value;
+        if (!convert_value_to_string(get_param(pKey, key_index), value, pKey, pDef, value_index))
+            value.set(pDef);
+        return value;
+    }
 
-        return it->second.m_values[value_index];
+    dynamic_string command_line_params::get_value_as_string(int param_id, uint key_index, const char *pDef, uint value_index) const
+    {
+        param_map_const_iterator it = get_param(param_id, key_index);
+
+        dynamic_string value;
+        if (!convert_value_to_string(it, value, get_param_key(it), pDef, value_index))
+            value.set(pDef);
+        return value;
     }
 
     const dynamic_string &command_line_params::get_value_as_string_or_empty(const char *pKey, uint key_index, uint value_index) const
     {
-        param_map_const_iterator it = get_param(pKey, key_index);
+        return get_value_string_or_empty(get_param(pKey, key_index), pKey, value_index);
+    }
+
+    const dynamic_string &command_line_params::get_value_as_string_or_empty(int param_id, uint key_index, uint value_index) const
+    {
+        param_map_const_iterator it = get_param(param_id, key_index);
+        return get_value_string_or_empty(it, get_param_key(it), value_index);
+    }
+
+    const dynamic_string &command_line_params::get_value_string_or_empty(param_map_const_iterator it, const char *pKey, uint value_index) const
+    {
         if (it == end())
             return get_empty_dynamic_string();
 
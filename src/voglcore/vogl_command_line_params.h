@@ -28,9 +28,7 @@
 #pragma once
 
 #include "vogl_core.h"
-
-// TODO: Get rid of std::multimap! vogl::map can replace this.
-#include <map>
+#include "vogl_hash_map.h"
 
 namespace vogl
 {
@@ -81,11 +79,19 @@ namespace vogl
             int8 m_modifier;
         };
 
-        // TODO: Get rid of std::multimap!
-        typedef std::multimap<dynamic_string, param_value> param_map;
+        // All parsed params in command line order (non-option params have an empty key).
+        typedef vogl::vector<std::pair<dynamic_string, param_value> > param_map;
         typedef param_map::const_iterator param_map_const_iterator;
         typedef param_map::iterator param_map_iterator;
 
+        // Params declared in the command_line_param_desc array passed to parse() can also be accessed by id, which is the param's index in that array.
+        // Ids are resolved to the parsed params once by parse(), so the id versions of the accessors below don't do any string hashing or compares.
+        // Prefer them for params checked on hot paths (every call, packet, or frame).
+        enum
+        {
+            cInvalidParamID = -1
+        };
+
         command_line_params();
 
         void clear();
@@ -142,8 +148,6 @@ namespace vogl
             return m_param_map.end();
         }
 
-        bool find(const char *pKey, param_map_const_iterator &begin, param_map_const_iterator &end) const;
-
         // Returns the # of command line params matching key (use "" key string for regular/non-option params)
         uint get_count(const char *pKey) const;
 
@@ -171,12 +175,84 @@ namespace vogl
         dynamic_string get_value_as_string(const char *pKey, uint key_index = 0, const char *pDef = "", uint value_index = 0) const;
         const dynamic_string &get_value_as_string_or_empty(const char *pKey, uint key_index = 0, uint value_index = 0) const;
 
+        // Returns cInvalidParamID if pKey wasn't declared in the param desc array passed to parse().
+        int get_param_id(const char *pKey) const;
+
+        // The param_id overloads treat a negative (cInvalidParamID) id as a param that wasn't specified.
+        uint get_count(int param_id) const
+        {
+            return ((param_id >= 0) && (static_cast<uint>(param_id) < m_params_by_id.size())) ? m_params_by_id[param_id].size() : 0;
+        }
+
+        // Returns end() if the param wasn't specified, or index is out of range.
+        param_map_const_iterator get_param(int param_id, uint key_index) const
+        {
+            if (key_index >= get_count(param_id))
+                return end();
+            return m_param_map.begin() + m_params_by_id[param_id][key_index];
+        }
+
+        bool has_key(int param_id) const
+        {
+            return get_count(param_id) != 0;
+        }
+
+        bool get_value_as_bool(int param_id, uint key_index = 0, bool def = false) const
+        {
+            param_map_const_iterator it = get_param(param_id, key_index);
+            return (it != end()) ? get_bool_value(it->second) : def;
+        }
+
+        int get_value_as_int(int param_id, uint key_index = 0, int def = 0, int l = cINT32_MIN, int h = cINT32_MAX, uint value_index = 0, bool *pSuccess = NULL) const;
+        int64_t get_value_as_int64(int param_id, uint key_index = 0, int64_t def = 0, int64_t l = cINT64_MIN, int64_t h = cINT64_MAX, uint value_index = 0, bool *pSuccess = NULL) const;
+        uint get_value_as_uint(int param_id, uint key_index = 0, uint def = 0, uint l = 0, uint h = cUINT32_MAX, uint value_index = 0, bool *pSuccess = NULL) const;
+        uint64_t get_value_as_uint64(int param_id, uint key_index = 0, uint64_t def = 0, uint64_t l = 0, uint64_t h = cUINT64_MAX, uint value_index = 0, bool *pSuccess = NULL) const;
+        float get_value_as_float(int param_id, uint key_index = 0, float def = 0.0f, float l = -math::cNearlyInfinite, float h = math::cNearlyInfinite, uint value_index = 0, bool *pSuccess = NULL) const;
+
+        bool get_value_as_string(dynamic_string &value, int param_id, uint key_index = 0, const char *pDef = "", uint value_index = 0) const;
+        dynamic_string get_value_as_string(int param_id, uint key_index = 0, const char *pDef = "", uint value_index = 0) const;
+        const dynamic_string &get_value_as_string_or_empty(int param_id, uint key_index = 0, uint value_index = 0) const;
+
     private:
         dynamic_string_array m_params;
 
         param_map m_param_map;
 
+        // Lowercased param name -> indices into m_param_map, in command line order (param names are case insensitive).
+        typedef vogl::hash_map<dynamic_string, uint_vec> param_index_map;
+        param_index_map m_params_by_key;
+
+        // Lowercased param name -> id, for every declared param.
+        typedef vogl::hash_map<dynamic_string, int> param_id_map;
+        param_id_map m_param_ids;
+
+        // Param id -> indices into m_param_map, in command line order.
+        vogl::vector<uint_vec> m_params_by_id;
+
         static bool load_string_file(const char *pFilename, dynamic_string_array &strings);
+
+        static inline bool get_bool_value(const param_value &pv)
+        {
+            return pv.m_modifier ? (pv.m_modifier > 0) : true;
+        }
+
+        void add_param(const dynamic_string &key, const param_value &pv);
+        void init_param_ids(uint total_param_descs, const command_line_param_desc *pParam_desc);
+        const uint_vec *find_key(const char *pKey) const;
+
+        // These do the actual conversions for both the string and id accessors.
+        int convert_value_to_int(param_map_const_iterator it, const char *pKey, uint key_index, int def, int l, int h, uint value_index, bool *pSuccess) const;
+        int64_t convert_value_to_int64(param_map_const_iterator it, const char *pKey, uint key_index, int64_t def, int64_t l, int64_t h, uint value_index, bool *pSuccess) const;
+        uint convert_value_to_uint(param_map_const_iterator it, const char *pKey, uint key_index, uint def, uint l, uint h, uint value_index, bool *pSuccess) const;
+        uint64_t convert_value_to_uint64(param_map_const_iterator it, const char *pKey, uint key_index, uint64_t def, uint64_t l, uint64_t h, uint value_index, bool *pSuccess) const;
+        float convert_value_to_float(param_map_const_iterator it, const char *pKey, float def, float l, float h, uint value_index, bool *pSuccess) const;
+        bool convert_value_to_string(param_map_const_iterator it, dynamic_string &value, const char *pKey, const char *pDef, uint value_index) const;
+        const dynamic_string &get_value_string_or_empty(param_map_const_iterator it, const char *pKey, uint value_index) const;
+
+        const char *get_param_key(param_map_const_iterator it) const
+        {
+            return (it != end()) ? it->first.get_ptr() : "";
+        }
     };
 
     inline command_line_params &g_command_line_params()
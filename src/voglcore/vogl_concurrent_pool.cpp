@@ -0,0 +1,642 @@
+/**************************************************************************
+ *
+ * Copyright 2013-2014 RAD Game Tools and Valve Software
+ * Copyright 2010-2014 Rich Geldreich and Tenacious Software LLC
+ * All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ **************************************************************************/
+
+// File: vogl_concurrent_pool.cpp
+#include "vogl_concurrent_pool.h"
+
+VOGL_NAMESPACE_BEGIN(vogl)
+
+concurrent_freelist::concurrent_freelist(uint obj_size, uint grow_size, uint flags)
+    : m_head(0),
+      m_active_pops(0),
+      m_total_used_nodes(0),
+      m_high_water_used_nodes(0),
+      m_total_nodes(0),
+      m_total_blocks(0),
+      m_total_heap_bytes(0),
+      m_num_used_block_slots(0)
+{
+    utils::zero_object(m_block_slots);
+
+    init(obj_size, grow_size, flags);
+}
+
+concurrent_freelist::~concurrent_freelist()
+{
+    if (m_flags & cObjectPoolClearOnDestruction)
+        clear();
+}
+
+void concurrent_freelist::init(uint obj_size, uint grow_size, uint flags, uint user_data)
+{
+    VOGL_ASSERT(!m_total_blocks);
+
+    m_obj_size = obj_size;
+    m_node_size = math::align_up_value(cNodeHeaderSize + math::maximum<uint>(1U, obj_size), cNodeHeaderSize);
+    m_flags = flags;
+    m_grow_size = math::clamp<uint>(grow_size, 1U, cMaxNodesPerBlock);
+    m_next_grow_size = m_grow_size;
+    m_user_data = user_data;
+}
+
+void *concurrent_freelist::init_unpooled_node(void *pHeader, uint user_data)
+{
+    VOGL_ASSERT((reinterpret_cast<ptr_bits_t>(pHeader) & (cNodeHeaderSize - 1)) == 0);
+
+    node *pNode = static_cast<node *>(pHeader);
+    pNode->m_index = cUINT32_MAX;
+    pNode->m_next = 0;
+    pNode->m_marker = cUsedNodeMarker;
+    pNode->m_user_data = user_data;
+
+    return pNode->get_object_ptr();
+}
+
+void concurrent_freelist::grow()
+{
+    scoped_spinlock lock(m_grow_lock);
+
+    // Another thread may have grown the freelist (or freed some nodes) while we were waiting for the lock.
+    if (static_cast<uint>(m_head))
+        return;
+
+    if (m_num_used_block_slots == cMaxBlocks)
+        VOGL_FAIL("concurrent_freelist: Out of block slots");
+
+    uint slot = 0;
+    while (m_block_slots[slot])
+        slot++;
+
+    const uint total_nodes = m_next_grow_size;
+
+    block *pBlock = static_cast<block *>(vogl_malloc(sizeof(block) + static_cast<size_t>(total_nodes) * m_node_size));
+    pBlock->m_marker = cBlockMarker;
+    pBlock->m_slot = slot;
+    pBlock->m_total_nodes = total_nodes;
+    pBlock->m_node_size = m_node_size;
+
+    const uint first_index = slot << cNodeOffsetBits;
+    for (uint i = 0; i < total_nodes; i++)
+    {
+        node *pNode = pBlock->get_node(i);
+        pNode->m_index = first_index + i;
+        pNode->m_next = ((i + 1) < total_nodes) ? (first_index + i + 2) : 0;
+        pNode->m_marker = cFreeNodeMarker;
+        pNode->m_user_data = m_user_data;
+    }
+
+    m_block_slots[slot] = pBlock;
+    m_num_used_block_slots++;
+
+    m_total_nodes += total_nodes;
+    m_total_blocks++;
+    m_total_heap_bytes += vogl_msize(pBlock);
+
+    // Grow exponentially anyway once half the block slots are used, so the freelist can't run out of slots.
+    if ((m_flags & cObjectPoolGrowExponential) || (m_num_used_block_slots >= cMaxBlocks / 2))
+        m_next_grow_size = math::minimum<uint>(m_next_grow_size * 2U, cMaxNodesPerBlock);
+
+    link_chain(first_index, first_index + total_nodes - 1);
+}
+
+size_t concurrent_freelist::clear()
+{
+    scoped_spinlock lock(m_grow_lock);
+
+    size_t total_bytes_freed = m_total_heap_bytes;
+
+    for (uint slot = 0; slot < cMaxBlocks; slot++)
+    {
+        if (m_block_slots[slot])
+        {
+            VOGL_ASSERT(m_block_slots[slot]->m_marker == cBlockMarker);
+            vogl_free(m_block_slots[slot]);
+            m_block_slots[slot] = NULL;
+        }
+    }
+
+    m_head = make_head((static_cast<uint64_t>(m_head) >> 32U) + 1U, 0);
+
+    m_num_used_block_slots = 0;
+    m_next_grow_size = m_grow_size;
+
+    m_total_nodes = 0;
+    m_total_blocks = 0;
+    m_total_heap_bytes = 0;
+    m_total_used_nodes = 0;
+    m_high_water_used_nodes = 0;
+
+    return total_bytes_freed;
+}
+
+size_t concurrent_freelist::free_unused_blocks()
+{
+    scoped_spinlock lock(m_grow_lock);
+
+    // Take the entire shared stack. Concurrent allocs will see an empty stack and wait on m_grow_lock in grow(), concurrent frees start a new stack.
+    uint64_t head;
+    for (;;)
+    {
+        head = m_head;
+        if (!static_cast<uint>(head))
+            return 0;
+
+        if (static_cast<uint64_t>(atomic_compare_exchange64(&m_head, make_head((head >> 32U) + 1U, 0), head)) == head)
+            break;
+    }
+
+    // Pops that started before the exchange may still be walking the nodes we just took.
+    while (m_active_pops)
+        vogl_yield_processor();
+
+    vogl::vector<uint> free_nodes_in_slot(cMaxBlocks);
+
+    for (uint link = static_cast<uint>(head); link; link = get_node(link - 1U)->m_next)
+        free_nodes_in_slot[(link - 1U) >> cNodeOffsetBits]++;
+
+    size_t total_bytes_freed = 0;
+    size_t total_nodes_freed = 0;
+
+    for (uint slot = 0; slot < cMaxBlocks; slot++)
+    {
+        block *pBlock = m_block_slots[slot];
+        if ((!pBlock) || (free_nodes_in_slot[slot] != pBlock->m_total_nodes))
+            free_nodes_in_slot[slot] = 0;
+        else
+            total_nodes_freed += pBlock->m_total_nodes;
+    }
+
+    if (!total_nodes_freed)
+    {
+        link_chain(static_cast<uint>(head) - 1U, last_link_of_chain(static_cast<uint>(head)) - 1U);
+        return 0;
+    }
+
+    // Relink the nodes of the blocks we're keeping, then free the rest.
+    uint first_link = 0, last_link = 0;
+    for (uint link = static_cast<uint>(head); link;)
+    {
+        node *pNode = get_node(link - 1U);
+        uint next_link = pNode->m_next;
+
+        if (!free_nodes_in_slot[(link - 1U) >> cNodeOffsetBits])
+        {
+            if (last_link)
+                get_node(last_link - 1U)->m_next = link;
+            else
+                first_link = link;
+            last_link = link;
+        }
+
+        link = next_link;
+    }
+
+    for (uint slot = 0; slot < cMaxBlocks; slot++)
+    {
+        if (!free_nodes_in_slot[slot])
+            continue;
+
+        block *pBlock = m_block_slots[slot];
+        VOGL_ASSERT(pBlock->m_marker == cBlockMarker);
+
+        size_t block_size_in_bytes = vogl_msize(pBlock);
+        total_bytes_freed += block_size_in_bytes;
+
+        m_total_heap_bytes -= block_size_in_bytes;
+        m_total_nodes -= pBlock->m_total_nodes;
+        m_total_blocks--;
+
+        m_block_slots[slot] = NULL;
+        m_num_used_block_slots--;
+
+        vogl_free(pBlock);
+    }
+
+    if (first_link)
+        link_chain(first_link - 1U, last_link - 1U);
+
+    return total_bytes_freed;
+}
+
+uint concurrent_freelist::last_link_of_chain(uint link) const
+{
+    for (;;)
+    {
+        uint next_link = get_node(link - 1U)->m_next;
+        if (!next_link)
+            return link;
+        link = next_link;
+    }
+}
+
+bool concurrent_freelist::check() const
+{
+    scoped_spinlock lock(const_cast<spinlock &>(m_grow_lock));
+
+    size_t total_nodes_found = 0;
+    size_t total_blocks_found = 0;
+    size_t total_heap_bytes_found = 0;
+
+    for (uint slot = 0; slot < cMaxBlocks; slot++)
+    {
+        block *pBlock = m_block_slots[slot];
+        if (!pBlock)
+            continue;
+
+        if ((pBlock->m_marker != cBlockMarker) || (pBlock->m_slot != slot) || (!pBlock->m_total_nodes) || (pBlock->m_node_size != m_node_size))
+            return false;
+
+        if (vogl_msize(pBlock) < (sizeof(block) + static_cast<size_t>(pBlock->m_total_nodes) * m_node_size))
+            return false;
+
+        total_nodes_found += pBlock->m_total_nodes;
+        total_blocks_found++;
+        total_heap_bytes_found += vogl_msize(pBlock);
+    }
+
+    if ((total_nodes_found != m_total_nodes) || (total_blocks_found != m_total_blocks) || (total_blocks_found != m_num_used_block_slots) || (total_heap_bytes_found != m_total_heap_bytes))
+        return false;
+
+    size_t total_free_nodes_found = 0;
+    for (uint link = static_cast<uint>(m_head); link; link = get_node(link - 1U)->m_next)
+    {
+        uint slot = (link - 1U) >> cNodeOffsetBits;
+        if ((!m_block_slots[slot]) || (((link - 1U) & cNodeOffsetMask) >= m_block_slots[slot]->m_total_nodes))
+            return false;
+
+        const node *pNode = get_node(link - 1U);
+        if ((pNode->m_index != (link - 1U)) || (pNode->m_user_data != m_user_data))
+            return false;
+
+#if VOGL_OBJECT_POOL_DEBUGGING
+        if (pNode->m_marker != cFreeNodeMarker)
+            return false;
+#endif
+
+        if (++total_free_nodes_found > total_nodes_found)
+            return false;
+    }
+
+    if (total_free_nodes_found != (total_nodes_found - static_cast<size_t>(m_total_used_nodes)))
+        return false;
+
+    return true;
+}
+
+bool concurrent_freelist::is_valid_ptr(const void *p) const
+{
+    if (!p)
+        return false;
+
+    scoped_spinlock lock(const_cast<spinlock &>(m_grow_lock));
+
+    for (uint slot = 0; slot < cMaxBlocks; slot++)
+    {
+        block *pBlock = m_block_slots[slot];
+        if (!pBlock)
+            continue;
+
+        const uint8 *pFirst = static_cast<const uint8 *>(pBlock->get_node(0)->get_object_ptr());
+        const uint8 *pLast = static_cast<const uint8 *>(pBlock->get_node(pBlock->m_total_nodes - 1)->get_object_ptr());
+
+        if ((p >= pFirst) && (p <= pLast))
+            return ((static_cast<const uint8 *>(p) - pFirst) % m_node_size) == 0;
+    }
+
+    return false;
+}
+
+void concurrent_freelist::magazine::refill()
+{
+    VOGL_ASSERT(!m_num_nodes);
+
+    uint first_index;
+    uint n;
+    while ((n = m_list.pop_chain(cMaxNodes / 2, first_index)) == 0)
+        m_list.grow();
+
+    uint link = first_index + 1U;
+    for (uint i = 0; i < n; i++)
+    {
+        m_nodes[n - 1 - i] = link - 1U;
+        link = m_list.get_node(link - 1U)->m_next;
+    }
+
+    m_num_nodes = n;
+}
+
+void concurrent_freelist::magazine::flush(uint n)
+{
+    n = math::minimum(n, m_num_nodes);
+    if (!n)
+        return;
+
+    const uint first = m_num_nodes - n;
+    for (uint i = first; i < (m_num_nodes - 1); i++)
+        m_list.get_node(m_nodes[i])->m_next = m_nodes[i + 1] + 1U;
+
+    m_list.push_chain(m_nodes[first], m_nodes[m_num_nodes - 1], n);
+
+    m_num_nodes = first;
+}
+
+concurrent_buffer_pool::concurrent_buffer_pool(uint grow_size)
+    : m_total_large_bytes(0)
+{
+    for (uint i = 0; i < cNumSizeClasses; i++)
+    {
+        // By default start each size class with roughly 16KB worth of buffers.
+        uint size_class_grow_size = grow_size ? grow_size : math::maximum(1U, 16384U / get_size_class_size(i));
+        m_size_classes[i].init(get_size_class_size(i), size_class_grow_size, cObjectPoolGrowExponential | cObjectPoolClearOnDestruction, i);
+    }
+}
+
+concurrent_buffer_pool::~concurrent_buffer_pool()
+{
+}
+
+void *concurrent_buffer_pool::alloc_large(size_t size)
+{
+    void *pHeader = vogl_malloc(concurrent_freelist::cNodeHeaderSize + size);
+    if (!pHeader)
+        return NULL;
+
+    atomic_add32(&m_total_large_bytes, static_cast<nonvolatile_atomic32_t>(vogl_msize(pHeader)));
+
+    return concurrent_freelist::init_unpooled_node(pHeader, cLargeSizeClass);
+}
+
+void concurrent_buffer_pool::free_large(void *p)
+{
+    void *pHeader = concurrent_freelist::get_unpooled_node_header(p);
+
+    atomic_add32(&m_total_large_bytes, -static_cast<nonvolatile_atomic32_t>(vogl_msize(pHeader)));
+
+    vogl_free(pHeader);
+}
+
+size_t concurrent_buffer_pool::get_buffer_size(const void *p)
+{
+    uint size_class = concurrent_freelist::get_user_data(p);
+    if (size_class == cLargeSizeClass)
+        return vogl_msize(concurrent_freelist::get_unpooled_node_header(const_cast<void *>(p))) - concurrent_freelist::cNodeHeaderSize;
+
+    return get_size_class_size(size_class);
+}
+
+size_t concurrent_buffer_pool::clear()
+{
+    size_t total_bytes_freed = 0;
+    for (uint i = 0; i < cNumSizeClasses; i++)
+        total_bytes_freed += m_size_classes[i].clear();
+    return total_bytes_freed;
+}
+
+size_t concurrent_buffer_pool::free_unused_blocks()
+{
+    size_t total_bytes_freed = 0;
+    for (uint i = 0; i < cNumSizeClasses; i++)
+        total_bytes_freed += m_size_classes[i].free_unused_blocks();
+    return total_bytes_freed;
+}
+
+size_t concurrent_buffer_pool::get_total_heap_bytes() const
+{
+    size_t total_bytes = get_total_large_bytes();
+    for (uint i = 0; i < cNumSizeClasses; i++)
+        total_bytes += m_size_classes[i].get_total_heap_bytes();
+    return total_bytes;
+}
+
+concurrent_buffer_pool::magazine::magazine(concurrent_buffer_pool &pool)
+    : m_pool(pool)
+{
+    utils::zero_object(m_pMagazines);
+}
+
+concurrent_buffer_pool::magazine::~magazine()
+{
+    for (uint i = 0; i < cNumSizeClasses; i++)
+        vogl_delete(m_pMagazines[i]);
+}
+
+void concurrent_buffer_pool::magazine::flush()
+{
+    for (uint i = 0; i < cNumSizeClasses; i++)
+        if (m_pMagazines[i])
+            m_pMagazines[i]->flush();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// concurrent_pool_test
+//----------------------------------------------------------------------------------------------------------------------
+#define CHECK(x) \
+    if (!(x))    \
+        return false;
+
+namespace
+{
+    struct concurrent_pool_test_state
+    {
+        concurrent_object_pool<uint64_t> *m_pObj_pool;
+        concurrent_buffer_pool *m_pBuf_pool;
+        atomic32_t m_total_failures;
+    };
+
+    void concurrent_pool_test_task(uint64_t data, void *pData_ptr)
+    {
+        concurrent_pool_test_state &state = *static_cast<concurrent_pool_test_state *>(pData_ptr);
+
+        vogl::random rm;
+        rm.seed(static_cast<uint32>(data) + 1);
+
+        concurrent_object_pool<uint64_t>::magazine obj_magazine(*state.m_pObj_pool);
+        concurrent_buffer_pool::magazine buf_magazine(*state.m_pBuf_pool);
+
+        vogl::vector<uint64_t *> objs;
+        vogl::vector<uint8 *> bufs;
+
+        for (uint iter = 0; iter < 50000; iter++)
+        {
+            // Alternate between the magazines and the shared stacks, and free some of the time from the other side.
+            bool use_magazine = (iter & 1) != 0;
+
+            if ((objs.is_empty()) || (rm.irand(0, 3)))
+            {
+                uint64_t *p = use_magazine ? obj_magazine.alloc() : state.m_pObj_pool->alloc();
+                *p = (data << 32) | objs.size();
+                objs.push_back(p);
+
+                uint size = rm.irand(2, 1000);
+                uint8 *pBuf = static_cast<uint8 *>(use_magazine ? buf_magazine.alloc(size) : state.m_pBuf_pool->alloc(size));
+                memset(pBuf, static_cast<int>(data), size);
+                pBuf[0] = static_cast<uint8>(size & 0xFF);
+                bufs.push_back(pBuf);
+            }
+            else
+            {
+                uint k = rm.irand(0, objs.size());
+                if (*objs[k] != ((data << 32) | k))
+                    atomic_increment32(&state.m_total_failures);
+
+                uint8 *pBuf = bufs[k];
+                if ((concurrent_buffer_pool::get_buffer_size(pBuf) < 2) || (pBuf[1] != static_cast<uint8>(data)))
+                    atomic_increment32(&state.m_total_failures);
+
+                if (use_magazine)
+                {
+                    obj_magazine.destroy(objs[k]);
+                    buf_magazine.free(pBuf);
+                }
+                else
+                {
+                    state.m_pObj_pool->destroy(objs[k]);
+                    state.m_pBuf_pool->free(pBuf);
+                }
+
+                objs[k] = objs.back();
+                *objs[k] = (data << 32) | k;
+                objs.pop_back();
+
+                bufs[k] = bufs.back();
+                bufs.pop_back();
+            }
+
+            if (!rm.irand(0, 20000))
+            {
+                state.m_pObj_pool->free_unused_blocks();
+                state.m_pBuf_pool->free_unused_blocks();
+            }
+        }
+
+        for (uint i = 0; i < objs.size(); i++)
+        {
+            obj_magazine.destroy(objs[i]);
+            buf_magazine.free(bufs[i]);
+        }
+    }
+}
+
+bool concurrent_pool_test()
+{
+    {
+        concurrent_object_pool<uint> pool(16, 0);
+
+        CHECK(pool.check());
+
+        vogl::vector<uint *> ptrs;
+        for (uint i = 0; i < 1000; i++)
+        {
+            ptrs.push_back(pool.alloc(i));
+            CHECK(pool.is_valid_ptr(ptrs.back()));
+        }
+
+        CHECK(pool.check());
+        CHECK(pool.get_total_used_nodes() == 1000);
+        CHECK(pool.get_high_water_used_nodes() == 1000);
+
+        for (uint i = 0; i < ptrs.size(); i += 2)
+            pool.destroy(ptrs[i]);
+
+        CHECK(pool.check());
+        CHECK(pool.get_total_used_nodes() == 500);
+        CHECK(pool.get_high_water_used_nodes() == 1000);
+
+        for (uint i = 1; i < ptrs.size(); i += 2)
+            CHECK(*ptrs[i] == i);
+
+        {
+            concurrent_object_pool<uint>::magazine magazine(pool);
+            for (uint i = 1; i < ptrs.size(); i += 2)
+                magazine.destroy(ptrs[i]);
+
+            uint *p = magazine.alloc(5);
+            CHECK(*p == 5);
+            magazine.destroy(p);
+        }
+
+        CHECK(pool.check());
+        CHECK(pool.get_total_used_nodes() == 0);
+
+        size_t total_heap_bytes = pool.get_total_heap_bytes();
+        CHECK(pool.free_unused_blocks() == total_heap_bytes);
+        CHECK(!pool.get_total_blocks());
+        CHECK(pool.check());
+
+        pool.reset_high_water_mark();
+        CHECK(pool.get_high_water_used_nodes() == 0);
+    }
+
+    {
+        concurrent_buffer_pool pool;
+
+        for (uint size = 1; size <= concurrent_buffer_pool::cMaxPooledSize * 2; size = size * 3 + 1)
+        {
+            uint8 *p = static_cast<uint8 *>(pool.alloc(size));
+            CHECK((reinterpret_cast<ptr_bits_t>(p) & 15) == 0);
+            CHECK(concurrent_buffer_pool::get_buffer_size(p) >= size);
+            memset(p, 0xCD, size);
+            pool.free(p);
+        }
+
+        CHECK(!pool.get_total_large_bytes());
+    }
+
+    {
+        concurrent_object_pool<uint64_t> obj_pool(64);
+        concurrent_buffer_pool buf_pool;
+
+        concurrent_pool_test_state state;
+        state.m_pObj_pool = &obj_pool;
+        state.m_pBuf_pool = &buf_pool;
+        state.m_total_failures = 0;
+
+        const uint cNumThreads = 4;
+
+        task_pool tp(cNumThreads);
+        for (uint i = 0; i < cNumThreads * 2; i++)
+            tp.queue_task(concurrent_pool_test_task, i, &state);
+        tp.join();
+
+        CHECK(!state.m_total_failures);
+        CHECK(obj_pool.check());
+        CHECK(obj_pool.get_total_used_nodes() == 0);
+
+        for (uint i = 0; i < concurrent_buffer_pool::cNumSizeClasses; i++)
+        {
+            CHECK(buf_pool.get_size_class_freelist(i).check());
+            CHECK(buf_pool.get_size_class_freelist(i).get_total_used_nodes() == 0);
+        }
+
+        printf("Object pool high water mark: %" PRIu64 " nodes, heap bytes: %" PRIu64 "\n", static_cast<uint64_t>(obj_pool.get_high_water_used_nodes()), static_cast<uint64_t>(obj_pool.get_total_heap_bytes()));
+    }
+
+    return true;
+}
+
+#undef CHECK
+
+VOGL_NAMESPACE_END(vogl)
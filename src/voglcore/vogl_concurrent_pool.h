@@ -0,0 +1,701 @@
+/**************************************************************************
+ *
+ * Copyright 2013-2014 RAD Game Tools and Valve Software
+ * Copyright 2010-2014 Rich Geldreich and Tenacious Software LLC
+ * All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ **************************************************************************/
+
+// File: vogl_concurrent_pool.h
+// Lock-free, multi-producer/multi-consumer freelists.
+// concurrent_freelist is the untyped core: free nodes live on a shared lock-free stack, and blocks are only added or removed under a spinlock (which alloc/free never take unless the pool must grow).
+// concurrent_object_pool<T> is the typed version, with the same alloc()/destroy() interface as object_pool.
+// concurrent_buffer_pool hands out variable size raw buffers from a set of power of 2 size classes.
+// Each one has a magazine class, a small single thread cache which moves nodes to/from the shared stack in batches. Threads that allocate heavily should keep one around.
+#pragma once
+
+#include "vogl_core.h"
+#include "vogl_atomics.h"
+#include "vogl_threading.h"
+#include "vogl_object_pool.h"
+
+VOGL_NAMESPACE_BEGIN(vogl)
+
+class concurrent_freelist
+{
+    VOGL_NO_COPY_OR_ASSIGNMENT_OP(concurrent_freelist);
+
+public:
+    enum
+    {
+        // Every node starts with this many bytes of header, so objects are always 16 byte aligned.
+        cNodeHeaderSize = 16,
+
+        cNodeOffsetBits = 22,
+        cMaxNodesPerBlock = 1U << cNodeOffsetBits,
+        cMaxBlocks = (1U << (32U - cNodeOffsetBits)) - 1U
+    };
+
+    // flags are object_pool_flags.
+    concurrent_freelist(uint obj_size = 0, uint grow_size = 0, uint flags = cObjectPoolGrowExponential | cObjectPoolClearOnDestruction);
+    ~concurrent_freelist();
+
+    // Only call this before the freelist is used (or after clear()). user_data is stored in every node's header, see get_user_data().
+    void init(uint obj_size, uint grow_size, uint flags, uint user_data = 0);
+
+    uint get_obj_size() const
+    {
+        return m_obj_size;
+    }
+
+    inline void *alloc()
+    {
+        uint first_index;
+        while (!pop_chain(1, first_index))
+            grow();
+
+        node *pNode = get_node(first_index);
+
+#if VOGL_OBJECT_POOL_DEBUGGING
+        VOGL_ASSERT(pNode->m_marker == cFreeNodeMarker);
+        pNode->m_marker = cUsedNodeMarker;
+#endif
+
+        return pNode->get_object_ptr();
+    }
+
+    inline void free(void *p)
+    {
+        if (!p)
+            return;
+
+        node *pNode = get_node_from_object_ptr(p);
+
+#if VOGL_OBJECT_POOL_DEBUGGING
+        VOGL_ASSERT(pNode->m_marker == cUsedNodeMarker);
+        pNode->m_marker = cFreeNodeMarker;
+#endif
+
+        push_chain(pNode->m_index, pNode->m_index, 1);
+    }
+
+    // Writes a node header to pHeader (which must be 16 byte aligned) for memory that doesn't come from a freelist, so get_user_data() works on it. Returns the object pointer.
+    static void *init_unpooled_node(void *pHeader, uint user_data);
+    static void *get_unpooled_node_header(void *p)
+    {
+        return get_node_from_object_ptr(p);
+    }
+
+    // The user_data passed to init() by the freelist that allocated p.
+    static inline uint get_user_data(const void *p)
+    {
+        return get_node_from_object_ptr(p)->m_user_data;
+    }
+
+    // This frees all allocated memory, but does NOT destroy all objects. That's the caller's responsibility.
+    // Not safe to call while other threads are still using the freelist.
+    size_t clear();
+
+    // Frees every block whose nodes are all on the shared free stack. Safe to call while other threads are allocating/freeing.
+    // Nodes sitting in magazines keep their blocks alive.
+    size_t free_unused_blocks();
+
+    // Checks the blocks and counters. The freelist must be quiescent.
+    bool check() const;
+
+    bool is_valid_ptr(const void *p) const;
+
+    size_t get_total_blocks() const
+    {
+        return m_total_blocks;
+    }
+    size_t get_total_heap_bytes() const
+    {
+        return m_total_heap_bytes;
+    }
+    size_t get_total_nodes() const
+    {
+        return m_total_nodes;
+    }
+    // Nodes not on the shared free stack (this includes nodes cached in magazines).
+    size_t get_total_used_nodes() const
+    {
+        return static_cast<size_t>(m_total_used_nodes);
+    }
+    size_t get_total_free_nodes() const
+    {
+        return get_total_nodes() - get_total_used_nodes();
+    }
+    // The most nodes that have been in use at once since the last clear() or reset_high_water_mark().
+    size_t get_high_water_used_nodes() const
+    {
+        return static_cast<size_t>(m_high_water_used_nodes);
+    }
+    void reset_high_water_mark()
+    {
+        atomic_exchange32(&m_high_water_used_nodes, m_total_used_nodes);
+    }
+
+    // Single thread cache of free nodes. A magazine may only be used by one thread at a time, and must be destroyed (or flushed) before its freelist is cleared.
+    class magazine
+    {
+        VOGL_NO_COPY_OR_ASSIGNMENT_OP(magazine);
+
+    public:
+        enum
+        {
+            cMaxNodes = 64
+        };
+
+        magazine(concurrent_freelist &list)
+            : m_list(list),
+              m_num_nodes(0)
+        {
+        }
+
+        ~magazine()
+        {
+            flush();
+        }
+
+        concurrent_freelist &get_freelist() const
+        {
+            return m_list;
+        }
+
+        inline void *alloc()
+        {
+            if (!m_num_nodes)
+                refill();
+
+            node *pNode = m_list.get_node(m_nodes[--m_num_nodes]);
+
+#if VOGL_OBJECT_POOL_DEBUGGING
+            VOGL_ASSERT(pNode->m_marker == cFreeNodeMarker);
+            pNode->m_marker = cUsedNodeMarker;
+#endif
+
+            return pNode->get_object_ptr();
+        }
+
+        // p must have been allocated from this magazine's freelist (by any thread).
+        inline void free(void *p)
+        {
+            if (!p)
+                return;
+
+            node *pNode = get_node_from_object_ptr(p);
+
+#if VOGL_OBJECT_POOL_DEBUGGING
+            VOGL_ASSERT(pNode->m_marker == cUsedNodeMarker);
+            pNode->m_marker = cFreeNodeMarker;
+#endif
+
+            if (m_num_nodes == cMaxNodes)
+                flush(cMaxNodes / 2);
+
+            m_nodes[m_num_nodes++] = pNode->m_index;
+        }
+
+        // Returns the last n cached nodes (or all of them) to the shared stack.
+        void flush(uint n = cUINT32_MAX);
+
+    private:
+        concurrent_freelist &m_list;
+        uint m_num_nodes;
+        uint m_nodes[cMaxNodes];
+
+        void refill();
+    };
+
+private:
+    enum
+    {
+        cNodeOffsetMask = cMaxNodesPerBlock - 1,
+
+        cBlockMarker = 0x1234ABCD,
+        cUsedNodeMarker = 0xCC139876,
+        cFreeNodeMarker = 0xFF137654
+    };
+
+    // Node indices are (block slot << cNodeOffsetBits) | node offset. Links (and the stack head) store index + 1, so 0 is the end of a list.
+    struct node
+    {
+        uint m_index;
+        volatile uint m_next;
+        uint m_marker;
+        uint m_user_data;
+
+        void *get_object_ptr()
+        {
+            return reinterpret_cast<uint8 *>(this) + cNodeHeaderSize;
+        }
+    };
+
+    struct block
+    {
+        uint m_marker;
+        uint m_slot;
+        uint m_total_nodes;
+        uint m_node_size;
+
+        node *get_node(uint offset)
+        {
+            return reinterpret_cast<node *>(reinterpret_cast<uint8 *>(this) + sizeof(block) + offset * m_node_size);
+        }
+    };
+
+    uint m_obj_size;
+    uint m_node_size;
+    uint m_flags;
+    uint m_grow_size;
+    uint m_next_grow_size;
+    uint m_user_data;
+
+    // Low 32 bits: index + 1 of the top node, high 32 bits: a tag that's bumped by every successful exchange (to avoid ABA problems).
+    atomic64_t m_head;
+
+    // Number of pops in progress. free_unused_blocks() waits for this to drop to 0 before freeing blocks, because a pop may be reading a node in a block that's about to be freed.
+    atomic32_t m_active_pops;
+
+    atomic32_t m_total_used_nodes;
+    atomic32_t m_high_water_used_nodes;
+
+    // Blocks are only added/removed (and the members below only change) while holding this.
+    spinlock m_grow_lock;
+
+    volatile size_t m_total_nodes;
+    volatile size_t m_total_blocks;
+    volatile size_t m_total_heap_bytes;
+
+    uint m_num_used_block_slots;
+    block *m_block_slots[cMaxBlocks];
+
+    static inline node *get_node_from_object_ptr(const void *p)
+    {
+        return reinterpret_cast<node *>(const_cast<uint8 *>(static_cast<const uint8 *>(p)) - cNodeHeaderSize);
+    }
+
+    inline node *get_node(uint index) const
+    {
+        return m_block_slots[index >> cNodeOffsetBits]->get_node(index & cNodeOffsetMask);
+    }
+
+    static inline uint64_t make_head(uint64_t tag, uint link)
+    {
+        return (tag << 32U) | link;
+    }
+
+    // Links the nodes first..last (already chained through m_next) onto the shared stack.
+    inline void link_chain(uint first_index, uint last_index)
+    {
+        node *pLast = get_node(last_index);
+        for (;;)
+        {
+            uint64_t head = m_head;
+            pLast->m_next = static_cast<uint>(head);
+            if (static_cast<uint64_t>(atomic_compare_exchange64(&m_head, make_head((head >> 32U) + 1U, first_index + 1U), head)) == head)
+                break;
+            vogl_yield_processor();
+        }
+    }
+
+    inline void push_chain(uint first_index, uint last_index, uint n)
+    {
+        link_chain(first_index, last_index);
+        atomic_add32(&m_total_used_nodes, -static_cast<nonvolatile_atomic32_t>(n));
+    }
+
+    // Pops up to max_nodes nodes off the shared stack. The popped nodes stay chained through m_next. Returns 0 if the stack is empty.
+    inline uint pop_chain(uint max_nodes, uint &first_index)
+    {
+        atomic_increment32(&m_active_pops);
+
+        uint n;
+        for (;;)
+        {
+            uint64_t head = m_head;
+            uint link = static_cast<uint>(head);
+            if (!link)
+            {
+                n = 0;
+                break;
+            }
+
+            // Walk down the stack. The m_next values read here may be stale if another thread gets in first, but then the exchange will fail.
+            uint next_link = link;
+            n = 0;
+            while ((next_link) && (n < max_nodes))
+            {
+                next_link = get_node(next_link - 1U)->m_next;
+                n++;
+            }
+
+            if (static_cast<uint64_t>(atomic_compare_exchange64(&m_head, make_head((head >> 32U) + 1U, next_link), head)) == head)
+            {
+                first_index = link - 1U;
+                break;
+            }
+
+            vogl_yield_processor();
+        }
+
+        atomic_decrement32(&m_active_pops);
+
+        if (n)
+            update_used_nodes(n);
+
+        return n;
+    }
+
+    inline void update_used_nodes(uint n)
+    {
+        nonvolatile_atomic32_t used = atomic_add32(&m_total_used_nodes, static_cast<nonvolatile_atomic32_t>(n));
+
+        nonvolatile_atomic32_t high_water = m_high_water_used_nodes;
+        while (used > high_water)
+        {
+            nonvolatile_atomic32_t prev = atomic_compare_exchange32(&m_high_water_used_nodes, used, high_water);
+            if (prev == high_water)
+                break;
+            high_water = prev;
+        }
+    }
+
+    uint last_link_of_chain(uint link) const;
+
+    void grow();
+};
+
+template <typename T>
+class concurrent_object_pool
+{
+    VOGL_NO_COPY_OR_ASSIGNMENT_OP(concurrent_object_pool);
+
+public:
+    concurrent_object_pool(size_t grow_size = 0, uint flags = cObjectPoolGrowExponential | cObjectPoolClearOnDestruction)
+        : m_list(sizeof(T), static_cast<uint>(math::minimum<size_t>(grow_size, concurrent_freelist::cMaxNodesPerBlock)), flags)
+    {
+    }
+
+    inline T *alloc()
+    {
+        T *pObj = static_cast<T *>(m_list.alloc());
+        scalar_type<T>::construct(pObj);
+        return pObj;
+    }
+
+    template <typename U>
+    inline T *alloc(const U &a)
+    {
+        T *pObj = static_cast<T *>(m_list.alloc());
+        scalar_type<T>::construct(pObj, a);
+        return pObj;
+    }
+
+    template <typename U, typename V>
+    inline T *alloc(const U &a, const V &b)
+    {
+        T *pObj = static_cast<T *>(m_list.alloc());
+        new (static_cast<void *>(pObj)) T(a, b);
+        return pObj;
+    }
+
+    template <typename U, typename V, typename W>
+    inline T *alloc(const U &a, const V &b, const W &c)
+    {
+        T *pObj = static_cast<T *>(m_list.alloc());
+        new (static_cast<void *>(pObj)) T(a, b, c);
+        return pObj;
+    }
+
+    template <typename U, typename V, typename W, typename X>
+    inline T *alloc(const U &a, const V &b, const W &c, const X &d)
+    {
+        T *pObj = static_cast<T *>(m_list.alloc());
+        new (static_cast<void *>(pObj)) T(a, b, c, d);
+        return pObj;
+    }
+
+    inline T *alloc_no_construction()
+    {
+        return static_cast<T *>(m_list.alloc());
+    }
+
+    inline void destroy_no_destruction(T *p)
+    {
+        m_list.free(p);
+    }
+
+    inline void destroy(T *p)
+    {
+        if (p)
+        {
+            scalar_type<T>::destruct(p);
+            m_list.free(p);
+        }
+    }
+
+    size_t clear()
+    {
+        return m_list.clear();
+    }
+
+    size_t free_unused_blocks()
+    {
+        return m_list.free_unused_blocks();
+    }
+
+    bool check() const
+    {
+        return m_list.check();
+    }
+
+    bool is_valid_ptr(const T *p) const
+    {
+        return m_list.is_valid_ptr(p);
+    }
+
+    size_t get_total_blocks() const
+    {
+        return m_list.get_total_blocks();
+    }
+    size_t get_total_heap_bytes() const
+    {
+        return m_list.get_total_heap_bytes();
+    }
+    size_t get_total_nodes() const
+    {
+        return m_list.get_total_nodes();
+    }
+    size_t get_total_free_nodes() const
+    {
+        return m_list.get_total_free_nodes();
+    }
+    size_t get_total_used_nodes() const
+    {
+        return m_list.get_total_used_nodes();
+    }
+    size_t get_high_water_used_nodes() const
+    {
+        return m_list.get_high_water_used_nodes();
+    }
+    void reset_high_water_mark()
+    {
+        m_list.reset_high_water_mark();
+    }
+
+    class magazine
+    {
+        VOGL_NO_COPY_OR_ASSIGNMENT_OP(magazine);
+
+    public:
+        magazine(concurrent_object_pool &pool)
+            : m_magazine(pool.m_list)
+        {
+        }
+
+        inline T *alloc()
+        {
+            T *pObj = static_cast<T *>(m_magazine.alloc());
+            scalar_type<T>::construct(pObj);
+            return pObj;
+        }
+
+        template <typename U>
+        inline T *alloc(const U &a)
+        {
+            T *pObj = static_cast<T *>(m_magazine.alloc());
+            scalar_type<T>::construct(pObj, a);
+            return pObj;
+        }
+
+        template <typename U, typename V>
+        inline T *alloc(const U &a, const V &b)
+        {
+            T *pObj = static_cast<T *>(m_magazine.alloc());
+            new (static_cast<void *>(pObj)) T(a, b);
+            return pObj;
+        }
+
+        inline T *alloc_no_construction()
+        {
+            return static_cast<T *>(m_magazine.alloc());
+        }
+
+        inline void destroy_no_destruction(T *p)
+        {
+            m_magazine.free(p);
+        }
+
+        inline void destroy(T *p)
+        {
+            if (p)
+            {
+                scalar_type<T>::destruct(p);
+                m_magazine.free(p);
+            }
+        }
+
+        void flush()
+        {
+            m_magazine.flush();
+        }
+
+    private:
+        concurrent_freelist::magazine m_magazine;
+    };
+
+private:
+    concurrent_freelist m_list;
+};
+
+// Variable size buffers, rounded up to power of 2 size classes. Buffers larger than the biggest class come straight from the heap.
+// All buffers are 16 byte aligned.
+class concurrent_buffer_pool
+{
+    VOGL_NO_COPY_OR_ASSIGNMENT_OP(concurrent_buffer_pool);
+
+public:
+    enum
+    {
+        cMinSizeClassLog2 = 4,
+        cMaxSizeClassLog2 = 16,
+        cNumSizeClasses = cMaxSizeClassLog2 - cMinSizeClassLog2 + 1,
+        cMaxPooledSize = 1U << cMaxSizeClassLog2
+    };
+
+    concurrent_buffer_pool(uint grow_size = 0);
+    ~concurrent_buffer_pool();
+
+    static inline uint get_size_class(size_t size)
+    {
+        if (size <= (1U << cMinSizeClassLog2))
+            return 0;
+        return math::ceil_log2i(static_cast<uint>(size)) - cMinSizeClassLog2;
+    }
+
+    static inline uint get_size_class_size(uint size_class)
+    {
+        return 1U << (size_class + cMinSizeClassLog2);
+    }
+
+    // Never returns NULL for sizes that fit in a size class.
+    inline void *alloc(size_t size)
+    {
+        if (size > cMaxPooledSize)
+            return alloc_large(size);
+        return m_size_classes[get_size_class(size)].alloc();
+    }
+
+    inline void free(void *p)
+    {
+        if (!p)
+            return;
+
+        uint size_class = concurrent_freelist::get_user_data(p);
+        if (size_class == cLargeSizeClass)
+            free_large(p);
+        else
+            m_size_classes[size_class].free(p);
+    }
+
+    // The usable size of a buffer returned by alloc().
+    static size_t get_buffer_size(const void *p);
+
+    // Not safe to call while other threads are still using the pool.
+    size_t clear();
+
+    size_t free_unused_blocks();
+
+    const concurrent_freelist &get_size_class_freelist(uint size_class) const
+    {
+        VOGL_ASSERT(size_class < cNumSizeClasses);
+        return m_size_classes[size_class];
+    }
+
+    size_t get_total_heap_bytes() const;
+
+    // Large buffers currently allocated.
+    size_t get_total_large_bytes() const
+    {
+        return static_cast<size_t>(m_total_large_bytes);
+    }
+
+    class magazine
+    {
+        VOGL_NO_COPY_OR_ASSIGNMENT_OP(magazine);
+
+    public:
+        magazine(concurrent_buffer_pool &pool);
+        ~magazine();
+
+        inline void *alloc(size_t size)
+        {
+            if (size > cMaxPooledSize)
+                return m_pool.alloc_large(size);
+            return get_magazine(get_size_class(size)).alloc();
+        }
+
+        inline void free(void *p)
+        {
+            if (!p)
+                return;
+
+            uint size_class = concurrent_freelist::get_user_data(p);
+            if (size_class == cLargeSizeClass)
+                m_pool.free_large(p);
+            else
+                get_magazine(size_class).free(p);
+        }
+
+        void flush();
+
+    private:
+        concurrent_buffer_pool &m_pool;
+
+        // Created on first use, most threads only touch a few size classes.
+        concurrent_freelist::magazine *m_pMagazines[cNumSizeClasses];
+
+        inline concurrent_freelist::magazine &get_magazine(uint size_class)
+        {
+            if (!m_pMagazines[size_class])
+                m_pMagazines[size_class] = vogl_new(concurrent_freelist::magazine, m_pool.m_size_classes[size_class]);
+            return *m_pMagazines[size_class];
+        }
+    };
+
+private:
+    enum
+    {
+        cLargeSizeClass = 0xFFFFFFFF
+    };
+
+    concurrent_freelist m_size_classes[cNumSizeClasses];
+    atomic32_t m_total_large_bytes;
+
+    void *alloc_large(size_t size);
+    void free_large(void *p);
+};
+
+bool concurrent_pool_test();
+
+VOGL_NAMESPACE_END(vogl)
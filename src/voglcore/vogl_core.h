@@ -53,6 +53,7 @@
 #include <typeinfo>
 #include <functional>
 #include <iterator>
+#include <utility>
 
 #ifdef min
     #undef min
@@ -89,6 +90,23 @@
     #endif
 #endif
 
+// Move construction/assignment and emplace are only compiled in when the compiler supports rvalue references and
+// variadic templates. Everything else only requires C++98, so containers fall back to copying (or bitwise moves).
+#ifndef VOGL_HAS_MOVE_SEMANTICS
+    #if (__cplusplus >= 201103L) || (defined(_MSC_VER) && (_MSC_VER >= 1800))
+        #define VOGL_HAS_MOVE_SEMANTICS 1
+    #else
+        #define VOGL_HAS_MOVE_SEMANTICS 0
+    #endif
+#endif
+
+// VOGL_MOVE(x) casts x to an rvalue when move semantics are available, otherwise it's a plain (copying) lvalue.
+#if VOGL_HAS_MOVE_SEMANTICS
+    #define VOGL_MOVE(x) std::move(x)
+#else
+    #define VOGL_MOVE(x) (x)
+#endif
+
 #include "vogl_warnings.h"
 #include "vogl_types.h"
 #include "vogl_assert.h"
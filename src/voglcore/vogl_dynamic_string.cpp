@@ -28,6 +28,9 @@
 #include "vogl_core.h"
 #include "vogl_strutils.h"
 #include "vogl_json.h"
+#include "vogl_hash_map.h"
+#include "vogl_map.h"
+#include "vogl_unique_ptr.h"
 
 #if VOGL_SLOW_STRING_LEN_CHECKS
 #pragma message("Warning: Slow string checking enabled")
@@ -535,33 +538,48 @@ namespace vogl
         return dynamic_string(a).append(b);
     }
 
-    dynamic_string &dynamic_string::format_args(const char *p, va_list args)
+    // Formats into pBuf (a buf_size byte buffer) if the result fits, otherwise into a heap block which is returned in pBuf (free it with vogl_free()).
+    // Returns the formatted length, or -1 on errors.
+    static int format_to_buf(char *&pBuf, int buf_size, const char *p, va_list args)
     {
-        VOGL_ASSERT(p);
-
-        const uint cBufSize = 4096;
-        int buf_size = cBufSize;
-        char buf[cBufSize];
-        char *pBuf = buf;
-
+        va_list args_copy;
+        va_copy(args_copy, args);
 #ifdef COMPILER_MSVC
-        int l = vsnprintf_s(pBuf, buf_size, _TRUNCATE, p, args);
+        int l = vsnprintf_s(pBuf, buf_size, _TRUNCATE, p, args_copy);
 #else
-        int l = vsnprintf(pBuf, buf_size, p, args);
+        int l = vsnprintf(pBuf, buf_size, p, args_copy);
 #endif
+        va_end(args_copy);
 
         if (l >= buf_size)
         {
+            // Only happens for very long strings, so the second pass is rare.
             buf_size = l + 1;
             pBuf = static_cast<char *>(vogl_malloc(buf_size));
 
+            va_copy(args_copy, args);
 #ifdef COMPILER_MSVC
-            l = vsnprintf_s(pBuf, buf_size, _TRUNCATE, p, args);
+            l = vsnprintf_s(pBuf, buf_size, _TRUNCATE, p, args_copy);
 #else
-            l = vsnprintf(pBuf, buf_size, p, args);
+            l = vsnprintf(pBuf, buf_size, p, args_copy);
 #endif
+            va_end(args_copy);
         }
 
+        return l;
+    }
+
+    dynamic_string &dynamic_string::format_args(const char *p, va_list args)
+    {
+        VOGL_ASSERT(p);
+
+        // Formatting goes through a temp buffer first, because the args may point into this string.
+        const uint cBufSize = 4096;
+        char buf[cBufSize];
+        char *pBuf = buf;
+
+        int l = format_to_buf(pBuf, cBufSize, p, args);
+
         if (l > cMaxDynamicStringLen)
         {
             VOGL_ASSERT_ALWAYS;
@@ -588,6 +606,25 @@ namespace vogl
         return *this;
     }
 
+    dynamic_string &dynamic_string::format_append_args(const char *p, va_list args)
+    {
+        VOGL_ASSERT(p);
+
+        const uint cBufSize = 4096;
+        char buf[cBufSize];
+        char *pBuf = buf;
+
+        int l = format_to_buf(pBuf, cBufSize, p, args);
+
+        if (l > 0)
+            append(pBuf, l);
+
+        if (pBuf != buf)
+            vogl_free(pBuf);
+
+        return *this;
+    }
+
     dynamic_string &dynamic_string::format(const char *p, ...)
     {
         VOGL_ASSERT(p);
@@ -603,18 +640,44 @@ namespace vogl
     {
         VOGL_ASSERT(p);
 
-        dynamic_string temp;
-
         va_list args;
         va_start(args, p);
-        temp.format_args(p, args);
+        format_append_args(p, args);
         va_end(args);
 
-        append(temp);
-
         return *this;
     }
 
+    dynamic_string &dynamic_string::append_uint64(uint64_t val)
+    {
+        char buf[cMaxNumberStringBufSize];
+        return append(buf, uint64_to_chars(val, buf));
+    }
+
+    dynamic_string &dynamic_string::append_int64(int64_t val)
+    {
+        char buf[cMaxNumberStringBufSize];
+        return append(buf, int64_to_chars(val, buf));
+    }
+
+    dynamic_string &dynamic_string::append_hex(uint64_t val, uint min_digits, bool upper_case)
+    {
+        char buf[cMaxNumberStringBufSize];
+        return append(buf, uint64_to_hex_chars(val, buf, min_digits, upper_case));
+    }
+
+    dynamic_string &dynamic_string::append_double(double val)
+    {
+        char buf[cMaxNumberStringBufSize];
+        return append(buf, double_to_chars(val, buf));
+    }
+
+    dynamic_string &dynamic_string::append_float(float val)
+    {
+        char buf[cMaxNumberStringBufSize];
+        return append(buf, float_to_chars(val, buf));
+    }
+
     dynamic_string &dynamic_string::crop(uint start, uint len)
     {
         if (start >= m_len)
@@ -1264,6 +1327,43 @@ namespace vogl
             CHECK(x == "BlahBlahBlahBlahBlahBlahBlahBlahBlahBlahBlahBlahBlahBlahBlahBlahBlahBlahBlahBlahBlahBlahBlahBlahBlahBlahBlahBlahBlahBlahBlahBlahBlahBlahBlahBlahBlahBlahBlahBlahBlahBlahBlahBlahBlahBlahBlahBlahBlahBlahBlahBlahBlahBlahBlahBlahBlahBlahBlahBlahBlahBlahBlahBlah");
         }
 
+#if VOGL_HAS_MOVE_SEMANTICS
+        {
+            // Moving strings into and around containers must never copy their heap buffers.
+            dynamic_string x("This string is long enough to live on the heap");
+            const char *pBuf = x.get_ptr();
+
+            dynamic_string_array strs;
+            strs.push_back(std::move(x));
+            CHECK(x.is_empty() && (strs[0].get_ptr() == pBuf));
+
+            strs.insert(0, dynamic_string("A"));
+            strs.emplace_back("B");
+            CHECK((strs.size() == 3) && (strs[0] == "A") && (strs[1].get_ptr() == pBuf) && (strs[2] == "B"));
+
+            hash_map<dynamic_string, dynamic_string> h;
+            h.insert(std::move(strs[1]), dynamic_string("X"));
+            CHECK(h.begin()->first.get_ptr() == pBuf);
+            for (uint i = 0; i < 100; i++)
+                h.emplace(dynamic_string(cVarArg, "%u", i), "Y");
+            CHECK((h.size() == 101) && (h.find(pBuf) != h.end()) && (h.find(pBuf)->first.get_ptr() == pBuf));
+
+            dynamic_string y(std::move(h.find(pBuf)->first));
+            vogl::map<dynamic_string, uint> m;
+            CHECK(m.emplace(std::move(y), 1U).second);
+            CHECK(m.begin()->first.get_ptr() == pBuf);
+
+            // Move-only elements.
+            vogl::vector<vogl_unique_ptr<dynamic_string> > ptrs;
+            for (uint i = 0; i < 100; i++)
+                ptrs.push_back(vogl_unique_ptr<dynamic_string>(vogl_new(dynamic_string, cVarArg, "%u", i)));
+            ptrs.erase(0U);
+            ptrs.insert(0, vogl_unique_ptr<dynamic_string>(vogl_new(dynamic_string, "0")));
+            for (uint i = 0; i < 100; i++)
+                CHECK(string_to_uint(ptrs[i]->get_ptr()) == i);
+        }
+#endif
+
         {
             dynamic_string_array tokens;
             dynamic_string x("   This is,a, test   ");
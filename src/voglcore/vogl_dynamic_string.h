@@ -69,6 +69,15 @@ namespace vogl
         dynamic_string(const char *p, uint len);
         dynamic_string(const dynamic_string &other);
 
+#if VOGL_HAS_MOVE_SEMANTICS
+        // Takes other's buffer (dynamic_string is bitwise movable), other is left empty.
+        inline dynamic_string(dynamic_string &&other)
+        {
+            memcpy(static_cast<void *>(this), &other, sizeof(*this));
+            other.set_to_empty_small_string();
+        }
+#endif
+
         inline ~dynamic_string()
         {
             if (is_dynamic())
@@ -247,6 +256,18 @@ namespace vogl
             return set(p);
         }
 
+#if VOGL_HAS_MOVE_SEMANTICS
+        dynamic_string &operator=(dynamic_string &&rhs)
+        {
+            if (this != &rhs)
+            {
+                clear();
+                swap(rhs);
+            }
+            return *this;
+        }
+#endif
+
         dynamic_string &set_char(uint index, char c);
         dynamic_string &append_char(char c);
         dynamic_string &append_char(int c)
@@ -276,9 +297,19 @@ namespace vogl
         friend dynamic_string operator+(const dynamic_string &a, const dynamic_string &b);
 
         dynamic_string &format_args(const char *p, va_list args);
+        dynamic_string &format_append_args(const char *p, va_list args);
         dynamic_string &format(const char *p, ...) VOGL_ATTRIBUTE_PRINTF(2, 3);
         dynamic_string &format_append(const char *p, ...) VOGL_ATTRIBUTE_PRINTF(2, 3);
 
+        // Typed appends, much cheaper than format_append() because they don't go through vsnprintf().
+        dynamic_string &append_uint64(uint64_t val);
+        dynamic_string &append_int64(int64_t val);
+        // No "0x" prefix, zero padded to min_digits.
+        dynamic_string &append_hex(uint64_t val, uint min_digits = 0, bool upper_case = true);
+        // Shortest representation that reads back as exactly the same value.
+        dynamic_string &append_double(double val);
+        dynamic_string &append_float(float val);
+
         // Note many of these ops are IN-PLACE string operations to avoid constructing new dynamic_string objects.
         // Yes this is awkward, one way to work around this is to close the string like this (which introduces a clone and then does the op in-place):
         // result = str.get_clone().left(x);
@@ -106,6 +106,24 @@ namespace vogl
             return *this;
         }
 
+#if VOGL_HAS_MOVE_SEMANTICS
+        hash_map(hash_map &&other)
+            : m_hash_shift(32), m_num_valid(0), m_grow_threshold(0)
+        {
+            swap(other);
+        }
+
+        hash_map &operator=(hash_map &&other)
+        {
+            if (this != &other)
+            {
+                clear();
+                swap(other);
+            }
+            return *this;
+        }
+#endif
+
         inline ~hash_map()
         {
             clear();
@@ -200,7 +218,7 @@ namespace vogl
             }
             else if (sizeof(node) <= 32)
             {
-                memset(&m_values[0], 0, m_values.size_in_bytes());
+                memset(static_cast<void *>(&m_values[0]), 0, m_values.size_in_bytes());
             }
             else
             {
@@ -522,66 +540,75 @@ namespace vogl
 
         inline bool insert_no_grow(insert_result &result, const Key &k, const Value &v = Value())
         {
-            if (!m_values.size())
+            bool found;
+            int index = find_insert_index(k, found);
+            if (index < 0)
                 return false;
 
-            int index = hash_key(k);
-            node *pNode = &get_node(index);
-
-            if (pNode->state)
+            if (!found)
             {
-                if (m_equals(pNode->first, k))
-                {
-                    result.first = iterator(*this, index);
-                    result.second = false;
-                    return true;
-                }
+                node *pNode = &get_node(index);
 
-                const int orig_index = index;
+                construct_value_type(pNode, k, v);
 
-                for (;;)
-                {
-                    if (!index)
-                    {
-                        index = m_values.size() - 1;
-                        pNode = &get_node(index);
-                    }
-                    else
-                    {
-                        index--;
-                        pNode--;
-                    }
+                pNode->state = cStateValid;
 
-                    if (orig_index == index)
-                        return false;
+                m_num_valid++;
+                VOGL_ASSERT(m_num_valid <= m_values.size());
+            }
 
-                    if (!pNode->state)
-                        break;
+            result.first = iterator(*this, index);
+            result.second = !found;
 
-                    if (m_equals(pNode->first, k))
-                    {
-                        result.first = iterator(*this, index);
-                        result.second = false;
-                        return true;
-                    }
+            return true;
+        }
+
+#if VOGL_HAS_MOVE_SEMANTICS
+        inline insert_result insert(Key &&k, Value &&v)
+        {
+            return emplace(std::move(k), std::move(v));
+        }
+
+        inline insert_result insert(value_type &&v)
+        {
+            return emplace(std::move(v.first), std::move(v.second));
+        }
+
+        // Like insert(), but the key and value are constructed in place from the supplied arguments (only if the key isn't already present).
+        // k is only moved from if a new key/value is inserted.
+        template <typename K, typename... Args>
+        inline insert_result emplace(K &&k, Args &&... args)
+        {
+            bool found;
+            int index = find_insert_index(k, found);
+            if (index < 0)
+            {
+                grow();
+
+                // This must succeed.
+                index = find_insert_index(k, found);
+                if (index < 0)
+                {
+                    VOGL_FAIL("emplace() failed");
                 }
             }
 
-            if (m_num_valid >= m_grow_threshold)
-                return false;
-
-            construct_value_type(pNode, k, v);
+            if (!found)
+            {
+                node *pNode = &get_node(index);
 
-            pNode->state = cStateValid;
+                helpers::construct_emplace(&pNode->first, std::forward<K>(k));
+                helpers::construct_emplace(&pNode->second, std::forward<Args>(args)...);
 
-            m_num_valid++;
-            VOGL_ASSERT(m_num_valid <= m_values.size());
+                pNode->state = cStateValid;
 
-            result.first = iterator(*this, index);
-            result.second = true;
+                m_num_valid++;
+                VOGL_ASSERT(m_num_valid <= m_values.size());
+            }
 
-            return true;
+            return insert_result(iterator(*this, index), !found);
         }
+#endif
 
         inline Value &operator[](const Key &key)
         {
@@ -866,15 +893,70 @@ namespace vogl
             uint8 state;
         };
 
+        // Returns the index of the node containing k (found will be true), or of the empty node k should be inserted into (found will be false).
+        // Returns -1 if k isn't present and the container must grow before it can be inserted.
+        inline int find_insert_index(const Key &k, bool &found)
+        {
+            found = false;
+
+            if (!m_values.size())
+                return -1;
+
+            int index = hash_key(k);
+            node *pNode = &get_node(index);
+
+            if (pNode->state)
+            {
+                if (m_equals(pNode->first, k))
+                {
+                    found = true;
+                    return index;
+                }
+
+                const int orig_index = index;
+
+                for (;;)
+                {
+                    if (!index)
+                    {
+                        index = m_values.size() - 1;
+                        pNode = &get_node(index);
+                    }
+                    else
+                    {
+                        index--;
+                        pNode--;
+                    }
+
+                    if (orig_index == index)
+                        return -1;
+
+                    if (!pNode->state)
+                        break;
+
+                    if (m_equals(pNode->first, k))
+                    {
+                        found = true;
+                        return index;
+                    }
+                }
+            }
+
+            if (m_num_valid >= m_grow_threshold)
+                return -1;
+
+            return index;
+        }
+
         static inline void construct_value_type(value_type *pDst, const Key &k, const Value &v)
         {
             if (VOGL_IS_BITWISE_COPYABLE(Key))
-                memcpy(&pDst->first, &k, sizeof(Key));
+                memcpy(static_cast<void *>(&pDst->first), &k, sizeof(Key));
             else
                 scalar_type<Key>::construct(&pDst->first, k);
 
             if (VOGL_IS_BITWISE_COPYABLE(Value))
-                memcpy(&pDst->second, &v, sizeof(Value));
+                memcpy(static_cast<void *>(&pDst->second), &v, sizeof(Value));
             else
                 scalar_type<Value>::construct(&pDst->second, v);
         }
@@ -883,17 +965,17 @@ namespace vogl
         {
             if ((VOGL_IS_BITWISE_COPYABLE(Key)) && (VOGL_IS_BITWISE_COPYABLE(Value)))
             {
-                memcpy(pDst, pSrc, sizeof(value_type));
+                memcpy(static_cast<void *>(pDst), pSrc, sizeof(value_type));
             }
             else
             {
                 if (VOGL_IS_BITWISE_COPYABLE(Key))
-                    memcpy(&pDst->first, &pSrc->first, sizeof(Key));
+                    memcpy(static_cast<void *>(&pDst->first), &pSrc->first, sizeof(Key));
                 else
                     scalar_type<Key>::construct(&pDst->first, pSrc->first);
 
                 if (VOGL_IS_BITWISE_COPYABLE(Value))
-                    memcpy(&pDst->second, &pSrc->second, sizeof(Value));
+                    memcpy(static_cast<void *>(&pDst->second), &pSrc->second, sizeof(Value));
                 else
                     scalar_type<Value>::construct(&pDst->second, pSrc->second);
             }
@@ -913,25 +995,19 @@ namespace vogl
 
             if (VOGL_IS_BITWISE_COPYABLE_OR_MOVABLE(Key) && VOGL_IS_BITWISE_COPYABLE_OR_MOVABLE(Value))
             {
-                memcpy(pDst, pSrc, sizeof(node));
+                memcpy(static_cast<void *>(pDst), pSrc, sizeof(node));
             }
             else
             {
                 if (VOGL_IS_BITWISE_COPYABLE_OR_MOVABLE(Key))
-                    memcpy(&pDst->first, &pSrc->first, sizeof(Key));
+                    memcpy(static_cast<void *>(&pDst->first), &pSrc->first, sizeof(Key));
                 else
-                {
-                    scalar_type<Key>::construct(&pDst->first, pSrc->first);
-                    scalar_type<Key>::destruct(&pSrc->first);
-                }
+                    helpers::move(pDst->first, pSrc->first);
 
                 if (VOGL_IS_BITWISE_COPYABLE_OR_MOVABLE(Value))
-                    memcpy(&pDst->second, &pSrc->second, sizeof(Value));
+                    memcpy(static_cast<void *>(&pDst->second), &pSrc->second, sizeof(Value));
                 else
-                {
-                    scalar_type<Value>::construct(&pDst->second, pSrc->second);
-                    scalar_type<Value>::destruct(&pSrc->second);
-                }
+                    helpers::move(pDst->second, pSrc->second);
 
                 pDst->state = cStateValid;
             }
@@ -968,6 +1044,19 @@ namespace vogl
                     pDst->state = cStateInvalid;
             }
 
+#if VOGL_HAS_MOVE_SEMANTICS
+            // Only used when the node vector relocates its elements. This avoids deep copying (and allows move-only keys/values).
+            inline raw_node(raw_node &&other)
+            {
+                node *pDst = reinterpret_cast<node *>(this);
+                node *pSrc = reinterpret_cast<node *>(&other);
+
+                pDst->state = cStateInvalid;
+                if (pSrc->state)
+                    hash_map_type::move_node(pDst, pSrc);
+            }
+#endif
+
             inline raw_node &operator=(const raw_node &rhs)
             {
                 if (this == &rhs)
@@ -75,6 +75,14 @@ namespace vogl
             return new (static_cast<void *>(p)) T(init);
         }
 
+#if VOGL_HAS_MOVE_SEMANTICS
+        template <typename T, typename... Args>
+        inline T *construct_emplace(T *p, Args &&... args)
+        {
+            return new (static_cast<void *>(p)) T(std::forward<Args>(args)...);
+        }
+#endif
+
         template <typename T>
         inline void construct_array(T *p, uint n)
         {
@@ -253,27 +253,19 @@ namespace vogl
             const uint half_width = m_width / 2;
             for (uint y = 0; y < m_height; y++)
             {
+                color_type *pL = get_scanline(y);
+                color_type *pR = pL + m_width - 1;
                 for (uint x = 0; x < half_width; x++)
-                {
-                    color_type c((*this)(x, y));
-                    (*this)(x, y) = (*this)(m_width - 1 - x, y);
-                    (*this)(m_width - 1 - x, y) = c;
-                }
+                    std::swap(*pL++, *pR--);
             }
         }
 
         void flip_y()
         {
+            // Swap whole scanlines, these are contiguous so this vectorizes well.
             const uint half_height = m_height / 2;
             for (uint y = 0; y < half_height; y++)
-            {
-                for (uint x = 0; x < m_width; x++)
-                {
-                    color_type c((*this)(x, y));
-                    (*this)(x, y) = (*this)(x, m_height - 1 - y);
-                    (*this)(x, m_height - 1 - y) = c;
-                }
-            }
+                std::swap_ranges(get_scanline(y), get_scanline(y) + m_width, get_scanline(m_height - 1 - y));
         }
 
         void convert_to_grayscale()
@@ -46,6 +46,13 @@
 
 #include "vogl_pixel_format.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+    #define VOGL_IMAGE_UTILS_SSE2 1
+    #include <emmintrin.h>
+#else
+    #define VOGL_IMAGE_UTILS_SSE2 0
+#endif
+
 namespace vogl
 {
     const float cInfinitePSNR = 999999.0f;
@@ -899,31 +906,158 @@ namespace vogl
                 return resample_single_thread(src, dst, params);
         }
 
-        bool compute_delta(image_u8 &dest, const image_u8 &a, const image_u8 &b, uint scale)
+        // Images with at least this many pixels are processed in bands of rows on a temporary task pool.
+        const uint cMinPixelsForRowParallelism = 256 * 256;
+
+        typedef void (*row_range_func)(uint first_row, uint end_row, void *pContext);
+
+        struct row_range_task
         {
-            if ((a.get_width() != b.get_width()) || (a.get_height() != b.get_height()))
-                return false;
+            row_range_func m_pFunc;
+            void *m_pContext;
+        };
 
-            dest.crop(a.get_width(), b.get_height());
+        static void row_range_task_callback(uint64_t data, void *pData_ptr)
+        {
+            const row_range_task *pTask = static_cast<const row_range_task *>(pData_ptr);
+            pTask->m_pFunc(static_cast<uint>(data), static_cast<uint>(data >> 32U), pTask->m_pContext);
+        }
+
+        // Calls pFunc over [0, height) in bands of rows, which are multiples of row_granularity (except the last one).
+        // Each call must only write to state owned by its rows.
+        static void process_rows(uint width, uint height, uint row_granularity, row_range_func pFunc, void *pContext)
+        {
+            if ((g_number_of_processors <= 1) || ((static_cast<uint64_t>(width) * height) < cMinPixelsForRowParallelism) || (height < row_granularity * 2))
+            {
+                pFunc(0, height, pContext);
+                return;
+            }
+
+            task_pool tp;
+            if (!tp.init(g_number_of_processors - 1))
+            {
+                pFunc(0, height, pContext);
+                return;
+            }
+
+            row_range_task task;
+            task.m_pFunc = pFunc;
+            task.m_pContext = pContext;
+
+            // A few bands per thread, so uneven rows still balance out.
+            const uint num_bands = math::minimum<uint>(g_number_of_processors * 4, height / row_granularity);
+            const uint rows_per_band = (((height + num_bands - 1) / num_bands + row_granularity - 1) / row_granularity) * row_granularity;
+
+            for (uint first_row = 0; first_row < height; first_row += rows_per_band)
+            {
+                const uint end_row = math::minimum(height, first_row + rows_per_band);
+                if (!tp.queue_task(row_range_task_callback, first_row | (static_cast<uint64_t>(end_row) << 32U), &task))
+                    pFunc(first_row, end_row, pContext);
+            }
+
+            tp.join();
+        }
+
+#if VOGL_IMAGE_UTILS_SSE2
+        // Same result as color_quad_u8::get_luma() for 4 RGBA pixels, in 32-bit lanes.
+        static inline __m128i luma_sse2(__m128i p)
+        {
+            const __m128i rb = _mm_and_si128(p, _mm_set1_epi32(0x00FF00FF));
+            const __m128i g = _mm_and_si128(_mm_srli_epi32(p, 8), _mm_set1_epi32(0xFF));
 
-            for (uint y = 0; y < a.get_height(); y++)
+            // 38470 doesn't fit in a signed 16-bit madd weight, so G is weighted by 19235 and doubled.
+            __m128i l = _mm_madd_epi16(rb, _mm_set1_epi32(19595 | (7471 << 16)));
+            l = _mm_add_epi32(l, _mm_slli_epi32(_mm_madd_epi16(g, _mm_set1_epi32(19235)), 1));
+
+            return _mm_srli_epi32(_mm_add_epi32(l, _mm_set1_epi32(32768)), 16);
+        }
+
+        static inline __m128i load_pixels_sse2(const color_quad_u8 *p)
+        {
+            return _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+        }
+
+        static inline void store_pixels_sse2(color_quad_u8 *p, __m128i v)
+        {
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(p), v);
+        }
+#endif
+
+        static void compute_delta_row(color_quad_u8 *pDst, const color_quad_u8 *pA, const color_quad_u8 *pB, uint n, uint scale)
+        {
+            uint i = 0;
+
+#if VOGL_IMAGE_UTILS_SSE2
+            // (a - b) * scale must fit in 16 bits, the saturating add + pack then matches the scalar clamp.
+            if (scale <= 128)
             {
-                for (uint x = 0; x < a.get_width(); x++)
+                const __m128i zero = _mm_setzero_si128();
+                const __m128i scale16 = _mm_set1_epi16(static_cast<short>(scale));
+                const __m128i bias = _mm_set1_epi16(128);
+
+                for (; (i + 4) <= n; i += 4)
                 {
-                    const color_quad_u8 &ca = a(x, y);
-                    const color_quad_u8 &cb = b(x, y);
+                    const __m128i a = load_pixels_sse2(pA + i);
+                    const __m128i b = load_pixels_sse2(pB + i);
 
-                    color_quad_u8 cd;
-                    for (uint c = 0; c < 4; c++)
-                    {
-                        int d = (ca[c] - cb[c]) * scale + 128;
-                        d = math::clamp(d, 0, 255);
-                        cd[c] = static_cast<uint8>(d);
-                    }
+                    __m128i lo = _mm_sub_epi16(_mm_unpacklo_epi8(a, zero), _mm_unpacklo_epi8(b, zero));
+                    __m128i hi = _mm_sub_epi16(_mm_unpackhi_epi8(a, zero), _mm_unpackhi_epi8(b, zero));
 
-                    dest(x, y) = cd;
+                    lo = _mm_adds_epi16(_mm_mullo_epi16(lo, scale16), bias);
+                    hi = _mm_adds_epi16(_mm_mullo_epi16(hi, scale16), bias);
+
+                    store_pixels_sse2(pDst + i, _mm_packus_epi16(lo, hi));
+                }
+            }
+#endif
+
+            for (; i < n; i++)
+            {
+                const color_quad_u8 &ca = pA[i];
+                const color_quad_u8 &cb = pB[i];
+
+                color_quad_u8 cd;
+                for (uint c = 0; c < 4; c++)
+                {
+                    int d = (ca[c] - cb[c]) * scale + 128;
+                    d = math::clamp(d, 0, 255);
+                    cd[c] = static_cast<uint8>(d);
                 }
+
+                pDst[i] = cd;
             }
+        }
+
+        struct compute_delta_context
+        {
+            image_u8 *m_pDest;
+            const image_u8 *m_pA;
+            const image_u8 *m_pB;
+            uint m_scale;
+        };
+
+        static void compute_delta_rows(uint first_row, uint end_row, void *pContext)
+        {
+            const compute_delta_context &ctx = *static_cast<const compute_delta_context *>(pContext);
+
+            for (uint y = first_row; y < end_row; y++)
+                compute_delta_row(ctx.m_pDest->get_scanline(y), ctx.m_pA->get_scanline(y), ctx.m_pB->get_scanline(y), ctx.m_pA->get_width(), ctx.m_scale);
+        }
+
+        bool compute_delta(image_u8 &dest, const image_u8 &a, const image_u8 &b, uint scale)
+        {
+            if ((a.get_width() != b.get_width()) || (a.get_height() != b.get_height()))
+                return false;
+
+            dest.crop(a.get_width(), b.get_height());
+
+            compute_delta_context ctx;
+            ctx.m_pDest = &dest;
+            ctx.m_pA = &a;
+            ctx.m_pB = &b;
+            ctx.m_scale = scale;
+
+            process_rows(a.get_width(), a.get_height(), 1, compute_delta_rows, &ctx);
 
             return true;
         }
@@ -969,15 +1103,30 @@ namespace vogl
             return n / d;
         }
 
-        double compute_ssim(const image_u8 &a, const image_u8 &b, int channel_index)
+        struct compute_ssim_context
+        {
+            const image_u8 *m_pA;
+            const image_u8 *m_pB;
+            int m_channel_index;
+            uint m_num_blocks_x;
+            double *m_pBlock_ssim;
+        };
+
+        static const uint cSSIMBlockSize = 8;
+
+        static void compute_ssim_rows(uint first_row, uint end_row, void *pContext)
         {
-            const uint N = 8;
+            const compute_ssim_context &ctx = *static_cast<const compute_ssim_context *>(pContext);
+            const image_u8 &a = *ctx.m_pA;
+            const image_u8 &b = *ctx.m_pB;
+            const int channel_index = ctx.m_channel_index;
+
+            const uint N = cSSIMBlockSize;
             uint8 sx[N * N], sy[N * N];
 
-            double total_ssim = 0.0f;
-            uint total_blocks = 0;
+            VOGL_ASSERT((first_row % N) == 0);
 
-            for (uint y = 0; y < a.get_height(); y += N)
+            for (uint y = first_row; y < end_row; y += N)
             {
                 for (uint x = 0; x < a.get_width(); x += N)
                 {
@@ -997,19 +1146,37 @@ namespace vogl
                         }
                     }
 
-                    double ssim = compute_block_ssim(N * N, sx, sy);
-                    total_ssim += ssim;
-                    total_blocks++;
-
-                    //uint ssim_c = (uint)math::clamp<double>(ssim * 127.0f + 128.0f, 0, 255);
-                    //yimg(x / N, y / N).set(ssim_c, ssim_c, ssim_c, 255);
+                    ctx.m_pBlock_ssim[(y / N) * ctx.m_num_blocks_x + (x / N)] = compute_block_ssim(N * N, sx, sy);
                 }
             }
+        }
+
+        double compute_ssim(const image_u8 &a, const image_u8 &b, int channel_index)
+        {
+            const uint N = cSSIMBlockSize;
+
+            const uint num_blocks_x = (a.get_width() + N - 1) / N;
+            const uint num_blocks_y = (a.get_height() + N - 1) / N;
+            const uint total_blocks = num_blocks_x * num_blocks_y;
 
             if (!total_blocks)
                 return 0.0f;
 
-            //save_to_file_stb_or_miniz("ssim.tga", yimg, cWriteFlagGrayscale);
+            // The per-block results are summed afterwards in raster order, so the result doesn't depend on how the rows were split up.
+            vogl::vector<double> block_ssim(total_blocks);
+
+            compute_ssim_context ctx;
+            ctx.m_pA = &a;
+            ctx.m_pB = &b;
+            ctx.m_channel_index = channel_index;
+            ctx.m_num_blocks_x = num_blocks_x;
+            ctx.m_pBlock_ssim = block_ssim.get_ptr();
+
+            process_rows(a.get_width(), a.get_height(), N, compute_ssim_rows, &ctx);
+
+            double total_ssim = 0.0f;
+            for (uint i = 0; i < total_blocks; i++)
+                total_ssim += block_ssim[i];
 
             return total_ssim / total_blocks;
         }
@@ -1037,6 +1204,88 @@ namespace vogl
                 console::printf("%s Error: Max: %3u, Mean: %3.3f, MSE: %3.3f, RMSE: %3.3f, PSNR: %3.3f, SSIM: %1.6f", pName, mMax, mMean, mMeanSquared, mRootMeanSquared, mPeakSNR, mSSIM);
         }
 
+        struct error_histogram_context
+        {
+            const image_u8 *m_pA;
+            const image_u8 *m_pB;
+            uint m_width;
+            uint m_first_channel;
+            uint m_num_channels;
+            uint64_t *m_pHist_bands;
+        };
+
+        static const uint cErrorHistogramRowsPerBand = 16;
+
+        static void error_histogram_row(uint64_t *pHist, const color_quad_u8 *pA, const color_quad_u8 *pB, uint n, uint first_channel, uint num_channels)
+        {
+            uint i = 0;
+
+#if VOGL_IMAGE_UTILS_SSE2
+            VOGL_ALIGNED_BEGIN(16) uint32 diffs[4] VOGL_ALIGNED_END(16);
+
+            if (!num_channels)
+            {
+                for (; (i + 4) <= n; i += 4)
+                {
+                    const __m128i la = luma_sse2(load_pixels_sse2(pA + i));
+                    const __m128i lb = luma_sse2(load_pixels_sse2(pB + i));
+
+                    // Lumas are 0-255, so a saturating byte difference each way gives the absolute difference.
+                    _mm_store_si128(reinterpret_cast<__m128i *>(diffs), _mm_or_si128(_mm_subs_epu8(la, lb), _mm_subs_epu8(lb, la)));
+
+                    pHist[diffs[0]]++;
+                    pHist[diffs[1]]++;
+                    pHist[diffs[2]]++;
+                    pHist[diffs[3]]++;
+                }
+            }
+            else
+            {
+                const uint shift = first_channel * 8;
+
+                for (; (i + 4) <= n; i += 4)
+                {
+                    const __m128i a = load_pixels_sse2(pA + i);
+                    const __m128i b = load_pixels_sse2(pB + i);
+
+                    _mm_store_si128(reinterpret_cast<__m128i *>(diffs), _mm_or_si128(_mm_subs_epu8(a, b), _mm_subs_epu8(b, a)));
+
+                    for (uint j = 0; j < 4; j++)
+                    {
+                        const uint d = diffs[j] >> shift;
+                        for (uint c = 0; c < num_channels; c++)
+                            pHist[(d >> (c * 8)) & 0xFF]++;
+                    }
+                }
+            }
+#endif
+
+            for (; i < n; i++)
+            {
+                const color_quad_u8 &ca = pA[i];
+                const color_quad_u8 &cb = pB[i];
+
+                if (!num_channels)
+                    pHist[labs(ca.get_luma() - cb.get_luma())]++;
+                else
+                {
+                    for (uint c = 0; c < num_channels; c++)
+                        pHist[labs(ca[first_channel + c] - cb[first_channel + c])]++;
+                }
+            }
+        }
+
+        static void error_histogram_rows(uint first_row, uint end_row, void *pContext)
+        {
+            const error_histogram_context &ctx = *static_cast<const error_histogram_context *>(pContext);
+
+            for (uint y = first_row; y < end_row; y++)
+            {
+                uint64_t *pHist = ctx.m_pHist_bands + (y / cErrorHistogramRowsPerBand) * 256;
+                error_histogram_row(pHist, ctx.m_pA->get_scanline(y), ctx.m_pB->get_scanline(y), ctx.m_width, ctx.m_first_channel, ctx.m_num_channels);
+            }
+        }
+
         bool error_metrics::compute(const image_u8 &a, const image_u8 &b, uint first_channel, uint num_channels, bool average_component_error)
         {
             //if ( (!a.get_width()) || (!b.get_height()) || (a.get_width() != b.get_width()) || (a.get_height() != b.get_height()) )
@@ -1048,25 +1297,27 @@ namespace vogl
             VOGL_ASSERT((first_channel < 4U) && (first_channel + num_channels <= 4U));
 
             // Histogram approach due to Charles Bloom.
+            error_histogram_context ctx;
+            ctx.m_pA = &a;
+            ctx.m_pB = &b;
+            ctx.m_width = width;
+            ctx.m_first_channel = first_channel;
+            ctx.m_num_channels = num_channels;
+            ctx.m_pHist_bands = NULL;
+
+            // One histogram per band of cErrorHistogramRowsPerBand rows, merged afterwards.
+            const uint num_bands = (height + cErrorHistogramRowsPerBand - 1) / cErrorHistogramRowsPerBand;
+            vogl::vector<uint64_t> hist_bands(num_bands * 256);
+            ctx.m_pHist_bands = hist_bands.get_ptr();
+
+            process_rows(width, height, cErrorHistogramRowsPerBand, error_histogram_rows, &ctx);
+
             double hist[256];
             utils::zero_object(hist);
 
-            for (uint y = 0; y < height; y++)
-            {
-                for (uint x = 0; x < width; x++)
-                {
-                    const color_quad_u8 &ca = a(x, y);
-                    const color_quad_u8 &cb = b(x, y);
-
-                    if (!num_channels)
-                        hist[labs(ca.get_luma() - cb.get_luma())]++;
-                    else
-                    {
-                        for (uint c = 0; c < num_channels; c++)
-                            hist[labs(ca[first_channel + c] - cb[first_channel + c])]++;
-                    }
-                }
-            }
+            for (uint band = 0; band < num_bands; band++)
+                for (uint i = 0; i < 256; i++)
+                    hist[i] += static_cast<double>(hist_bands[band * 256 + i]);
 
             mMax = 0;
             double sum = 0.0f, sum2 = 0.0f;
@@ -1160,6 +1411,231 @@ namespace vogl
             return static_cast<uint8>(math::clamp(ib, 0, 255));
         }
 
+        static inline color_quad_u8 convert_pixel(const color_quad_u8 &src, image_utils::conversion_type conv_type)
+        {
+            color_quad_u8 dst;
+
+            switch (conv_type)
+            {
+                case image_utils::cConversion_To_CCxY:
+                {
+                    color::RGB_to_YCC(dst, src);
+                    break;
+                }
+                case image_utils::cConversion_From_CCxY:
+                {
+                    color::YCC_to_RGB(dst, src);
+                    break;
+                }
+                case image_utils::cConversion_To_xGxR:
+                {
+                    dst.r = 0;
+                    dst.g = src.g;
+                    dst.b = 0;
+                    dst.a = src.r;
+                    break;
+                }
+                case image_utils::cConversion_From_xGxR:
+                {
+                    dst.r = src.a;
+                    dst.g = src.g;
+                    // This is kinda iffy, we're assuming the image is a normal map here.
+                    dst.b = regen_z(src.a, src.g);
+                    dst.a = 255;
+                    break;
+                }
+                case image_utils::cConversion_To_xGBR:
+                {
+                    dst.r = 0;
+                    dst.g = src.g;
+                    dst.b = src.b;
+                    dst.a = src.r;
+                    break;
+                }
+                case image_utils::cConversion_To_AGBR:
+                {
+                    dst.r = src.a;
+                    dst.g = src.g;
+                    dst.b = src.b;
+                    dst.a = src.r;
+                    break;
+                }
+                case image_utils::cConversion_From_xGBR:
+                {
+                    dst.r = src.a;
+                    dst.g = src.g;
+                    dst.b = src.b;
+                    dst.a = 255;
+                    break;
+                }
+                case image_utils::cConversion_From_AGBR:
+                {
+                    dst.r = src.a;
+                    dst.g = src.g;
+                    dst.b = src.b;
+                    dst.a = src.r;
+                    break;
+                }
+                case image_utils::cConversion_XY_to_XYZ:
+                {
+                    dst.r = src.r;
+                    dst.g = src.g;
+                    // This is kinda iffy, we're assuming the image is a normal map here.
+                    dst.b = regen_z(src.r, src.g);
+                    dst.a = 255;
+                    break;
+                }
+                case image_utils::cConversion_Y_To_A:
+                {
+                    dst.r = src.r;
+                    dst.g = src.g;
+                    dst.b = src.b;
+                    dst.a = static_cast<uint8>(src.get_luma());
+                    break;
+                }
+                case image_utils::cConversion_Y_To_RGB:
+                {
+                    uint8 y2 = static_cast<uint8>(src.get_luma());
+                    dst.r = y2;
+                    dst.g = y2;
+                    dst.b = y2;
+                    dst.a = src.a;
+                    break;
+                }
+                case image_utils::cConversion_A_To_RGBA:
+                {
+                    dst.r = src.a;
+                    dst.g = src.a;
+                    dst.b = src.a;
+                    dst.a = src.a;
+                    break;
+                }
+                case image_utils::cConversion_To_Y:
+                {
+                    uint8 y2 = static_cast<uint8>(src.get_luma());
+                    dst.r = y2;
+                    dst.g = y2;
+                    dst.b = y2;
+                    dst.a = src.a;
+                    break;
+                }
+                default:
+                {
+                    VOGL_ASSERT(false);
+                    dst = src;
+                    break;
+                }
+            }
+
+            return dst;
+        }
+
+        // Converts n pixels in place. The pure swizzles and the luma conversions have SSE2 versions, the rest go through convert_pixel().
+        static void convert_row(color_quad_u8 *pPixels, uint n, image_utils::conversion_type conv_type)
+        {
+            uint i = 0;
+
+#if VOGL_IMAGE_UTILS_SSE2
+            // Pixels are RGBA in memory, so R is the low byte of each 32-bit lane.
+            const __m128i mask_g = _mm_set1_epi32(0x0000FF00);
+            const __m128i mask_gb = _mm_set1_epi32(0x00FFFF00);
+            const __m128i mask_rgb = _mm_set1_epi32(0x00FFFFFF);
+            const __m128i mask_a = _mm_set1_epi32(0xFF000000);
+
+            switch (conv_type)
+            {
+                case image_utils::cConversion_To_xGxR:
+                {
+                    for (; (i + 4) <= n; i += 4)
+                    {
+                        const __m128i p = load_pixels_sse2(pPixels + i);
+                        store_pixels_sse2(pPixels + i, _mm_or_si128(_mm_and_si128(p, mask_g), _mm_slli_epi32(p, 24)));
+                    }
+                    break;
+                }
+                case image_utils::cConversion_To_xGBR:
+                {
+                    for (; (i + 4) <= n; i += 4)
+                    {
+                        const __m128i p = load_pixels_sse2(pPixels + i);
+                        store_pixels_sse2(pPixels + i, _mm_or_si128(_mm_and_si128(p, mask_gb), _mm_slli_epi32(p, 24)));
+                    }
+                    break;
+                }
+                case image_utils::cConversion_To_AGBR:
+                case image_utils::cConversion_From_AGBR:
+                {
+                    for (; (i + 4) <= n; i += 4)
+                    {
+                        const __m128i p = load_pixels_sse2(pPixels + i);
+                        store_pixels_sse2(pPixels + i, _mm_or_si128(_mm_and_si128(p, mask_gb), _mm_or_si128(_mm_slli_epi32(p, 24), _mm_srli_epi32(p, 24))));
+                    }
+                    break;
+                }
+                case image_utils::cConversion_From_xGBR:
+                {
+                    for (; (i + 4) <= n; i += 4)
+                    {
+                        const __m128i p = load_pixels_sse2(pPixels + i);
+                        store_pixels_sse2(pPixels + i, _mm_or_si128(_mm_or_si128(_mm_and_si128(p, mask_gb), _mm_srli_epi32(p, 24)), mask_a));
+                    }
+                    break;
+                }
+                case image_utils::cConversion_A_To_RGBA:
+                {
+                    for (; (i + 4) <= n; i += 4)
+                    {
+                        __m128i a = _mm_srli_epi32(load_pixels_sse2(pPixels + i), 24);
+                        a = _mm_or_si128(a, _mm_slli_epi32(a, 8));
+                        store_pixels_sse2(pPixels + i, _mm_or_si128(a, _mm_slli_epi32(a, 16)));
+                    }
+                    break;
+                }
+                case image_utils::cConversion_Y_To_A:
+                {
+                    for (; (i + 4) <= n; i += 4)
+                    {
+                        const __m128i p = load_pixels_sse2(pPixels + i);
+                        store_pixels_sse2(pPixels + i, _mm_or_si128(_mm_and_si128(p, mask_rgb), _mm_slli_epi32(luma_sse2(p), 24)));
+                    }
+                    break;
+                }
+                case image_utils::cConversion_Y_To_RGB:
+                case image_utils::cConversion_To_Y:
+                {
+                    for (; (i + 4) <= n; i += 4)
+                    {
+                        const __m128i p = load_pixels_sse2(pPixels + i);
+                        __m128i l = luma_sse2(p);
+                        l = _mm_or_si128(l, _mm_slli_epi32(l, 8));
+                        l = _mm_or_si128(l, _mm_slli_epi32(l, 8));
+                        store_pixels_sse2(pPixels + i, _mm_or_si128(_mm_and_si128(p, mask_a), l));
+                    }
+                    break;
+                }
+                default:
+                    break;
+            }
+#endif
+
+            for (; i < n; i++)
+                pPixels[i] = convert_pixel(pPixels[i], conv_type);
+        }
+
+        struct convert_image_context
+        {
+            image_u8 *m_pImg;
+            image_utils::conversion_type m_conv_type;
+        };
+
+        static void convert_image_rows(uint first_row, uint end_row, void *pContext)
+        {
+            const convert_image_context &ctx = *static_cast<const convert_image_context *>(pContext);
+
+            for (uint y = first_row; y < end_row; y++)
+                convert_row(ctx.m_pImg->get_scanline(y), ctx.m_pImg->get_width(), ctx.m_conv_type);
+        }
+
         void convert_image(image_u8 &img, image_utils::conversion_type conv_type)
         {
             switch (conv_type)
@@ -1236,128 +1712,11 @@ namespace vogl
                 }
             }
 
-            for (uint y = 0; y < img.get_height(); y++)
-            {
-                for (uint x = 0; x < img.get_width(); x++)
-                {
-                    color_quad_u8 src(img(x, y));
-                    color_quad_u8 dst;
-
-                    switch (conv_type)
-                    {
-                        case image_utils::cConversion_To_CCxY:
-                        {
-                            color::RGB_to_YCC(dst, src);
-                            break;
-                        }
-                        case image_utils::cConversion_From_CCxY:
-                        {
-                            color::YCC_to_RGB(dst, src);
-                            break;
-                        }
-                        case image_utils::cConversion_To_xGxR:
-                        {
-                            dst.r = 0;
-                            dst.g = src.g;
-                            dst.b = 0;
-                            dst.a = src.r;
-                            break;
-                        }
-                        case image_utils::cConversion_From_xGxR:
-                        {
-                            dst.r = src.a;
-                            dst.g = src.g;
-                            // This is kinda iffy, we're assuming the image is a normal map here.
-                            dst.b = regen_z(src.a, src.g);
-                            dst.a = 255;
-                            break;
-                        }
-                        case image_utils::cConversion_To_xGBR:
-                        {
-                            dst.r = 0;
-                            dst.g = src.g;
-                            dst.b = src.b;
-                            dst.a = src.r;
-                            break;
-                        }
-                        case image_utils::cConversion_To_AGBR:
-                        {
-                            dst.r = src.a;
-                            dst.g = src.g;
-                            dst.b = src.b;
-                            dst.a = src.r;
-                            break;
-                        }
-                        case image_utils::cConversion_From_xGBR:
-                        {
-                            dst.r = src.a;
-                            dst.g = src.g;
-                            dst.b = src.b;
-                            dst.a = 255;
-                            break;
-                        }
-                        case image_utils::cConversion_From_AGBR:
-                        {
-                            dst.r = src.a;
-                            dst.g = src.g;
-                            dst.b = src.b;
-                            dst.a = src.r;
-                            break;
-                        }
-                        case image_utils::cConversion_XY_to_XYZ:
-                        {
-                            dst.r = src.r;
-                            dst.g = src.g;
-                            // This is kinda iffy, we're assuming the image is a normal map here.
-                            dst.b = regen_z(src.r, src.g);
-                            dst.a = 255;
-                            break;
-                        }
-                        case image_utils::cConversion_Y_To_A:
-                        {
-                            dst.r = src.r;
-                            dst.g = src.g;
-                            dst.b = src.b;
-                            dst.a = static_cast<uint8>(src.get_luma());
-                            break;
-                        }
-                        case image_utils::cConversion_Y_To_RGB:
-                        {
-                            uint8 y2 = static_cast<uint8>(src.get_luma());
-                            dst.r = y2;
-                            dst.g = y2;
-                            dst.b = y2;
-                            dst.a = src.a;
-                            break;
-                        }
-                        case image_utils::cConversion_A_To_RGBA:
-                        {
-                            dst.r = src.a;
-                            dst.g = src.a;
-                            dst.b = src.a;
-                            dst.a = src.a;
-                            break;
-                        }
-                        case image_utils::cConversion_To_Y:
-                        {
-                            uint8 y2 = static_cast<uint8>(src.get_luma());
-                            dst.r = y2;
-                            dst.g = y2;
-                            dst.b = y2;
-                            dst.a = src.a;
-                            break;
-                        }
-                        default:
-                        {
-                            VOGL_ASSERT(false);
-                            dst = src;
-                            break;
-                        }
-                    }
+            convert_image_context ctx;
+            ctx.m_pImg = &img;
+            ctx.m_conv_type = conv_type;
 
-                    img(x, y) = dst;
-                }
-            }
+            process_rows(img.get_width(), img.get_height(), 1, convert_image_rows, &ctx);
         }
 
         image_utils::conversion_type get_conversion_type(bool cooking, pixel_format fmt)
@@ -1827,53 +2186,107 @@ namespace vogl
             }
         }
 
-        void convolution_filter(image_u8 &dst, const image_u8 &src, const float *pWeights, uint M, uint N, bool wrapping)
+        struct convolution_filter_context
         {
-            if (((M & 1) == 0) || ((N & 1) == 0))
-            {
-                VOGL_ASSERT_ALWAYS;
-                return;
-            }
+            image_u8 *m_pDst;
+            const image_u8 *m_pSrc;
+            const float *m_pWeights;
+            uint m_M;
+            uint m_N;
+            bool m_wrapping;
+        };
+
+        static void convolution_filter_rows(uint first_row, uint end_row, void *pContext)
+        {
+            const convolution_filter_context &ctx = *static_cast<const convolution_filter_context *>(pContext);
+            const image_u8 &src = *ctx.m_pSrc;
+            image_u8 &dst = *ctx.m_pDst;
+            const float *pWeights = ctx.m_pWeights;
+            const bool wrapping = ctx.m_wrapping;
 
             const int width = src.get_width();
             const int height = src.get_height();
 
-            dst.crop(width, height);
-
-            const int HM = M / 2;
-            const int HN = N / 2;
-
-            VOGL_ASSERT((HM * 2 + 1) == static_cast<int>(M));
-            VOGL_ASSERT((HN * 2 + 1) == static_cast<int>(N));
+            const int N = ctx.m_N;
+            const int HM = ctx.m_M / 2;
+            const int HN = ctx.m_N / 2;
 
-            for (int dst_y = 0; dst_y < height; dst_y++)
+            for (int dst_y = first_row; dst_y < static_cast<int>(end_row); dst_y++)
             {
                 for (int dst_x = 0; dst_x < width; dst_x++)
                 {
+#if VOGL_IMAGE_UTILS_SSE2
+                    // Same per-component multiply/add sequence as the scalar path below, 4 components at a time.
+                    const __m128i zero = _mm_setzero_si128();
+                    __m128 c = _mm_setzero_ps();
+#else
                     vec4F c(0.0f);
+#endif
 
                     for (int yd = -HM; yd <= HM; yd++)
                     {
                         int src_y = wrapping ? math::posmod(dst_y + yd, height) : math::clamp<int>(dst_y + yd, 0, height - 1);
+                        const color_quad_u8 *pSrc_row = src.get_scanline(src_y);
 
                         for (int xd = -HN; xd <= HN; xd++)
                         {
                             int src_x = wrapping ? math::posmod(dst_x + xd, width) : math::clamp<int>(dst_x + xd, 0, width - 1);
                             float w = pWeights[(yd + HM) * N + (xd + HN)];
 
-                            const color_quad_u8 &src_c = src(src_x, src_y);
+                            const color_quad_u8 &src_c = pSrc_row[src_x];
+#if VOGL_IMAGE_UTILS_SSE2
+                            __m128i p = _mm_cvtsi32_si128(static_cast<int>(src_c.get_uint32()));
+                            p = _mm_unpacklo_epi16(_mm_unpacklo_epi8(p, zero), zero);
+                            c = _mm_add_ps(c, _mm_mul_ps(_mm_cvtepi32_ps(p), _mm_set1_ps(w)));
+#else
                             c[0] += src_c[0] * w;
                             c[1] += src_c[1] * w;
                             c[2] += src_c[2] * w;
                             c[3] += src_c[3] * w;
+#endif
                         }
                     }
 
+#if VOGL_IMAGE_UTILS_SSE2
+                    // Truncating convert then saturating packs, same as the int conversion and clamp done by set().
+                    __m128i r = _mm_cvttps_epi32(_mm_add_ps(c, _mm_set1_ps(.5f)));
+                    r = _mm_packus_epi16(_mm_packs_epi32(r, zero), zero);
+                    const uint32 packed = static_cast<uint32>(_mm_cvtsi128_si32(r));
+                    memcpy(static_cast<void *>(&dst(dst_x, dst_y)), &packed, sizeof(packed));
+#else
                     dst(dst_x, dst_y).set(static_cast<int>(c[0] + .5f), static_cast<int>(c[1] + .5f), static_cast<int>(c[2] + .5f), static_cast<int>(c[3] + .5f));
+#endif
                 }
             }
         }
 
+        void convolution_filter(image_u8 &dst, const image_u8 &src, const float *pWeights, uint M, uint N, bool wrapping)
+        {
+            if (((M & 1) == 0) || ((N & 1) == 0))
+            {
+                VOGL_ASSERT_ALWAYS;
+                return;
+            }
+
+            const int width = src.get_width();
+            const int height = src.get_height();
+
+            dst.crop(width, height);
+
+            VOGL_ASSERT(((M / 2) * 2 + 1) == M);
+            VOGL_ASSERT(((N / 2) * 2 + 1) == N);
+
+            convolution_filter_context ctx;
+            ctx.m_pDst = &dst;
+            ctx.m_pSrc = &src;
+            ctx.m_pWeights = pWeights;
+            ctx.m_M = M;
+            ctx.m_N = N;
+            ctx.m_wrapping = wrapping;
+
+            process_rows(width, height, 1, convolution_filter_rows, &ctx);
+        }
+
         void convolution_filter(image_f &dst, const image_f &src, const float *pWeights, uint M, uint N, bool wrapping)
         {
             if (((M & 1) == 0) || ((N & 1) == 0))
@@ -1923,4 +2336,335 @@ namespace vogl
 
     } // namespace image_utils
 
+    // Checks the SIMD/row-parallel image_utils paths against straightforward per-pixel versions, which must match exactly.
+    static void image_utils_test_fill(image_u8 &img, random &r, uint width, uint height)
+    {
+        img.resize(width, height);
+        for (uint y = 0; y < height; y++)
+            for (uint x = 0; x < width; x++)
+                img(x, y).set_noclamp_rgba(r.urand32() & 0xFF, r.urand32() & 0xFF, r.urand32() & 0xFF, r.urand32() & 0xFF);
+    }
+
+    // Reference conversion, written independently of convert_pixel(): each channel of the result is either a source channel, a constant, or the luma.
+    enum
+    {
+        cRef0 = 4,
+        cRef255,
+        cRefLuma,
+        cRefRegenZ_AG,
+        cRefRegenZ_RG
+    };
+
+    static color_quad_u8 image_utils_test_convert_pixel(const color_quad_u8 &src, image_utils::conversion_type conv_type)
+    {
+        static const uint8 s_swizzles[image_utils::cConversionTotal][4] =
+            {
+                { 0, 0, 0, 0 },                           // cConversion_To_CCxY
+                { 0, 0, 0, 0 },                           // cConversion_From_CCxY
+                { cRef0, 1, cRef0, 0 },                   // cConversion_To_xGxR
+                { 3, 1, cRefRegenZ_AG, cRef255 },         // cConversion_From_xGxR
+                { cRef0, 1, 2, 0 },                       // cConversion_To_xGBR
+                { 3, 1, 2, cRef255 },                     // cConversion_From_xGBR
+                { 3, 1, 2, 0 },                           // cConversion_To_AGBR
+                { 3, 1, 2, 0 },                           // cConversion_From_AGBR
+                { 0, 1, cRefRegenZ_RG, cRef255 },         // cConversion_XY_to_XYZ
+                { 0, 1, 2, cRefLuma },                    // cConversion_Y_To_A
+                { 3, 3, 3, 3 },                           // cConversion_A_To_RGBA
+                { cRefLuma, cRefLuma, cRefLuma, 3 },      // cConversion_Y_To_RGB
+                { cRefLuma, cRefLuma, cRefLuma, 3 }       // cConversion_To_Y
+            };
+
+        color_quad_u8 dst;
+        if (conv_type == image_utils::cConversion_To_CCxY)
+            color::RGB_to_YCC(dst, src);
+        else if (conv_type == image_utils::cConversion_From_CCxY)
+            color::YCC_to_RGB(dst, src);
+        else
+        {
+            for (uint c = 0; c < 4; c++)
+            {
+                uint v;
+                switch (s_swizzles[conv_type][c])
+                {
+                    case cRef0:
+                        v = 0;
+                        break;
+                    case cRef255:
+                        v = 255;
+                        break;
+                    case cRefLuma:
+                        v = (19595U * src.r + 38470U * src.g + 7471U * src.b + 32768U) >> 16U;
+                        break;
+                    case cRefRegenZ_AG:
+                        v = image_utils::regen_z(src.a, src.g);
+                        break;
+                    case cRefRegenZ_RG:
+                        v = image_utils::regen_z(src.r, src.g);
+                        break;
+                    default:
+                        v = src[s_swizzles[conv_type][c]];
+                        break;
+                }
+                dst[c] = static_cast<uint8>(v);
+            }
+        }
+        return dst;
+    }
+
+    static bool image_utils_test_equal(const image_u8 &a, const image_u8 &b)
+    {
+        if ((a.get_width() != b.get_width()) || (a.get_height() != b.get_height()))
+            return false;
+
+        for (uint y = 0; y < a.get_height(); y++)
+            if (memcmp(a.get_scanline(y), b.get_scanline(y), a.get_width() * sizeof(color_quad_u8)) != 0)
+                return false;
+
+        return true;
+    }
+
+    bool image_utils_test()
+    {
+#define CHECK(x)                \
+    do                          \
+    {                           \
+        if (!(x))               \
+        {                       \
+            VOGL_ASSERT_ALWAYS; \
+            return false;       \
+        }                       \
+    } while (0)
+
+        // Make sure g_number_of_processors is set, so the row-parallel paths actually get used.
+        if (g_number_of_processors <= 1)
+            vogl_threading_init();
+
+        // A few hand-computed conversions, so the reference below can't share a mistake with the code under test.
+        {
+            image_u8 img(5, 1);
+            for (uint x = 0; x < 5; x++)
+                img(x, 0).set_noclamp_rgba(10, 200, 30, 250);
+
+            static const struct
+            {
+                image_utils::conversion_type m_type;
+                uint8 m_expected[4];
+            } s_expected[] =
+                  {
+                      { image_utils::cConversion_To_xGxR, { 0, 200, 0, 10 } },
+                      { image_utils::cConversion_To_xGBR, { 0, 200, 30, 10 } },
+                      { image_utils::cConversion_From_xGBR, { 250, 200, 30, 255 } },
+                      { image_utils::cConversion_To_AGBR, { 250, 200, 30, 10 } },
+                      { image_utils::cConversion_From_AGBR, { 250, 200, 30, 10 } },
+                      { image_utils::cConversion_Y_To_A, { 10, 200, 30, 124 } },
+                      { image_utils::cConversion_A_To_RGBA, { 250, 250, 250, 250 } },
+                      { image_utils::cConversion_Y_To_RGB, { 124, 124, 124, 250 } },
+                      { image_utils::cConversion_To_Y, { 124, 124, 124, 250 } }
+                  };
+
+            for (uint i = 0; i < VOGL_ARRAY_SIZE(s_expected); i++)
+            {
+                image_u8 converted(img);
+                image_utils::convert_image(converted, s_expected[i].m_type);
+                const color_quad_u8 expected(s_expected[i].m_expected[0], s_expected[i].m_expected[1], s_expected[i].m_expected[2], s_expected[i].m_expected[3]);
+                for (uint x = 0; x < 5; x++)
+                    CHECK(converted(x, 0) == expected);
+            }
+        }
+
+        random r;
+        r.seed(1000);
+
+        // The last size is large enough to go through the thread pool.
+        static const uint s_sizes[][2] = { { 1, 1 }, { 3, 1 }, { 4, 4 }, { 7, 5 }, { 17, 9 }, { 64, 33 }, { 513, 301 } };
+
+        for (uint size_index = 0; size_index < sizeof(s_sizes) / sizeof(s_sizes[0]); size_index++)
+        {
+            const uint width = s_sizes[size_index][0], height = s_sizes[size_index][1];
+
+            image_u8 a, b;
+            image_utils_test_fill(a, r, width, height);
+            image_utils_test_fill(b, r, width, height);
+
+            // Make some pixels close so the small differences show up in the histograms.
+            for (uint i = 0; i < width * height / 2; i++)
+            {
+                uint x = r.irand(0, width), y = r.irand(0, height);
+                b(x, y) = a(x, y);
+                b(x, y).g = static_cast<uint8>(math::clamp<int>(a(x, y).g + r.irand_inclusive(-3, 3), 0, 255));
+            }
+
+            // compute_delta, including scales which can't take the 16-bit path
+            static const uint s_scales[] = { 0, 1, 2, 7, 128, 129, 1000 };
+            for (uint scale_index = 0; scale_index < VOGL_ARRAY_SIZE(s_scales); scale_index++)
+            {
+                const uint scale = s_scales[scale_index];
+
+                image_u8 delta;
+                CHECK(image_utils::compute_delta(delta, a, b, scale));
+
+                for (uint y = 0; y < height; y++)
+                {
+                    for (uint x = 0; x < width; x++)
+                    {
+                        for (uint c = 0; c < 4; c++)
+                        {
+                            int d = math::clamp<int>((a(x, y)[c] - b(x, y)[c]) * static_cast<int>(scale) + 128, 0, 255);
+                            CHECK(delta(x, y)[c] == d);
+                        }
+                    }
+                }
+            }
+
+            // error metrics
+            for (uint first_channel = 0; first_channel < 4; first_channel++)
+            {
+                for (uint num_channels = 0; num_channels <= 4 - first_channel; num_channels++)
+                {
+                    image_utils::error_metrics em;
+                    CHECK(em.compute(a, b, first_channel, num_channels));
+
+                    double hist[256];
+                    utils::zero_object(hist);
+                    for (uint y = 0; y < height; y++)
+                    {
+                        for (uint x = 0; x < width; x++)
+                        {
+                            const color_quad_u8 &ca = a(x, y);
+                            const color_quad_u8 &cb = b(x, y);
+                            if (!num_channels)
+                                hist[labs(ca.get_luma() - cb.get_luma())]++;
+                            else
+                            {
+                                for (uint c = 0; c < num_channels; c++)
+                                    hist[labs(ca[first_channel + c] - cb[first_channel + c])]++;
+                            }
+                        }
+                    }
+
+                    uint max_err = 0;
+                    double sum = 0.0f, sum2 = 0.0f;
+                    for (uint i = 0; i < 256; i++)
+                    {
+                        if (!hist[i])
+                            continue;
+                        max_err = math::maximum(max_err, i);
+                        double x = i * hist[i];
+                        sum += x;
+                        sum2 += i * x;
+                    }
+
+                    const double total_values = static_cast<double>(width * height) * math::clamp<uint>(num_channels, 1, 4);
+                    CHECK(em.mMax == max_err);
+                    CHECK(em.mMean == math::clamp<double>(sum / total_values, 0.0f, 255.0f));
+                    CHECK(em.mMeanSquared == math::clamp<double>(sum2 / total_values, 0.0f, 255.0f * 255.0f));
+                }
+            }
+
+            // SSIM
+            for (int channel_index = -1; channel_index < 4; channel_index++)
+            {
+                const uint N = 8;
+                uint8 sx[N * N], sy[N * N];
+                double total_ssim = 0.0f;
+                uint total_blocks = 0;
+
+                for (uint y = 0; y < height; y += N)
+                {
+                    for (uint x = 0; x < width; x += N)
+                    {
+                        for (uint iy = 0; iy < N; iy++)
+                        {
+                            for (uint ix = 0; ix < N; ix++)
+                            {
+                                const color_quad_u8 &ca = a.get_clamped(x + ix, y + iy);
+                                const color_quad_u8 &cb = b.get_clamped(x + ix, y + iy);
+                                sx[ix + iy * N] = static_cast<uint8>((channel_index < 0) ? ca.get_luma() : ca[channel_index]);
+                                sy[ix + iy * N] = static_cast<uint8>((channel_index < 0) ? cb.get_luma() : cb[channel_index]);
+                            }
+                        }
+
+                        total_ssim += image_utils::compute_block_ssim(N * N, sx, sy);
+                        total_blocks++;
+                    }
+                }
+
+                CHECK(image_utils::compute_ssim(a, b, channel_index) == (total_ssim / total_blocks));
+            }
+
+            // conversions
+            for (uint conv_type = 0; conv_type < image_utils::cConversionTotal; conv_type++)
+            {
+                image_u8 converted(a);
+                image_utils::convert_image(converted, static_cast<image_utils::conversion_type>(conv_type));
+
+                for (uint y = 0; y < height; y++)
+                    for (uint x = 0; x < width; x++)
+                        CHECK(converted(x, y) == image_utils_test_convert_pixel(a(x, y), static_cast<image_utils::conversion_type>(conv_type)));
+            }
+
+            // convolution
+            {
+                static const float s_weights[5] = { 1.0f, 4.0f, 6.5f, 4.0f, 1.0f };
+                float weights[5][5];
+                for (uint y = 0; y < 5; y++)
+                    for (uint x = 0; x < 5; x++)
+                        weights[y][x] = s_weights[x] * s_weights[y] / (16.5f * 16.5f);
+
+                for (uint wrapping = 0; wrapping < 2; wrapping++)
+                {
+                    image_u8 filtered;
+                    image_utils::convolution_filter(filtered, a, &weights[0][0], 5, 5, wrapping != 0);
+
+                    for (int dst_y = 0; dst_y < static_cast<int>(height); dst_y++)
+                    {
+                        for (int dst_x = 0; dst_x < static_cast<int>(width); dst_x++)
+                        {
+                            vec4F c(0.0f);
+                            for (int yd = -2; yd <= 2; yd++)
+                            {
+                                int src_y = wrapping ? math::posmod(dst_y + yd, static_cast<int>(height)) : math::clamp<int>(dst_y + yd, 0, height - 1);
+                                for (int xd = -2; xd <= 2; xd++)
+                                {
+                                    int src_x = wrapping ? math::posmod(dst_x + xd, static_cast<int>(width)) : math::clamp<int>(dst_x + xd, 0, width - 1);
+                                    float w = weights[yd + 2][xd + 2];
+                                    const color_quad_u8 &src_c = a(src_x, src_y);
+                                    c[0] += src_c[0] * w;
+                                    c[1] += src_c[1] * w;
+                                    c[2] += src_c[2] * w;
+                                    c[3] += src_c[3] * w;
+                                }
+                            }
+
+                            color_quad_u8 expected;
+                            expected.set(static_cast<int>(c[0] + .5f), static_cast<int>(c[1] + .5f), static_cast<int>(c[2] + .5f), static_cast<int>(c[3] + .5f));
+                            CHECK(filtered(dst_x, dst_y) == expected);
+                        }
+                    }
+                }
+            }
+
+            // flips
+            {
+                image_u8 flipped(a);
+                flipped.flip_x();
+                for (uint y = 0; y < height; y++)
+                    for (uint x = 0; x < width; x++)
+                        CHECK(flipped(x, y) == a(width - 1 - x, y));
+                flipped.flip_x();
+                CHECK(image_utils_test_equal(flipped, a));
+
+                flipped.flip_y();
+                for (uint y = 0; y < height; y++)
+                    for (uint x = 0; x < width; x++)
+                        CHECK(flipped(x, y) == a(x, height - 1 - y));
+                flipped.flip_y();
+                CHECK(image_utils_test_equal(flipped, a));
+            }
+        }
+
+        return true;
+#undef CHECK
+    }
+
 } // namespace vogl
@@ -279,4 +279,6 @@ namespace vogl
 
     } // namespace image_utils
 
+    bool image_utils_test();
+
 } // namespace vogl
@@ -0,0 +1,119 @@
+/**************************************************************************
+ *
+ * Copyright 2013-2014 RAD Game Tools and Valve Software
+ * Copyright 2010-2014 Rich Geldreich and Tenacious Software LLC
+ * All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ **************************************************************************/
+
+// File: vogl_interval_set.cpp
+#include "vogl_core.h"
+#include "vogl_interval_set.h"
+#include "vogl_rand.h"
+
+namespace vogl
+{
+    // Checks interval_set against a brute force bitmap under random inserts and erases.
+    bool interval_set_test()
+    {
+#define CHECK(x)                \
+    do                          \
+    {                           \
+        if (!(x))               \
+        {                       \
+            VOGL_ASSERT_ALWAYS; \
+            return false;       \
+        }                       \
+    } while (0)
+
+        interval_set<int64_t> s;
+        s.insert(10, 20);
+        s.insert(20, 30);
+        CHECK((s.size() == 1) && (s[0] == interval_set<int64_t>::interval(10, 30)));
+        s.insert(40, 50);
+        s.insert(5, 45);
+        CHECK((s.size() == 1) && (s[0] == interval_set<int64_t>::interval(5, 50)));
+        s.erase(20, 25);
+        CHECK((s.size() == 2) && (s.get_total_size() == 40));
+        CHECK(s.contains(5, 20) && !s.contains(19, 21) && !s.intersects(20, 25) && s.intersects(24, 26));
+
+        random r;
+        r.seed(1000);
+
+        const uint cMaxValue = 256;
+        for (uint trial = 0; trial < 200; trial++)
+        {
+            s.clear();
+            bool bits[cMaxValue];
+            utils::zero_object(bits);
+
+            const uint num_ops = r.irand_inclusive(1, 64);
+            for (uint op = 0; op < num_ops; op++)
+            {
+                uint b = r.irand(0, cMaxValue);
+                uint e = math::minimum<uint>(cMaxValue, b + r.irand_inclusive(0, 48));
+                bool is_insert = r.irand(0, 3) != 0;
+
+                if (is_insert)
+                    s.insert(b, e);
+                else
+                    s.erase(b, e);
+
+                for (uint i = b; i < e; i++)
+                    bits[i] = is_insert;
+
+                // Intervals must be sorted, non-empty, and neither overlapping nor adjacent.
+                int64_t total = 0;
+                for (uint i = 0; i < s.size(); i++)
+                {
+                    CHECK(s[i].m_begin < s[i].m_end);
+                    if (i)
+                        CHECK(s[i - 1].m_end < s[i].m_begin);
+                    total += s[i].get_size();
+                }
+                CHECK(total == s.get_total_size());
+
+                int64_t expected_total = 0;
+                for (uint i = 0; i < cMaxValue; i++)
+                {
+                    CHECK(s.contains(i) == bits[i]);
+                    expected_total += bits[i];
+                }
+                CHECK(total == expected_total);
+
+                uint qb = r.irand(0, cMaxValue);
+                uint qe = math::minimum<uint>(cMaxValue, qb + r.irand_inclusive(1, 32));
+                bool all = true, any = false;
+                for (uint i = qb; i < qe; i++)
+                {
+                    all = all && bits[i];
+                    any = any || bits[i];
+                }
+                CHECK(s.contains(qb, qe) == all);
+                CHECK(s.intersects(qb, qe) == any);
+            }
+        }
+
+#undef CHECK
+        return true;
+    }
+
+} // namespace vogl
@@ -0,0 +1,245 @@
+/**************************************************************************
+ *
+ * Copyright 2013-2014 RAD Game Tools and Valve Software
+ * Copyright 2010-2014 Rich Geldreich and Tenacious Software LLC
+ * All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ **************************************************************************/
+
+// File: vogl_interval_set.h
+#pragma once
+
+#include "vogl_core.h"
+#include "vogl_vector.h"
+
+namespace vogl
+{
+    // Set of disjoint, half open [begin, end) intervals, kept sorted by begin.
+    // insert() coalesces overlapping and adjacent intervals, so every value is covered at most once. erase() splits intervals as needed.
+    // Backed by a sorted vector: lookups are binary searches and inserts/erases move at most the tail of the array, which is fine for the
+    // handful of ranges these sets typically hold.
+    template <typename T>
+    class interval_set
+    {
+    public:
+        struct interval
+        {
+            interval()
+            {
+            }
+
+            interval(T begin, T end)
+                : m_begin(begin), m_end(end)
+            {
+            }
+
+            inline T get_size() const
+            {
+                return m_end - m_begin;
+            }
+
+            inline bool operator==(const interval &rhs) const
+            {
+                return (m_begin == rhs.m_begin) && (m_end == rhs.m_end);
+            }
+
+            T m_begin;
+            T m_end;
+        };
+
+        typedef vogl::vector<interval> interval_vec;
+
+        interval_set()
+        {
+        }
+
+        inline void clear()
+        {
+            m_intervals.clear();
+        }
+
+        inline bool is_empty() const
+        {
+            return m_intervals.is_empty();
+        }
+
+        // Number of disjoint intervals (not the number of covered values, see get_total_size()).
+        inline uint size() const
+        {
+            return m_intervals.size();
+        }
+
+        inline const interval &operator[](uint index) const
+        {
+            return m_intervals[index];
+        }
+
+        inline const interval_vec &get_intervals() const
+        {
+            return m_intervals;
+        }
+
+        inline void swap(interval_set &other)
+        {
+            m_intervals.swap(other.m_intervals);
+        }
+
+        inline bool operator==(const interval_set &rhs) const
+        {
+            return m_intervals == rhs.m_intervals;
+        }
+
+        inline bool operator!=(const interval_set &rhs) const
+        {
+            return !(*this == rhs);
+        }
+
+        // Total number of values covered by the set.
+        T get_total_size() const
+        {
+            T total = 0;
+            for (uint i = 0; i < m_intervals.size(); i++)
+                total += m_intervals[i].get_size();
+            return total;
+        }
+
+        // Adds [begin, end), merging it with any intervals it overlaps or touches.
+        void insert(T begin, T end)
+        {
+            if (begin >= end)
+                return;
+
+            uint first = find_first_ending_at_or_after(begin);
+            uint last = first;
+
+            while ((last < m_intervals.size()) && (m_intervals[last].m_begin <= end))
+            {
+                begin = math::minimum(begin, m_intervals[last].m_begin);
+                end = math::maximum(end, m_intervals[last].m_end);
+                last++;
+            }
+
+            if (first == last)
+            {
+                m_intervals.insert(first, interval(begin, end));
+            }
+            else
+            {
+                m_intervals[first] = interval(begin, end);
+                if ((last - first) > 1)
+                    m_intervals.erase(first + 1, last - first - 1);
+            }
+        }
+
+        // Removes [begin, end) from the set, trimming or splitting the intervals it overlaps.
+        void erase(T begin, T end)
+        {
+            if (begin >= end)
+                return;
+
+            uint first = find_first_ending_after(begin);
+            uint last = first;
+            while ((last < m_intervals.size()) && (m_intervals[last].m_begin < end))
+                last++;
+
+            if (first == last)
+                return;
+
+            interval pieces[2];
+            uint num_pieces = 0;
+            if (m_intervals[first].m_begin < begin)
+                pieces[num_pieces++] = interval(m_intervals[first].m_begin, begin);
+            if (m_intervals[last - 1].m_end > end)
+                pieces[num_pieces++] = interval(end, m_intervals[last - 1].m_end);
+
+            m_intervals.erase(first, last - first);
+            if (num_pieces)
+                m_intervals.insert(first, pieces, num_pieces);
+        }
+
+        // true if every value in [begin, end) is in the set.
+        bool contains(T begin, T end) const
+        {
+            if (begin >= end)
+                return true;
+
+            uint index = find_first_ending_after(begin);
+            return (index < m_intervals.size()) && (m_intervals[index].m_begin <= begin) && (m_intervals[index].m_end >= end);
+        }
+
+        inline bool contains(T value) const
+        {
+            return contains(value, value + 1);
+        }
+
+        // true if any value in [begin, end) is in the set.
+        bool intersects(T begin, T end) const
+        {
+            if (begin >= end)
+                return false;
+
+            uint index = find_first_ending_after(begin);
+            return (index < m_intervals.size()) && (m_intervals[index].m_begin < end);
+        }
+
+    private:
+        interval_vec m_intervals;
+
+        // Index of the first interval whose end is > value, or size() if there is none.
+        uint find_first_ending_after(T value) const
+        {
+            uint lo = 0, hi = m_intervals.size();
+            while (lo < hi)
+            {
+                uint mid = lo + ((hi - lo) >> 1);
+                if (m_intervals[mid].m_end > value)
+                    hi = mid;
+                else
+                    lo = mid + 1;
+            }
+            return lo;
+        }
+
+        // Index of the first interval whose end is >= value (i.e. it overlaps or touches value), or size() if there is none.
+        uint find_first_ending_at_or_after(T value) const
+        {
+            uint lo = 0, hi = m_intervals.size();
+            while (lo < hi)
+            {
+                uint mid = lo + ((hi - lo) >> 1);
+                if (m_intervals[mid].m_end >= value)
+                    hi = mid;
+                else
+                    lo = mid + 1;
+            }
+            return lo;
+        }
+    };
+
+    template <typename T>
+    inline void swap(interval_set<T> &a, interval_set<T> &b)
+    {
+        a.swap(b);
+    }
+
+    bool interval_set_test();
+
+} // namespace vogl
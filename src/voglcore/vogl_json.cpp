@@ -353,8 +353,10 @@ namespace vogl
         if (nVal > static_cast<uint64_t>(cINT64_MAX))
         {
             // Encode as a hex string because otherwise some json parsers have a fit, and the UJB format doesn't directly support uint64_t.
-            char buf[32];
-            vogl_sprintf_s(buf, sizeof(buf), "0x%" PRIX64, nVal);
+            char buf[2 + cMaxNumberStringBufSize];
+            buf[0] = '0';
+            buf[1] = 'x';
+            uint64_to_hex_chars(nVal, buf + 2);
             set_value(buf);
         }
         else
@@ -636,39 +638,34 @@ namespace vogl
             }
             case cJSONValueTypeInt:
             {
-                val.format("%" PRIi64, m_data.m_nVal);
+                val.empty();
+                val.append_int64(m_data.m_nVal);
                 return true;
             }
             case cJSONValueTypeDouble:
             {
-                val.format("%1.18f", m_data.m_flVal);
+                char buf[cMaxNumberStringBufSize + 2];
+                uint len = double_to_chars(m_data.m_flVal, buf);
 
-                if ((!val.contains('E')) && (!val.contains('e')))
+                // Make sure the value still reads back as a double, not an int.
+                bool is_integral = true;
+                for (uint i = 0; i < len; i++)
                 {
-                    // Remove trailing 0's, except the first after the decimal point which is required for valid JSON.
-                    int dot_ofs = val.find_right('.');
-                    if (dot_ofs >= 0)
+                    if (!vogl_isdigit(buf[i]) && (buf[i] != '-'))
                     {
-                        int len = val.get_len();
-
-                        int i;
-                        for (i = dot_ofs + 1; i < len; i++)
-                        {
-                            char c = val[i];
-                            if (!vogl_isdigit(c))
-                                break;
-                        }
-                        if (i == len)
-                        {
-                            int cur_ofs = len - 1;
-                            while ((val[cur_ofs] == '0') && (cur_ofs > (dot_ofs + 1)))
-                            {
-                                val.set_len(cur_ofs);
-                                cur_ofs--;
-                            }
-                        }
+                        is_integral = false;
+                        break;
                     }
                 }
+
+                if (is_integral)
+                {
+                    buf[len++] = '.';
+                    buf[len++] = '0';
+                    buf[len] = '\0';
+                }
+
+                val.set_from_buf(buf, len);
                 return true;
             }
             case cJSONValueTypeString:
@@ -33,7 +33,7 @@
 #include "vogl_core.h"
 #include "vogl_strutils.h"
 #include "vogl_vec.h"
-#include "vogl_object_pool.h"
+#include "vogl_concurrent_pool.h"
 
 #define VOGL_TEXT_JSON_EXTENSION "json"
 #define VOGL_BINARY_JSON_EXTENSION "ubj"
@@ -93,7 +93,8 @@ namespace vogl
     };
 
     // Node pool
-    typedef object_pool<json_node, object_pool_spinlock_locking_policy> json_node_object_pool;
+    // Nodes are created/destroyed from any thread (snapshots, trace packets), so this is lock-free.
+    typedef concurrent_object_pool<json_node> json_node_object_pool;
     extern json_node_object_pool *g_pJSON_node_pool;
 
     void json_node_pool_init();
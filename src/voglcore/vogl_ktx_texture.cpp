@@ -29,6 +29,8 @@
 #include "vogl_ktx_texture.h"
 #include "vogl_console.h"
 #include "vogl_strutils.h"
+#include "vogl_dynamic_stream.h"
+#include "vogl_rand.h"
 
 // Set #if VOGL_KTX_PVRTEX_WORKAROUNDS to 1 to enable various workarounds for oddball KTX files written by PVRTexTool.
 #define VOGL_KTX_PVRTEX_WORKAROUNDS 1
@@ -379,7 +381,7 @@ namespace vogl
         return true;
     }
 
-    bool ktx_texture::read_from_stream(data_stream_serializer &serializer)
+    bool ktx_texture::read_header_from_stream(data_stream_serializer &serializer)
     {
         clear();
 
@@ -469,7 +471,6 @@ namespace vogl
             num_key_value_bytes_remaining -= padding;
         }
 
-        // Now read the mip levels
         uint total_faces = get_num_mips() * get_array_size() * get_num_faces() * get_depth();
         if ((!total_faces) || (total_faces > 65535))
             return false;
@@ -486,91 +487,76 @@ namespace vogl
         if ((!mip0_row_blocks) || (!mip0_col_blocks))
             return false;
 
-        const uint mip0_depth = VOGL_MAX(1, m_header.m_pixelDepth);
-        VOGL_NOTE_UNUSED(mip0_depth);
-
-        bool has_valid_image_size_fields = true;
-        bool disable_mip_and_cubemap_padding = false;
+        return true;
+    }
 
+    bool ktx_texture::is_missing_image_size_fields(uint64_t stream_bytes_remaining) const
+    {
 #if VOGL_KTX_PVRTEX_WORKAROUNDS
+        // PVRTexTool has a bogus KTX writer that doesn't write any imageSize fields. Nice.
+        uint64_t expected_bytes_remaining = 0;
+        for (uint mip_level = 0; mip_level < get_num_mips(); mip_level++)
         {
-            // PVRTexTool has a bogus KTX writer that doesn't write any imageSize fields. Nice.
-            size_t expected_bytes_remaining = 0;
-            for (uint mip_level = 0; mip_level < get_num_mips(); mip_level++)
-            {
-                uint mip_width, mip_height, mip_depth;
-                get_mip_dim(mip_level, mip_width, mip_height, mip_depth);
+            const uint slice_size = get_expected_image_size(mip_level);
 
-                const uint mip_row_blocks = (mip_width + m_block_dim - 1) / m_block_dim;
-                const uint mip_col_blocks = (mip_height + m_block_dim - 1) / m_block_dim;
-                if ((!mip_row_blocks) || (!mip_col_blocks))
-                    return false;
-
-                expected_bytes_remaining += sizeof(uint32);
+            expected_bytes_remaining += sizeof(uint32);
 
-                if ((!m_header.m_numberOfArrayElements) && (get_num_faces() == 6))
-                {
-                    for (uint face = 0; face < get_num_faces(); face++)
-                    {
-                        uint slice_size = mip_row_blocks * mip_col_blocks * m_bytes_per_block;
-                        expected_bytes_remaining += slice_size;
-
-                        uint num_cube_pad_bytes = 3 - ((slice_size + 3) % 4);
-                        expected_bytes_remaining += num_cube_pad_bytes;
-                    }
-                }
-                else
-                {
-                    uint total_mip_size = 0;
-                    for (uint array_element = 0; array_element < get_array_size(); array_element++)
-                    {
-                        for (uint face = 0; face < get_num_faces(); face++)
-                        {
-                            for (uint zslice = 0; zslice < mip_depth; zslice++)
-                            {
-                                uint slice_size = mip_row_blocks * mip_col_blocks * m_bytes_per_block;
-                                total_mip_size += slice_size;
-                            }
-                        }
-                    }
-                    expected_bytes_remaining += total_mip_size;
-
-                    uint num_mip_pad_bytes = 3 - ((total_mip_size + 3) % 4);
-                    expected_bytes_remaining += num_mip_pad_bytes;
-                }
+            if (is_plain_cubemap())
+            {
+                uint num_cube_pad_bytes = 3 - ((slice_size + 3) % 4);
+                expected_bytes_remaining += get_num_faces() * (slice_size + num_cube_pad_bytes);
             }
-
-            if (serializer.get_stream()->get_remaining() < expected_bytes_remaining)
+            else
             {
-                has_valid_image_size_fields = false;
-                disable_mip_and_cubemap_padding = true;
-                console::warning("ktx_texture::read_from_stream: KTX file size is smaller than expected - trying to read anyway without imageSize fields\n");
+                uint total_mip_size = slice_size * get_num_level_images(mip_level);
+                expected_bytes_remaining += total_mip_size;
+
+                uint num_mip_pad_bytes = 3 - ((total_mip_size + 3) % 4);
+                expected_bytes_remaining += num_mip_pad_bytes;
             }
         }
+
+        return stream_bytes_remaining < expected_bytes_remaining;
+#else
+        VOGL_NOTE_UNUSED(stream_bytes_remaining);
+        return false;
 #endif
+    }
+
+    bool ktx_texture::read_from_stream(data_stream_serializer &serializer)
+    {
+        if (!read_header_from_stream(serializer))
+        {
+            clear();
+            return false;
+        }
+
+        bool has_valid_image_size_fields = true;
+        bool disable_mip_and_cubemap_padding = false;
 
+        if (is_missing_image_size_fields(serializer.get_stream()->get_remaining()))
+        {
+            has_valid_image_size_fields = false;
+            disable_mip_and_cubemap_padding = true;
+            console::warning("ktx_texture::read_from_stream: KTX file size is smaller than expected - trying to read anyway without imageSize fields\n");
+        }
+
+        uint8 pad_bytes[3];
+
+        // Now read the mip levels
         for (uint mip_level = 0; mip_level < get_num_mips(); mip_level++)
         {
             uint mip_width, mip_height, mip_depth;
             get_mip_dim(mip_level, mip_width, mip_height, mip_depth);
 
-            const uint mip_row_blocks = (mip_width + m_block_dim - 1) / m_block_dim;
-            const uint mip_col_blocks = (mip_height + m_block_dim - 1) / m_block_dim;
-            if ((!mip_row_blocks) || (!mip_col_blocks))
+            const uint slice_size = get_expected_image_size(mip_level);
+            if (!slice_size)
                 return false;
 
             uint32 image_size = 0;
             if (!has_valid_image_size_fields)
             {
-                if ((!m_header.m_numberOfArrayElements) && (get_num_faces() == 6))
-                {
-                    // The KTX file format has an exception for plain cubemap textures, argh.
-                    image_size = mip_row_blocks * mip_col_blocks * m_bytes_per_block;
-                }
-                else
-                {
-                    image_size = mip_depth * mip_row_blocks * mip_col_blocks * m_bytes_per_block * get_array_size() * get_num_faces();
-                }
+                image_size = get_level_image_size_field(mip_level);
             }
             else
             {
@@ -587,7 +573,7 @@ namespace vogl
             uint total_mip_size = 0;
 
             // The KTX file format has an exception for plain cubemap textures, argh.
-            if ((!m_header.m_numberOfArrayElements) && (get_num_faces() == 6))
+            if (is_plain_cubemap())
             {
                 // plain non-array cubemap
                 for (uint face = 0; face < get_num_faces(); face++)
@@ -622,8 +608,7 @@ namespace vogl
                     {
                         for (uint zslice = 0; zslice < mip_depth; zslice++)
                         {
-                            uint slice_size = mip_row_blocks * mip_col_blocks * m_bytes_per_block;
-                            if ((!slice_size) || (slice_size > num_image_bytes_remaining))
+                            if (slice_size > num_image_bytes_remaining)
                                 return false;
 
                             uint image_index = get_image_index(mip_level, array_element, face, zslice);
@@ -659,16 +644,14 @@ namespace vogl
         return true;
     }
 
-    bool ktx_texture::write_to_stream(data_stream_serializer &serializer, bool no_keyvalue_data) const
+    bool ktx_texture::write_header_to_stream(data_stream_serializer &serializer, bool no_keyvalue_data) const
     {
-        if (!consistency_check())
-        {
-            VOGL_ASSERT_ALWAYS;
+        if (!check_header())
             return false;
-        }
 
         memcpy(m_header.m_identifier, s_ktx_file_id, sizeof(m_header.m_identifier));
-        m_header.m_endianness = m_opposite_endianness ? KTX_OPPOSITE_ENDIAN : KTX_ENDIAN;
+        // Always KTX_ENDIAN in native order, the whole header gets swapped below when writing in the opposite endianness.
+        m_header.m_endianness = KTX_ENDIAN;
 
         if (m_block_dim == 1)
         {
@@ -677,6 +660,8 @@ namespace vogl
         }
         else
         {
+            // Section 2.3 of the KTX spec: glTypeSize must be 1 for compressed data.
+            m_header.m_glTypeSize = 1;
             m_header.m_glBaseInternalFormat = ktx_get_ogl_compressed_base_internal_fmt(m_header.m_glInternalFormat);
         }
 
@@ -736,110 +721,41 @@ namespace vogl
 
         VOGL_ASSERT(total_key_value_bytes == m_header.m_bytesOfKeyValueData);
 
+        return true;
+    }
+
+    bool ktx_texture::write_to_stream(data_stream_serializer &serializer, bool no_keyvalue_data) const
+    {
+        if (!consistency_check())
+        {
+            VOGL_ASSERT_ALWAYS;
+            return false;
+        }
+
+        ktx_texture_writer writer;
+        if (!writer.begin(serializer, *this, no_keyvalue_data))
+            return false;
+
         for (uint mip_level = 0; mip_level < get_num_mips(); mip_level++)
         {
             uint mip_width, mip_height, mip_depth;
             get_mip_dim(mip_level, mip_width, mip_height, mip_depth);
 
-            const uint mip_row_blocks = (mip_width + m_block_dim - 1) / m_block_dim;
-            const uint mip_col_blocks = (mip_height + m_block_dim - 1) / m_block_dim;
-            if ((!mip_row_blocks) || (!mip_col_blocks))
-                return false;
-
-            uint32 image_size = mip_row_blocks * mip_col_blocks * m_bytes_per_block;
-            if ((m_header.m_numberOfArrayElements) || (get_num_faces() == 1))
-                image_size *= (get_array_size() * get_num_faces() * mip_depth);
-
-            if (!image_size)
-            {
-                VOGL_ASSERT_ALWAYS;
-                return false;
-            }
-
-            if (m_opposite_endianness)
-                image_size = utils::swap32(image_size);
-
-            success = (serializer.write(&image_size, sizeof(image_size), 1) == 1);
-
-            if (m_opposite_endianness)
-                image_size = utils::swap32(image_size);
-
-            if (!success)
-                return false;
-
-            uint total_mip_size = 0;
-            uint total_image_data_size = 0;
-
-            if ((!m_header.m_numberOfArrayElements) && (get_num_faces() == 6))
+            for (uint array_element = 0; array_element < get_array_size(); array_element++)
             {
-                // plain non-array cubemap
                 for (uint face = 0; face < get_num_faces(); face++)
                 {
-                    const uint8_vec &image_data = get_image_data(get_image_index(mip_level, 0, face, 0));
-                    if ((!image_data.size()) || (image_data.size() != image_size))
-                        return false;
-
-                    if (m_opposite_endianness)
+                    for (uint zslice = 0; zslice < mip_depth; zslice++)
                     {
-                        uint8_vec tmp_image_data(image_data);
-                        utils::endian_swap_mem(&tmp_image_data[0], tmp_image_data.size(), m_header.m_glTypeSize);
-                        if (serializer.write(&tmp_image_data[0], tmp_image_data.size(), 1) != 1)
+                        const uint8_vec &image_data = get_image_data(get_image_index(mip_level, array_element, face, zslice));
+                        if (!writer.write_image(image_data.get_ptr(), image_data.size()))
                             return false;
                     }
-                    else if (serializer.write(&image_data[0], image_data.size(), 1) != 1)
-                        return false;
-
-                    // Not +=, but =, because of the silly image_size plain cubemap exception in the KTX file format
-                    total_image_data_size = image_data.size();
-
-                    uint num_cube_pad_bytes = 3 - ((image_data.size() + 3) % 4);
-                    if ((num_cube_pad_bytes) && (serializer.write(padding, num_cube_pad_bytes, 1) != 1))
-                        return false;
-
-                    total_mip_size += image_size + num_cube_pad_bytes;
                 }
             }
-            else
-            {
-                // 1D, 2D, 3D (normal or array texture), or array cubemap
-                for (uint array_element = 0; array_element < get_array_size(); array_element++)
-                {
-                    for (uint face = 0; face < get_num_faces(); face++)
-                    {
-                        for (uint zslice = 0; zslice < mip_depth; zslice++)
-                        {
-                            const uint8_vec &image_data = get_image_data(get_image_index(mip_level, array_element, face, zslice));
-                            if (!image_data.size())
-                                return false;
-
-                            if (m_opposite_endianness)
-                            {
-                                uint8_vec tmp_image_data(image_data);
-                                utils::endian_swap_mem(&tmp_image_data[0], tmp_image_data.size(), m_header.m_glTypeSize);
-                                if (serializer.write(&tmp_image_data[0], tmp_image_data.size(), 1) != 1)
-                                    return false;
-                            }
-                            else if (serializer.write(&image_data[0], image_data.size(), 1) != 1)
-                                return false;
-
-                            total_image_data_size += image_data.size();
-
-                            total_mip_size += image_data.size();
-                        }
-                    }
-                }
-
-                uint num_mip_pad_bytes = 3 - ((total_mip_size + 3) % 4);
-                if ((num_mip_pad_bytes) && (serializer.write(padding, num_mip_pad_bytes, 1) != 1))
-                    return false;
-                total_mip_size += num_mip_pad_bytes;
-            }
-
-            VOGL_ASSERT((total_mip_size & 3) == 0);
-            VOGL_ASSERT(total_image_data_size == image_size);
         }
 
-        return true;
+        return writer.end();
     }
 
     bool ktx_texture::init_1D(uint width, uint num_mips, uint32 ogl_internal_fmt, uint32 ogl_fmt, uint32 ogl_type)
@@ -1247,4 +1163,474 @@ namespace vogl
         return true;
     }
 
+    ktx_texture_reader::ktx_texture_reader()
+        : m_pStream(NULL),
+          m_has_padding(true)
+    {
+    }
+
+    ktx_texture_reader::~ktx_texture_reader()
+    {
+        close();
+    }
+
+    void ktx_texture_reader::close()
+    {
+        m_pStream = NULL;
+        m_desc.clear();
+        m_level_ofs.clear();
+        m_has_padding = true;
+    }
+
+    bool ktx_texture_reader::open(data_stream &stream)
+    {
+        close();
+
+        if ((!stream.is_readable()) || (!stream.is_seekable()))
+            return false;
+
+        data_stream_serializer serializer(stream);
+        if (!m_desc.read_header_from_stream(serializer))
+        {
+            close();
+            return false;
+        }
+
+        // Without imageSize fields (PVRTexTool) there's no padding either, see ktx_texture::read_from_stream().
+        const bool has_image_size_fields = !m_desc.is_missing_image_size_fields(stream.get_remaining());
+        m_has_padding = has_image_size_fields;
+
+        const uint64_t stream_size = stream.get_size();
+        uint64_t ofs = stream.get_ofs();
+
+        m_level_ofs.resize(m_desc.get_num_mips());
+
+        for (uint mip_level = 0; mip_level < m_desc.get_num_mips(); mip_level++)
+        {
+            const uint slice_size = m_desc.get_expected_image_size(mip_level);
+            if (!slice_size)
+            {
+                close();
+                return false;
+            }
+
+            if (has_image_size_fields)
+            {
+                uint32 image_size = 0;
+                if ((!stream.seek(ofs, false)) || (stream.read(&image_size, sizeof(image_size)) != sizeof(image_size)))
+                {
+                    close();
+                    return false;
+                }
+
+                if (m_desc.get_opposite_endianness())
+                    image_size = utils::swap32(image_size);
+
+                if (image_size != m_desc.get_level_image_size_field(mip_level))
+                {
+                    close();
+                    return false;
+                }
+
+                ofs += sizeof(image_size);
+            }
+
+            m_level_ofs[mip_level] = ofs;
+
+            if (m_desc.is_plain_cubemap())
+            {
+                uint num_cube_pad_bytes = m_has_padding ? (3 - ((slice_size + 3) % 4)) : 0;
+                ofs += static_cast<uint64_t>(slice_size + num_cube_pad_bytes) * m_desc.get_num_faces();
+            }
+            else
+            {
+                uint64_t total_mip_size = static_cast<uint64_t>(slice_size) * m_desc.get_num_level_images(mip_level);
+                ofs += total_mip_size;
+                if (m_has_padding)
+                    ofs += 3 - ((total_mip_size + 3) % 4);
+            }
+
+            if (ofs > stream_size)
+            {
+                close();
+                return false;
+            }
+        }
+
+        m_pStream = &stream;
+
+        return true;
+    }
+
+    uint64_t ktx_texture_reader::get_image_ofs(uint mip_index, uint array_index, uint face_index, uint zslice_index) const
+    {
+        VOGL_ASSERT(is_opened());
+
+        uint mip_width, mip_height, mip_depth;
+        m_desc.get_mip_dim(mip_index, mip_width, mip_height, mip_depth);
+        VOGL_ASSERT((array_index < m_desc.get_array_size()) && (face_index < m_desc.get_num_faces()) && (zslice_index < mip_depth));
+
+        const uint slice_size = get_image_size(mip_index);
+
+        if (m_desc.is_plain_cubemap())
+        {
+            uint num_cube_pad_bytes = m_has_padding ? (3 - ((slice_size + 3) % 4)) : 0;
+            return m_level_ofs[mip_index] + static_cast<uint64_t>(slice_size + num_cube_pad_bytes) * face_index;
+        }
+
+        uint image_index = (array_index * m_desc.get_num_faces() + face_index) * mip_depth + zslice_index;
+        return m_level_ofs[mip_index] + static_cast<uint64_t>(slice_size) * image_index;
+    }
+
+    bool ktx_texture_reader::read_image(uint mip_index, uint array_index, uint face_index, uint zslice_index, uint8_vec &data) const
+    {
+        if (!is_opened())
+            return false;
+
+        uint mip_width, mip_height, mip_depth;
+        m_desc.get_mip_dim(mip_index, mip_width, mip_height, mip_depth);
+        if ((array_index >= m_desc.get_array_size()) || (face_index >= m_desc.get_num_faces()) || (zslice_index >= mip_depth))
+            return false;
+
+        const uint slice_size = get_image_size(mip_index);
+
+        if (!m_pStream->seek(get_image_ofs(mip_index, array_index, face_index, zslice_index), false))
+            return false;
+
+        data.resize(slice_size);
+        if (m_pStream->read(data.get_ptr(), slice_size) != slice_size)
+            return false;
+
+        if (m_desc.get_opposite_endianness())
+            utils::endian_swap_mem(data.get_ptr(), slice_size, m_desc.get_header().m_glTypeSize);
+
+        return true;
+    }
+
+    bool ktx_texture_reader::read_mip_level(uint mip_index, ktx_texture &tex) const
+    {
+        if ((!is_opened()) || (mip_index >= m_desc.get_num_mips()))
+            return false;
+
+        if ((tex.get_width() != m_desc.get_width()) || (tex.get_height() != m_desc.get_height()) || (tex.get_depth() != m_desc.get_depth()) ||
+            (tex.get_num_mips() != m_desc.get_num_mips()) || (tex.get_array_size() != m_desc.get_array_size()) || (tex.get_num_faces() != m_desc.get_num_faces()) ||
+            (tex.get_ogl_internal_fmt() != m_desc.get_ogl_internal_fmt()))
+        {
+            return false;
+        }
+
+        uint mip_width, mip_height, mip_depth;
+        m_desc.get_mip_dim(mip_index, mip_width, mip_height, mip_depth);
+
+        for (uint array_element = 0; array_element < m_desc.get_array_size(); array_element++)
+        {
+            for (uint face = 0; face < m_desc.get_num_faces(); face++)
+            {
+                for (uint zslice = 0; zslice < mip_depth; zslice++)
+                {
+                    uint image_index = tex.get_image_index(mip_index, array_element, face, zslice);
+                    tex.get_image_data_vec().ensure_element_is_valid(image_index);
+
+                    if (!read_image(mip_index, array_element, face, zslice, tex.get_image_data(image_index)))
+                        return false;
+                }
+            }
+        }
+
+        return true;
+    }
+
+    const uint8 *ktx_texture_reader::map_image(uint mip_index, uint array_index, uint face_index, uint zslice_index) const
+    {
+        if (!is_opened())
+            return NULL;
+
+        if ((m_desc.get_opposite_endianness()) && (m_desc.get_header().m_glTypeSize > 1))
+            return NULL;
+
+        const uint8 *pBuf = static_cast<const uint8 *>(m_pStream->get_ptr());
+        if (!pBuf)
+            return NULL;
+
+        uint mip_width, mip_height, mip_depth;
+        m_desc.get_mip_dim(mip_index, mip_width, mip_height, mip_depth);
+        if ((array_index >= m_desc.get_array_size()) || (face_index >= m_desc.get_num_faces()) || (zslice_index >= mip_depth))
+            return NULL;
+
+        return pBuf + get_image_ofs(mip_index, array_index, face_index, zslice_index);
+    }
+
+    ktx_texture_writer::ktx_texture_writer()
+    {
+        reset();
+    }
+
+    ktx_texture_writer::~ktx_texture_writer()
+    {
+    }
+
+    void ktx_texture_writer::reset()
+    {
+        m_serializer.set_stream(NULL);
+        m_pDesc = NULL;
+
+        m_cur_mip_index = 0;
+        m_cur_array_index = 0;
+        m_cur_face_index = 0;
+        m_cur_zslice_index = 0;
+        m_cur_level_size = 0;
+    }
+
+    bool ktx_texture_writer::begin(data_stream_serializer &serializer, const ktx_texture &desc, bool no_keyvalue_data)
+    {
+        reset();
+
+        if (!desc.get_expected_image_size(0))
+            return false;
+
+        if (!desc.write_header_to_stream(serializer, no_keyvalue_data))
+            return false;
+
+        m_serializer = serializer;
+        m_pDesc = &desc;
+
+        return true;
+    }
+
+    bool ktx_texture_writer::write_padding(uint size)
+    {
+        const uint8 padding[3] = { 0, 0, 0 };
+        VOGL_ASSERT(size <= sizeof(padding));
+
+        return (!size) || (m_serializer.write(padding, size, 1) == 1);
+    }
+
+    bool ktx_texture_writer::write_image(uint mip_index, uint array_index, uint face_index, uint zslice_index, const void *pData, uint data_size)
+    {
+        if ((mip_index != m_cur_mip_index) || (array_index != m_cur_array_index) || (face_index != m_cur_face_index) || (zslice_index != m_cur_zslice_index))
+        {
+            VOGL_ASSERT_ALWAYS;
+            return false;
+        }
+
+        return write_image(pData, data_size);
+    }
+
+    bool ktx_texture_writer::write_image(const void *pData, uint data_size)
+    {
+        if ((!m_pDesc) || (is_complete()))
+            return false;
+
+        const ktx_texture &desc = *m_pDesc;
+
+        if ((!pData) || (data_size != desc.get_expected_image_size(m_cur_mip_index)))
+            return false;
+
+        const bool opposite_endianness = desc.get_opposite_endianness();
+
+        // First image of a mip level: write its imageSize field.
+        if ((!m_cur_array_index) && (!m_cur_face_index) && (!m_cur_zslice_index))
+        {
+            uint32 image_size = desc.get_level_image_size_field(m_cur_mip_index);
+            if (opposite_endianness)
+                image_size = utils::swap32(image_size);
+
+            if (m_serializer.write(&image_size, sizeof(image_size), 1) != 1)
+                return false;
+
+            m_cur_level_size = 0;
+        }
+
+        if (opposite_endianness)
+        {
+            m_swap_buf.resize(data_size);
+            memcpy(m_swap_buf.get_ptr(), pData, data_size);
+            utils::endian_swap_mem(m_swap_buf.get_ptr(), data_size, desc.get_header().m_glTypeSize);
+            pData = m_swap_buf.get_ptr();
+        }
+
+        if (m_serializer.write(pData, data_size, 1) != 1)
+            return false;
+
+        m_cur_level_size += data_size;
+
+        if (desc.is_plain_cubemap())
+        {
+            uint num_cube_pad_bytes = 3 - ((data_size + 3) % 4);
+            if (!write_padding(num_cube_pad_bytes))
+                return false;
+            m_cur_level_size += num_cube_pad_bytes;
+        }
+
+        // Advance to the next image in file order.
+        uint mip_width, mip_height, mip_depth;
+        desc.get_mip_dim(m_cur_mip_index, mip_width, mip_height, mip_depth);
+
+        if (++m_cur_zslice_index < mip_depth)
+            return true;
+        m_cur_zslice_index = 0;
+
+        if (++m_cur_face_index < desc.get_num_faces())
+            return true;
+        m_cur_face_index = 0;
+
+        if (++m_cur_array_index < desc.get_array_size())
+            return true;
+        m_cur_array_index = 0;
+
+        uint num_mip_pad_bytes = 3 - ((m_cur_level_size + 3) % 4);
+        if (!write_padding(num_mip_pad_bytes))
+            return false;
+
+        m_cur_mip_index++;
+
+        return true;
+    }
+
+    bool ktx_texture_writer::end()
+    {
+        bool success = is_complete();
+
+        reset();
+
+        return success;
+    }
+
+    // Round trips a few texture layouts through write_to_stream(), read_from_stream(), ktx_texture_reader and ktx_texture_writer.
+    static bool ktx_texture_test_layout(ktx_texture &tex, random &r, bool opposite_endianness)
+    {
+        tex.set_opposite_endianness(opposite_endianness);
+        tex.add_key_value("KTXorientation", "S=r,T=d");
+
+        for (uint mip_level = 0; mip_level < tex.get_num_mips(); mip_level++)
+        {
+            uint mip_width, mip_height, mip_depth;
+            tex.get_mip_dim(mip_level, mip_width, mip_height, mip_depth);
+
+            uint8_vec img(tex.get_expected_image_size(mip_level));
+            for (uint a = 0; a < tex.get_array_size(); a++)
+            {
+                for (uint f = 0; f < tex.get_num_faces(); f++)
+                {
+                    for (uint z = 0; z < mip_depth; z++)
+                    {
+                        for (uint i = 0; i < img.size(); i++)
+                            img[i] = static_cast<uint8>(r.urand32());
+                        tex.add_image(mip_level, a, f, z, img.get_ptr(), img.size());
+                    }
+                }
+            }
+        }
+
+        dynamic_stream file_stream;
+        data_stream_serializer file_serializer(file_stream);
+        if (!tex.write_to_stream(file_serializer))
+            return false;
+
+        // Full read
+        file_stream.seek(0, false);
+        ktx_texture full_tex;
+        if ((!full_tex.read_from_stream(file_serializer)) || (full_tex.get_num_images() != tex.get_num_images()))
+            return false;
+
+        // Lazy reads, with the streaming writer re-emitting each level as it's read.
+        file_stream.seek(0, false);
+        ktx_texture_reader reader;
+        if (!reader.open(file_stream))
+            return false;
+
+        const ktx_texture &desc = reader.get_desc();
+        if ((desc.get_num_images()) || (desc.get_num_mips() != tex.get_num_mips()) || (desc.get_array_size() != tex.get_array_size()) || (desc.get_depth() != tex.get_depth()))
+            return false;
+
+        dynamic_stream copy_stream;
+        data_stream_serializer copy_serializer(copy_stream);
+        ktx_texture_writer writer;
+        if (!writer.begin(copy_serializer, desc))
+            return false;
+
+        ktx_texture level_tex(desc);
+        for (uint mip_level = tex.get_num_mips(); mip_level-- > 0;)
+        {
+            if (!reader.read_mip_level(mip_level, level_tex))
+                return false;
+        }
+
+        uint8_vec img;
+        for (uint mip_level = 0; mip_level < tex.get_num_mips(); mip_level++)
+        {
+            uint mip_width, mip_height, mip_depth;
+            tex.get_mip_dim(mip_level, mip_width, mip_height, mip_depth);
+
+            for (uint a = 0; a < tex.get_array_size(); a++)
+            {
+                for (uint f = 0; f < tex.get_num_faces(); f++)
+                {
+                    for (uint z = 0; z < mip_depth; z++)
+                    {
+                        const uint8_vec &expected_img = tex.get_image_data(mip_level, a, f, z);
+
+                        if ((!reader.read_image(mip_level, a, f, z, img)) || (img != expected_img))
+                            return false;
+
+                        if ((full_tex.get_image_data(mip_level, a, f, z) != expected_img) || (level_tex.get_image_data(mip_level, a, f, z) != expected_img))
+                            return false;
+
+                        const uint8 *pMapped = reader.map_image(mip_level, a, f, z);
+                        if ((pMapped) && (memcmp(pMapped, expected_img.get_ptr(), expected_img.size()) != 0))
+                            return false;
+                        if ((!pMapped) != (opposite_endianness && (tex.get_header().m_glTypeSize > 1)))
+                            return false;
+
+                        if (!writer.write_image(mip_level, a, f, z, img.get_ptr(), img.size()))
+                            return false;
+                    }
+                }
+            }
+        }
+
+        if (!writer.end())
+            return false;
+
+        return copy_stream.get_buf() == file_stream.get_buf();
+    }
+
+    bool ktx_texture_test()
+    {
+        random r;
+        r.seed(1000);
+
+        for (uint pass = 0; pass < 2; pass++)
+        {
+            const bool opposite_endianness = (pass != 0);
+
+            ktx_texture tex_2d;
+            if ((!tex_2d.init_2D(37, 19, 6, KTX_RGB8, KTX_RGB, KTX_UNSIGNED_BYTE)) || (!ktx_texture_test_layout(tex_2d, r, opposite_endianness)))
+                return false;
+
+            ktx_texture tex_cube;
+            if ((!tex_cube.init_cubemap(9, 4, KTX_RGB8, KTX_RGB, KTX_UNSIGNED_BYTE)) || (!ktx_texture_test_layout(tex_cube, r, opposite_endianness)))
+                return false;
+
+            ktx_texture tex_cube_array;
+            if ((!tex_cube_array.init_cubemap_array(5, 3, 2, KTX_RGB8, KTX_RGB, KTX_UNSIGNED_BYTE)) || (!ktx_texture_test_layout(tex_cube_array, r, opposite_endianness)))
+                return false;
+
+            ktx_texture tex_3d;
+            if ((!tex_3d.init_3D(8, 4, 5, 4, KTX_RGBA, KTX_RGBA, KTX_UNSIGNED_SHORT)) || (!ktx_texture_test_layout(tex_3d, r, opposite_endianness)))
+                return false;
+
+            ktx_texture tex_2d_array;
+            if ((!tex_2d_array.init_2D_array(13, 7, 3, 4, KTX_RGBA, KTX_RGBA, KTX_FLOAT)) || (!ktx_texture_test_layout(tex_2d_array, r, opposite_endianness)))
+                return false;
+
+            ktx_texture tex_dxt1;
+            if ((!tex_dxt1.init_2D(13, 6, 3, KTX_COMPRESSED_RGB_S3TC_DXT1_EXT, 0, 0)) || (!ktx_texture_test_layout(tex_dxt1, r, opposite_endianness)))
+                return false;
+        }
+
+        return true;
+    }
+
+
 } // namespace vogl
@@ -238,6 +238,11 @@ namespace vogl
         bool read_from_stream(data_stream_serializer &serializer);
         bool write_to_stream(data_stream_serializer &serializer, bool no_keyvalue_data = false) const;
 
+        // Header only methods, used by ktx_texture_reader/ktx_texture_writer.
+        // read_header_from_stream() initializes the header and key values (but no image data), and leaves the stream positioned at the first mip level.
+        bool read_header_from_stream(data_stream_serializer &serializer);
+        bool write_header_to_stream(data_stream_serializer &serializer, bool no_keyvalue_data = false) const;
+
         // For compressed internal formats, set ogl_fmt and ogl_type to 0 (GL_NONE). The base internal format will be computed automatically.
         // Otherwise, if ogl_fmt/ogl_type are not 0 (GL_NONE) then the internal format must be uncompressed, and all fmt's must be valid.
         bool init_1D(uint width, uint num_mips, uint32 ogl_internal_fmt, uint32 ogl_fmt, uint32 ogl_type);
@@ -445,6 +450,30 @@ namespace vogl
         // Returns the expected size of a single 2D image. (For 3D, multiply by the depth, etc.)
         uint get_expected_image_size(uint mip_index) const;
 
+        // The KTX file format has an exception for plain (non-array) cubemaps: imageSize is the size of a single face, and each face is padded.
+        bool is_plain_cubemap() const
+        {
+            return (!m_header.m_numberOfArrayElements) && (get_num_faces() == 6);
+        }
+
+        // Returns the total number of 2D images stored in a mip level (array elements * faces * zslices), in file order.
+        uint get_num_level_images(uint mip_index) const
+        {
+            uint mip_width, mip_height, mip_depth;
+            get_mip_dim(mip_index, mip_width, mip_height, mip_depth);
+            return get_array_size() * get_num_faces() * mip_depth;
+        }
+
+        // Returns the value of the imageSize field which precedes the mip level in the file.
+        uint get_level_image_size_field(uint mip_index) const
+        {
+            uint image_size = get_expected_image_size(mip_index);
+            return is_plain_cubemap() ? image_size : (image_size * get_num_level_images(mip_index));
+        }
+
+        // true if the stream is too small to contain the imageSize fields and padding (PVRTexTool's KTX writer omits them).
+        bool is_missing_image_size_fields(uint64_t stream_bytes_remaining) const;
+
         bool operator==(const ktx_texture &rhs) const;
         bool operator!=(const ktx_texture &rhs) const
         {
@@ -465,4 +494,122 @@ namespace vogl
         bool compute_pixel_info();
     };
 
+    // Lazy KTX accessor. open() only reads the header and key values, then indexes the file offset of each mip level by hopping over the
+    // imageSize fields. Individual images or whole mip levels are read (and endian swapped) on demand, so viewing or restoring a single level
+    // doesn't require loading the entire mip chain. The stream must be seekable and must outlive the reader.
+    class ktx_texture_reader
+    {
+        ktx_texture_reader(const ktx_texture_reader &);
+        ktx_texture_reader &operator=(const ktx_texture_reader &);
+
+    public:
+        ktx_texture_reader();
+        ~ktx_texture_reader();
+
+        bool open(data_stream &stream);
+        void close();
+
+        bool is_opened() const
+        {
+            return m_pStream != NULL;
+        }
+
+        // Header and key values only, the returned texture has no image data.
+        const ktx_texture &get_desc() const
+        {
+            return m_desc;
+        }
+
+        // Size of a single 2D image in the specified mip level.
+        uint get_image_size(uint mip_index) const
+        {
+            return m_desc.get_expected_image_size(mip_index);
+        }
+
+        // Offset of the image's data in the stream.
+        uint64_t get_image_ofs(uint mip_index, uint array_index, uint face_index, uint zslice_index) const;
+
+        bool read_image(uint mip_index, uint array_index, uint face_index, uint zslice_index, uint8_vec &data) const;
+
+        // Reads all of a mip level's images into tex, which must have been initialized with the same description (see get_desc()).
+        bool read_mip_level(uint mip_index, ktx_texture &tex) const;
+
+        // Returns a pointer directly into the stream's memory (see data_stream::get_ptr()) if the stream is memory backed and the image doesn't
+        // need to be endian swapped, otherwise NULL. The caller should fall back to read_image() in this case.
+        const uint8 *map_image(uint mip_index, uint array_index, uint face_index, uint zslice_index) const;
+
+    private:
+        data_stream *m_pStream;
+        ktx_texture m_desc;
+
+        // Offset of each mip level's first image (just past its imageSize field)
+        vogl::vector<uint64_t> m_level_ofs;
+
+        bool m_has_padding;
+    };
+
+    // Streaming KTX writer. begin() writes the header and key values, then each image is written as soon as it's supplied, so the caller
+    // only needs to keep one image (or mip level) resident at a time. Images must be supplied in file order: by mip level, then array element,
+    // face and zslice. The description texture passed to begin() doesn't need any image data, and must outlive the writer.
+    class ktx_texture_writer
+    {
+        ktx_texture_writer(const ktx_texture_writer &);
+        ktx_texture_writer &operator=(const ktx_texture_writer &);
+
+    public:
+        ktx_texture_writer();
+        ~ktx_texture_writer();
+
+        bool begin(data_stream_serializer &serializer, const ktx_texture &desc, bool no_keyvalue_data = false);
+
+        // Writes the next image in file order.
+        bool write_image(const void *pData, uint data_size);
+
+        // Same as above, but verifies the image is the next one expected.
+        bool write_image(uint mip_index, uint array_index, uint face_index, uint zslice_index, const void *pData, uint data_size);
+
+        // Fails if any images are missing.
+        bool end();
+
+        bool is_complete() const
+        {
+            return (m_pDesc != NULL) && (m_cur_mip_index >= m_pDesc->get_num_mips());
+        }
+
+        // The next image expected by write_image().
+        uint get_cur_mip_index() const
+        {
+            return m_cur_mip_index;
+        }
+        uint get_cur_array_index() const
+        {
+            return m_cur_array_index;
+        }
+        uint get_cur_face_index() const
+        {
+            return m_cur_face_index;
+        }
+        uint get_cur_zslice_index() const
+        {
+            return m_cur_zslice_index;
+        }
+
+    private:
+        data_stream_serializer m_serializer;
+        const ktx_texture *m_pDesc;
+
+        uint m_cur_mip_index;
+        uint m_cur_array_index;
+        uint m_cur_face_index;
+        uint m_cur_zslice_index;
+        uint m_cur_level_size;
+
+        uint8_vec m_swap_buf;
+
+        void reset();
+        bool write_padding(uint size);
+    };
+
+    bool ktx_texture_test();
+
 } // namespace vogl
@@ -0,0 +1,178 @@
+/**************************************************************************
+ *
+ * Copyright 2013-2014 RAD Game Tools and Valve Software
+ * Copyright 2010-2014 Rich Geldreich and Tenacious Software LLC
+ * All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ **************************************************************************/
+
+// File: vogl_linear_allocator.h
+//
+// Chunked bump allocator. Individual allocations are never freed, instead reset() recycles every chunk at once,
+// so a steady state workload (like repeatedly building or deserializing trace packets) performs no heap allocations.
+// Chunks can optionally come from a concurrent_buffer_pool, so short lived allocators recycle chunks between each other.
+#pragma once
+
+#include "vogl_core.h"
+#include "vogl_concurrent_pool.h"
+
+namespace vogl
+{
+    class linear_allocator
+    {
+        VOGL_NO_COPY_OR_ASSIGNMENT_OP(linear_allocator);
+
+    public:
+        enum
+        {
+            cDefaultChunkSize = 16 * 1024,
+            cAlignment = 8
+        };
+
+        // If pChunk_pool is not NULL chunks are allocated from (and freed back to) it instead of the heap. The pool must outlive the allocator.
+        inline explicit linear_allocator(uint chunk_size = cDefaultChunkSize, concurrent_buffer_pool *pChunk_pool = NULL)
+            : m_pChunk_pool(pChunk_pool),
+              m_cur_chunk(0),
+              m_cur_ofs(0),
+              m_chunk_size(math::maximum<uint>(chunk_size, cAlignment)),
+              m_total_allocated(0)
+        {
+        }
+
+        inline ~linear_allocator()
+        {
+            clear();
+        }
+
+        // Frees all chunks.
+        inline void clear()
+        {
+            for (uint i = 0; i < m_chunks.size(); i++)
+            {
+                if (m_pChunk_pool)
+                    m_pChunk_pool->free(m_chunks[i].m_pBuf);
+                else
+                    vogl_free(m_chunks[i].m_pBuf);
+            }
+            m_chunks.clear();
+
+            m_cur_chunk = 0;
+            m_cur_ofs = 0;
+            m_total_allocated = 0;
+        }
+
+        // Invalidates all previous allocations, but doesn't free any memory.
+        inline void reset()
+        {
+            m_cur_chunk = 0;
+            m_cur_ofs = 0;
+            m_total_allocated = 0;
+        }
+
+        // Returns cAlignment aligned memory, never NULL (vogl_malloc() aborts on OOM).
+        inline void *alloc(size_t size)
+        {
+            size = (size + (cAlignment - 1)) & ~static_cast<size_t>(cAlignment - 1);
+
+            while (m_cur_chunk < m_chunks.size())
+            {
+                chunk &c = m_chunks[m_cur_chunk];
+                if ((c.m_size - m_cur_ofs) >= size)
+                {
+                    void *p = c.m_pBuf + m_cur_ofs;
+                    m_cur_ofs += size;
+                    m_total_allocated += size;
+                    return p;
+                }
+
+                m_cur_chunk++;
+                m_cur_ofs = 0;
+            }
+
+            // Oversized requests get their own chunk, which is kept around for reuse after reset().
+            chunk *pChunk = m_chunks.enlarge(1);
+            pChunk->m_size = math::maximum<size_t>(size, m_chunk_size);
+            if (m_pChunk_pool)
+            {
+                pChunk->m_pBuf = static_cast<uint8 *>(m_pChunk_pool->alloc(pChunk->m_size));
+                if (!pChunk->m_pBuf)
+                    VOGL_FAIL("linear_allocator::alloc: Out of memory");
+
+                // Pooled buffers are rounded up to their size class, so use all of it.
+                pChunk->m_size = concurrent_buffer_pool::get_buffer_size(pChunk->m_pBuf);
+            }
+            else
+            {
+                pChunk->m_pBuf = static_cast<uint8 *>(vogl_malloc(pChunk->m_size));
+            }
+
+            m_cur_chunk = m_chunks.size() - 1;
+            m_cur_ofs = size;
+            m_total_allocated += size;
+
+            return pChunk->m_pBuf;
+        }
+
+        inline void *alloc_and_copy(const void *pData, size_t size)
+        {
+            void *p = alloc(size);
+            if (size)
+                memcpy(p, pData, size);
+            return p;
+        }
+
+        // Total bytes handed out since the last reset() (including alignment padding).
+        inline uint64_t get_total_allocated() const
+        {
+            return m_total_allocated;
+        }
+
+        inline uint get_num_chunks() const
+        {
+            return m_chunks.size();
+        }
+
+        inline uint get_chunk_size() const
+        {
+            return m_chunk_size;
+        }
+
+        inline concurrent_buffer_pool *get_chunk_pool() const
+        {
+            return m_pChunk_pool;
+        }
+
+    private:
+        struct chunk
+        {
+            uint8 *m_pBuf;
+            size_t m_size;
+        };
+
+        concurrent_buffer_pool *m_pChunk_pool;
+        vogl::vector<chunk> m_chunks;
+        uint m_cur_chunk;
+        size_t m_cur_ofs;
+        uint m_chunk_size;
+        uint64_t m_total_allocated;
+    };
+
+} // namespace vogl
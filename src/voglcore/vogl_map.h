@@ -373,6 +373,32 @@ namespace vogl
             return *this;
         }
 
+#if VOGL_HAS_MOVE_SEMANTICS
+        // other is left empty (but still owns a head node, so it remains usable).
+        inline map(map &&other)
+            : m_total_allocated(0),
+              m_pHead(NULL),
+              m_size(0),
+              m_rand(other.m_rand),
+              m_fixed_max_level(other.m_fixed_max_level),
+              m_is_key_less_than(other.m_is_key_less_than),
+              m_is_key_equal_to(other.m_is_key_equal_to)
+        {
+            init(cDefaultMaxLevel);
+            swap(other);
+        }
+
+        inline map &operator=(map &&rhs)
+        {
+            if (this != &rhs)
+            {
+                clear();
+                swap(rhs);
+            }
+            return *this;
+        }
+#endif
+
         inline ~map()
         {
             m_pHead->check_head_debug_marker();
@@ -565,6 +591,37 @@ namespace vogl
             return insert(value.first, value.second, true);
         }
 
+#if VOGL_HAS_MOVE_SEMANTICS
+        inline insert_result insert(Key &&key, Value &&value)
+        {
+            return emplace(std::move(key), std::move(value));
+        }
+
+        inline insert_result insert(value_type &&value)
+        {
+            return emplace(std::move(const_cast<Key &>(value.first)), std::move(value.second));
+        }
+
+        inline insert_result insert_multi(Key &&key, Value &&value)
+        {
+            return emplace_multi(std::move(key), std::move(value));
+        }
+
+        // Like insert(), but the key and value are constructed in place from the supplied arguments (only if the key isn't already present).
+        // key is only moved from if a new key/value is inserted.
+        template <typename K, typename... Args>
+        inline insert_result emplace(K &&key, Args &&... args)
+        {
+            return emplace_internal(false, std::forward<K>(key), std::forward<Args>(args)...);
+        }
+
+        template <typename K, typename... Args>
+        inline insert_result emplace_multi(K &&key, Args &&... args)
+        {
+            return emplace_internal(true, std::forward<K>(key), std::forward<Args>(args)...);
+        }
+#endif
+
         inline Value &operator[](const Key &key)
         {
             return (insert(key).first)->second;
@@ -1313,6 +1370,17 @@ namespace vogl
         }
 
         inline node_type *alloc_node(uint num_forward_ptrs, const Key &key, const Value &val)
+        {
+            node_type *p = alloc_node_no_construction(num_forward_ptrs);
+
+            helpers::construct(const_cast<Key *>(&p->first), key);
+            helpers::construct(&p->second, val);
+
+            return p;
+        }
+
+        // The caller must construct the node's key and value.
+        inline node_type *alloc_node_no_construction(uint num_forward_ptrs)
         {
             VOGL_ASSERT(num_forward_ptrs && (num_forward_ptrs < cMaxLevels));
 
@@ -1327,9 +1395,6 @@ namespace vogl
             p->set_debug_marker(cMapListNodeItemDebugMarker);
 #endif
 
-            helpers::construct(const_cast<Key *>(&p->first), key);
-            helpers::construct(&p->second, val);
-
             return p;
         }
 
@@ -1358,7 +1423,7 @@ namespace vogl
                 m_pHead = static_cast<node_type *>(vogl_malloc(sizeof(node_type) + (cMaxLevels - 1) * sizeof(void *)));
 
                 // Purposely clearing the whole thing, because we're not going to construct the Key/Value at the beginning (and if somebody screws up and accesses the head by accident, at least they get zero's instead of garbage).
-                memset(m_pHead, 0, sizeof(node_type));
+                memset(static_cast<void *>(m_pHead), 0, sizeof(node_type));
 
 #ifdef VOGL_ASSERTS_ENABLED
                 m_pHead->set_debug_marker(cMapNodeHeadDebugMarker);
@@ -1461,13 +1526,43 @@ namespace vogl
         // insert_result.first will always point to inserted key/value (or the already existing key/value).
         // insert_result.second will be true if a new key/value was inserted, or false if the key already existed (in which case first will point to the already existing value).
         insert_result insert(const Key &key, const Value &value, bool allow_dups)
+        {
+            node_type *ppPredecessors[cMaxLevels];
+            int new_level;
+            insert_result result;
+            if (!find_insert_position(key, allow_dups, ppPredecessors, new_level, result))
+                return result;
+
+            return link_new_node(alloc_node(new_level + 1, key, value), ppPredecessors, new_level);
+        }
+
+#if VOGL_HAS_MOVE_SEMANTICS
+        template <typename K, typename... Args>
+        insert_result emplace_internal(bool allow_dups, K &&key, Args &&... args)
+        {
+            node_type *ppPredecessors[cMaxLevels];
+            int new_level;
+            insert_result result;
+            if (!find_insert_position(key, allow_dups, ppPredecessors, new_level, result))
+                return result;
+
+            node_type *pNew_node = alloc_node_no_construction(new_level + 1);
+            helpers::construct_emplace(const_cast<Key *>(&pNew_node->first), std::forward<K>(key));
+            helpers::construct_emplace(&pNew_node->second, std::forward<Args>(args)...);
+
+            return link_new_node(pNew_node, ppPredecessors, new_level);
+        }
+#endif
+
+        // Finds the predecessors of a new node with the specified key, and picks the new node's level.
+        // Returns false (and sets result) if nothing should be inserted.
+        bool find_insert_position(const Key &key, bool allow_dups, node_type **ppPredecessors, int &new_level, insert_result &result)
         {
             VOGL_ASSERT((m_max_level < cMaxLevels) && (m_cur_level <= m_max_level));
             m_pHead->check_head_debug_marker();
 
             node_type *p = m_pHead;
 
-            node_type *ppPredecessors[cMaxLevels];
             for (int i = m_cur_level; i >= 0; i--)
             {
                 for (;;)
@@ -1498,17 +1593,21 @@ namespace vogl
             {
                 p = p->get_forward_ptr(0);
                 if ((p != m_pHead) && (m_is_key_equal_to(p->first, key)))
-                    return std::make_pair(iterator(p), false);
+                {
+                    result = std::make_pair(iterator(p), false);
+                    return false;
+                }
             }
 
             if (m_size == cUINT32_MAX)
             {
                 VOGL_ASSERT_ALWAYS;
-                return std::make_pair(begin(), false);
+                result = std::make_pair(begin(), false);
+                return false;
             }
 
             uint rnd = m_rand.urand32();
-            int new_level = math::count_leading_zero_bits(rnd);
+            new_level = math::count_leading_zero_bits(rnd);
 #if VOGL_MAP_USE_POINT_25_PROB
             new_level >>= 1U;
 #endif
@@ -1522,8 +1621,11 @@ namespace vogl
                 m_cur_level = new_level;
             }
 
-            node_type *pNew_node = alloc_node(new_level + 1, key, value);
+            return true;
+        }
 
+        insert_result link_new_node(node_type *pNew_node, node_type **ppPredecessors, int new_level)
+        {
             node_type *pPrev = ppPredecessors[0];
             node_type *pNext = pPrev->get_forward_ptr(0);
 
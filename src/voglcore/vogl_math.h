@@ -466,6 +466,9 @@ namespace vogl
         // http://www-graphics.stanford.edu/~seander/bithacks.html
         inline uint count_trailing_zero_bits(uint v)
         {
+            #if defined(COMPILER_GCCLIKE)
+                return v ? __builtin_ctz(v) : 32;
+            #else
             uint c = 32; // c will be the number of zero bits on the right
 
             static const unsigned int B[] = { 0x55555555, 0x33333333, 0x0F0F0F0F, 0x00FF00FF, 0x0000FFFF };
@@ -486,6 +489,18 @@ namespace vogl
             }
 
             return c;
+            #endif
+        }
+
+        inline uint count_set_bits(uint32 v)
+        {
+            #if defined(COMPILER_GCCLIKE)
+                return __builtin_popcount(v);
+            #else
+                v = v - ((v >> 1) & 0x55555555);
+                v = (v & 0x33333333) + ((v >> 2) & 0x33333333);
+                return (((v + (v >> 4)) & 0x0F0F0F0F) * 0x01010101) >> 24;
+            #endif
         }
 
         inline uint count_leading_zero_bits(uint v)
@@ -0,0 +1,631 @@
+/**************************************************************************
+ *
+ * Copyright 2013-2014 RAD Game Tools and Valve Software
+ * Copyright 2010-2014 Rich Geldreich and Tenacious Software LLC
+ * All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ **************************************************************************/
+
+// File: vogl_miniz_parallel.cpp
+#include "vogl_core.h"
+#include "vogl_miniz_parallel.h"
+#include "vogl_miniz_zip.h"
+#include "vogl_threading.h"
+#include "vogl_rand.h"
+
+namespace vogl
+{
+    namespace mz_parallel
+    {
+        static const char *s_index_prefix = "vogl_pdfl1:";
+
+        typedef void (*block_func)(uint block_index, void *pContext);
+
+        struct block_task
+        {
+            block_func m_pFunc;
+            void *m_pContext;
+        };
+
+        static void block_task_callback(uint64_t data, void *pData_ptr)
+        {
+            const block_task *pTask = static_cast<const block_task *>(pData_ptr);
+            pTask->m_pFunc(static_cast<uint>(data), pTask->m_pContext);
+        }
+
+        // Calls pFunc once for each block, on a temporary task pool if there's more than one block and processor.
+        static void process_blocks(uint num_blocks, block_func pFunc, void *pContext)
+        {
+            task_pool tp;
+            if ((g_number_of_processors <= 1) || (num_blocks < 2) || (!tp.init(math::minimum<uint>(g_number_of_processors, num_blocks) - 1)))
+            {
+                for (uint i = 0; i < num_blocks; i++)
+                    pFunc(i, pContext);
+                return;
+            }
+
+            block_task task;
+            task.m_pFunc = pFunc;
+            task.m_pContext = pContext;
+
+            for (uint i = 0; i < num_blocks; i++)
+            {
+                if (!tp.queue_task(block_task_callback, i, &task))
+                    pFunc(i, pContext);
+            }
+
+            tp.join();
+        }
+
+        uint64_t get_block_size(uint64_t src_size)
+        {
+            if (src_size < cMinBlockSize * 2U)
+                return math::maximum<uint64_t>(src_size, 1U);
+
+            return math::maximum<uint64_t>(cMinBlockSize, (src_size + cMaxBlocks - 1) / cMaxBlocks);
+        }
+
+        mz_uint32 adler32_combine(mz_uint32 adler1, mz_uint32 adler2, uint64_t len2)
+        {
+            const mz_uint32 cBase = 65521U;
+
+            // s1 = s1_1 + s1_2 - 1, s2 = s2_1 + s2_2 + len2 * (s1_1 - 1), all mod 65521
+            const uint64_t s1_1 = adler1 & 0xFFFF, s2_1 = adler1 >> 16;
+            const uint64_t s1_2 = adler2 & 0xFFFF, s2_2 = adler2 >> 16;
+            const uint64_t rem = len2 % cBase;
+
+            uint64_t s1 = (s1_1 + s1_2 + cBase - 1) % cBase;
+            uint64_t s2 = (s2_1 + s2_2 + rem * ((s1_1 + cBase - 1) % cBase)) % cBase;
+
+            return static_cast<mz_uint32>((s2 << 16) | s1);
+        }
+
+        static mz_uint32 gf2_matrix_times(const mz_uint32 *pMat, mz_uint32 vec)
+        {
+            mz_uint32 sum = 0;
+            for (; vec; vec >>= 1, pMat++)
+            {
+                if (vec & 1)
+                    sum ^= *pMat;
+            }
+            return sum;
+        }
+
+        static void gf2_matrix_square(mz_uint32 *pSquare, const mz_uint32 *pMat)
+        {
+            for (uint n = 0; n < 32; n++)
+                pSquare[n] = gf2_matrix_times(pMat, pMat[n]);
+        }
+
+        // Appends len2 zero bytes to crc1's message by repeated squaring of the CRC shift operator, then adds in crc2.
+        mz_uint32 crc32_combine(mz_uint32 crc1, mz_uint32 crc2, uint64_t len2)
+        {
+            if (!len2)
+                return crc1;
+
+            mz_uint32 even[32], odd[32];
+
+            // Operator for a single zero bit.
+            odd[0] = 0xEDB88320U;
+            mz_uint32 row = 1;
+            for (uint n = 1; n < 32; n++, row <<= 1)
+                odd[n] = row;
+
+            // Two and four zero bits.
+            gf2_matrix_square(even, odd);
+            gf2_matrix_square(odd, even);
+
+            for (;;)
+            {
+                gf2_matrix_square(even, odd);
+                if (len2 & 1)
+                    crc1 = gf2_matrix_times(even, crc1);
+                len2 >>= 1;
+                if (!len2)
+                    break;
+
+                gf2_matrix_square(odd, even);
+                if (len2 & 1)
+                    crc1 = gf2_matrix_times(odd, crc1);
+                len2 >>= 1;
+                if (!len2)
+                    break;
+            }
+
+            return crc1 ^ crc2;
+        }
+
+        dynamic_string &block_index::serialize(dynamic_string &str) const
+        {
+            str.set(s_index_prefix);
+            str.append_char(m_primed ? 'p' : 'i');
+            str.append_char(':');
+            str.append_hex(m_block_size);
+
+            for (uint i = 0; i < m_comp_sizes.size(); i++)
+            {
+                str.append_char(i ? ',' : ':');
+                str.append_hex(m_comp_sizes[i]);
+            }
+
+            return str;
+        }
+
+        bool block_index::deserialize(const char *pStr)
+        {
+            clear();
+
+            const uint prefix_len = vogl_strlen(s_index_prefix);
+            if ((!pStr) || (strncmp(pStr, s_index_prefix, prefix_len) != 0))
+                return false;
+            pStr += prefix_len;
+
+            if ((pStr[0] != 'p') && (pStr[0] != 'i'))
+                return false;
+            m_primed = (pStr[0] == 'p');
+            if (pStr[1] != ':')
+                return false;
+            pStr += 2;
+
+            char *pEnd = NULL;
+            m_block_size = strtoull(pStr, &pEnd, 16);
+            if ((pEnd == pStr) || (*pEnd != ':') || (!m_block_size))
+            {
+                clear();
+                return false;
+            }
+
+            do
+            {
+                pStr = pEnd + 1;
+                uint64_t comp_size = strtoull(pStr, &pEnd, 16);
+                if ((pEnd == pStr) || ((*pEnd != ',') && (*pEnd != '\0')) || (m_comp_sizes.size() >= cMaxBlocks * 2))
+                {
+                    clear();
+                    return false;
+                }
+                m_comp_sizes.push_back(comp_size);
+            } while (*pEnd);
+
+            return true;
+        }
+
+        struct deflate_state
+        {
+            const uint8 *m_pSrc;
+            uint64_t m_src_size;
+            uint64_t m_block_size;
+            uint m_num_blocks;
+            mz_uint m_comp_flags;
+            bool m_prime_dictionary;
+            bool m_compute_adler32;
+            bool m_compute_crc32;
+
+            vogl::vector<uint8_vec> m_comp_data;
+            vogl::vector<mz_uint32> m_adler32;
+            vogl::vector<mz_uint32> m_crc32;
+            vogl::vector<uint8> m_failed;
+        };
+
+        static mz_bool deflate_put_buf_callback(const void *pBuf, int len, void *pUser)
+        {
+            uint8_vec &buf = *static_cast<uint8_vec *>(pUser);
+            if (static_cast<uint64_t>(buf.size()) + len > cUINT32_MAX / 2)
+                return MZ_FALSE;
+            buf.append(static_cast<const uint8 *>(pBuf), len);
+            return MZ_TRUE;
+        }
+
+        static void deflate_block(uint block_index, void *pContext)
+        {
+            deflate_state &state = *static_cast<deflate_state *>(pContext);
+
+            const uint64_t block_ofs = block_index * state.m_block_size;
+            const uint64_t block_size = math::minimum(state.m_block_size, state.m_src_size - block_ofs);
+            const bool last_block = (block_index == (state.m_num_blocks - 1));
+            const uint8 *pBlock = state.m_pSrc + block_ofs;
+
+            if (state.m_compute_adler32)
+                state.m_adler32[block_index] = static_cast<mz_uint32>(mz_adler32(MZ_ADLER32_INIT, pBlock, static_cast<size_t>(block_size)));
+            if (state.m_compute_crc32)
+                state.m_crc32[block_index] = static_cast<mz_uint32>(mz_crc32(MZ_CRC32_INIT, pBlock, static_cast<size_t>(block_size)));
+
+            tdefl_compressor *pComp = static_cast<tdefl_compressor *>(vogl_malloc(sizeof(tdefl_compressor)));
+            if (!pComp)
+            {
+                state.m_failed[block_index] = true;
+                return;
+            }
+
+            uint8_vec &comp_data = state.m_comp_data[block_index];
+            comp_data.reserve(static_cast<uint>(math::minimum<uint64_t>(block_size / 2 + 1024, cUINT32_MAX / 4)));
+
+            bool success = (tdefl_init(pComp, deflate_put_buf_callback, &comp_data, state.m_comp_flags) == TDEFL_STATUS_OKAY);
+
+            if ((success) && (state.m_prime_dictionary) && (block_ofs))
+            {
+                // tdefl has no way to preset the dictionary, so compress the tail of the previous block and throw away the output. The sync flush
+                // leaves the bit stream byte aligned, so what follows can reference the primed data but is otherwise independent of it.
+                const uint dict_size = static_cast<uint>(math::minimum<uint64_t>(TDEFL_LZ_DICT_SIZE, block_ofs));
+                success = (tdefl_compress_buffer(pComp, pBlock - dict_size, dict_size, TDEFL_SYNC_FLUSH) == TDEFL_STATUS_OKAY);
+                comp_data.resize(0);
+            }
+
+            if (success)
+            {
+                tdefl_status status = tdefl_compress_buffer(pComp, pBlock, static_cast<size_t>(block_size), last_block ? TDEFL_FINISH : TDEFL_SYNC_FLUSH);
+                success = last_block ? (status == TDEFL_STATUS_DONE) : (status == TDEFL_STATUS_OKAY);
+            }
+
+            vogl_free(pComp);
+
+            if (!success)
+                state.m_failed[block_index] = true;
+        }
+
+        bool deflate(uint8_vec &comp_data, const void *pSrc, size_t src_size, int level, uint flags, block_index *pIndex, mz_uint32 *pCRC32)
+        {
+            comp_data.clear();
+            if (pIndex)
+                pIndex->clear();
+
+            if ((!pSrc) && (src_size))
+                return false;
+
+            deflate_state state;
+            state.m_pSrc = static_cast<const uint8 *>(pSrc);
+            state.m_src_size = src_size;
+            state.m_block_size = get_block_size(src_size);
+            state.m_num_blocks = static_cast<uint>(math::maximum<uint64_t>(1U, (state.m_src_size + state.m_block_size - 1) / state.m_block_size));
+            // Raw deflate, the zlib header and trailer are written here.
+            state.m_comp_flags = tdefl_create_comp_flags_from_zip_params(level, -MZ_DEFAULT_WINDOW_BITS, MZ_DEFAULT_STRATEGY);
+            state.m_prime_dictionary = (flags & cFlagPrimeDictionary) != 0;
+            state.m_compute_adler32 = (flags & cFlagZlibStream) != 0;
+            state.m_compute_crc32 = (pCRC32 != NULL);
+
+            state.m_comp_data.resize(state.m_num_blocks);
+            state.m_adler32.resize(state.m_num_blocks);
+            state.m_crc32.resize(state.m_num_blocks);
+            state.m_failed.resize(state.m_num_blocks);
+
+            process_blocks(state.m_num_blocks, deflate_block, &state);
+
+            uint64_t total_comp_size = (flags & cFlagZlibStream) ? 6 : 0;
+            for (uint i = 0; i < state.m_num_blocks; i++)
+            {
+                if (state.m_failed[i])
+                    return false;
+                total_comp_size += state.m_comp_data[i].size();
+            }
+
+            if (total_comp_size > cUINT32_MAX / 2)
+                return false;
+
+            comp_data.reserve(static_cast<uint>(total_comp_size));
+
+            if (flags & cFlagZlibStream)
+            {
+                // Same header tdefl writes: deflate, 32KB window, no preset dictionary.
+                comp_data.push_back(0x78);
+                comp_data.push_back(0x01);
+            }
+
+            mz_uint32 adler32 = MZ_ADLER32_INIT;
+            mz_uint32 crc32 = MZ_CRC32_INIT;
+
+            if (pIndex)
+            {
+                pIndex->m_block_size = state.m_block_size;
+                pIndex->m_primed = state.m_prime_dictionary;
+                pIndex->m_comp_sizes.resize(state.m_num_blocks);
+            }
+
+            for (uint i = 0; i < state.m_num_blocks; i++)
+            {
+                const uint8_vec &block_comp_data = state.m_comp_data[i];
+                comp_data.append(block_comp_data);
+
+                if (pIndex)
+                    pIndex->m_comp_sizes[i] = block_comp_data.size();
+
+                const uint64_t block_size = math::minimum(state.m_block_size, state.m_src_size - i * state.m_block_size);
+                adler32 = i ? adler32_combine(adler32, state.m_adler32[i], block_size) : state.m_adler32[i];
+                crc32 = i ? crc32_combine(crc32, state.m_crc32[i], block_size) : state.m_crc32[i];
+            }
+
+            if (flags & cFlagZlibStream)
+            {
+                for (uint i = 0; i < 4; i++)
+                    comp_data.push_back(static_cast<uint8>(adler32 >> (24 - i * 8)));
+            }
+
+            if (pCRC32)
+                *pCRC32 = crc32;
+
+            return true;
+        }
+
+        struct inflate_state
+        {
+            uint8 *m_pDst;
+            uint64_t m_dst_size;
+            const uint8 *m_pSrc;
+            uint64_t m_block_size;
+            uint m_num_blocks;
+            bool m_compute_adler32;
+            bool m_compute_crc32;
+
+            vogl::vector<uint64_t> m_comp_ofs;
+            vogl::vector<uint64_t> m_comp_sizes;
+            vogl::vector<mz_uint32> m_adler32;
+            vogl::vector<mz_uint32> m_crc32;
+            vogl::vector<uint8> m_failed;
+        };
+
+        static void inflate_block(uint block_index, void *pContext)
+        {
+            inflate_state &state = *static_cast<inflate_state *>(pContext);
+
+            const uint64_t block_ofs = block_index * state.m_block_size;
+            const uint64_t block_size = math::minimum(state.m_block_size, state.m_dst_size - block_ofs);
+            const bool last_block = (block_index == (state.m_num_blocks - 1));
+            uint8 *pBlock = state.m_pDst + block_ofs;
+
+            tinfl_decompressor *pDecomp = static_cast<tinfl_decompressor *>(vogl_malloc(sizeof(tinfl_decompressor)));
+            if (!pDecomp)
+            {
+                state.m_failed[block_index] = true;
+                return;
+            }
+
+            tinfl_init(pDecomp);
+
+            // Blocks before the last one end with a sync flush, so they never reach a final block.
+            size_t in_size = static_cast<size_t>(state.m_comp_sizes[block_index]);
+            size_t out_size = static_cast<size_t>(block_size);
+            tinfl_status status = tinfl_decompress(pDecomp, state.m_pSrc + state.m_comp_ofs[block_index], &in_size, pBlock, pBlock, &out_size,
+                                                   TINFL_FLAG_USING_NON_WRAPPING_OUTPUT_BUF | (last_block ? 0 : TINFL_FLAG_HAS_MORE_INPUT));
+
+            vogl_free(pDecomp);
+
+            if ((status != (last_block ? TINFL_STATUS_DONE : TINFL_STATUS_NEEDS_MORE_INPUT)) || (in_size != state.m_comp_sizes[block_index]) || (out_size != block_size))
+            {
+                state.m_failed[block_index] = true;
+                return;
+            }
+
+            if (state.m_compute_adler32)
+                state.m_adler32[block_index] = static_cast<mz_uint32>(mz_adler32(MZ_ADLER32_INIT, pBlock, out_size));
+            if (state.m_compute_crc32)
+                state.m_crc32[block_index] = static_cast<mz_uint32>(mz_crc32(MZ_CRC32_INIT, pBlock, out_size));
+        }
+
+        static bool inflate_serial(void *pDst, size_t dst_size, const void *pSrc, size_t src_size, uint flags, mz_uint32 *pCRC32)
+        {
+            tinfl_decompressor *pDecomp = static_cast<tinfl_decompressor *>(vogl_malloc(sizeof(tinfl_decompressor)));
+            if (!pDecomp)
+                return false;
+
+            tinfl_init(pDecomp);
+
+            size_t in_size = src_size;
+            size_t out_size = dst_size;
+            tinfl_status status = tinfl_decompress(pDecomp, static_cast<const mz_uint8 *>(pSrc), &in_size, static_cast<mz_uint8 *>(pDst), static_cast<mz_uint8 *>(pDst), &out_size,
+                                                   TINFL_FLAG_USING_NON_WRAPPING_OUTPUT_BUF | ((flags & cFlagZlibStream) ? TINFL_FLAG_PARSE_ZLIB_HEADER : 0));
+
+            vogl_free(pDecomp);
+
+            if ((status != TINFL_STATUS_DONE) || (out_size != dst_size))
+                return false;
+
+            if (pCRC32)
+                *pCRC32 = static_cast<mz_uint32>(mz_crc32(MZ_CRC32_INIT, static_cast<const mz_uint8 *>(pDst), dst_size));
+
+            return true;
+        }
+
+        bool inflate(void *pDst, size_t dst_size, const void *pSrc, size_t src_size, uint flags, const block_index *pIndex, mz_uint32 *pCRC32)
+        {
+            if (((!pDst) && (dst_size)) || (!pSrc))
+                return false;
+
+            if ((!pIndex) || (pIndex->m_primed) || (pIndex->m_comp_sizes.size() < 2))
+                return inflate_serial(pDst, dst_size, pSrc, src_size, flags, pCRC32);
+
+            const bool zlib_stream = (flags & cFlagZlibStream) != 0;
+
+            inflate_state state;
+            state.m_pDst = static_cast<uint8 *>(pDst);
+            state.m_dst_size = dst_size;
+            state.m_pSrc = static_cast<const uint8 *>(pSrc);
+            state.m_block_size = pIndex->m_block_size;
+            state.m_num_blocks = pIndex->m_comp_sizes.size();
+            state.m_compute_adler32 = zlib_stream;
+            state.m_compute_crc32 = (pCRC32 != NULL);
+
+            // The index must describe exactly dst_size bytes.
+            if ((!state.m_block_size) || (((dst_size + state.m_block_size - 1) / state.m_block_size) != state.m_num_blocks))
+                return false;
+
+            uint64_t comp_ofs = 0;
+            if (zlib_stream)
+            {
+                const uint8 *pHeader = state.m_pSrc;
+                if ((src_size < 6) || ((pHeader[0] & 0xF) != MZ_DEFLATED) || ((pHeader[1] & 0x20) != 0) || (((pHeader[0] << 8U) | pHeader[1]) % 31U))
+                    return false;
+                comp_ofs = 2;
+            }
+
+            state.m_comp_ofs.resize(state.m_num_blocks);
+            state.m_comp_sizes = pIndex->m_comp_sizes;
+            for (uint i = 0; i < state.m_num_blocks; i++)
+            {
+                state.m_comp_ofs[i] = comp_ofs;
+                comp_ofs += state.m_comp_sizes[i];
+            }
+
+            if (comp_ofs + (zlib_stream ? 4 : 0) > src_size)
+                return false;
+
+            state.m_adler32.resize(state.m_num_blocks);
+            state.m_crc32.resize(state.m_num_blocks);
+            state.m_failed.resize(state.m_num_blocks);
+
+            process_blocks(state.m_num_blocks, inflate_block, &state);
+
+            mz_uint32 adler32 = MZ_ADLER32_INIT;
+            mz_uint32 crc32 = MZ_CRC32_INIT;
+            for (uint i = 0; i < state.m_num_blocks; i++)
+            {
+                if (state.m_failed[i])
+                    return false;
+
+                const uint64_t block_size = math::minimum(state.m_block_size, state.m_dst_size - i * state.m_block_size);
+                adler32 = i ? adler32_combine(adler32, state.m_adler32[i], block_size) : state.m_adler32[i];
+                crc32 = i ? crc32_combine(crc32, state.m_crc32[i], block_size) : state.m_crc32[i];
+            }
+
+            if (zlib_stream)
+            {
+                const uint8 *pTrailer = state.m_pSrc + comp_ofs;
+                mz_uint32 stream_adler32 = (pTrailer[0] << 24U) | (pTrailer[1] << 16U) | (pTrailer[2] << 8U) | pTrailer[3];
+                if (stream_adler32 != adler32)
+                    return false;
+            }
+
+            if (pCRC32)
+                *pCRC32 = crc32;
+
+            return true;
+        }
+
+    } // namespace mz_parallel
+
+    bool mz_parallel_test()
+    {
+#define CHECK(x)                \
+    do                          \
+    {                           \
+        if (!(x))               \
+        {                       \
+            VOGL_ASSERT_ALWAYS; \
+            return false;       \
+        }                       \
+    } while (0)
+
+        if (g_number_of_processors <= 1)
+            vogl_threading_init();
+
+        random r;
+        r.seed(1000);
+
+        // Checksum combining
+        uint8_vec buf(100000);
+        for (uint i = 0; i < buf.size(); i++)
+            buf[i] = static_cast<uint8>(r.urand32());
+
+        for (uint t = 0; t < 100; t++)
+        {
+            uint split = r.irand_inclusive(0, buf.size());
+            const mz_uint8 *p = buf.get_ptr();
+
+            mz_uint32 whole_adler = static_cast<mz_uint32>(mz_adler32(MZ_ADLER32_INIT, p, buf.size()));
+            mz_uint32 whole_crc = static_cast<mz_uint32>(mz_crc32(MZ_CRC32_INIT, p, buf.size()));
+
+            mz_uint32 adler1 = static_cast<mz_uint32>(mz_adler32(MZ_ADLER32_INIT, p, split));
+            mz_uint32 adler2 = static_cast<mz_uint32>(mz_adler32(MZ_ADLER32_INIT, p + split, buf.size() - split));
+            mz_uint32 crc1 = static_cast<mz_uint32>(mz_crc32(MZ_CRC32_INIT, p, split));
+            mz_uint32 crc2 = static_cast<mz_uint32>(mz_crc32(MZ_CRC32_INIT, p + split, buf.size() - split));
+
+            CHECK(mz_parallel::adler32_combine(adler1, adler2, buf.size() - split) == whole_adler);
+            CHECK(mz_parallel::crc32_combine(crc1, crc2, buf.size() - split) == whole_crc);
+        }
+
+        // Round trips, with somewhat compressible data which spans several blocks.
+        static const uint s_sizes[] = { 0, 1, 1000, mz_parallel::cMinBlockSize * 2 - 1, mz_parallel::cMinBlockSize * 5 + 12345 };
+        for (uint size_index = 0; size_index < VOGL_ARRAY_SIZE(s_sizes); size_index++)
+        {
+            const uint size = s_sizes[size_index];
+
+            uint8_vec src(size);
+            for (uint i = 0; i < size; i++)
+                src[i] = (r.irand(0, 8) == 0) ? static_cast<uint8>(r.urand32()) : static_cast<uint8>((i / 7) ^ (i >> 13));
+
+            const mz_uint32 expected_crc32 = static_cast<mz_uint32>(mz_crc32(MZ_CRC32_INIT, src.get_ptr(), size));
+
+            for (uint flags = 0; flags < 4; flags++)
+            {
+                const int level = (flags & 1) ? MZ_BEST_SPEED : MZ_DEFAULT_LEVEL;
+
+                uint8_vec comp_data;
+                mz_parallel::block_index index;
+                mz_uint32 comp_crc32 = 0;
+                CHECK(mz_parallel::deflate(comp_data, src.get_ptr(), size, level, flags, &index, &comp_crc32));
+                CHECK(comp_crc32 == expected_crc32);
+
+                dynamic_string index_str;
+                mz_parallel::block_index index2;
+                CHECK(index2.deserialize(index.serialize(index_str).get_ptr()));
+                CHECK((index2.m_block_size == index.m_block_size) && (index2.m_primed == index.m_primed) && (index2.m_comp_sizes == index.m_comp_sizes));
+                CHECK(index_str.get_len() < MZ_ZIP_MAX_ARCHIVE_FILE_COMMENT_SIZE);
+
+                // The stream must be readable by a plain inflater.
+                uint8_vec dst(size + 1);
+                size_t dst_size = tinfl_decompress_mem_to_mem(dst.get_ptr(), dst.size(), comp_data.get_ptr(), comp_data.size(), (flags & mz_parallel::cFlagZlibStream) ? TINFL_FLAG_PARSE_ZLIB_HEADER : 0);
+                CHECK(dst_size == size);
+                CHECK(!size || !memcmp(dst.get_ptr(), src.get_ptr(), size));
+
+                if (flags & mz_parallel::cFlagZlibStream)
+                {
+                    mz_ulong zlib_dst_size = dst.size();
+                    CHECK(mz_uncompress(dst.get_ptr(), &zlib_dst_size, comp_data.get_ptr(), comp_data.size()) == MZ_OK);
+                    CHECK(zlib_dst_size == size);
+                }
+
+                // Indexed (parallel for independent blocks) and serial inflate
+                for (uint use_index = 0; use_index < 2; use_index++)
+                {
+                    dst.resize(0);
+                    dst.resize(size);
+
+                    mz_uint32 decomp_crc32 = 0;
+                    CHECK(mz_parallel::inflate(dst.get_ptr(), size, comp_data.get_ptr(), comp_data.size(), flags, use_index ? &index2 : NULL, &decomp_crc32));
+                    CHECK(decomp_crc32 == expected_crc32);
+                    CHECK(dst == src);
+                }
+
+                // Corrupted data should be caught (or at least not crash).
+                if (comp_data.size() > 16)
+                {
+                    comp_data[comp_data.size() / 2] ^= 0x55;
+                    dst.resize(size);
+                    mz_uint32 decomp_crc32 = 0;
+                    if (mz_parallel::inflate(dst.get_ptr(), size, comp_data.get_ptr(), comp_data.size(), flags, &index2, &decomp_crc32))
+                        CHECK((decomp_crc32 != expected_crc32) || (dst == src));
+                }
+            }
+        }
+
+#undef CHECK
+        return true;
+    }
+
+} // namespace vogl
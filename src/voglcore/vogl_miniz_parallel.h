@@ -0,0 +1,111 @@
+/**************************************************************************
+ *
+ * Copyright 2013-2014 RAD Game Tools and Valve Software
+ * Copyright 2010-2014 Rich Geldreich and Tenacious Software LLC
+ * All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ **************************************************************************/
+
+// File: vogl_miniz_parallel.h
+#pragma once
+
+#include "vogl_core.h"
+#include "vogl_miniz.h"
+#include "vogl_dynamic_string.h"
+
+namespace vogl
+{
+    // Block-parallel deflate/inflate for large buffers.
+    // The input is split into fixed size blocks which are deflated concurrently. Every block but the last ends with a sync flush (an empty
+    // stored block), so the block outputs are byte aligned and can simply be concatenated into a single standard raw deflate or zlib
+    // stream, which any inflater can read.
+    // If the block boundaries are kept (see mz_parallel::block_index) and the blocks were compressed independently, the stream can also be
+    // inflated in parallel. Blocks primed with the previous block's dictionary compress slightly better, but can only be inflated serially.
+    namespace mz_parallel
+    {
+        enum
+        {
+            // Blocks are never smaller than this. Buffers under 2 blocks are compressed as a single block on the calling thread.
+            cMinBlockSize = 1024 * 1024,
+
+            // Larger buffers use larger blocks, so the block index stays small enough to fit into a zip file comment.
+            cMaxBlocks = 32
+        };
+
+        enum flags
+        {
+            // Write a zlib header and adler-32 trailer, otherwise the stream is raw deflate.
+            cFlagZlibStream = 1,
+
+            // Prime each block's dictionary with the end of the previous block. Better ratio, but the stream can only be inflated serially.
+            cFlagPrimeDictionary = 2
+        };
+
+        class block_index
+        {
+        public:
+            block_index()
+                : m_block_size(0),
+                  m_primed(false)
+            {
+            }
+
+            void clear()
+            {
+                m_block_size = 0;
+                m_primed = false;
+                m_comp_sizes.clear();
+            }
+
+            // Uncompressed size of every block but the last.
+            uint64_t m_block_size;
+
+            // true if the blocks were compressed with cFlagPrimeDictionary.
+            bool m_primed;
+
+            // Compressed size of each block. The first block's doesn't include the zlib header, the last block's doesn't include the trailer.
+            vogl::vector<uint64_t> m_comp_sizes;
+
+            // Compact text form, for storing the index alongside the compressed data (in a zip file comment, for example).
+            dynamic_string &serialize(dynamic_string &str) const;
+            bool deserialize(const char *pStr);
+        };
+
+        // Returns the block size deflate() uses for a buffer of the specified size.
+        uint64_t get_block_size(uint64_t src_size);
+
+        // Compresses pSrc into comp_data. level is a zlib style compression level (MZ_BEST_SPEED, etc.).
+        // Optionally returns the block boundaries and the CRC-32 of the uncompressed data (computed in parallel, for zip archives).
+        bool deflate(uint8_vec &comp_data, const void *pSrc, size_t src_size, int level, uint flags, block_index *pIndex = NULL, mz_uint32 *pCRC32 = NULL);
+
+        // Decompresses a stream written by deflate() (or any other deflate/zlib stream, if pIndex is NULL) into exactly dst_size bytes.
+        // Independent blocks are inflated in parallel if pIndex is supplied, otherwise the stream is inflated serially.
+        bool inflate(void *pDst, size_t dst_size, const void *pSrc, size_t src_size, uint flags, const block_index *pIndex = NULL, mz_uint32 *pCRC32 = NULL);
+
+        // Checksums of the concatenation of two buffers, given the checksums of each buffer and the size of the second.
+        mz_uint32 adler32_combine(mz_uint32 adler1, mz_uint32 adler2, uint64_t len2);
+        mz_uint32 crc32_combine(mz_uint32 crc1, mz_uint32 crc2, uint64_t len2);
+
+    } // namespace mz_parallel
+
+    bool mz_parallel_test();
+
+} // namespace vogl
@@ -0,0 +1,126 @@
+/**************************************************************************
+ *
+ * Copyright 2013-2014 RAD Game Tools and Valve Software
+ * Copyright 2010-2014 Rich Geldreich and Tenacious Software LLC
+ * All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ **************************************************************************/
+
+// File: vogl_parallel_sort.cpp
+#include "vogl_core.h"
+#include "vogl_parallel_sort.h"
+#include "vogl_rand.h"
+
+namespace vogl
+{
+    struct parallel_sort_test_struct
+    {
+        uint m_key;
+        uint m_index;
+
+        bool operator<(const parallel_sort_test_struct &rhs) const
+        {
+            return m_key < rhs.m_key;
+        }
+    };
+
+    bool parallel_sort_test()
+    {
+        task_pool tp;
+        if (!tp.init(math::clamp<uint>(g_number_of_processors, 2, task_pool::cMaxThreads) - 1))
+            return false;
+
+        random rnd;
+        rnd.seed(1000);
+
+        for (uint t = 0; t < 40; t++)
+        {
+            uint n = (t < 4) ? rnd.irand_inclusive(0, 1000) : rnd.irand_inclusive(0, 300000);
+            uint key_size = rnd.irand_inclusive(1, 4);
+
+            // Lots of duplicate keys, and sometimes all keys identical, so pass skipping and stability both get exercised.
+            uint k = static_cast<uint>((1ULL << rnd.irand_inclusive(0, 32)) - 1ULL);
+
+            vogl::vector<parallel_sort_test_struct> x(n);
+            for (uint i = 0; i < n; i++)
+            {
+                x[i].m_key = rnd.urand32() & k;
+                x[i].m_index = i;
+            }
+
+            // Direct radix sort must match the single threaded sort exactly.
+            vogl::vector<parallel_sort_test_struct> a0(x), a1(n), b0(x), b1(n);
+
+            parallel_sort_test_struct *pSerial = radix_sort(n, a0.get_ptr(), a1.get_ptr(), 0, key_size);
+            parallel_sort_test_struct *pParallel = parallel_radix_sort(tp, n, b0.get_ptr(), b1.get_ptr(), 0, key_size);
+
+            for (uint i = 0; i < n; i++)
+            {
+                if ((pSerial[i].m_key != pParallel[i].m_key) || (pSerial[i].m_index != pParallel[i].m_index))
+                    return false;
+            }
+
+            // Indirect radix sort
+            vogl::vector<uint> i0(n), i1(n), j0(n), j1(n);
+
+            uint *pSerial_indices = indirect_radix_sort(n, i0.get_ptr(), i1.get_ptr(), x.get_ptr(), 0, key_size, true);
+            uint *pParallel_indices = parallel_indirect_radix_sort(tp, n, j0.get_ptr(), j1.get_ptr(), x.get_ptr(), 0, key_size, true);
+
+            if ((n) && (memcmp(pSerial_indices, pParallel_indices, n * sizeof(uint)) != 0))
+                return false;
+
+            // Merge sort stability
+            vogl::vector<parallel_sort_test_struct> y(x);
+            parallel_mergesort(tp, y);
+
+            if (y.size() != n)
+                return false;
+
+            for (uint i = 1; i < n; i++)
+            {
+                if (y[i - 1].m_key > y[i].m_key)
+                    return false;
+                if ((y[i - 1].m_key == y[i].m_key) && (y[i - 1].m_index >= y[i].m_index))
+                    return false;
+            }
+
+            // Merge sort of a type that's swapped, not copied, during merging
+            if (n <= 100000)
+            {
+                dynamic_string_array sx(n);
+                for (uint i = 0; i < n; i++)
+                    sx[i].format("%u", x[i].m_key);
+
+                dynamic_string_array sy(sx);
+                vogl::mergesort(sx);
+                parallel_mergesort(tp, sy);
+
+                if (sx != sy)
+                    return false;
+            }
+        }
+
+        tp.deinit();
+
+        return true;
+    }
+
+} // namespace vogl
@@ -0,0 +1,457 @@
+/**************************************************************************
+ *
+ * Copyright 2013-2014 RAD Game Tools and Valve Software
+ * Copyright 2010-2014 Rich Geldreich and Tenacious Software LLC
+ * All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ **************************************************************************/
+
+// File: vogl_parallel_sort.h
+// Multithreaded versions of radix_sort(), indirect_radix_sort() and mergesort(), using a caller supplied task_pool.
+// Both are stable, and produce exactly the same order as their single threaded counterparts.
+//
+// Radix sort: each LSD pass splits the array into one chunk per thread (plus one for the joining caller). Each chunk is
+// histogrammed in parallel, the per-chunk histograms are prefix summed into per-chunk output offsets (chunk order within
+// each digit keeps the sort stable), then each chunk scatters in parallel. Passes where every key has the same digit are skipped.
+//
+// Merge sort: the array is split into one run per task, the runs are sorted in parallel with mergesort(), then merged
+// pairwise in parallel rounds.
+//
+// Small arrays, pools without any threads, or pools that fail to queue a task, fall back to the single threaded sorts.
+//
+// The histogram and scatter loops are scalar (2x unrolled, like vogl_radix_sort.h). Each key is fetched through a key
+// functor, which for the indirect sort is a dependent load through the index, and each count or store goes to an address
+// picked by the key's digit. SSE2 has no gather or scatter instructions to vectorize either of those.
+#pragma once
+
+#include "vogl_core.h"
+#include "vogl_threading.h"
+#include "vogl_radix_sort.h"
+#include "vogl_mergesort.h"
+
+namespace vogl
+{
+    enum
+    {
+        cParallelRadixSortMinVals = 64 * 1024,
+        cParallelMergeSortMinElems = 16 * 1024
+    };
+
+    namespace detail
+    {
+        template <typename T>
+        struct radix_sort_direct_key
+        {
+            uint m_key_ofs;
+
+            inline uint operator()(const T &val) const
+            {
+                return *(const uint *)((const uint8 *)(&val) + m_key_ofs);
+            }
+        };
+
+        template <typename T, typename Q>
+        struct radix_sort_indirect_key
+        {
+            const Q *m_pKeys;
+            uint m_key_ofs;
+
+            inline uint operator()(const T &index) const
+            {
+                return *(const uint *)((const uint8 *)(m_pKeys + index) + m_key_ofs);
+            }
+        };
+
+        template <typename T, typename KeyFunc>
+        class parallel_radix_sorter
+        {
+        public:
+            parallel_radix_sorter(task_pool &tp, const KeyFunc &key_func)
+                : m_pTask_pool(&tp),
+                  m_key_func(key_func),
+                  m_num_vals(0),
+                  m_num_chunks(0),
+                  m_pass_shift(0),
+                  m_pCur(NULL),
+                  m_pNew(NULL)
+            {
+            }
+
+            // Returns pointer to sorted array, or NULL if the task pool couldn't queue the tasks. In that case get_cur_buf()
+            // holds the values partially sorted by the finished passes, which is a valid input for the serial radix sorts.
+            T *sort(uint num_vals, T *pBuf0, T *pBuf1, uint key_size)
+            {
+                m_num_vals = num_vals;
+                m_num_chunks = math::minimum<uint>(m_pTask_pool->get_num_threads() + 1, num_vals);
+                m_pCur = pBuf0;
+                m_pNew = pBuf1;
+
+                m_hist.resize(m_num_chunks * 256);
+                m_offsets.resize(m_num_chunks * 256);
+
+                for (uint pass = 0; pass < key_size; pass++)
+                {
+                    m_pass_shift = pass << 3;
+
+                    bool queued = m_pTask_pool->queue_multiple_object_tasks(this, &parallel_radix_sorter::histogram_task, 0, m_num_chunks);
+                    m_pTask_pool->join();
+                    if (!queued)
+                        return NULL;
+
+                    if (!compute_offsets())
+                        continue;
+
+                    queued = m_pTask_pool->queue_multiple_object_tasks(this, &parallel_radix_sorter::scatter_task, 0, m_num_chunks);
+                    m_pTask_pool->join();
+                    if (!queued)
+                        return NULL;
+
+                    std::swap(m_pCur, m_pNew);
+                }
+
+                return m_pCur;
+            }
+
+            T *get_cur_buf() const
+            {
+                return m_pCur;
+            }
+            T *get_new_buf() const
+            {
+                return m_pNew;
+            }
+
+        private:
+            task_pool *m_pTask_pool;
+            KeyFunc m_key_func;
+
+            uint m_num_vals;
+            uint m_num_chunks;
+            uint m_pass_shift;
+
+            T *m_pCur;
+            T *m_pNew;
+
+            // 256 counts/offsets per chunk
+            vogl::vector<uint> m_hist;
+            vogl::vector<uint> m_offsets;
+
+            inline uint get_chunk_start(uint chunk_index) const
+            {
+                return static_cast<uint>((static_cast<uint64_t>(m_num_vals) * chunk_index) / m_num_chunks);
+            }
+
+            void histogram_task(uint64_t data, void *pData_ptr)
+            {
+                VOGL_NOTE_UNUSED(pData_ptr);
+
+                const uint chunk_index = static_cast<uint>(data);
+
+                uint *pHist = &m_hist[chunk_index * 256];
+                memset(pHist, 0, sizeof(uint) * 256);
+
+                const uint pass_shift = m_pass_shift;
+
+                const T *p = m_pCur + get_chunk_start(chunk_index);
+                const T *q = m_pCur + get_chunk_start(chunk_index + 1);
+
+                for (; (q - p) >= 2; p += 2)
+                {
+                    pHist[(m_key_func(p[0]) >> pass_shift) & 0xFF]++;
+                    pHist[(m_key_func(p[1]) >> pass_shift) & 0xFF]++;
+                }
+
+                if (p != q)
+                    pHist[(m_key_func(*p) >> pass_shift) & 0xFF]++;
+            }
+
+            // Returns false if the pass can be skipped because all keys have the same digit.
+            bool compute_offsets()
+            {
+                uint cur_ofs = 0;
+
+                for (uint digit = 0; digit < 256; digit++)
+                {
+                    const uint digit_start = cur_ofs;
+
+                    for (uint chunk_index = 0; chunk_index < m_num_chunks; chunk_index++)
+                    {
+                        m_offsets[chunk_index * 256 + digit] = cur_ofs;
+                        cur_ofs += m_hist[chunk_index * 256 + digit];
+                    }
+
+                    if ((cur_ofs - digit_start) == m_num_vals)
+                        return false;
+                }
+
+                VOGL_ASSERT(cur_ofs == m_num_vals);
+
+                return true;
+            }
+
+            void scatter_task(uint64_t data, void *pData_ptr)
+            {
+                VOGL_NOTE_UNUSED(pData_ptr);
+
+                const uint chunk_index = static_cast<uint>(data);
+
+                uint offsets[256];
+                memcpy(offsets, &m_offsets[chunk_index * 256], sizeof(offsets));
+
+                const uint pass_shift = m_pass_shift;
+                T *pNew = m_pNew;
+
+                const T *p = m_pCur + get_chunk_start(chunk_index);
+                const T *q = m_pCur + get_chunk_start(chunk_index + 1);
+
+                for (; (q - p) >= 2; p += 2)
+                {
+                    uint c0 = (m_key_func(p[0]) >> pass_shift) & 0xFF;
+                    uint c1 = (m_key_func(p[1]) >> pass_shift) & 0xFF;
+
+                    if (c0 == c1)
+                    {
+                        uint dst_offset0 = offsets[c0];
+
+                        offsets[c0] = dst_offset0 + 2;
+
+                        pNew[dst_offset0] = p[0];
+                        pNew[dst_offset0 + 1] = p[1];
+                    }
+                    else
+                    {
+                        uint dst_offset0 = offsets[c0]++;
+                        uint dst_offset1 = offsets[c1]++;
+
+                        pNew[dst_offset0] = p[0];
+                        pNew[dst_offset1] = p[1];
+                    }
+                }
+
+                if (p != q)
+                {
+                    uint c = (m_key_func(*p) >> pass_shift) & 0xFF;
+                    pNew[offsets[c]] = *p;
+                }
+            }
+        };
+
+        template <typename T, typename Comparator>
+        class parallel_merge_sorter
+        {
+        public:
+            parallel_merge_sorter(task_pool &tp, Comparator comp)
+                : m_pTask_pool(&tp),
+                  m_comp(comp)
+            {
+            }
+
+            void sort(vogl::vector<T> &elems)
+            {
+                const uint n = elems.size();
+                const uint num_runs = math::minimum<uint>(m_pTask_pool->get_num_threads() + 1, n);
+
+                m_runs.resize(num_runs);
+
+                uint cur_elem = 0;
+                for (uint run_index = 0; run_index < num_runs; run_index++)
+                {
+                    const uint run_end = static_cast<uint>((static_cast<uint64_t>(n) * (run_index + 1)) / num_runs);
+
+                    vogl::vector<T> &run = m_runs[run_index];
+                    run.resize(run_end - cur_elem);
+
+                    for (uint i = 0; i < run.size(); i++)
+                        transfer(run[i], elems[cur_elem + i]);
+
+                    cur_elem = run_end;
+                }
+
+                bool queued = m_pTask_pool->queue_multiple_object_tasks(this, &parallel_merge_sorter::sort_task, 0, num_runs);
+                m_pTask_pool->join();
+                if (!queued)
+                {
+                    serial_sort(elems);
+                    return;
+                }
+
+                while (m_runs.size() > 1)
+                {
+                    const uint num_merges = m_runs.size() / 2;
+
+                    queued = m_pTask_pool->queue_multiple_object_tasks(this, &parallel_merge_sorter::merge_task, 0, num_merges);
+                    m_pTask_pool->join();
+                    if (!queued)
+                    {
+                        serial_sort(elems);
+                        return;
+                    }
+
+                    // Merged runs landed in the even slots, an odd run out is carried over unchanged.
+                    for (uint i = 1; i < (m_runs.size() + 1) / 2; i++)
+                        m_runs[i].swap(m_runs[i * 2]);
+
+                    m_runs.resize((m_runs.size() + 1) / 2);
+                }
+
+                elems.swap(m_runs[0]);
+                m_runs.clear();
+            }
+
+        private:
+            task_pool *m_pTask_pool;
+            Comparator m_comp;
+
+            vogl::vector<vogl::vector<T> > m_runs;
+
+            static inline void transfer(T &dst, T &src)
+            {
+                if (mergesort_use_swaps_during_merge<T>::cFlag)
+                    std::swap(dst, src);
+                else
+                    dst = src;
+            }
+
+            // Called after the task pool failed to queue a task. Whichever tasks did run only reordered elements within a
+            // run, or merged neighbouring runs in order, so concatenating the runs and merge sorting them is still stable.
+            void serial_sort(vogl::vector<T> &elems)
+            {
+                uint cur_elem = 0;
+                for (uint run_index = 0; run_index < m_runs.size(); run_index++)
+                {
+                    vogl::vector<T> &run = m_runs[run_index];
+                    for (uint i = 0; i < run.size(); i++)
+                        transfer(elems[cur_elem++], run[i]);
+                }
+                VOGL_ASSERT(cur_elem == elems.size());
+
+                m_runs.clear();
+
+                mergesort(elems, m_comp);
+            }
+
+            void sort_task(uint64_t data, void *pData_ptr)
+            {
+                VOGL_NOTE_UNUSED(pData_ptr);
+
+                mergesort(m_runs[static_cast<uint>(data)], m_comp);
+            }
+
+            // Merges runs data*2 and data*2+1 into run data*2. Items from the left run go first when equal, so the merge is stable.
+            void merge_task(uint64_t data, void *pData_ptr)
+            {
+                VOGL_NOTE_UNUSED(pData_ptr);
+
+                vogl::vector<T> &a = m_runs[static_cast<uint>(data) * 2];
+                vogl::vector<T> &b = m_runs[static_cast<uint>(data) * 2 + 1];
+
+                vogl::vector<T> merged(a.size() + b.size());
+
+                uint i0 = 0, i1 = 0, j = 0;
+                while ((i0 < a.size()) && (i1 < b.size()))
+                {
+                    if (m_comp(b[i1], a[i0]))
+                        transfer(merged[j++], b[i1++]);
+                    else
+                        transfer(merged[j++], a[i0++]);
+                }
+
+                while (i0 < a.size())
+                    transfer(merged[j++], a[i0++]);
+                while (i1 < b.size())
+                    transfer(merged[j++], b[i1++]);
+
+                a.swap(merged);
+                b.clear();
+            }
+        };
+
+    } // namespace detail
+
+    // Returns pointer to sorted array (either pBuf0 or pBuf1). Same requirements as radix_sort().
+    template <typename T>
+    T *parallel_radix_sort(task_pool &tp, uint num_vals, T *pBuf0, T *pBuf1, uint key_ofs, uint key_size)
+    {
+        VOGL_ASSERT(key_ofs < sizeof(T));
+        VOGL_ASSERT_CLOSED_RANGE(key_size, 1, 4);
+
+        if ((num_vals < cParallelRadixSortMinVals) || (!tp.get_num_threads()))
+            return radix_sort(num_vals, pBuf0, pBuf1, key_ofs, key_size);
+
+        detail::radix_sort_direct_key<T> key_func;
+        key_func.m_key_ofs = key_ofs;
+
+        detail::parallel_radix_sorter<T, detail::radix_sort_direct_key<T> > sorter(tp, key_func);
+        T *pSorted = sorter.sort(num_vals, pBuf0, pBuf1, key_size);
+        if (!pSorted)
+            pSorted = radix_sort(num_vals, sorter.get_cur_buf(), sorter.get_new_buf(), key_ofs, key_size);
+        return pSorted;
+    }
+
+    // Returns pointer to sorted array (either pIndices0 or pIndices1). Same requirements as indirect_radix_sort().
+    template <typename T, typename Q>
+    T *parallel_indirect_radix_sort(task_pool &tp, uint num_indices, T *pIndices0, T *pIndices1, const Q *pKeys, uint key_ofs, uint key_size, bool init_indices)
+    {
+        VOGL_ASSERT(key_ofs < sizeof(T));
+        VOGL_ASSERT_CLOSED_RANGE(key_size, 1, 4);
+
+        if ((num_indices < cParallelRadixSortMinVals) || (!tp.get_num_threads()))
+            return indirect_radix_sort(num_indices, pIndices0, pIndices1, pKeys, key_ofs, key_size, init_indices);
+
+        if (init_indices)
+        {
+            for (uint i = 0; i < num_indices; i++)
+                pIndices0[i] = static_cast<T>(i);
+        }
+
+        detail::radix_sort_indirect_key<T, Q> key_func;
+        key_func.m_pKeys = pKeys;
+        key_func.m_key_ofs = key_ofs;
+
+        detail::parallel_radix_sorter<T, detail::radix_sort_indirect_key<T, Q> > sorter(tp, key_func);
+        T *pSorted = sorter.sort(num_indices, pIndices0, pIndices1, key_size);
+        if (!pSorted)
+            pSorted = indirect_radix_sort(num_indices, sorter.get_cur_buf(), sorter.get_new_buf(), pKeys, key_ofs, key_size, false);
+        return pSorted;
+    }
+
+    template <typename T, typename Comparator>
+    inline void parallel_mergesort(task_pool &tp, vogl::vector<T> &elems, Comparator comp)
+    {
+        if ((elems.size() < cParallelMergeSortMinElems) || (!tp.get_num_threads()))
+        {
+            mergesort(elems, comp);
+            return;
+        }
+
+        detail::parallel_merge_sorter<T, Comparator> sorter(tp, comp);
+        sorter.sort(elems);
+    }
+
+    template <typename T>
+    inline void parallel_mergesort(task_pool &tp, vogl::vector<T> &elems)
+    {
+        parallel_mergesort(tp, elems, std::less<T>());
+    }
+
+    bool parallel_sort_test();
+
+} // namespace vogl
@@ -189,6 +189,26 @@ namespace vogl
             return *this;
         }
 
+#if VOGL_HAS_MOVE_SEMANTICS
+        rh_hash_map(rh_hash_map &&other)
+            : m_hash_shift(32),
+              m_num_valid(0),
+              m_grow_threshold(0)
+        {
+            swap(other);
+        }
+
+        rh_hash_map &operator=(rh_hash_map &&other)
+        {
+            if (this != &other)
+            {
+                clear();
+                swap(other);
+            }
+            return *this;
+        }
+#endif
+
         inline ~rh_hash_map()
         {
             clear();
@@ -664,6 +684,39 @@ namespace vogl
             return true;
         }
 
+#if VOGL_HAS_MOVE_SEMANTICS
+        inline insert_result insert(Key &&k, Value &&v)
+        {
+            return emplace(std::move(k), std::move(v));
+        }
+
+        inline insert_result insert(value_type &&v)
+        {
+            return emplace(std::move(v.first), std::move(v.second));
+        }
+
+        // Like insert(), but the key and value are constructed in place from the supplied arguments (only if the key isn't already present).
+        // k is only moved from if a new key/value is inserted.
+        template <typename K, typename... Args>
+        inline insert_result emplace(K &&k, Args &&... args)
+        {
+            iterator it(find(k));
+            if (it != end())
+                return insert_result(it, false);
+
+            if ((!m_values.size()) || (m_num_valid >= m_grow_threshold))
+                grow();
+
+            hash_entry new_entry;
+            new_entry.m_pValue = m_allocator.alloc_no_construction();
+            helpers::construct_emplace(&new_entry.m_pValue->first, std::forward<K>(k));
+            helpers::construct_emplace(&new_entry.m_pValue->second, std::forward<Args>(args)...);
+            new_entry.m_hash = hash_key(new_entry.m_pValue->first);
+
+            return insert_result(iterator(*this, move_into_container(&new_entry)), true);
+        }
+#endif
+
         inline Value &operator[](const Key &key)
         {
             return (insert(key).first)->second;
@@ -1063,7 +1116,8 @@ namespace vogl
             rehash(math::maximum<uint>(cMinHashSize, m_values.size() * 2U));
         }
 
-        inline void move_into_container(hash_entry *pEntry_to_move)
+        // Inserts an entry whose key isn't already present, returns the index it was placed at.
+        inline uint move_into_container(hash_entry *pEntry_to_move)
         {
             ++m_num_valid;
             VOGL_ASSERT(m_num_valid <= m_values.size());
@@ -1076,6 +1130,8 @@ namespace vogl
 
             const uint size = m_values.size();
 
+            uint result_index = cUINT32_MAX;
+
             uint i;
             for (i = 0; i < size; ++i, ++probe_current)
             {
@@ -1084,6 +1140,9 @@ namespace vogl
 
                 if (!pEntry->m_pValue)
                 {
+                    if (result_index == cUINT32_MAX)
+                        result_index = index_current;
+
                     pEntry->m_pValue = pValue;
                     pEntry->m_hash = hash;
                     break;
@@ -1092,6 +1151,10 @@ namespace vogl
                 uint probe_distance = calc_distance(index_current);
                 if (probe_current > probe_distance)
                 {
+                    // Once placed, the entry being inserted is never displaced again during this call.
+                    if (result_index == cUINT32_MAX)
+                        result_index = index_current;
+
                     value_type *pTemp_value = pEntry->m_pValue;
                     uint temp_hash = pEntry->m_hash;
 
@@ -1106,6 +1169,8 @@ namespace vogl
             }
 
             VOGL_ASSERT(i != size);
+
+            return result_index;
         }
 
         inline void rehash(uint new_hash_size)
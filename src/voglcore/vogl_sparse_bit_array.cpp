@@ -44,7 +44,7 @@ namespace vogl
         resize(size);
     }
 
-    sparse_bit_array::sparse_bit_array(sparse_bit_array &other)
+    sparse_bit_array::sparse_bit_array(const sparse_bit_array &other)
     {
         m_num_groups = other.m_num_groups;
         m_ppGroups = (uint32 **)vogl_malloc(m_num_groups * sizeof(uint32 *));
@@ -67,7 +67,7 @@ namespace vogl
         clear();
     }
 
-    sparse_bit_array &sparse_bit_array::operator=(sparse_bit_array &other)
+    sparse_bit_array &sparse_bit_array::operator=(const sparse_bit_array &other)
     {
         if (this == &other)
             return *this;
@@ -452,12 +452,29 @@ namespace vogl
         return *this;
     }
 
-    int sparse_bit_array::find_first_set_bit(uint index, uint num) const
+    uint sparse_bit_array::count_set_bits() const
+    {
+        uint total = 0;
+
+        for (uint i = 0; i < m_num_groups; i++)
+        {
+            const uint32 *pGroup = m_ppGroups[i];
+            if (!pGroup)
+                continue;
+
+            for (uint j = 0; j < cDWORDsPerGroup; j++)
+                total += math::count_set_bits(pGroup[j]);
+        }
+
+        return total;
+    }
+
+    uint sparse_bit_array::find_first_set_bit(uint index, uint num) const
     {
         VOGL_ASSERT((index + num) <= (m_num_groups << cBitsPerGroupShift));
 
         if (!num)
-            return -1;
+            return cUINT32_MAX;
 
         while ((index & cBitsPerGroupMask) || (num <= cBitsPerGroup))
         {
@@ -479,7 +496,7 @@ namespace vogl
                 if (bits)
                 {
                     uint num_trailing_zeros = math::count_trailing_zero_bits(bits);
-                    int set_index = num_trailing_zeros + (index & ~31);
+                    uint set_index = num_trailing_zeros + (index & ~31);
                     VOGL_ASSERT(get_bit(set_index));
                     return set_index;
                 }
@@ -487,7 +504,7 @@ namespace vogl
 
             num -= bits_to_examine;
             if (!num)
-                return -1;
+                return cUINT32_MAX;
 
             index += bits_to_examine;
         }
@@ -507,7 +524,7 @@ namespace vogl
                     {
                         uint num_trailing_zeros = math::count_trailing_zero_bits(bits);
 
-                        int set_index = num_trailing_zeros + index + (i << 5);
+                        uint set_index = num_trailing_zeros + index + (i << 5);
                         VOGL_ASSERT(get_bit(set_index));
                         return set_index;
                     }
@@ -537,7 +554,7 @@ namespace vogl
                 {
                     uint num_trailing_zeros = math::count_trailing_zero_bits(bits);
 
-                    int set_index = num_trailing_zeros + (index & ~31);
+                    uint set_index = num_trailing_zeros + (index & ~31);
                     VOGL_ASSERT(get_bit(set_index));
                     return set_index;
                 }
@@ -547,7 +564,7 @@ namespace vogl
             index += bits_to_examine;
         }
 
-        return -1;
+        return cUINT32_MAX;
     }
 
 } // namespace vogl
@@ -36,14 +36,14 @@ namespace vogl
     public:
         sparse_bit_array();
         sparse_bit_array(uint size);
-        sparse_bit_array(sparse_bit_array &other);
+        sparse_bit_array(const sparse_bit_array &other);
         ~sparse_bit_array();
 
-        sparse_bit_array &operator=(sparse_bit_array &other);
+        sparse_bit_array &operator=(const sparse_bit_array &other);
 
         void clear();
 
-        inline uint get_size()
+        inline uint get_size() const
         {
             return (m_num_groups << cBitsPerGroupShift);
         }
@@ -171,7 +171,11 @@ namespace vogl
             pGroup[bit_ofs >> 5] = value;
         }
 
-        int find_first_set_bit(uint index, uint num) const;
+        // Returns the index of the first set bit in [index, index + num), or cUINT32_MAX if there isn't one.
+        uint find_first_set_bit(uint index, uint num) const;
+
+        // Total number of set bits, only visits allocated groups.
+        uint count_set_bits() const;
 
         enum
         {
@@ -272,21 +272,8 @@ namespace vogl
     {
         VOGL_ASSERT(pDst);
 
-        // really only 20 digits (plus \0 or 21), but whatever
-        const uint cBufSize = 32;
-        char buf[cBufSize];
-
-        char *p = buf + cBufSize - 1;
-
-        *p-- = '\0';
-
-        do
-        {
-            *p-- = static_cast<uint8>('0' + (value % 10U));
-            value /= 10U;
-        } while (value);
-
-        const size_t total_bytes = (buf + cBufSize - 1) - p;
+        char buf[cMaxNumberStringBufSize];
+        const uint total_bytes = uint64_to_chars(value, buf) + 1;
         if (total_bytes > len)
         {
             if ((pDst) && (len))
@@ -294,8 +281,7 @@ namespace vogl
             return false;
         }
 
-        for (size_t i = 0; i < total_bytes; i++)
-            pDst[i] = p[1 + i];
+        memcpy(pDst, buf, total_bytes);
 
         return true;
     }
@@ -360,30 +346,435 @@ namespace vogl
         return dynamic_string(buf);
     }
 
-    bool int64_to_string(int64_t value, char *pDst, uint len)
+    static const char g_decimal_digit_pairs[] =
+        "00010203040506070809"
+        "10111213141516171819"
+        "20212223242526272829"
+        "30313233343536373839"
+        "40414243444546474849"
+        "50515253545556575859"
+        "60616263646566676869"
+        "70717273747576777879"
+        "80818283848586878889"
+        "90919293949596979899";
+
+    uint uint64_to_chars(uint64_t value, char *pDst)
     {
         VOGL_ASSERT(pDst);
 
-        const uint cBufSize = 32;
-        char buf[cBufSize];
+        char buf[cMaxNumberStringBufSize];
+        char *p = buf + cMaxNumberStringBufSize;
 
-        // -value could overflow here, but we cast to uint64_t so it doesn't matter
-        uint64_t j = static_cast<uint64_t>((value < 0) ? -value : value);
+        // Two digits at a time, which halves the number of (slow) 64-bit divides.
+        while (value >= 100U)
+        {
+            uint i = static_cast<uint>(value % 100U) * 2U;
+            value /= 100U;
+            *--p = g_decimal_digit_pairs[i + 1];
+            *--p = g_decimal_digit_pairs[i];
+        }
 
-        char *p = buf + cBufSize - 1;
+        if (value >= 10U)
+        {
+            uint i = static_cast<uint>(value) * 2U;
+            *--p = g_decimal_digit_pairs[i + 1];
+            *--p = g_decimal_digit_pairs[i];
+        }
+        else
+        {
+            *--p = static_cast<char>('0' + value);
+        }
 
-        *p-- = '\0';
+        uint len = static_cast<uint>((buf + cMaxNumberStringBufSize) - p);
+        memcpy(pDst, p, len);
+        pDst[len] = '\0';
 
-        do
+        return len;
+    }
+
+    uint int64_to_chars(int64_t value, char *pDst)
+    {
+        VOGL_ASSERT(pDst);
+
+        if (value >= 0)
+            return uint64_to_chars(static_cast<uint64_t>(value), pDst);
+
+        *pDst = '-';
+        return 1 + uint64_to_chars(0U - static_cast<uint64_t>(value), pDst + 1);
+    }
+
+    uint uint64_to_hex_chars(uint64_t value, char *pDst, uint min_digits, bool upper_case)
+    {
+        VOGL_ASSERT(pDst);
+
+        const char *pDigits = upper_case ? "0123456789ABCDEF" : "0123456789abcdef";
+
+        uint num_digits = 1;
+        while ((num_digits < 16) && (value >> (num_digits * 4U)))
+            num_digits++;
+
+        num_digits = math::clamp<uint>(math::maximum(num_digits, min_digits), 1U, cMaxNumberStringBufSize - 1);
+
+        for (uint i = 0; i < num_digits; i++)
         {
-            *p-- = static_cast<uint8>('0' + (j % 10U));
-            j /= 10U;
-        } while (j);
+            uint shift = (num_digits - 1 - i) * 4U;
+            pDst[i] = (shift < 64U) ? pDigits[(value >> shift) & 0xF] : '0';
+        }
+        pDst[num_digits] = '\0';
 
-        if (value < 0)
-            *p-- = '-';
+        return num_digits;
+    }
 
-        const size_t total_bytes = (buf + cBufSize - 1) - p;
+    // Grisu2 (Florian Loitsch, "Printing Floating-Point Numbers Quickly and Accurately with Integers"): generates the
+    // shortest digit string inside the value's rounding interval, shrunk by one ulp of the 64-bit approximation so the
+    // result always reads back exactly. In rare cases it's one digit longer than the true shortest.
+    namespace grisu
+    {
+        struct diy_fp
+        {
+            diy_fp()
+            {
+            }
+            diy_fp(uint64_t f, int e)
+                : m_f(f), m_e(e)
+            {
+            }
+
+            uint64_t m_f;
+            int m_e;
+        };
+
+        static inline diy_fp mul(const diy_fp &a, const diy_fp &b)
+        {
+            const uint64_t M32 = 0xFFFFFFFFU;
+            const uint64_t a_hi = a.m_f >> 32, a_lo = a.m_f & M32;
+            const uint64_t b_hi = b.m_f >> 32, b_lo = b.m_f & M32;
+            const uint64_t hh = a_hi * b_hi, lh = a_lo * b_hi, hl = a_hi * b_lo, ll = a_lo * b_lo;
+
+            // Round the discarded low 64 bits.
+            uint64_t tmp = (ll >> 32) + (hl & M32) + (lh & M32) + (1U << 31);
+            return diy_fp(hh + (hl >> 32) + (lh >> 32) + (tmp >> 32), a.m_e + b.m_e + 64);
+        }
+
+        static inline diy_fp normalize(diy_fp x)
+        {
+            while (!(x.m_f & 0x8000000000000000ULL))
+            {
+                x.m_f <<= 1;
+                x.m_e--;
+            }
+            return x;
+        }
+
+        // Cached 10^k for k = -348, -340, ..., 340, normalized to 64 bits.
+        static const uint64_t s_cached_powers_f[] =
+            {
+                0xFA8FD5A0081C0288ULL, 0xBAAEE17FA23EBF76ULL, 0x8B16FB203055AC76ULL, 0xCF42894A5DCE35EAULL,
+                0x9A6BB0AA55653B2DULL, 0xE61ACF033D1A45DFULL, 0xAB70FE17C79AC6CAULL, 0xFF77B1FCBEBCDC4FULL,
+                0xBE5691EF416BD60CULL, 0x8DD01FAD907FFC3CULL, 0xD3515C2831559A83ULL, 0x9D71AC8FADA6C9B5ULL,
+                0xEA9C227723EE8BCBULL, 0xAECC49914078536DULL, 0x823C12795DB6CE57ULL, 0xC21094364DFB5637ULL,
+                0x9096EA6F3848984FULL, 0xD77485CB25823AC7ULL, 0xA086CFCD97BF97F4ULL, 0xEF340A98172AACE5ULL,
+                0xB23867FB2A35B28EULL, 0x84C8D4DFD2C63F3BULL, 0xC5DD44271AD3CDBAULL, 0x936B9FCEBB25C996ULL,
+                0xDBAC6C247D62A584ULL, 0xA3AB66580D5FDAF6ULL, 0xF3E2F893DEC3F126ULL, 0xB5B5ADA8AAFF80B8ULL,
+                0x87625F056C7C4A8BULL, 0xC9BCFF6034C13053ULL, 0x964E858C91BA2655ULL, 0xDFF9772470297EBDULL,
+                0xA6DFBD9FB8E5B88FULL, 0xF8A95FCF88747D94ULL, 0xB94470938FA89BCFULL, 0x8A08F0F8BF0F156BULL,
+                0xCDB02555653131B6ULL, 0x993FE2C6D07B7FACULL, 0xE45C10C42A2B3B06ULL, 0xAA242499697392D3ULL,
+                0xFD87B5F28300CA0EULL, 0xBCE5086492111AEBULL, 0x8CBCCC096F5088CCULL, 0xD1B71758E219652CULL,
+                0x9C40000000000000ULL, 0xE8D4A51000000000ULL, 0xAD78EBC5AC620000ULL, 0x813F3978F8940984ULL,
+                0xC097CE7BC90715B3ULL, 0x8F7E32CE7BEA5C70ULL, 0xD5D238A4ABE98068ULL, 0x9F4F2726179A2245ULL,
+                0xED63A231D4C4FB27ULL, 0xB0DE65388CC8ADA8ULL, 0x83C7088E1AAB65DBULL, 0xC45D1DF942711D9AULL,
+                0x924D692CA61BE758ULL, 0xDA01EE641A708DEAULL, 0xA26DA3999AEF774AULL, 0xF209787BB47D6B85ULL,
+                0xB454E4A179DD1877ULL, 0x865B86925B9BC5C2ULL, 0xC83553C5C8965D3DULL, 0x952AB45CFA97A0B3ULL,
+                0xDE469FBD99A05FE3ULL, 0xA59BC234DB398C25ULL, 0xF6C69A72A3989F5CULL, 0xB7DCBF5354E9BECEULL,
+                0x88FCF317F22241E2ULL, 0xCC20CE9BD35C78A5ULL, 0x98165AF37B2153DFULL, 0xE2A0B5DC971F303AULL,
+                0xA8D9D1535CE3B396ULL, 0xFB9B7CD9A4A7443CULL, 0xBB764C4CA7A44410ULL, 0x8BAB8EEFB6409C1AULL,
+                0xD01FEF10A657842CULL, 0x9B10A4E5E9913129ULL, 0xE7109BFBA19C0C9DULL, 0xAC2820D9623BF429ULL,
+                0x80444B5E7AA7CF85ULL, 0xBF21E44003ACDD2DULL, 0x8E679C2F5E44FF8FULL, 0xD433179D9C8CB841ULL,
+                0x9E19DB92B4E31BA9ULL, 0xEB96BF6EBADF77D9ULL, 0xAF87023B9BF0EE6BULL
+            };
+        static const int16 s_cached_powers_e[] =
+            {
+                -1220, -1193, -1166, -1140, -1113, -1087, -1060, -1034, -1007, -980,
+                -954, -927, -901, -874, -847, -821, -794, -768, -741, -715,
+                -688, -661, -635, -608, -582, -555, -529, -502, -475, -449,
+                -422, -396, -369, -343, -316, -289, -263, -236, -210, -183,
+                -157, -130, -103, -77, -50, -24, 3, 30, 56, 83,
+                109, 136, 162, 189, 216, 242, 269, 295, 322, 348,
+                375, 402, 428, 455, 481, 508, 534, 561, 588, 614,
+                641, 667, 694, 720, 747, 774, 800, 827, 853, 880,
+                907, 933, 960, 986, 1013, 1039, 1066
+            };
+
+        // Returns c = 10^-K, so that the exponent of (c * a normalized value with exponent e) lands in [-60, -32].
+        static inline diy_fp get_cached_power(int e, int &K)
+        {
+            double dk = (-61 - e) * 0.30102999566398114 + 347;
+            int k = static_cast<int>(dk);
+            if (dk - k > 0.0)
+                k++;
+
+            uint index = static_cast<uint>((k >> 3) + 1);
+            K = -(-348 + static_cast<int>(index << 3));
+
+            return diy_fp(s_cached_powers_f[index], s_cached_powers_e[index]);
+        }
+
+        static inline void round_weed(char *pBuf, uint len, uint64_t delta, uint64_t rest, uint64_t ten_kappa, uint64_t wp_w)
+        {
+            while ((rest < wp_w) && ((delta - rest) >= ten_kappa) && (((rest + ten_kappa) < wp_w) || ((wp_w - rest) > (rest + ten_kappa - wp_w))))
+            {
+                pBuf[len - 1]--;
+                rest += ten_kappa;
+            }
+        }
+
+        static const uint64_t s_pow10[] =
+            {
+                1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL, 100000000ULL, 1000000000ULL,
+                10000000000ULL, 100000000000ULL, 1000000000000ULL, 10000000000000ULL, 100000000000000ULL, 1000000000000000ULL,
+                10000000000000000ULL, 100000000000000000ULL, 1000000000000000000ULL, 10000000000000000000ULL
+            };
+
+        static inline void digit_gen(const diy_fp &W, const diy_fp &Mp, uint64_t delta, char *pBuf, uint &len, int &K)
+        {
+            const diy_fp one(1ULL << -Mp.m_e, Mp.m_e);
+            const uint64_t wp_w = Mp.m_f - W.m_f;
+
+            uint32 p1 = static_cast<uint32>(Mp.m_f >> -one.m_e);
+            uint64_t p2 = Mp.m_f & (one.m_f - 1);
+
+            int kappa = 1;
+            while ((kappa < 10) && (p1 >= s_pow10[kappa]))
+                kappa++;
+
+            len = 0;
+            while (kappa > 0)
+            {
+                const uint32 div = static_cast<uint32>(s_pow10[kappa - 1]);
+                const uint32 d = p1 / div;
+                p1 %= div;
+
+                if ((d) || (len))
+                    pBuf[len++] = static_cast<char>('0' + d);
+
+                kappa--;
+
+                const uint64_t rest = (static_cast<uint64_t>(p1) << -one.m_e) + p2;
+                if (rest <= delta)
+                {
+                    K += kappa;
+                    round_weed(pBuf, len, delta, rest, s_pow10[kappa] << -one.m_e, wp_w);
+                    return;
+                }
+            }
+
+            for (;;)
+            {
+                p2 *= 10;
+                delta *= 10;
+
+                const char d = static_cast<char>(p2 >> -one.m_e);
+                if ((d) || (len))
+                    pBuf[len++] = static_cast<char>('0' + d);
+
+                p2 &= one.m_f - 1;
+                kappa--;
+
+                if (p2 < delta)
+                {
+                    K += kappa;
+                    const int index = -kappa;
+                    round_weed(pBuf, len, delta, p2, one.m_f, wp_w * ((index < static_cast<int>(VOGL_ARRAY_SIZE(s_pow10))) ? s_pow10[index] : 0));
+                    return;
+                }
+            }
+        }
+
+        // f/e is a positive finite value (f including the hidden bit, if any). significand_bits is 52 for doubles, 23 for floats.
+        // Writes the digits to pBuf (no terminator), returns their count, and sets K so the value is digits * 10^K.
+        static uint generate_digits(uint64_t f, int e, uint significand_bits, char *pBuf, int &K)
+        {
+            const diy_fp v(f, e);
+
+            // The boundaries are halfway to the neighbouring values. The lower one is closer when f is an exact power of 2.
+            const diy_fp plus(normalize(diy_fp((f << 1) + 1, e - 1)));
+            diy_fp minus((f == (1ULL << significand_bits)) ? diy_fp((f << 2) - 1, e - 2) : diy_fp((f << 1) - 1, e - 1));
+            minus.m_f <<= minus.m_e - plus.m_e;
+            minus.m_e = plus.m_e;
+
+            const diy_fp c_mk(get_cached_power(plus.m_e, K));
+
+            const diy_fp W(mul(normalize(v), c_mk));
+            diy_fp Wp(mul(plus, c_mk));
+            diy_fp Wm(mul(minus, c_mk));
+            Wm.m_f++;
+            Wp.m_f--;
+
+            uint len;
+            digit_gen(W, Wp, Wp.m_f - Wm.m_f, pBuf, len, K);
+            return len;
+        }
+
+        // Lays out digits * 10^K like "%.*g" would with precision max_fixed_exp10 + 1: plain decimal for exponents in
+        // [-4, max_fixed_exp10], otherwise d.ddde+XX.
+        static uint format_digits(char *pDst, const char *pDigits, uint len, int K, int max_fixed_exp10)
+        {
+            char *p = pDst;
+
+            // 10^(exp10) <= value < 10^(exp10 + 1)
+            const int exp10 = static_cast<int>(len) + K - 1;
+
+            if ((exp10 >= -4) && (exp10 <= max_fixed_exp10))
+            {
+                if (exp10 < 0)
+                {
+                    *p++ = '0';
+                    *p++ = '.';
+                    for (int i = -1; i > exp10; i--)
+                        *p++ = '0';
+                    memcpy(p, pDigits, len);
+                    p += len;
+                }
+                else if (static_cast<int>(len) <= (exp10 + 1))
+                {
+                    memcpy(p, pDigits, len);
+                    p += len;
+                    for (int i = static_cast<int>(len); i <= exp10; i++)
+                        *p++ = '0';
+                }
+                else
+                {
+                    memcpy(p, pDigits, exp10 + 1);
+                    p += exp10 + 1;
+                    *p++ = '.';
+                    memcpy(p, pDigits + exp10 + 1, len - (exp10 + 1));
+                    p += len - (exp10 + 1);
+                }
+            }
+            else
+            {
+                *p++ = pDigits[0];
+                if (len > 1)
+                {
+                    *p++ = '.';
+                    memcpy(p, pDigits + 1, len - 1);
+                    p += len - 1;
+                }
+
+                *p++ = 'e';
+                *p++ = (exp10 < 0) ? '-' : '+';
+
+                uint exp_abs = static_cast<uint>((exp10 < 0) ? -exp10 : exp10);
+                if (exp_abs >= 100)
+                {
+                    *p++ = static_cast<char>('0' + exp_abs / 100);
+                    exp_abs %= 100;
+                }
+                *p++ = g_decimal_digit_pairs[exp_abs * 2];
+                *p++ = g_decimal_digit_pairs[exp_abs * 2 + 1];
+            }
+
+            *p = '\0';
+            return static_cast<uint>(p - pDst);
+        }
+
+    } // namespace grisu
+
+    uint double_to_chars(double value, char *pDst)
+    {
+        VOGL_ASSERT(pDst);
+
+        uint64_t bits;
+        memcpy(&bits, &value, sizeof(bits));
+
+        const uint biased_exp = static_cast<uint>((bits >> 52) & 0x7FF);
+        uint64_t f = bits & 0xFFFFFFFFFFFFFULL;
+
+        if (biased_exp == 0x7FF)
+            return static_cast<uint>(vogl_sprintf_s(pDst, cMaxNumberStringBufSize, "%g", value));
+
+        char *p = pDst;
+        if (bits >> 63)
+            *p++ = '-';
+
+        if ((!biased_exp) && (!f))
+        {
+            *p++ = '0';
+            *p = '\0';
+            return static_cast<uint>(p - pDst);
+        }
+
+        int e;
+        if (biased_exp)
+        {
+            f |= 1ULL << 52;
+            e = static_cast<int>(biased_exp) - 1075;
+        }
+        else
+            e = -1074;
+
+        char digits[24];
+        int K;
+        uint len = grisu::generate_digits(f, e, 52, digits, K);
+
+        return static_cast<uint>(p - pDst) + grisu::format_digits(p, digits, len, K, 16);
+    }
+
+    uint float_to_chars(float value, char *pDst)
+    {
+        VOGL_ASSERT(pDst);
+
+        uint32 bits;
+        memcpy(&bits, &value, sizeof(bits));
+
+        const uint biased_exp = (bits >> 23) & 0xFF;
+        uint64_t f = bits & 0x7FFFFF;
+
+        if (biased_exp == 0xFF)
+            return static_cast<uint>(vogl_sprintf_s(pDst, cMaxNumberStringBufSize, "%g", static_cast<double>(value)));
+
+        char *p = pDst;
+        if (bits >> 31)
+            *p++ = '-';
+
+        if ((!biased_exp) && (!f))
+        {
+            *p++ = '0';
+            *p = '\0';
+            return static_cast<uint>(p - pDst);
+        }
+
+        int e;
+        if (biased_exp)
+        {
+            f |= 1U << 23;
+            e = static_cast<int>(biased_exp) - 150;
+        }
+        else
+            e = -149;
+
+        char digits[24];
+        int K;
+        uint len = grisu::generate_digits(f, e, 23, digits, K);
+
+        return static_cast<uint>(p - pDst) + grisu::format_digits(p, digits, len, K, 8);
+    }
+
+    dynamic_string uint64_to_hex_string(uint64_t value, uint min_digits)
+    {
+        char buf[2 + cMaxNumberStringBufSize];
+        buf[0] = '0';
+        buf[1] = 'x';
+        uint len = 2 + uint64_to_hex_chars(value, buf + 2, min_digits);
+        return dynamic_string(buf, len);
+    }
+
+    bool int64_to_string(int64_t value, char *pDst, uint len)
+    {
+        VOGL_ASSERT(pDst);
+
+        char buf[cMaxNumberStringBufSize];
+        const uint total_bytes = int64_to_chars(value, buf) + 1;
         if (total_bytes > len)
         {
             if ((pDst) && (len))
@@ -391,8 +782,7 @@ namespace vogl
             return false;
         }
 
-        for (size_t i = 0; i < total_bytes; i++)
-            pDst[i] = p[1 + i];
+        memcpy(pDst, buf, total_bytes);
 
         return true;
     }
@@ -1034,6 +1424,66 @@ namespace vogl
             CHECK((isalpha(i) != 0) == vogl_isalpha(i));
         }
 
+        {
+            static const struct
+            {
+                double m_val;
+                const char *m_pExpected;
+            } s_doubles[] =
+                  {
+                      { 0.0, "0" }, { -0.0, "-0" }, { 1.0, "1" }, { -2.5, "-2.5" }, { 0.1, "0.1" }, { 1.0 / 3.0, "0.3333333333333333" },
+                      { 123456.0, "123456" }, { 1e16, "10000000000000000" }, { 1e17, "1e+17" }, { 0.0001, "0.0001" }, { 0.00001, "1e-05" }, { 0.000001, "1e-06" },
+                      { 5e-324, "5e-324" }, { 1.7976931348623157e308, "1.7976931348623157e+308" }, { 2.2250738585072014e-308, "2.2250738585072014e-308" }
+                  };
+
+            char buf[cMaxNumberStringBufSize];
+            for (uint i = 0; i < VOGL_ARRAY_SIZE(s_doubles); i++)
+            {
+                uint len = vogl::double_to_chars(s_doubles[i].m_val, buf);
+                CHECK(!strcmp(buf, s_doubles[i].m_pExpected));
+                CHECK(len == strlen(buf));
+            }
+
+            vogl::float_to_chars(0.1f, buf);
+            CHECK(!strcmp(buf, "0.1"));
+            vogl::float_to_chars(16777216.0f, buf);
+            CHECK(!strcmp(buf, "16777216"));
+            vogl::float_to_chars(1e10f, buf);
+            CHECK(!strcmp(buf, "1e+10"));
+            vogl::float_to_chars(3.4028235e38f, buf);
+            CHECK(!strcmp(buf, "3.4028235e+38"));
+            vogl::float_to_chars(1.4e-45f, buf);
+            CHECK(!strcmp(buf, "1e-45"));
+
+            // Every finite bit pattern must read back exactly, and never take more digits than "%.17g" / "%.9g".
+            vogl::random fr;
+            for (uint t = 0; t < 1000000; t++)
+            {
+                uint64_t bits = fr.urand64();
+                double d;
+                memcpy(&d, &bits, sizeof(d));
+                if (math::is_nan_or_inf(d))
+                    continue;
+
+                uint len = vogl::double_to_chars(d, buf);
+                CHECK(strtod(buf, NULL) == d);
+                CHECK(len == strlen(buf));
+
+                char ref_buf[64];
+                CHECK(len <= static_cast<uint>(vogl_sprintf_s(ref_buf, sizeof(ref_buf), "%.17g", d)));
+
+                uint32 fbits = fr.urand32();
+                float f;
+                memcpy(&f, &fbits, sizeof(f));
+                if (math::is_nan_or_inf(f))
+                    continue;
+
+                len = vogl::float_to_chars(f, buf);
+                CHECK(static_cast<float>(strtod(buf, NULL)) == f);
+                CHECK(len <= static_cast<uint>(vogl_sprintf_s(ref_buf, sizeof(ref_buf), "%.9g", static_cast<double>(f))));
+            }
+        }
+
         vogl::random r;
         for (uint t = 0; t < 0x1FFFFFF; t++)
         {
@@ -1090,6 +1540,17 @@ namespace vogl
             CHECK(vogl::string_ptr_to_uint64(pBuf, uv64));
             CHECK(uv64 == static_cast<uint64_t>(i));
 
+            char hex_buf[cMaxNumberStringBufSize];
+            vogl::uint64_to_hex_chars(static_cast<uint64_t>(i), hex_buf, 16);
+            CHECK(strtoull(hex_buf, NULL, 16) == static_cast<uint64_t>(i));
+
+            if ((t & 255) == 0)
+            {
+                double d = static_cast<double>(i) * r.drand(-1.0, 1.0);
+                vogl::double_to_chars(d, buf);
+                CHECK(strtod(buf, NULL) == d);
+            }
+
             if ((t & 32767) == 32767)
                 printf("0x%08X\n", t);
         }
@@ -119,6 +119,24 @@ namespace vogl
     bool uint64_to_string_with_commas(uint64_t value, char *pDst, uint len);
     dynamic_string uint64_to_string_with_commas(uint64_t value);
 
+    // Fast number to text conversions, for hot paths that would otherwise go through vsnprintf().
+    // pDst must have room for cMaxNumberStringBufSize chars. They return the number of chars written, not counting the zero terminator.
+    enum
+    {
+        cMaxNumberStringBufSize = 32
+    };
+    uint uint64_to_chars(uint64_t value, char *pDst);
+    uint int64_to_chars(int64_t value, char *pDst);
+    // No "0x" prefix, zero padded to min_digits.
+    uint uint64_to_hex_chars(uint64_t value, char *pDst, uint min_digits = 0, bool upper_case = true);
+    // "%.17g" ("%.9g" for floats) style string with the fewest significant digits that reads back as exactly the same value.
+    // Uses Grisu2, so very rarely one digit more than the minimum.
+    uint double_to_chars(double value, char *pDst);
+    uint float_to_chars(float value, char *pDst);
+
+    // Same as dynamic_string(cVarArg, "0x%" PRIX64, value) (or "0x%016" PRIX64 with min_digits=16).
+    dynamic_string uint64_to_hex_string(uint64_t value, uint min_digits = 0);
+
     // string_to_int/uint/etc.
     // Supports hex values beginning with "0x", skips leading whitespace, returns false on overflow or conversion errors.
     // pBuf will be moved forward the # of characters actually consumed.
@@ -308,10 +308,10 @@ namespace vogl
         inline void move(T &dst, T &src)
         {
             if (VOGL_IS_BITWISE_COPYABLE_OR_MOVABLE(T))
-                memcpy(&dst, &src, sizeof(T));
+                memcpy(static_cast<void *>(&dst), &src, sizeof(T));
             else
             {
-                construct(&dst, src);
+                new (static_cast<void *>(&dst)) T(VOGL_MOVE(src));
                 destruct(&src);
             }
         }
@@ -326,7 +326,7 @@ namespace vogl
             {
                 for (uint i = 0; i < n; i++)
                 {
-                    construct(pDst + i, pSrc[i]);
+                    new (static_cast<void *>(pDst + i)) T(VOGL_MOVE(pSrc[i]));
                     destruct(pSrc + i);
                 }
             }
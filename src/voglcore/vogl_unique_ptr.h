@@ -72,6 +72,23 @@ namespace vogl
         {
         }
 
+#if VOGL_HAS_MOVE_SEMANTICS
+        // Allows vogl_unique_ptr's to be returned by value and stored in containers (which move their elements instead of copying them).
+        vogl_unique_ptr(vogl_unique_ptr &&other)
+            : m_p(other.release())
+        {
+        }
+
+        vogl_unique_ptr &operator=(vogl_unique_ptr &&rhs)
+        {
+            if (this != &rhs)
+            {
+                reset(rhs.release());
+            }
+            return *this;
+        }
+#endif
+
         ~vogl_unique_ptr()
         {
             reset();
@@ -146,6 +163,16 @@ namespace vogl
     private:
         pointer m_p;
     };
+
+    // The default delete policy is stateless, so these can be relocated with memcpy.
+    template <typename T>
+    struct bitwise_movable<vogl_unique_ptr<T> >
+    {
+        enum
+        {
+            cFlag = true
+        };
+    };
 }
 
 namespace std
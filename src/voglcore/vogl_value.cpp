@@ -68,6 +68,19 @@ namespace vogl
         if (this == &other)
             return *this;
 
+        if (other.m_type == cDTBlob)
+        {
+            // Copies of borrowed blobs are also borrowed
+            if (other.m_blob_storage == cBlobStorageBorrowed)
+                set_blob_borrowed(other.m_borrowed_blob.m_pData, other.m_borrowed_blob.m_size);
+            else
+                set_blob(other.get_blob_data(), other.get_blob_size());
+
+            m_user_data = other.m_user_data;
+            m_flags = other.m_flags;
+            return *this;
+        }
+
         change_type(other.m_type);
         m_user_data = other.m_user_data;
         m_flags = other.m_flags;
@@ -75,16 +88,13 @@ namespace vogl
         switch (other.m_type)
         {
             case cDTString:
-                m_pStr->set(*other.m_pStr);
+                str_ptr()->set(*other.str_ptr());
                 break;
             case cDTVec3F:
-                m_pVec3F->set(*other.m_pVec3F);
+                vec3F_ptr()->set(*other.vec3F_ptr());
                 break;
             case cDTVec3I:
-                m_pVec3I->set(*other.m_pVec3I);
-                break;
-            case cDTBlob:
-                (*m_pBlob) = (*other.m_pBlob);
+                vec3I_ptr()->set(*other.vec3I_ptr());
                 break;
             case cDTJSONDoc:
                 (*m_pJSONDoc) = (*other.m_pJSONDoc);
@@ -150,7 +160,7 @@ namespace vogl
                 case cDTInvalid:
                     break;
                 case cDTString:
-                    return m_pStr->compare(*other.m_pStr, true) < 0;
+                    return str_ptr()->compare(*other.str_ptr(), true) < 0;
                 case cDTBool:
                     return m_bool < other.m_bool;
                 case cDTInt8:
@@ -177,11 +187,17 @@ namespace vogl
                 case cDTVoidPtr:
                     return m_pPtr < other.m_pPtr;
                 case cDTVec3F:
-                    return (*m_pVec3F) < (*other.m_pVec3F);
+                    return (*vec3F_ptr()) < (*other.vec3F_ptr());
                 case cDTVec3I:
-                    return (*m_pVec3I) < (*other.m_pVec3I);
+                    return (*vec3I_ptr()) < (*other.vec3I_ptr());
                 case cDTBlob:
-                    return (*m_pBlob) < (*other.m_pBlob);
+                {
+                    uint size = get_blob_size(), other_size = other.get_blob_size();
+                    int result = memcmp(get_blob_data(), other.get_blob_data(), math::minimum(size, other_size));
+                    if (result)
+                        return result < 0;
+                    return size < other_size;
+                }
                 case cDTJSONDoc:
                 {
                     // This is brain dead slow, but I doubt we'll be using this path much if at all.
@@ -272,8 +288,8 @@ namespace vogl
                         return false;
                     }
 
-                    change_type(cDTBlob);
-                    if (!m_pBlob->try_resize(static_cast<uint>(size)))
+                    uint8 *pDst = init_blob(static_cast<uint>(size));
+                    if (!pDst)
                     {
                         clear();
                         return false;
@@ -281,7 +297,6 @@ namespace vogl
 
                     if (size)
                     {
-                        uint8 *pDst = m_pBlob->get_ptr();
 
                         for (i = 1; i < (str_len - 1); i += 3)
                         {
@@ -398,12 +413,12 @@ namespace vogl
                 if (quote_strings)
                 {
                     dst = "\"";
-                    dst += *m_pStr;
+                    dst += *str_ptr();
                     dst += "\"";
                 }
                 else
                 {
-                    dst = *m_pStr;
+                    dst = *str_ptr();
                 }
                 break;
             }
@@ -445,15 +460,15 @@ namespace vogl
                 dst.format("%1.17f", m_double);
                 break;
             case cDTVec3F:
-                dst.format("%1.8f,%1.8f,%1.8f", (*m_pVec3F)[0], (*m_pVec3F)[1], (*m_pVec3F)[2]);
+                dst.format("%1.8f,%1.8f,%1.8f", (*vec3F_ptr())[0], (*vec3F_ptr())[1], (*vec3F_ptr())[2]);
                 break;
             case cDTVec3I:
-                dst.format("%i,%i,%i", (*m_pVec3I)[0], (*m_pVec3I)[1], (*m_pVec3I)[2]);
+                dst.format("%i,%i,%i", (*vec3I_ptr())[0], (*vec3I_ptr())[1], (*vec3I_ptr())[2]);
                 break;
             case cDTBlob:
             {
-                uint blob_size = m_pBlob->size();
-                const uint8 *pSrc = m_pBlob->get_ptr();
+                uint blob_size = get_blob_size();
+                const uint8 *pSrc = get_blob_data();
 
                 if (!blob_size)
                     dst = "[]";
@@ -553,7 +568,7 @@ namespace vogl
             }
             case cDTString:
             {
-                const char *p = m_pStr->get_ptr();
+                const char *p = str_ptr()->get_ptr();
                 return string_ptr_to_int64(p, val);
             }
             case cDTBool:
@@ -622,23 +637,23 @@ namespace vogl
             {
                 if (component > 2)
                     return false;
-                if (((*m_pVec3F)[component] < cINT64_MIN) || ((*m_pVec3F)[component] > cINT64_MAX))
+                if (((*vec3F_ptr())[component] < cINT64_MIN) || ((*vec3F_ptr())[component] > cINT64_MAX))
                     return false;
-                val = static_cast<int64_t>((*m_pVec3F)[component]);
+                val = static_cast<int64_t>((*vec3F_ptr())[component]);
                 break;
             }
             case cDTVec3I:
             {
                 if (component > 2)
                     return false;
-                val = (*m_pVec3I)[component];
+                val = (*vec3I_ptr())[component];
                 break;
             }
             case cDTBlob:
             {
-                if (component >= m_pBlob->size())
+                if (component >= get_blob_size())
                     return false;
-                val = m_pBlob->at(component);
+                val = get_blob_data()[component];
                 break;
             }
             case cDTVoidPtr:
@@ -682,7 +697,7 @@ namespace vogl
             }
             case cDTString:
             {
-                const char *p = m_pStr->get_ptr();
+                const char *p = str_ptr()->get_ptr();
                 return string_ptr_to_uint64(p, val);
             }
             case cDTBool:
@@ -757,29 +772,29 @@ namespace vogl
             {
                 if (component > 2)
                     return false;
-                if (((*m_pVec3F)[component] < 0) || ((*m_pVec3F)[component] > cUINT64_MAX))
+                if (((*vec3F_ptr())[component] < 0) || ((*vec3F_ptr())[component] > cUINT64_MAX))
                 {
                     return false;
                 }
-                val = static_cast<uint64_t>((*m_pVec3F)[component]);
+                val = static_cast<uint64_t>((*vec3F_ptr())[component]);
                 break;
             }
             case cDTVec3I:
             {
                 if (component > 2)
                     return false;
-                if ((*m_pVec3I)[component] < 0)
+                if ((*vec3I_ptr())[component] < 0)
                 {
                     return false;
                 }
-                val = static_cast<uint64_t>((*m_pVec3I)[component]);
+                val = static_cast<uint64_t>((*vec3I_ptr())[component]);
                 break;
             }
             case cDTBlob:
             {
-                if (component >= m_pBlob->size())
+                if (component >= get_blob_size())
                     return false;
-                val = m_pBlob->at(component);
+                val = get_blob_data()[component];
                 break;
             }
             case cDTVoidPtr:
@@ -811,7 +826,7 @@ namespace vogl
             }
             case cDTString:
             {
-                const char *p = m_pStr->get_ptr();
+                const char *p = str_ptr()->get_ptr();
                 return string_ptr_to_bool(p, val);
             }
             case cDTBool:
@@ -858,21 +873,21 @@ namespace vogl
             {
                 if (component > 2)
                     return false;
-                val = ((*m_pVec3F)[component] != 0);
+                val = ((*vec3F_ptr())[component] != 0);
                 break;
             }
             case cDTVec3I:
             {
                 if (component > 2)
                     return false;
-                val = ((*m_pVec3I)[component] != 0);
+                val = ((*vec3I_ptr())[component] != 0);
                 break;
             }
             case cDTBlob:
             {
-                if (component >= m_pBlob->size())
+                if (component >= get_blob_size())
                     return false;
-                val = m_pBlob->at(component) != 0;
+                val = get_blob_data()[component] != 0;
                 break;
             }
             case cDTVoidPtr:
@@ -905,7 +920,7 @@ namespace vogl
             }
             case cDTString:
             {
-                const char *p = m_pStr->get_ptr();
+                const char *p = str_ptr()->get_ptr();
                 return string_ptr_to_double(p, val);
             }
             case cDTBool:
@@ -968,21 +983,21 @@ namespace vogl
             {
                 if (component > 2)
                     return false;
-                val = (*m_pVec3F)[component];
+                val = (*vec3F_ptr())[component];
                 break;
             }
             case cDTVec3I:
             {
                 if (component > 2)
                     return false;
-                val = static_cast<double>((*m_pVec3I)[component]);
+                val = static_cast<double>((*vec3I_ptr())[component]);
                 break;
             }
             case cDTBlob:
             {
-                if (component >= m_pBlob->size())
+                if (component >= get_blob_size())
                     return false;
-                val = static_cast<double>(m_pBlob->at(component));
+                val = static_cast<double>(get_blob_data()[component]);
                 break;
             }
             case cDTVoidPtr:
@@ -1029,7 +1044,7 @@ namespace vogl
             }
             case cDTString:
             {
-                const char *p = m_pStr->get_ptr();
+                const char *p = str_ptr()->get_ptr();
                 float x = 0, y = 0, z = 0;
 #ifdef COMPILER_MSVC
                 if (sscanf_s(p, "%f,%f,%f", &x, &y, &z) == 3)
@@ -1098,19 +1113,19 @@ namespace vogl
             }
             case cDTVec3F:
             {
-                val = *m_pVec3F;
+                val = *vec3F_ptr();
                 break;
             }
             case cDTVec3I:
             {
-                val.set(static_cast<float>((*m_pVec3I)[0]), static_cast<float>((*m_pVec3I)[1]), static_cast<float>((*m_pVec3I)[2]));
+                val.set(static_cast<float>((*vec3I_ptr())[0]), static_cast<float>((*vec3I_ptr())[1]), static_cast<float>((*vec3I_ptr())[2]));
                 break;
             }
             case cDTBlob:
             {
-                if (!m_pBlob->size())
+                if (!get_blob_size())
                     return false;
-                val.set(static_cast<float>(m_pBlob->at(0)));
+                val.set(static_cast<float>(get_blob_data()[0]));
                 break;
             }
             case cDTVoidPtr:
@@ -1142,7 +1157,7 @@ namespace vogl
             }
             case cDTString:
             {
-                const char *p = m_pStr->get_ptr();
+                const char *p = str_ptr()->get_ptr();
                 float x = 0, y = 0, z = 0;
 #ifdef COMPILER_MSVC
                 if (sscanf_s(p, "%f,%f,%f", &x, &y, &z) == 3)
@@ -1219,19 +1234,19 @@ namespace vogl
             }
             case cDTVec3F:
             {
-                val.set((int)(*m_pVec3F)[0], (int)(*m_pVec3F)[1], (int)(*m_pVec3F)[2]);
+                val.set((int)(*vec3F_ptr())[0], (int)(*vec3F_ptr())[1], (int)(*vec3F_ptr())[2]);
                 break;
             }
             case cDTVec3I:
             {
-                val = *m_pVec3I;
+                val = *vec3I_ptr();
                 break;
             }
             case cDTBlob:
             {
-                if (!m_pBlob->size())
+                if (!get_blob_size())
                     return false;
-                val.set(m_pBlob->at(0));
+                val.set(get_blob_data()[0]);
                 break;
             }
             case cDTVoidPtr:
@@ -1258,7 +1273,7 @@ namespace vogl
         if (m_type == cDTString)
         {
             // Hash the string
-            hash.set(m_pStr->get_ptr());
+            hash.set(str_ptr()->get_ptr());
             return true;
         }
         else if (m_type == cDTStringHash)
@@ -1269,7 +1284,7 @@ namespace vogl
         else if (m_type == cDTBlob)
         {
             // Just hash the blob and hope for the best
-            hash.set(reinterpret_cast<const char *>(m_pBlob->get_ptr()), m_pBlob->size());
+            hash.set(reinterpret_cast<const char *>(get_blob_data()), get_blob_size());
             return true;
         }
         else if (m_type == cDTJSONDoc)
@@ -1302,7 +1317,7 @@ namespace vogl
         {
             case cDTString:
             {
-                size += m_pStr->get_serialize_size();
+                size += str_ptr()->get_serialize_size();
                 break;
             }
             case cDTBool:
@@ -1349,7 +1364,7 @@ namespace vogl
             }
             case cDTBlob:
             {
-                size += sizeof(uint) + m_pBlob->size();
+                size += sizeof(uint) + get_blob_size();
                 break;
             }
             case cDTJSONDoc:
@@ -1386,7 +1401,7 @@ namespace vogl
         {
             case cDTString:
             {
-                int bytes_written = m_pStr->serialize(pBuf, buf_left, little_endian);
+                int bytes_written = str_ptr()->serialize(pBuf, buf_left, little_endian);
                 if (bytes_written < 0)
                     return -1;
 
@@ -1435,20 +1450,20 @@ namespace vogl
             case cDTVec3F:
             {
                 for (uint i = 0; i < 3; i++)
-                    if (!utils::write_obj((*m_pVec3F)[i], pBuf, buf_left, little_endian))
+                    if (!utils::write_obj((*vec3F_ptr())[i], pBuf, buf_left, little_endian))
                         return -1;
                 break;
             }
             case cDTVec3I:
             {
                 for (uint i = 0; i < 3; i++)
-                    if (!utils::write_obj((*m_pVec3I)[i], pBuf, buf_left, little_endian))
+                    if (!utils::write_obj((*vec3I_ptr())[i], pBuf, buf_left, little_endian))
                         return -1;
                 break;
             }
             case cDTBlob:
             {
-                uint size = m_pBlob->size();
+                uint size = get_blob_size();
 
                 if (buf_left < (size + sizeof(uint)))
                     return -1;
@@ -1458,7 +1473,7 @@ namespace vogl
 
                 if (size)
                 {
-                    memcpy(pBuf, m_pBlob->get_ptr(), size);
+                    memcpy(pBuf, get_blob_data(), size);
                     pBuf = static_cast<uint8 *>(pBuf) + size;
                     buf_left -= size;
                 }
@@ -1495,7 +1510,7 @@ namespace vogl
         return buf_size - buf_left;
     }
 
-    int value::deserialize(const void *pBuf, uint buf_size, bool little_endian, bool serialize_user_data)
+    int value::deserialize(const void *pBuf, uint buf_size, bool little_endian, bool serialize_user_data, linear_allocator *pBlob_arena)
     {
         uint buf_left = buf_size;
 
@@ -1523,7 +1538,7 @@ namespace vogl
             {
                 change_type(cDTString);
 
-                int bytes_read = m_pStr->deserialize(pBuf, buf_left, little_endian);
+                int bytes_read = str_ptr()->deserialize(pBuf, buf_left, little_endian);
                 if (bytes_read < 0)
                     return -1;
 
@@ -1584,7 +1599,7 @@ namespace vogl
                 change_type(cDTVec3F);
 
                 for (uint i = 0; i < 3; i++)
-                    if (!utils::read_obj((*m_pVec3F)[i], pBuf, buf_left, little_endian))
+                    if (!utils::read_obj((*vec3F_ptr())[i], pBuf, buf_left, little_endian))
                         return -1;
                 break;
             }
@@ -1593,14 +1608,12 @@ namespace vogl
                 change_type(cDTVec3I);
 
                 for (uint i = 0; i < 3; i++)
-                    if (!utils::read_obj((*m_pVec3I)[i], pBuf, buf_left, little_endian))
+                    if (!utils::read_obj((*vec3I_ptr())[i], pBuf, buf_left, little_endian))
                         return -1;
                 break;
             }
             case cDTBlob:
             {
-                change_type(cDTBlob);
-
                 uint size = 0;
                 if (!utils::read_obj(size, pBuf, buf_left, little_endian))
                     return -1;
@@ -1608,16 +1621,13 @@ namespace vogl
                 if (buf_left < size)
                     return -1;
 
-                if (!m_pBlob->try_resize(size))
+                if ((pBlob_arena) && (size > cMaxInlineBlobSize))
+                    set_blob_borrowed(static_cast<const uint8 *>(pBlob_arena->alloc_and_copy(pBuf, size)), size);
+                else if (!set_blob(static_cast<const uint8 *>(pBuf), size))
                     return -1;
 
-                if (size)
-                {
-                    memcpy(m_pBlob->get_ptr(), pBuf, size);
-
-                    pBuf = static_cast<const uint8 *>(pBuf) + size;
-                    buf_left -= size;
-                }
+                pBuf = static_cast<const uint8 *>(pBuf) + size;
+                buf_left -= size;
 
                 break;
             }
@@ -1649,4 +1659,116 @@ namespace vogl
         return buf_size - buf_left;
     }
 
+    bool value_test()
+    {
+#define CHECK(x)                \
+    do                          \
+    {                           \
+        if (!(x))               \
+        {                       \
+            VOGL_ASSERT_ALWAYS; \
+            return false;       \
+        }                       \
+    } while (0)
+
+        uint8 small_blob[value::cMaxInlineBlobSize];
+        uint8 large_blob[4096];
+        for (uint i = 0; i < sizeof(large_blob); i++)
+            large_blob[i] = static_cast<uint8>(i * 7 + 3);
+        memcpy(small_blob, large_blob, sizeof(small_blob));
+
+        {
+            value v(small_blob, sizeof(small_blob));
+            CHECK(v.is_blob() && !v.is_blob_borrowed());
+            CHECK(v.get_blob_size() == sizeof(small_blob));
+            CHECK(!memcmp(v.get_blob_data(), small_blob, sizeof(small_blob)));
+
+            value w(v);
+            CHECK(w == v);
+
+            v.set_blob(large_blob, sizeof(large_blob));
+            CHECK(v.get_blob_size() == sizeof(large_blob));
+            CHECK(!memcmp(v.get_blob_data(), large_blob, sizeof(large_blob)));
+            CHECK(w < v);
+
+            v.swap(w);
+            CHECK(v.get_blob_size() == sizeof(small_blob));
+            CHECK(w.get_blob_size() == sizeof(large_blob));
+        }
+
+        {
+            value v;
+            v.set_blob_borrowed(large_blob, sizeof(large_blob));
+            CHECK(v.is_blob_borrowed() && (v.get_blob_data() == large_blob));
+
+            value w(v);
+            CHECK(w.is_blob_borrowed() && (w == v));
+
+            w.make_blob_owned();
+            CHECK(!w.is_blob_borrowed() && (w.get_blob_data() != large_blob) && (w == v));
+        }
+
+#if VOGL_HAS_MOVE_SEMANTICS
+        {
+            dynamic_string str("This string is too long to be stored in place");
+            const char *pBuf = str.get_ptr();
+
+            value v(std::move(str));
+            value w(std::move(v));
+            CHECK(!v.is_valid() && (w.get_string_ptr()->get_ptr() == pBuf));
+
+            vogl::vector<value> values;
+            values.push_back(std::move(w));
+            CHECK(values[0].get_string_ptr()->get_ptr() == pBuf);
+        }
+#endif
+
+        key_value_map src;
+        src.insert("small", value(small_blob, sizeof(small_blob)));
+        src.insert_blob("large", large_blob, sizeof(large_blob));
+        src.insert("str", "This string is too long to be stored in place");
+
+        uint8_vec buf(static_cast<uint>(src.get_serialize_size(false)));
+        CHECK(src.serialize_to_buffer(buf.get_ptr(), buf.size(), true, false) == static_cast<int>(buf.size()));
+
+        key_value_map *pDst = vogl_new(key_value_map);
+        pDst->set_blob_arena_mode(true);
+        CHECK(pDst->deserialize_from_buffer(buf.get_ptr(), buf.size(), true, false) == static_cast<int>(buf.size()));
+        CHECK(*pDst == src);
+
+        uint size;
+        const uint8 *pData = pDst->get_blob_data("large", size);
+        CHECK((size == sizeof(large_blob)) && !memcmp(pData, large_blob, size));
+        CHECK(pDst->get_blob_arena()->get_total_allocated() >= sizeof(large_blob));
+
+        // Copies must not reference the source map's arena once it's gone.
+        key_value_map copy(*pDst);
+        vogl_delete(pDst);
+
+        pData = copy.get_blob_data("large", size);
+        CHECK((size == sizeof(large_blob)) && !memcmp(pData, large_blob, size));
+        CHECK(copy == src);
+
+        // Arena chunks from a buffer pool go back to it when the map is destroyed.
+        concurrent_buffer_pool chunk_pool;
+        {
+            key_value_map pooled;
+            pooled.set_blob_arena_mode(true, &chunk_pool);
+            CHECK(pooled.deserialize_from_buffer(buf.get_ptr(), buf.size(), true, false) == static_cast<int>(buf.size()));
+            CHECK(pooled == src);
+            CHECK(pooled.get_blob_arena()->get_chunk_pool() == &chunk_pool);
+
+            key_value_map pooled_copy(pooled);
+            CHECK(pooled_copy.get_blob_arena()->get_chunk_pool() == &chunk_pool);
+            CHECK(pooled_copy == src);
+
+            const concurrent_freelist &chunk_list = chunk_pool.get_size_class_freelist(concurrent_buffer_pool::get_size_class(linear_allocator::cDefaultChunkSize));
+            CHECK(chunk_list.get_total_used_nodes() == 2);
+        }
+        CHECK(chunk_pool.get_size_class_freelist(concurrent_buffer_pool::get_size_class(linear_allocator::cDefaultChunkSize)).get_total_used_nodes() == 0);
+
+#undef CHECK
+        return true;
+    }
+
 } // namespace vogl
@@ -34,6 +34,7 @@
 #include "vogl_hash_map.h"
 #include "vogl_data_stream.h"
 #include "vogl_json.h"
+#include "vogl_linear_allocator.h"
 
 namespace vogl
 {
@@ -74,127 +75,187 @@ namespace vogl
             cFlagsHasUserData = 1
         };
 
+        // How the bytes of a cDTBlob are held: in a uint8_vec constructed inside the value, directly inside the value
+        // (small blobs), or as a non-owning view of memory owned by someone else (see set_blob_borrowed()).
+        enum blob_storage_type
+        {
+            cBlobStorageVec,
+            cBlobStorageInline,
+            cBlobStorageBorrowed
+        };
+
+        enum
+        {
+            // Strings, vectors and blob vectors are constructed in place in this many bytes, so they don't need their own heap block.
+            cStorageSize = 24
+        };
+
     public:
+        enum
+        {
+            // Blobs up to this size are stored inside the value itself (the last storage byte holds the size).
+            cMaxInlineBlobSize = cStorageSize - 1
+        };
+
         inline value()
             : m_uint64(0),
               m_user_data(0),
-              m_type(cDTInvalid),
-              m_flags(0)
+              m_flags(0),
+              m_blob_storage(cBlobStorageVec),
+              m_type(cDTInvalid)
         {
             VOGL_ASSUME(sizeof(float) == sizeof(int));
             VOGL_ASSUME(sizeof(double) == sizeof(uint64_t));
+            VOGL_ASSUME(sizeof(dynamic_string) <= cStorageSize);
+            VOGL_ASSUME(sizeof(uint8_vec) <= cStorageSize);
+            VOGL_ASSUME(sizeof(vec3F) <= cStorageSize);
         }
 
         inline value(const char *pStr)
-            : m_pStr(vogl_new(dynamic_string, pStr)), m_user_data(0), m_type(cDTString), m_flags(0)
+            : m_user_data(0), m_flags(0), m_blob_storage(cBlobStorageVec), m_type(cDTString)
         {
+            helpers::construct(str_ptr(), pStr);
         }
 
         inline value(const dynamic_string &str)
-            : m_pStr(vogl_new(dynamic_string, str)), m_user_data(0), m_type(cDTString), m_flags(0)
+            : m_user_data(0), m_flags(0), m_blob_storage(cBlobStorageVec), m_type(cDTString)
         {
+            helpers::construct(str_ptr(), str);
         }
 
         inline value(const uint8 *pBuf, uint size)
-            : m_pBlob(vogl_new(uint8_vec, size)), m_user_data(0), m_type(cDTBlob), m_flags(0)
+            : m_user_data(0), m_flags(0), m_blob_storage(cBlobStorageVec), m_type(cDTBlob)
         {
-            if (size)
-                memcpy(m_pBlob->get_ptr(), pBuf, size);
+            construct_blob(pBuf, size);
         }
 
         inline value(const uint8_vec &blob)
-            : m_pBlob(vogl_new(uint8_vec, blob)), m_user_data(0), m_type(cDTBlob), m_flags(0)
+            : m_user_data(0), m_flags(0), m_blob_storage(cBlobStorageVec), m_type(cDTBlob)
         {
+            construct_blob(blob.get_ptr(), blob.size());
         }
 
         inline value(const json_document &doc)
-            : m_pJSONDoc(vogl_new(json_document, doc)), m_user_data(0), m_type(cDTJSONDoc), m_flags(0)
+            : m_pJSONDoc(vogl_new(json_document, doc)), m_user_data(0), m_flags(0), m_blob_storage(cBlobStorageVec), m_type(cDTJSONDoc)
         {
         }
 
         inline explicit value(bool v)
-            : m_bool(v), m_user_data(0), m_type(cDTBool), m_flags(0)
+            : m_bool(v), m_user_data(0), m_flags(0), m_blob_storage(cBlobStorageVec), m_type(cDTBool)
         {
         }
 
         inline explicit value(void *p)
-            : m_pPtr(p), m_user_data(0), m_type(cDTVoidPtr), m_flags(0)
+            : m_pPtr(p), m_user_data(0), m_flags(0), m_blob_storage(cBlobStorageVec), m_type(cDTVoidPtr)
         {
         }
 
         inline value(int8 v)
-            : m_int8(v), m_user_data(0), m_type(cDTInt8), m_flags(0)
+            : m_int8(v), m_user_data(0), m_flags(0), m_blob_storage(cBlobStorageVec), m_type(cDTInt8)
         {
         }
 
         inline value(uint8 v)
-            : m_uint8(v), m_user_data(0), m_type(cDTUInt8), m_flags(0)
+            : m_uint8(v), m_user_data(0), m_flags(0), m_blob_storage(cBlobStorageVec), m_type(cDTUInt8)
         {
         }
 
         inline value(int16 v)
-            : m_int16(v), m_user_data(0), m_type(cDTInt16), m_flags(0)
+            : m_int16(v), m_user_data(0), m_flags(0), m_blob_storage(cBlobStorageVec), m_type(cDTInt16)
         {
         }
 
         inline value(uint16 v)
-            : m_uint16(v), m_user_data(0), m_type(cDTUInt16), m_flags(0)
+            : m_uint16(v), m_user_data(0), m_flags(0), m_blob_storage(cBlobStorageVec), m_type(cDTUInt16)
         {
         }
 
         inline value(int v)
-            : m_int(v), m_user_data(0), m_type(cDTInt), m_flags(0)
+            : m_int(v), m_user_data(0), m_flags(0), m_blob_storage(cBlobStorageVec), m_type(cDTInt)
         {
         }
 
         inline value(uint v)
-            : m_uint(v), m_user_data(0), m_type(cDTUInt), m_flags(0)
+            : m_uint(v), m_user_data(0), m_flags(0), m_blob_storage(cBlobStorageVec), m_type(cDTUInt)
         {
         }
 
         inline value(int64_t v)
-            : m_int64(v), m_user_data(0), m_type(cDTInt64), m_flags(0)
+            : m_int64(v), m_user_data(0), m_flags(0), m_blob_storage(cBlobStorageVec), m_type(cDTInt64)
         {
         }
 
         inline value(uint64_t v)
-            : m_uint64(v), m_user_data(0), m_type(cDTUInt64), m_flags(0)
+            : m_uint64(v), m_user_data(0), m_flags(0), m_blob_storage(cBlobStorageVec), m_type(cDTUInt64)
         {
         }
 
         inline value(float v)
-            : m_float(v), m_user_data(0), m_type(cDTFloat), m_flags(0)
+            : m_float(v), m_user_data(0), m_flags(0), m_blob_storage(cBlobStorageVec), m_type(cDTFloat)
         {
         }
 
         inline value(double v)
-            : m_double(v), m_user_data(0), m_type(cDTDouble), m_flags(0)
+            : m_double(v), m_user_data(0), m_flags(0), m_blob_storage(cBlobStorageVec), m_type(cDTDouble)
         {
         }
 
         inline value(const vec3F &v)
-            : m_pVec3F(vogl_new(vec3F, v)), m_user_data(0), m_type(cDTVec3F), m_flags(0)
+            : m_user_data(0), m_flags(0), m_blob_storage(cBlobStorageVec), m_type(cDTVec3F)
         {
+            helpers::construct(vec3F_ptr(), v);
         }
 
         inline value(const vec3I &v)
-            : m_pVec3I(vogl_new(vec3I, v)), m_user_data(0), m_type(cDTVec3I), m_flags(0)
+            : m_user_data(0), m_flags(0), m_blob_storage(cBlobStorageVec), m_type(cDTVec3I)
         {
+            helpers::construct(vec3I_ptr(), v);
         }
 
         inline value(const value &other)
-            : m_type(cDTInvalid),
-              m_flags(0)
+            : m_flags(0),
+              m_blob_storage(cBlobStorageVec),
+              m_type(cDTInvalid)
         {
             *this = other;
         }
 
         inline value(const string_hash &hash)
-            : m_user_data(0), m_type(cDTStringHash), m_flags(0)
+            : m_user_data(0), m_flags(0), m_blob_storage(cBlobStorageVec), m_type(cDTStringHash)
         {
             get_string_hash_ref() = hash;
         }
 
+#if VOGL_HAS_MOVE_SEMANTICS
+        // Takes other's contents, other is left invalid.
+        inline value(value &&other)
+            : m_user_data(0),
+              m_flags(0),
+              m_blob_storage(cBlobStorageVec),
+              m_type(cDTInvalid)
+        {
+            // swap() exchanges all of the storage, so other must not be left holding uninitialized bytes.
+            memset(m_storage, 0, sizeof(m_storage));
+            swap(other);
+        }
+
+        inline value(dynamic_string &&str)
+            : m_user_data(0), m_flags(0), m_blob_storage(cBlobStorageVec), m_type(cDTString)
+        {
+            helpers::construct_emplace(str_ptr(), std::move(str));
+        }
+
+        inline value &operator=(value &&other)
+        {
+            if (this != &other)
+            {
+                clear();
+                swap(other);
+            }
+            return *this;
+        }
+#endif
+
         inline ~value()
         {
             clear_dynamic();
@@ -312,13 +373,13 @@ namespace vogl
         inline void set_vec(const vec3F &v)
         {
             change_type(cDTVec3F);
-            m_pVec3F->set(v);
+            vec3F_ptr()->set(v);
         }
 
         inline void set_vec(const vec3I &v)
         {
             change_type(cDTVec3I);
-            m_pVec3I->set(v);
+            vec3I_ptr()->set(v);
         }
 
         inline void set_string(const char *pStr)
@@ -326,14 +387,21 @@ namespace vogl
             set_str(pStr);
         }
 
+        // Blobs up to cMaxInlineBlobSize bytes are copied into the value itself, larger blobs into a uint8_vec.
         inline bool set_blob(const uint8 *pBlob, uint size)
         {
-            change_type(cDTBlob);
-            if (!m_pBlob->try_resize(size))
-                return false;
-            if (size)
-                memcpy(m_pBlob->get_ptr(), pBlob, size);
-            return true;
+            if ((m_type == cDTBlob) && (m_blob_storage == cBlobStorageVec) && (size > cMaxInlineBlobSize))
+            {
+                // Reuse the existing vector's capacity
+                if (!blob_vec_ptr()->try_resize(size))
+                    return false;
+                memcpy(blob_vec_ptr()->get_ptr(), pBlob, size);
+                return true;
+            }
+
+            clear_dynamic();
+            m_type = cDTBlob;
+            return construct_blob(pBlob, size);
         }
 
         inline bool set_blob(const uint8_vec &v)
@@ -344,7 +412,29 @@ namespace vogl
         inline void set_blob_take_ownership(uint8_vec &v)
         {
             change_type(cDTBlob);
-            m_pBlob->swap(v);
+            ensure_blob_vec()->swap(v);
+        }
+
+        // Sets this value to a non-owning view of size bytes at pBlob. Nothing is copied, so the memory must outlive this value
+        // and any copies made of it (copies of a borrowed blob are also borrowed). Use make_blob_owned() to detach it.
+        inline void set_blob_borrowed(const uint8 *pBlob, uint size)
+        {
+            clear_dynamic();
+            m_type = cDTBlob;
+            m_blob_storage = cBlobStorageBorrowed;
+            m_borrowed_blob.m_pData = pBlob;
+            m_borrowed_blob.m_size = size;
+        }
+
+        // Copies the bytes of a borrowed blob into storage owned by this value. Does nothing for any other type.
+        inline bool make_blob_owned()
+        {
+            if ((m_type != cDTBlob) || (m_blob_storage != cBlobStorageBorrowed))
+                return true;
+
+            const uint8 *pData = m_borrowed_blob.m_pData;
+            uint size = m_borrowed_blob.m_size;
+            return construct_blob(pData, size);
         }
 
         inline bool set_json_document(const json_document &doc)
@@ -477,7 +567,7 @@ namespace vogl
         }
         inline dynamic_string *get_string_ptr() const
         {
-            return (m_type == cDTString) ? m_pStr : NULL;
+            return (m_type == cDTString) ? const_cast<dynamic_string *>(str_ptr()) : NULL;
         }
 
         // on failure, the destination val is NOT modified
@@ -582,14 +672,56 @@ namespace vogl
             return result;
         }
 
+        // Returns NULL for inline or borrowed blobs, use get_blob_data()/get_blob_size() unless you really need the vector.
         inline const uint8_vec *get_blob() const
         {
-            return (m_type == cDTBlob) ? m_pBlob : NULL;
+            return ((m_type == cDTBlob) && (m_blob_storage == cBlobStorageVec)) ? blob_vec_ptr() : NULL;
         }
 
+        // Moves inline or borrowed blobs into a vector first, so this only returns NULL if the value isn't a blob.
         inline uint8_vec *get_blob()
         {
-            return (m_type == cDTBlob) ? m_pBlob : NULL;
+            return (m_type == cDTBlob) ? ensure_blob_vec() : NULL;
+        }
+
+        // These work with every blob storage type. get_blob_data() returns NULL if the value isn't a blob.
+        inline const uint8 *get_blob_data() const
+        {
+            if (m_type != cDTBlob)
+                return NULL;
+
+            switch (m_blob_storage)
+            {
+                case cBlobStorageInline:
+                    return m_storage_bytes;
+                case cBlobStorageBorrowed:
+                    return m_borrowed_blob.m_pData;
+                default:
+                    break;
+            }
+            return blob_vec_ptr()->get_ptr();
+        }
+
+        inline uint get_blob_size() const
+        {
+            if (m_type != cDTBlob)
+                return 0;
+
+            switch (m_blob_storage)
+            {
+                case cBlobStorageInline:
+                    return m_storage_bytes[cMaxInlineBlobSize];
+                case cBlobStorageBorrowed:
+                    return m_borrowed_blob.m_size;
+                default:
+                    break;
+            }
+            return blob_vec_ptr()->size();
+        }
+
+        inline bool is_blob_borrowed() const
+        {
+            return (m_type == cDTBlob) && (m_blob_storage == cBlobStorageBorrowed);
         }
 
         inline void *get_void_ptr() const
@@ -617,7 +749,7 @@ namespace vogl
                 }
                 case cDTString:
                 {
-                    m_pStr->empty();
+                    str_ptr()->empty();
                     break;
                 }
                 case cDTBool:
@@ -642,17 +774,23 @@ namespace vogl
                 }
                 case cDTVec3F:
                 {
-                    m_pVec3F->clear();
+                    vec3F_ptr()->clear();
                     break;
                 }
                 case cDTVec3I:
                 {
-                    m_pVec3I->clear();
+                    vec3I_ptr()->clear();
                     break;
                 }
                 case cDTBlob:
                 {
-                    m_pBlob->clear();
+                    if (m_blob_storage == cBlobStorageVec)
+                        blob_vec_ptr()->clear();
+                    else
+                    {
+                        m_blob_storage = cBlobStorageInline;
+                        m_storage_bytes[cMaxInlineBlobSize] = 0;
+                    }
                     break;
                 }
                 case cDTJSONDoc:
@@ -698,7 +836,7 @@ namespace vogl
                 case cDTVec3I:
                     return 3;
                 case cDTBlob:
-                    return m_pBlob->size();
+                    return get_blob_size();
                 default:
                     break;
             }
@@ -736,13 +874,13 @@ namespace vogl
                 switch (m_type)
                 {
                     case cDTString:
-                        return m_pStr->get_ptr();
+                        return str_ptr()->get_ptr();
                     case cDTVec3F:
-                        return m_pVec3F;
+                        return vec3F_ptr();
                     case cDTVec3I:
-                        return m_pVec3I;
+                        return vec3I_ptr();
                     case cDTBlob:
-                        return m_pBlob->get_ptr();
+                        return get_blob_data();
                     case cDTJSONDoc:
                         return NULL;
                     default:
@@ -779,13 +917,13 @@ namespace vogl
                 case cDTVoidPtr:
                     return sizeof(void *);
                 case cDTString:
-                    return (m_pStr->get_len() + 1);
+                    return (str_ptr()->get_len() + 1);
                 case cDTVec3F:
                     return sizeof(vec3F);
                 case cDTVec3I:
                     return sizeof(vec3I);
                 case cDTBlob:
-                    return m_pBlob->size_in_bytes();
+                    return get_blob_size();
                 case cDTJSONDoc:
                     return 0;
                 default:
@@ -887,14 +1025,18 @@ namespace vogl
 
         uint get_serialize_size(bool serialize_user_data) const;
         int serialize(void *pBuf, uint buf_size, bool little_endian, bool serialize_user_data) const;
-        int deserialize(const void *pBuf, uint buf_size, bool little_endian, bool serialize_user_data);
+        // If pBlob_arena is not NULL, blobs too large to be stored inline are copied into the arena and referenced as borrowed views.
+        int deserialize(const void *pBuf, uint buf_size, bool little_endian, bool serialize_user_data, linear_allocator *pBlob_arena = NULL);
 
+        // Everything held inline is bitwise movable, so swapping the raw storage is safe.
         inline value &swap(value &other)
         {
-            std::swap(m_uint64, other.m_uint64);
+            for (uint i = 0; i < VOGL_ARRAY_SIZE(m_storage); i++)
+                std::swap(m_storage[i], other.m_storage[i]);
             std::swap(m_type, other.m_type);
             std::swap(m_user_data, other.m_user_data);
             std::swap(m_flags, other.m_flags);
+            std::swap(m_blob_storage, other.m_blob_storage);
             return *this;
         }
 
@@ -931,18 +1073,123 @@ namespace vogl
         }
 
     private:
+        inline dynamic_string *str_ptr()
+        {
+            return reinterpret_cast<dynamic_string *>(m_storage);
+        }
+        inline const dynamic_string *str_ptr() const
+        {
+            return reinterpret_cast<const dynamic_string *>(m_storage);
+        }
+
+        inline vec3F *vec3F_ptr()
+        {
+            return reinterpret_cast<vec3F *>(m_storage);
+        }
+        inline const vec3F *vec3F_ptr() const
+        {
+            return reinterpret_cast<const vec3F *>(m_storage);
+        }
+
+        inline vec3I *vec3I_ptr()
+        {
+            return reinterpret_cast<vec3I *>(m_storage);
+        }
+        inline const vec3I *vec3I_ptr() const
+        {
+            return reinterpret_cast<const vec3I *>(m_storage);
+        }
+
+        inline uint8_vec *blob_vec_ptr()
+        {
+            VOGL_ASSERT(m_blob_storage == cBlobStorageVec);
+            return reinterpret_cast<uint8_vec *>(m_storage);
+        }
+        inline const uint8_vec *blob_vec_ptr() const
+        {
+            VOGL_ASSERT(m_blob_storage == cBlobStorageVec);
+            return reinterpret_cast<const uint8_vec *>(m_storage);
+        }
+
+        // m_type must already be cDTBlob, and the blob storage must not be constructed yet.
+        // On allocation failure the blob is left empty and false is returned.
+        inline bool construct_blob(const uint8 *pBlob, uint size)
+        {
+            uint8 *pDst = construct_uninitialized_blob(size);
+            if (!pDst)
+                return false;
+            if (size)
+                memcpy(pDst, pBlob, size);
+            return true;
+        }
+
+        inline uint8 *construct_uninitialized_blob(uint size)
+        {
+            VOGL_ASSERT(m_type == cDTBlob);
+
+            if (size <= cMaxInlineBlobSize)
+            {
+                m_blob_storage = cBlobStorageInline;
+                m_storage_bytes[cMaxInlineBlobSize] = static_cast<uint8>(size);
+                return m_storage_bytes;
+            }
+
+            m_blob_storage = cBlobStorageVec;
+            uint8_vec *pVec = helpers::construct(blob_vec_ptr());
+            if (!pVec->try_resize(size))
+                return NULL;
+            return pVec->get_ptr();
+        }
+
+        // Changes the value to an uninitialized blob of the specified size, returns NULL on allocation failure.
+        inline uint8 *init_blob(uint size)
+        {
+            clear_dynamic();
+            m_type = cDTBlob;
+            return construct_uninitialized_blob(size);
+        }
+
+        // Converts inline or borrowed blobs to vector storage.
+        inline uint8_vec *ensure_blob_vec()
+        {
+            VOGL_ASSERT(m_type == cDTBlob);
+
+            if (m_blob_storage != cBlobStorageVec)
+            {
+                uint size = get_blob_size();
+
+                uint8 temp[cMaxInlineBlobSize];
+                const uint8 *pSrc = get_blob_data();
+                if (m_blob_storage == cBlobStorageInline)
+                {
+                    memcpy(temp, pSrc, size);
+                    pSrc = temp;
+                }
+
+                m_blob_storage = cBlobStorageVec;
+                uint8_vec *pVec = helpers::construct(blob_vec_ptr());
+                if (size)
+                    pVec->append(pSrc, size);
+            }
+
+            return blob_vec_ptr();
+        }
+
         inline void clear_dynamic()
         {
             if (m_type >= cDTFirstDynamic)
             {
                 if (m_type == cDTVec3F)
-                    vogl_delete(m_pVec3F);
+                    helpers::destruct(vec3F_ptr());
                 else if (m_type == cDTVec3I)
-                    vogl_delete(m_pVec3I);
+                    helpers::destruct(vec3I_ptr());
                 else if (m_type == cDTString)
-                    vogl_delete(m_pStr);
+                    helpers::destruct(str_ptr());
                 else if (m_type == cDTBlob)
-                    vogl_delete(m_pBlob);
+                {
+                    if (m_blob_storage == cBlobStorageVec)
+                        helpers::destruct(blob_vec_ptr());
+                }
                 else if (m_type == cDTJSONDoc)
                     vogl_delete(m_pJSONDoc);
                 else
@@ -952,6 +1199,7 @@ namespace vogl
 
                 m_pPtr = NULL;
                 m_type = cDTInvalid;
+                m_blob_storage = cBlobStorageVec;
             }
         }
 
@@ -967,16 +1215,16 @@ namespace vogl
                     switch (m_type)
                     {
                         case cDTString:
-                            m_pStr = vogl_new(dynamic_string);
+                            helpers::construct(str_ptr());
                             break;
                         case cDTVec3F:
-                            m_pVec3F = vogl_new(vec3F);
+                            helpers::construct(vec3F_ptr());
                             break;
                         case cDTVec3I:
-                            m_pVec3I = vogl_new(vec3I);
+                            helpers::construct(vec3I_ptr());
                             break;
                         case cDTBlob:
-                            m_pBlob = vogl_new(uint8_vec);
+                            helpers::construct(blob_vec_ptr());
                             break;
                         case cDTJSONDoc:
                             m_pJSONDoc = vogl_new(json_document);
@@ -991,26 +1239,26 @@ namespace vogl
         inline void set_str(const dynamic_string &s)
         {
             if (m_type == cDTString)
-                m_pStr->set(s);
+                str_ptr()->set(s);
             else
             {
                 clear_dynamic();
 
                 m_type = cDTString;
-                m_pStr = vogl_new(dynamic_string, s);
+                helpers::construct(str_ptr(), s);
             }
         }
 
         inline void set_str(const char *p)
         {
             if (m_type == cDTString)
-                m_pStr->set(p);
+                str_ptr()->set(p);
             else
             {
                 clear_dynamic();
 
                 m_type = cDTString;
-                m_pStr = vogl_new(dynamic_string, p);
+                helpers::construct(str_ptr(), p);
             }
         }
 
@@ -1034,11 +1282,17 @@ namespace vogl
             double m_double;
             void *m_pPtr;
 
-            vec3F *m_pVec3F;
-            vec3I *m_pVec3I;
-            dynamic_string *m_pStr;
-            uint8_vec *m_pBlob;
             json_document *m_pJSONDoc;
+
+            struct
+            {
+                const uint8 *m_pData;
+                uint m_size;
+            } m_borrowed_blob;
+
+            // cDTString, cDTVec3F, cDTVec3I and vector blobs are constructed in place here, inline blobs are copied here.
+            uint8 m_storage_bytes[cStorageSize];
+            uint64_t m_storage[cStorageSize / sizeof(uint64_t)];
         };
 
         const string_hash &get_string_hash_ref() const
@@ -1054,10 +1308,13 @@ namespace vogl
 
         // I'm torn about m_user_data/m_flags - may not be useful, but there's room for it due to alignment.
         uint16 m_user_data;
-        value_data_type m_type;
         uint8 m_flags;
+        uint8 m_blob_storage;
+        value_data_type m_type;
     };
 
+    VOGL_DEFINE_BITWISE_MOVABLE(value);
+
     typedef vogl::vector<value> value_vector;
 
     template <>
@@ -1078,27 +1335,65 @@ namespace vogl
         typedef value_to_value_hash_map::const_iterator const_iterator;
 
         inline key_value_map()
+            : m_pBlob_arena(NULL)
         {
         }
 
         inline ~key_value_map()
         {
             clear();
+            vogl_delete(m_pBlob_arena);
         }
 
         inline key_value_map(const key_value_map &other)
+            : m_pBlob_arena(other.m_pBlob_arena ? vogl_new(linear_allocator, linear_allocator::cDefaultChunkSize, other.m_pBlob_arena->get_chunk_pool()) : NULL)
         {
             *this = other;
         }
 
+        // Borrowed blobs are never shared between maps: they're copied into this map's arena (if enabled), or made owned.
         inline key_value_map &operator=(const key_value_map &rhs)
         {
             if (this == &rhs)
                 return *this;
             m_key_values = rhs.m_key_values;
+            if (m_pBlob_arena)
+                m_pBlob_arena->reset();
+            rehome_borrowed_blobs();
             return *this;
         }
 
+        // In arena mode, blobs deserialized into this map (or added with insert_blob()) which are too large to be stored
+        // inline are copied into a chunked arena owned by the map, and the values reference them as borrowed blobs.
+        // clear()/reset() recycle the arena, so repeatedly building or deserializing maps performs no per-entry heap allocations.
+        // Disabling arena mode converts any borrowed blobs into owned blobs.
+        // If pChunk_pool is not NULL the arena's chunks come from this pool (see linear_allocator). It's ignored if arena mode is already enabled.
+        inline void set_blob_arena_mode(bool enabled, concurrent_buffer_pool *pChunk_pool = NULL)
+        {
+            if (enabled)
+            {
+                if (!m_pBlob_arena)
+                    m_pBlob_arena = vogl_new(linear_allocator, linear_allocator::cDefaultChunkSize, pChunk_pool);
+            }
+            else if (m_pBlob_arena)
+            {
+                linear_allocator *pArena = m_pBlob_arena;
+                m_pBlob_arena = NULL;
+                rehome_borrowed_blobs();
+                vogl_delete(pArena);
+            }
+        }
+
+        inline bool get_blob_arena_mode() const
+        {
+            return m_pBlob_arena != NULL;
+        }
+
+        inline const linear_allocator *get_blob_arena() const
+        {
+            return m_pBlob_arena;
+        }
+
         inline bool operator==(const key_value_map &other) const
         {
             if (m_key_values.size() != other.m_key_values.size())
@@ -1137,11 +1432,15 @@ namespace vogl
         inline void clear()
         {
             m_key_values.clear();
+            if (m_pBlob_arena)
+                m_pBlob_arena->clear();
         }
 
         inline void reset()
         {
             m_key_values.reset();
+            if (m_pBlob_arena)
+                m_pBlob_arena->reset();
         }
 
         inline void reserve(uint new_capacity)
@@ -1206,7 +1505,7 @@ namespace vogl
 
         inline int deserialize_from_buffer(const void *pBuf, uint buf_size, bool little_endian, bool serialize_user_data)
         {
-            m_key_values.reset();
+            reset();
 
             uint buf_left = buf_size;
 
@@ -1235,7 +1534,7 @@ namespace vogl
                 buf_left -= num_bytes_read;
 
                 value val;
-                num_bytes_read = val.deserialize(pBuf, buf_left, little_endian, serialize_user_data);
+                num_bytes_read = val.deserialize(pBuf, buf_left, little_endian, serialize_user_data, m_pBlob_arena);
                 if (num_bytes_read < 0)
                     return -1;
 
@@ -1312,6 +1611,20 @@ namespace vogl
             return m_key_values.insert(key, val);
         }
 
+        // Copies the blob into the arena in arena mode (see set_blob_arena_mode()), otherwise this is the same as insert(key, value(pData, size)).
+        inline value_to_value_hash_map::insert_result insert_blob(const value &key, const void *pData, uint size)
+        {
+            value_to_value_hash_map::insert_result res(m_key_values.insert(key, value()));
+            value &val = res.first->second;
+
+            if ((m_pBlob_arena) && (size > value::cMaxInlineBlobSize))
+                val.set_blob_borrowed(static_cast<const uint8 *>(m_pBlob_arena->alloc_and_copy(pData, size)), size);
+            else
+                val.set_blob(static_cast<const uint8 *>(pData), size);
+
+            return res;
+        }
+
         inline iterator find(const value &key)
         {
             return m_key_values.find(key);
@@ -1413,6 +1726,9 @@ namespace vogl
         inline const uint8_vec *get_blob(const value &key) const;
         inline uint8_vec *get_blob(const value &key);
 
+        // Works with all blob storage types, returns NULL (and sets size to 0) if the key isn't found or isn't a blob.
+        inline const uint8 *get_blob_data(const value &key, uint &size) const;
+
         inline const json_document *get_json_document(const value &key) const;
         inline json_document *get_json_document(const value &key);
 
@@ -1470,6 +1786,28 @@ namespace vogl
 
     private:
         value_to_value_hash_map m_key_values;
+        linear_allocator *m_pBlob_arena;
+
+        inline void rehome_borrowed_blob(value &v)
+        {
+            if (!v.is_blob_borrowed())
+                return;
+
+            if ((m_pBlob_arena) && (v.get_blob_size() > value::cMaxInlineBlobSize))
+                v.set_blob_borrowed(static_cast<const uint8 *>(m_pBlob_arena->alloc_and_copy(v.get_blob_data(), v.get_blob_size())), v.get_blob_size());
+            else
+                v.make_blob_owned();
+        }
+
+        inline void rehome_borrowed_blobs()
+        {
+            for (iterator it = begin(); it != end(); ++it)
+            {
+                // Changing the blob's storage doesn't change the key's hash or ordering.
+                rehome_borrowed_blob(const_cast<value &>(it->first));
+                rehome_borrowed_blob(it->second);
+            }
+        }
     };
 
     inline bool key_value_map::get_string_if_found(const value &key, dynamic_string &dst, bool quote_strings) const
@@ -1585,6 +1923,18 @@ namespace vogl
         return it->second.get_blob();
     }
 
+    inline const uint8 *key_value_map::get_blob_data(const value &key, uint &size) const
+    {
+        size = 0;
+
+        const_iterator it = m_key_values.find(key);
+        if (it == m_key_values.end())
+            return NULL;
+
+        size = it->second.get_blob_size();
+        return it->second.get_blob_data();
+    }
+
     inline const json_document *key_value_map::get_json_document(const value &key) const
     {
         const_iterator it = m_key_values.find(key);
@@ -1601,4 +1951,6 @@ namespace vogl
         return it->second.get_json_document();
     }
 
+    bool value_test();
+
 } // namespace vogl
@@ -115,4 +115,59 @@ namespace vogl
         return true;
     }
 
+#define CHECK(x)                         \
+    if (!(x))                            \
+    {                                    \
+        vogl_debug_break_if_debugging(); \
+        return false;                    \
+    }
+
+    // Mirrors how trace packets are queued: a reused read buffer is handed over to a packet array, which then grows.
+    bool vector_move_test()
+    {
+        random r;
+        r.seed(1000);
+
+        vogl::vector<uint8_vec> packets;
+        vogl::vector<const uint8 *> packet_ptrs;
+
+        uint8_vec read_buf;
+        for (uint i = 0; i < 1000; i++)
+        {
+            read_buf.resize(r.irand_inclusive(1, 4096));
+            read_buf[0] = static_cast<uint8>(i);
+
+            const uint8 *pRead_buf = read_buf.get_ptr();
+            const uint read_buf_capacity = read_buf.capacity();
+
+            packets.push_back(VOGL_MOVE(read_buf));
+
+#if VOGL_HAS_MOVE_SEMANTICS
+            // The packet must own the read buffer's original allocation: no new buffer, no copy.
+            CHECK(packets.back().get_ptr() == pRead_buf);
+            CHECK(packets.back().capacity() == read_buf_capacity);
+            CHECK(read_buf.is_empty() && !read_buf.get_ptr());
+#else
+            VOGL_NOTE_UNUSED(pRead_buf);
+            VOGL_NOTE_UNUSED(read_buf_capacity);
+#endif
+
+            packet_ptrs.push_back(packets.back().get_ptr());
+        }
+
+        // Growing the packet array relocates the element headers, never the packet data.
+        for (uint i = 0; i < packets.size(); i++)
+        {
+            CHECK(packets[i][0] == static_cast<uint8>(i));
+            CHECK(packets[i].get_ptr() == packet_ptrs[i]);
+        }
+
+        packets.erase(0U);
+        CHECK(packets[0].get_ptr() == packet_ptrs[1]);
+
+        return true;
+    }
+
+#undef CHECK
+
 } // namespace vogl
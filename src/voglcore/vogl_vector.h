@@ -99,6 +99,29 @@ namespace vogl
             resize(size);
         }
 
+#if VOGL_HAS_MOVE_SEMANTICS
+        // Takes other's heap block, other is left empty.
+        inline vector(vector &&other)
+            : m_p(other.m_p),
+              m_size(other.m_size),
+              m_capacity(other.m_capacity)
+        {
+            other.m_p = NULL;
+            other.m_size = 0;
+            other.m_capacity = 0;
+        }
+
+        inline vector &operator=(vector &&other)
+        {
+            if (this != &other)
+            {
+                clear();
+                swap(other);
+            }
+            return *this;
+        }
+#endif
+
         inline ~vector()
         {
             if (m_p)
@@ -363,6 +386,32 @@ namespace vogl
             m_size++;
         }
 
+#if VOGL_HAS_MOVE_SEMANTICS
+        inline void push_back(T &&obj)
+        {
+            VOGL_ASSERT(!m_p || (&obj < m_p) || (&obj >= (m_p + m_size)));
+
+            if (m_size >= m_capacity)
+                increase_capacity(m_size + 1, true);
+
+            new (static_cast<void *>(m_p + m_size)) T(std::move(obj));
+            m_size++;
+        }
+
+        // Constructs a new element at the end of the container from the supplied arguments.
+        // Like push_back(), the arguments must not refer to elements inside the container.
+        template <typename... Args>
+        inline T &emplace_back(Args &&... args)
+        {
+            if (m_size >= m_capacity)
+                increase_capacity(m_size + 1, true);
+
+            T *p = helpers::construct_emplace(m_p + m_size, std::forward<Args>(args)...);
+            m_size++;
+            return *p;
+        }
+#endif
+
         inline bool try_push_back(const T &obj)
         {
             VOGL_ASSERT(!m_p || (&obj < m_p) || (&obj >= (m_p + m_size)));
@@ -417,13 +466,13 @@ namespace vogl
             }
             else
             {
-                const T *pSrc = m_p + orig_size - 1;
-                T *pDst = const_cast<T *>(pSrc) + n;
+                T *pSrc = m_p + orig_size - 1;
+                T *pDst = pSrc + n;
 
                 for (uint i = 0; i < num_to_move; i++)
                 {
                     VOGL_ASSERT((pDst - m_p) < (int)m_size);
-                    *pDst-- = *pSrc--;
+                    *pDst-- = VOGL_MOVE(*pSrc--);
                 }
             }
 
@@ -450,6 +499,35 @@ namespace vogl
             insert(index, &obj, 1);
         }
 
+#if VOGL_HAS_MOVE_SEMANTICS
+        inline void insert(uint index, T &&obj)
+        {
+            VOGL_ASSERT(index <= m_size);
+
+            push_back(std::move(obj));
+
+            // Rotate the new element down into place.
+            const uint last = m_size - 1;
+            if (index == last)
+                return;
+
+            if (type_is_bitwise_copyable_or_movable())
+            {
+                uint8 tmp[sizeof(T)];
+                memcpy(tmp, reinterpret_cast<const void *>(m_p + last), sizeof(T));
+                memmove(reinterpret_cast<void *>(m_p + index + 1), reinterpret_cast<const void *>(m_p + index), sizeof(T) * (last - index));
+                memcpy(reinterpret_cast<void *>(m_p + index), tmp, sizeof(T));
+            }
+            else
+            {
+                T tmp(std::move(m_p[last]));
+                for (uint i = last; i > index; i--)
+                    m_p[i] = std::move(m_p[i - 1]);
+                m_p[index] = std::move(tmp);
+            }
+        }
+#endif
+
         // push_front() isn't going to be very fast - it's only here for usability.
         inline void push_front(const T &obj)
         {
@@ -484,7 +562,7 @@ namespace vogl
 
             T *pDst = m_p + start;
 
-            const T *pSrc = m_p + start + n;
+            T *pSrc = m_p + start + n;
 
             if (type_is_bitwise_copyable_or_movable())
             {
@@ -497,7 +575,7 @@ namespace vogl
                 }
 
                 // Copy "down" the objects to preserve, filling in the empty slots.
-                memmove(pDst, pSrc, num_to_move * sizeof(T));
+                memmove(static_cast<void *>(pDst), pSrc, num_to_move * sizeof(T));
             }
             else
             {
@@ -505,7 +583,7 @@ namespace vogl
                 // Move them down one at a time by using the equals operator, and destroying anything that's left over at the end.
                 T *pDst_end = pDst + num_to_move;
                 while (pDst != pDst_end)
-                    *pDst++ = *pSrc++;
+                    *pDst++ = VOGL_MOVE(*pSrc++);
 
                 scalar_type<T>::destruct_array(pDst_end, n);
             }
@@ -529,7 +607,7 @@ namespace vogl
             VOGL_ASSERT(index < m_size);
 
             if ((index + 1) < m_size)
-                (*this)[index] = back();
+                (*this)[index] = VOGL_MOVE(back());
 
             pop_back();
         }
@@ -929,7 +1007,7 @@ namespace vogl
             while (pSrc != pSrc_end)
             {
                 // placement new
-                new (static_cast<void *>(pDst)) T(*pSrc);
+                new (static_cast<void *>(pDst)) T(VOGL_MOVE(*pSrc));
                 pSrc->~T();
                 ++pSrc;
                 ++pDst;
@@ -987,6 +1065,8 @@ namespace vogl
         a.swap(b);
     }
 
+    bool vector_move_test();
+
 #if 0
 inline void vector_test()
 {
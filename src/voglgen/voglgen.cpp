@@ -40,6 +40,7 @@
 #include "vogl_regex.h"
 #include "vogl_hash_map.h"
 #include <set>
+#include <map>
 
 #include "vogl_port.h"
 
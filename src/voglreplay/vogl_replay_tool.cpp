@@ -127,6 +127,9 @@ static command_line_param_desc g_command_line_param_descs[] =
         { "loop_count", 1, false, "Replay: loop mode's loop count" },
         { "draw_kill_max_thresh", 1, false, "Replay: Enable draw kill mode during looping to visualize order of draws, sets the max # of draws before counter resets to 0" },
         { "disable_frontbuffer_restore", 0, false, "Replay: Do not restore the front buffer's contents when restoring a state snapshot" },
+        { "batch_immediate_mode", 0, false, "Replay: Replay glBegin/glEnd blocks that only specify vertices, colors, normals and texcoords as single glDrawArrays calls" },
+        { "offscreen", 0, false, "Replay: Render the default framebuffer to an offscreen pbuffer sized to the trace's window, so window resizes never wait on the window manager" },
+        { "offscreen_present", 0, false, "Replay: Used with -offscreen, blits each frame to the (fixed size) replay window" },
 
         // find specific
         { "find_func", 1, false, "Find: Limit the find to only the specified function name POSIX regex pattern" },
@@ -642,6 +645,8 @@ static uint get_replayer_flags_from_command_line_params(bool interactive_mode)
               { "dump_framebuffer_on_draw", cGLReplayerDumpFramebufferOnDraws },
               { "clear_uninitialized_bufs", cGLReplayerClearUnintializedBuffers },
               { "disable_frontbuffer_restore", cGLReplayerDisableRestoreFrontBuffer },
+              { "batch_immediate_mode", cGLReplayerBatchImmediateMode },
+              { "offscreen_present", cGLReplayerOffscreenPresent },
           };
 
     for (uint i = 0; i < sizeof(s_replayer_command_line_params) / sizeof(s_replayer_command_line_params[0]); i++)
@@ -690,7 +695,7 @@ static uint get_replayer_flags_from_command_line_params(bool interactive_mode)
         // TODO: This will create a window with default attributes, which seems fine for the majority of traces.
         // Unfortunately, some GL call streams *don't* want an alpha channel, or depth, or stencil etc. in the default framebuffer so this may become a problem.
         // Also, this design only supports a single window, which is going to be a problem with multiple window traces.
-        if (!window.open(g_command_line_params().get_value_as_int("width", 0, 1024, 1, 65535), g_command_line_params().get_value_as_int("height", 0, 768, 1, 65535), g_command_line_params().get_value_as_int("msaa", 0, 0, 0, 65535)))
+        if (!window.open(g_command_line_params().get_value_as_int("width", 0, 1024, 1, 65535), g_command_line_params().get_value_as_int("height", 0, 768, 1, 65535), g_command_line_params().get_value_as_int("msaa", 0, 0, 0, 65535), g_command_line_params().get_value_as_bool("offscreen")))
         {
             vogl_error_printf("%s: Failed initializing replay window\n", VOGL_FUNCTION_INFO_CSTR);
             return false;
@@ -1989,6 +1994,8 @@ static bool tool_dump_mode()
     }
 
     const bool full_verification = g_command_line_params().get_value_as_bool("verify");
+    const bool debug_packets = g_command_line_params().get_value_as_bool("debug");
+    const bool write_debug_info = g_command_line_params().get_value_as_bool("write_debug_info");
 
     vogl_ctypes trace_gl_ctypes;
     trace_gl_ctypes.init(pTrace_reader->get_sof_packet().m_pointer_sizes);
@@ -2126,7 +2133,7 @@ static bool tool_dump_mode()
         const char *pFunc_name = g_vogl_entrypoint_descs[gl_packet.m_entrypoint_id].m_pName;
         VOGL_NOTE_UNUSED(pFunc_name);
 
-        if (g_command_line_params().get_value_as_bool("debug"))
+        if (debug_packets)
         {
             vogl_debug_printf("Trace packet: File offset: %" PRIu64 ", Total size %u, Param size: %u, Client mem size %u, Name value size %u, call %" PRIu64 ", ID: %s (%u), Thread ID: 0x%" PRIX64 ", Trace Context: 0x%" PRIX64 "\n",
                              cur_packet_ofs,
@@ -2156,7 +2163,7 @@ static bool tool_dump_mode()
         serialize_params.m_output_basename = file_utils::get_filename(output_base_filename.get_ptr());
         serialize_params.m_pBlob_manager = &output_file_blob_manager;
         serialize_params.m_cur_frame = cur_file_index;
-        serialize_params.m_write_debug_info = g_command_line_params().get_value_as_bool("write_debug_info");
+        serialize_params.m_write_debug_info = write_debug_info;
         if (!gl_packet_cracker.json_serialize(new_node, serialize_params))
         {
             vogl_error_printf("JSON serialization failed!\n");
@@ -32,10 +32,18 @@
 #include "vogl_bigint128.h"
 #include "vogl_sparse_vector.h"
 #include "vogl_sort.h"
+#include "vogl_parallel_sort.h"
 #include "vogl_hash_map.h"
 #include "vogl_map.h"
+#include "vogl_btree_map.h"
 #include "vogl_md5.h"
 #include "vogl_rh_hash_map.h"
+#include "vogl_value.h"
+#include "vogl_concurrent_pool.h"
+#include "vogl_image_utils.h"
+#include "vogl_ktx_texture.h"
+#include "vogl_miniz_parallel.h"
+#include "vogl_interval_set.h"
 
 //$ TODO?
 //#include "vogl_timer.h"
@@ -60,15 +68,24 @@ static const struct test_data_t g_tests[] =
 #define DEFTEST2(_x) { #_x, NULL, _x ## _test }
     DEFTEST(rh_hash_map),
     DEFTEST(object_pool),
+    DEFTEST(concurrent_pool),
     DEFTEST(dynamic_string),
+    DEFTEST(vector_move),
     DEFTEST(md5),
     DEFTEST(introsort),
+    DEFTEST(parallel_sort),
     DEFTEST(rand),
     DEFTEST(regexp),
     DEFTEST(strutils),
     DEFTEST(map),
+    DEFTEST(btree_map),
     DEFTEST(hash_map),
     DEFTEST(sort),
+    DEFTEST(value),
+    DEFTEST(image_utils),
+    DEFTEST(ktx_texture),
+    DEFTEST(mz_parallel),
+    DEFTEST(interval_set),
     DEFTEST2(sparse_vector),
     DEFTEST2(bigint128),
 #undef DEFTEST
@@ -35,6 +35,8 @@
 
 // voglcore
 #include "vogl_hash_map.h"
+#include "vogl_concurrent_pool.h"
+#include "vogl_interval_set.h"
 #include "vogl_console.h"
 #include "vogl_colorized_console.h"
 #include "vogl_command_line_params.h"
@@ -177,8 +179,38 @@ static command_line_param_desc g_command_line_param_descs[] =
         { "vogl_backtrace_no_calls", 0, false, NULL },
         { "vogl_exit_after_x_frames", 1, false, NULL },
         { "vogl_traceport", 1, false, NULL },
+        { "vogl_snapshot_texture_budget_mb", 1, false, NULL },
+        { "vogl_snapshot_static_buffer_limit_mb", 1, false, NULL },
     };
 
+// Ids of the params checked on every swap or context creation, resolved once after the command line is parsed.
+static struct vogl_hot_param_ids
+{
+    // Every id starts out invalid (not 0, which is a real param id) until vogl_init_command_line_params() resolves them.
+    vogl_hot_param_ids()
+        : m_dump_png_screenshots(command_line_params::cInvalidParamID),
+          m_dump_jpeg_screenshots(command_line_params::cInvalidParamID),
+          m_jpeg_quality(command_line_params::cInvalidParamID),
+          m_screenshot_prefix(command_line_params::cInvalidParamID),
+          m_hash_backbuffer(command_line_params::cInvalidParamID),
+          m_dump_backbuffer_hashes(command_line_params::cInvalidParamID),
+          m_sum_hashing(command_line_params::cInvalidParamID),
+          m_force_debug_context(command_line_params::cInvalidParamID),
+          m_exit_after_x_frames(command_line_params::cInvalidParamID)
+    {
+    }
+
+    int m_dump_png_screenshots;
+    int m_dump_jpeg_screenshots;
+    int m_jpeg_quality;
+    int m_screenshot_prefix;
+    int m_hash_backbuffer;
+    int m_dump_backbuffer_hashes;
+    int m_sum_hashing;
+    int m_force_debug_context;
+    int m_exit_after_x_frames;
+} g_param_ids;
+
 //----------------------------------------------------------------------------------------------------------------------
 // Globals
 //----------------------------------------------------------------------------------------------------------------------
@@ -202,6 +234,10 @@ static bool g_vogl_stop_capturing;
 static vogl_capture_status_callback_func_ptr g_vogl_pCapture_status_callback;
 static void *g_vogl_pCapture_status_opaque;
 
+// Costs of the most recently written state snapshot, protected by the trace mutex.
+static vogl_snapshot_stats g_vogl_last_snapshot_stats;
+static bool g_vogl_has_last_snapshot_stats;
+
 static vogl_trace_file_writer& get_vogl_trace_writer()
 {
     // If we wind up having issues with destructor ordering, we could changed these
@@ -240,6 +276,14 @@ static vogl_intercept_data &get_vogl_intercept_data()
     return s_data;
 }
 
+// Shared by all threads: trace packet key/value blob arena chunks, and temporary client memory buffers (through each thread's magazine).
+// This purposely leaks, because thread local data (and the packets it owns) can be destroyed after static destructors have run.
+static concurrent_buffer_pool &get_vogl_trace_buffer_pool()
+{
+    static concurrent_buffer_pool *s_pBuffer_pool = vogl_new(concurrent_buffer_pool);
+    return *s_pBuffer_pool;
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 // vogl_get_current_kernel_thread_id
 //----------------------------------------------------------------------------------------------------------------------
@@ -257,13 +301,13 @@ class vogl_entrypoint_serializer
 
 public:
     inline vogl_entrypoint_serializer()
-        : m_packet(&get_vogl_process_gl_ctypes()),
+        : m_packet(&get_vogl_process_gl_ctypes(), &get_vogl_trace_buffer_pool()),
           m_in_begin(false)
     {
     }
 
     inline vogl_entrypoint_serializer(gl_entrypoint_id_t id, vogl_context *pContext)
-        : m_packet(&get_vogl_process_gl_ctypes()),
+        : m_packet(&get_vogl_process_gl_ctypes(), &get_vogl_trace_buffer_pool()),
           m_in_begin(false)
     {
         begin(id, pContext);
@@ -408,6 +452,15 @@ private:
     bool m_in_begin;
 };
 
+typedef concurrent_object_pool<vogl_entrypoint_serializer> vogl_entrypoint_serializer_pool;
+
+// Out of band serializers (see vogl_scoped_entrypoint_serializer) come from here. Purposely leaks, see get_vogl_trace_buffer_pool().
+static vogl_entrypoint_serializer_pool &get_vogl_serializer_pool()
+{
+    static vogl_entrypoint_serializer_pool *s_pSerializer_pool = vogl_new(vogl_entrypoint_serializer_pool);
+    return *s_pSerializer_pool;
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 // struct vogl_thread_local_data
 //----------------------------------------------------------------------------------------------------------------------
@@ -416,6 +469,8 @@ class vogl_thread_local_data
 public:
     vogl_thread_local_data()
         : m_pContext(NULL),
+          m_serializer_magazine(get_vogl_serializer_pool()),
+          m_buffer_magazine(get_vogl_trace_buffer_pool()),
           m_calling_driver_entrypoint_id(VOGL_ENTRYPOINT_INVALID)
     {
     }
@@ -428,6 +483,10 @@ public:
     vogl_context *m_pContext;
     vogl_entrypoint_serializer m_serializer;
 
+    // Per-thread caches in front of the shared serializer and buffer pools, so most allocations don't touch the shared free stacks.
+    vogl_entrypoint_serializer_pool::magazine m_serializer_magazine;
+    concurrent_buffer_pool::magazine m_buffer_magazine;
+
     // Set to a valid entrypoint ID if we're currently trying to call the driver on this thread. The "direct" GL function wrappers (in
     // vogl_entrypoints.cpp) call our vogl_direct_gl_func_prolog/epilog func callbacks below, which manipulate this member.
     gl_entrypoint_id_t m_calling_driver_entrypoint_id;
@@ -457,6 +516,43 @@ static VOGL_FORCE_INLINE vogl_thread_local_data *vogl_get_or_create_thread_local
     return pTLS_data;
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+// class vogl_scoped_entrypoint_serializer
+// Serializer for packets written outside of the usual BEGIN/END macros, while the thread's own serializer may be busy.
+// The serializer comes from the thread's serializer magazine instead of the stack (trace packets are large).
+//----------------------------------------------------------------------------------------------------------------------
+class vogl_scoped_entrypoint_serializer
+{
+    VOGL_NO_COPY_OR_ASSIGNMENT_OP(vogl_scoped_entrypoint_serializer);
+
+public:
+    inline vogl_scoped_entrypoint_serializer()
+        : m_magazine(vogl_get_or_create_thread_local_data()->m_serializer_magazine),
+          m_pSerializer(m_magazine.alloc())
+    {
+    }
+
+    inline vogl_scoped_entrypoint_serializer(gl_entrypoint_id_t id, vogl_context *pContext)
+        : m_magazine(vogl_get_or_create_thread_local_data()->m_serializer_magazine),
+          m_pSerializer(m_magazine.alloc(id, pContext))
+    {
+    }
+
+    inline ~vogl_scoped_entrypoint_serializer()
+    {
+        m_magazine.destroy(m_pSerializer);
+    }
+
+    inline vogl_entrypoint_serializer &get()
+    {
+        return *m_pSerializer;
+    }
+
+private:
+    vogl_entrypoint_serializer_pool::magazine &m_magazine;
+    vogl_entrypoint_serializer *m_pSerializer;
+};
+
 //----------------------------------------------------------------------------------------------------------------------
 // tls_thread_local_data_destructor
 //----------------------------------------------------------------------------------------------------------------------
@@ -608,6 +704,20 @@ bool vogl_is_capturing()
     return get_vogl_trace_writer().is_opened();
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+// vogl_get_last_snapshot_stats
+//----------------------------------------------------------------------------------------------------------------------
+bool vogl_get_last_snapshot_stats(vogl_snapshot_stats &stats)
+{
+    scoped_mutex lock(get_vogl_trace_mutex());
+
+    if (!g_vogl_has_last_snapshot_stats)
+        return false;
+
+    stats = g_vogl_last_snapshot_stats;
+    return true;
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 // vogl_dump_statistics
 //----------------------------------------------------------------------------------------------------------------------
@@ -827,6 +937,16 @@ static void vogl_init_command_line_params()
         exit(EXIT_FAILURE);
     }
 
+    g_param_ids.m_dump_png_screenshots = g_command_line_params().get_param_id("vogl_dump_png_screenshots");
+    g_param_ids.m_dump_jpeg_screenshots = g_command_line_params().get_param_id("vogl_dump_jpeg_screenshots");
+    g_param_ids.m_jpeg_quality = g_command_line_params().get_param_id("vogl_jpeg_quality");
+    g_param_ids.m_screenshot_prefix = g_command_line_params().get_param_id("vogl_screenshot_prefix");
+    g_param_ids.m_hash_backbuffer = g_command_line_params().get_param_id("vogl_hash_backbuffer");
+    g_param_ids.m_dump_backbuffer_hashes = g_command_line_params().get_param_id("vogl_dump_backbuffer_hashes");
+    g_param_ids.m_sum_hashing = g_command_line_params().get_param_id("vogl_sum_hashing");
+    g_param_ids.m_force_debug_context = g_command_line_params().get_param_id("vogl_force_debug_context");
+    g_param_ids.m_exit_after_x_frames = g_command_line_params().get_param_id("vogl_exit_after_x_frames");
+
     g_dump_gl_calls_flag = g_command_line_params().get_value_as_bool("vogl_dump_gl_calls");
     g_dump_gl_buffers_flag = g_command_line_params().get_value_as_bool("vogl_dump_gl_buffers");
     g_dump_gl_shaders_flag = g_command_line_params().get_value_as_bool("vogl_dump_gl_shaders");
@@ -1048,20 +1168,15 @@ struct gl_buffer_desc
 
     bool m_map_range;
 
-    struct flushed_range
-    {
-        inline flushed_range(int64_t ofs, int64_t size)
-            : m_ofs(ofs), m_size(size)
-        {
-        }
-        inline flushed_range()
-        {
-        }
+    // Ranges flushed by glFlushMappedBufferRange() since the buffer was mapped, relative to the start of the map. Overlapping and
+    // adjacent flushes are coalesced, so each byte is written to the trace at most once when the buffer is unmapped.
+    typedef vogl::interval_set<int64_t> range_set;
+    range_set m_flushed_ranges;
 
-        int64_t m_ofs;
-        int64_t m_size;
-    };
-    vogl::vector<flushed_range> m_flushed_ranges;
+    // Ranges of the buffer (in buffer offsets) whose last CPU side write was written to the trace by glBufferData(), glBufferSubData(),
+    // or a flush/unmap of a write map. Only updated from data the tracer already has in hand, so GPU writes (copies, clears, transform
+    // feedback, image/SSBO stores, etc.) aren't seen and can leave ranges in here whose contents the trace no longer matches.
+    range_set m_trace_synced_ranges;
 
     inline gl_buffer_desc()
     {
@@ -1084,6 +1199,7 @@ struct gl_buffer_desc
         m_map_access = 0;
         m_map_range = false;
         m_flushed_ranges.clear();
+        m_trace_synced_ranges.clear();
     }
 };
 
@@ -1427,6 +1543,11 @@ public:
         return m_capture_context_params;
     }
 
+    vogl_fixed_function_shadow &get_fixed_function_shadow()
+    {
+        return m_capture_context_params.m_fixed_function_shadow;
+    }
+
     const vogl_framebuffer_capturer &get_framebuffer_capturer() const
     {
         return m_framebuffer_capturer;
@@ -1457,6 +1578,8 @@ public:
                 vogl_error_printf("%s: Failed initializing m_context_info!\n", VOGL_FUNCTION_INFO_CSTR);
             }
 
+            m_capture_context_params.m_fixed_function_shadow.init(m_context_info);
+
             if (!m_has_been_made_current)
             {
                 on_first_make_current();
@@ -1722,16 +1845,13 @@ public:
 
         vogl_scoped_context_shadow_lock lock;
 
+        vogl_handle_tracker &textures = get_shared_state()->m_capture_context_params.m_textures;
+
         for (GLsizei i = 0; i < n; i++)
         {
-            GLuint handle = pTextures[i];
-            if (handle)
-            {
-                if (!get_shared_state()->m_capture_context_params.m_textures.insert(handle, handle, GL_NONE))
-                {
-                    vogl_warning_printf("%s: Unable to add texture handle %u to texture handle shadow map!\n", VOGL_FUNCTION_INFO_CSTR, handle);
-                }
-            }
+            i += textures.insert_array(n - i, pTextures + i, pTextures + i, GL_NONE);
+            if (i < n)
+                vogl_warning_printf("%s: Unable to add texture handle %u to texture handle shadow map!\n", VOGL_FUNCTION_INFO_CSTR, pTextures[i]);
         }
     }
 
@@ -1742,16 +1862,13 @@ public:
 
         vogl_scoped_context_shadow_lock lock;
 
+        vogl_handle_tracker &textures = get_shared_state()->m_capture_context_params.m_textures;
+
         for (GLsizei i = 0; i < n; i++)
         {
-            GLuint handle = pTextures[i];
-            if (handle)
-            {
-                if (!get_shared_state()->m_capture_context_params.m_textures.erase(handle))
-                {
-                    vogl_warning_printf("%s: Failed erasing handle %u from texture handle shadow map!\n", VOGL_FUNCTION_INFO_CSTR, handle);
-                }
-            }
+            i += textures.erase_array(n - i, pTextures + i, NULL);
+            if (i < n)
+                vogl_warning_printf("%s: Failed erasing handle %u from texture handle shadow map!\n", VOGL_FUNCTION_INFO_CSTR, pTextures[i]);
         }
     }
 
@@ -1980,16 +2097,13 @@ public:
 
         vogl_scoped_context_shadow_lock lock;
 
+        vogl_handle_tracker &rbos = get_shared_state()->m_capture_context_params.m_rbos;
+
         for (GLsizei i = 0; i < n; i++)
         {
-            GLuint id = pIDs[i];
-            if (id)
-            {
-                if (!get_shared_state()->m_capture_context_params.m_rbos.insert(id, id, GL_NONE))
-                {
-                    vogl_error_printf("%s: Can't insert render buffer handle 0x%04X into render buffer shadow!\n", VOGL_FUNCTION_INFO_CSTR, id);
-                }
-            }
+            i += rbos.insert_array(n - i, pIDs + i, pIDs + i, GL_NONE);
+            if (i < n)
+                vogl_error_printf("%s: Can't insert render buffer handle 0x%04X into render buffer shadow!\n", VOGL_FUNCTION_INFO_CSTR, pIDs[i]);
         }
     }
 
@@ -2000,16 +2114,13 @@ public:
 
         vogl_scoped_context_shadow_lock lock;
 
+        vogl_handle_tracker &rbos = get_shared_state()->m_capture_context_params.m_rbos;
+
         for (GLsizei i = 0; i < n; i++)
         {
-            GLuint buffer = buffers[i];
-            if (!buffer)
-                continue;
-
-            if (!get_shared_state()->m_capture_context_params.m_rbos.erase(buffer))
-            {
-                vogl_error_printf("%s: Can't erase render buffer handle 0x%04X from render buffer shadow!\n", VOGL_FUNCTION_INFO_CSTR, buffer);
-            }
+            i += rbos.erase_array(n - i, buffers + i, NULL);
+            if (i < n)
+                vogl_error_printf("%s: Can't erase render buffer handle 0x%04X from render buffer shadow!\n", VOGL_FUNCTION_INFO_CSTR, buffers[i]);
         }
     }
 
@@ -2105,6 +2216,43 @@ public:
         return get_shared_state()->m_capture_context_params.m_linked_programs.add_snapshot(m_context_info, m_handle_remapper, link_entrypoint, handle, type, count, strings);
     }
 
+    // Records a glUniform*/glProgramUniform* write into the uniform value shadow, which program snapshots read instead of glGetUniform*().
+    void update_uniform_value_shadow(GLuint program, GLint location, GLsizei count, GLboolean transpose, GLenum base_type, uint num_components, const void *pValues)
+    {
+        vogl_scoped_context_shadow_lock lock;
+
+        vogl_uniform_value_shadow &shadow = get_shared_state()->m_capture_context_params.m_uniform_values;
+
+        if (!program)
+        {
+            // glUniform* with no current program either failed or went to a program pipeline's active program, which we don't track.
+            shadow.clear();
+        }
+        else if (transpose)
+            shadow.invalidate(program, location, count);
+        else
+            shadow.set(program, location, count, base_type, num_components, pValues);
+    }
+
+    // For uniform writes the shadow can't represent (bindless handles, etc.).
+    void invalidate_uniform_value_shadow(GLuint program, GLint location, GLsizei count)
+    {
+        vogl_scoped_context_shadow_lock lock;
+
+        if (!program)
+            get_shared_state()->m_capture_context_params.m_uniform_values.clear();
+        else
+            get_shared_state()->m_capture_context_params.m_uniform_values.invalidate(program, location, count);
+    }
+
+    // Linking resets a program's uniforms and may reassign their locations.
+    void remove_uniform_value_shadow(GLuint program)
+    {
+        vogl_scoped_context_shadow_lock lock;
+
+        get_shared_state()->m_capture_context_params.m_uniform_values.remove_program(program);
+    }
+
     void handle_use_program(gl_entrypoint_id_t id, GLuint program)
     {
         // Note: This mixes ARB and non-ARB funcs. to probe around, which is evil.
@@ -2183,6 +2331,7 @@ public:
                 VOGL_NOTE_UNUSED(was_deleted);
 
                 get_shared_state()->m_capture_context_params.m_linked_programs.remove_snapshot(prev_program);
+                get_shared_state()->m_capture_context_params.m_uniform_values.remove_program(prev_program);
 
                 for (uint i = 0; i < prev_attached_replay_shaders.size(); i++)
                 {
@@ -2338,6 +2487,7 @@ public:
             VOGL_NOTE_UNUSED(was_deleted);
 
             get_shared_state()->m_capture_context_params.m_linked_programs.remove_snapshot(obj);
+            get_shared_state()->m_capture_context_params.m_uniform_values.remove_program(obj);
 
             if (m_cur_program == obj)
             {
@@ -2503,6 +2653,8 @@ public:
         m_current_display_list_handle = handle;
         m_current_display_list_mode = mode;
 
+        m_capture_context_params.m_fixed_function_shadow.new_list(mode);
+
         vogl_scoped_context_shadow_lock lock;
 
         get_shared_state()->m_capture_context_params.m_display_lists.new_list(handle, handle);
@@ -2529,6 +2681,8 @@ public:
         m_current_display_list_handle = -1;
         m_current_display_list_mode = GL_NONE;
 
+        m_capture_context_params.m_fixed_function_shadow.end_list();
+
         return true;
     }
 
@@ -2567,14 +2721,29 @@ public:
     {
         vogl_scoped_context_shadow_lock lock;
 
-        return get_shared_state()->m_capture_context_params.m_display_lists.parse_list_and_update_shadows(handle, pBind_callback, pBind_callback_opaque);
+        return get_shared_state()->m_capture_context_params.m_display_lists.parse_list_and_update_shadows(handle, pBind_callback, pBind_callback_opaque, &m_capture_context_params.m_fixed_function_shadow);
     }
 
     bool parse_lists_and_update_shadows(GLsizei n, GLenum type, const GLvoid *lists, vogl_display_list_state::pBind_callback_func_ptr pBind_callback, void *pBind_callback_opaque)
     {
         vogl_scoped_context_shadow_lock lock;
 
-        return get_shared_state()->m_capture_context_params.m_display_lists.parse_lists_and_update_shadows(n, type, lists, pBind_callback, pBind_callback_opaque);
+        return get_shared_state()->m_capture_context_params.m_display_lists.parse_lists_and_update_shadows(n, type, lists, pBind_callback, pBind_callback_opaque, &m_capture_context_params.m_fixed_function_shadow);
+    }
+
+    // Executing the list won't do what its recorded packets say, so the fixed function shadow can't follow it.
+    void set_current_display_list_has_unlisted_calls()
+    {
+        VOGL_FUNC_TRACER
+
+        if (m_current_display_list_handle < 0)
+            return;
+
+        vogl_scoped_context_shadow_lock lock;
+
+        vogl_display_list *pList = get_shared_state()->m_capture_context_params.m_display_lists.find_list(m_current_display_list_handle);
+        if (pList)
+            pList->set_has_unlisted_calls();
     }
 
     bool add_packet_to_current_display_list(gl_entrypoint_id_t func, const vogl_trace_packet &packet)
@@ -2592,13 +2761,23 @@ public:
                     vogl_error_printf("%s: Failed serializing trace packet into display list shadow! Call is not listable.\n", VOGL_FUNCTION_INFO_CSTR);
                 else
                     vogl_error_printf("%s: Failed serializing trace packet into display list shadow! Call with these parameters is not listable.\n", VOGL_FUNCTION_INFO_CSTR);
+
+                set_current_display_list_has_unlisted_calls();
             }
             return false;
         }
 
-        vogl_scoped_context_shadow_lock lock;
+        bool added;
+        {
+            vogl_scoped_context_shadow_lock lock;
+
+            added = get_shared_state()->m_capture_context_params.m_display_lists.add_packet_to_list(m_current_display_list_handle, func, packet);
+        }
+
+        if (!added)
+            set_current_display_list_has_unlisted_calls();
 
-        return get_shared_state()->m_capture_context_params.m_display_lists.add_packet_to_list(m_current_display_list_handle, func, packet);
+        return added;
     }
 
     bool MakeCurrent(CONTEXT_TYPE new_context)
@@ -2703,7 +2882,7 @@ private:
 
     void on_first_make_current()
     {
-        if ((g_command_line_params().get_value_as_bool("vogl_force_debug_context")) && (m_context_info.is_debug_context()))
+        if ((g_command_line_params().get_value_as_bool(g_param_ids.m_force_debug_context)) && (m_context_info.is_debug_context()))
         {
             if (GL_ENTRYPOINT(glDebugMessageCallbackARB) && m_context_info.supports_extension("GL_ARB_debug_output"))
             {
@@ -3958,6 +4137,8 @@ static inline bool vogl_should_serialize_call(gl_entrypoint_id_t func, vogl_cont
     if ((is_in_display_list) && (is_listable) && (!is_whitelisted))
     {
         vogl_error_printf("%s: Called GL func %s is not currently supported in display lists! The replay will diverge.\n", VOGL_FUNCTION_INFO_CSTR, g_vogl_entrypoint_descs[func].m_pName);
+
+        pContext->set_current_display_list_has_unlisted_calls();
     }
 
     // When we're writing a trace we ALWAYS want to serialize, even if the func is not listable (so we can at least process the trace, etc.)
@@ -4204,7 +4385,8 @@ static void vogl_glInternalTraceCommandRAD(GLuint cmd, GLuint size, const GLubyt
 
     if (get_vogl_trace_writer().is_opened())
     {
-        vogl_entrypoint_serializer serializer(VOGL_ENTRYPOINT_glInternalTraceCommandRAD, NULL);
+        vogl_scoped_entrypoint_serializer scoped_serializer(VOGL_ENTRYPOINT_glInternalTraceCommandRAD, NULL);
+        vogl_entrypoint_serializer &serializer = scoped_serializer.get();
 
         uint64_t cur_rdtsc = utils::RDTSC();
         serializer.set_gl_begin_end_rdtsc(cur_rdtsc, cur_rdtsc + 1);
@@ -4276,7 +4458,8 @@ static __GLXextFuncPtr vogl_glXGetProcAddress(const GLubyte *procName)
 
     if (get_vogl_trace_writer().is_opened())
     {
-        vogl_entrypoint_serializer serializer(VOGL_ENTRYPOINT_glXGetProcAddress, get_context_manager().get_current(true));
+        vogl_scoped_entrypoint_serializer scoped_serializer(VOGL_ENTRYPOINT_glXGetProcAddress, get_context_manager().get_current(true));
+        vogl_entrypoint_serializer &serializer = scoped_serializer.get();
         serializer.set_begin_rdtsc(begin_rdtsc);
         serializer.set_gl_begin_end_rdtsc(gl_begin_rdtsc, gl_end_rdtsc);
         serializer.add_param(0, VOGL_CONST_GLUBYTE_PTR, &procName, sizeof(procName));
@@ -4322,7 +4505,8 @@ static __GLXextFuncPtr vogl_glXGetProcAddressARB(const GLubyte *procName)
 
     if (get_vogl_trace_writer().is_opened())
     {
-        vogl_entrypoint_serializer serializer(VOGL_ENTRYPOINT_glXGetProcAddressARB, get_context_manager().get_current(true));
+        vogl_scoped_entrypoint_serializer scoped_serializer(VOGL_ENTRYPOINT_glXGetProcAddressARB, get_context_manager().get_current(true));
+        vogl_entrypoint_serializer &serializer = scoped_serializer.get();
         serializer.set_begin_rdtsc(begin_rdtsc);
         serializer.set_gl_begin_end_rdtsc(gl_begin_rdtsc, gl_end_rdtsc);
         serializer.add_param(0, VOGL_CONST_GLUBYTE_PTR, &procName, sizeof(procName));
@@ -4368,7 +4552,8 @@ static PROC vogl_wglGetProcAddress(LPCSTR lpszProc)
 
     if (get_vogl_trace_writer().is_opened())
     {
-        vogl_entrypoint_serializer serializer(VOGL_ENTRYPOINT_wglGetProcAddress, get_context_manager().get_current(true));
+        vogl_scoped_entrypoint_serializer scoped_serializer(VOGL_ENTRYPOINT_wglGetProcAddress, get_context_manager().get_current(true));
+        vogl_entrypoint_serializer &serializer = scoped_serializer.get();
         serializer.set_begin_rdtsc(begin_rdtsc);
         serializer.set_gl_begin_end_rdtsc(gl_begin_rdtsc, gl_end_rdtsc);
         serializer.add_param(0, VOGL_LPCSTR, &lpszProc, sizeof(lpszProc));
@@ -4602,7 +4787,8 @@ static void vogl_glTexStorage2D(	GLenum target,
 
         if (get_vogl_trace_writer().is_opened())
         {
-            vogl_entrypoint_serializer serializer(VOGL_ENTRYPOINT_glXMakeCurrent, pCur_context);
+            vogl_scoped_entrypoint_serializer scoped_serializer(VOGL_ENTRYPOINT_glXMakeCurrent, pCur_context);
+            vogl_entrypoint_serializer &serializer = scoped_serializer.get();
             serializer.set_begin_rdtsc(begin_rdtsc);
             serializer.set_gl_begin_end_rdtsc(gl_begin_rdtsc, gl_end_rdtsc);
             serializer.add_param(0, VOGL_CONST_DISPLAY_PTR, &dpy, sizeof(dpy));
@@ -4702,7 +4888,8 @@ static void vogl_glTexStorage2D(	GLenum target,
 
         if (get_vogl_trace_writer().is_opened())
         {
-            vogl_entrypoint_serializer serializer(VOGL_ENTRYPOINT_glXMakeContextCurrent, pCur_context);
+            vogl_scoped_entrypoint_serializer scoped_serializer(VOGL_ENTRYPOINT_glXMakeContextCurrent, pCur_context);
+            vogl_entrypoint_serializer &serializer = scoped_serializer.get();
             serializer.set_begin_rdtsc(begin_rdtsc);
             serializer.set_gl_begin_end_rdtsc(gl_begin_rdtsc, gl_end_rdtsc);
             serializer.add_param(0, VOGL_CONST_DISPLAY_PTR, &dpy, sizeof(dpy));
@@ -4794,7 +4981,8 @@ static void vogl_glTexStorage2D(	GLenum target,
 
         if (get_vogl_trace_writer().is_opened())
         {
-            vogl_entrypoint_serializer serializer(VOGL_ENTRYPOINT_wglMakeCurrent, pCur_context);
+            vogl_scoped_entrypoint_serializer scoped_serializer(VOGL_ENTRYPOINT_wglMakeCurrent, pCur_context);
+            vogl_entrypoint_serializer &serializer = scoped_serializer.get();
             serializer.set_begin_rdtsc(begin_rdtsc);
             serializer.set_gl_begin_end_rdtsc(gl_begin_rdtsc, gl_end_rdtsc);
             serializer.add_param(0, VOGL_HDC, &hdc, sizeof(hdc));
@@ -4843,12 +5031,12 @@ static bool vogl_screen_capture_callback(uint width, uint height, uint pitch, si
         return false;
     }
 
-    if (g_command_line_params().get_value_as_bool("vogl_dump_png_screenshots"))
+    if (g_command_line_params().get_value_as_bool(g_param_ids.m_dump_png_screenshots))
     {
         size_t png_size = 0;
         void *pPNG_data = tdefl_write_image_to_png_file_in_memory_ex(pImage, width, height, 3, &png_size, 1, true);
 
-        dynamic_string screenshot_filename(cVarArg, "%s_%08" PRIx64 "_%08" PRIu64 ".png", g_command_line_params().get_value_as_string("vogl_screenshot_prefix", 0, "screenshot").get_ptr(), cast_val_to_uint64(pContext->get_context_handle()), cast_val_to_uint64(frame_index));
+        dynamic_string screenshot_filename(cVarArg, "%s_%08" PRIx64 "_%08" PRIu64 ".png", g_command_line_params().get_value_as_string(g_param_ids.m_screenshot_prefix, 0, "screenshot").get_ptr(), cast_val_to_uint64(pContext->get_context_handle()), cast_val_to_uint64(frame_index));
         if (!file_utils::write_buf_to_file(screenshot_filename.get_ptr(), pPNG_data, png_size))
         {
             console::error("Failed writing PNG screenshot to file %s\n", screenshot_filename.get_ptr());
@@ -4856,9 +5044,9 @@ static bool vogl_screen_capture_callback(uint width, uint height, uint pitch, si
 
         mz_free(pPNG_data);
     }
-    else if (g_command_line_params().get_value_as_bool("vogl_dump_jpeg_screenshots"))
+    else if (g_command_line_params().get_value_as_bool(g_param_ids.m_dump_jpeg_screenshots))
     {
-        int jpeg_quality = g_command_line_params().get_value_as_int("vogl_jpeg_quality", 0, 80, 1, 100);
+        int jpeg_quality = g_command_line_params().get_value_as_int(g_param_ids.m_jpeg_quality, 0, 80, 1, 100);
 
         long unsigned int jpeg_size = 0;
         unsigned char *pJPEG_data = NULL;
@@ -4874,7 +5062,7 @@ static bool vogl_screen_capture_callback(uint width, uint height, uint pitch, si
         if (status == 0)
         {
             dynamic_string screenshot_filename(cVarArg, "%s_%08" PRIx64 "_%08" PRIu64 ".jpg",
-                g_command_line_params().get_value_as_string("vogl_screenshot_prefix", 0, "screenshot").get_ptr(),
+                g_command_line_params().get_value_as_string(g_param_ids.m_screenshot_prefix, 0, "screenshot").get_ptr(),
                 cast_val_to_uint64(pContext->get_context_handle()),
                 cast_val_to_uint64(frame_index));
             if (!file_utils::write_buf_to_file(screenshot_filename.get_ptr(), pJPEG_data, jpeg_size))
@@ -4886,11 +5074,11 @@ static bool vogl_screen_capture_callback(uint width, uint height, uint pitch, si
         tjFree(pJPEG_data);
     }
 
-    if (g_command_line_params().get_value_as_bool("vogl_dump_backbuffer_hashes") || g_command_line_params().get_value_as_bool("vogl_hash_backbuffer"))
+    if (g_command_line_params().get_value_as_bool(g_param_ids.m_dump_backbuffer_hashes) || g_command_line_params().get_value_as_bool(g_param_ids.m_hash_backbuffer))
     {
         uint64_t backbuffer_crc64;
 
-        if (g_command_line_params().get_value_as_bool("vogl_sum_hashing"))
+        if (g_command_line_params().get_value_as_bool(g_param_ids.m_sum_hashing))
         {
             backbuffer_crc64 = calc_sum64(static_cast<const uint8 *>(pImage), size);
         }
@@ -4902,7 +5090,7 @@ static bool vogl_screen_capture_callback(uint width, uint height, uint pitch, si
         console::printf("Frame %" PRIu64 " hash: 0x%016" PRIX64 "\n", cast_val_to_uint64(frame_index), backbuffer_crc64);
 
         dynamic_string backbuffer_hash_file;
-        if (g_command_line_params().get_value_as_string(backbuffer_hash_file, "vogl_dump_backbuffer_hashes"))
+        if (g_command_line_params().get_value_as_string(backbuffer_hash_file, g_param_ids.m_dump_backbuffer_hashes))
         {
             FILE *pFile = vogl_fopen(backbuffer_hash_file.get_ptr(), "a");
             if (!pFile)
@@ -4928,8 +5116,8 @@ static void vogl_tick_screen_capture(vogl_context *pVOGL_context)
     if ((!width) || (!height))
         return;
 
-    bool grab_backbuffer = g_command_line_params().get_value_as_bool("vogl_dump_backbuffer_hashes") || g_command_line_params().get_value_as_bool("vogl_hash_backbuffer") ||
-                           g_command_line_params().get_value_as_bool("vogl_dump_jpeg_screenshots") || g_command_line_params().get_value_as_bool("vogl_dump_png_screenshots");
+    bool grab_backbuffer = g_command_line_params().get_value_as_bool(g_param_ids.m_dump_backbuffer_hashes) || g_command_line_params().get_value_as_bool(g_param_ids.m_hash_backbuffer) ||
+                           g_command_line_params().get_value_as_bool(g_param_ids.m_dump_jpeg_screenshots) || g_command_line_params().get_value_as_bool(g_param_ids.m_dump_png_screenshots);
     if (!grab_backbuffer)
         return;
 
@@ -5147,6 +5335,53 @@ static void vogl_check_for_capture_trigger_file()
         vogl_message_printf("%s: Successfully enabled capture mode, will capture up to %u frame(s), override path \"%s\", override base_name \"%s\"\n", VOGL_FUNCTION_INFO_CSTR, total_frames, path.get_ptr(), base_name.get_ptr());
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+// vogl_get_snapshot_budget
+//----------------------------------------------------------------------------------------------------------------------
+static vogl_snapshot_budget vogl_get_snapshot_budget()
+{
+    vogl_snapshot_budget budget;
+    budget.m_max_texture_bytes = g_command_line_params().get_value_as_uint64("vogl_snapshot_texture_budget_mb") * 1024U * 1024U;
+    budget.m_max_static_buffer_size = g_command_line_params().get_value_as_uint64("vogl_snapshot_static_buffer_limit_mb") * 1024U * 1024U;
+    return budget;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// vogl_find_share_group_capture_contexts
+// Objects shared across a sharelist group are tracked by the group's root context, but can only be snapshotted through a
+// context that has been made current. Picks exactly one such context per group (the root if possible), so each shared
+// namespace is captured once no matter how many contexts are in the group.
+//----------------------------------------------------------------------------------------------------------------------
+typedef vogl::hash_map<vogl_context *, vogl_context *, bit_hasher<vogl_context *> > vogl_share_group_capture_context_map;
+
+static void vogl_find_share_group_capture_contexts(const context_map &contexts, vogl_share_group_capture_context_map &capture_contexts)
+{
+    capture_contexts.reset();
+
+    for (context_map::const_iterator it = contexts.begin(); it != contexts.end(); ++it)
+    {
+        vogl_context *pVOGL_context = it->second;
+        if (!pVOGL_context->get_has_been_made_current())
+            continue;
+
+        vogl_context *&pCapture_context = capture_contexts[pVOGL_context->get_shared_state()];
+        if ((!pCapture_context) || (pVOGL_context->is_root_context()))
+            pCapture_context = pVOGL_context;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// vogl_get_shared_capture_context_params
+// Returns the root's shadow if pVOGL_context must capture its sharelist group's objects on the root's behalf, or NULL.
+//----------------------------------------------------------------------------------------------------------------------
+static const vogl_capture_context_params *vogl_get_shared_capture_context_params(const vogl_share_group_capture_context_map &capture_contexts, vogl_context *pVOGL_context)
+{
+    if ((pVOGL_context->is_root_context()) || (capture_contexts.value(pVOGL_context->get_shared_state()) != pVOGL_context))
+        return NULL;
+
+    return &pVOGL_context->get_shared_state()->get_capture_context_params();
+}
+
 #if (VOGL_PLATFORM_HAS_GLX)
     //----------------------------------------------------------------------------------------------------------------------
     static vogl_gl_state_snapshot *vogl_snapshot_state(const Display *dpy, GLXDrawable drawable, vogl_context *pCur_context)
@@ -5178,6 +5413,7 @@ static void vogl_check_for_capture_trigger_file()
         vogl_check_gl_error();
 
         vogl_gl_state_snapshot *pSnapshot = vogl_new(vogl_gl_state_snapshot);
+        pSnapshot->set_budget(vogl_get_snapshot_budget());
 
         const context_map &contexts = context_manager.get_context_map();
 
@@ -5220,6 +5456,9 @@ static void vogl_check_for_capture_trigger_file()
 
         vogl_printf("%s: Capturing %u context(s)\n", VOGL_FUNCTION_INFO_CSTR, contexts.size());
 
+        vogl_share_group_capture_context_map share_group_capture_contexts;
+        vogl_find_share_group_capture_contexts(contexts, share_group_capture_contexts);
+
         context_map::const_iterator it;
         for (it = contexts.begin(); it != contexts.end(); ++it)
         {
@@ -5261,7 +5500,9 @@ static void vogl_check_for_capture_trigger_file()
 
             vogl_capture_context_params &capture_context_params = pVOGL_context->get_capture_context_params();
 
-            if (!pSnapshot->capture_context(pVOGL_context->get_context_desc(), pVOGL_context->get_context_info(), pVOGL_context->get_handle_remapper(), capture_context_params))
+            const vogl_capture_context_params *pShared_capture_context_params = vogl_get_shared_capture_context_params(share_group_capture_contexts, pVOGL_context);
+
+            if (!pSnapshot->capture_context(pVOGL_context->get_context_desc(), pVOGL_context->get_context_info(), pVOGL_context->get_handle_remapper(), capture_context_params, pShared_capture_context_params))
             {
                 vogl_error_printf("%s: Failed capturing trace context 0x%" PRIX64 ", capture failed\n", VOGL_FUNCTION_INFO_CSTR, cast_val_to_uint64(gl_context));
                 break;
@@ -5327,7 +5568,7 @@ static void vogl_check_for_capture_trigger_file()
 
         // TODO: This can take a lot of memory, probably better off to split the snapshot into separate smaller binary json or whatever files stored directly in the archive.
         json_document doc;
-        if (!pSnapshot->serialize(*doc.get_root(), trace_archive, &get_vogl_process_gl_ctypes()))
+        if (!pSnapshot->serialize(*doc.get_root(), trace_archive, &get_vogl_process_gl_ctypes(), &g_vogl_last_snapshot_stats))
         {
             vogl_error_printf("%s: Failed serializing GL state snapshot!\n", VOGL_FUNCTION_INFO_CSTR);
 
@@ -5336,6 +5577,9 @@ static void vogl_check_for_capture_trigger_file()
             return false;
         }
 
+        g_vogl_has_last_snapshot_stats = true;
+        g_vogl_last_snapshot_stats.print();
+
         pSnapshot.reset();
 
         vogl_message_printf("%s: Serializing JSON document to UBJ\n", VOGL_FUNCTION_INFO_CSTR);
@@ -5603,7 +5847,8 @@ static void vogl_check_for_capture_trigger_file()
         }
 
         // Use a local serializer because the call to glXSwapBuffer()'s will make GL calls if something like the Steam Overlay is active.
-        vogl_entrypoint_serializer serializer;
+        vogl_scoped_entrypoint_serializer scoped_serializer;
+        vogl_entrypoint_serializer &serializer = scoped_serializer.get();
 
         if (get_vogl_trace_writer().is_opened())
         {
@@ -5641,9 +5886,9 @@ static void vogl_check_for_capture_trigger_file()
             vogl_message_printf("** END %s 0x%" PRIX64 "\n", VOGL_FUNCTION_INFO_CSTR, vogl_get_current_kernel_thread_id());
         }
 
-        if (g_command_line_params().has_key("vogl_exit_after_x_frames") && (pTLS_data->m_pContext))
+        if (g_command_line_params().has_key(g_param_ids.m_exit_after_x_frames) && (pTLS_data->m_pContext))
         {
-            uint64_t max_num_frames = g_command_line_params().get_value_as_uint64("vogl_exit_after_x_frames");
+            uint64_t max_num_frames = g_command_line_params().get_value_as_uint64(g_param_ids.m_exit_after_x_frames);
             uint64_t cur_num_frames = pTLS_data->m_pContext->get_frame_index();
 
             if (cur_num_frames >= max_num_frames)
@@ -5678,7 +5923,7 @@ static void vogl_check_for_capture_trigger_file()
 
         vogl_context_attribs context_attribs;
 
-        if (g_command_line_params().get_value_as_bool("vogl_force_debug_context"))
+        if (g_command_line_params().get_value_as_bool(g_param_ids.m_force_debug_context))
         {
             vogl_warning_printf("%s: Forcing debug context\n", VOGL_FUNCTION_INFO_CSTR);
 
@@ -5726,7 +5971,8 @@ static void vogl_check_for_capture_trigger_file()
 
         if (get_vogl_trace_writer().is_opened())
         {
-            vogl_entrypoint_serializer serializer(VOGL_ENTRYPOINT_glXCreateContextAttribsARB, context_manager.get_current(true));
+            vogl_scoped_entrypoint_serializer scoped_serializer(VOGL_ENTRYPOINT_glXCreateContextAttribsARB, context_manager.get_current(true));
+            vogl_entrypoint_serializer &serializer = scoped_serializer.get();
             serializer.set_begin_rdtsc(begin_rdtsc);
             serializer.set_gl_begin_end_rdtsc(gl_begin_rdtsc, gl_end_rdtsc);
             serializer.add_param(0, VOGL_CONST_DISPLAY_PTR, &dpy, sizeof(dpy));
@@ -5884,7 +6130,7 @@ static void vogl_check_for_capture_trigger_file()
             return GL_ENTRYPOINT(glXCreateContext)(dpy, vis, shareList, direct);
         }
 
-        if (g_command_line_params().get_value_as_bool("vogl_force_debug_context"))
+        if (g_command_line_params().get_value_as_bool(g_param_ids.m_force_debug_context))
         {
             vogl_warning_printf("%s: Can't enable debug contexts via glXCreateContext(), forcing call to use glXCreateContextsAttribsARB() instead\n", VOGL_FUNCTION_INFO_CSTR);
 
@@ -5913,7 +6159,8 @@ static void vogl_check_for_capture_trigger_file()
 
         if (get_vogl_trace_writer().is_opened())
         {
-            vogl_entrypoint_serializer serializer(VOGL_ENTRYPOINT_glXCreateContext, context_manager.get_current(true));
+            vogl_scoped_entrypoint_serializer scoped_serializer(VOGL_ENTRYPOINT_glXCreateContext, context_manager.get_current(true));
+            vogl_entrypoint_serializer &serializer = scoped_serializer.get();
             serializer.set_begin_rdtsc(begin_rdtsc);
             serializer.set_gl_begin_end_rdtsc(gl_begin_rdtsc, gl_end_rdtsc);
             serializer.add_param(0, VOGL_CONST_DISPLAY_PTR, &dpy, sizeof(dpy));
@@ -5985,7 +6232,7 @@ static void vogl_check_for_capture_trigger_file()
             vogl_error_printf("%s: Unsupported render type (%s)!\n", VOGL_FUNCTION_INFO_CSTR, get_gl_enums().find_glx_name(render_type));
         }
 
-        if (g_command_line_params().get_value_as_bool("vogl_force_debug_context"))
+        if (g_command_line_params().get_value_as_bool(g_param_ids.m_force_debug_context))
         {
             vogl_warning_printf("%s: Redirecting call from glxCreateNewContext() to glxCreateContextAttribsARB because --vogl_force_debug_context was specified. Note this may fail if glXCreateWindow() was called.\n", VOGL_FUNCTION_INFO_CSTR);
 
@@ -6020,7 +6267,8 @@ static void vogl_check_for_capture_trigger_file()
 
         if (get_vogl_trace_writer().is_opened())
         {
-            vogl_entrypoint_serializer serializer(VOGL_ENTRYPOINT_glXCreateNewContext, context_manager.get_current(true));
+            vogl_scoped_entrypoint_serializer scoped_serializer(VOGL_ENTRYPOINT_glXCreateNewContext, context_manager.get_current(true));
+            vogl_entrypoint_serializer &serializer = scoped_serializer.get();
             serializer.set_begin_rdtsc(begin_rdtsc);
             serializer.set_gl_begin_end_rdtsc(gl_begin_rdtsc, gl_end_rdtsc);
             serializer.add_param(0, VOGL_CONST_DISPLAY_PTR, &dpy, sizeof(dpy));
@@ -6123,7 +6371,8 @@ static void vogl_check_for_capture_trigger_file()
 
         if (get_vogl_trace_writer().is_opened())
         {
-            vogl_entrypoint_serializer serializer(VOGL_ENTRYPOINT_glXDestroyContext, context_manager.get_current(true));
+            vogl_scoped_entrypoint_serializer scoped_serializer(VOGL_ENTRYPOINT_glXDestroyContext, context_manager.get_current(true));
+            vogl_entrypoint_serializer &serializer = scoped_serializer.get();
             serializer.set_begin_rdtsc(begin_rdtsc);
             serializer.set_gl_begin_end_rdtsc(gl_begin_rdtsc, gl_end_rdtsc);
             serializer.add_param(0, VOGL_CONST_DISPLAY_PTR, &dpy, sizeof(dpy));
@@ -6212,6 +6461,7 @@ static void vogl_check_for_capture_trigger_file()
         vogl_check_gl_error();
 
         vogl_gl_state_snapshot *pSnapshot = vogl_new(vogl_gl_state_snapshot);
+        pSnapshot->set_budget(vogl_get_snapshot_budget());
 
         const context_map &contexts = context_manager.get_context_map();
 
@@ -6254,6 +6504,9 @@ static void vogl_check_for_capture_trigger_file()
 
         vogl_printf("%s: Capturing %u context(s)\n", VOGL_FUNCTION_INFO_CSTR, contexts.size());
 
+        vogl_share_group_capture_context_map share_group_capture_contexts;
+        vogl_find_share_group_capture_contexts(contexts, share_group_capture_contexts);
+
         context_map::const_iterator it;
         for (it = contexts.begin(); it != contexts.end(); ++it)
         {
@@ -6295,7 +6548,9 @@ static void vogl_check_for_capture_trigger_file()
 
             vogl_capture_context_params &capture_context_params = pVOGL_context->get_capture_context_params();
 
-            if (!pSnapshot->capture_context(pVOGL_context->get_context_desc(), pVOGL_context->get_context_info(), pVOGL_context->get_handle_remapper(), capture_context_params))
+            const vogl_capture_context_params *pShared_capture_context_params = vogl_get_shared_capture_context_params(share_group_capture_contexts, pVOGL_context);
+
+            if (!pSnapshot->capture_context(pVOGL_context->get_context_desc(), pVOGL_context->get_context_info(), pVOGL_context->get_handle_remapper(), capture_context_params, pShared_capture_context_params))
             {
                 vogl_error_printf("%s: Failed capturing trace context 0x%" PRIX64 ", capture failed\n", VOGL_FUNCTION_INFO_CSTR, cast_val_to_uint64(gl_context));
                 break;
@@ -6362,7 +6617,7 @@ static void vogl_check_for_capture_trigger_file()
 
         // TODO: This can take a lot of memory, probably better off to split the snapshot into separate smaller binary json or whatever files stored directly in the archive.
         json_document doc;
-        if (!pSnapshot->serialize(*doc.get_root(), trace_archive, &get_vogl_process_gl_ctypes()))
+        if (!pSnapshot->serialize(*doc.get_root(), trace_archive, &get_vogl_process_gl_ctypes(), &g_vogl_last_snapshot_stats))
         {
             vogl_error_printf("%s: Failed serializing GL state snapshot!\n", VOGL_FUNCTION_INFO_CSTR);
 
@@ -6371,6 +6626,9 @@ static void vogl_check_for_capture_trigger_file()
             return false;
         }
 
+        g_vogl_has_last_snapshot_stats = true;
+        g_vogl_last_snapshot_stats.print();
+
         pSnapshot.reset();
 
         vogl_message_printf("%s: Serializing JSON document to UBJ\n", VOGL_FUNCTION_INFO_CSTR);
@@ -6589,7 +6847,8 @@ static void vogl_check_for_capture_trigger_file()
         }
 
         // Use a local serializer because the call to wglSwapBuffer()'s will make GL calls if something like the Steam Overlay is active.
-        vogl_entrypoint_serializer serializer;
+        vogl_scoped_entrypoint_serializer scoped_serializer;
+        vogl_entrypoint_serializer &serializer = scoped_serializer.get();
 
         if (get_vogl_trace_writer().is_opened())
         {
@@ -6629,9 +6888,9 @@ static void vogl_check_for_capture_trigger_file()
             vogl_message_printf("** END %s 0x%" PRIX64 "\n", VOGL_FUNCTION_INFO_CSTR, vogl_get_current_kernel_thread_id());
         }
 
-        if (g_command_line_params().has_key("vogl_exit_after_x_frames") && (pTLS_data->m_pContext))
+        if (g_command_line_params().has_key(g_param_ids.m_exit_after_x_frames) && (pTLS_data->m_pContext))
         {
-            uint64_t max_num_frames = g_command_line_params().get_value_as_uint64("vogl_exit_after_x_frames");
+            uint64_t max_num_frames = g_command_line_params().get_value_as_uint64(g_param_ids.m_exit_after_x_frames);
             uint64_t cur_num_frames = pTLS_data->m_pContext->get_frame_index();
 
             if (cur_num_frames >= max_num_frames)
@@ -6666,7 +6925,7 @@ static void vogl_check_for_capture_trigger_file()
             return GL_ENTRYPOINT(wglCreateContext)(hdc);
         }
 
-        if (g_command_line_params().get_value_as_bool("vogl_force_debug_context"))
+        if (g_command_line_params().get_value_as_bool(g_param_ids.m_force_debug_context))
         {
             vogl_warning_printf("%s: Can't enable debug contexts via wglCreateContext(), forcing call to use wglCreateContextsAttribsARB() instead\n", VOGL_FUNCTION_INFO_CSTR);
 
@@ -6688,7 +6947,8 @@ static void vogl_check_for_capture_trigger_file()
 
         if (get_vogl_trace_writer().is_opened())
         {
-            vogl_entrypoint_serializer serializer(VOGL_ENTRYPOINT_wglCreateContext, context_manager.get_current(true));
+            vogl_scoped_entrypoint_serializer scoped_serializer(VOGL_ENTRYPOINT_wglCreateContext, context_manager.get_current(true));
+            vogl_entrypoint_serializer &serializer = scoped_serializer.get();
             serializer.set_begin_rdtsc(begin_rdtsc);
             serializer.set_gl_begin_end_rdtsc(gl_begin_rdtsc, gl_end_rdtsc);
             serializer.add_param(0, VOGL_HDC, &hdc, sizeof(hdc));
@@ -6754,7 +7014,8 @@ static void vogl_check_for_capture_trigger_file()
 
         if (get_vogl_trace_writer().is_opened())
         {
-            vogl_entrypoint_serializer serializer(VOGL_ENTRYPOINT_wglShareLists, context_manager.get_current(true));
+            vogl_scoped_entrypoint_serializer scoped_serializer(VOGL_ENTRYPOINT_wglShareLists, context_manager.get_current(true));
+            vogl_entrypoint_serializer &serializer = scoped_serializer.get();
             serializer.set_begin_rdtsc(begin_rdtsc);
             serializer.set_gl_begin_end_rdtsc(gl_begin_rdtsc, gl_end_rdtsc);
             serializer.add_param(0, VOGL_HGLRC, &hglrc1, sizeof(hglrc1));
@@ -6839,7 +7100,8 @@ static GLenum vogl_glGetError()
 
     if (get_vogl_trace_writer().is_opened())
     {
-        vogl_entrypoint_serializer serializer(VOGL_ENTRYPOINT_glGetError, get_context_manager().get_current(true));
+        vogl_scoped_entrypoint_serializer scoped_serializer(VOGL_ENTRYPOINT_glGetError, get_context_manager().get_current(true));
+        vogl_entrypoint_serializer &serializer = scoped_serializer.get();
         serializer.set_begin_rdtsc(begin_rdtsc);
         serializer.set_gl_begin_end_rdtsc(gl_begin_rdtsc, gl_end_rdtsc);
         serializer.add_return_param(VOGL_GLENUM, &gl_err, sizeof(gl_err));
@@ -7151,16 +7413,21 @@ static void vogl_serialize_client_side_arrays_helper(
         {
             uint total_index_data_size = count * index_size;
 
-            // FIXME: Move index_data array to context state
-            vogl::vector<uint8> index_data;
+            concurrent_buffer_pool::magazine &buffer_magazine = vogl_get_or_create_thread_local_data()->m_buffer_magazine;
+            uint8 *pIndex_data = NULL;
             const uint8 *pIndices_to_scan = static_cast<const uint8 *>(indices);
 
             if (element_array_buffer)
             {
-                index_data.resize(total_index_data_size);
-                pIndices_to_scan = index_data.get_ptr();
+                pIndex_data = static_cast<uint8 *>(buffer_magazine.alloc(total_index_data_size));
+                if (!pIndex_data)
+                {
+                    vogl_error_printf("%s: Failed allocating %u bytes of index data\n", VOGL_FUNCTION_INFO_CSTR, total_index_data_size);
+                    return;
+                }
+                pIndices_to_scan = pIndex_data;
 
-                GL_ENTRYPOINT(glGetBufferSubData)(GL_ELEMENT_ARRAY_BUFFER, (GLintptr)indices, total_index_data_size, index_data.get_ptr());
+                GL_ENTRYPOINT(glGetBufferSubData)(GL_ELEMENT_ARRAY_BUFFER, (GLintptr)indices, total_index_data_size, pIndex_data);
             }
 
             start = cUINT32_MAX;
@@ -7184,6 +7451,8 @@ static void vogl_serialize_client_side_arrays_helper(
                 start = math::minimum(start, v);
                 end = math::maximum(end, v);
             }
+
+            buffer_magazine.free(pIndex_data);
         }
 
         if (trace_serializer.is_in_begin())
@@ -7508,7 +7777,11 @@ static inline void vogl_named_buffer_data_ext_helper(vogl_context *pContext, vog
     buf_desc.m_map_size = 0;
     buf_desc.m_map_access = 0;
     buf_desc.m_map_range = 0;
-    buf_desc.m_flushed_ranges.resize(0);
+    buf_desc.m_flushed_ranges.clear();
+
+    buf_desc.m_trace_synced_ranges.clear();
+    if (data)
+        buf_desc.m_trace_synced_ranges.insert(0, size);
 }
 
 #define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glBufferData(exported, category, ret, ret_type_enum, num_params, name, args, params) vogl_buffer_data_helper(pContext, trace_serializer, target, size, data, usage);
@@ -7534,9 +7807,7 @@ static inline void vogl_buffer_data_helper(vogl_context *pContext, vogl_entrypoi
 #define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glNamedBufferSubDataEXT(exported, category, ret, ret_type_enum, num_params, name, args, params) vogl_named_buffer_subdata_ext_helper(pContext, trace_serializer, buffer, offset, size, data);
 static inline void vogl_named_buffer_subdata_ext_helper(vogl_context *pContext, vogl_entrypoint_serializer &trace_serializer, GLuint buffer, GLintptr offset, GLsizeiptr size, const GLvoid *data)
 {
-    VOGL_NOTE_UNUSED(buffer);
     VOGL_NOTE_UNUSED(trace_serializer);
-    VOGL_NOTE_UNUSED(pContext);
 
     if (g_dump_gl_buffers_flag)
     {
@@ -7544,6 +7815,12 @@ static inline void vogl_named_buffer_subdata_ext_helper(vogl_context *pContext,
         vogl_print_hex(data, size, 1);
         vogl_log_printf("\n");
     }
+
+    if ((!pContext) || (!data))
+        return;
+
+    gl_buffer_desc &buf_desc = pContext->get_or_create_buffer_desc(buffer);
+    buf_desc.m_trace_synced_ranges.insert(offset, math::minimum<int64_t>(static_cast<int64_t>(offset) + size, buf_desc.m_size));
 }
 
 #define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glBufferSubData(exported, category, ret, ret_type_enum, num_params, name, args, params) vogl_buffer_subdata_helper(pContext, trace_serializer, target, offset, size, data);
@@ -7727,7 +8004,9 @@ static inline void vogl_flush_mapped_buffer_range(vogl_context *pContext, GLenum
                            VOGL_FUNCTION_INFO_CSTR, static_cast<int64_t>(offset), static_cast<int64_t>(length), buffer, buf_desc.m_map_size);
     }
 
-    buf_desc.m_flushed_ranges.push_back(gl_buffer_desc::flushed_range(offset, length));
+    int64_t flush_begin = math::maximum<int64_t>(offset, 0);
+    int64_t flush_end = math::minimum<int64_t>(static_cast<int64_t>(offset) + length, buf_desc.m_map_size);
+    buf_desc.m_flushed_ranges.insert(flush_begin, flush_end);
 }
 
 #define DEF_FUNCTION_CUSTOM_GL_PROLOG_glUnmapBuffer(exported, category, ret, ret_type_enum, num_params, name, args, params) vogl_unmap_buffer_helper(pContext, trace_serializer, target);
@@ -7787,8 +8066,9 @@ static inline void vogl_unmap_buffer_helper(vogl_context *pContext, vogl_entrypo
             {
                 for (uint i = 0; i < buf_desc.m_flushed_ranges.size(); i++)
                 {
-                    vogl_log_printf("Flushed buffer data (ofs: %" PRIu64 " size: %" PRIu64 "):\n", buf_desc.m_flushed_ranges[i].m_ofs, buf_desc.m_flushed_ranges[i].m_size);
-                    vogl_print_hex(static_cast<const uint8_t *>(buf_desc.m_pMap) + buf_desc.m_flushed_ranges[i].m_ofs, buf_desc.m_flushed_ranges[i].m_size, 1);
+                    const gl_buffer_desc::range_set::interval &range = buf_desc.m_flushed_ranges[i];
+                    vogl_log_printf("Flushed buffer data (ofs: %" PRIu64 " size: %" PRIu64 "):\n", cast_val_to_uint64(range.m_begin), cast_val_to_uint64(range.get_size()));
+                    vogl_print_hex(static_cast<const uint8_t *>(buf_desc.m_pMap) + range.m_begin, range.get_size(), 1);
                     vogl_log_printf("\n");
                 }
             }
@@ -7798,14 +8078,19 @@ static inline void vogl_unmap_buffer_helper(vogl_context *pContext, vogl_entrypo
                 trace_serializer.add_key_value(string_hash("flushed_ranges"), buf_desc.m_flushed_ranges.size());
                 for (uint i = 0; i < buf_desc.m_flushed_ranges.size(); i++)
                 {
+                    const gl_buffer_desc::range_set::interval &range = buf_desc.m_flushed_ranges[i];
+
                     int key_index = i * 4;
-                    trace_serializer.add_key_value(key_index, buf_desc.m_flushed_ranges[i].m_ofs);
-                    trace_serializer.add_key_value(key_index + 1, buf_desc.m_flushed_ranges[i].m_size);
+                    trace_serializer.add_key_value(key_index, range.m_begin);
+                    trace_serializer.add_key_value(key_index + 1, range.get_size());
                     // TODO
-                    VOGL_ASSERT(buf_desc.m_flushed_ranges[i].m_size <= cUINT32_MAX);
-                    trace_serializer.add_key_value_blob(key_index + 2, static_cast<const uint8_t *>(buf_desc.m_pMap) + buf_desc.m_flushed_ranges[i].m_ofs, static_cast<uint>(buf_desc.m_flushed_ranges[i].m_size));
+                    VOGL_ASSERT(range.get_size() <= cUINT32_MAX);
+                    trace_serializer.add_key_value_blob(key_index + 2, static_cast<const uint8_t *>(buf_desc.m_pMap) + range.m_begin, static_cast<uint>(range.get_size()));
                 }
             }
+
+            for (uint i = 0; i < buf_desc.m_flushed_ranges.size(); i++)
+                buf_desc.m_trace_synced_ranges.insert(buf_desc.m_map_ofs + buf_desc.m_flushed_ranges[i].m_begin, buf_desc.m_map_ofs + buf_desc.m_flushed_ranges[i].m_end);
         }
         else
         {
@@ -7824,6 +8109,8 @@ static inline void vogl_unmap_buffer_helper(vogl_context *pContext, vogl_entrypo
                 VOGL_ASSERT(buf_desc.m_map_size <= cUINT32_MAX);
                 trace_serializer.add_key_value_blob(2, static_cast<const uint8_t *>(buf_desc.m_pMap), static_cast<uint>(buf_desc.m_map_size));
             }
+
+            buf_desc.m_trace_synced_ranges.insert(buf_desc.m_map_ofs, buf_desc.m_map_ofs + buf_desc.m_map_size);
         }
     }
 
@@ -7831,7 +8118,7 @@ static inline void vogl_unmap_buffer_helper(vogl_context *pContext, vogl_entrypo
     buf_desc.m_map_ofs = 0;
     buf_desc.m_map_size = 0;
     buf_desc.m_map_access = 0;
-    buf_desc.m_flushed_ranges.resize(0);
+    buf_desc.m_flushed_ranges.clear();
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -8045,6 +8332,8 @@ static void vogl_link_program_arb(vogl_context *pContext, vogl_entrypoint_serial
 
     if (programObj)
     {
+        pContext->remove_uniform_value_shadow(programObj);
+
         if ((link_status) || (!pContext->has_linked_program_snapshot(programObj)))
         {
             if (!pContext->add_linked_program_snapshot(VOGL_ENTRYPOINT_glLinkProgramARB, programObj))
@@ -8201,6 +8490,8 @@ static void vogl_link_program_epilog_helper(vogl_context *pContext, vogl_entrypo
 
     if (program)
     {
+        pContext->remove_uniform_value_shadow(program);
+
         if ((link_status) || (!pContext->has_linked_program_snapshot(program)))
         {
             if (id == VOGL_ENTRYPOINT_glProgramBinary)
@@ -8228,6 +8519,192 @@ static void vogl_link_program_epilog_helper(vogl_context *pContext, vogl_entrypo
     }
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+// glUniform*/glProgramUniform* function epilogs
+// These keep the uniform value shadow up to date, so state snapshots don't need a glGetUniform*() call per uniform array element.
+//----------------------------------------------------------------------------------------------------------------------
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glProgramUniform1d(e, c, rt, r, nu, ne, a, p) if (pContext) { const GLdouble values[1] = { v0 }; pContext->update_uniform_value_shadow(program, location, 1, GL_FALSE, GL_DOUBLE, 1, values); }
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glProgramUniform1dEXT(e, c, rt, r, nu, ne, a, p) if (pContext) { const GLdouble values[1] = { x }; pContext->update_uniform_value_shadow(program, location, 1, GL_FALSE, GL_DOUBLE, 1, values); }
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glProgramUniform1dv(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->update_uniform_value_shadow(program, location, count, GL_FALSE, GL_DOUBLE, 1, value);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glProgramUniform1dvEXT(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->update_uniform_value_shadow(program, location, count, GL_FALSE, GL_DOUBLE, 1, value);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glProgramUniform1f(e, c, rt, r, nu, ne, a, p) if (pContext) { const GLfloat values[1] = { v0 }; pContext->update_uniform_value_shadow(program, location, 1, GL_FALSE, GL_FLOAT, 1, values); }
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glProgramUniform1fEXT(e, c, rt, r, nu, ne, a, p) if (pContext) { const GLfloat values[1] = { v0 }; pContext->update_uniform_value_shadow(program, location, 1, GL_FALSE, GL_FLOAT, 1, values); }
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glProgramUniform1fv(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->update_uniform_value_shadow(program, location, count, GL_FALSE, GL_FLOAT, 1, value);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glProgramUniform1fvEXT(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->update_uniform_value_shadow(program, location, count, GL_FALSE, GL_FLOAT, 1, value);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glProgramUniform1i(e, c, rt, r, nu, ne, a, p) if (pContext) { const GLint values[1] = { v0 }; pContext->update_uniform_value_shadow(program, location, 1, GL_FALSE, GL_INT, 1, values); }
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glProgramUniform1iEXT(e, c, rt, r, nu, ne, a, p) if (pContext) { const GLint values[1] = { v0 }; pContext->update_uniform_value_shadow(program, location, 1, GL_FALSE, GL_INT, 1, values); }
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glProgramUniform1iv(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->update_uniform_value_shadow(program, location, count, GL_FALSE, GL_INT, 1, value);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glProgramUniform1ivEXT(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->update_uniform_value_shadow(program, location, count, GL_FALSE, GL_INT, 1, value);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glProgramUniform1ui(e, c, rt, r, nu, ne, a, p) if (pContext) { const GLuint values[1] = { v0 }; pContext->update_uniform_value_shadow(program, location, 1, GL_FALSE, GL_UNSIGNED_INT, 1, values); }
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glProgramUniform1uiEXT(e, c, rt, r, nu, ne, a, p) if (pContext) { const GLuint values[1] = { v0 }; pContext->update_uniform_value_shadow(program, location, 1, GL_FALSE, GL_UNSIGNED_INT, 1, values); }
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glProgramUniform1uiv(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->update_uniform_value_shadow(program, location, count, GL_FALSE, GL_UNSIGNED_INT, 1, value);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glProgramUniform1uivEXT(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->update_uniform_value_shadow(program, location, count, GL_FALSE, GL_UNSIGNED_INT, 1, value);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glProgramUniform2d(e, c, rt, r, nu, ne, a, p) if (pContext) { const GLdouble values[2] = { v0, v1 }; pContext->update_uniform_value_shadow(program, location, 1, GL_FALSE, GL_DOUBLE, 2, values); }
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glProgramUniform2dEXT(e, c, rt, r, nu, ne, a, p) if (pContext) { const GLdouble values[2] = { x, y }; pContext->update_uniform_value_shadow(program, location, 1, GL_FALSE, GL_DOUBLE, 2, values); }
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glProgramUniform2dv(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->update_uniform_value_shadow(program, location, count, GL_FALSE, GL_DOUBLE, 2, value);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glProgramUniform2dvEXT(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->update_uniform_value_shadow(program, location, count, GL_FALSE, GL_DOUBLE, 2, value);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glProgramUniform2f(e, c, rt, r, nu, ne, a, p) if (pContext) { const GLfloat values[2] = { v0, v1 }; pContext->update_uniform_value_shadow(program, location, 1, GL_FALSE, GL_FLOAT, 2, values); }
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glProgramUniform2fEXT(e, c, rt, r, nu, ne, a, p) if (pContext) { const GLfloat values[2] = { v0, v1 }; pContext->update_uniform_value_shadow(program, location, 1, GL_FALSE, GL_FLOAT, 2, values); }
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glProgramUniform2fv(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->update_uniform_value_shadow(program, location, count, GL_FALSE, GL_FLOAT, 2, value);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glProgramUniform2fvEXT(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->update_uniform_value_shadow(program, location, count, GL_FALSE, GL_FLOAT, 2, value);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glProgramUniform2i(e, c, rt, r, nu, ne, a, p) if (pContext) { const GLint values[2] = { v0, v1 }; pContext->update_uniform_value_shadow(program, location, 1, GL_FALSE, GL_INT, 2, values); }
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glProgramUniform2iEXT(e, c, rt, r, nu, ne, a, p) if (pContext) { const GLint values[2] = { v0, v1 }; pContext->update_uniform_value_shadow(program, location, 1, GL_FALSE, GL_INT, 2, values); }
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glProgramUniform2iv(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->update_uniform_value_shadow(program, location, count, GL_FALSE, GL_INT, 2, value);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glProgramUniform2ivEXT(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->update_uniform_value_shadow(program, location, count, GL_FALSE, GL_INT, 2, value);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glProgramUniform2ui(e, c, rt, r, nu, ne, a, p) if (pContext) { const GLuint values[2] = { v0, v1 }; pContext->update_uniform_value_shadow(program, location, 1, GL_FALSE, GL_UNSIGNED_INT, 2, values); }
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glProgramUniform2uiEXT(e, c, rt, r, nu, ne, a, p) if (pContext) { const GLuint values[2] = { v0, v1 }; pContext->update_uniform_value_shadow(program, location, 1, GL_FALSE, GL_UNSIGNED_INT, 2, values); }
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glProgramUniform2uiv(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->update_uniform_value_shadow(program, location, count, GL_FALSE, GL_UNSIGNED_INT, 2, value);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glProgramUniform2uivEXT(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->update_uniform_value_shadow(program, location, count, GL_FALSE, GL_UNSIGNED_INT, 2, value);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glProgramUniform3d(e, c, rt, r, nu, ne, a, p) if (pContext) { const GLdouble values[3] = { v0, v1, v2 }; pContext->update_uniform_value_shadow(program, location, 1, GL_FALSE, GL_DOUBLE, 3, values); }
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glProgramUniform3dEXT(e, c, rt, r, nu, ne, a, p) if (pContext) { const GLdouble values[3] = { x, y, z }; pContext->update_uniform_value_shadow(program, location, 1, GL_FALSE, GL_DOUBLE, 3, values); }
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glProgramUniform3dv(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->update_uniform_value_shadow(program, location, count, GL_FALSE, GL_DOUBLE, 3, value);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glProgramUniform3dvEXT(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->update_uniform_value_shadow(program, location, count, GL_FALSE, GL_DOUBLE, 3, value);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glProgramUniform3f(e, c, rt, r, nu, ne, a, p) if (pContext) { const GLfloat values[3] = { v0, v1, v2 }; pContext->update_uniform_value_shadow(program, location, 1, GL_FALSE, GL_FLOAT, 3, values); }
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glProgramUniform3fEXT(e, c, rt, r, nu, ne, a, p) if (pContext) { const GLfloat values[3] = { v0, v1, v2 }; pContext->update_uniform_value_shadow(program, location, 1, GL_FALSE, GL_FLOAT, 3, values); }
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glProgramUniform3fv(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->update_uniform_value_shadow(program, location, count, GL_FALSE, GL_FLOAT, 3, value);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glProgramUniform3fvEXT(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->update_uniform_value_shadow(program, location, count, GL_FALSE, GL_FLOAT, 3, value);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glProgramUniform3i(e, c, rt, r, nu, ne, a, p) if (pContext) { const GLint values[3] = { v0, v1, v2 }; pContext->update_uniform_value_shadow(program, location, 1, GL_FALSE, GL_INT, 3, values); }
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glProgramUniform3iEXT(e, c, rt, r, nu, ne, a, p) if (pContext) { const GLint values[3] = { v0, v1, v2 }; pContext->update_uniform_value_shadow(program, location, 1, GL_FALSE, GL_INT, 3, values); }
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glProgramUniform3iv(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->update_uniform_value_shadow(program, location, count, GL_FALSE, GL_INT, 3, value);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glProgramUniform3ivEXT(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->update_uniform_value_shadow(program, location, count, GL_FALSE, GL_INT, 3, value);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glProgramUniform3ui(e, c, rt, r, nu, ne, a, p) if (pContext) { const GLuint values[3] = { v0, v1, v2 }; pContext->update_uniform_value_shadow(program, location, 1, GL_FALSE, GL_UNSIGNED_INT, 3, values); }
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glProgramUniform3uiEXT(e, c, rt, r, nu, ne, a, p) if (pContext) { const GLuint values[3] = { v0, v1, v2 }; pContext->update_uniform_value_shadow(program, location, 1, GL_FALSE, GL_UNSIGNED_INT, 3, values); }
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glProgramUniform3uiv(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->update_uniform_value_shadow(program, location, count, GL_FALSE, GL_UNSIGNED_INT, 3, value);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glProgramUniform3uivEXT(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->update_uniform_value_shadow(program, location, count, GL_FALSE, GL_UNSIGNED_INT, 3, value);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glProgramUniform4d(e, c, rt, r, nu, ne, a, p) if (pContext) { const GLdouble values[4] = { v0, v1, v2, v3 }; pContext->update_uniform_value_shadow(program, location, 1, GL_FALSE, GL_DOUBLE, 4, values); }
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glProgramUniform4dEXT(e, c, rt, r, nu, ne, a, p) if (pContext) { const GLdouble values[4] = { x, y, z, w }; pContext->update_uniform_value_shadow(program, location, 1, GL_FALSE, GL_DOUBLE, 4, values); }
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glProgramUniform4dv(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->update_uniform_value_shadow(program, location, count, GL_FALSE, GL_DOUBLE, 4, value);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glProgramUniform4dvEXT(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->update_uniform_value_shadow(program, location, count, GL_FALSE, GL_DOUBLE, 4, value);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glProgramUniform4f(e, c, rt, r, nu, ne, a, p) if (pContext) { const GLfloat values[4] = { v0, v1, v2, v3 }; pContext->update_uniform_value_shadow(program, location, 1, GL_FALSE, GL_FLOAT, 4, values); }
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glProgramUniform4fEXT(e, c, rt, r, nu, ne, a, p) if (pContext) { const GLfloat values[4] = { v0, v1, v2, v3 }; pContext->update_uniform_value_shadow(program, location, 1, GL_FALSE, GL_FLOAT, 4, values); }
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glProgramUniform4fv(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->update_uniform_value_shadow(program, location, count, GL_FALSE, GL_FLOAT, 4, value);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glProgramUniform4fvEXT(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->update_uniform_value_shadow(program, location, count, GL_FALSE, GL_FLOAT, 4, value);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glProgramUniform4i(e, c, rt, r, nu, ne, a, p) if (pContext) { const GLint values[4] = { v0, v1, v2, v3 }; pContext->update_uniform_value_shadow(program, location, 1, GL_FALSE, GL_INT, 4, values); }
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glProgramUniform4iEXT(e, c, rt, r, nu, ne, a, p) if (pContext) { const GLint values[4] = { v0, v1, v2, v3 }; pContext->update_uniform_value_shadow(program, location, 1, GL_FALSE, GL_INT, 4, values); }
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glProgramUniform4iv(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->update_uniform_value_shadow(program, location, count, GL_FALSE, GL_INT, 4, value);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glProgramUniform4ivEXT(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->update_uniform_value_shadow(program, location, count, GL_FALSE, GL_INT, 4, value);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glProgramUniform4ui(e, c, rt, r, nu, ne, a, p) if (pContext) { const GLuint values[4] = { v0, v1, v2, v3 }; pContext->update_uniform_value_shadow(program, location, 1, GL_FALSE, GL_UNSIGNED_INT, 4, values); }
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glProgramUniform4uiEXT(e, c, rt, r, nu, ne, a, p) if (pContext) { const GLuint values[4] = { v0, v1, v2, v3 }; pContext->update_uniform_value_shadow(program, location, 1, GL_FALSE, GL_UNSIGNED_INT, 4, values); }
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glProgramUniform4uiv(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->update_uniform_value_shadow(program, location, count, GL_FALSE, GL_UNSIGNED_INT, 4, value);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glProgramUniform4uivEXT(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->update_uniform_value_shadow(program, location, count, GL_FALSE, GL_UNSIGNED_INT, 4, value);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glProgramUniformMatrix2dv(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->update_uniform_value_shadow(program, location, count, transpose, GL_DOUBLE, 4, value);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glProgramUniformMatrix2dvEXT(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->update_uniform_value_shadow(program, location, count, transpose, GL_DOUBLE, 4, value);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glProgramUniformMatrix2fv(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->update_uniform_value_shadow(program, location, count, transpose, GL_FLOAT, 4, value);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glProgramUniformMatrix2fvEXT(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->update_uniform_value_shadow(program, location, count, transpose, GL_FLOAT, 4, value);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glProgramUniformMatrix2x3dv(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->update_uniform_value_shadow(program, location, count, transpose, GL_DOUBLE, 6, value);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glProgramUniformMatrix2x3dvEXT(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->update_uniform_value_shadow(program, location, count, transpose, GL_DOUBLE, 6, value);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glProgramUniformMatrix2x3fv(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->update_uniform_value_shadow(program, location, count, transpose, GL_FLOAT, 6, value);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glProgramUniformMatrix2x3fvEXT(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->update_uniform_value_shadow(program, location, count, transpose, GL_FLOAT, 6, value);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glProgramUniformMatrix2x4dv(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->update_uniform_value_shadow(program, location, count, transpose, GL_DOUBLE, 8, value);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glProgramUniformMatrix2x4dvEXT(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->update_uniform_value_shadow(program, location, count, transpose, GL_DOUBLE, 8, value);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glProgramUniformMatrix2x4fv(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->update_uniform_value_shadow(program, location, count, transpose, GL_FLOAT, 8, value);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glProgramUniformMatrix2x4fvEXT(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->update_uniform_value_shadow(program, location, count, transpose, GL_FLOAT, 8, value);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glProgramUniformMatrix3dv(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->update_uniform_value_shadow(program, location, count, transpose, GL_DOUBLE, 9, value);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glProgramUniformMatrix3dvEXT(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->update_uniform_value_shadow(program, location, count, transpose, GL_DOUBLE, 9, value);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glProgramUniformMatrix3fv(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->update_uniform_value_shadow(program, location, count, transpose, GL_FLOAT, 9, value);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glProgramUniformMatrix3fvEXT(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->update_uniform_value_shadow(program, location, count, transpose, GL_FLOAT, 9, value);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glProgramUniformMatrix3x2dv(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->update_uniform_value_shadow(program, location, count, transpose, GL_DOUBLE, 6, value);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glProgramUniformMatrix3x2dvEXT(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->update_uniform_value_shadow(program, location, count, transpose, GL_DOUBLE, 6, value);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glProgramUniformMatrix3x2fv(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->update_uniform_value_shadow(program, location, count, transpose, GL_FLOAT, 6, value);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glProgramUniformMatrix3x2fvEXT(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->update_uniform_value_shadow(program, location, count, transpose, GL_FLOAT, 6, value);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glProgramUniformMatrix3x4dv(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->update_uniform_value_shadow(program, location, count, transpose, GL_DOUBLE, 12, value);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glProgramUniformMatrix3x4dvEXT(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->update_uniform_value_shadow(program, location, count, transpose, GL_DOUBLE, 12, value);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glProgramUniformMatrix3x4fv(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->update_uniform_value_shadow(program, location, count, transpose, GL_FLOAT, 12, value);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glProgramUniformMatrix3x4fvEXT(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->update_uniform_value_shadow(program, location, count, transpose, GL_FLOAT, 12, value);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glProgramUniformMatrix4dv(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->update_uniform_value_shadow(program, location, count, transpose, GL_DOUBLE, 16, value);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glProgramUniformMatrix4dvEXT(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->update_uniform_value_shadow(program, location, count, transpose, GL_DOUBLE, 16, value);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glProgramUniformMatrix4fv(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->update_uniform_value_shadow(program, location, count, transpose, GL_FLOAT, 16, value);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glProgramUniformMatrix4fvEXT(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->update_uniform_value_shadow(program, location, count, transpose, GL_FLOAT, 16, value);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glProgramUniformMatrix4x2dv(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->update_uniform_value_shadow(program, location, count, transpose, GL_DOUBLE, 8, value);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glProgramUniformMatrix4x2dvEXT(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->update_uniform_value_shadow(program, location, count, transpose, GL_DOUBLE, 8, value);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glProgramUniformMatrix4x2fv(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->update_uniform_value_shadow(program, location, count, transpose, GL_FLOAT, 8, value);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glProgramUniformMatrix4x2fvEXT(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->update_uniform_value_shadow(program, location, count, transpose, GL_FLOAT, 8, value);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glProgramUniformMatrix4x3dv(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->update_uniform_value_shadow(program, location, count, transpose, GL_DOUBLE, 12, value);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glProgramUniformMatrix4x3dvEXT(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->update_uniform_value_shadow(program, location, count, transpose, GL_DOUBLE, 12, value);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glProgramUniformMatrix4x3fv(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->update_uniform_value_shadow(program, location, count, transpose, GL_FLOAT, 12, value);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glProgramUniformMatrix4x3fvEXT(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->update_uniform_value_shadow(program, location, count, transpose, GL_FLOAT, 12, value);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glUniform1d(e, c, rt, r, nu, ne, a, p) if (pContext) { const GLdouble values[1] = { x }; pContext->update_uniform_value_shadow(pContext->get_cur_program(), location, 1, GL_FALSE, GL_DOUBLE, 1, values); }
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glUniform1dv(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->update_uniform_value_shadow(pContext->get_cur_program(), location, count, GL_FALSE, GL_DOUBLE, 1, value);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glUniform1f(e, c, rt, r, nu, ne, a, p) if (pContext) { const GLfloat values[1] = { v0 }; pContext->update_uniform_value_shadow(pContext->get_cur_program(), location, 1, GL_FALSE, GL_FLOAT, 1, values); }
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glUniform1fARB(e, c, rt, r, nu, ne, a, p) if (pContext) { const GLfloat values[1] = { v0 }; pContext->update_uniform_value_shadow(pContext->get_cur_program(), location, 1, GL_FALSE, GL_FLOAT, 1, values); }
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glUniform1fv(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->update_uniform_value_shadow(pContext->get_cur_program(), location, count, GL_FALSE, GL_FLOAT, 1, value);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glUniform1fvARB(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->update_uniform_value_shadow(pContext->get_cur_program(), location, count, GL_FALSE, GL_FLOAT, 1, value);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glUniform1i(e, c, rt, r, nu, ne, a, p) if (pContext) { const GLint values[1] = { v0 }; pContext->update_uniform_value_shadow(pContext->get_cur_program(), location, 1, GL_FALSE, GL_INT, 1, values); }
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glUniform1iARB(e, c, rt, r, nu, ne, a, p) if (pContext) { const GLint values[1] = { v0 }; pContext->update_uniform_value_shadow(pContext->get_cur_program(), location, 1, GL_FALSE, GL_INT, 1, values); }
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glUniform1iv(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->update_uniform_value_shadow(pContext->get_cur_program(), location, count, GL_FALSE, GL_INT, 1, value);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glUniform1ivARB(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->update_uniform_value_shadow(pContext->get_cur_program(), location, count, GL_FALSE, GL_INT, 1, value);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glUniform1ui(e, c, rt, r, nu, ne, a, p) if (pContext) { const GLuint values[1] = { v0 }; pContext->update_uniform_value_shadow(pContext->get_cur_program(), location, 1, GL_FALSE, GL_UNSIGNED_INT, 1, values); }
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glUniform1uiEXT(e, c, rt, r, nu, ne, a, p) if (pContext) { const GLuint values[1] = { v0 }; pContext->update_uniform_value_shadow(pContext->get_cur_program(), location, 1, GL_FALSE, GL_UNSIGNED_INT, 1, values); }
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glUniform1uiv(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->update_uniform_value_shadow(pContext->get_cur_program(), location, count, GL_FALSE, GL_UNSIGNED_INT, 1, value);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glUniform1uivEXT(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->update_uniform_value_shadow(pContext->get_cur_program(), location, count, GL_FALSE, GL_UNSIGNED_INT, 1, value);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glUniform2d(e, c, rt, r, nu, ne, a, p) if (pContext) { const GLdouble values[2] = { x, y }; pContext->update_uniform_value_shadow(pContext->get_cur_program(), location, 1, GL_FALSE, GL_DOUBLE, 2, values); }
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glUniform2dv(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->update_uniform_value_shadow(pContext->get_cur_program(), location, count, GL_FALSE, GL_DOUBLE, 2, value);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glUniform2f(e, c, rt, r, nu, ne, a, p) if (pContext) { const GLfloat values[2] = { v0, v1 }; pContext->update_uniform_value_shadow(pContext->get_cur_program(), location, 1, GL_FALSE, GL_FLOAT, 2, values); }
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glUniform2fARB(e, c, rt, r, nu, ne, a, p) if (pContext) { const GLfloat values[2] = { v0, v1 }; pContext->update_uniform_value_shadow(pContext->get_cur_program(), location, 1, GL_FALSE, GL_FLOAT, 2, values); }
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glUniform2fv(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->update_uniform_value_shadow(pContext->get_cur_program(), location, count, GL_FALSE, GL_FLOAT, 2, value);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glUniform2fvARB(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->update_uniform_value_shadow(pContext->get_cur_program(), location, count, GL_FALSE, GL_FLOAT, 2, value);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glUniform2i(e, c, rt, r, nu, ne, a, p) if (pContext) { const GLint values[2] = { v0, v1 }; pContext->update_uniform_value_shadow(pContext->get_cur_program(), location, 1, GL_FALSE, GL_INT, 2, values); }
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glUniform2iARB(e, c, rt, r, nu, ne, a, p) if (pContext) { const GLint values[2] = { v0, v1 }; pContext->update_uniform_value_shadow(pContext->get_cur_program(), location, 1, GL_FALSE, GL_INT, 2, values); }
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glUniform2iv(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->update_uniform_value_shadow(pContext->get_cur_program(), location, count, GL_FALSE, GL_INT, 2, value);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glUniform2ivARB(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->update_uniform_value_shadow(pContext->get_cur_program(), location, count, GL_FALSE, GL_INT, 2, value);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glUniform2ui(e, c, rt, r, nu, ne, a, p) if (pContext) { const GLuint values[2] = { v0, v1 }; pContext->update_uniform_value_shadow(pContext->get_cur_program(), location, 1, GL_FALSE, GL_UNSIGNED_INT, 2, values); }
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glUniform2uiEXT(e, c, rt, r, nu, ne, a, p) if (pContext) { const GLuint values[2] = { v0, v1 }; pContext->update_uniform_value_shadow(pContext->get_cur_program(), location, 1, GL_FALSE, GL_UNSIGNED_INT, 2, values); }
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glUniform2uiv(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->update_uniform_value_shadow(pContext->get_cur_program(), location, count, GL_FALSE, GL_UNSIGNED_INT, 2, value);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glUniform2uivEXT(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->update_uniform_value_shadow(pContext->get_cur_program(), location, count, GL_FALSE, GL_UNSIGNED_INT, 2, value);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glUniform3d(e, c, rt, r, nu, ne, a, p) if (pContext) { const GLdouble values[3] = { x, y, z }; pContext->update_uniform_value_shadow(pContext->get_cur_program(), location, 1, GL_FALSE, GL_DOUBLE, 3, values); }
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glUniform3dv(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->update_uniform_value_shadow(pContext->get_cur_program(), location, count, GL_FALSE, GL_DOUBLE, 3, value);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glUniform3f(e, c, rt, r, nu, ne, a, p) if (pContext) { const GLfloat values[3] = { v0, v1, v2 }; pContext->update_uniform_value_shadow(pContext->get_cur_program(), location, 1, GL_FALSE, GL_FLOAT, 3, values); }
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glUniform3fARB(e, c, rt, r, nu, ne, a, p) if (pContext) { const GLfloat values[3] = { v0, v1, v2 }; pContext->update_uniform_value_shadow(pContext->get_cur_program(), location, 1, GL_FALSE, GL_FLOAT, 3, values); }
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glUniform3fv(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->update_uniform_value_shadow(pContext->get_cur_program(), location, count, GL_FALSE, GL_FLOAT, 3, value);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glUniform3fvARB(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->update_uniform_value_shadow(pContext->get_cur_program(), location, count, GL_FALSE, GL_FLOAT, 3, value);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glUniform3i(e, c, rt, r, nu, ne, a, p) if (pContext) { const GLint values[3] = { v0, v1, v2 }; pContext->update_uniform_value_shadow(pContext->get_cur_program(), location, 1, GL_FALSE, GL_INT, 3, values); }
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glUniform3iARB(e, c, rt, r, nu, ne, a, p) if (pContext) { const GLint values[3] = { v0, v1, v2 }; pContext->update_uniform_value_shadow(pContext->get_cur_program(), location, 1, GL_FALSE, GL_INT, 3, values); }
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glUniform3iv(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->update_uniform_value_shadow(pContext->get_cur_program(), location, count, GL_FALSE, GL_INT, 3, value);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glUniform3ivARB(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->update_uniform_value_shadow(pContext->get_cur_program(), location, count, GL_FALSE, GL_INT, 3, value);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glUniform3ui(e, c, rt, r, nu, ne, a, p) if (pContext) { const GLuint values[3] = { v0, v1, v2 }; pContext->update_uniform_value_shadow(pContext->get_cur_program(), location, 1, GL_FALSE, GL_UNSIGNED_INT, 3, values); }
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glUniform3uiEXT(e, c, rt, r, nu, ne, a, p) if (pContext) { const GLuint values[3] = { v0, v1, v2 }; pContext->update_uniform_value_shadow(pContext->get_cur_program(), location, 1, GL_FALSE, GL_UNSIGNED_INT, 3, values); }
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glUniform3uiv(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->update_uniform_value_shadow(pContext->get_cur_program(), location, count, GL_FALSE, GL_UNSIGNED_INT, 3, value);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glUniform3uivEXT(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->update_uniform_value_shadow(pContext->get_cur_program(), location, count, GL_FALSE, GL_UNSIGNED_INT, 3, value);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glUniform4d(e, c, rt, r, nu, ne, a, p) if (pContext) { const GLdouble values[4] = { x, y, z, w }; pContext->update_uniform_value_shadow(pContext->get_cur_program(), location, 1, GL_FALSE, GL_DOUBLE, 4, values); }
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glUniform4dv(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->update_uniform_value_shadow(pContext->get_cur_program(), location, count, GL_FALSE, GL_DOUBLE, 4, value);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glUniform4f(e, c, rt, r, nu, ne, a, p) if (pContext) { const GLfloat values[4] = { v0, v1, v2, v3 }; pContext->update_uniform_value_shadow(pContext->get_cur_program(), location, 1, GL_FALSE, GL_FLOAT, 4, values); }
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glUniform4fARB(e, c, rt, r, nu, ne, a, p) if (pContext) { const GLfloat values[4] = { v0, v1, v2, v3 }; pContext->update_uniform_value_shadow(pContext->get_cur_program(), location, 1, GL_FALSE, GL_FLOAT, 4, values); }
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glUniform4fv(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->update_uniform_value_shadow(pContext->get_cur_program(), location, count, GL_FALSE, GL_FLOAT, 4, value);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glUniform4fvARB(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->update_uniform_value_shadow(pContext->get_cur_program(), location, count, GL_FALSE, GL_FLOAT, 4, value);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glUniform4i(e, c, rt, r, nu, ne, a, p) if (pContext) { const GLint values[4] = { v0, v1, v2, v3 }; pContext->update_uniform_value_shadow(pContext->get_cur_program(), location, 1, GL_FALSE, GL_INT, 4, values); }
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glUniform4iARB(e, c, rt, r, nu, ne, a, p) if (pContext) { const GLint values[4] = { v0, v1, v2, v3 }; pContext->update_uniform_value_shadow(pContext->get_cur_program(), location, 1, GL_FALSE, GL_INT, 4, values); }
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glUniform4iv(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->update_uniform_value_shadow(pContext->get_cur_program(), location, count, GL_FALSE, GL_INT, 4, value);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glUniform4ivARB(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->update_uniform_value_shadow(pContext->get_cur_program(), location, count, GL_FALSE, GL_INT, 4, value);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glUniform4ui(e, c, rt, r, nu, ne, a, p) if (pContext) { const GLuint values[4] = { v0, v1, v2, v3 }; pContext->update_uniform_value_shadow(pContext->get_cur_program(), location, 1, GL_FALSE, GL_UNSIGNED_INT, 4, values); }
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glUniform4uiEXT(e, c, rt, r, nu, ne, a, p) if (pContext) { const GLuint values[4] = { v0, v1, v2, v3 }; pContext->update_uniform_value_shadow(pContext->get_cur_program(), location, 1, GL_FALSE, GL_UNSIGNED_INT, 4, values); }
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glUniform4uiv(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->update_uniform_value_shadow(pContext->get_cur_program(), location, count, GL_FALSE, GL_UNSIGNED_INT, 4, value);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glUniform4uivEXT(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->update_uniform_value_shadow(pContext->get_cur_program(), location, count, GL_FALSE, GL_UNSIGNED_INT, 4, value);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glUniformMatrix2dv(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->update_uniform_value_shadow(pContext->get_cur_program(), location, count, transpose, GL_DOUBLE, 4, value);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glUniformMatrix2fv(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->update_uniform_value_shadow(pContext->get_cur_program(), location, count, transpose, GL_FLOAT, 4, value);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glUniformMatrix2fvARB(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->update_uniform_value_shadow(pContext->get_cur_program(), location, count, transpose, GL_FLOAT, 4, value);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glUniformMatrix2x3dv(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->update_uniform_value_shadow(pContext->get_cur_program(), location, count, transpose, GL_DOUBLE, 6, value);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glUniformMatrix2x3fv(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->update_uniform_value_shadow(pContext->get_cur_program(), location, count, transpose, GL_FLOAT, 6, value);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glUniformMatrix2x4dv(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->update_uniform_value_shadow(pContext->get_cur_program(), location, count, transpose, GL_DOUBLE, 8, value);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glUniformMatrix2x4fv(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->update_uniform_value_shadow(pContext->get_cur_program(), location, count, transpose, GL_FLOAT, 8, value);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glUniformMatrix3dv(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->update_uniform_value_shadow(pContext->get_cur_program(), location, count, transpose, GL_DOUBLE, 9, value);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glUniformMatrix3fv(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->update_uniform_value_shadow(pContext->get_cur_program(), location, count, transpose, GL_FLOAT, 9, value);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glUniformMatrix3fvARB(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->update_uniform_value_shadow(pContext->get_cur_program(), location, count, transpose, GL_FLOAT, 9, value);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glUniformMatrix3x2dv(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->update_uniform_value_shadow(pContext->get_cur_program(), location, count, transpose, GL_DOUBLE, 6, value);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glUniformMatrix3x2fv(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->update_uniform_value_shadow(pContext->get_cur_program(), location, count, transpose, GL_FLOAT, 6, value);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glUniformMatrix3x4dv(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->update_uniform_value_shadow(pContext->get_cur_program(), location, count, transpose, GL_DOUBLE, 12, value);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glUniformMatrix3x4fv(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->update_uniform_value_shadow(pContext->get_cur_program(), location, count, transpose, GL_FLOAT, 12, value);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glUniformMatrix4dv(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->update_uniform_value_shadow(pContext->get_cur_program(), location, count, transpose, GL_DOUBLE, 16, value);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glUniformMatrix4fv(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->update_uniform_value_shadow(pContext->get_cur_program(), location, count, transpose, GL_FLOAT, 16, value);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glUniformMatrix4fvARB(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->update_uniform_value_shadow(pContext->get_cur_program(), location, count, transpose, GL_FLOAT, 16, value);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glUniformMatrix4x2dv(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->update_uniform_value_shadow(pContext->get_cur_program(), location, count, transpose, GL_DOUBLE, 8, value);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glUniformMatrix4x2fv(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->update_uniform_value_shadow(pContext->get_cur_program(), location, count, transpose, GL_FLOAT, 8, value);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glUniformMatrix4x3dv(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->update_uniform_value_shadow(pContext->get_cur_program(), location, count, transpose, GL_DOUBLE, 12, value);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glUniformMatrix4x3fv(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->update_uniform_value_shadow(pContext->get_cur_program(), location, count, transpose, GL_FLOAT, 12, value);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glUniformHandleui64NV(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->invalidate_uniform_value_shadow(pContext->get_cur_program(), location, 1);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glUniformHandleui64vNV(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->invalidate_uniform_value_shadow(pContext->get_cur_program(), location, count);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glProgramUniformHandleui64NV(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->invalidate_uniform_value_shadow(program, location, 1);
+#define DEF_FUNCTION_CUSTOM_FUNC_EPILOG_glProgramUniformHandleui64vNV(e, c, rt, r, nu, ne, a, p) if (pContext) pContext->invalidate_uniform_value_shadow(program, location, count);
+
 //----------------------------------------------------------------------------------------------------------------------
 // glCreateShaderProgramv
 //----------------------------------------------------------------------------------------------------------------------
@@ -8659,12 +9136,18 @@ static inline void vogl_transform_feedback_varyings(vogl_context *pContext, vogl
         pContext->peek_and_record_gl_error();
 #define DEF_FUNCTION_CUSTOM_GL_EPILOG_glBegin(e, c, rt, r, nu, ne, a, p) \
     if (pContext)                                                        \
-        pContext->set_in_gl_begin(true);
+    {                                                                    \
+        pContext->set_in_gl_begin(true);                                 \
+        pContext->get_fixed_function_shadow().begin();                   \
+    }
 
 //#define DEF_FUNCTION_CUSTOM_GL_PROLOG_glEnd(e, c, rt, r, nu, ne, a, p)
 #define DEF_FUNCTION_CUSTOM_GL_EPILOG_glEnd(e, c, rt, r, nu, ne, a, p) \
     if (pContext)                                                      \
-        pContext->set_in_gl_begin(false);
+    {                                                                  \
+        pContext->set_in_gl_begin(false);                              \
+        pContext->get_fixed_function_shadow().end();                   \
+    }
 
 //----------------------------------------------------------------------------------------------------------------------
 // Program/shader shadowing
@@ -8834,6 +9317,304 @@ static void vogl_display_list_bind_callback(vogl_namespace_t handle_namespace, G
     }
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+// Fixed function matrix/light/material/texenv shadowing
+// The shadow validates the params itself, so these don't need to check for GL errors. The OES fixed point variants
+// aren't followed, they just mark the state they change as unknown.
+//----------------------------------------------------------------------------------------------------------------------
+#define DEF_FUNCTION_CUSTOM_GL_EPILOG_glMatrixMode(e, c, rt, r, nu, ne, a, p) \
+    if (pContext)                                                             \
+        pContext->get_fixed_function_shadow().matrix_mode(mode);
+#define DEF_FUNCTION_CUSTOM_GL_EPILOG_glActiveTexture(e, c, rt, r, nu, ne, a, p) \
+    if (pContext)                                                                \
+        pContext->get_fixed_function_shadow().active_texture(texture);
+#define DEF_FUNCTION_CUSTOM_GL_EPILOG_glActiveTextureARB(e, c, rt, r, nu, ne, a, p) \
+    if (pContext)                                                                   \
+        pContext->get_fixed_function_shadow().active_texture(texture);
+#define DEF_FUNCTION_CUSTOM_GL_EPILOG_glEnable(e, c, rt, r, nu, ne, a, p) \
+    if (pContext)                                                         \
+        pContext->get_fixed_function_shadow().enable(cap, true);
+#define DEF_FUNCTION_CUSTOM_GL_EPILOG_glDisable(e, c, rt, r, nu, ne, a, p) \
+    if (pContext)                                                          \
+        pContext->get_fixed_function_shadow().enable(cap, false);
+#define DEF_FUNCTION_CUSTOM_GL_EPILOG_glPushAttrib(e, c, rt, r, nu, ne, a, p) \
+    if (pContext)                                                             \
+        pContext->get_fixed_function_shadow().push_attrib(mask);
+#define DEF_FUNCTION_CUSTOM_GL_EPILOG_glPopAttrib(e, c, rt, r, nu, ne, a, p) \
+    if (pContext)                                                            \
+        pContext->get_fixed_function_shadow().pop_attrib();
+
+#define DEF_FUNCTION_CUSTOM_GL_EPILOG_glLoadIdentity(e, c, rt, r, nu, ne, a, p) \
+    if (pContext)                                                               \
+        pContext->get_fixed_function_shadow().load_identity(GL_NONE);
+#define DEF_FUNCTION_CUSTOM_GL_EPILOG_glLoadMatrixf(e, c, rt, r, nu, ne, a, p) \
+    if (pContext)                                                              \
+        pContext->get_fixed_function_shadow().load_matrix(GL_NONE, m, false);
+#define DEF_FUNCTION_CUSTOM_GL_EPILOG_glLoadMatrixd(e, c, rt, r, nu, ne, a, p) \
+    if (pContext)                                                              \
+        pContext->get_fixed_function_shadow().load_matrix(GL_NONE, m, false);
+#define DEF_FUNCTION_CUSTOM_GL_EPILOG_glLoadTransposeMatrixf(e, c, rt, r, nu, ne, a, p) \
+    if (pContext)                                                                       \
+        pContext->get_fixed_function_shadow().load_matrix(GL_NONE, m, true);
+#define DEF_FUNCTION_CUSTOM_GL_EPILOG_glLoadTransposeMatrixd(e, c, rt, r, nu, ne, a, p) \
+    if (pContext)                                                                       \
+        pContext->get_fixed_function_shadow().load_matrix(GL_NONE, m, true);
+#define DEF_FUNCTION_CUSTOM_GL_EPILOG_glLoadTransposeMatrixfARB(e, c, rt, r, nu, ne, a, p) \
+    if (pContext)                                                                          \
+        pContext->get_fixed_function_shadow().load_matrix(GL_NONE, m, true);
+#define DEF_FUNCTION_CUSTOM_GL_EPILOG_glLoadTransposeMatrixdARB(e, c, rt, r, nu, ne, a, p) \
+    if (pContext)                                                                          \
+        pContext->get_fixed_function_shadow().load_matrix(GL_NONE, m, true);
+#define DEF_FUNCTION_CUSTOM_GL_EPILOG_glMultMatrixf(e, c, rt, r, nu, ne, a, p) \
+    if (pContext)                                                              \
+        pContext->get_fixed_function_shadow().mult_matrix(GL_NONE, m, false);
+#define DEF_FUNCTION_CUSTOM_GL_EPILOG_glMultMatrixd(e, c, rt, r, nu, ne, a, p) \
+    if (pContext)                                                              \
+        pContext->get_fixed_function_shadow().mult_matrix(GL_NONE, m, false);
+#define DEF_FUNCTION_CUSTOM_GL_EPILOG_glMultTransposeMatrixf(e, c, rt, r, nu, ne, a, p) \
+    if (pContext)                                                                       \
+        pContext->get_fixed_function_shadow().mult_matrix(GL_NONE, m, true);
+#define DEF_FUNCTION_CUSTOM_GL_EPILOG_glMultTransposeMatrixd(e, c, rt, r, nu, ne, a, p) \
+    if (pContext)                                                                       \
+        pContext->get_fixed_function_shadow().mult_matrix(GL_NONE, m, true);
+#define DEF_FUNCTION_CUSTOM_GL_EPILOG_glMultTransposeMatrixfARB(e, c, rt, r, nu, ne, a, p) \
+    if (pContext)                                                                          \
+        pContext->get_fixed_function_shadow().mult_matrix(GL_NONE, m, true);
+#define DEF_FUNCTION_CUSTOM_GL_EPILOG_glMultTransposeMatrixdARB(e, c, rt, r, nu, ne, a, p) \
+    if (pContext)                                                                          \
+        pContext->get_fixed_function_shadow().mult_matrix(GL_NONE, m, true);
+#define DEF_FUNCTION_CUSTOM_GL_EPILOG_glRotatef(e, c, rt, r, nu, ne, a, p)     \
+    if (pContext)                                                              \
+        pContext->get_fixed_function_shadow().rotate(GL_NONE, angle, x, y, z);
+#define DEF_FUNCTION_CUSTOM_GL_EPILOG_glRotated(e, c, rt, r, nu, ne, a, p)     \
+    if (pContext)                                                              \
+        pContext->get_fixed_function_shadow().rotate(GL_NONE, angle, x, y, z);
+#define DEF_FUNCTION_CUSTOM_GL_EPILOG_glScalef(e, c, rt, r, nu, ne, a, p) \
+    if (pContext)                                                         \
+        pContext->get_fixed_function_shadow().scale(GL_NONE, x, y, z);
+#define DEF_FUNCTION_CUSTOM_GL_EPILOG_glScaled(e, c, rt, r, nu, ne, a, p) \
+    if (pContext)                                                         \
+        pContext->get_fixed_function_shadow().scale(GL_NONE, x, y, z);
+#define DEF_FUNCTION_CUSTOM_GL_EPILOG_glTranslatef(e, c, rt, r, nu, ne, a, p) \
+    if (pContext)                                                             \
+        pContext->get_fixed_function_shadow().translate(GL_NONE, x, y, z);
+#define DEF_FUNCTION_CUSTOM_GL_EPILOG_glTranslated(e, c, rt, r, nu, ne, a, p) \
+    if (pContext)                                                             \
+        pContext->get_fixed_function_shadow().translate(GL_NONE, x, y, z);
+#define DEF_FUNCTION_CUSTOM_GL_EPILOG_glFrustum(e, c, rt, r, nu, ne, a, p)                             \
+    if (pContext)                                                                                      \
+        pContext->get_fixed_function_shadow().frustum(GL_NONE, left, right, bottom, top, zNear, zFar);
+#define DEF_FUNCTION_CUSTOM_GL_EPILOG_glFrustumfOES(e, c, rt, r, nu, ne, a, p)    \
+    if (pContext)                                                                 \
+        pContext->get_fixed_function_shadow().frustum(GL_NONE, l, r, b, t, n, f);
+#define DEF_FUNCTION_CUSTOM_GL_EPILOG_glOrtho(e, c, rt, r, nu, ne, a, p)                             \
+    if (pContext)                                                                                    \
+        pContext->get_fixed_function_shadow().ortho(GL_NONE, left, right, bottom, top, zNear, zFar);
+#define DEF_FUNCTION_CUSTOM_GL_EPILOG_glOrthofOES(e, c, rt, r, nu, ne, a, p)    \
+    if (pContext)                                                               \
+        pContext->get_fixed_function_shadow().ortho(GL_NONE, l, r, b, t, n, f);
+#define DEF_FUNCTION_CUSTOM_GL_EPILOG_glPushMatrix(e, c, rt, r, nu, ne, a, p) \
+    if (pContext)                                                             \
+        pContext->get_fixed_function_shadow().push_matrix(GL_NONE);
+#define DEF_FUNCTION_CUSTOM_GL_EPILOG_glPopMatrix(e, c, rt, r, nu, ne, a, p) \
+    if (pContext)                                                            \
+        pContext->get_fixed_function_shadow().pop_matrix(GL_NONE);
+#define DEF_FUNCTION_CUSTOM_GL_EPILOG_glLoadMatrixxOES(e, c, rt, r, nu, ne, a, p) \
+    if (pContext)                                                                 \
+        pContext->get_fixed_function_shadow().invalidate_matrix(GL_NONE);
+#define DEF_FUNCTION_CUSTOM_GL_EPILOG_glLoadTransposeMatrixxOES(e, c, rt, r, nu, ne, a, p) \
+    if (pContext)                                                                          \
+        pContext->get_fixed_function_shadow().invalidate_matrix(GL_NONE);
+#define DEF_FUNCTION_CUSTOM_GL_EPILOG_glMultMatrixxOES(e, c, rt, r, nu, ne, a, p) \
+    if (pContext)                                                                 \
+        pContext->get_fixed_function_shadow().invalidate_matrix(GL_NONE);
+#define DEF_FUNCTION_CUSTOM_GL_EPILOG_glMultTransposeMatrixxOES(e, c, rt, r, nu, ne, a, p) \
+    if (pContext)                                                                          \
+        pContext->get_fixed_function_shadow().invalidate_matrix(GL_NONE);
+#define DEF_FUNCTION_CUSTOM_GL_EPILOG_glRotatexOES(e, c, rt, r, nu, ne, a, p) \
+    if (pContext)                                                             \
+        pContext->get_fixed_function_shadow().invalidate_matrix(GL_NONE);
+#define DEF_FUNCTION_CUSTOM_GL_EPILOG_glScalexOES(e, c, rt, r, nu, ne, a, p) \
+    if (pContext)                                                            \
+        pContext->get_fixed_function_shadow().invalidate_matrix(GL_NONE);
+#define DEF_FUNCTION_CUSTOM_GL_EPILOG_glTranslatexOES(e, c, rt, r, nu, ne, a, p) \
+    if (pContext)                                                                \
+        pContext->get_fixed_function_shadow().invalidate_matrix(GL_NONE);
+#define DEF_FUNCTION_CUSTOM_GL_EPILOG_glFrustumxOES(e, c, rt, r, nu, ne, a, p) \
+    if (pContext)                                                              \
+        pContext->get_fixed_function_shadow().invalidate_matrix(GL_NONE);
+#define DEF_FUNCTION_CUSTOM_GL_EPILOG_glOrthoxOES(e, c, rt, r, nu, ne, a, p) \
+    if (pContext)                                                            \
+        pContext->get_fixed_function_shadow().invalidate_matrix(GL_NONE);
+
+#define DEF_FUNCTION_CUSTOM_GL_EPILOG_glMatrixLoadIdentityEXT(e, c, rt, r, nu, ne, a, p) \
+    if (pContext)                                                                        \
+        pContext->get_fixed_function_shadow().load_identity(mode);
+#define DEF_FUNCTION_CUSTOM_GL_EPILOG_glMatrixLoadfEXT(e, c, rt, r, nu, ne, a, p) \
+    if (pContext)                                                                 \
+        pContext->get_fixed_function_shadow().load_matrix(mode, m, false);
+#define DEF_FUNCTION_CUSTOM_GL_EPILOG_glMatrixLoaddEXT(e, c, rt, r, nu, ne, a, p) \
+    if (pContext)                                                                 \
+        pContext->get_fixed_function_shadow().load_matrix(mode, m, false);
+#define DEF_FUNCTION_CUSTOM_GL_EPILOG_glMatrixLoadTransposefEXT(e, c, rt, r, nu, ne, a, p) \
+    if (pContext)                                                                          \
+        pContext->get_fixed_function_shadow().load_matrix(mode, m, true);
+#define DEF_FUNCTION_CUSTOM_GL_EPILOG_glMatrixLoadTransposedEXT(e, c, rt, r, nu, ne, a, p) \
+    if (pContext)                                                                          \
+        pContext->get_fixed_function_shadow().load_matrix(mode, m, true);
+#define DEF_FUNCTION_CUSTOM_GL_EPILOG_glMatrixMultfEXT(e, c, rt, r, nu, ne, a, p) \
+    if (pContext)                                                                 \
+        pContext->get_fixed_function_shadow().mult_matrix(mode, m, false);
+#define DEF_FUNCTION_CUSTOM_GL_EPILOG_glMatrixMultdEXT(e, c, rt, r, nu, ne, a, p) \
+    if (pContext)                                                                 \
+        pContext->get_fixed_function_shadow().mult_matrix(mode, m, false);
+#define DEF_FUNCTION_CUSTOM_GL_EPILOG_glMatrixMultTransposefEXT(e, c, rt, r, nu, ne, a, p) \
+    if (pContext)                                                                          \
+        pContext->get_fixed_function_shadow().mult_matrix(mode, m, true);
+#define DEF_FUNCTION_CUSTOM_GL_EPILOG_glMatrixMultTransposedEXT(e, c, rt, r, nu, ne, a, p) \
+    if (pContext)                                                                          \
+        pContext->get_fixed_function_shadow().mult_matrix(mode, m, true);
+#define DEF_FUNCTION_CUSTOM_GL_EPILOG_glMatrixRotatefEXT(e, c, rt, r, nu, ne, a, p) \
+    if (pContext)                                                                   \
+        pContext->get_fixed_function_shadow().rotate(mode, angle, x, y, z);
+#define DEF_FUNCTION_CUSTOM_GL_EPILOG_glMatrixRotatedEXT(e, c, rt, r, nu, ne, a, p) \
+    if (pContext)                                                                   \
+        pContext->get_fixed_function_shadow().rotate(mode, angle, x, y, z);
+#define DEF_FUNCTION_CUSTOM_GL_EPILOG_glMatrixScalefEXT(e, c, rt, r, nu, ne, a, p) \
+    if (pContext)                                                                  \
+        pContext->get_fixed_function_shadow().scale(mode, x, y, z);
+#define DEF_FUNCTION_CUSTOM_GL_EPILOG_glMatrixScaledEXT(e, c, rt, r, nu, ne, a, p) \
+    if (pContext)                                                                  \
+        pContext->get_fixed_function_shadow().scale(mode, x, y, z);
+#define DEF_FUNCTION_CUSTOM_GL_EPILOG_glMatrixTranslatefEXT(e, c, rt, r, nu, ne, a, p) \
+    if (pContext)                                                                      \
+        pContext->get_fixed_function_shadow().translate(mode, x, y, z);
+#define DEF_FUNCTION_CUSTOM_GL_EPILOG_glMatrixTranslatedEXT(e, c, rt, r, nu, ne, a, p) \
+    if (pContext)                                                                      \
+        pContext->get_fixed_function_shadow().translate(mode, x, y, z);
+#define DEF_FUNCTION_CUSTOM_GL_EPILOG_glMatrixFrustumEXT(e, c, rt, r, nu, ne, a, p)                 \
+    if (pContext)                                                                                   \
+        pContext->get_fixed_function_shadow().frustum(mode, left, right, bottom, top, zNear, zFar);
+#define DEF_FUNCTION_CUSTOM_GL_EPILOG_glMatrixOrthoEXT(e, c, rt, r, nu, ne, a, p)                 \
+    if (pContext)                                                                                 \
+        pContext->get_fixed_function_shadow().ortho(mode, left, right, bottom, top, zNear, zFar);
+#define DEF_FUNCTION_CUSTOM_GL_EPILOG_glMatrixPushEXT(e, c, rt, r, nu, ne, a, p) \
+    if (pContext)                                                                \
+        pContext->get_fixed_function_shadow().push_matrix(mode);
+#define DEF_FUNCTION_CUSTOM_GL_EPILOG_glMatrixPopEXT(e, c, rt, r, nu, ne, a, p) \
+    if (pContext)                                                               \
+        pContext->get_fixed_function_shadow().pop_matrix(mode);
+
+#define DEF_FUNCTION_CUSTOM_GL_EPILOG_glLightf(e, c, rt, r, nu, ne, a, p)         \
+    if (pContext)                                                                 \
+        pContext->get_fixed_function_shadow().light(light, pname, &param, false);
+#define DEF_FUNCTION_CUSTOM_GL_EPILOG_glLighti(e, c, rt, r, nu, ne, a, p)         \
+    if (pContext)                                                                 \
+        pContext->get_fixed_function_shadow().light(light, pname, &param, false);
+#define DEF_FUNCTION_CUSTOM_GL_EPILOG_glLightfv(e, c, rt, r, nu, ne, a, p)       \
+    if (pContext)                                                                \
+        pContext->get_fixed_function_shadow().light(light, pname, params, true);
+#define DEF_FUNCTION_CUSTOM_GL_EPILOG_glLightiv(e, c, rt, r, nu, ne, a, p)       \
+    if (pContext)                                                                \
+        pContext->get_fixed_function_shadow().light(light, pname, params, true);
+#define DEF_FUNCTION_CUSTOM_GL_EPILOG_glLightxOES(e, c, rt, r, nu, ne, a, p) \
+    if (pContext)                                                            \
+        pContext->get_fixed_function_shadow().invalidate_lights();
+#define DEF_FUNCTION_CUSTOM_GL_EPILOG_glLightxvOES(e, c, rt, r, nu, ne, a, p) \
+    if (pContext)                                                             \
+        pContext->get_fixed_function_shadow().invalidate_lights();
+#define DEF_FUNCTION_CUSTOM_GL_EPILOG_glMaterialf(e, c, rt, r, nu, ne, a, p)        \
+    if (pContext)                                                                   \
+        pContext->get_fixed_function_shadow().material(face, pname, &param, false);
+#define DEF_FUNCTION_CUSTOM_GL_EPILOG_glMateriali(e, c, rt, r, nu, ne, a, p)        \
+    if (pContext)                                                                   \
+        pContext->get_fixed_function_shadow().material(face, pname, &param, false);
+#define DEF_FUNCTION_CUSTOM_GL_EPILOG_glMaterialfv(e, c, rt, r, nu, ne, a, p)      \
+    if (pContext)                                                                  \
+        pContext->get_fixed_function_shadow().material(face, pname, params, true);
+#define DEF_FUNCTION_CUSTOM_GL_EPILOG_glMaterialiv(e, c, rt, r, nu, ne, a, p)      \
+    if (pContext)                                                                  \
+        pContext->get_fixed_function_shadow().material(face, pname, params, true);
+#define DEF_FUNCTION_CUSTOM_GL_EPILOG_glMaterialxOES(e, c, rt, r, nu, ne, a, p) \
+    if (pContext)                                                               \
+        pContext->get_fixed_function_shadow().invalidate_material();
+#define DEF_FUNCTION_CUSTOM_GL_EPILOG_glMaterialxvOES(e, c, rt, r, nu, ne, a, p) \
+    if (pContext)                                                                \
+        pContext->get_fixed_function_shadow().invalidate_material();
+
+#define DEF_FUNCTION_CUSTOM_GL_EPILOG_glTexEnvf(e, c, rt, r, nu, ne, a, p)                    \
+    if (pContext)                                                                             \
+        pContext->get_fixed_function_shadow().tex_env(GL_NONE, target, pname, &param, false);
+#define DEF_FUNCTION_CUSTOM_GL_EPILOG_glTexEnvi(e, c, rt, r, nu, ne, a, p)                    \
+    if (pContext)                                                                             \
+        pContext->get_fixed_function_shadow().tex_env(GL_NONE, target, pname, &param, false);
+#define DEF_FUNCTION_CUSTOM_GL_EPILOG_glTexEnvfv(e, c, rt, r, nu, ne, a, p)                  \
+    if (pContext)                                                                            \
+        pContext->get_fixed_function_shadow().tex_env(GL_NONE, target, pname, params, true);
+#define DEF_FUNCTION_CUSTOM_GL_EPILOG_glTexEnviv(e, c, rt, r, nu, ne, a, p)                  \
+    if (pContext)                                                                            \
+        pContext->get_fixed_function_shadow().tex_env(GL_NONE, target, pname, params, true);
+#define DEF_FUNCTION_CUSTOM_GL_EPILOG_glMultiTexEnvfEXT(e, c, rt, r, nu, ne, a, p)            \
+    if (pContext)                                                                             \
+        pContext->get_fixed_function_shadow().tex_env(texunit, target, pname, &param, false);
+#define DEF_FUNCTION_CUSTOM_GL_EPILOG_glMultiTexEnviEXT(e, c, rt, r, nu, ne, a, p)            \
+    if (pContext)                                                                             \
+        pContext->get_fixed_function_shadow().tex_env(texunit, target, pname, &param, false);
+#define DEF_FUNCTION_CUSTOM_GL_EPILOG_glMultiTexEnvfvEXT(e, c, rt, r, nu, ne, a, p)          \
+    if (pContext)                                                                            \
+        pContext->get_fixed_function_shadow().tex_env(texunit, target, pname, params, true);
+#define DEF_FUNCTION_CUSTOM_GL_EPILOG_glMultiTexEnvivEXT(e, c, rt, r, nu, ne, a, p)          \
+    if (pContext)                                                                            \
+        pContext->get_fixed_function_shadow().tex_env(texunit, target, pname, params, true);
+#define DEF_FUNCTION_CUSTOM_GL_EPILOG_glTexGend(e, c, rt, r, nu, ne, a, p)                   \
+    if (pContext)                                                                            \
+        pContext->get_fixed_function_shadow().tex_gen(GL_NONE, coord, pname, &param, false);
+#define DEF_FUNCTION_CUSTOM_GL_EPILOG_glTexGenf(e, c, rt, r, nu, ne, a, p)                   \
+    if (pContext)                                                                            \
+        pContext->get_fixed_function_shadow().tex_gen(GL_NONE, coord, pname, &param, false);
+#define DEF_FUNCTION_CUSTOM_GL_EPILOG_glTexGeni(e, c, rt, r, nu, ne, a, p)                   \
+    if (pContext)                                                                            \
+        pContext->get_fixed_function_shadow().tex_gen(GL_NONE, coord, pname, &param, false);
+#define DEF_FUNCTION_CUSTOM_GL_EPILOG_glTexGendv(e, c, rt, r, nu, ne, a, p)                 \
+    if (pContext)                                                                           \
+        pContext->get_fixed_function_shadow().tex_gen(GL_NONE, coord, pname, params, true);
+#define DEF_FUNCTION_CUSTOM_GL_EPILOG_glTexGenfv(e, c, rt, r, nu, ne, a, p)                 \
+    if (pContext)                                                                           \
+        pContext->get_fixed_function_shadow().tex_gen(GL_NONE, coord, pname, params, true);
+#define DEF_FUNCTION_CUSTOM_GL_EPILOG_glTexGeniv(e, c, rt, r, nu, ne, a, p)                 \
+    if (pContext)                                                                           \
+        pContext->get_fixed_function_shadow().tex_gen(GL_NONE, coord, pname, params, true);
+#define DEF_FUNCTION_CUSTOM_GL_EPILOG_glMultiTexGendEXT(e, c, rt, r, nu, ne, a, p)           \
+    if (pContext)                                                                            \
+        pContext->get_fixed_function_shadow().tex_gen(texunit, coord, pname, &param, false);
+#define DEF_FUNCTION_CUSTOM_GL_EPILOG_glMultiTexGenfEXT(e, c, rt, r, nu, ne, a, p)           \
+    if (pContext)                                                                            \
+        pContext->get_fixed_function_shadow().tex_gen(texunit, coord, pname, &param, false);
+#define DEF_FUNCTION_CUSTOM_GL_EPILOG_glMultiTexGeniEXT(e, c, rt, r, nu, ne, a, p)           \
+    if (pContext)                                                                            \
+        pContext->get_fixed_function_shadow().tex_gen(texunit, coord, pname, &param, false);
+#define DEF_FUNCTION_CUSTOM_GL_EPILOG_glMultiTexGendvEXT(e, c, rt, r, nu, ne, a, p)         \
+    if (pContext)                                                                           \
+        pContext->get_fixed_function_shadow().tex_gen(texunit, coord, pname, params, true);
+#define DEF_FUNCTION_CUSTOM_GL_EPILOG_glMultiTexGenfvEXT(e, c, rt, r, nu, ne, a, p)         \
+    if (pContext)                                                                           \
+        pContext->get_fixed_function_shadow().tex_gen(texunit, coord, pname, params, true);
+#define DEF_FUNCTION_CUSTOM_GL_EPILOG_glMultiTexGenivEXT(e, c, rt, r, nu, ne, a, p)         \
+    if (pContext)                                                                           \
+        pContext->get_fixed_function_shadow().tex_gen(texunit, coord, pname, params, true);
+#define DEF_FUNCTION_CUSTOM_GL_EPILOG_glTexEnvxOES(e, c, rt, r, nu, ne, a, p) \
+    if (pContext)                                                             \
+        pContext->get_fixed_function_shadow().invalidate_texenv();
+#define DEF_FUNCTION_CUSTOM_GL_EPILOG_glTexEnvxvOES(e, c, rt, r, nu, ne, a, p) \
+    if (pContext)                                                              \
+        pContext->get_fixed_function_shadow().invalidate_texenv();
+#define DEF_FUNCTION_CUSTOM_GL_EPILOG_glTexGenxOES(e, c, rt, r, nu, ne, a, p) \
+    if (pContext)                                                             \
+        pContext->get_fixed_function_shadow().invalidate_texenv();
+#define DEF_FUNCTION_CUSTOM_GL_EPILOG_glTexGenxvOES(e, c, rt, r, nu, ne, a, p) \
+    if (pContext)                                                              \
+        pContext->get_fixed_function_shadow().invalidate_texenv();
+
 //----------------------------------------------------------------------------------------------------------------------
 // glCallList shadowing
 //----------------------------------------------------------------------------------------------------------------------
@@ -71,4 +71,10 @@ bool vogl_stop_capturing(vogl_capture_status_callback_func_ptr pStatus_callback,
 // Returns true if a full-stream or triggered capturing is currently active.
 bool vogl_is_capturing();
 
+// Retrieves the per object type costs (object count, bytes, GL readback and serialization time) of the state snapshot written at the start of
+// the most recent capture. The same stats are stored in the trace archive's snapshot. Can be called from the capture status callback.
+// Returns false if no snapshot has been written yet.
+class vogl_snapshot_stats;
+bool vogl_get_last_snapshot_stats(vogl_snapshot_stats &stats);
+
 #endif // VOGL_INTERCEPT_H